@@ -0,0 +1,112 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/miniconda/lib/cmake/GTest/GTestConfig.cmake"
+  "/root/miniconda/lib/cmake/GTest/GTestConfigVersion.cmake"
+  "/root/miniconda/lib/cmake/GTest/GTestTargets-release.cmake"
+  "/root/miniconda/lib/cmake/GTest/GTestTargets.cmake"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/cmake/CheckCXXIntrinsicsAVX.cmake"
+  "/root/repo/cmake/CheckCXXIntrinsicsHeader.cmake"
+  "/root/repo/cmake/CheckCXXIntrinsicsSpecific.cmake"
+  "/root/repo/cmake/CheckMemset.cmake"
+  "/root/repo/cmake/CheckVirtualMemory.cmake"
+  "/root/repo/cmake/CleanArtifacts.cmake"
+  "/root/repo/cmake/EnableCXX17.cmake"
+  "/root/repo/cmake/SEALConfig.cmake.in"
+  "/root/repo/cmake/SEALMacros.cmake"
+  "/root/repo/dotnet/SEALNet.sln.in"
+  "/root/repo/dotnet/examples/SEALNetExamples.csproj.in"
+  "/root/repo/dotnet/nuget/SEALNet-multi.nuspec.in"
+  "/root/repo/dotnet/nuget/SEALNet.nuspec.in"
+  "/root/repo/dotnet/src/SEALNet.csproj.in"
+  "/root/repo/dotnet/tests/SEALNetTest.csproj.in"
+  "/root/repo/native/src/seal/CMakeLists.txt"
+  "/root/repo/native/src/seal/util/CMakeLists.txt"
+  "/root/repo/native/src/seal/util/config.h.in"
+  "/root/repo/native/tests/CMakeLists.txt"
+  "/root/repo/native/tests/seal/CMakeLists.txt"
+  "/root/repo/native/tests/seal/util/CMakeLists.txt"
+  "/root/repo/pkgconfig/seal.pc.in"
+  "/usr/share/cmake-3.25/Modules/BasicConfigVersion-SameMinorVersion.cmake.in"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDependentOption.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeFindDependencyMacro.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakePackageConfigHelpers.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakePushCheckState.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCXXSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCXXSourceRuns.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFile.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFileCXX.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckSymbolExists.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckTypeSize.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/FindZLIB.cmake"
+  "/usr/share/cmake-3.25/Modules/GNUInstallDirs.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceRuns.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  "/usr/share/cmake-3.25/Modules/SelectLibraryConfigurations.cmake"
+  "/usr/share/cmake-3.25/Modules/WriteBasicConfigVersionFile.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "native/src/seal/util/config.h"
+  "cmake/SEALConfig.cmake"
+  "cmake/SEALConfigVersion.cmake"
+  "pkgconfig/seal.pc"
+  "dotnet/src/SEALNet.csproj"
+  "dotnet/tests/SEALNetTest.csproj"
+  "dotnet/examples/SEALNetExamples.csproj"
+  "dotnet/SEALNet.sln"
+  "dotnet/nuget/SEALNet-multi.nuspec"
+  "dotnet/nuget/SEALNet.nuspec"
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "native/src/seal/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "native/src/seal/util/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "native/tests/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "native/tests/seal/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "native/tests/seal/util/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "CMakeFiles/seal.dir/DependInfo.cmake"
+  "native/tests/CMakeFiles/sealtest.dir/DependInfo.cmake"
+  )
@@ -0,0 +1,69 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/native/src/seal/util/blake2b.c" "CMakeFiles/seal.dir/native/src/seal/util/blake2b.c.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/util/blake2b.c.o.d"
+  "/root/repo/native/src/seal/util/blake2xb.c" "CMakeFiles/seal.dir/native/src/seal/util/blake2xb.c.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/util/blake2xb.c.o.d"
+  "/root/repo/native/src/seal/util/fips202.c" "CMakeFiles/seal.dir/native/src/seal/util/fips202.c.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/util/fips202.c.o.d"
+  "/root/repo/native/src/seal/batchencoder.cpp" "CMakeFiles/seal.dir/native/src/seal/batchencoder.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/batchencoder.cpp.o.d"
+  "/root/repo/native/src/seal/ciphertext.cpp" "CMakeFiles/seal.dir/native/src/seal/ciphertext.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/ciphertext.cpp.o.d"
+  "/root/repo/native/src/seal/ckks.cpp" "CMakeFiles/seal.dir/native/src/seal/ckks.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/ckks.cpp.o.d"
+  "/root/repo/native/src/seal/context.cpp" "CMakeFiles/seal.dir/native/src/seal/context.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/context.cpp.o.d"
+  "/root/repo/native/src/seal/decryptor.cpp" "CMakeFiles/seal.dir/native/src/seal/decryptor.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/decryptor.cpp.o.d"
+  "/root/repo/native/src/seal/encryptionparams.cpp" "CMakeFiles/seal.dir/native/src/seal/encryptionparams.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/encryptionparams.cpp.o.d"
+  "/root/repo/native/src/seal/encryptor.cpp" "CMakeFiles/seal.dir/native/src/seal/encryptor.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/encryptor.cpp.o.d"
+  "/root/repo/native/src/seal/evaluator.cpp" "CMakeFiles/seal.dir/native/src/seal/evaluator.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/evaluator.cpp.o.d"
+  "/root/repo/native/src/seal/keygenerator.cpp" "CMakeFiles/seal.dir/native/src/seal/keygenerator.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/keygenerator.cpp.o.d"
+  "/root/repo/native/src/seal/kswitchkeys.cpp" "CMakeFiles/seal.dir/native/src/seal/kswitchkeys.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/kswitchkeys.cpp.o.d"
+  "/root/repo/native/src/seal/lineartransform.cpp" "CMakeFiles/seal.dir/native/src/seal/lineartransform.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/lineartransform.cpp.o.d"
+  "/root/repo/native/src/seal/memorymanager.cpp" "CMakeFiles/seal.dir/native/src/seal/memorymanager.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/memorymanager.cpp.o.d"
+  "/root/repo/native/src/seal/modulus.cpp" "CMakeFiles/seal.dir/native/src/seal/modulus.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/modulus.cpp.o.d"
+  "/root/repo/native/src/seal/plaintext.cpp" "CMakeFiles/seal.dir/native/src/seal/plaintext.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/plaintext.cpp.o.d"
+  "/root/repo/native/src/seal/randomgen.cpp" "CMakeFiles/seal.dir/native/src/seal/randomgen.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/randomgen.cpp.o.d"
+  "/root/repo/native/src/seal/rotationplan.cpp" "CMakeFiles/seal.dir/native/src/seal/rotationplan.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/rotationplan.cpp.o.d"
+  "/root/repo/native/src/seal/serialization.cpp" "CMakeFiles/seal.dir/native/src/seal/serialization.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/serialization.cpp.o.d"
+  "/root/repo/native/src/seal/util/clipnormal.cpp" "CMakeFiles/seal.dir/native/src/seal/util/clipnormal.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/util/clipnormal.cpp.o.d"
+  "/root/repo/native/src/seal/util/common.cpp" "CMakeFiles/seal.dir/native/src/seal/util/common.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/util/common.cpp.o.d"
+  "/root/repo/native/src/seal/util/cpufeatures.cpp" "CMakeFiles/seal.dir/native/src/seal/util/cpufeatures.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/util/cpufeatures.cpp.o.d"
+  "/root/repo/native/src/seal/util/croots.cpp" "CMakeFiles/seal.dir/native/src/seal/util/croots.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/util/croots.cpp.o.d"
+  "/root/repo/native/src/seal/util/fft.cpp" "CMakeFiles/seal.dir/native/src/seal/util/fft.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/util/fft.cpp.o.d"
+  "/root/repo/native/src/seal/util/fftavx2.cpp" "CMakeFiles/seal.dir/native/src/seal/util/fftavx2.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/util/fftavx2.cpp.o.d"
+  "/root/repo/native/src/seal/util/fftavx512.cpp" "CMakeFiles/seal.dir/native/src/seal/util/fftavx512.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/util/fftavx512.cpp.o.d"
+  "/root/repo/native/src/seal/util/galois.cpp" "CMakeFiles/seal.dir/native/src/seal/util/galois.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/util/galois.cpp.o.d"
+  "/root/repo/native/src/seal/util/globals.cpp" "CMakeFiles/seal.dir/native/src/seal/util/globals.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/util/globals.cpp.o.d"
+  "/root/repo/native/src/seal/util/hash.cpp" "CMakeFiles/seal.dir/native/src/seal/util/hash.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/util/hash.cpp.o.d"
+  "/root/repo/native/src/seal/util/iterator.cpp" "CMakeFiles/seal.dir/native/src/seal/util/iterator.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/util/iterator.cpp.o.d"
+  "/root/repo/native/src/seal/util/mempool.cpp" "CMakeFiles/seal.dir/native/src/seal/util/mempool.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/util/mempool.cpp.o.d"
+  "/root/repo/native/src/seal/util/ntt.cpp" "CMakeFiles/seal.dir/native/src/seal/util/ntt.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/util/ntt.cpp.o.d"
+  "/root/repo/native/src/seal/util/nttavx2.cpp" "CMakeFiles/seal.dir/native/src/seal/util/nttavx2.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/util/nttavx2.cpp.o.d"
+  "/root/repo/native/src/seal/util/nttavx512.cpp" "CMakeFiles/seal.dir/native/src/seal/util/nttavx512.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/util/nttavx512.cpp.o.d"
+  "/root/repo/native/src/seal/util/numth.cpp" "CMakeFiles/seal.dir/native/src/seal/util/numth.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/util/numth.cpp.o.d"
+  "/root/repo/native/src/seal/util/polyarithavx2.cpp" "CMakeFiles/seal.dir/native/src/seal/util/polyarithavx2.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/util/polyarithavx2.cpp.o.d"
+  "/root/repo/native/src/seal/util/polyarithavx512.cpp" "CMakeFiles/seal.dir/native/src/seal/util/polyarithavx512.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/util/polyarithavx512.cpp.o.d"
+  "/root/repo/native/src/seal/util/polyarithsmallmod.cpp" "CMakeFiles/seal.dir/native/src/seal/util/polyarithsmallmod.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/util/polyarithsmallmod.cpp.o.d"
+  "/root/repo/native/src/seal/util/polykernels.cpp" "CMakeFiles/seal.dir/native/src/seal/util/polykernels.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/util/polykernels.cpp.o.d"
+  "/root/repo/native/src/seal/util/rlwe.cpp" "CMakeFiles/seal.dir/native/src/seal/util/rlwe.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/util/rlwe.cpp.o.d"
+  "/root/repo/native/src/seal/util/rns.cpp" "CMakeFiles/seal.dir/native/src/seal/util/rns.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/util/rns.cpp.o.d"
+  "/root/repo/native/src/seal/util/scalingvariant.cpp" "CMakeFiles/seal.dir/native/src/seal/util/scalingvariant.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/util/scalingvariant.cpp.o.d"
+  "/root/repo/native/src/seal/util/streambuf.cpp" "CMakeFiles/seal.dir/native/src/seal/util/streambuf.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/util/streambuf.cpp.o.d"
+  "/root/repo/native/src/seal/util/threadpool.cpp" "CMakeFiles/seal.dir/native/src/seal/util/threadpool.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/util/threadpool.cpp.o.d"
+  "/root/repo/native/src/seal/util/uintarith.cpp" "CMakeFiles/seal.dir/native/src/seal/util/uintarith.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/util/uintarith.cpp.o.d"
+  "/root/repo/native/src/seal/util/uintarithmod.cpp" "CMakeFiles/seal.dir/native/src/seal/util/uintarithmod.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/util/uintarithmod.cpp.o.d"
+  "/root/repo/native/src/seal/util/uintarithsmallmod.cpp" "CMakeFiles/seal.dir/native/src/seal/util/uintarithsmallmod.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/util/uintarithsmallmod.cpp.o.d"
+  "/root/repo/native/src/seal/util/uintcore.cpp" "CMakeFiles/seal.dir/native/src/seal/util/uintcore.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/util/uintcore.cpp.o.d"
+  "/root/repo/native/src/seal/util/ztools.cpp" "CMakeFiles/seal.dir/native/src/seal/util/ztools.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/util/ztools.cpp.o.d"
+  "/root/repo/native/src/seal/valcheck.cpp" "CMakeFiles/seal.dir/native/src/seal/valcheck.cpp.o" "gcc" "CMakeFiles/seal.dir/native/src/seal/valcheck.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,111 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/seal.dir/native/src/seal/batchencoder.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/batchencoder.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/ciphertext.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/ciphertext.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/ckks.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/ckks.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/context.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/context.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/decryptor.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/decryptor.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/encryptionparams.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/encryptionparams.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/encryptor.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/encryptor.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/evaluator.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/evaluator.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/keygenerator.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/keygenerator.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/kswitchkeys.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/kswitchkeys.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/lineartransform.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/lineartransform.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/memorymanager.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/memorymanager.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/modulus.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/modulus.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/plaintext.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/plaintext.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/randomgen.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/randomgen.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/rotationplan.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/rotationplan.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/serialization.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/serialization.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/util/blake2b.c.o"
+  "CMakeFiles/seal.dir/native/src/seal/util/blake2b.c.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/util/blake2xb.c.o"
+  "CMakeFiles/seal.dir/native/src/seal/util/blake2xb.c.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/util/clipnormal.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/util/clipnormal.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/util/common.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/util/common.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/util/cpufeatures.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/util/cpufeatures.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/util/croots.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/util/croots.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/util/fft.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/util/fft.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/util/fftavx2.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/util/fftavx2.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/util/fftavx512.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/util/fftavx512.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/util/fips202.c.o"
+  "CMakeFiles/seal.dir/native/src/seal/util/fips202.c.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/util/galois.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/util/galois.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/util/globals.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/util/globals.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/util/hash.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/util/hash.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/util/iterator.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/util/iterator.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/util/mempool.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/util/mempool.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/util/ntt.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/util/ntt.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/util/nttavx2.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/util/nttavx2.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/util/nttavx512.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/util/nttavx512.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/util/numth.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/util/numth.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/util/polyarithavx2.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/util/polyarithavx2.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/util/polyarithavx512.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/util/polyarithavx512.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/util/polyarithsmallmod.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/util/polyarithsmallmod.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/util/polykernels.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/util/polykernels.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/util/rlwe.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/util/rlwe.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/util/rns.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/util/rns.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/util/scalingvariant.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/util/scalingvariant.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/util/streambuf.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/util/streambuf.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/util/threadpool.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/util/threadpool.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/util/uintarith.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/util/uintarith.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/util/uintarithmod.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/util/uintarithmod.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/util/uintarithsmallmod.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/util/uintarithsmallmod.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/util/uintcore.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/util/uintcore.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/util/ztools.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/util/ztools.cpp.o.d"
+  "CMakeFiles/seal.dir/native/src/seal/valcheck.cpp.o"
+  "CMakeFiles/seal.dir/native/src/seal/valcheck.cpp.o.d"
+  "lib/libseal-4.0.a"
+  "lib/libseal-4.0.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C CXX)
+  include(CMakeFiles/seal.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
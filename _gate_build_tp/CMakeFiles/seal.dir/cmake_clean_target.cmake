@@ -0,0 +1,3 @@
+file(REMOVE_RECURSE
+  "lib/libseal-4.0.a"
+)
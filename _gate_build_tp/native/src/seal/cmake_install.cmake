@@ -0,0 +1,83 @@
+# Install script for directory: /root/repo/native/src/seal
+
+# Set the install prefix
+if(NOT DEFINED CMAKE_INSTALL_PREFIX)
+  set(CMAKE_INSTALL_PREFIX "/usr/local")
+endif()
+string(REGEX REPLACE "/$" "" CMAKE_INSTALL_PREFIX "${CMAKE_INSTALL_PREFIX}")
+
+# Set the install configuration name.
+if(NOT DEFINED CMAKE_INSTALL_CONFIG_NAME)
+  if(BUILD_TYPE)
+    string(REGEX REPLACE "^[^A-Za-z0-9_]+" ""
+           CMAKE_INSTALL_CONFIG_NAME "${BUILD_TYPE}")
+  else()
+    set(CMAKE_INSTALL_CONFIG_NAME "Release")
+  endif()
+  message(STATUS "Install configuration: \"${CMAKE_INSTALL_CONFIG_NAME}\"")
+endif()
+
+# Set the component getting installed.
+if(NOT CMAKE_INSTALL_COMPONENT)
+  if(COMPONENT)
+    message(STATUS "Install component: \"${COMPONENT}\"")
+    set(CMAKE_INSTALL_COMPONENT "${COMPONENT}")
+  else()
+    set(CMAKE_INSTALL_COMPONENT)
+  endif()
+endif()
+
+# Install shared libraries without execute permission?
+if(NOT DEFINED CMAKE_INSTALL_SO_NO_EXE)
+  set(CMAKE_INSTALL_SO_NO_EXE "1")
+endif()
+
+# Is this installation the result of a crosscompile?
+if(NOT DEFINED CMAKE_CROSSCOMPILING)
+  set(CMAKE_CROSSCOMPILING "FALSE")
+endif()
+
+# Set default install directory permissions.
+if(NOT DEFINED CMAKE_OBJDUMP)
+  set(CMAKE_OBJDUMP "/usr/bin/objdump")
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/include/SEAL-4.0/seal" TYPE FILE FILES
+    "/root/repo/native/src/seal/batchencoder.h"
+    "/root/repo/native/src/seal/ciphertext.h"
+    "/root/repo/native/src/seal/ckks.h"
+    "/root/repo/native/src/seal/modulus.h"
+    "/root/repo/native/src/seal/context.h"
+    "/root/repo/native/src/seal/decryptor.h"
+    "/root/repo/native/src/seal/dynarray.h"
+    "/root/repo/native/src/seal/encryptionparams.h"
+    "/root/repo/native/src/seal/encryptor.h"
+    "/root/repo/native/src/seal/evaluator.h"
+    "/root/repo/native/src/seal/extendedciphertext.h"
+    "/root/repo/native/src/seal/galoiskeys.h"
+    "/root/repo/native/src/seal/keygenerator.h"
+    "/root/repo/native/src/seal/kswitchkeys.h"
+    "/root/repo/native/src/seal/lineartransform.h"
+    "/root/repo/native/src/seal/memorymanager.h"
+    "/root/repo/native/src/seal/plaintext.h"
+    "/root/repo/native/src/seal/publickey.h"
+    "/root/repo/native/src/seal/randomgen.h"
+    "/root/repo/native/src/seal/randomtostd.h"
+    "/root/repo/native/src/seal/relinkeys.h"
+    "/root/repo/native/src/seal/rotationplan.h"
+    "/root/repo/native/src/seal/seal.h"
+    "/root/repo/native/src/seal/secretkey.h"
+    "/root/repo/native/src/seal/serializable.h"
+    "/root/repo/native/src/seal/serialization.h"
+    "/root/repo/native/src/seal/valcheck.h"
+    "/root/repo/native/src/seal/version.h"
+    )
+endif()
+
+if(NOT CMAKE_INSTALL_LOCAL_ONLY)
+  # Include the install script for each subdirectory.
+  include("/root/repo/_gate_build_tp/native/src/seal/util/cmake_install.cmake")
+
+endif()
+
@@ -0,0 +1,88 @@
+# Install script for directory: /root/repo/native/src/seal/util
+
+# Set the install prefix
+if(NOT DEFINED CMAKE_INSTALL_PREFIX)
+  set(CMAKE_INSTALL_PREFIX "/usr/local")
+endif()
+string(REGEX REPLACE "/$" "" CMAKE_INSTALL_PREFIX "${CMAKE_INSTALL_PREFIX}")
+
+# Set the install configuration name.
+if(NOT DEFINED CMAKE_INSTALL_CONFIG_NAME)
+  if(BUILD_TYPE)
+    string(REGEX REPLACE "^[^A-Za-z0-9_]+" ""
+           CMAKE_INSTALL_CONFIG_NAME "${BUILD_TYPE}")
+  else()
+    set(CMAKE_INSTALL_CONFIG_NAME "Release")
+  endif()
+  message(STATUS "Install configuration: \"${CMAKE_INSTALL_CONFIG_NAME}\"")
+endif()
+
+# Set the component getting installed.
+if(NOT CMAKE_INSTALL_COMPONENT)
+  if(COMPONENT)
+    message(STATUS "Install component: \"${COMPONENT}\"")
+    set(CMAKE_INSTALL_COMPONENT "${COMPONENT}")
+  else()
+    set(CMAKE_INSTALL_COMPONENT)
+  endif()
+endif()
+
+# Install shared libraries without execute permission?
+if(NOT DEFINED CMAKE_INSTALL_SO_NO_EXE)
+  set(CMAKE_INSTALL_SO_NO_EXE "1")
+endif()
+
+# Is this installation the result of a crosscompile?
+if(NOT DEFINED CMAKE_CROSSCOMPILING)
+  set(CMAKE_CROSSCOMPILING "FALSE")
+endif()
+
+# Set default install directory permissions.
+if(NOT DEFINED CMAKE_OBJDUMP)
+  set(CMAKE_OBJDUMP "/usr/bin/objdump")
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/include/SEAL-4.0/seal/util" TYPE FILE FILES
+    "/root/repo/native/src/seal/util/blake2.h"
+    "/root/repo/native/src/seal/util/blake2-impl.h"
+    "/root/repo/native/src/seal/util/clang.h"
+    "/root/repo/native/src/seal/util/clipnormal.h"
+    "/root/repo/native/src/seal/util/common.h"
+    "/root/repo/native/src/seal/util/cpufeatures.h"
+    "/root/repo/native/src/seal/util/croots.h"
+    "/root/repo/native/src/seal/util/defines.h"
+    "/root/repo/native/src/seal/util/dwthandler.h"
+    "/root/repo/native/src/seal/util/fft.h"
+    "/root/repo/native/src/seal/util/fftavx.h"
+    "/root/repo/native/src/seal/util/fips202.h"
+    "/root/repo/native/src/seal/util/galois.h"
+    "/root/repo/native/src/seal/util/gcc.h"
+    "/root/repo/native/src/seal/util/globals.h"
+    "/root/repo/native/src/seal/util/hash.h"
+    "/root/repo/native/src/seal/util/hestdparms.h"
+    "/root/repo/native/src/seal/util/iterator.h"
+    "/root/repo/native/src/seal/util/locks.h"
+    "/root/repo/native/src/seal/util/mempool.h"
+    "/root/repo/native/src/seal/util/msvc.h"
+    "/root/repo/native/src/seal/util/numth.h"
+    "/root/repo/native/src/seal/util/pointer.h"
+    "/root/repo/native/src/seal/util/polyarithavx.h"
+    "/root/repo/native/src/seal/util/polyarithsmallmod.h"
+    "/root/repo/native/src/seal/util/polykernels.h"
+    "/root/repo/native/src/seal/util/polycore.h"
+    "/root/repo/native/src/seal/util/rlwe.h"
+    "/root/repo/native/src/seal/util/rns.h"
+    "/root/repo/native/src/seal/util/scalingvariant.h"
+    "/root/repo/native/src/seal/util/ntt.h"
+    "/root/repo/native/src/seal/util/nttavx.h"
+    "/root/repo/native/src/seal/util/streambuf.h"
+    "/root/repo/native/src/seal/util/threadpool.h"
+    "/root/repo/native/src/seal/util/uintarith.h"
+    "/root/repo/native/src/seal/util/uintarithmod.h"
+    "/root/repo/native/src/seal/util/uintarithsmallmod.h"
+    "/root/repo/native/src/seal/util/uintcore.h"
+    "/root/repo/native/src/seal/util/ztools.h"
+    )
+endif()
+
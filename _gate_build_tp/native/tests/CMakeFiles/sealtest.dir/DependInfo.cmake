@@ -0,0 +1,61 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/native/tests/seal/ciphertext.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/ciphertext.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/ciphertext.cpp.o.d"
+  "/root/repo/native/tests/seal/ckks.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/ckks.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/ckks.cpp.o.d"
+  "/root/repo/native/tests/seal/context.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/context.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/context.cpp.o.d"
+  "/root/repo/native/tests/seal/dynarray.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/dynarray.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/dynarray.cpp.o.d"
+  "/root/repo/native/tests/seal/encryptionparams.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/encryptionparams.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/encryptionparams.cpp.o.d"
+  "/root/repo/native/tests/seal/encryptor.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/encryptor.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/encryptor.cpp.o.d"
+  "/root/repo/native/tests/seal/evaluator.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/evaluator.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/evaluator.cpp.o.d"
+  "/root/repo/native/tests/seal/galoiskeys.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/galoiskeys.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/galoiskeys.cpp.o.d"
+  "/root/repo/native/tests/seal/keygenerator.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/keygenerator.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/keygenerator.cpp.o.d"
+  "/root/repo/native/tests/seal/lineartransform.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/lineartransform.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/lineartransform.cpp.o.d"
+  "/root/repo/native/tests/seal/memorymanager.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/memorymanager.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/memorymanager.cpp.o.d"
+  "/root/repo/native/tests/seal/modulus.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/modulus.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/modulus.cpp.o.d"
+  "/root/repo/native/tests/seal/plaintext.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/plaintext.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/plaintext.cpp.o.d"
+  "/root/repo/native/tests/seal/publickey.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/publickey.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/publickey.cpp.o.d"
+  "/root/repo/native/tests/seal/randomgen.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/randomgen.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/randomgen.cpp.o.d"
+  "/root/repo/native/tests/seal/randomtostd.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/randomtostd.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/randomtostd.cpp.o.d"
+  "/root/repo/native/tests/seal/relinkeys.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/relinkeys.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/relinkeys.cpp.o.d"
+  "/root/repo/native/tests/seal/rotationplan.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/rotationplan.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/rotationplan.cpp.o.d"
+  "/root/repo/native/tests/seal/secretkey.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/secretkey.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/secretkey.cpp.o.d"
+  "/root/repo/native/tests/seal/serialization.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/serialization.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/serialization.cpp.o.d"
+  "/root/repo/native/tests/seal/testrunner.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/testrunner.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/testrunner.cpp.o.d"
+  "/root/repo/native/tests/seal/util/clipnormal.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/util/clipnormal.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/util/clipnormal.cpp.o.d"
+  "/root/repo/native/tests/seal/util/common.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/util/common.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/util/common.cpp.o.d"
+  "/root/repo/native/tests/seal/util/fft.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/util/fft.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/util/fft.cpp.o.d"
+  "/root/repo/native/tests/seal/util/galois.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/util/galois.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/util/galois.cpp.o.d"
+  "/root/repo/native/tests/seal/util/hash.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/util/hash.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/util/hash.cpp.o.d"
+  "/root/repo/native/tests/seal/util/iterator.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/util/iterator.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/util/iterator.cpp.o.d"
+  "/root/repo/native/tests/seal/util/locks.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/util/locks.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/util/locks.cpp.o.d"
+  "/root/repo/native/tests/seal/util/mempool.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/util/mempool.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/util/mempool.cpp.o.d"
+  "/root/repo/native/tests/seal/util/ntt.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/util/ntt.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/util/ntt.cpp.o.d"
+  "/root/repo/native/tests/seal/util/numth.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/util/numth.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/util/numth.cpp.o.d"
+  "/root/repo/native/tests/seal/util/polyarithsmallmod.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/util/polyarithsmallmod.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/util/polyarithsmallmod.cpp.o.d"
+  "/root/repo/native/tests/seal/util/polycore.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/util/polycore.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/util/polycore.cpp.o.d"
+  "/root/repo/native/tests/seal/util/polykernels.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/util/polykernels.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/util/polykernels.cpp.o.d"
+  "/root/repo/native/tests/seal/util/rns.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/util/rns.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/util/rns.cpp.o.d"
+  "/root/repo/native/tests/seal/util/stringtouint64.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/util/stringtouint64.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/util/stringtouint64.cpp.o.d"
+  "/root/repo/native/tests/seal/util/threadpool.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/util/threadpool.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/util/threadpool.cpp.o.d"
+  "/root/repo/native/tests/seal/util/uint64tostring.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/util/uint64tostring.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/util/uint64tostring.cpp.o.d"
+  "/root/repo/native/tests/seal/util/uintarith.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/util/uintarith.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/util/uintarith.cpp.o.d"
+  "/root/repo/native/tests/seal/util/uintarithmod.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/util/uintarithmod.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/util/uintarithmod.cpp.o.d"
+  "/root/repo/native/tests/seal/util/uintarithsmallmod.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/util/uintarithsmallmod.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/util/uintarithsmallmod.cpp.o.d"
+  "/root/repo/native/tests/seal/util/uintcore.cpp" "native/tests/CMakeFiles/sealtest.dir/seal/util/uintcore.cpp.o" "gcc" "native/tests/CMakeFiles/sealtest.dir/seal/util/uintcore.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_build_tp/CMakeFiles/seal.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
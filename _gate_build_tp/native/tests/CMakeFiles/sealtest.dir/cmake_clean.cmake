@@ -0,0 +1,93 @@
+file(REMOVE_RECURSE
+  "../../bin/sealtest"
+  "../../bin/sealtest.pdb"
+  "CMakeFiles/sealtest.dir/seal/ciphertext.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/ciphertext.cpp.o.d"
+  "CMakeFiles/sealtest.dir/seal/ckks.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/ckks.cpp.o.d"
+  "CMakeFiles/sealtest.dir/seal/context.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/context.cpp.o.d"
+  "CMakeFiles/sealtest.dir/seal/dynarray.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/dynarray.cpp.o.d"
+  "CMakeFiles/sealtest.dir/seal/encryptionparams.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/encryptionparams.cpp.o.d"
+  "CMakeFiles/sealtest.dir/seal/encryptor.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/encryptor.cpp.o.d"
+  "CMakeFiles/sealtest.dir/seal/evaluator.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/evaluator.cpp.o.d"
+  "CMakeFiles/sealtest.dir/seal/galoiskeys.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/galoiskeys.cpp.o.d"
+  "CMakeFiles/sealtest.dir/seal/keygenerator.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/keygenerator.cpp.o.d"
+  "CMakeFiles/sealtest.dir/seal/lineartransform.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/lineartransform.cpp.o.d"
+  "CMakeFiles/sealtest.dir/seal/memorymanager.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/memorymanager.cpp.o.d"
+  "CMakeFiles/sealtest.dir/seal/modulus.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/modulus.cpp.o.d"
+  "CMakeFiles/sealtest.dir/seal/plaintext.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/plaintext.cpp.o.d"
+  "CMakeFiles/sealtest.dir/seal/publickey.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/publickey.cpp.o.d"
+  "CMakeFiles/sealtest.dir/seal/randomgen.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/randomgen.cpp.o.d"
+  "CMakeFiles/sealtest.dir/seal/randomtostd.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/randomtostd.cpp.o.d"
+  "CMakeFiles/sealtest.dir/seal/relinkeys.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/relinkeys.cpp.o.d"
+  "CMakeFiles/sealtest.dir/seal/rotationplan.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/rotationplan.cpp.o.d"
+  "CMakeFiles/sealtest.dir/seal/secretkey.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/secretkey.cpp.o.d"
+  "CMakeFiles/sealtest.dir/seal/serialization.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/serialization.cpp.o.d"
+  "CMakeFiles/sealtest.dir/seal/testrunner.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/testrunner.cpp.o.d"
+  "CMakeFiles/sealtest.dir/seal/util/clipnormal.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/util/clipnormal.cpp.o.d"
+  "CMakeFiles/sealtest.dir/seal/util/common.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/util/common.cpp.o.d"
+  "CMakeFiles/sealtest.dir/seal/util/fft.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/util/fft.cpp.o.d"
+  "CMakeFiles/sealtest.dir/seal/util/galois.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/util/galois.cpp.o.d"
+  "CMakeFiles/sealtest.dir/seal/util/hash.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/util/hash.cpp.o.d"
+  "CMakeFiles/sealtest.dir/seal/util/iterator.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/util/iterator.cpp.o.d"
+  "CMakeFiles/sealtest.dir/seal/util/locks.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/util/locks.cpp.o.d"
+  "CMakeFiles/sealtest.dir/seal/util/mempool.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/util/mempool.cpp.o.d"
+  "CMakeFiles/sealtest.dir/seal/util/ntt.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/util/ntt.cpp.o.d"
+  "CMakeFiles/sealtest.dir/seal/util/numth.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/util/numth.cpp.o.d"
+  "CMakeFiles/sealtest.dir/seal/util/polyarithsmallmod.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/util/polyarithsmallmod.cpp.o.d"
+  "CMakeFiles/sealtest.dir/seal/util/polycore.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/util/polycore.cpp.o.d"
+  "CMakeFiles/sealtest.dir/seal/util/polykernels.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/util/polykernels.cpp.o.d"
+  "CMakeFiles/sealtest.dir/seal/util/rns.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/util/rns.cpp.o.d"
+  "CMakeFiles/sealtest.dir/seal/util/stringtouint64.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/util/stringtouint64.cpp.o.d"
+  "CMakeFiles/sealtest.dir/seal/util/threadpool.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/util/threadpool.cpp.o.d"
+  "CMakeFiles/sealtest.dir/seal/util/uint64tostring.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/util/uint64tostring.cpp.o.d"
+  "CMakeFiles/sealtest.dir/seal/util/uintarith.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/util/uintarith.cpp.o.d"
+  "CMakeFiles/sealtest.dir/seal/util/uintarithmod.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/util/uintarithmod.cpp.o.d"
+  "CMakeFiles/sealtest.dir/seal/util/uintarithsmallmod.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/util/uintarithsmallmod.cpp.o.d"
+  "CMakeFiles/sealtest.dir/seal/util/uintcore.cpp.o"
+  "CMakeFiles/sealtest.dir/seal/util/uintcore.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/sealtest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,46 @@
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT license.
+
+# Check whether the compiler can build the AVX2 and AVX-512 kernels; whether the CPU supports them is checked at
+# run time.
+if(SEAL_USE_INTRIN AND CMAKE_SYSTEM_PROCESSOR MATCHES "^(x86_64|AMD64|amd64|x86|i686|i386)$")
+    if(MSVC)
+        set(SEAL_AVX2_FLAGS "/arch:AVX2")
+        set(SEAL_AVX2_FMA_FLAGS "/arch:AVX2")
+        set(SEAL_AVX512_FLAGS "/arch:AVX512")
+    else()
+        set(SEAL_AVX2_FLAGS "-mavx2")
+        set(SEAL_AVX2_FMA_FLAGS "-mavx2;-mfma")
+        set(SEAL_AVX512_FLAGS "-mavx512f;-mavx512dq;-mavx512ifma")
+    endif()
+
+    cmake_push_check_state(RESET)
+    set(CMAKE_REQUIRED_QUIET TRUE)
+    # The AVX2 FFT kernel also uses FMA
+    string(REPLACE ";" " " CMAKE_REQUIRED_FLAGS "${SEAL_AVX2_FMA_FLAGS}")
+    check_cxx_source_compiles("
+        #include <immintrin.h>
+        int main() {
+            __m256i a = _mm256_set1_epi64x(1);
+            a = _mm256_permute4x64_epi64(_mm256_mul_epu32(a, a), 0);
+            __m256d b = _mm256_fmadd_pd(_mm256_set1_pd(1.0), _mm256_set1_pd(1.0), _mm256_set1_pd(1.0));
+            return static_cast<int>(_mm256_extract_epi64(a, 0)) - static_cast<int>(_mm256_cvtsd_f64(b)) + 1;
+        }"
+        SEAL_AVX2_FOUND
+    )
+
+    string(REPLACE ";" " " CMAKE_REQUIRED_FLAGS "${SEAL_AVX512_FLAGS}")
+    check_cxx_source_compiles("
+        #include <immintrin.h>
+        int main() {
+            __m512i a = _mm512_set1_epi64(1);
+            a = _mm512_madd52lo_epu64(_mm512_mullo_epi64(a, a), a, a);
+            return static_cast<int>(_mm512_reduce_add_epi64(a)) - 16;
+        }"
+        SEAL_AVX512_FOUND
+    )
+    cmake_pop_check_state()
+else()
+    set(SEAL_AVX2_FOUND OFF)
+    set(SEAL_AVX512_FOUND OFF)
+endif()
@@ -0,0 +1,15 @@
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT license.
+
+# Check for madvise
+check_symbol_exists(madvise "sys/mman.h" SEAL_MADVISE_FOUND)
+
+# Check for anonymous memory mappings with transparent huge pages
+check_symbol_exists(mmap "sys/mman.h" SEAL_MMAP_FOUND)
+check_symbol_exists(MAP_ANONYMOUS "sys/mman.h" SEAL_MAP_ANONYMOUS_FOUND)
+check_symbol_exists(MADV_HUGEPAGE "sys/mman.h" SEAL_MADV_HUGEPAGE_FOUND)
+if(SEAL_MADVISE_FOUND AND SEAL_MMAP_FOUND AND SEAL_MAP_ANONYMOUS_FOUND AND SEAL_MADV_HUGEPAGE_FOUND)
+    set(SEAL_HUGE_PAGES_FOUND TRUE)
+else()
+    set(SEAL_HUGE_PAGES_FOUND FALSE)
+endif()
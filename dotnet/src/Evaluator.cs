@@ -938,7 +938,10 @@ namespace Microsoft.Research.SEAL
         /// </summary>
         /// <remarks>
         /// Multiplies a ciphertext with a plaintext. The plaintext cannot be identically 0. Dynamic memory allocations
-        /// in the process are allocated from the memory pool pointed to by the given MemoryPoolHandle.
+        /// in the process are allocated from the memory pool pointed to by the given MemoryPoolHandle. A ciphertext
+        /// that is not in NTT form can also be multiplied with a plaintext that has been transformed to NTT form at
+        /// the level of the ciphertext with TransformToNTTInplace, which avoids lifting and transforming the plaintext
+        /// on every call when the same plaintext multiplies many BFV or BGV ciphertexts.
         /// </remarks>
         /// <param name="encrypted">The ciphertext to multiply</param>
         /// <param name="plain">The plaintext to multiply</param>
@@ -946,7 +949,9 @@ namespace Microsoft.Research.SEAL
         /// <exception cref="ArgumentNullException">if encrypted or plain is null.</exception>
         /// <exception cref="ArgumentException">if encrypted or plain is not valid for the encryption
         /// parameters</exception>
-        /// <exception cref="ArgumentException">if encrypted and plain are in different NTT forms</exception>
+        /// <exception cref="ArgumentException">if encrypted is in NTT form and plain is not</exception>
+        /// <exception cref="ArgumentException">if plain is in NTT form and encrypted and plain are at different
+        /// levels</exception>
         /// <exception cref="ArgumentException">if the output scale is too large for the encryption
         /// parameters</exception>
         /// <exception cref="ArgumentException">if pool is uninitialized</exception>
@@ -971,7 +976,9 @@ namespace Microsoft.Research.SEAL
         /// <exception cref="ArgumentNullException">if encrypted, plain, or destination is null</exception>
         /// <exception cref="ArgumentException">if encrypted or plain is not valid for the encryption
         /// parameters</exception>
-        /// <exception cref="ArgumentException">if encrypted and plain are in different NTT forms</exception>
+        /// <exception cref="ArgumentException">if encrypted is in NTT form and plain is not</exception>
+        /// <exception cref="ArgumentException">if plain is in NTT form and encrypted and plain are at different
+        /// levels</exception>
         /// <exception cref="ArgumentException">if the output scale is too large for the encryption
         /// parameters</exception>
         /// <exception cref="ArgumentException">if pool is uninitialized</exception>
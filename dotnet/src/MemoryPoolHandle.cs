@@ -178,6 +178,95 @@ namespace Microsoft.Research.SEAL
             }
         }
 
+        /// <summary>
+        /// Returns the allocation statistics of the memory pool.
+        /// </summary>
+        /// <remarks>
+        /// This function returns the allocation statistics of the memory pool pointed
+        /// to by the current MemoryPoolHandle, or empty statistics if the MemoryPoolHandle
+        /// is uninitialized. The statistics of an item size start over when all of its
+        /// memory is freed. For size-class memory pools the allocations cached by threads
+        /// count as in use for the peak number of items in use, and the statistics are
+        /// approximate while other threads use the pool.
+        /// </remarks>
+        public MemoryPoolStats Stats
+        {
+            get
+            {
+                ulong[] byteCounts = new ulong[3];
+                ulong count = 0;
+                NativeMethods.MemoryPoolHandle_Stats(NativePtr, ref count, null, byteCounts);
+
+                // The pool may gain sizes between the calls
+                while (true)
+                {
+                    ulong capacity = count;
+                    ulong[] sizeClasses = new ulong[checked(6 * capacity)];
+                    NativeMethods.MemoryPoolHandle_Stats(NativePtr, ref count, sizeClasses, byteCounts);
+                    if (count <= capacity)
+                    {
+                        return new MemoryPoolStats(count, sizeClasses, byteCounts);
+                    }
+                }
+            }
+        }
+
+        /// <summary>
+        /// Starts tracing the allocations of the memory pool, discarding the previous
+        /// trace.
+        /// </summary>
+        /// <remarks>
+        /// Every samplePeriod-th allocation is recorded together with the Evaluator
+        /// function it is made for, and the trace keeps the most recent capacity
+        /// entries. Tracing makes all threads allocating from the pool update a shared
+        /// counter, so it should only be enabled while looking for allocation hot spots.
+        /// </remarks>
+        /// <param name="samplePeriod">The number of allocations per recorded allocation,
+        /// or zero to stop tracing</param>
+        /// <param name="capacity">The number of entries the trace keeps</param>
+        /// <exception cref="InvalidOperationException">if the MemoryPoolHandle is
+        /// uninitialized</exception>
+        /// <exception cref="ArgumentException">if samplePeriod is non-zero and capacity
+        /// is zero or too large</exception>
+        public void SetTrace(ulong samplePeriod, ulong capacity = 1024)
+        {
+            NativeMethods.MemoryPoolHandle_SetTrace(NativePtr, samplePeriod, capacity);
+        }
+
+        /// <summary>
+        /// Returns the entries of the allocation trace, oldest first, or an empty
+        /// trace if the MemoryPoolHandle is uninitialized.
+        /// </summary>
+        public MemoryPoolTraceEntry[] Trace
+        {
+            get
+            {
+                ulong count = 0;
+                NativeMethods.MemoryPoolHandle_Trace(NativePtr, ref count, null, null, null);
+
+                // The trace may grow between the calls
+                while (true)
+                {
+                    ulong capacity = count;
+                    ulong[] allocationIndices = new ulong[capacity];
+                    ulong[] byteCounts = new ulong[capacity];
+                    IntPtr[] functions = new IntPtr[capacity];
+                    NativeMethods.MemoryPoolHandle_Trace(
+                        NativePtr, ref count, allocationIndices, byteCounts, functions);
+                    if (count <= capacity)
+                    {
+                        MemoryPoolTraceEntry[] trace = new MemoryPoolTraceEntry[count];
+                        for (ulong i = 0; i < count; i++)
+                        {
+                            trace[i] = new MemoryPoolTraceEntry(
+                                allocationIndices[i], byteCounts[i], Marshal.PtrToStringAnsi(functions[i]));
+                        }
+                        return trace;
+                    }
+                }
+            }
+        }
+
         /// <summary>
         /// Returns the number of MemoryPoolHandle objects sharing this memory pool.
         /// </summary>
@@ -0,0 +1,94 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+namespace Microsoft.Research.SEAL
+{
+    /// <summary>
+    /// Allocation statistics of a memory pool, as returned by MemoryPoolHandle.Stats.
+    /// </summary>
+    /// <remarks>
+    /// A memory pool serves each allocation with an item of a fixed byte size that
+    /// is at least the requested size, and keeps the items that are no longer in use
+    /// cached for later allocations of the same size.
+    /// </remarks>
+    public class MemoryPoolStats
+    {
+        /// <summary>
+        /// Statistics of the items of one byte size.
+        /// </summary>
+        public class SizeClass
+        {
+            internal SizeClass(ulong[] values, int offset)
+            {
+                ItemByteCount = values[offset];
+                ItemCount = values[offset + 1];
+                ReuseCount = values[offset + 2];
+                FreshCount = values[offset + 3];
+                InUseCount = values[offset + 4];
+                PeakInUseCount = values[offset + 5];
+            }
+
+            /// <summary>
+            /// Returns the byte size of the items.
+            /// </summary>
+            public ulong ItemByteCount { get; }
+
+            /// <summary>
+            /// Returns the number of items allocated.
+            /// </summary>
+            public ulong ItemCount { get; }
+
+            /// <summary>
+            /// Returns the number of allocations served by items that were in use before.
+            /// </summary>
+            public ulong ReuseCount { get; }
+
+            /// <summary>
+            /// Returns the number of allocations served by items that were never in use before.
+            /// </summary>
+            public ulong FreshCount { get; }
+
+            /// <summary>
+            /// Returns the number of items in use.
+            /// </summary>
+            public ulong InUseCount { get; }
+
+            /// <summary>
+            /// Returns the largest number of items in use at the same time.
+            /// </summary>
+            public ulong PeakInUseCount { get; }
+        }
+
+        internal MemoryPoolStats(ulong count, ulong[] sizeClasses, ulong[] byteCounts)
+        {
+            SizeClasses = new SizeClass[count];
+            for (ulong i = 0; i < count; i++)
+            {
+                SizeClasses[i] = new SizeClass(sizeClasses, checked((int)(6 * i)));
+            }
+            AllocByteCount = byteCounts[0];
+            InUseByteCount = byteCounts[1];
+            CachedByteCount = byteCounts[2];
+        }
+
+        /// <summary>
+        /// Returns the statistics of each item byte size, in increasing order of byte size.
+        /// </summary>
+        public SizeClass[] SizeClasses { get; }
+
+        /// <summary>
+        /// Returns the number of bytes allocated.
+        /// </summary>
+        public ulong AllocByteCount { get; }
+
+        /// <summary>
+        /// Returns the number of allocated bytes in items in use.
+        /// </summary>
+        public ulong InUseByteCount { get; }
+
+        /// <summary>
+        /// Returns the number of allocated bytes in items cached for later allocations.
+        /// </summary>
+        public ulong CachedByteCount { get; }
+    }
+}
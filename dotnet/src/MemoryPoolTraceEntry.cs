@@ -0,0 +1,35 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+namespace Microsoft.Research.SEAL
+{
+    /// <summary>
+    /// A sampled allocation of a memory pool, as returned by MemoryPoolHandle.Trace.
+    /// </summary>
+    public class MemoryPoolTraceEntry
+    {
+        internal MemoryPoolTraceEntry(ulong allocationIndex, ulong byteCount, string function)
+        {
+            AllocationIndex = allocationIndex;
+            ByteCount = byteCount;
+            Function = function;
+        }
+
+        /// <summary>
+        /// Returns the index of the allocation among all allocations since tracing
+        /// was enabled.
+        /// </summary>
+        public ulong AllocationIndex { get; }
+
+        /// <summary>
+        /// Returns the number of bytes requested.
+        /// </summary>
+        public ulong ByteCount { get; }
+
+        /// <summary>
+        /// Returns the name of the Evaluator function the allocation was made for,
+        /// or null for allocations made elsewhere.
+        /// </summary>
+        public string Function { get; }
+    }
+}
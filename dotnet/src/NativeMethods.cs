@@ -869,6 +869,24 @@ namespace Microsoft.Research.SEAL
         [DllImport(sealc, PreserveSig = false)]
         internal static extern void MemoryPoolHandle_Equals(IntPtr thisptr, IntPtr otherptr, out bool result);
 
+        [DllImport(sealc, PreserveSig = false)]
+        internal static extern void MemoryPoolHandle_Stats(
+            IntPtr thisptr,
+            ref ulong count,
+            ulong[] sizeClasses,
+            ulong[] byteCounts);
+
+        [DllImport(sealc, PreserveSig = false)]
+        internal static extern void MemoryPoolHandle_SetTrace(IntPtr thisptr, ulong samplePeriod, ulong capacity);
+
+        [DllImport(sealc, PreserveSig = false)]
+        internal static extern void MemoryPoolHandle_Trace(
+            IntPtr thisptr,
+            ref ulong count,
+            ulong[] allocationIndices,
+            ulong[] byteCounts,
+            [MarshalAs(UnmanagedType.LPArray)] IntPtr[] functions);
+
 #endregion
 
 #region Encryptor methods
@@ -86,6 +86,64 @@ namespace SEALNetTest
             Assert.AreEqual(1L, pool.UseCount);
         }
 
+        [TestMethod]
+        public void StatsTest()
+        {
+            MemoryPoolHandle pool = MemoryPoolHandle.New();
+            Assert.AreEqual(0, pool.Stats.SizeClasses.Length);
+
+            Plaintext plain1 = new Plaintext(1000, pool);
+            Plaintext plain2 = new Plaintext(1000, pool);
+            plain2.Dispose();
+            plain2 = new Plaintext(1000, pool);
+
+            MemoryPoolStats stats = pool.Stats;
+            Assert.AreEqual(1, stats.SizeClasses.Length);
+            Assert.AreEqual(8000ul, stats.SizeClasses[0].ItemByteCount);
+            Assert.AreEqual(2ul, stats.SizeClasses[0].FreshCount);
+            Assert.AreEqual(1ul, stats.SizeClasses[0].ReuseCount);
+            Assert.AreEqual(2ul, stats.SizeClasses[0].InUseCount);
+            Assert.AreEqual(2ul, stats.SizeClasses[0].PeakInUseCount);
+            Assert.AreEqual(pool.AllocByteCount, stats.AllocByteCount);
+            Assert.AreEqual(16000ul, stats.InUseByteCount);
+            Assert.AreEqual(stats.AllocByteCount - 16000ul, stats.CachedByteCount);
+        }
+
+        [TestMethod]
+        public void TraceTest()
+        {
+            MemoryPoolHandle pool = MemoryPoolHandle.New();
+            Assert.AreEqual(0, pool.Trace.Length);
+
+            pool.SetTrace(samplePeriod: 1);
+            Plaintext plain = new Plaintext(1000, pool);
+            MemoryPoolTraceEntry[] trace = pool.Trace;
+            Assert.AreEqual(1, trace.Length);
+            Assert.AreEqual(0ul, trace[0].AllocationIndex);
+            Assert.AreEqual(8000ul, trace[0].ByteCount);
+            Assert.IsNull(trace[0].Function);
+
+            SEALContext context = GlobalContext.BFVContext;
+            KeyGenerator keygen = new KeyGenerator(context);
+            keygen.CreatePublicKey(out PublicKey publicKey);
+            Encryptor encryptor = new Encryptor(context, publicKey);
+            Evaluator evaluator = new Evaluator(context);
+            Ciphertext encrypted = new Ciphertext();
+            encryptor.Encrypt(new Plaintext("1x^1"), encrypted);
+
+            pool.SetTrace(samplePeriod: 1);
+            evaluator.SquareInplace(encrypted, pool);
+            trace = pool.Trace;
+            Assert.IsTrue(trace.Length > 0);
+            foreach (MemoryPoolTraceEntry entry in trace)
+            {
+                Assert.AreEqual("Evaluator::square_inplace", entry.Function);
+            }
+
+            pool.SetTrace(samplePeriod: 0);
+            Assert.AreEqual(0, pool.Trace.Length);
+        }
+
         [TestMethod]
         public void ExceptionsTest()
         {
@@ -94,6 +152,10 @@ namespace SEALNetTest
             Utilities.AssertThrows<ArgumentNullException>(() => handle = new MemoryPoolHandle(null));
 
             Utilities.AssertThrows<ArgumentNullException>(() => handle.Set(null));
+
+            Utilities.AssertThrows<InvalidOperationException>(() => handle.SetTrace(1));
+
+            Utilities.AssertThrows<ArgumentException>(() => MemoryPoolHandle.New().SetTrace(1, 0));
         }
     }
 }
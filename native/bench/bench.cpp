@@ -68,6 +68,7 @@ namespace sealbench
         SEAL_BENCHMARK_REGISTER(BFV, n, log_q, EncryptSecret, bm_bfv_encrypt_secret, bm_env_bfv);
         SEAL_BENCHMARK_REGISTER(BFV, n, log_q, EncryptPublic, bm_bfv_encrypt_public, bm_env_bfv);
         SEAL_BENCHMARK_REGISTER(BFV, n, log_q, Decrypt, bm_bfv_decrypt, bm_env_bfv);
+        SEAL_BENCHMARK_REGISTER(BFV, n, log_q, DecryptHPS, bm_bfv_decrypt_hps, bm_env_bfv);
         SEAL_BENCHMARK_REGISTER(BFV, n, log_q, EncodeBatch, bm_bfv_encode_batch, bm_env_bfv);
         SEAL_BENCHMARK_REGISTER(BFV, n, log_q, DecodeBatch, bm_bfv_decode_batch, bm_env_bfv);
         SEAL_BENCHMARK_REGISTER(BFV, n, log_q, EvaluateAddCt, bm_bfv_add_ct, bm_env_bfv);
@@ -76,8 +77,11 @@ namespace sealbench
         SEAL_BENCHMARK_REGISTER(BFV, n, log_q, EvaluateSubCt, bm_bfv_sub_ct, bm_env_bfv);
         SEAL_BENCHMARK_REGISTER(BFV, n, log_q, EvaluateSubPt, bm_bfv_sub_pt, bm_env_bfv);
         SEAL_BENCHMARK_REGISTER(BFV, n, log_q, EvaluateMulCt, bm_bfv_mul_ct, bm_env_bfv);
+        SEAL_BENCHMARK_REGISTER(BFV, n, log_q, EvaluateMulCtHPS, bm_bfv_mul_ct_hps, bm_env_bfv);
         SEAL_BENCHMARK_REGISTER(BFV, n, log_q, EvaluateMulPt, bm_bfv_mul_pt, bm_env_bfv);
+        SEAL_BENCHMARK_REGISTER(BFV, n, log_q, EvaluateMulPtNTT, bm_bfv_mul_pt_ntt, bm_env_bfv);
         SEAL_BENCHMARK_REGISTER(BFV, n, log_q, EvaluateSquare, bm_bfv_square, bm_env_bfv);
+        SEAL_BENCHMARK_REGISTER(BFV, n, log_q, EvaluateSquareHPS, bm_bfv_square_hps, bm_env_bfv);
         if (bm_env_bfv->context().first_context_data()->parms().coeff_modulus().size() > 1)
         {
             SEAL_BENCHMARK_REGISTER(BFV, n, log_q, EvaluateModSwitchInplace, bm_bfv_modswitch_inplace, bm_env_bfv);
@@ -126,6 +130,32 @@ namespace sealbench
         SEAL_BENCHMARK_REGISTER(CKKS, n, log_q, Decrypt, bm_ckks_decrypt, bm_env_ckks);
         SEAL_BENCHMARK_REGISTER(CKKS, n, log_q, EncodeDouble, bm_ckks_encode_double, bm_env_ckks);
         SEAL_BENCHMARK_REGISTER(CKKS, n, log_q, DecodeDouble, bm_ckks_decode_double, bm_env_ckks);
+
+        // Encoding and decoding with each FFT kernel the CPU supports; the cases above use the fastest kernel
+        SEAL_BENCHMARK_REGISTER(
+            CKKS, n, log_q, EncodeDoubleScalar, bm_ckks_encode_double_kernel, bm_env_ckks,
+            util::fft_kernel_type::scalar);
+        SEAL_BENCHMARK_REGISTER(
+            CKKS, n, log_q, DecodeDoubleScalar, bm_ckks_decode_double_kernel, bm_env_ckks,
+            util::fft_kernel_type::scalar);
+        if (util::fft_kernel_supported(util::fft_kernel_type::avx2))
+        {
+            SEAL_BENCHMARK_REGISTER(
+                CKKS, n, log_q, EncodeDoubleAVX2, bm_ckks_encode_double_kernel, bm_env_ckks,
+                util::fft_kernel_type::avx2);
+            SEAL_BENCHMARK_REGISTER(
+                CKKS, n, log_q, DecodeDoubleAVX2, bm_ckks_decode_double_kernel, bm_env_ckks,
+                util::fft_kernel_type::avx2);
+        }
+        if (util::fft_kernel_supported(util::fft_kernel_type::avx512))
+        {
+            SEAL_BENCHMARK_REGISTER(
+                CKKS, n, log_q, EncodeDoubleAVX512, bm_ckks_encode_double_kernel, bm_env_ckks,
+                util::fft_kernel_type::avx512);
+            SEAL_BENCHMARK_REGISTER(
+                CKKS, n, log_q, DecodeDoubleAVX512, bm_ckks_decode_double_kernel, bm_env_ckks,
+                util::fft_kernel_type::avx512);
+        }
         SEAL_BENCHMARK_REGISTER(CKKS, n, log_q, EvaluateAddCt, bm_ckks_add_ct, bm_env_ckks);
         SEAL_BENCHMARK_REGISTER(CKKS, n, log_q, EvaluateAddPt, bm_ckks_add_pt, bm_env_ckks);
         SEAL_BENCHMARK_REGISTER(CKKS, n, log_q, EvaluateNegate, bm_ckks_negate, bm_env_ckks);
@@ -149,6 +179,147 @@ namespace sealbench
         SEAL_BENCHMARK_REGISTER(UTIL, n, 0, NTTInverseLowLevel, bm_util_ntt_inverse_low_level, bm_env_bfv);
         SEAL_BENCHMARK_REGISTER(UTIL, n, 0, NTTForwardLowLevelLazy, bm_util_ntt_forward_low_level_lazy, bm_env_bfv);
         SEAL_BENCHMARK_REGISTER(UTIL, n, 0, NTTInverseLowLevelLazy, bm_util_ntt_inverse_low_level_lazy, bm_env_bfv);
+
+        // The lazy NTT with each kernel the CPU supports, modulo the benchmark's first prime and modulo a narrow 30-bit
+        // prime; the cases above use the fastest kernel
+        SEAL_BENCHMARK_REGISTER(
+            UTIL, n, 0, NTTForwardLowLevelLazyScalar, bm_util_ntt_forward_low_level_lazy_kernel, bm_env_bfv,
+            util::ntt_kernel_type::scalar);
+        SEAL_BENCHMARK_REGISTER(
+            UTIL, n, 0, NTTInverseLowLevelLazyScalar, bm_util_ntt_inverse_low_level_lazy_kernel, bm_env_bfv,
+            util::ntt_kernel_type::scalar);
+        SEAL_BENCHMARK_REGISTER(
+            UTIL, n, 30, NTTForwardLowLevelLazyNarrowScalar, bm_util_ntt_forward_low_level_lazy_narrow, bm_env_bfv,
+            util::ntt_kernel_type::scalar);
+        SEAL_BENCHMARK_REGISTER(
+            UTIL, n, 30, NTTInverseLowLevelLazyNarrowScalar, bm_util_ntt_inverse_low_level_lazy_narrow, bm_env_bfv,
+            util::ntt_kernel_type::scalar);
+        if (util::ntt_kernel_supported(util::ntt_kernel_type::avx2))
+        {
+            SEAL_BENCHMARK_REGISTER(
+                UTIL, n, 0, NTTForwardLowLevelLazyAVX2, bm_util_ntt_forward_low_level_lazy_kernel, bm_env_bfv,
+                util::ntt_kernel_type::avx2);
+            SEAL_BENCHMARK_REGISTER(
+                UTIL, n, 0, NTTInverseLowLevelLazyAVX2, bm_util_ntt_inverse_low_level_lazy_kernel, bm_env_bfv,
+                util::ntt_kernel_type::avx2);
+            SEAL_BENCHMARK_REGISTER(
+                UTIL, n, 30, NTTForwardLowLevelLazyNarrowAVX2, bm_util_ntt_forward_low_level_lazy_narrow, bm_env_bfv,
+                util::ntt_kernel_type::avx2);
+            SEAL_BENCHMARK_REGISTER(
+                UTIL, n, 30, NTTInverseLowLevelLazyNarrowAVX2, bm_util_ntt_inverse_low_level_lazy_narrow, bm_env_bfv,
+                util::ntt_kernel_type::avx2);
+        }
+        if (util::ntt_kernel_supported(util::ntt_kernel_type::avx512))
+        {
+            SEAL_BENCHMARK_REGISTER(
+                UTIL, n, 0, NTTForwardLowLevelLazyAVX512, bm_util_ntt_forward_low_level_lazy_kernel, bm_env_bfv,
+                util::ntt_kernel_type::avx512);
+            SEAL_BENCHMARK_REGISTER(
+                UTIL, n, 0, NTTInverseLowLevelLazyAVX512, bm_util_ntt_inverse_low_level_lazy_kernel, bm_env_bfv,
+                util::ntt_kernel_type::avx512);
+            SEAL_BENCHMARK_REGISTER(
+                UTIL, n, 30, NTTForwardLowLevelLazyNarrowAVX512, bm_util_ntt_forward_low_level_lazy_narrow, bm_env_bfv,
+                util::ntt_kernel_type::avx512);
+            SEAL_BENCHMARK_REGISTER(
+                UTIL, n, 30, NTTInverseLowLevelLazyNarrowAVX512, bm_util_ntt_inverse_low_level_lazy_narrow, bm_env_bfv,
+                util::ntt_kernel_type::avx512);
+        }
+        if (util::ntt_kernel_supported(util::ntt_kernel_type::avx512ifma))
+        {
+            SEAL_BENCHMARK_REGISTER(
+                UTIL, n, 0, NTTForwardLowLevelLazyAVX512IFMA, bm_util_ntt_forward_low_level_lazy_kernel, bm_env_bfv,
+                util::ntt_kernel_type::avx512ifma);
+            SEAL_BENCHMARK_REGISTER(
+                UTIL, n, 0, NTTInverseLowLevelLazyAVX512IFMA, bm_util_ntt_inverse_low_level_lazy_kernel, bm_env_bfv,
+                util::ntt_kernel_type::avx512ifma);
+            SEAL_BENCHMARK_REGISTER(
+                UTIL, n, 30, NTTForwardLowLevelLazyNarrowAVX512IFMA, bm_util_ntt_forward_low_level_lazy_narrow,
+                bm_env_bfv, util::ntt_kernel_type::avx512ifma);
+            SEAL_BENCHMARK_REGISTER(
+                UTIL, n, 30, NTTInverseLowLevelLazyNarrowAVX512IFMA, bm_util_ntt_inverse_low_level_lazy_narrow,
+                bm_env_bfv, util::ntt_kernel_type::avx512ifma);
+        }
+
+        // Element-wise arithmetic modulo a single prime of each bit count, with each kernel the CPU supports
+        for (int bit_count : { 30, 50, 60 })
+        {
+            SEAL_BENCHMARK_REGISTER(
+                UTIL, n, bit_count, AddPolyScalar, bm_util_add_poly_coeffmod, bm_env_bfv, bit_count,
+                util::polyarith_kernel_type::scalar);
+            SEAL_BENCHMARK_REGISTER(
+                UTIL, n, bit_count, SubPolyScalar, bm_util_sub_poly_coeffmod, bm_env_bfv, bit_count,
+                util::polyarith_kernel_type::scalar);
+            SEAL_BENCHMARK_REGISTER(
+                UTIL, n, bit_count, MultiplyPolyScalarScalar, bm_util_multiply_poly_scalar_coeffmod, bm_env_bfv,
+                bit_count, util::polyarith_kernel_type::scalar);
+            SEAL_BENCHMARK_REGISTER(
+                UTIL, n, bit_count, DyadicProductScalar, bm_util_dyadic_product_coeffmod, bm_env_bfv, bit_count,
+                util::polyarith_kernel_type::scalar);
+            SEAL_BENCHMARK_REGISTER(
+                UTIL, n, bit_count, DyadicProductMontgomery, bm_util_dyadic_product_montgomery_coeffmod, bm_env_bfv,
+                bit_count);
+            if (util::polyarith_kernel_supported(util::polyarith_kernel_type::avx2))
+            {
+                SEAL_BENCHMARK_REGISTER(
+                    UTIL, n, bit_count, AddPolyAVX2, bm_util_add_poly_coeffmod, bm_env_bfv, bit_count,
+                    util::polyarith_kernel_type::avx2);
+                SEAL_BENCHMARK_REGISTER(
+                    UTIL, n, bit_count, SubPolyAVX2, bm_util_sub_poly_coeffmod, bm_env_bfv, bit_count,
+                    util::polyarith_kernel_type::avx2);
+                SEAL_BENCHMARK_REGISTER(
+                    UTIL, n, bit_count, MultiplyPolyScalarAVX2, bm_util_multiply_poly_scalar_coeffmod, bm_env_bfv,
+                    bit_count, util::polyarith_kernel_type::avx2);
+                SEAL_BENCHMARK_REGISTER(
+                    UTIL, n, bit_count, DyadicProductAVX2, bm_util_dyadic_product_coeffmod, bm_env_bfv, bit_count,
+                    util::polyarith_kernel_type::avx2);
+            }
+            if (util::polyarith_kernel_supported(util::polyarith_kernel_type::avx512))
+            {
+                SEAL_BENCHMARK_REGISTER(
+                    UTIL, n, bit_count, AddPolyAVX512, bm_util_add_poly_coeffmod, bm_env_bfv, bit_count,
+                    util::polyarith_kernel_type::avx512);
+                SEAL_BENCHMARK_REGISTER(
+                    UTIL, n, bit_count, SubPolyAVX512, bm_util_sub_poly_coeffmod, bm_env_bfv, bit_count,
+                    util::polyarith_kernel_type::avx512);
+                SEAL_BENCHMARK_REGISTER(
+                    UTIL, n, bit_count, MultiplyPolyScalarAVX512, bm_util_multiply_poly_scalar_coeffmod, bm_env_bfv,
+                    bit_count, util::polyarith_kernel_type::avx512);
+                SEAL_BENCHMARK_REGISTER(
+                    UTIL, n, bit_count, DyadicProductAVX512, bm_util_dyadic_product_coeffmod, bm_env_bfv, bit_count,
+                    util::polyarith_kernel_type::avx512);
+            }
+        }
+
+        // Fast base conversions of the sizes in BFV multiplication (BEHZ), i.e., from q to Bsk = B U {m_sk} and from B
+        // to q, where B has as many primes as q, with each kernel the CPU supports. The AVX2 kernel is only used for
+        // input bases of at most 8 primes; with more primes the AVX2 cases measure the scalar path, which was faster
+        // (n = 8192, 60-bit primes, ibase x obase: 8x9 760 us scalar, 739 us AVX2; 15x16 2191 us scalar, 2340 us AVX2).
+        // Input and output primes below 2^30 take the narrow 32-bit lane products with any number of primes.
+        size_t q_size = max<size_t>(bm_env_bfv->parms().coeff_modulus().size() - 1, 1);
+        SEAL_BENCHMARK_REGISTER(
+            UTIL, n, log_q, BaseConvertQToBskScalar, bm_util_fast_convert_array, bm_env_bfv, q_size, q_size + 1,
+            util::polyarith_kernel_type::scalar);
+        SEAL_BENCHMARK_REGISTER(
+            UTIL, n, log_q, BaseConvertBToQScalar, bm_util_fast_convert_array, bm_env_bfv, q_size, q_size,
+            util::polyarith_kernel_type::scalar);
+        if (util::polyarith_kernel_supported(util::polyarith_kernel_type::avx2))
+        {
+            SEAL_BENCHMARK_REGISTER(
+                UTIL, n, log_q, BaseConvertQToBskAVX2, bm_util_fast_convert_array, bm_env_bfv, q_size, q_size + 1,
+                util::polyarith_kernel_type::avx2);
+            SEAL_BENCHMARK_REGISTER(
+                UTIL, n, log_q, BaseConvertBToQAVX2, bm_util_fast_convert_array, bm_env_bfv, q_size, q_size,
+                util::polyarith_kernel_type::avx2);
+        }
+        if (util::polyarith_kernel_supported(util::polyarith_kernel_type::avx512))
+        {
+            SEAL_BENCHMARK_REGISTER(
+                UTIL, n, log_q, BaseConvertQToBskAVX512, bm_util_fast_convert_array, bm_env_bfv, q_size, q_size + 1,
+                util::polyarith_kernel_type::avx512);
+            SEAL_BENCHMARK_REGISTER(
+                UTIL, n, log_q, BaseConvertBToQAVX512, bm_util_fast_convert_array, bm_env_bfv, q_size, q_size,
+                util::polyarith_kernel_type::avx512);
+        }
     }
 
 } // namespace sealbench
@@ -16,6 +16,7 @@
 #endif
 
 #include "seal/seal.h"
+#include "seal/util/polyarithsmallmod.h"
 #include "seal/util/rlwe.h"
 
 namespace sealbench
@@ -346,6 +347,35 @@ namespace sealbench
     void bm_util_ntt_inverse_low_level(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
     void bm_util_ntt_forward_low_level_lazy(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
     void bm_util_ntt_inverse_low_level_lazy(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
+    void bm_util_ntt_forward_low_level_lazy_kernel(
+        benchmark::State &state, std::shared_ptr<BMEnv> bm_env, seal::util::ntt_kernel_type kernel);
+    void bm_util_ntt_inverse_low_level_lazy_kernel(
+        benchmark::State &state, std::shared_ptr<BMEnv> bm_env, seal::util::ntt_kernel_type kernel);
+    void bm_util_ntt_forward_low_level_lazy_narrow(
+        benchmark::State &state, std::shared_ptr<BMEnv> bm_env, seal::util::ntt_kernel_type kernel);
+    void bm_util_ntt_inverse_low_level_lazy_narrow(
+        benchmark::State &state, std::shared_ptr<BMEnv> bm_env, seal::util::ntt_kernel_type kernel);
+
+    // Element-wise polynomial arithmetic benchmark cases
+    void bm_util_add_poly_coeffmod(
+        benchmark::State &state, std::shared_ptr<BMEnv> bm_env, int bit_count,
+        seal::util::polyarith_kernel_type kernel);
+    void bm_util_sub_poly_coeffmod(
+        benchmark::State &state, std::shared_ptr<BMEnv> bm_env, int bit_count,
+        seal::util::polyarith_kernel_type kernel);
+    void bm_util_multiply_poly_scalar_coeffmod(
+        benchmark::State &state, std::shared_ptr<BMEnv> bm_env, int bit_count,
+        seal::util::polyarith_kernel_type kernel);
+    void bm_util_dyadic_product_coeffmod(
+        benchmark::State &state, std::shared_ptr<BMEnv> bm_env, int bit_count,
+        seal::util::polyarith_kernel_type kernel);
+    void bm_util_dyadic_product_montgomery_coeffmod(
+        benchmark::State &state, std::shared_ptr<BMEnv> bm_env, int bit_count);
+
+    // RNS base conversion benchmark cases
+    void bm_util_fast_convert_array(
+        benchmark::State &state, std::shared_ptr<BMEnv> bm_env, std::size_t ibase_size, std::size_t obase_size,
+        seal::util::polyarith_kernel_type kernel);
 
     // KeyGen benchmark cases
     void bm_keygen_secret(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
@@ -357,6 +387,7 @@ namespace sealbench
     void bm_bfv_encrypt_secret(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
     void bm_bfv_encrypt_public(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
     void bm_bfv_decrypt(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
+    void bm_bfv_decrypt_hps(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
     void bm_bfv_encode_batch(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
     void bm_bfv_decode_batch(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
     void bm_bfv_add_ct(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
@@ -365,8 +396,11 @@ namespace sealbench
     void bm_bfv_sub_ct(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
     void bm_bfv_sub_pt(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
     void bm_bfv_mul_ct(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
+    void bm_bfv_mul_ct_hps(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
     void bm_bfv_mul_pt(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
+    void bm_bfv_mul_pt_ntt(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
     void bm_bfv_square(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
+    void bm_bfv_square_hps(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
     void bm_bfv_modswitch_inplace(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
     void bm_bfv_relin_inplace(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
     void bm_bfv_rotate_rows(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
@@ -405,6 +439,10 @@ namespace sealbench
     void bm_ckks_decrypt(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
     void bm_ckks_encode_double(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
     void bm_ckks_decode_double(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
+    void bm_ckks_encode_double_kernel(
+        benchmark::State &state, std::shared_ptr<BMEnv> bm_env, seal::util::fft_kernel_type kernel);
+    void bm_ckks_decode_double_kernel(
+        benchmark::State &state, std::shared_ptr<BMEnv> bm_env, seal::util::fft_kernel_type kernel);
     void bm_ckks_add_ct(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
     void bm_ckks_add_pt(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
     void bm_ckks_negate(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
@@ -58,6 +58,23 @@ namespace sealbench
         }
     }
 
+    void bm_bfv_decrypt_hps(State &state, shared_ptr<BMEnv> bm_env)
+    {
+        SEALContext context = bm_env->context();
+        context.set_rns_method(rns_method_type::hps);
+        Decryptor decryptor(context, bm_env->sk());
+        vector<Ciphertext> &ct = bm_env->ct();
+        Plaintext &pt = bm_env->pt()[0];
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            bm_env->randomize_ct_bfv(ct[0]);
+
+            state.ResumeTiming();
+            decryptor.decrypt(ct[0], pt);
+        }
+    }
+
     void bm_bfv_encode_batch(State &state, shared_ptr<BMEnv> bm_env)
     {
         vector<uint64_t> &msg = bm_env->msg_uint64();
@@ -171,6 +188,23 @@ namespace sealbench
         }
     }
 
+    void bm_bfv_mul_ct_hps(State &state, shared_ptr<BMEnv> bm_env)
+    {
+        SEALContext context = bm_env->context();
+        context.set_rns_method(rns_method_type::hps);
+        Evaluator evaluator(context);
+        vector<Ciphertext> &ct = bm_env->ct();
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            bm_env->randomize_ct_bfv(ct[0]);
+            bm_env->randomize_ct_bfv(ct[1]);
+
+            state.ResumeTiming();
+            evaluator.multiply(ct[0], ct[1], ct[2]);
+        }
+    }
+
     void bm_bfv_mul_pt(State &state, shared_ptr<BMEnv> bm_env)
     {
         vector<Ciphertext> &ct = bm_env->ct();
@@ -186,6 +220,24 @@ namespace sealbench
         }
     }
 
+    void bm_bfv_mul_pt_ntt(State &state, shared_ptr<BMEnv> bm_env)
+    {
+        vector<Ciphertext> &ct = bm_env->ct();
+        Plaintext &pt = bm_env->pt()[0];
+        Plaintext pt_ntt;
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            bm_env->randomize_ct_bfv(ct[0]);
+            bm_env->randomize_pt_bfv(pt);
+            pt_ntt = pt;
+            bm_env->evaluator()->transform_to_ntt_inplace(pt_ntt, ct[0].parms_id());
+
+            state.ResumeTiming();
+            bm_env->evaluator()->multiply_plain(ct[0], pt_ntt, ct[2]);
+        }
+    }
+
     void bm_bfv_square(State &state, shared_ptr<BMEnv> bm_env)
     {
         vector<Ciphertext> &ct = bm_env->ct();
@@ -200,6 +252,22 @@ namespace sealbench
         }
     }
 
+    void bm_bfv_square_hps(State &state, shared_ptr<BMEnv> bm_env)
+    {
+        SEALContext context = bm_env->context();
+        context.set_rns_method(rns_method_type::hps);
+        Evaluator evaluator(context);
+        vector<Ciphertext> &ct = bm_env->ct();
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            bm_env->randomize_ct_bfv(ct[0]);
+
+            state.ResumeTiming();
+            evaluator.square(ct[0], ct[2]);
+        }
+    }
+
     void bm_bfv_modswitch_inplace(State &state, shared_ptr<BMEnv> bm_env)
     {
         vector<Ciphertext> &ct = bm_env->ct();
@@ -88,6 +88,22 @@ namespace sealbench
         }
     }
 
+    void bm_ckks_encode_double_kernel(State &state, shared_ptr<BMEnv> bm_env, util::fft_kernel_type kernel)
+    {
+        util::fft_kernel_type default_kernel = util::get_fft_kernel();
+        util::set_fft_kernel(kernel);
+        bm_ckks_encode_double(state, bm_env);
+        util::set_fft_kernel(default_kernel);
+    }
+
+    void bm_ckks_decode_double_kernel(State &state, shared_ptr<BMEnv> bm_env, util::fft_kernel_type kernel)
+    {
+        util::fft_kernel_type default_kernel = util::get_fft_kernel();
+        util::set_fft_kernel(kernel);
+        bm_ckks_decode_double(state, bm_env);
+        util::set_fft_kernel(default_kernel);
+    }
+
     void bm_ckks_add_ct(State &state, shared_ptr<BMEnv> bm_env)
     {
         vector<Ciphertext> &ct = bm_env->ct();
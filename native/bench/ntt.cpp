@@ -106,4 +106,64 @@ namespace sealbench
             inverse_ntt_negacyclic_harvey_lazy(ct[0].data(), small_ntt_tables[0]);
         }
     }
+
+    void bm_util_ntt_forward_low_level_lazy_kernel(State &state, shared_ptr<BMEnv> bm_env, util::ntt_kernel_type kernel)
+    {
+        util::ntt_kernel_type default_kernel = util::get_ntt_kernel();
+        util::set_ntt_kernel(kernel);
+        bm_util_ntt_forward_low_level_lazy(state, bm_env);
+        util::set_ntt_kernel(default_kernel);
+    }
+
+    void bm_util_ntt_inverse_low_level_lazy_kernel(State &state, shared_ptr<BMEnv> bm_env, util::ntt_kernel_type kernel)
+    {
+        util::ntt_kernel_type default_kernel = util::get_ntt_kernel();
+        util::set_ntt_kernel(kernel);
+        bm_util_ntt_inverse_low_level_lazy(state, bm_env);
+        util::set_ntt_kernel(default_kernel);
+    }
+
+    namespace
+    {
+        // Runs the lazy forward or inverse NTT modulo a 30-bit prime, which is narrow for the AVX2 and AVX-512 kernels
+        void bm_util_ntt_low_level_lazy_narrow(
+            State &state, shared_ptr<BMEnv> bm_env, util::ntt_kernel_type kernel, bool inverse)
+        {
+            size_t coeff_count = bm_env->parms().poly_modulus_degree();
+            Modulus modulus = CoeffModulus::Create(coeff_count, { 30 })[0];
+            util::NTTTables tables(util::get_power_of_two(coeff_count), modulus);
+            vector<uint64_t> values(coeff_count);
+
+            util::ntt_kernel_type default_kernel = util::get_ntt_kernel();
+            util::set_ntt_kernel(kernel);
+            for (auto _ : state)
+            {
+                state.PauseTiming();
+                bm_env->randomize_array_mod(values.data(), coeff_count, modulus);
+
+                state.ResumeTiming();
+                if (inverse)
+                {
+                    util::inverse_ntt_negacyclic_harvey_lazy(values.data(), tables);
+                }
+                else
+                {
+                    util::ntt_negacyclic_harvey_lazy(values.data(), tables);
+                }
+            }
+            util::set_ntt_kernel(default_kernel);
+        }
+    } // namespace
+
+    void bm_util_ntt_forward_low_level_lazy_narrow(
+        State &state, shared_ptr<BMEnv> bm_env, util::ntt_kernel_type kernel)
+    {
+        bm_util_ntt_low_level_lazy_narrow(state, bm_env, kernel, false);
+    }
+
+    void bm_util_ntt_inverse_low_level_lazy_narrow(
+        State &state, shared_ptr<BMEnv> bm_env, util::ntt_kernel_type kernel)
+    {
+        bm_util_ntt_low_level_lazy_narrow(state, bm_env, kernel, true);
+    }
 } // namespace sealbench
@@ -0,0 +1,84 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/seal.h"
+#include "seal/util/polyarithsmallmod.h"
+#include "bench.h"
+
+using namespace benchmark;
+using namespace sealbench;
+using namespace seal;
+using namespace std;
+
+/**
+This file defines benchmarks for element-wise polynomial arithmetic on a single RNS component.
+*/
+
+namespace sealbench
+{
+    namespace
+    {
+        /**
+        Runs op on two random polynomials of the benchmark's degree modulo a prime of the given bit count, with the
+        given polynomial arithmetic kernel selected.
+        */
+        template <typename PolyArithOp>
+        void bm_util_polyarith(
+            State &state, shared_ptr<BMEnv> bm_env, int bit_count, util::polyarith_kernel_type kernel, PolyArithOp op)
+        {
+            size_t coeff_count = bm_env->parms().poly_modulus_degree();
+            Modulus modulus = CoeffModulus::Create(coeff_count, { bit_count })[0];
+            vector<uint64_t> operand1(coeff_count), operand2(coeff_count), result(coeff_count);
+            bm_env->randomize_array_mod(operand1.data(), coeff_count, modulus);
+            bm_env->randomize_array_mod(operand2.data(), coeff_count, modulus);
+
+            util::polyarith_kernel_type default_kernel = util::get_polyarith_kernel();
+            util::set_polyarith_kernel(kernel);
+            for (auto _ : state)
+            {
+                op(operand1.data(), operand2.data(), coeff_count, modulus, result.data());
+            }
+            util::set_polyarith_kernel(default_kernel);
+        }
+    } // namespace
+
+    void bm_util_add_poly_coeffmod(
+        State &state, shared_ptr<BMEnv> bm_env, int bit_count, util::polyarith_kernel_type kernel)
+    {
+        bm_util_polyarith(state, bm_env, bit_count, kernel, [](auto... args) { util::add_poly_coeffmod(args...); });
+    }
+
+    void bm_util_sub_poly_coeffmod(
+        State &state, shared_ptr<BMEnv> bm_env, int bit_count, util::polyarith_kernel_type kernel)
+    {
+        bm_util_polyarith(state, bm_env, bit_count, kernel, [](auto... args) { util::sub_poly_coeffmod(args...); });
+    }
+
+    void bm_util_multiply_poly_scalar_coeffmod(
+        State &state, shared_ptr<BMEnv> bm_env, int bit_count, util::polyarith_kernel_type kernel)
+    {
+        bm_util_polyarith(
+            state, bm_env, bit_count, kernel,
+            [](const uint64_t *operand1, const uint64_t *operand2, size_t coeff_count, const Modulus &modulus,
+               uint64_t *result) {
+                util::MultiplyUIntModOperand scalar;
+                scalar.set(operand2[0], modulus);
+                util::multiply_poly_scalar_coeffmod(operand1, coeff_count, scalar, modulus, result);
+            });
+    }
+
+    void bm_util_dyadic_product_coeffmod(
+        State &state, shared_ptr<BMEnv> bm_env, int bit_count, util::polyarith_kernel_type kernel)
+    {
+        bm_util_polyarith(
+            state, bm_env, bit_count, kernel, [](auto... args) { util::dyadic_product_coeffmod(args...); });
+    }
+
+    void bm_util_dyadic_product_montgomery_coeffmod(State &state, shared_ptr<BMEnv> bm_env, int bit_count)
+    {
+        // The second operand is taken to be in Montgomery form already, as in Evaluator::multiply
+        bm_util_polyarith(
+            state, bm_env, bit_count, util::polyarith_kernel_type::scalar,
+            [](auto... args) { util::dyadic_product_montgomery_coeffmod(args...); });
+    }
+} // namespace sealbench
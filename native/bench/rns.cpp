@@ -0,0 +1,47 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/seal.h"
+#include "seal/util/polyarithsmallmod.h"
+#include "seal/util/rns.h"
+#include "bench.h"
+
+using namespace benchmark;
+using namespace sealbench;
+using namespace seal;
+using namespace std;
+
+/**
+This file defines benchmarks for RNS base conversion.
+*/
+
+namespace sealbench
+{
+    void bm_util_fast_convert_array(
+        State &state, shared_ptr<BMEnv> bm_env, size_t ibase_size, size_t obase_size,
+        util::polyarith_kernel_type kernel)
+    {
+        // Distinct 60-bit primes for both bases, as for the coefficient modulus and the auxiliary bases of BFV
+        size_t coeff_count = bm_env->parms().poly_modulus_degree();
+        vector<Modulus> primes = CoeffModulus::Create(coeff_count, vector<int>(ibase_size + obase_size, 60));
+        MemoryPoolHandle pool = seal::MemoryManager::GetPool();
+        util::RNSBase ibase(vector<Modulus>(primes.begin(), primes.begin() + ibase_size), pool);
+        util::RNSBase obase(vector<Modulus>(primes.begin() + ibase_size, primes.end()), pool);
+        util::BaseConverter conv(ibase, obase, pool);
+
+        vector<uint64_t> in(coeff_count * ibase_size), out(coeff_count * obase_size);
+        for (size_t i = 0; i < ibase_size; i++)
+        {
+            bm_env->randomize_array_mod(in.data() + i * coeff_count, coeff_count, ibase[i]);
+        }
+
+        util::polyarith_kernel_type default_kernel = util::get_polyarith_kernel();
+        util::set_polyarith_kernel(kernel);
+        for (auto _ : state)
+        {
+            conv.fast_convert_array(
+                util::ConstRNSIter(in.data(), coeff_count), util::RNSIter(out.data(), coeff_count), pool);
+        }
+        util::set_polyarith_kernel(default_kernel);
+    }
+} // namespace sealbench
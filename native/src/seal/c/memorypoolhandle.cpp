@@ -133,3 +133,91 @@ SEAL_C_FUNC MemoryPoolHandle_Equals(void *thisptr, void *otherptr, bool *result)
     *result = (*pool == *other);
     return S_OK;
 }
+
+SEAL_C_FUNC MemoryPoolHandle_Stats(void *thisptr, uint64_t *count, uint64_t *size_classes, uint64_t *byte_counts)
+{
+    MemoryPoolHandle *pool = FromVoid<MemoryPoolHandle>(thisptr);
+    IfNullRet(pool, E_POINTER);
+    IfNullRet(count, E_POINTER);
+
+    MemoryPoolStats stats = pool->stats();
+    uint64_t capacity = *count;
+    *count = stats.size_classes.size();
+
+    if (nullptr != byte_counts)
+    {
+        byte_counts[0] = stats.alloc_byte_count;
+        byte_counts[1] = stats.in_use_byte_count;
+        byte_counts[2] = stats.cached_byte_count;
+    }
+
+    if (nullptr == size_classes)
+    {
+        // We only wanted the count.
+        return S_OK;
+    }
+
+    // The pool may have gained size classes since the count was queried; only capacity of them fit
+    for (uint64_t i = 0; i < *count && i < capacity; i++)
+    {
+        const auto &size_class = stats.size_classes[i];
+        uint64_t *dest = size_classes + 6 * i;
+        dest[0] = size_class.item_byte_count;
+        dest[1] = size_class.item_count;
+        dest[2] = size_class.reuse_count;
+        dest[3] = size_class.fresh_count;
+        dest[4] = size_class.in_use_count;
+        dest[5] = size_class.peak_in_use_count;
+    }
+
+    return S_OK;
+}
+
+SEAL_C_FUNC MemoryPoolHandle_SetTrace(void *thisptr, uint64_t sample_period, uint64_t capacity)
+{
+    MemoryPoolHandle *pool = FromVoid<MemoryPoolHandle>(thisptr);
+    IfNullRet(pool, E_POINTER);
+
+    try
+    {
+        pool->set_trace(sample_period, util::safe_cast<size_t>(capacity));
+        return S_OK;
+    }
+    catch (const invalid_argument &)
+    {
+        return E_INVALIDARG;
+    }
+    catch (const logic_error &)
+    {
+        return COR_E_INVALIDOPERATION;
+    }
+}
+
+SEAL_C_FUNC MemoryPoolHandle_Trace(
+    void *thisptr, uint64_t *count, uint64_t *allocation_indices, uint64_t *byte_counts, char **functions)
+{
+    MemoryPoolHandle *pool = FromVoid<MemoryPoolHandle>(thisptr);
+    IfNullRet(pool, E_POINTER);
+    IfNullRet(count, E_POINTER);
+
+    vector<MemoryPoolTraceEntry> trace = pool->trace();
+    uint64_t capacity = *count;
+    *count = trace.size();
+
+    if (nullptr == allocation_indices || nullptr == byte_counts || nullptr == functions)
+    {
+        // We only wanted the count.
+        return S_OK;
+    }
+
+    // The trace may have grown since the count was queried; only capacity of its entries fit. The function names
+    // are string literals, so the pointers stay valid.
+    for (uint64_t i = 0; i < *count && i < capacity; i++)
+    {
+        allocation_indices[i] = trace[i].allocation_index;
+        byte_counts[i] = trace[i].byte_count;
+        functions[i] = const_cast<char *>(trace[i].function);
+    }
+
+    return S_OK;
+}
@@ -36,3 +36,10 @@ SEAL_C_FUNC MemoryPoolHandle_UseCount(void *thisptr, long *count);
 SEAL_C_FUNC MemoryPoolHandle_IsInitialized(void *thisptr, bool *result);
 
 SEAL_C_FUNC MemoryPoolHandle_Equals(void *thisptr, void *otherptr, bool *result);
+
+SEAL_C_FUNC MemoryPoolHandle_Stats(void *thisptr, uint64_t *count, uint64_t *size_classes, uint64_t *byte_counts);
+
+SEAL_C_FUNC MemoryPoolHandle_SetTrace(void *thisptr, uint64_t sample_period, uint64_t capacity);
+
+SEAL_C_FUNC MemoryPoolHandle_Trace(
+    void *thisptr, uint64_t *count, uint64_t *allocation_indices, uint64_t *byte_counts, char **functions);
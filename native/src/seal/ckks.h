@@ -9,6 +9,7 @@
 #include "seal/util/croots.h"
 #include "seal/util/defines.h"
 #include "seal/util/dwthandler.h"
+#include "seal/util/fft.h"
 #include "seal/util/uintarithsmallmod.h"
 #include "seal/util/uintcore.h"
 #include <cmath>
@@ -105,9 +106,6 @@ namespace seal
     */
     class CKKSEncoder
     {
-        using ComplexArith = util::Arithmetic<std::complex<double>, std::complex<double>, double>;
-        using FFTHandler = util::DWTHandler<std::complex<double>, std::complex<double>, double>;
-
     public:
         /**
         Creates a CKKSEncoder instance initialized with the specified SEALContext.
@@ -491,20 +489,25 @@ namespace seal
             // values_size is guaranteed to be no bigger than slots_
             std::size_t n = util::mul_safe(slots_, std::size_t(2));
 
-            auto conj_values = util::allocate<std::complex<double>>(n, pool, 0);
+            // The real and imaginary parts of the values and their conjugates are stored separately for the FFT
+            auto conj_values = util::allocate<double>(util::mul_safe(n, std::size_t(2)), pool, 0);
+            double *conj_values_real = conj_values.get();
+            double *conj_values_imag = conj_values.get() + n;
             for (std::size_t i = 0; i < values_size; i++)
             {
-                conj_values[matrix_reps_index_map_[i]] = values[i];
+                conj_values_real[matrix_reps_index_map_[i]] = std::real(values[i]);
+                conj_values_imag[matrix_reps_index_map_[i]] = std::imag(values[i]);
                 // TODO: if values are real, the following values should be set to zero, and multiply results by 2.
-                conj_values[matrix_reps_index_map_[i + slots_]] = std::conj(values[i]);
+                conj_values_real[matrix_reps_index_map_[i + slots_]] = std::real(values[i]);
+                conj_values_imag[matrix_reps_index_map_[i + slots_]] = -std::imag(values[i]);
             }
             double fix = scale / static_cast<double>(n);
-            fft_handler_.transform_from_rev(conj_values.get(), util::get_power_of_two(n), inv_root_powers_.get(), &fix);
+            fft_->transform_from_rev(conj_values_real, conj_values_imag, &fix);
 
             double max_coeff = 0;
             for (std::size_t i = 0; i < n; i++)
             {
-                max_coeff = std::max<>(max_coeff, std::fabs(conj_values[i].real()));
+                max_coeff = std::max<>(max_coeff, std::fabs(conj_values_real[i]));
             }
             // Verify that the values are not too large to fit in coeff_modulus
             // Note that we have an extra + 1 for the sign bit
@@ -528,7 +531,7 @@ namespace seal
             {
                 for (std::size_t i = 0; i < n; i++)
                 {
-                    double coeffd = std::round(conj_values[i].real());
+                    double coeffd = std::round(conj_values_real[i]);
                     bool is_negative = std::signbit(coeffd);
 
                     std::uint64_t coeffu = static_cast<std::uint64_t>(std::fabs(coeffd));
@@ -554,7 +557,7 @@ namespace seal
             {
                 for (std::size_t i = 0; i < n; i++)
                 {
-                    double coeffd = std::round(conj_values[i].real());
+                    double coeffd = std::round(conj_values_real[i]);
                     bool is_negative = std::signbit(coeffd);
                     coeffd = std::fabs(coeffd);
 
@@ -584,7 +587,7 @@ namespace seal
                 auto coeffu(util::allocate_uint(coeff_modulus_size, pool));
                 for (std::size_t i = 0; i < n; i++)
                 {
-                    double coeffd = std::round(conj_values[i].real());
+                    double coeffd = std::round(conj_values_real[i]);
                     bool is_negative = std::signbit(coeffd);
                     coeffd = std::fabs(coeffd);
 
@@ -694,7 +697,10 @@ namespace seal
 
             // Create floating-point representations of the multi-precision integer coefficients
             double two_pow_64 = std::pow(2.0, 64);
-            auto res(util::allocate<std::complex<double>>(coeff_count, pool));
+            // The real and imaginary parts are stored separately for the FFT; the imaginary parts start at zero
+            auto res(util::allocate<double>(util::mul_safe(coeff_count, std::size_t(2)), pool));
+            double *res_imag = res.get() + coeff_count;
+            std::fill_n(res_imag, coeff_count, 0.0);
             for (std::size_t i = 0; i < coeff_count; i++)
             {
                 res[i] = 0.0;
@@ -732,11 +738,12 @@ namespace seal
                 // res[i] = res_accum * inv_scale;
             }
 
-            fft_handler_.transform_to_rev(res.get(), logn, root_powers_.get());
+            fft_->transform_to_rev(res.get(), res_imag);
 
             for (std::size_t i = 0; i < slots_; i++)
             {
-                destination[i] = from_complex<T>(res[static_cast<std::size_t>(matrix_reps_index_map_[i])]);
+                std::size_t index = matrix_reps_index_map_[i];
+                destination[i] = from_complex<T>({ res[index], res_imag[index] });
             }
         }
 
@@ -759,18 +766,9 @@ namespace seal
 
         std::size_t slots_;
 
-        std::shared_ptr<util::ComplexRoots> complex_roots_;
-
-        // Holds 1~(n-1)-th powers of root in bit-reversed order, the 0-th power is left unset.
-        util::Pointer<std::complex<double>> root_powers_;
-
-        // Holds 1~(n-1)-th powers of inverse root in scrambled order, the 0-th power is left unset.
-        util::Pointer<std::complex<double>> inv_root_powers_;
-
         util::Pointer<std::size_t> matrix_reps_index_map_;
 
-        ComplexArith complex_arith_;
-
-        FFTHandler fft_handler_;
+        // Holds the powers of the roots used by the FFT
+        std::shared_ptr<util::SpecialFFT> fft_;
     };
 } // namespace seal
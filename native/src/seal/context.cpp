@@ -70,6 +70,15 @@ namespace seal
         case error_type::failed_creating_rns_tool:
             return "failed_creating_rns_tool";
 
+        case error_type::invalid_special_modulus_count:
+            return "invalid_special_modulus_count";
+
+        case error_type::invalid_decomposition_number:
+            return "invalid_decomposition_number";
+
+        case error_type::failed_creating_kswitch_tool:
+            return "failed_creating_kswitch_tool";
+
         default:
             return "invalid parameter_error";
         }
@@ -127,6 +136,15 @@ namespace seal
         case error_type::failed_creating_rns_tool:
             return "RNSTool cannot be constructed";
 
+        case error_type::invalid_special_modulus_count:
+            return "special_modulus_count is not smaller than the coeff_modulus's primes' count";
+
+        case error_type::invalid_decomposition_number:
+            return "decomposition_number is larger than the number of data primes";
+
+        case error_type::failed_creating_kswitch_tool:
+            return "KSwitchTool cannot be constructed";
+
         default:
             return "invalid parameter_error";
         }
@@ -155,6 +173,23 @@ namespace seal
         }
 
         size_t coeff_modulus_size = coeff_modulus.size();
+
+        // With several special primes at least one data prime must remain
+        size_t special_modulus_count = parms.special_modulus_count();
+        if (special_modulus_count > 1 && special_modulus_count >= coeff_modulus_size)
+        {
+            context_data.qualifiers_.parameter_error = error_type::invalid_special_modulus_count;
+            return context_data;
+        }
+
+        // There cannot be more digits than data primes
+        if (coeff_modulus_size > special_modulus_count &&
+            parms.decomposition_number() > coeff_modulus_size - special_modulus_count)
+        {
+            context_data.qualifiers_.parameter_error = error_type::invalid_decomposition_number;
+            return context_data;
+        }
+
         for (size_t i = 0; i < coeff_modulus_size; i++)
         {
             // Check coefficient moduli bounds
@@ -250,6 +285,9 @@ namespace seal
             return context_data;
         }
 
+        // Select the kernels specialized for this degree
+        context_data.poly_kernels_ = &get_poly_kernels(coeff_count_power);
+
         if (parms.scheme() == scheme_type::bfv || parms.scheme() == scheme_type::bgv)
         {
             // Plain modulus must be at least 2 and at most 60 bits
@@ -426,6 +464,10 @@ namespace seal
         auto next_coeff_modulus = next_parms.coeff_modulus();
         next_coeff_modulus.pop_back();
         next_parms.set_coeff_modulus(next_coeff_modulus);
+
+        // Keyswitching settings only apply to the key parameters
+        next_parms.set_special_modulus_count(1);
+        next_parms.set_decomposition_number(0);
         auto next_parms_id = next_parms.parms_id();
 
         // Validate next parameters and create next context_data
@@ -477,14 +519,36 @@ namespace seal
         // more than one modulus in coeff_modulus. This is equivalent to expanding
         // the chain by one step. Otherwise, we set first_parms_id_ to equal
         // key_parms_id_.
+        // With several special primes the chain is expanded by one step for each of them, and the intermediate
+        // parameters are only used by keys.
         if (!context_data_map_.at(key_parms_id_)->qualifiers_.parameters_set() || parms.coeff_modulus().size() == 1)
         {
             first_parms_id_ = key_parms_id_;
         }
         else
         {
-            auto next_parms_id = create_next_context_data(key_parms_id_);
-            first_parms_id_ = (next_parms_id == parms_id_zero) ? key_parms_id_ : next_parms_id;
+            auto next_parms_id = key_parms_id_;
+            for (size_t i = 0; i < parms.special_modulus_count() && next_parms_id != parms_id_zero; i++)
+            {
+                next_parms_id = create_next_context_data(next_parms_id);
+            }
+
+            if (next_parms_id == parms_id_zero)
+            {
+                // Remove any intermediate parameters that were created
+                auto context_data_ptr = context_data_map_.at(key_parms_id_)->next_context_data_;
+                const_pointer_cast<ContextData>(context_data_map_.at(key_parms_id_))->next_context_data_ = nullptr;
+                while (context_data_ptr)
+                {
+                    context_data_map_.erase(context_data_ptr->parms_id());
+                    context_data_ptr = context_data_ptr->next_context_data_;
+                }
+                first_parms_id_ = key_parms_id_;
+            }
+            else
+            {
+                first_parms_id_ = next_parms_id;
+            }
         }
 
         // Set last_parms_id_ to point to first_parms_id_
@@ -510,6 +574,39 @@ namespace seal
             }
         }
 
+        // Create the KSwitchTool for each data level if hybrid keyswitching is used
+        if (using_keyswitching_ && parms.using_hybrid_keyswitching())
+        {
+            auto &key_modulus = parms.coeff_modulus();
+            size_t special_modulus_count = parms.special_modulus_count();
+            size_t data_modulus_size = key_modulus.size() - special_modulus_count;
+            size_t decomposition_number = parms.decomposition_number();
+            size_t digit_size =
+                decomposition_number ? divide_round_up(data_modulus_size, decomposition_number) : size_t(1);
+
+            auto context_data_ptr = context_data_map_.at(first_parms_id_);
+            try
+            {
+                RNSBase special_base(
+                    vector<Modulus>(key_modulus.cbegin() + safe_cast<ptrdiff_t>(data_modulus_size), key_modulus.cend()),
+                    pool_);
+                while (context_data_ptr)
+                {
+                    auto &context_parms = context_data_ptr->parms();
+                    const_pointer_cast<ContextData>(context_data_ptr)->kswitch_tool_ = allocate<KSwitchTool>(
+                        pool_, context_parms.poly_modulus_degree(), RNSBase(context_parms.coeff_modulus(), pool_),
+                        special_base, digit_size, context_parms.plain_modulus(), pool_);
+                    context_data_ptr = context_data_ptr->next_context_data_;
+                }
+            }
+            catch (const exception &)
+            {
+                // Parameters are not valid; report the error through the first data parameters
+                const_pointer_cast<ContextData>(context_data_map_.at(first_parms_id_))->qualifiers_.parameter_error =
+                    error_type::failed_creating_kswitch_tool;
+            }
+        }
+
         // Set the chain_index for each context_data
         size_t parms_count = context_data_map_.size();
         auto context_data_ptr = context_data_map_.at(key_parms_id_);
@@ -9,12 +9,31 @@
 #include "seal/util/galois.h"
 #include "seal/util/ntt.h"
 #include "seal/util/pointer.h"
+#include "seal/util/polykernels.h"
 #include "seal/util/rns.h"
 #include <memory>
 #include <unordered_map>
 
 namespace seal
 {
+    /**
+    Selects the RNS algorithm used for BFV multiplication and decryption.
+    */
+    enum class rns_method_type : std::uint8_t
+    {
+        /**
+        Bajard-Eynard-Hasan-Zucca: base extension with Montgomery reduction and
+        Shenoy-Kumaresan conversion, using only integer arithmetic.
+        */
+        behz = 0x0,
+
+        /**
+        Halevi-Polyakov-Shoup: exact base conversions and scaling with
+        floating-point assisted rounding.
+        */
+        hps = 0x1
+    };
+
     /**
     Stores a set of attributes (qualifiers) of a set of encryption parameters.
     These parameters are mainly used internally in various parts of the library,
@@ -112,6 +131,21 @@ namespace seal
             RNSTool cannot be constructed
             */
             failed_creating_rns_tool = 14,
+
+            /**
+            special_modulus_count is not smaller than the coeff_modulus's primes' count
+            */
+            invalid_special_modulus_count = 15,
+
+            /**
+            decomposition_number is larger than the number of data primes
+            */
+            invalid_decomposition_number = 16,
+
+            /**
+            KSwitchTool cannot be constructed
+            */
+            failed_creating_kswitch_tool = 17,
         };
 
         /**
@@ -244,6 +278,10 @@ namespace seal
     in the full chain. The chain itself is a doubly linked list, and is referred to as the
     modulus switching chain.
 
+    When EncryptionParameters::special_modulus_count is larger than one, the data part of
+    the chain starts only after all special primes have been removed, so the chain contains
+    further key-only parameters between key_context_data() and first_context_data().
+
     @see EncryptionParameters for more details on the parameters.
     @see EncryptionParameterQualifiers for more details on the qualifiers.
     */
@@ -319,6 +357,16 @@ namespace seal
                 return rns_tool_.get();
             }
 
+            /**
+            Returns a constant pointer to the KSwitchTool. This is only set for the data
+            levels of the modulus switching chain when hybrid keyswitching is used, and
+            is nullptr otherwise.
+            */
+            SEAL_NODISCARD inline const util::KSwitchTool *kswitch_tool() const noexcept
+            {
+                return kswitch_tool_.get();
+            }
+
             /**
             Returns a constant pointer to the NTT tables.
             */
@@ -335,6 +383,15 @@ namespace seal
                 return plain_ntt_tables_.get();
             }
 
+            /**
+            Returns a constant pointer to the table of kernels the evaluator uses on single RNS components, which are
+            specialized for poly_modulus_degree when it is between 4096 and 65536.
+            */
+            SEAL_NODISCARD inline const util::PolyKernels *poly_kernels() const noexcept
+            {
+                return poly_kernels_;
+            }
+
             /**
             Returns a constant pointer to the GaloisTool.
             */
@@ -451,10 +508,14 @@ namespace seal
 
             util::Pointer<util::RNSTool> rns_tool_;
 
+            util::Pointer<util::KSwitchTool> kswitch_tool_;
+
             util::Pointer<util::NTTTables> small_ntt_tables_;
 
             util::Pointer<util::NTTTables> plain_ntt_tables_;
 
+            const util::PolyKernels *poly_kernels_ = nullptr;
+
             util::Pointer<util::GaloisTool> galois_tool_;
 
             util::Pointer<std::uint64_t> total_coeff_modulus_;
@@ -632,6 +693,28 @@ namespace seal
             return using_keyswitching_;
         }
 
+        /**
+        Returns the RNS algorithm used for BFV multiplication and decryption.
+        */
+        SEAL_NODISCARD inline rns_method_type rns_method() const noexcept
+        {
+            return rns_method_;
+        }
+
+        /**
+        Sets the RNS algorithm used for BFV multiplication and decryption. Both
+        algorithms produce valid results for all parameters supported by BFV, and
+        which one is faster depends on the parameters and the platform. Evaluator
+        and Decryptor objects use the setting of the SEALContext they were created
+        with, so it must be changed before creating them.
+
+        @param[in] rns_method The RNS algorithm
+        */
+        inline void set_rns_method(rns_method_type rns_method) noexcept
+        {
+            rns_method_ = rns_method;
+        }
+
     private:
         /**
         Creates an instance of SEALContext, and performs several pre-computations
@@ -676,5 +759,7 @@ namespace seal
         Is keyswitching supported by the encryption parameters?
         */
         bool using_keyswitching_;
+
+        rns_method_type rns_method_ = rns_method_type::behz;
     };
 } // namespace seal
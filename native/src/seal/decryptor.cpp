@@ -141,8 +141,15 @@ namespace seal
         destination.parms_id() = parms_id_zero;
         destination.resize(coeff_count);
 
-        // Divide scaling variant using BEHZ FullRNS techniques
-        context_data.rns_tool()->decrypt_scale_and_round(tmp_dest_modq, destination.data(), pool);
+        // Divide scaling variant using BEHZ or HPS FullRNS techniques
+        if (context_.rns_method() == rns_method_type::hps)
+        {
+            context_data.rns_tool()->hps_decrypt_scale_and_round(tmp_dest_modq, destination.data(), pool);
+        }
+        else
+        {
+            context_data.rns_tool()->decrypt_scale_and_round(tmp_dest_modq, destination.data(), pool);
+        }
 
         // How many non-zero coefficients do we really have in the result?
         size_t plain_coeff_count = get_significant_uint64_count_uint(destination.data(), coeff_count);
@@ -12,6 +12,12 @@ namespace seal
 {
     const parms_id_type parms_id_zero = util::HashFunction::hash_zero_block;
 
+    namespace
+    {
+        // Set in the serialized scheme identifier when non-default keyswitching settings follow plain_modulus
+        constexpr uint8_t scheme_keyswitching_flag = 0x80;
+    } // namespace
+
     void EncryptionParameters::save_members(ostream &stream) const
     {
         // Throw exceptions on std::ios_base::badbit and std::ios_base::failbit
@@ -23,6 +29,11 @@ namespace seal
             uint64_t poly_modulus_degree64 = static_cast<uint64_t>(poly_modulus_degree_);
             uint64_t coeff_modulus_size64 = static_cast<uint64_t>(coeff_modulus_.size());
             uint8_t scheme = static_cast<uint8_t>(scheme_);
+            bool save_keyswitching = has_keyswitching_settings();
+            if (save_keyswitching)
+            {
+                scheme |= scheme_keyswitching_flag;
+            }
 
             stream.write(reinterpret_cast<const char *>(&scheme), sizeof(uint8_t));
             stream.write(reinterpret_cast<const char *>(&poly_modulus_degree64), sizeof(uint64_t));
@@ -34,6 +45,15 @@ namespace seal
 
             // Only BFV and BGV uses plain_modulus but save it in any case for simplicity
             plain_modulus_.save(stream, compr_mode_type::none);
+
+            // The keyswitching settings are only saved when they differ from the defaults
+            if (save_keyswitching)
+            {
+                uint64_t special_modulus_count64 = static_cast<uint64_t>(special_modulus_count_);
+                uint64_t decomposition_number64 = static_cast<uint64_t>(decomposition_number_);
+                stream.write(reinterpret_cast<const char *>(&special_modulus_count64), sizeof(uint64_t));
+                stream.write(reinterpret_cast<const char *>(&decomposition_number64), sizeof(uint64_t));
+            }
         }
         catch (const ios_base::failure &)
         {
@@ -59,6 +79,8 @@ namespace seal
             // Read the scheme identifier
             uint8_t scheme;
             stream.read(reinterpret_cast<char *>(&scheme), sizeof(uint8_t));
+            bool load_keyswitching = scheme & scheme_keyswitching_flag;
+            scheme &= static_cast<uint8_t>(~scheme_keyswitching_flag);
 
             // This constructor will throw if scheme is invalid
             EncryptionParameters parms(scheme);
@@ -95,6 +117,15 @@ namespace seal
             Modulus plain_modulus;
             plain_modulus.load(stream);
 
+            // Read the keyswitching settings if present
+            uint64_t special_modulus_count64 = 1;
+            uint64_t decomposition_number64 = 0;
+            if (load_keyswitching)
+            {
+                stream.read(reinterpret_cast<char *>(&special_modulus_count64), sizeof(uint64_t));
+                stream.read(reinterpret_cast<char *>(&decomposition_number64), sizeof(uint64_t));
+            }
+
             // Supposedly everything worked so set the values of member variables
             parms.set_poly_modulus_degree(safe_cast<size_t>(poly_modulus_degree64));
             parms.set_coeff_modulus(coeff_modulus);
@@ -103,6 +134,10 @@ namespace seal
             // other schemes it is zero
             parms.set_plain_modulus(plain_modulus);
 
+            // These setters check that the values are in range
+            parms.set_special_modulus_count(safe_cast<size_t>(special_modulus_count64));
+            parms.set_decomposition_number(safe_cast<size_t>(decomposition_number64));
+
             // Set the loaded parameters
             swap(*this, parms);
 
@@ -125,10 +160,15 @@ namespace seal
     {
         size_t coeff_modulus_size = coeff_modulus_.size();
 
+        // The keyswitching settings are hashed only when they differ from the defaults so that the parms_id of
+        // classic parameters does not change
+        bool hash_keyswitching = has_keyswitching_settings();
+
         size_t total_uint64_count = add_safe(
             size_t(1), // scheme
             size_t(1), // poly_modulus_degree
-            coeff_modulus_size, plain_modulus_.uint64_count());
+            coeff_modulus_size, plain_modulus_.uint64_count(),
+            hash_keyswitching ? size_t(2) : size_t(0)); // special_modulus_count, decomposition_number
 
         auto param_data(allocate_uint(total_uint64_count, pool_));
         uint64_t *param_data_ptr = param_data.get();
@@ -147,6 +187,12 @@ namespace seal
         set_uint(plain_modulus_.data(), plain_modulus_.uint64_count(), param_data_ptr);
         param_data_ptr += plain_modulus_.uint64_count();
 
+        if (hash_keyswitching)
+        {
+            *param_data_ptr++ = static_cast<uint64_t>(special_modulus_count_);
+            *param_data_ptr++ = static_cast<uint64_t>(decomposition_number_);
+        }
+
         HashFunction::hash(param_data.get(), total_uint64_count, parms_id_);
 
         // Did we somehow manage to get a zero block as result? This is reserved for
@@ -253,6 +253,75 @@ namespace seal
             set_plain_modulus(Modulus(plain_modulus));
         }
 
+        /**
+        Sets the number of special primes used in keyswitching. The special primes
+        are always the last primes in the coefficient modulus and are used only by
+        keys: ciphertexts and plaintexts never carry them. By default a single
+        special prime is used, which is the classic Microsoft SEAL setting. Using
+        several special primes together with set_decomposition_number enables
+        hybrid keyswitching, where the remaining (data) primes are grouped into a
+        small number of digits. This reduces the cost of relinearization and
+        rotations, and the size of RelinKeys and GaloisKeys, when the coefficient
+        modulus consists of many primes.
+
+        For keyswitching noise to remain small, the product of the special primes
+        should be at least as large as the product of the primes in any digit.
+
+        @param[in] special_modulus_count The number of special primes
+        @throws std::logic_error if a valid scheme is not set and special_modulus_count
+        is not 1
+        @throws std::invalid_argument if special_modulus_count is zero or larger than
+        SEAL_COEFF_MOD_COUNT_MAX
+        */
+        inline void set_special_modulus_count(std::size_t special_modulus_count)
+        {
+            if (scheme_ == scheme_type::none && special_modulus_count != 1)
+            {
+                throw std::logic_error("special_modulus_count is not supported for this scheme");
+            }
+            if (!special_modulus_count || special_modulus_count > SEAL_COEFF_MOD_COUNT_MAX)
+            {
+                throw std::invalid_argument("special_modulus_count is invalid");
+            }
+
+            special_modulus_count_ = special_modulus_count;
+
+            // Re-compute the parms_id
+            compute_parms_id();
+        }
+
+        /**
+        Sets the decomposition number (often called dnum) used in keyswitching.
+        The data primes, i.e., the primes in the coefficient modulus that are not
+        special primes, are split into dnum consecutive groups (digits) of
+        ceil(data_prime_count / dnum) primes each, and every keyswitching key
+        consists of one component per digit. The default value 0 means that each
+        data prime forms its own digit, which is the classic Microsoft SEAL setting.
+
+        @param[in] decomposition_number The number of digits, or 0 for one digit
+        per data prime
+        @throws std::logic_error if a valid scheme is not set and decomposition_number
+        is non-zero
+        @throws std::invalid_argument if decomposition_number is larger than
+        SEAL_COEFF_MOD_COUNT_MAX
+        */
+        inline void set_decomposition_number(std::size_t decomposition_number)
+        {
+            if (scheme_ == scheme_type::none && decomposition_number)
+            {
+                throw std::logic_error("decomposition_number is not supported for this scheme");
+            }
+            if (decomposition_number > SEAL_COEFF_MOD_COUNT_MAX)
+            {
+                throw std::invalid_argument("decomposition_number is invalid");
+            }
+
+            decomposition_number_ = decomposition_number;
+
+            // Re-compute the parms_id
+            compute_parms_id();
+        }
+
         /**
         Sets the random number generator factory to use for encryption. By default,
         the random generator is set to UniformRandomGeneratorFactory::default_factory().
@@ -298,6 +367,35 @@ namespace seal
             return plain_modulus_;
         }
 
+        /**
+        Returns the number of special primes used in keyswitching.
+        */
+        SEAL_NODISCARD inline std::size_t special_modulus_count() const noexcept
+        {
+            return special_modulus_count_;
+        }
+
+        /**
+        Returns the decomposition number used in keyswitching. The value 0 means
+        that each data prime forms its own digit.
+        */
+        SEAL_NODISCARD inline std::size_t decomposition_number() const noexcept
+        {
+            return decomposition_number_;
+        }
+
+        /**
+        Returns whether hybrid keyswitching is requested, i.e., whether the keyswitching
+        settings differ from the classic setting with a single special prime and one
+        digit per data prime.
+        */
+        SEAL_NODISCARD inline bool using_hybrid_keyswitching() const noexcept
+        {
+            return (special_modulus_count_ != 1) ||
+                   (decomposition_number_ && coeff_modulus_.size() > special_modulus_count_ &&
+                    decomposition_number_ != coeff_modulus_.size() - special_modulus_count_);
+        }
+
         /**
         Returns a pointer to the random number generator factory to use for encryption.
         */
@@ -363,7 +461,9 @@ namespace seal
                     sizeof(std::uint64_t), // poly_modulus_degree_
                     sizeof(std::uint64_t), // coeff_modulus_size
                     coeff_modulus_total_size,
-                    util::safe_cast<std::size_t>(plain_modulus_.save_size(compr_mode_type::none))),
+                    util::safe_cast<std::size_t>(plain_modulus_.save_size(compr_mode_type::none)),
+                    has_keyswitching_settings() ? 2 * sizeof(std::uint64_t)
+                                                : std::size_t(0)), // special_modulus_count_, decomposition_number_
                 compr_mode);
 
             return util::safe_cast<std::streamoff>(util::add_safe(sizeof(Serialization::SEALHeader), members_size));
@@ -483,6 +583,15 @@ namespace seal
             return false;
         }
 
+        /**
+        Returns whether the keyswitching settings differ from the defaults, in which
+        case they are saved and hashed into the parms_id.
+        */
+        SEAL_NODISCARD inline bool has_keyswitching_settings() const noexcept
+        {
+            return (special_modulus_count_ != 1) || decomposition_number_;
+        }
+
         void compute_parms_id();
 
         void save_members(std::ostream &stream) const;
@@ -501,6 +610,10 @@ namespace seal
 
         Modulus plain_modulus_{};
 
+        std::size_t special_modulus_count_ = 1;
+
+        std::size_t decomposition_number_ = 0;
+
         parms_id_type parms_id_ = parms_id_zero;
     };
 } // namespace seal
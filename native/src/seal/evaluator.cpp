@@ -8,10 +8,12 @@
 #include "seal/util/polyarithsmallmod.h"
 #include "seal/util/polycore.h"
 #include "seal/util/scalingvariant.h"
+#include "seal/util/threadpool.h"
 #include "seal/util/uintarith.h"
 #include <algorithm>
 #include <cmath>
 #include <functional>
+#include <numeric>
 
 using namespace std;
 using namespace seal::util;
@@ -116,6 +118,7 @@ namespace seal
             }
             return make_tuple(multiply_uint_mod(e1, factor1, plain_modulus), e1, e2);
         }
+
     } // namespace
 
     Evaluator::Evaluator(const SEALContext &context) : context_(context)
@@ -241,6 +244,8 @@ namespace seal
 
     void Evaluator::add_many(const vector<Ciphertext> &encrypteds, Ciphertext &destination) const
     {
+        AllocationScope scope("Evaluator::add_many");
+
         if (encrypteds.empty())
         {
             throw invalid_argument("encrypteds cannot be empty");
@@ -260,6 +265,69 @@ namespace seal
         }
     }
 
+    void Evaluator::add_many_parallel(
+        const vector<Ciphertext> &encrypteds, Ciphertext &destination, SEAL_MAYBE_UNUSED size_t thread_count,
+        MemoryPoolHandle pool) const
+    {
+        AllocationScope scope("Evaluator::add_many_parallel");
+
+        if (encrypteds.empty())
+        {
+            throw invalid_argument("encrypteds cannot be empty");
+        }
+        for (size_t i = 0; i < encrypteds.size(); i++)
+        {
+            if (&encrypteds[i] == &destination)
+            {
+                throw invalid_argument("encrypteds must be different from destination");
+            }
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+
+#ifdef SEAL_USE_THREAD_POOL
+        // In BGV the order of additions affects the result when the correction factors differ
+        auto &thread_pool = ThreadPool::Global();
+        size_t chunk_count =
+            min(thread_count ? thread_count : thread_pool.thread_count(), encrypteds.size() / 2);
+        if (chunk_count <= 1 || !static_cast<MemoryPool &>(pool).is_thread_safe() ||
+            any_of(encrypteds.cbegin(), encrypteds.cend(), [&](auto &encrypted) {
+                return encrypted.correction_factor() != encrypteds[0].correction_factor();
+            }))
+        {
+            add_many(encrypteds, destination);
+            return;
+        }
+
+        // Sum up contiguous chunks concurrently
+        vector<Ciphertext> partial_sums;
+        partial_sums.reserve(chunk_count);
+        for (size_t c = 0; c < chunk_count; c++)
+        {
+            partial_sums.emplace_back(pool);
+        }
+        thread_pool.parallel_for(chunk_count, [&](size_t c) {
+            size_t begin = c * encrypteds.size() / chunk_count;
+            size_t end = (c + 1) * encrypteds.size() / chunk_count;
+            partial_sums[c] = encrypteds[begin];
+            for (size_t i = begin + 1; i < end; i++)
+            {
+                add_inplace(partial_sums[c], encrypteds[i]);
+            }
+        });
+
+        destination = partial_sums[0];
+        for (size_t c = 1; c < chunk_count; c++)
+        {
+            add_inplace(destination, partial_sums[c]);
+        }
+#else
+        add_many(encrypteds, destination);
+#endif
+    }
+
     void Evaluator::sub_inplace(Ciphertext &encrypted1, const Ciphertext &encrypted2) const
     {
         // Verify parameters.
@@ -351,6 +419,8 @@ namespace seal
 
     void Evaluator::multiply_inplace(Ciphertext &encrypted1, const Ciphertext &encrypted2, MemoryPoolHandle pool) const
     {
+        AllocationScope scope("Evaluator::multiply_inplace");
+
         // Verify parameters.
         if (!is_metadata_valid_for(encrypted1, context_) || !is_buffer_valid(encrypted1))
         {
@@ -398,11 +468,17 @@ namespace seal
         {
             throw invalid_argument("encrypted1 or encrypted2 cannot be in NTT form");
         }
+        if (context_.rns_method() == rns_method_type::hps)
+        {
+            bfv_multiply_hps(encrypted1, encrypted2, move(pool));
+            return;
+        }
 
         // Extract encryption parameters.
         auto &context_data = *context_.get_context_data(encrypted1.parms_id());
         auto &parms = context_data.parms();
         size_t coeff_count = parms.poly_modulus_degree();
+        auto &kernels = *context_data.poly_kernels();
         size_t base_q_size = parms.coeff_modulus().size();
         size_t encrypted1_size = encrypted1.size();
         size_t encrypted2_size = encrypted2.size();
@@ -480,13 +556,25 @@ namespace seal
         SEAL_ALLOCATE_GET_POLY_ITER(encrypted1_Bsk, encrypted1_size, coeff_count, base_Bsk_size, pool);
 
         // Perform BEHZ steps (1)-(3) for encrypted1
-        SEAL_ITERATE(iter(encrypted1, encrypted1_q, encrypted1_Bsk), encrypted1_size, behz_extend_base_convert_to_ntt);
+        SEAL_ITERATE_PARALLEL(
+            pool, iter(encrypted1, encrypted1_q, encrypted1_Bsk), encrypted1_size, behz_extend_base_convert_to_ntt);
 
         // Repeat for encrypted2
         SEAL_ALLOCATE_GET_POLY_ITER(encrypted2_q, encrypted2_size, coeff_count, base_q_size, pool);
         SEAL_ALLOCATE_GET_POLY_ITER(encrypted2_Bsk, encrypted2_size, coeff_count, base_Bsk_size, pool);
 
-        SEAL_ITERATE(iter(encrypted2, encrypted2_q, encrypted2_Bsk), encrypted2_size, behz_extend_base_convert_to_ntt);
+        // With Montgomery products, the NTT-form encrypted2 is converted to Montgomery form once, and each of its
+        // products below needs only a Montgomery reduction
+        bool montgomery = use_montgomery_dyadic_product(base_q, base_q_size) ||
+                          use_montgomery_dyadic_product(base_Bsk, base_Bsk_size);
+        SEAL_ITERATE_PARALLEL(pool, iter(encrypted2, encrypted2_q, encrypted2_Bsk), encrypted2_size, [&](auto I) {
+            behz_extend_base_convert_to_ntt(I);
+            if (montgomery)
+            {
+                to_montgomery_poly_coeffmod(get<1>(I), base_q_size, base_q, get<1>(I));
+                to_montgomery_poly_coeffmod(get<2>(I), base_Bsk_size, base_Bsk, get<2>(I));
+            }
+        });
 
         // Allocate temporary space for the output of step (4)
         // We allocate space separately for the base q and the base Bsk components
@@ -494,7 +582,7 @@ namespace seal
         SEAL_ALLOCATE_ZERO_GET_POLY_ITER(temp_dest_Bsk, dest_size, coeff_count, base_Bsk_size, pool);
 
         // Perform BEHZ step (4): dyadic multiplication on arbitrary size ciphertexts
-        SEAL_ITERATE(iter(size_t(0)), dest_size, [&](auto I) {
+        SEAL_ITERATE_PARALLEL(pool, iter(size_t(0)), dest_size, [&](auto I) {
             // We iterate over relevant components of encrypted1 and encrypted2 in increasing order for
             // encrypted1 and reversed (decreasing) order for encrypted2. The bounds for the indices of
             // the relevant terms are obtained as follows.
@@ -529,8 +617,16 @@ namespace seal
                 SEAL_ITERATE(iter(shifted_in1_iter, shifted_reversed_in2_iter), steps, [&](auto J) {
                     SEAL_ITERATE(iter(J, base_iter, shifted_out_iter), base_size, [&](auto K) {
                         SEAL_ALLOCATE_GET_COEFF_ITER(temp, coeff_count, pool);
-                        dyadic_product_coeffmod(get<0, 0>(K), get<0, 1>(K), coeff_count, get<1>(K), temp);
-                        add_poly_coeffmod(temp, get<2>(K), coeff_count, get<1>(K), get<2>(K));
+                        if (montgomery)
+                        {
+                            dyadic_product_montgomery_coeffmod(
+                                get<0, 0>(K), get<0, 1>(K), coeff_count, get<1>(K), temp);
+                        }
+                        else
+                        {
+                            kernels.dyadic_product_coeffmod(get<0, 0>(K), get<0, 1>(K), coeff_count, get<1>(K), temp);
+                        }
+                        kernels.add_poly_coeffmod(temp, get<2>(K), coeff_count, get<1>(K), get<2>(K));
                     });
                 });
             };
@@ -546,7 +642,7 @@ namespace seal
         inverse_ntt_negacyclic_harvey_lazy(temp_dest_Bsk, dest_size, base_Bsk_ntt_tables);
 
         // Perform BEHZ steps (6)-(8)
-        SEAL_ITERATE(iter(temp_dest_q, temp_dest_Bsk, encrypted1), dest_size, [&](auto I) {
+        SEAL_ITERATE_PARALLEL(pool, iter(temp_dest_q, temp_dest_Bsk, encrypted1), dest_size, [&](auto I) {
             // Bring together the base q and base Bsk components into a single allocation
             SEAL_ALLOCATE_GET_RNS_ITER(temp_q_Bsk, coeff_count, base_q_size + base_Bsk_size, pool);
 
@@ -566,6 +662,142 @@ namespace seal
         });
     }
 
+    void Evaluator::bfv_multiply_hps(
+        Ciphertext &encrypted1, const Ciphertext &encrypted2, MemoryPoolHandle pool) const
+    {
+        // Extract encryption parameters.
+        auto &context_data = *context_.get_context_data(encrypted1.parms_id());
+        auto &parms = context_data.parms();
+        size_t coeff_count = parms.poly_modulus_degree();
+        auto &kernels = *context_data.poly_kernels();
+        size_t base_q_size = parms.coeff_modulus().size();
+        size_t encrypted1_size = encrypted1.size();
+        size_t encrypted2_size = encrypted2.size();
+
+        auto rns_tool = context_data.rns_tool();
+        size_t base_Bsk_size = rns_tool->base_Bsk()->size();
+        size_t base_q_Bsk_size = add_safe(base_q_size, base_Bsk_size);
+
+        // Determine destination.size()
+        size_t dest_size = sub_safe(add_safe(encrypted1_size, encrypted2_size), size_t(1));
+
+        // Size check
+        if (!product_fits_in(dest_size, coeff_count, base_q_Bsk_size))
+        {
+            throw logic_error("invalid parameters");
+        }
+
+        // The extended base q U Bsk
+        vector<Modulus> base_q_Bsk(parms.coeff_modulus());
+        base_q_Bsk.insert(base_q_Bsk.end(), rns_tool->base_Bsk()->base(), rns_tool->base_Bsk()->base() + base_Bsk_size);
+
+        // Set up iterators for NTT tables
+        auto base_q_ntt_tables = iter(context_data.small_ntt_tables());
+        auto base_Bsk_ntt_tables = iter(rns_tool->base_Bsk_ntt_tables());
+
+        // The HPS variant of RNS multiplication uses the base Bsk from BEHZ as its auxiliary base. It consists of the
+        // following steps:
+        //
+        // (1) Extend encrypted1 and encrypted2 (initially in base q) exactly to base q U Bsk
+        // (2) Transform the data to NTT form
+        // (3) Compute the ciphertext polynomial product using dyadic multiplication
+        // (4) Transform the data back from NTT form
+        // (5) Scale the result by t/q and round, switching base to Bsk
+        // (6) Convert the result exactly to base q
+        //
+        // The exact base conversions and the scaling use floating-point arithmetic to determine the multiples of q
+        // and prod(Bsk) to subtract, instead of the Montgomery reduction and Shenoy-Kumaresan steps of BEHZ.
+
+        // Performs steps (1)-(2) for an input polynomial, writing the result in base q U Bsk
+        auto hps_extend_to_ntt = [&](auto I) {
+            set_poly(get<0>(I), coeff_count, base_q_size, get<1>(I));
+            ntt_negacyclic_harvey_lazy(get<1>(I), base_q_size, base_q_ntt_tables);
+            rns_tool->exact_bconv_q_to_Bsk(get<0>(I), get<1>(I) + base_q_size, pool);
+            ntt_negacyclic_harvey_lazy(get<1>(I) + base_q_size, base_Bsk_size, base_Bsk_ntt_tables);
+        };
+
+        // Both inputs are extended before encrypted1 is resized, so encrypted1 and encrypted2 may alias; for a square
+        // the input is extended only once
+        bool is_square = (&encrypted1 == &encrypted2);
+        SEAL_ALLOCATE_GET_POLY_ITER(encrypted1_q_Bsk, encrypted1_size, coeff_count, base_q_Bsk_size, pool);
+        SEAL_ITERATE_PARALLEL(pool, iter(encrypted1, encrypted1_q_Bsk), encrypted1_size, hps_extend_to_ntt);
+
+        auto encrypted2_q_Bsk_alloc(
+            allocate_poly_array(is_square ? 0 : encrypted2_size, coeff_count, base_q_Bsk_size, pool));
+        PolyIter encrypted2_q_Bsk(
+            is_square ? encrypted1_q_Bsk : PolyIter(encrypted2_q_Bsk_alloc.get(), coeff_count, base_q_Bsk_size));
+        bool montgomery = !is_square && use_montgomery_dyadic_product(iter(base_q_Bsk), base_q_Bsk_size);
+        if (!is_square)
+        {
+            SEAL_ITERATE_PARALLEL(pool, iter(encrypted2, encrypted2_q_Bsk), encrypted2_size, [&](auto I) {
+                hps_extend_to_ntt(I);
+                if (montgomery)
+                {
+                    to_montgomery_poly_coeffmod(get<1>(I), base_q_Bsk_size, iter(base_q_Bsk), get<1>(I));
+                }
+            });
+        }
+
+        // Perform step (3): dyadic multiplication
+        SEAL_ALLOCATE_ZERO_GET_POLY_ITER(temp_dest, dest_size, coeff_count, base_q_Bsk_size, pool);
+        if (is_square && encrypted1_size == 2)
+        {
+            // Compute (c0^2, 2 * c0 * c1, c1^2) with three dyadic products instead of four
+            SEAL_ITERATE_PARALLEL(
+                iter(encrypted1_q_Bsk[0], encrypted1_q_Bsk[1], temp_dest[0], temp_dest[1], temp_dest[2], base_q_Bsk),
+                base_q_Bsk_size, [&](auto I) {
+                    dyadic_product_coeffmod(get<0>(I), get<0>(I), coeff_count, get<5>(I), get<2>(I));
+                    dyadic_product_coeffmod(get<0>(I), get<1>(I), coeff_count, get<5>(I), get<3>(I));
+                    add_poly_coeffmod(get<3>(I), get<3>(I), coeff_count, get<5>(I), get<3>(I));
+                    dyadic_product_coeffmod(get<1>(I), get<1>(I), coeff_count, get<5>(I), get<4>(I));
+                });
+        }
+        else
+        {
+            SEAL_ITERATE_PARALLEL(pool, iter(size_t(0)), dest_size, [&](auto I) {
+                size_t curr_encrypted1_last = min<size_t>(I, encrypted1_size - 1);
+                size_t curr_encrypted2_first = min<size_t>(I, encrypted2_size - 1);
+                size_t curr_encrypted1_first = I - curr_encrypted2_first;
+                size_t steps = curr_encrypted1_last - curr_encrypted1_first + 1;
+
+                auto shifted_in1_iter = ConstPolyIter(encrypted1_q_Bsk) + curr_encrypted1_first;
+                auto shifted_reversed_in2_iter = reverse_iter(ConstPolyIter(encrypted2_q_Bsk) + curr_encrypted2_first);
+                SEAL_ITERATE(iter(shifted_in1_iter, shifted_reversed_in2_iter), steps, [&](auto J) {
+                    SEAL_ITERATE(iter(J, base_q_Bsk, temp_dest[I]), base_q_Bsk_size, [&](auto K) {
+                        SEAL_ALLOCATE_GET_COEFF_ITER(temp, coeff_count, pool);
+                        if (montgomery)
+                        {
+                            dyadic_product_montgomery_coeffmod(
+                                get<0, 0>(K), get<0, 1>(K), coeff_count, get<1>(K), temp);
+                        }
+                        else
+                        {
+                            kernels.dyadic_product_coeffmod(get<0, 0>(K), get<0, 1>(K), coeff_count, get<1>(K), temp);
+                        }
+                        kernels.add_poly_coeffmod(temp, get<2>(K), coeff_count, get<1>(K), get<2>(K));
+                    });
+                });
+            });
+        }
+
+        // Resize encrypted1 to destination size
+        encrypted1.resize(context_, context_data.parms_id(), dest_size);
+
+        // Perform steps (4)-(6)
+        SEAL_ITERATE_PARALLEL(pool, iter(temp_dest, encrypted1), dest_size, [&](auto I) {
+            // Step (4): the scaling needs fully reduced input
+            inverse_ntt_negacyclic_harvey(get<0>(I), base_q_size, base_q_ntt_tables);
+            inverse_ntt_negacyclic_harvey(get<0>(I) + base_q_size, base_Bsk_size, base_Bsk_ntt_tables);
+
+            // Step (5): scale by t/q and round, producing a result in base Bsk
+            SEAL_ALLOCATE_GET_RNS_ITER(temp_Bsk, coeff_count, base_Bsk_size, pool);
+            rns_tool->hps_scale_and_round(get<0>(I), temp_Bsk, pool);
+
+            // Step (6): convert the result to base q and write to encrypted1
+            rns_tool->exact_bconv_Bsk_to_q(temp_Bsk, get<1>(I), pool);
+        });
+    }
+
     void Evaluator::ckks_multiply(Ciphertext &encrypted1, const Ciphertext &encrypted2, MemoryPoolHandle pool) const
     {
         if (!(encrypted1.is_ntt_form() && encrypted2.is_ntt_form()))
@@ -577,6 +809,7 @@ namespace seal
         auto &context_data = *context_.get_context_data(encrypted1.parms_id());
         auto &parms = context_data.parms();
         size_t coeff_count = parms.poly_modulus_degree();
+        auto &kernels = *context_data.poly_kernels();
         size_t coeff_modulus_size = parms.coeff_modulus().size();
         size_t encrypted1_size = encrypted1.size();
         size_t encrypted2_size = encrypted2.size();
@@ -627,30 +860,44 @@ namespace seal
             // Temporary buffer to store intermediate results
             SEAL_ALLOCATE_GET_COEFF_ITER(temp, tile_size, pool);
 
+            // With Montgomery products, each tile of y is converted to Montgomery form into these buffers
+            bool montgomery = use_montgomery_dyadic_product(coeff_modulus, coeff_modulus_size);
+            SEAL_ALLOCATE_GET_COEFF_ITER(encrypted2_0_montgomery, montgomery ? tile_size : 0, pool);
+            SEAL_ALLOCATE_GET_COEFF_ITER(encrypted2_1_montgomery, montgomery ? tile_size : 0, pool);
+
             // Computes the output tile_size coefficients at a time
             // Given input tuples of polynomials x = (x[0], x[1], x[2]), y = (y[0], y[1]), computes
             // x = (x[0] * y[0], x[0] * y[1] + x[1] * y[0], x[1] * y[1])
             // with appropriate modular reduction
             SEAL_ITERATE(coeff_modulus, coeff_modulus_size, [&](auto I) {
                 SEAL_ITERATE(iter(size_t(0)), num_tiles, [&](SEAL_MAYBE_UNUSED auto J) {
+                    decltype(PolyKernels::dyadic_product_coeffmod) dyadic_product = dyadic_product_coeffmod;
+                    ConstCoeffIter y0 = encrypted2_0_iter[0];
+                    ConstCoeffIter y1 = encrypted2_1_iter[0];
+                    if (montgomery)
+                    {
+                        dyadic_product = dyadic_product_montgomery_coeffmod;
+                        to_montgomery_poly_coeffmod(y0, tile_size, I, encrypted2_0_montgomery);
+                        to_montgomery_poly_coeffmod(y1, tile_size, I, encrypted2_1_montgomery);
+                        y0 = encrypted2_0_montgomery;
+                        y1 = encrypted2_1_montgomery;
+                    }
+
                     // Compute third output polynomial, overwriting input
                     // x[2] = x[1] * y[1]
-                    dyadic_product_coeffmod(
-                        encrypted1_1_iter[0], encrypted2_1_iter[0], tile_size, I, encrypted1_2_iter[0]);
+                    dyadic_product(encrypted1_1_iter[0], y1, tile_size, I, encrypted1_2_iter[0]);
 
                     // Compute second output polynomial, overwriting input
                     // temp = x[1] * y[0]
-                    dyadic_product_coeffmod(encrypted1_1_iter[0], encrypted2_0_iter[0], tile_size, I, temp);
+                    dyadic_product(encrypted1_1_iter[0], y0, tile_size, I, temp);
                     // x[1] = x[0] * y[1]
-                    dyadic_product_coeffmod(
-                        encrypted1_0_iter[0], encrypted2_1_iter[0], tile_size, I, encrypted1_1_iter[0]);
+                    dyadic_product(encrypted1_0_iter[0], y1, tile_size, I, encrypted1_1_iter[0]);
                     // x[1] += temp
                     add_poly_coeffmod(encrypted1_1_iter[0], temp, tile_size, I, encrypted1_1_iter[0]);
 
                     // Compute first output polynomial, overwriting input
                     // x[0] = x[0] * y[0]
-                    dyadic_product_coeffmod(
-                        encrypted1_0_iter[0], encrypted2_0_iter[0], tile_size, I, encrypted1_0_iter[0]);
+                    dyadic_product(encrypted1_0_iter[0], y0, tile_size, I, encrypted1_0_iter[0]);
 
                     // Manually increment iterators
                     encrypted1_0_iter++;
@@ -666,6 +913,16 @@ namespace seal
             // Allocate temporary space for the result
             SEAL_ALLOCATE_ZERO_GET_POLY_ITER(temp, dest_size, coeff_count, coeff_modulus_size, pool);
 
+            // With Montgomery products, the products take a copy of encrypted2 in Montgomery form
+            bool montgomery = use_montgomery_dyadic_product(coeff_modulus, coeff_modulus_size);
+            SEAL_ALLOCATE_GET_POLY_ITER(
+                encrypted2_montgomery, montgomery ? encrypted2_size : 0, coeff_count, coeff_modulus_size, pool);
+            if (montgomery)
+            {
+                to_montgomery_poly_coeffmod(encrypted2_iter, encrypted2_size, coeff_modulus, encrypted2_montgomery);
+                encrypted2_iter = encrypted2_montgomery;
+            }
+
             SEAL_ITERATE(iter(size_t(0)), dest_size, [&](auto I) {
                 // We iterate over relevant components of encrypted1 and encrypted2 in increasing order for
                 // encrypted1 and reversed (decreasing) order for encrypted2. The bounds for the indices of
@@ -689,8 +946,16 @@ namespace seal
                     // temp_iter must be dereferenced once to produce an appropriate RNSIter
                     SEAL_ITERATE(iter(J, coeff_modulus, temp[I]), coeff_modulus_size, [&](auto K) {
                         SEAL_ALLOCATE_GET_COEFF_ITER(prod, coeff_count, pool);
-                        dyadic_product_coeffmod(get<0, 0>(K), get<0, 1>(K), coeff_count, get<1>(K), prod);
-                        add_poly_coeffmod(prod, get<2>(K), coeff_count, get<1>(K), get<2>(K));
+                        if (montgomery)
+                        {
+                            dyadic_product_montgomery_coeffmod(
+                                get<0, 0>(K), get<0, 1>(K), coeff_count, get<1>(K), prod);
+                        }
+                        else
+                        {
+                            kernels.dyadic_product_coeffmod(get<0, 0>(K), get<0, 1>(K), coeff_count, get<1>(K), prod);
+                        }
+                        kernels.add_poly_coeffmod(prod, get<2>(K), coeff_count, get<1>(K), get<2>(K));
                     });
                 });
             });
@@ -718,6 +983,7 @@ namespace seal
         auto &context_data = *context_.get_context_data(encrypted1.parms_id());
         auto &parms = context_data.parms();
         size_t coeff_count = parms.poly_modulus_degree();
+        auto &kernels = *context_data.poly_kernels();
         size_t coeff_modulus_size = parms.coeff_modulus().size();
         size_t encrypted1_size = encrypted1.size();
         size_t encrypted2_size = encrypted2.size();
@@ -739,15 +1005,22 @@ namespace seal
         ntt_negacyclic_harvey(encrypted1, encrypted1_size, ntt_table);
         PolyIter encrypted2_iter;
         Ciphertext encrypted2_cpy;
+        bool montgomery = false;
         if (&encrypted1 == &encrypted2)
         {
             encrypted2_iter = iter(encrypted1);
         }
         else
         {
+            // With Montgomery products, the products take the copy of encrypted2 in Montgomery form
+            montgomery = use_montgomery_dyadic_product(coeff_modulus, coeff_modulus_size);
             encrypted2_cpy = encrypted2;
             ntt_negacyclic_harvey(encrypted2_cpy, encrypted2_size, ntt_table);
             encrypted2_iter = iter(encrypted2_cpy);
+            if (montgomery)
+            {
+                to_montgomery_poly_coeffmod(encrypted2_iter, encrypted2_size, coeff_modulus, encrypted2_iter);
+            }
         }
 
         // Allocate temporary space for the result
@@ -776,8 +1049,15 @@ namespace seal
                 // temp_iter must be dereferenced once to produce an appropriate RNSIter
                 SEAL_ITERATE(iter(J, coeff_modulus, temp[I]), coeff_modulus_size, [&](auto K) {
                     SEAL_ALLOCATE_GET_COEFF_ITER(prod, coeff_count, pool);
-                    dyadic_product_coeffmod(get<0, 0>(K), get<0, 1>(K), coeff_count, get<1>(K), prod);
-                    add_poly_coeffmod(prod, get<2>(K), coeff_count, get<1>(K), get<2>(K));
+                    if (montgomery)
+                    {
+                        dyadic_product_montgomery_coeffmod(get<0, 0>(K), get<0, 1>(K), coeff_count, get<1>(K), prod);
+                    }
+                    else
+                    {
+                        kernels.dyadic_product_coeffmod(get<0, 0>(K), get<0, 1>(K), coeff_count, get<1>(K), prod);
+                    }
+                    kernels.add_poly_coeffmod(prod, get<2>(K), coeff_count, get<1>(K), get<2>(K));
                 });
             });
         });
@@ -793,8 +1073,198 @@ namespace seal
             multiply_uint_mod(encrypted1.correction_factor(), encrypted2.correction_factor(), parms.plain_modulus());
     }
 
+    void Evaluator::multiply_accumulate(
+        const vector<Ciphertext> &encrypteds1, const vector<Ciphertext> &encrypteds2, Ciphertext &destination,
+        MemoryPoolHandle pool) const
+    {
+        AllocationScope scope("Evaluator::multiply_accumulate");
+
+        // Verify parameters.
+        if (encrypteds1.empty() || encrypteds1.size() != encrypteds2.size())
+        {
+            throw invalid_argument("encrypteds1 and encrypteds2 must be non-empty and have the same size");
+        }
+        auto parms_id = encrypteds1[0].parms_id();
+        for (size_t i = 0; i < encrypteds1.size(); i++)
+        {
+            if (!is_metadata_valid_for(encrypteds1[i], context_) || !is_buffer_valid(encrypteds1[i]))
+            {
+                throw invalid_argument("encrypteds1 is not valid for encryption parameters");
+            }
+            if (!is_metadata_valid_for(encrypteds2[i], context_) || !is_buffer_valid(encrypteds2[i]))
+            {
+                throw invalid_argument("encrypteds2 is not valid for encryption parameters");
+            }
+            if (encrypteds1[i].parms_id() != parms_id || encrypteds2[i].parms_id() != parms_id)
+            {
+                throw invalid_argument("encrypteds1 and encrypteds2 parameter mismatch");
+            }
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+
+        auto &context_data = *context_.get_context_data(parms_id);
+        auto &parms = context_data.parms();
+        auto scheme = parms.scheme();
+        size_t term_count = encrypteds1.size();
+
+        // The fused kernel handles products of two ciphertexts of size 2 in CKKS and BGV. The products must all have
+        // the same scale or correction factor, respectively, so that they can be added without adjustments.
+        bool fused = (scheme == scheme_type::ckks || scheme == scheme_type::bgv);
+        for (size_t i = 0; fused && i < term_count; i++)
+        {
+            auto &encrypted1 = encrypteds1[i];
+            auto &encrypted2 = encrypteds2[i];
+            fused = encrypted1.size() == 2 && encrypted2.size() == 2 &&
+                    util::are_close<double>(
+                        encrypted1.scale() * encrypted2.scale(), encrypteds1[0].scale() * encrypteds2[0].scale()) &&
+                    multiply_uint_mod(
+                        encrypted1.correction_factor(), encrypted2.correction_factor(), parms.plain_modulus()) ==
+                        multiply_uint_mod(
+                            encrypteds1[0].correction_factor(), encrypteds2[0].correction_factor(),
+                            parms.plain_modulus());
+        }
+
+        // Write to a temporary in case destination is one of the inputs
+        Ciphertext result(pool);
+        if (!fused)
+        {
+            // Sum up the products computed one by one; this still needs only a single relinearization
+            multiply(encrypteds1[0], encrypteds2[0], result, pool);
+            Ciphertext temp(pool);
+            for (size_t i = 1; i < term_count; i++)
+            {
+                multiply(encrypteds1[i], encrypteds2[i], temp, pool);
+                add_inplace(result, temp);
+            }
+            destination = move(result);
+            return;
+        }
+
+        bool is_ckks = (scheme == scheme_type::ckks);
+        if (any_of(encrypteds1.cbegin(), encrypteds1.cend(), [&](auto &ct) { return ct.is_ntt_form() != is_ckks; }) ||
+            any_of(encrypteds2.cbegin(), encrypteds2.cend(), [&](auto &ct) { return ct.is_ntt_form() != is_ckks; }))
+        {
+            throw invalid_argument("encrypteds1 or encrypteds2 is not in the default NTT form");
+        }
+
+        // Extract encryption parameters.
+        auto &coeff_modulus = parms.coeff_modulus();
+        size_t coeff_count = parms.poly_modulus_degree();
+        size_t coeff_modulus_size = coeff_modulus.size();
+        auto ntt_tables = iter(context_data.small_ntt_tables());
+
+        // Size check
+        if (!product_fits_in(size_t(3), coeff_count, coeff_modulus_size))
+        {
+            throw logic_error("invalid parameters");
+        }
+
+        // Prepare result
+        result.resize(context_, parms_id, 3);
+        result.is_ntt_form() = is_ckks;
+        result.scale() = encrypteds1[0].scale() * encrypteds2[0].scale();
+        if (!is_scale_within_bounds(result.scale(), context_data))
+        {
+            throw invalid_argument("scale out of bounds");
+        }
+        result.correction_factor() = multiply_uint_mod(
+            encrypteds1[0].correction_factor(), encrypteds2[0].correction_factor(), parms.plain_modulus());
+        PolyIter result_iter(result);
+
+        // Each term adds two products to the middle component
+        size_t lazy_reduction_summand_bound = size_t(SEAL_MULTIPLY_ACCUMULATE_USER_MOD_MAX) >> 1;
+
+        // The whole computation is done one RNS factor at a time
+        SEAL_ITERATE(iter(size_t(0), coeff_modulus, ntt_tables), coeff_modulus_size, [&](auto I) {
+            size_t index = get<0>(I);
+            size_t lazy_reduction_counter = lazy_reduction_summand_bound;
+
+            // Allocate memory for a lazy accumulator (128-bit coefficients) for each of the three components
+            auto t_poly_lazy(allocate_zero_poly_array(3, coeff_count, 2, pool));
+
+            // Semantic misuse of PolyIter; this is really pointing to the data for a single RNS factor
+            PolyIter accumulator_iter(t_poly_lazy.get(), 2, coeff_count);
+
+            // BGV operands need to be transformed to NTT form; this is done for one RNS factor at a time
+            SEAL_ALLOCATE_GET_RNS_ITER(t_ntt, coeff_count, 4, pool);
+
+            auto accumulate = [&](ConstCoeffIter operand1, ConstCoeffIter operand2, auto accumulator, bool reduce) {
+                SEAL_ITERATE(iter(operand1, operand2, accumulator), coeff_count, [&](auto J) {
+                    unsigned long long qword[2]{ 0, 0 };
+                    multiply_uint64(get<0>(J), get<1>(J), qword);
+                    add_uint128(qword, get<2>(J).ptr(), qword);
+                    if (reduce)
+                    {
+                        get<2>(J)[0] = barrett_reduce_128(qword, get<1>(I));
+                        get<2>(J)[1] = 0;
+                    }
+                    else
+                    {
+                        get<2>(J)[0] = qword[0];
+                        get<2>(J)[1] = qword[1];
+                    }
+                });
+            };
+
+            for (size_t i = 0; i < term_count; i++)
+            {
+                ConstCoeffIter a0 = ConstPolyIter(encrypteds1[i])[0][index];
+                ConstCoeffIter a1 = ConstPolyIter(encrypteds1[i])[1][index];
+                ConstCoeffIter b0 = ConstPolyIter(encrypteds2[i])[0][index];
+                ConstCoeffIter b1 = ConstPolyIter(encrypteds2[i])[1][index];
+                if (!is_ckks)
+                {
+                    set_uint(a0, coeff_count, t_ntt[0]);
+                    set_uint(a1, coeff_count, t_ntt[1]);
+                    set_uint(b0, coeff_count, t_ntt[2]);
+                    set_uint(b1, coeff_count, t_ntt[3]);
+                    SEAL_ITERATE(t_ntt, size_t(4), [&](auto J) { ntt_negacyclic_harvey(J, get<2>(I)); });
+                    a0 = t_ntt[0];
+                    a1 = t_ntt[1];
+                    b0 = t_ntt[2];
+                    b1 = t_ntt[3];
+                }
+
+                bool reduce = !--lazy_reduction_counter;
+                accumulate(a0, b0, accumulator_iter[0], reduce);
+                accumulate(a0, b1, accumulator_iter[1], false);
+                accumulate(a1, b0, accumulator_iter[1], reduce);
+                accumulate(a1, b1, accumulator_iter[2], reduce);
+                if (reduce)
+                {
+                    lazy_reduction_counter = lazy_reduction_summand_bound;
+                }
+            }
+
+            // Final modular reduction
+            SEAL_ITERATE(iter(accumulator_iter, result_iter), size_t(3), [&](auto J) {
+                SEAL_ITERATE(iter(get<0>(J), get<1>(J)[index]), coeff_count, [&](auto K) {
+                    get<1>(K) = barrett_reduce_128(get<0>(K).ptr(), get<1>(I));
+                });
+            });
+        });
+
+        if (!is_ckks)
+        {
+            inverse_ntt_negacyclic_harvey(result, result.size(), ntt_tables);
+        }
+#ifdef SEAL_THROW_ON_TRANSPARENT_CIPHERTEXT
+        // Transparent ciphertext output is not allowed.
+        if (result.is_transparent())
+        {
+            throw logic_error("result ciphertext is transparent");
+        }
+#endif
+        destination = move(result);
+    }
+
     void Evaluator::square_inplace(Ciphertext &encrypted, MemoryPoolHandle pool) const
     {
+        AllocationScope scope("Evaluator::square_inplace");
+
         // Verify parameters.
         if (!is_metadata_valid_for(encrypted, context_) || !is_buffer_valid(encrypted))
         {
@@ -847,8 +1317,8 @@ namespace seal
         size_t base_Bsk_size = rns_tool->base_Bsk()->size();
         size_t base_Bsk_m_tilde_size = rns_tool->base_Bsk_m_tilde()->size();
 
-        // Optimization implemented currently only for size 2 ciphertexts
-        if (encrypted_size != 2)
+        // Optimization implemented currently only for size 2 ciphertexts and BEHZ
+        if (encrypted_size != 2 || context_.rns_method() == rns_method_type::hps)
         {
             bfv_multiply(encrypted, encrypted, move(pool));
             return;
@@ -1104,6 +1574,8 @@ namespace seal
     void Evaluator::relinearize_internal(
         Ciphertext &encrypted, const RelinKeys &relin_keys, size_t destination_size, MemoryPoolHandle pool) const
     {
+        AllocationScope scope("Evaluator::relinearize");
+
         // Verify parameters.
         auto context_data_ptr = context_.get_context_data(encrypted.parms_id());
         if (!context_data_ptr)
@@ -1342,6 +1814,8 @@ namespace seal
     void Evaluator::mod_switch_to_next(
         const Ciphertext &encrypted, Ciphertext &destination, MemoryPoolHandle pool) const
     {
+        AllocationScope scope("Evaluator::mod_switch_to_next");
+
         // Verify parameters.
         if (!is_metadata_valid_for(encrypted, context_) || !is_buffer_valid(encrypted))
         {
@@ -1388,6 +1862,8 @@ namespace seal
 
     void Evaluator::mod_switch_to_inplace(Ciphertext &encrypted, parms_id_type parms_id, MemoryPoolHandle pool) const
     {
+        AllocationScope scope("Evaluator::mod_switch_to_inplace");
+
         // Verify parameters.
         auto context_data_ptr = context_.get_context_data(encrypted.parms_id());
         auto target_context_data_ptr = context_.get_context_data(parms_id);
@@ -1440,6 +1916,8 @@ namespace seal
 
     void Evaluator::rescale_to_next(const Ciphertext &encrypted, Ciphertext &destination, MemoryPoolHandle pool) const
     {
+        AllocationScope scope("Evaluator::rescale_to_next");
+
         // Verify parameters.
         if (!is_metadata_valid_for(encrypted, context_) || !is_buffer_valid(encrypted))
         {
@@ -1480,6 +1958,8 @@ namespace seal
 
     void Evaluator::rescale_to_inplace(Ciphertext &encrypted, parms_id_type parms_id, MemoryPoolHandle pool) const
     {
+        AllocationScope scope("Evaluator::rescale_to_inplace");
+
         // Verify parameters.
         if (!is_metadata_valid_for(encrypted, context_) || !is_buffer_valid(encrypted))
         {
@@ -1536,6 +2016,8 @@ namespace seal
         const vector<Ciphertext> &encrypteds, const RelinKeys &relin_keys, Ciphertext &destination,
         MemoryPoolHandle pool) const
     {
+        AllocationScope scope("Evaluator::multiply_many");
+
         // Verify parameters.
         if (encrypteds.size() == 0)
         {
@@ -1609,36 +2091,168 @@ namespace seal
         destination = product_vec.back();
     }
 
-    void Evaluator::exponentiate_inplace(
-        Ciphertext &encrypted, uint64_t exponent, const RelinKeys &relin_keys, MemoryPoolHandle pool) const
+    void Evaluator::multiply_many_parallel(
+        const vector<Ciphertext> &encrypteds, const RelinKeys &relin_keys, Ciphertext &destination,
+        SEAL_MAYBE_UNUSED size_t thread_count, MemoryPoolHandle pool) const
     {
+        AllocationScope scope("Evaluator::multiply_many_parallel");
+
         // Verify parameters.
-        auto context_data_ptr = context_.get_context_data(encrypted.parms_id());
-        if (!context_data_ptr)
+        if (encrypteds.size() == 0)
         {
-            throw invalid_argument("encrypted is not valid for encryption parameters");
+            throw invalid_argument("encrypteds vector must not be empty");
         }
-        if (!context_.get_context_data(relin_keys.parms_id()))
+        for (size_t i = 0; i < encrypteds.size(); i++)
         {
-            throw invalid_argument("relin_keys is not valid for encryption parameters");
+            if (&encrypteds[i] == &destination)
+            {
+                throw invalid_argument("encrypteds must be different from destination");
+            }
         }
-        if (!pool)
+
+        // There is at least one ciphertext
+        auto context_data_ptr = context_.get_context_data(encrypteds[0].parms_id());
+        if (!context_data_ptr)
         {
-            throw invalid_argument("pool is uninitialized");
+            throw invalid_argument("encrypteds is not valid for encryption parameters");
         }
-        if (exponent == 0)
+
+        // Extract encryption parameters.
+        auto &context_data = *context_data_ptr;
+        auto &parms = context_data.parms();
+
+        if (parms.scheme() != scheme_type::bfv && parms.scheme() != scheme_type::bgv)
         {
-            throw invalid_argument("exponent cannot be 0");
+            throw logic_error("unsupported scheme");
         }
 
-        // Fast case
-        if (exponent == 1)
+        if (!pool)
         {
-            return;
+            throw invalid_argument("pool is uninitialized");
         }
 
-        // Create a vector of copies of encrypted
-        vector<Ciphertext> exp_vector(static_cast<size_t>(exponent), encrypted);
+        // If there is only one ciphertext, return it.
+        if (encrypteds.size() == 1)
+        {
+            destination = encrypteds[0];
+            return;
+        }
+
+#ifdef SEAL_USE_THREAD_POOL
+        // The products are allocated concurrently from pool
+        if (!static_cast<MemoryPool &>(pool).is_thread_safe())
+        {
+            multiply_many(encrypteds, relin_keys, destination, move(pool));
+            return;
+        }
+
+        // This is the same tree as in multiply_many: the leaves are the products of pairs of encrypteds followed by
+        // the unpaired last ciphertext, and node leaf_count + j is the product of nodes 2 * j and 2 * j + 1.
+        size_t pair_count = encrypteds.size() / 2;
+        size_t leaf_count = pair_count + (encrypteds.size() & 1);
+        size_t node_count = 2 * leaf_count - 1;
+        vector<Ciphertext> nodes(node_count);
+        vector<const Ciphertext *> node_ptrs(node_count, nullptr);
+        if (encrypteds.size() & 1)
+        {
+            node_ptrs[pair_count] = &encrypteds.back();
+        }
+
+        auto &thread_pool = ThreadPool::Global();
+        size_t worker_count = thread_count ? thread_count : thread_pool.thread_count();
+
+        // Computes the nodes in [begin, end) concurrently; the range is split into one contiguous chunk per worker
+        auto compute_nodes = [&](size_t begin, size_t end) {
+            size_t chunk_count = min(worker_count, end - begin);
+            thread_pool.parallel_for(chunk_count, [&](size_t c) {
+                size_t chunk_begin = begin + c * (end - begin) / chunk_count;
+                size_t chunk_end = begin + (c + 1) * (end - begin) / chunk_count;
+                for (size_t k = chunk_begin; k < chunk_end; k++)
+                {
+                    Ciphertext temp(context_, context_data.parms_id(), pool);
+                    if (k < pair_count)
+                    {
+                        if (encrypteds[2 * k].data() == encrypteds[2 * k + 1].data())
+                        {
+                            square(encrypteds[2 * k], temp, pool);
+                        }
+                        else
+                        {
+                            multiply(encrypteds[2 * k], encrypteds[2 * k + 1], temp, pool);
+                        }
+                    }
+                    else
+                    {
+                        size_t j = k - leaf_count;
+                        multiply(*node_ptrs[2 * j], *node_ptrs[2 * j + 1], temp, pool);
+                    }
+                    relinearize_inplace(temp, relin_keys, pool);
+                    nodes[k] = move(temp);
+                    node_ptrs[k] = &nodes[k];
+                }
+            });
+        };
+
+        // Evaluate the tree one wave at a time; a wave consists of all nodes whose inputs are available
+        compute_nodes(0, pair_count);
+        size_t computed_count = leaf_count;
+        while (computed_count < node_count)
+        {
+            size_t wave_end = computed_count;
+            while (wave_end < node_count && 2 * (wave_end - leaf_count) + 1 < computed_count)
+            {
+                wave_end++;
+            }
+            compute_nodes(computed_count, wave_end);
+
+            // Release the inputs of this wave
+            for (size_t k = computed_count; k < wave_end; k++)
+            {
+                size_t j = k - leaf_count;
+                nodes[2 * j].release();
+                nodes[2 * j + 1].release();
+            }
+            computed_count = wave_end;
+        }
+
+        destination = *node_ptrs.back();
+#else
+        multiply_many(encrypteds, relin_keys, destination, move(pool));
+#endif
+    }
+
+    void Evaluator::exponentiate_inplace(
+        Ciphertext &encrypted, uint64_t exponent, const RelinKeys &relin_keys, MemoryPoolHandle pool) const
+    {
+        AllocationScope scope("Evaluator::exponentiate_inplace");
+
+        // Verify parameters.
+        auto context_data_ptr = context_.get_context_data(encrypted.parms_id());
+        if (!context_data_ptr)
+        {
+            throw invalid_argument("encrypted is not valid for encryption parameters");
+        }
+        if (!context_.get_context_data(relin_keys.parms_id()))
+        {
+            throw invalid_argument("relin_keys is not valid for encryption parameters");
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+        if (exponent == 0)
+        {
+            throw invalid_argument("exponent cannot be 0");
+        }
+
+        // Fast case
+        if (exponent == 1)
+        {
+            return;
+        }
+
+        // Create a vector of copies of encrypted
+        vector<Ciphertext> exp_vector(static_cast<size_t>(exponent), encrypted);
         multiply_many(exp_vector, relin_keys, encrypted, move(pool));
     }
 
@@ -1820,6 +2434,8 @@ namespace seal
 
     void Evaluator::multiply_plain_inplace(Ciphertext &encrypted, const Plaintext &plain, MemoryPoolHandle pool) const
     {
+        AllocationScope scope("Evaluator::multiply_plain_inplace");
+
         // Verify parameters.
         if (!is_metadata_valid_for(encrypted, context_) || !is_buffer_valid(encrypted))
         {
@@ -1829,7 +2445,7 @@ namespace seal
         {
             throw invalid_argument("plain is not valid for encryption parameters");
         }
-        if (encrypted.is_ntt_form() != plain.is_ntt_form())
+        if (encrypted.is_ntt_form() && !plain.is_ntt_form())
         {
             throw invalid_argument("NTT form mismatch");
         }
@@ -1857,6 +2473,12 @@ namespace seal
 
     void Evaluator::multiply_plain_normal(Ciphertext &encrypted, const Plaintext &plain, MemoryPoolHandle pool) const
     {
+        // Verify parameters.
+        if (plain.is_ntt_form() && encrypted.parms_id() != plain.parms_id())
+        {
+            throw invalid_argument("encrypted and plain parameter mismatch");
+        }
+
         // Extract encryption parameters.
         auto &context_data = *context_.get_context_data(encrypted.parms_id());
         auto &parms = context_data.parms();
@@ -1867,10 +2489,10 @@ namespace seal
         uint64_t plain_upper_half_threshold = context_data.plain_upper_half_threshold();
         auto plain_upper_half_increment = context_data.plain_upper_half_increment();
         auto ntt_tables = iter(context_data.small_ntt_tables());
+        auto &kernels = *context_data.poly_kernels();
 
         size_t encrypted_size = encrypted.size();
         size_t plain_coeff_count = plain.coeff_count();
-        size_t plain_nonzero_coeff_count = plain.nonzero_coeff_count();
 
         // Size check
         if (!product_fits_in(encrypted_size, coeff_count, coeff_modulus_size))
@@ -1882,7 +2504,7 @@ namespace seal
         Optimizations for constant / monomial multiplication can lead to the presence of a timing side-channel in
         use-cases where the plaintext data should also be kept private.
         */
-        if (plain_nonzero_coeff_count == 1)
+        if (!plain.is_ntt_form() && plain.nonzero_coeff_count() == 1)
         {
             // Multiplying by a monomial?
             size_t mono_exponent = plain.significant_coeff_count() - 1;
@@ -1932,12 +2554,46 @@ namespace seal
             return;
         }
 
-        // Generic case: any plaintext polynomial
-        // Allocate temporary space for an entire RNS polynomial
-        auto temp(allocate_zero_poly(coeff_count, coeff_modulus_size, pool));
+        // Generic case: any plaintext polynomial. The RNS component of index j of every ciphertext polynomial is
+        // multiplied with the NTT form of the plaintext modulo the j-th prime by passing it through the forward NTT,
+        // the dyadic product, and the inverse NTT in turn while it is still in cache.
+        auto multiply_rns_component = [&](size_t j, ConstCoeffIter plain_ntt) {
+            SEAL_ITERATE(iter(encrypted), encrypted_size, [&](auto I) {
+                // Lazy reduction
+                kernels.ntt_negacyclic_harvey_lazy(I[j], ntt_tables[j]);
+                kernels.dyadic_product_coeffmod(I[j], plain_ntt, coeff_count, coeff_modulus[j], I[j]);
+                inverse_ntt_negacyclic_harvey(I[j], ntt_tables[j]);
+            });
+        };
 
-        if (!context_data.qualifiers().using_fast_plain_lift)
+        if (plain.is_ntt_form())
         {
+            // The plaintext was lifted and transformed ahead of time with transform_to_ntt_inplace
+            ConstRNSIter plain_ntt_iter(plain.data(), coeff_count);
+            SEAL_ITERATE_PARALLEL(iter(size_t(0)), coeff_modulus_size, [&](size_t j) {
+                multiply_rns_component(j, plain_ntt_iter[j]);
+            });
+        }
+        else if (context_data.qualifiers().using_fast_plain_lift)
+        {
+            // Note that in this case plain_upper_half_increment holds its value in RNS form modulo the coeff_modulus
+            // primes, so each RNS component of the lifted plaintext can be computed, transformed, and used on its own
+            // without materializing the whole lifted polynomial.
+            SEAL_ITERATE_PARALLEL(pool, iter(size_t(0)), coeff_modulus_size, [&](size_t j) {
+                SEAL_ALLOCATE_ZERO_GET_COEFF_ITER(plain_ntt, coeff_count, pool);
+                SEAL_ITERATE(iter(plain_ntt, plain.data()), plain_coeff_count, [&](auto J) {
+                    get<0>(J) = SEAL_COND_SELECT(
+                        get<1>(J) >= plain_upper_half_threshold, get<1>(J) + plain_upper_half_increment[j],
+                        get<1>(J));
+                });
+                ntt_negacyclic_harvey(plain_ntt, ntt_tables[j]);
+                multiply_rns_component(j, plain_ntt);
+            });
+        }
+        else
+        {
+            // Allocate temporary space for an entire RNS polynomial
+            auto temp(allocate_zero_poly(coeff_count, coeff_modulus_size, pool));
             StrideIter<uint64_t *> temp_iter(temp.get(), coeff_modulus_size);
 
             SEAL_ITERATE(iter(plain.data(), temp_iter), plain_coeff_count, [&](auto I) {
@@ -1953,32 +2609,14 @@ namespace seal
             });
 
             context_data.rns_tool()->base_q()->decompose_array(temp_iter, coeff_count, pool);
-        }
-        else
-        {
-            // Note that in this case plain_upper_half_increment holds its value in RNS form modulo the coeff_modulus
-            // primes.
-            RNSIter temp_iter(temp.get(), coeff_count);
-            SEAL_ITERATE(iter(temp_iter, plain_upper_half_increment), coeff_modulus_size, [&](auto I) {
-                SEAL_ITERATE(iter(get<0>(I), plain.data()), plain_coeff_count, [&](auto J) {
-                    get<0>(J) =
-                        SEAL_COND_SELECT(get<1>(J) >= plain_upper_half_threshold, get<1>(J) + get<1>(I), get<1>(J));
-                });
-            });
-        }
 
-        // Need to multiply each component in encrypted with temp; first step is to transform to NTT form
-        RNSIter temp_iter(temp.get(), coeff_count);
-        ntt_negacyclic_harvey(temp_iter, coeff_modulus_size, ntt_tables);
-
-        SEAL_ITERATE(iter(encrypted), encrypted_size, [&](auto I) {
-            SEAL_ITERATE(iter(I, temp_iter, coeff_modulus, ntt_tables), coeff_modulus_size, [&](auto J) {
-                // Lazy reduction
-                ntt_negacyclic_harvey_lazy(get<0>(J), get<3>(J));
-                dyadic_product_coeffmod(get<0>(J), get<1>(J), coeff_count, get<2>(J), get<0>(J));
-                inverse_ntt_negacyclic_harvey(get<0>(J), get<3>(J));
+            // Transform the lifted plaintext to NTT form and multiply
+            RNSIter temp_rns_iter(temp.get(), coeff_count);
+            ntt_negacyclic_harvey(temp_rns_iter, coeff_modulus_size, ntt_tables);
+            SEAL_ITERATE_PARALLEL(iter(size_t(0)), coeff_modulus_size, [&](size_t j) {
+                multiply_rns_component(j, temp_rns_iter[j]);
             });
-        });
+        }
 
         // Set the scale
         if (parms.scheme() == scheme_type::ckks)
@@ -2030,8 +2668,163 @@ namespace seal
         }
     }
 
+    void Evaluator::inner_product_plain(
+        const vector<Ciphertext> &encrypteds, const vector<Plaintext> &plains, Ciphertext &destination,
+        MemoryPoolHandle pool) const
+    {
+        AllocationScope scope("Evaluator::inner_product_plain");
+
+        vector<const Ciphertext *> encrypted_ptrs;
+        encrypted_ptrs.reserve(encrypteds.size());
+        for (auto &encrypted : encrypteds)
+        {
+            encrypted_ptrs.push_back(&encrypted);
+        }
+        vector<const Plaintext *> plain_ptrs;
+        plain_ptrs.reserve(plains.size());
+        for (auto &plain : plains)
+        {
+            plain_ptrs.push_back(&plain);
+        }
+        inner_product_plain_internal(encrypted_ptrs, plain_ptrs, destination, move(pool));
+    }
+
+    void Evaluator::inner_product_plain_internal(
+        const vector<const Ciphertext *> &encrypteds, const vector<const Plaintext *> &plains, Ciphertext &destination,
+        MemoryPoolHandle pool) const
+    {
+        // Verify parameters.
+        if (encrypteds.empty() || encrypteds.size() != plains.size())
+        {
+            throw invalid_argument("encrypteds and plains must be non-empty and have the same size");
+        }
+        auto &first_encrypted = *encrypteds[0];
+        auto parms_id = first_encrypted.parms_id();
+        double scale = first_encrypted.scale() * plains[0]->scale();
+        size_t result_size = 0;
+        for (size_t i = 0; i < encrypteds.size(); i++)
+        {
+            auto &encrypted = *encrypteds[i];
+            auto &plain = *plains[i];
+            if (!is_metadata_valid_for(encrypted, context_) || !is_buffer_valid(encrypted))
+            {
+                throw invalid_argument("encrypteds is not valid for encryption parameters");
+            }
+            if (!is_metadata_valid_for(plain, context_) || !is_buffer_valid(plain))
+            {
+                throw invalid_argument("plains is not valid for encryption parameters");
+            }
+            if (!encrypted.is_ntt_form() || !plain.is_ntt_form())
+            {
+                throw invalid_argument("encrypteds and plains must be in NTT form");
+            }
+            if (encrypted.parms_id() != parms_id || plain.parms_id() != parms_id)
+            {
+                throw invalid_argument("encrypteds and plains parameter mismatch");
+            }
+            if (!util::are_close<double>(encrypted.scale() * plain.scale(), scale))
+            {
+                throw invalid_argument("scale mismatch");
+            }
+            if (encrypted.correction_factor() != first_encrypted.correction_factor())
+            {
+                throw invalid_argument("correction factor mismatch");
+            }
+            result_size = max(result_size, encrypted.size());
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+
+        // Extract encryption parameters.
+        auto &context_data = *context_.get_context_data(parms_id);
+        auto &parms = context_data.parms();
+        auto &coeff_modulus = parms.coeff_modulus();
+        size_t coeff_count = parms.poly_modulus_degree();
+        size_t coeff_modulus_size = coeff_modulus.size();
+        size_t term_count = encrypteds.size();
+
+        // Size check
+        if (!product_fits_in(result_size, coeff_count, coeff_modulus_size))
+        {
+            throw logic_error("invalid parameters");
+        }
+
+        // Prepare result; write to a temporary in case destination is one of the inputs
+        Ciphertext result(pool);
+        result.resize(context_, parms_id, result_size);
+        result.is_ntt_form() = true;
+        result.scale() = scale;
+        if (!is_scale_within_bounds(result.scale(), context_data))
+        {
+            throw invalid_argument("scale out of bounds");
+        }
+        result.correction_factor() = first_encrypted.correction_factor();
+        PolyIter result_iter(result);
+
+        // The whole computation is done one RNS factor at a time
+        SEAL_ITERATE(iter(size_t(0), coeff_modulus), coeff_modulus_size, [&](auto I) {
+            size_t index = get<0>(I);
+            size_t lazy_reduction_counter = SEAL_MULTIPLY_ACCUMULATE_USER_MOD_MAX;
+
+            // Allocate memory for a lazy accumulator (128-bit coefficients) for each result polynomial
+            auto t_poly_lazy(allocate_zero_poly_array(result_size, coeff_count, 2, pool));
+
+            // Semantic misuse of PolyIter; this is really pointing to the data for a single RNS factor
+            PolyIter accumulator_iter(t_poly_lazy.get(), 2, coeff_count);
+
+            for (size_t i = 0; i < term_count; i++)
+            {
+                bool reduce = !--lazy_reduction_counter;
+                ConstCoeffIter plain_iter(plains[i]->data() + index * coeff_count);
+                SEAL_ITERATE(
+                    iter(ConstPolyIter(*encrypteds[i]), accumulator_iter), encrypteds[i]->size(), [&](auto J) {
+                        SEAL_ITERATE(iter(get<0>(J)[index], plain_iter, get<1>(J)), coeff_count, [&](auto K) {
+                            unsigned long long qword[2]{ 0, 0 };
+                            multiply_uint64(get<0>(K), get<1>(K), qword);
+
+                            // Accumulate product of encrypted and plain to t_poly_lazy
+                            add_uint128(qword, get<2>(K).ptr(), qword);
+                            if (reduce)
+                            {
+                                get<2>(K)[0] = barrett_reduce_128(qword, get<1>(I));
+                                get<2>(K)[1] = 0;
+                            }
+                            else
+                            {
+                                get<2>(K)[0] = qword[0];
+                                get<2>(K)[1] = qword[1];
+                            }
+                        });
+                    });
+                if (reduce)
+                {
+                    lazy_reduction_counter = SEAL_MULTIPLY_ACCUMULATE_USER_MOD_MAX;
+                }
+            }
+
+            // Final modular reduction
+            SEAL_ITERATE(iter(accumulator_iter, result_iter), result_size, [&](auto J) {
+                SEAL_ITERATE(iter(get<0>(J), get<1>(J)[index]), coeff_count, [&](auto K) {
+                    get<1>(K) = barrett_reduce_128(get<0>(K).ptr(), get<1>(I));
+                });
+            });
+        });
+#ifdef SEAL_THROW_ON_TRANSPARENT_CIPHERTEXT
+        // Transparent ciphertext output is not allowed.
+        if (result.is_transparent())
+        {
+            throw logic_error("result ciphertext is transparent");
+        }
+#endif
+        destination = move(result);
+    }
+
     void Evaluator::transform_to_ntt_inplace(Plaintext &plain, parms_id_type parms_id, MemoryPoolHandle pool) const
     {
+        AllocationScope scope("Evaluator::transform_to_ntt_inplace");
+
         // Verify parameters.
         if (!is_valid_for(plain, context_))
         {
@@ -2125,6 +2918,8 @@ namespace seal
 
     void Evaluator::transform_to_ntt_inplace(Ciphertext &encrypted) const
     {
+        AllocationScope scope("Evaluator::transform_to_ntt_inplace");
+
         // Verify parameters.
         if (!is_metadata_valid_for(encrypted, context_) || !is_buffer_valid(encrypted))
         {
@@ -2173,6 +2968,8 @@ namespace seal
 
     void Evaluator::transform_from_ntt_inplace(Ciphertext &encrypted_ntt) const
     {
+        AllocationScope scope("Evaluator::transform_from_ntt_inplace");
+
         // Verify parameters.
         if (!is_metadata_valid_for(encrypted_ntt, context_) || !is_buffer_valid(encrypted_ntt))
         {
@@ -2221,6 +3018,8 @@ namespace seal
     void Evaluator::apply_galois_inplace(
         Ciphertext &encrypted, uint32_t galois_elt, const GaloisKeys &galois_keys, MemoryPoolHandle pool) const
     {
+        AllocationScope scope("Evaluator::apply_galois_inplace");
+
         // Verify parameters.
         if (!is_metadata_valid_for(encrypted, context_) || !is_buffer_valid(encrypted))
         {
@@ -2325,6 +3124,8 @@ namespace seal
     void Evaluator::rotate_internal(
         Ciphertext &encrypted, int steps, const GaloisKeys &galois_keys, MemoryPoolHandle pool) const
     {
+        AllocationScope scope("Evaluator::rotate");
+
         auto context_data_ptr = context_.get_context_data(encrypted.parms_id());
         if (!context_data_ptr)
         {
@@ -2379,77 +3180,600 @@ namespace seal
         }
     }
 
-    void Evaluator::switch_key_inplace(
-        Ciphertext &encrypted, ConstRNSIter target_iter, const KSwitchKeys &kswitch_keys, size_t kswitch_keys_index,
+    void Evaluator::rotate_internal(
+        Ciphertext &encrypted, int steps, const GaloisKeys &galois_keys, const RotationPlan &plan,
         MemoryPoolHandle pool) const
     {
-        auto parms_id = encrypted.parms_id();
-        auto &context_data = *context_.get_context_data(parms_id);
-        auto &parms = context_data.parms();
-        auto &key_context_data = *context_.key_context_data();
-        auto &key_parms = key_context_data.parms();
-        auto scheme = parms.scheme();
+        AllocationScope scope("Evaluator::rotate");
 
-        // Verify parameters.
-        if (!is_metadata_valid_for(encrypted, context_) || !is_buffer_valid(encrypted))
+        auto context_data_ptr = context_.get_context_data(encrypted.parms_id());
+        if (!context_data_ptr)
         {
             throw invalid_argument("encrypted is not valid for encryption parameters");
         }
-        if (!target_iter)
+        if (!context_data_ptr->qualifiers().using_batching)
         {
-            throw invalid_argument("target_iter");
+            throw logic_error("encryption parameters do not support batching");
         }
-        if (!context_.using_keyswitching())
+        if (galois_keys.parms_id() != context_.key_parms_id())
         {
-            throw logic_error("keyswitching is not supported by the context");
+            throw invalid_argument("galois_keys is not valid for encryption parameters");
+        }
+        if (plan.key_parms_id() != context_.key_parms_id())
+        {
+            throw invalid_argument("plan is not valid for encryption parameters");
         }
 
-        // Don't validate all of kswitch_keys but just check the parms_id.
-        if (kswitch_keys.parms_id() != context_.key_parms_id())
+        // Rotate by each key step of the planned decomposition
+        auto galois_tool = context_data_ptr->galois_tool();
+        for (auto key_step : plan.decomposition(steps))
         {
-            throw invalid_argument("parameter mismatch");
+            apply_galois_inplace(encrypted, galois_tool->get_elt_from_step(key_step), galois_keys, pool);
         }
+    }
 
-        if (kswitch_keys_index >= kswitch_keys.data().size())
+    void Evaluator::rotate_many_internal(
+        const Ciphertext &encrypted, const vector<int> &steps, const GaloisKeys &galois_keys,
+        vector<Ciphertext> &destination, MemoryPoolHandle pool) const
+    {
+        AllocationScope scope("Evaluator::rotate_many");
+
+        // Verify parameters.
+        if (!is_metadata_valid_for(encrypted, context_) || !is_buffer_valid(encrypted))
         {
-            throw out_of_range("kswitch_keys_index");
+            throw invalid_argument("encrypted is not valid for encryption parameters");
         }
-        if (!pool)
+        auto &context_data = *context_.get_context_data(encrypted.parms_id());
+        if (!context_data.qualifiers().using_batching)
         {
-            throw invalid_argument("pool is uninitialized");
+            throw logic_error("encryption parameters do not support batching");
         }
-        if (scheme == scheme_type::bfv && encrypted.is_ntt_form())
+        if (galois_keys.parms_id() != context_.key_parms_id())
         {
-            throw invalid_argument("BFV encrypted cannot be in NTT form");
+            throw invalid_argument("galois_keys is not valid for encryption parameters");
         }
-        if (scheme == scheme_type::ckks && !encrypted.is_ntt_form())
+        if (!context_.using_keyswitching())
         {
-            throw invalid_argument("CKKS encrypted must be in NTT form");
+            throw logic_error("keyswitching is not supported by the context");
         }
-        if (scheme == scheme_type::bgv && encrypted.is_ntt_form())
+        if (encrypted.size() > 2)
         {
-            throw invalid_argument("BGV encrypted cannot be in NTT form");
+            throw invalid_argument("encrypted size must be 2");
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+
+        auto &parms = context_data.parms();
+        auto &coeff_modulus = parms.coeff_modulus();
+        auto scheme = parms.scheme();
+        if ((scheme == scheme_type::ckks) != encrypted.is_ntt_form())
+        {
+            throw invalid_argument("encrypted is not in the default NTT form");
         }
 
         // Extract encryption parameters.
+        auto &key_context_data = *context_.key_context_data();
+        auto kswitch_tool = context_data.kswitch_tool();
         size_t coeff_count = parms.poly_modulus_degree();
-        size_t decomp_modulus_size = parms.coeff_modulus().size();
-        auto &key_modulus = key_parms.coeff_modulus();
-        size_t key_modulus_size = key_modulus.size();
-        size_t rns_modulus_size = decomp_modulus_size + 1;
+        size_t decomp_modulus_size = coeff_modulus.size();
+        size_t ext_modulus_size = decomp_modulus_size + (kswitch_tool ? kswitch_tool->base_p()->size() : 1);
+        size_t digit_count = kswitch_tool ? kswitch_tool->digit_count() : decomp_modulus_size;
         auto key_ntt_tables = iter(key_context_data.small_ntt_tables());
-        auto modswitch_factors = key_context_data.rns_tool()->inv_q_last_mod_q();
+
+        // Use key_context_data where permutation tables exist since previous runs.
+        auto galois_tool = key_context_data.galois_tool();
 
         // Size check
-        if (!product_fits_in(coeff_count, rns_modulus_size, size_t(2)))
+        if (!product_fits_in(coeff_count, ext_modulus_size, digit_count))
         {
             throw logic_error("invalid parameters");
         }
 
-        // Prepare input
-        auto &key_vector = kswitch_keys.data()[kswitch_keys_index];
-        size_t key_component_count = key_vector[0].data().size();
-
+        // The decomposition of encrypted.data(1) is shared by all rotations: the Galois automorphisms commute with
+        // the digit decomposition and base extension, so they can be applied directly to the decomposed NTT form.
+        auto encrypted_iter = iter(encrypted);
+        SEAL_ALLOCATE_GET_RNS_ITER(t_target, coeff_count, decomp_modulus_size, pool);
+        set_uint(encrypted_iter[1], decomp_modulus_size * coeff_count, t_target);
+        if (scheme == scheme_type::ckks)
+        {
+            inverse_ntt_negacyclic_harvey(t_target, decomp_modulus_size, key_ntt_tables);
+        }
+        SEAL_ALLOCATE_GET_POLY_ITER(t_decomposed, digit_count, coeff_count, ext_modulus_size, pool);
+        kswitch_decompose(context_data, t_target, encrypted_iter[1], t_decomposed, pool);
+
+        SEAL_ALLOCATE_GET_POLY_ITER(t_rotated, digit_count, coeff_count, ext_modulus_size, pool);
+        SEAL_ALLOCATE_GET_POLY_ITER(t_poly_prod, 2, coeff_count, ext_modulus_size, pool);
+
+        // Write to a temporary vector in case encrypted is an element of destination
+        vector<Ciphertext> results;
+        results.reserve(steps.size());
+        for (int step : steps)
+        {
+            results.emplace_back(pool);
+            Ciphertext &result = results.back();
+            uint32_t galois_elt = context_data.galois_tool()->get_elt_from_step(step);
+            if (!step || !galois_keys.has_key(galois_elt))
+            {
+                // Nothing to hoist; fall back to a composition of rotations
+                result = encrypted;
+                rotate_internal(result, step, galois_keys, pool);
+                continue;
+            }
+
+            // Check only the used component in GaloisKeys.
+            auto &key_vector = galois_keys.data()[GaloisKeys::get_index(galois_elt)];
+            if (key_vector.size() < digit_count)
+            {
+                throw invalid_argument("galois_keys is not valid for encryption parameters");
+            }
+            for (auto &each_key : key_vector)
+            {
+                if (!is_metadata_valid_for(each_key, context_) || !is_buffer_valid(each_key))
+                {
+                    throw invalid_argument("galois_keys is not valid for encryption parameters");
+                }
+            }
+
+            // Rotate the decomposed encrypted.data(1) and multiply with the keys
+            galois_tool->apply_galois_ntt(t_decomposed, digit_count, galois_elt, t_rotated);
+            kswitch_inner_product(context_data, t_rotated, key_vector, t_poly_prod, pool);
+
+            // Rotate encrypted.data(0) and add the keyswitched part
+            result.resize(context_, encrypted.parms_id(), 2);
+            result.is_ntt_form() = encrypted.is_ntt_form();
+            result.scale() = encrypted.scale();
+            result.correction_factor() = encrypted.correction_factor();
+            auto result_iter = iter(result);
+            if (scheme == scheme_type::ckks)
+            {
+                galois_tool->apply_galois_ntt(encrypted_iter[0], decomp_modulus_size, galois_elt, result_iter[0]);
+            }
+            else
+            {
+                galois_tool->apply_galois(
+                    encrypted_iter[0], decomp_modulus_size, galois_elt, coeff_modulus, result_iter[0]);
+            }
+            set_zero_poly(coeff_count, decomp_modulus_size, result.data(1));
+            kswitch_mod_down_add(context_data, t_poly_prod, 2, result, pool);
+#ifdef SEAL_THROW_ON_TRANSPARENT_CIPHERTEXT
+            // Transparent ciphertext output is not allowed.
+            if (result.is_transparent())
+            {
+                throw logic_error("result ciphertext is transparent");
+            }
+#endif
+        }
+        swap(destination, results);
+    }
+
+    void Evaluator::apply_galois_extended(
+        const Ciphertext &encrypted, uint32_t galois_elt, const GaloisKeys &galois_keys,
+        ExtendedCiphertext &destination, MemoryPoolHandle pool) const
+    {
+        AllocationScope scope("Evaluator::apply_galois_extended");
+
+        // Verify parameters.
+        if (!is_metadata_valid_for(encrypted, context_) || !is_buffer_valid(encrypted))
+        {
+            throw invalid_argument("encrypted is not valid for encryption parameters");
+        }
+        if (galois_keys.parms_id() != context_.key_parms_id())
+        {
+            throw invalid_argument("galois_keys is not valid for encryption parameters");
+        }
+        if (!context_.using_keyswitching())
+        {
+            throw logic_error("keyswitching is not supported by the context");
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+
+        auto &context_data = *context_.get_context_data(encrypted.parms_id());
+        auto &parms = context_data.parms();
+        auto &coeff_modulus = parms.coeff_modulus();
+        auto scheme = parms.scheme();
+        size_t coeff_count = parms.poly_modulus_degree();
+        size_t decomp_modulus_size = coeff_modulus.size();
+        if ((scheme == scheme_type::ckks) != encrypted.is_ntt_form())
+        {
+            throw invalid_argument("encrypted is not in the default NTT form");
+        }
+        if (encrypted.size() > 2)
+        {
+            throw invalid_argument("encrypted size must be 2");
+        }
+        if (!(galois_elt & 1) || unsigned_geq(galois_elt, mul_safe(static_cast<uint64_t>(coeff_count), uint64_t(2))))
+        {
+            throw invalid_argument("Galois element is not valid");
+        }
+        if (!galois_keys.has_key(galois_elt))
+        {
+            throw invalid_argument("Galois key not present");
+        }
+
+        // Extract encryption parameters.
+        auto &key_context_data = *context_.key_context_data();
+        auto kswitch_tool = context_data.kswitch_tool();
+        size_t ext_modulus_size = decomp_modulus_size + (kswitch_tool ? kswitch_tool->base_p()->size() : 1);
+        size_t digit_count = kswitch_tool ? kswitch_tool->digit_count() : decomp_modulus_size;
+        auto key_ntt_tables = iter(key_context_data.small_ntt_tables());
+
+        // Use key_context_data where permutation tables exist since previous runs.
+        auto galois_tool = key_context_data.galois_tool();
+
+        // Size check
+        if (!product_fits_in(coeff_count, ext_modulus_size, digit_count))
+        {
+            throw logic_error("invalid parameters");
+        }
+
+        // Check only the used component in GaloisKeys.
+        auto &key_vector = galois_keys.data()[GaloisKeys::get_index(galois_elt)];
+        if (key_vector.size() < digit_count)
+        {
+            throw invalid_argument("galois_keys is not valid for encryption parameters");
+        }
+        for (auto &each_key : key_vector)
+        {
+            if (!is_metadata_valid_for(each_key, context_) || !is_buffer_valid(each_key))
+            {
+                throw invalid_argument("galois_keys is not valid for encryption parameters");
+            }
+        }
+
+        // Apply the Galois automorphism to encrypted.data(1); in CKKS keep also the NTT form
+        auto encrypted_iter = iter(encrypted);
+        SEAL_ALLOCATE_GET_RNS_ITER(t_target, coeff_count, decomp_modulus_size, pool);
+        SEAL_ALLOCATE_GET_RNS_ITER(t_target_ntt, coeff_count, decomp_modulus_size, pool);
+        if (scheme == scheme_type::ckks)
+        {
+            galois_tool->apply_galois_ntt(encrypted_iter[1], decomp_modulus_size, galois_elt, t_target_ntt);
+            set_uint(t_target_ntt, decomp_modulus_size * coeff_count, t_target);
+            inverse_ntt_negacyclic_harvey(t_target, decomp_modulus_size, key_ntt_tables);
+        }
+        else
+        {
+            galois_tool->apply_galois(encrypted_iter[1], decomp_modulus_size, galois_elt, coeff_modulus, t_target);
+        }
+
+        // Keyswitch without the final division by the special primes
+        SEAL_ALLOCATE_GET_POLY_ITER(t_decomposed, digit_count, coeff_count, ext_modulus_size, pool);
+        kswitch_decompose(context_data, t_target, t_target_ntt, t_decomposed, pool);
+        DynArray<Ciphertext::ct_coeff_type> ext_data(mul_safe(size_t(2), coeff_count, ext_modulus_size), pool);
+        kswitch_inner_product(
+            context_data, t_decomposed, key_vector, PolyIter(ext_data.begin(), coeff_count, ext_modulus_size), pool);
+
+        // The ciphertext part is (galois(encrypted.data(0)), 0)
+        Ciphertext base(pool);
+        base.resize(context_, encrypted.parms_id(), 2);
+        base.is_ntt_form() = encrypted.is_ntt_form();
+        base.scale() = encrypted.scale();
+        base.correction_factor() = encrypted.correction_factor();
+        if (scheme == scheme_type::ckks)
+        {
+            galois_tool->apply_galois_ntt(encrypted_iter[0], decomp_modulus_size, galois_elt, iter(base)[0]);
+        }
+        else
+        {
+            galois_tool->apply_galois(encrypted_iter[0], decomp_modulus_size, galois_elt, coeff_modulus, iter(base)[0]);
+        }
+
+        // Write to destination only now in case encrypted is the ciphertext part of destination
+        destination.base_ = move(base);
+        destination.ext_data_ = move(ext_data);
+        destination.ext_modulus_size_ = ext_modulus_size;
+    }
+
+    void Evaluator::rotate_extended(
+        const Ciphertext &encrypted, int steps, const GaloisKeys &galois_keys, ExtendedCiphertext &destination,
+        MemoryPoolHandle pool) const
+    {
+        AllocationScope scope("Evaluator::rotate_extended");
+
+        auto context_data_ptr = context_.get_context_data(encrypted.parms_id());
+        if (!context_data_ptr)
+        {
+            throw invalid_argument("encrypted is not valid for encryption parameters");
+        }
+        if (!context_data_ptr->qualifiers().using_batching)
+        {
+            throw logic_error("encryption parameters do not support batching");
+        }
+        apply_galois_extended(
+            encrypted, context_data_ptr->galois_tool()->get_elt_from_step(steps), galois_keys, destination,
+            move(pool));
+    }
+
+    void Evaluator::add_extended_inplace(ExtendedCiphertext &encrypted1, const ExtendedCiphertext &encrypted2) const
+    {
+        // Verify parameters.
+        if (encrypted1.empty() || !is_metadata_valid_for(encrypted1.base_, context_))
+        {
+            throw invalid_argument("encrypted1 is not valid for encryption parameters");
+        }
+        if (encrypted2.empty() || !is_metadata_valid_for(encrypted2.base_, context_))
+        {
+            throw invalid_argument("encrypted2 is not valid for encryption parameters");
+        }
+        if (encrypted1.parms_id() != encrypted2.parms_id() ||
+            encrypted1.ext_modulus_size_ != encrypted2.ext_modulus_size_)
+        {
+            throw invalid_argument("encrypted1 and encrypted2 parameter mismatch");
+        }
+        if (encrypted1.base_.is_ntt_form() != encrypted2.base_.is_ntt_form())
+        {
+            throw invalid_argument("NTT form mismatch");
+        }
+        if (!are_same_scale(encrypted1, encrypted2))
+        {
+            throw invalid_argument("scale mismatch");
+        }
+        if (encrypted1.base_.correction_factor() != encrypted2.base_.correction_factor())
+        {
+            throw invalid_argument("correction factor mismatch");
+        }
+
+        // Extract encryption parameters.
+        auto &context_data = *context_.get_context_data(encrypted1.parms_id());
+        auto &parms = context_data.parms();
+        auto &coeff_modulus = parms.coeff_modulus();
+        auto &key_modulus = context_.key_context_data()->parms().coeff_modulus();
+        size_t coeff_count = parms.poly_modulus_degree();
+        size_t decomp_modulus_size = coeff_modulus.size();
+        size_t ext_modulus_size = encrypted1.ext_modulus_size_;
+        size_t special_modulus_size = ext_modulus_size - decomp_modulus_size;
+
+        // Add the ciphertext parts; these are usually transparent before mod_down so add_inplace cannot be used
+        add_poly_coeffmod(
+            ConstPolyIter(encrypted1.base_.data(), coeff_count, decomp_modulus_size),
+            ConstPolyIter(encrypted2.base_.data(), coeff_count, decomp_modulus_size), size_t(2), coeff_modulus,
+            PolyIter(encrypted1.base_.data(), coeff_count, decomp_modulus_size));
+
+        // Add the keyswitched parts; the special primes are the last primes of the key modulus
+        ConstPolyIter ext_iter2(encrypted2.ext_data(), coeff_count, ext_modulus_size);
+        PolyIter ext_iter1(encrypted1.ext_data_.begin(), coeff_count, ext_modulus_size);
+        SEAL_ITERATE(iter(ext_iter1, ext_iter2), size_t(2), [&](auto I) {
+            add_poly_coeffmod(get<0>(I), get<1>(I), decomp_modulus_size, coeff_modulus, get<0>(I));
+            add_poly_coeffmod(
+                get<0>(I) + decomp_modulus_size, get<1>(I) + decomp_modulus_size, special_modulus_size,
+                iter(key_modulus) + (key_modulus.size() - special_modulus_size), get<0>(I) + decomp_modulus_size);
+        });
+    }
+
+    void Evaluator::mod_down(const ExtendedCiphertext &encrypted, Ciphertext &destination, MemoryPoolHandle pool) const
+    {
+        AllocationScope scope("Evaluator::mod_down");
+
+        // Verify parameters.
+        if (encrypted.empty() || !is_metadata_valid_for(encrypted.base_, context_) ||
+            !is_buffer_valid(encrypted.base_))
+        {
+            throw invalid_argument("encrypted is not valid for encryption parameters");
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+
+        auto &context_data = *context_.get_context_data(encrypted.parms_id());
+        size_t coeff_count = context_data.parms().poly_modulus_degree();
+        size_t ext_modulus_size = encrypted.ext_modulus_size_;
+
+        // The division is done in place, so work on a copy of the keyswitched part
+        SEAL_ALLOCATE_GET_POLY_ITER(t_poly_prod, 2, coeff_count, ext_modulus_size, pool);
+        set_poly_array(encrypted.ext_data(), 2, coeff_count, ext_modulus_size, t_poly_prod);
+
+        destination = encrypted.base_;
+        kswitch_mod_down_add(context_data, t_poly_prod, 2, destination, pool);
+#ifdef SEAL_THROW_ON_TRANSPARENT_CIPHERTEXT
+        // Transparent ciphertext output is not allowed.
+        if (destination.is_transparent())
+        {
+            throw logic_error("result ciphertext is transparent");
+        }
+#endif
+    }
+
+    void Evaluator::linear_transform_inplace(
+        Ciphertext &encrypted, const LinearTransform &transform, const GaloisKeys &galois_keys,
+        MemoryPoolHandle pool) const
+    {
+        AllocationScope scope("Evaluator::linear_transform_inplace");
+
+        // Verify parameters.
+        if (!is_metadata_valid_for(encrypted, context_) || !is_buffer_valid(encrypted))
+        {
+            throw invalid_argument("encrypted is not valid for encryption parameters");
+        }
+        auto &context_data = *context_.get_context_data(encrypted.parms_id());
+        auto scheme = context_data.parms().scheme();
+        if (!context_data.qualifiers().using_batching)
+        {
+            throw logic_error("encryption parameters do not support batching");
+        }
+        if (transform.key_parms_id() != context_.key_parms_id() || transform.scheme() != scheme)
+        {
+            throw invalid_argument("transform is not valid for encryption parameters");
+        }
+        if (galois_keys.parms_id() != context_.key_parms_id())
+        {
+            throw invalid_argument("galois_keys is not valid for encryption parameters");
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+
+        auto &diagonals = transform.diagonals(encrypted.parms_id());
+        size_t dimension = transform.dimension();
+        size_t baby_step_count = transform.baby_step_count();
+        size_t giant_step_count = transform.giant_step_count();
+        bool is_ckks = (scheme == scheme_type::ckks);
+
+        // Baby-step rotations share one decomposition of encrypted; step 0 is just a copy
+        vector<int> baby_steps(baby_step_count);
+        iota(baby_steps.begin(), baby_steps.end(), 0);
+        vector<Ciphertext> baby_rotated;
+        rotate_many_internal(encrypted, baby_steps, galois_keys, baby_rotated, pool);
+        if (!is_ckks)
+        {
+            // BFV/BGV diagonals are in NTT form
+            for (auto &rotated : baby_rotated)
+            {
+                transform_to_ntt_inplace(rotated);
+            }
+        }
+
+        Ciphertext result(pool);
+        ExtendedCiphertext ext_result(pool);
+        Ciphertext temp(pool);
+        ExtendedCiphertext ext_temp(pool);
+        auto galois_tool = context_data.galois_tool();
+        for (size_t g = 0; g < giant_step_count; g++)
+        {
+            // Inner sum over the baby steps
+            vector<const Ciphertext *> baby_terms;
+            vector<const Plaintext *> diagonal_terms;
+            for (size_t b = 0; b < baby_step_count && g * baby_step_count + b < dimension; b++)
+            {
+                size_t k = g * baby_step_count + b;
+                if (!transform.is_zero_diagonal(k))
+                {
+                    baby_terms.push_back(&baby_rotated[b]);
+                    diagonal_terms.push_back(&diagonals[k]);
+                }
+            }
+            if (baby_terms.empty())
+            {
+                continue;
+            }
+            Ciphertext inner(pool);
+            inner_product_plain_internal(baby_terms, diagonal_terms, inner, pool);
+            if (!is_ckks)
+            {
+                transform_from_ntt_inplace(inner);
+            }
+
+            // Giant-step rotation; sum up in the extended base when the Galois key is present
+            int giant_step = static_cast<int>(g * baby_step_count);
+            if (giant_step && galois_keys.has_key(galois_tool->get_elt_from_step(giant_step)))
+            {
+                if (ext_result.empty())
+                {
+                    rotate_extended(inner, giant_step, galois_keys, ext_result, pool);
+                }
+                else
+                {
+                    rotate_extended(inner, giant_step, galois_keys, ext_temp, pool);
+                    add_extended_inplace(ext_result, ext_temp);
+                }
+                continue;
+            }
+            rotate_internal(inner, giant_step, galois_keys, pool);
+            if (result.size())
+            {
+                add_inplace(result, inner);
+            }
+            else
+            {
+                result = move(inner);
+            }
+        }
+
+        if (!ext_result.empty())
+        {
+            mod_down(ext_result, temp, pool);
+            if (result.size())
+            {
+                add_inplace(result, temp);
+            }
+            else
+            {
+                result = move(temp);
+            }
+        }
+        if (!result.size())
+        {
+            throw logic_error("result ciphertext is transparent");
+        }
+        encrypted = move(result);
+    }
+
+    void Evaluator::switch_key_inplace(
+        Ciphertext &encrypted, ConstRNSIter target_iter, const KSwitchKeys &kswitch_keys, size_t kswitch_keys_index,
+        MemoryPoolHandle pool) const
+    {
+        auto parms_id = encrypted.parms_id();
+        auto &context_data = *context_.get_context_data(parms_id);
+        auto &parms = context_data.parms();
+        auto &key_context_data = *context_.key_context_data();
+        auto &key_parms = key_context_data.parms();
+        auto scheme = parms.scheme();
+
+        // Verify parameters.
+        if (!is_metadata_valid_for(encrypted, context_) || !is_buffer_valid(encrypted))
+        {
+            throw invalid_argument("encrypted is not valid for encryption parameters");
+        }
+        if (!target_iter)
+        {
+            throw invalid_argument("target_iter");
+        }
+        if (!context_.using_keyswitching())
+        {
+            throw logic_error("keyswitching is not supported by the context");
+        }
+
+        // Don't validate all of kswitch_keys but just check the parms_id.
+        if (kswitch_keys.parms_id() != context_.key_parms_id())
+        {
+            throw invalid_argument("parameter mismatch");
+        }
+
+        if (kswitch_keys_index >= kswitch_keys.data().size())
+        {
+            throw out_of_range("kswitch_keys_index");
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+        if (scheme == scheme_type::bfv && encrypted.is_ntt_form())
+        {
+            throw invalid_argument("BFV encrypted cannot be in NTT form");
+        }
+        if (scheme == scheme_type::ckks && !encrypted.is_ntt_form())
+        {
+            throw invalid_argument("CKKS encrypted must be in NTT form");
+        }
+        if (scheme == scheme_type::bgv && encrypted.is_ntt_form())
+        {
+            throw invalid_argument("BGV encrypted cannot be in NTT form");
+        }
+
+        // Extract encryption parameters.
+        size_t coeff_count = parms.poly_modulus_degree();
+        size_t decomp_modulus_size = parms.coeff_modulus().size();
+        auto &key_modulus = key_parms.coeff_modulus();
+        size_t key_modulus_size = key_modulus.size();
+        size_t rns_modulus_size = decomp_modulus_size + 1;
+        auto key_ntt_tables = iter(key_context_data.small_ntt_tables());
+        auto &kernels = *key_context_data.poly_kernels();
+
+        // Size check
+        if (!product_fits_in(coeff_count, rns_modulus_size, size_t(2)))
+        {
+            throw logic_error("invalid parameters");
+        }
+
+        // Prepare input
+        auto &key_vector = kswitch_keys.data()[kswitch_keys_index];
+        size_t key_component_count = key_vector[0].data().size();
+
         // Check only the used component in KSwitchKeys.
         for (auto &each_key : key_vector)
         {
@@ -2469,6 +3793,26 @@ namespace seal
             inverse_ntt_negacyclic_harvey(t_target, decomp_modulus_size, key_ntt_tables);
         }
 
+        // Hybrid keyswitching extends each digit to the base q U p only once
+        if (auto kswitch_tool = context_data.kswitch_tool())
+        {
+            size_t digit_count = kswitch_tool->digit_count();
+            size_t ext_modulus_size = decomp_modulus_size + kswitch_tool->base_p()->size();
+            if (key_vector.size() < digit_count)
+            {
+                throw invalid_argument("kswitch_keys is not valid for encryption parameters");
+            }
+
+            SEAL_ALLOCATE_GET_POLY_ITER(t_decomposed, digit_count, coeff_count, ext_modulus_size, pool);
+            kswitch_decompose(context_data, t_target, target_iter, t_decomposed, pool);
+
+            SEAL_ALLOCATE_GET_POLY_ITER(t_ext_prod, key_component_count, coeff_count, ext_modulus_size, pool);
+            kswitch_inner_product(context_data, t_decomposed, key_vector, t_ext_prod, pool);
+
+            kswitch_mod_down_add(context_data, t_ext_prod, key_component_count, encrypted, pool);
+            return;
+        }
+
         // Temporary result
         auto t_poly_prod(allocate_zero_poly_array(key_component_count, coeff_count, rns_modulus_size, pool));
 
@@ -2506,10 +3850,10 @@ namespace seal
                     // Perform RNS conversion (modular reduction)
                     else
                     {
-                        modulo_poly_coeffs(t_target[J], coeff_count, key_modulus[key_index], t_ntt);
+                        kernels.modulo_poly_coeffs(t_target[J], coeff_count, key_modulus[key_index], t_ntt);
                     }
                     // NTT conversion lazy outputs in [0, 4q)
-                    ntt_negacyclic_harvey_lazy(t_ntt, key_ntt_tables[key_index]);
+                    kernels.ntt_negacyclic_harvey_lazy(t_ntt, key_ntt_tables[key_index]);
                     t_operand = t_ntt;
                 }
 
@@ -2569,7 +3913,185 @@ namespace seal
         // Accumulated products are now stored in t_poly_prod
 
         // Perform modulus switching with scaling
-        PolyIter t_poly_prod_iter(t_poly_prod.get(), coeff_count, rns_modulus_size);
+        kswitch_mod_down_add(context_data, PolyIter(t_poly_prod.get(), coeff_count, rns_modulus_size),
+            key_component_count, encrypted, pool);
+    }
+
+    void Evaluator::kswitch_decompose(
+        const SEALContext::ContextData &context_data, ConstRNSIter target_iter, ConstRNSIter target_ntt_iter,
+        PolyIter destination, MemoryPoolHandle pool) const
+    {
+        auto &parms = context_data.parms();
+        auto &key_context_data = *context_.key_context_data();
+        auto &key_modulus = key_context_data.parms().coeff_modulus();
+        auto kswitch_tool = context_data.kswitch_tool();
+        size_t coeff_count = parms.poly_modulus_degree();
+        size_t decomp_modulus_size = parms.coeff_modulus().size();
+        size_t key_modulus_size = key_modulus.size();
+        size_t ext_modulus_size = decomp_modulus_size + (kswitch_tool ? kswitch_tool->base_p()->size() : 1);
+        size_t digit_count = kswitch_tool ? kswitch_tool->digit_count() : decomp_modulus_size;
+        auto key_ntt_tables = iter(key_context_data.small_ntt_tables());
+        bool is_ckks = (parms.scheme() == scheme_type::ckks);
+
+        SEAL_ITERATE_PARALLEL(pool, iter(destination, size_t(0)), digit_count, [&](auto I) {
+            size_t digit_index = get<1>(I);
+            size_t digit_begin = digit_index;
+            size_t digit_end = digit_index + 1;
+            if (kswitch_tool)
+            {
+                // Extend the digit to q U p
+                kswitch_tool->mod_up(target_iter, digit_index, get<0>(I), pool);
+                digit_begin = digit_index * kswitch_tool->digit_size();
+                digit_end = digit_begin + kswitch_tool->digit_modulus_size(digit_index);
+            }
+
+            // In CKKS the digit itself is already available in NTT form
+            size_t ntt_skip_begin = is_ckks ? digit_begin : decomp_modulus_size;
+            size_t ntt_skip_end = is_ckks ? digit_end : decomp_modulus_size;
+            SEAL_ITERATE(iter(get<0>(I), size_t(0)), ext_modulus_size, [&](auto J) {
+                size_t index = get<1>(J);
+                size_t key_index = (index < decomp_modulus_size) ? index : key_modulus_size - ext_modulus_size + index;
+                if (index >= ntt_skip_begin && index < ntt_skip_end)
+                {
+                    set_uint(target_ntt_iter[index], coeff_count, get<0>(J));
+                }
+                else if (!kswitch_tool)
+                {
+                    // A single prime only needs to be reduced to the other primes
+                    modulo_poly_coeffs(target_iter[digit_index], coeff_count, key_modulus[key_index], get<0>(J));
+                }
+            });
+
+            // Transform the other components to NTT form, batching runs of consecutive primes
+            auto ntt_components = [&](size_t begin, size_t end) {
+                if (begin < end)
+                {
+                    size_t key_begin =
+                        (begin < decomp_modulus_size) ? begin : key_modulus_size - ext_modulus_size + begin;
+                    ntt_negacyclic_harvey(get<0>(I) + begin, end - begin, key_ntt_tables + key_begin);
+                }
+            };
+            ntt_components(0, ntt_skip_begin);
+            ntt_components(ntt_skip_end, decomp_modulus_size);
+            ntt_components(decomp_modulus_size, ext_modulus_size);
+        });
+    }
+
+    void Evaluator::kswitch_inner_product(
+        const SEALContext::ContextData &context_data, ConstPolyIter decomposed, const vector<PublicKey> &key_vector,
+        PolyIter destination, MemoryPoolHandle pool) const
+    {
+        auto &parms = context_data.parms();
+        auto &key_modulus = context_.key_context_data()->parms().coeff_modulus();
+        auto kswitch_tool = context_data.kswitch_tool();
+        size_t coeff_count = parms.poly_modulus_degree();
+        size_t decomp_modulus_size = parms.coeff_modulus().size();
+        size_t key_modulus_size = key_modulus.size();
+        size_t ext_modulus_size = decomp_modulus_size + (kswitch_tool ? kswitch_tool->base_p()->size() : 1);
+        size_t digit_count = kswitch_tool ? kswitch_tool->digit_count() : decomp_modulus_size;
+        size_t key_component_count = key_vector[0].data().size();
+
+        SEAL_ITERATE_PARALLEL(pool, iter(size_t(0)), ext_modulus_size, [&](auto I) {
+            size_t key_index = (I < decomp_modulus_size) ? I : key_modulus_size - ext_modulus_size + I;
+
+            // Product of two numbers is up to 60 + 60 = 120 bits, so we can sum up to 256 of them without reduction.
+            size_t lazy_reduction_summand_bound = size_t(SEAL_MULTIPLY_ACCUMULATE_USER_MOD_MAX);
+            size_t lazy_reduction_counter = lazy_reduction_summand_bound;
+
+            // Allocate memory for a lazy accumulator (128-bit coefficients)
+            auto t_poly_lazy(allocate_zero_poly_array(key_component_count, coeff_count, 2, pool));
+
+            // Semantic misuse of PolyIter; this is really pointing to the data for a single RNS factor
+            PolyIter accumulator_iter(t_poly_lazy.get(), 2, coeff_count);
+
+            // Multiply with keys and perform lazy reduction on product's coefficients
+            SEAL_ITERATE(iter(decomposed, key_vector), digit_count, [&](auto J) {
+                ConstCoeffIter t_operand = get<0>(J)[I];
+                SEAL_ITERATE(iter(get<1>(J).data(), accumulator_iter), key_component_count, [&](auto K) {
+                    if (!lazy_reduction_counter)
+                    {
+                        SEAL_ITERATE(iter(t_operand, get<0>(K)[key_index], get<1>(K)), coeff_count, [&](auto L) {
+                            unsigned long long qword[2]{ 0, 0 };
+                            multiply_uint64(get<0>(L), get<1>(L), qword);
+                            add_uint128(qword, get<2>(L).ptr(), qword);
+                            get<2>(L)[0] = barrett_reduce_128(qword, key_modulus[key_index]);
+                            get<2>(L)[1] = 0;
+                        });
+                    }
+                    else
+                    {
+                        // Same as above but no reduction
+                        SEAL_ITERATE(iter(t_operand, get<0>(K)[key_index], get<1>(K)), coeff_count, [&](auto L) {
+                            unsigned long long qword[2]{ 0, 0 };
+                            multiply_uint64(get<0>(L), get<1>(L), qword);
+                            add_uint128(qword, get<2>(L).ptr(), qword);
+                            get<2>(L)[0] = qword[0];
+                            get<2>(L)[1] = qword[1];
+                        });
+                    }
+                });
+
+                if (!--lazy_reduction_counter)
+                {
+                    lazy_reduction_counter = lazy_reduction_summand_bound;
+                }
+            });
+
+            // Final modular reduction into the destination, shifted to the appropriate modulus
+            SEAL_ITERATE(iter(accumulator_iter, destination), key_component_count, [&](auto K) {
+                SEAL_ITERATE(iter(get<0>(K), get<1>(K)[I]), coeff_count, [&](auto L) {
+                    get<1>(L) = barrett_reduce_128(get<0>(L).ptr(), key_modulus[key_index]);
+                });
+            });
+        });
+    }
+
+    void Evaluator::kswitch_mod_down_add(
+        const SEALContext::ContextData &context_data, PolyIter t_poly_prod_iter, size_t key_component_count,
+        Ciphertext &encrypted, MemoryPoolHandle pool) const
+    {
+        auto &parms = context_data.parms();
+        auto &key_context_data = *context_.key_context_data();
+        auto &key_modulus = key_context_data.parms().coeff_modulus();
+        auto kswitch_tool = context_data.kswitch_tool();
+        size_t coeff_count = parms.poly_modulus_degree();
+        size_t decomp_modulus_size = parms.coeff_modulus().size();
+        size_t key_modulus_size = key_modulus.size();
+        auto key_ntt_tables = iter(key_context_data.small_ntt_tables());
+        auto &kernels = *key_context_data.poly_kernels();
+        auto scheme = parms.scheme();
+
+        if (kswitch_tool)
+        {
+            auto &coeff_modulus = parms.coeff_modulus();
+            size_t special_modulus_size = kswitch_tool->base_p()->size();
+            auto special_ntt_tables = key_ntt_tables + (key_modulus_size - special_modulus_size);
+            SEAL_ITERATE_PARALLEL(pool, iter(t_poly_prod_iter, encrypted), key_component_count, [&](auto I) {
+                if (scheme == scheme_type::ckks)
+                {
+                    kswitch_tool->divide_and_round_p_ntt_inplace(get<0>(I), key_ntt_tables, special_ntt_tables, pool);
+                }
+                else
+                {
+                    inverse_ntt_negacyclic_harvey(get<0>(I), decomp_modulus_size, key_ntt_tables);
+                    inverse_ntt_negacyclic_harvey(
+                        get<0>(I) + decomp_modulus_size, special_modulus_size, special_ntt_tables);
+                    if (scheme == scheme_type::bgv)
+                    {
+                        kswitch_tool->mod_t_and_divide_p_inplace(get<0>(I), pool);
+                    }
+                    else
+                    {
+                        kswitch_tool->divide_and_round_p_inplace(get<0>(I), pool);
+                    }
+                }
+                add_poly_coeffmod(get<0>(I), get<1>(I), decomp_modulus_size, coeff_modulus, get<1>(I));
+            });
+            return;
+        }
+
+        // Legacy keyswitching with a single special prime
+        auto modswitch_factors = key_context_data.rns_tool()->inv_q_last_mod_q();
         SEAL_ITERATE(iter(encrypted, t_poly_prod_iter), key_component_count, [&](auto I) {
             if (scheme == scheme_type::bgv)
             {
@@ -2617,7 +4139,7 @@ namespace seal
             {
                 // Lazy reduction; this needs to be then reduced mod qi
                 CoeffIter t_last(get<1>(I)[decomp_modulus_size]);
-                inverse_ntt_negacyclic_harvey_lazy(t_last, key_ntt_tables[key_modulus_size - 1]);
+                kernels.inverse_ntt_negacyclic_harvey_lazy(t_last, key_ntt_tables[key_modulus_size - 1]);
 
                 // Add (p-1)/2 to change from flooring to rounding.
                 uint64_t qk = key_modulus[key_modulus_size - 1].value();
@@ -2626,7 +4148,8 @@ namespace seal
                     J = barrett_reduce_64(J + qk_half, key_modulus[key_modulus_size - 1]);
                 });
 
-                SEAL_ITERATE(iter(I, key_modulus, key_ntt_tables, modswitch_factors), decomp_modulus_size, [&](auto J) {
+                auto rns_iter = iter(I, key_modulus, key_ntt_tables, modswitch_factors);
+                SEAL_ITERATE_PARALLEL(pool, rns_iter, decomp_modulus_size, [&](auto J) {
                     SEAL_ALLOCATE_GET_COEFF_ITER(t_ntt, coeff_count, pool);
 
                     // (ct mod 4qk) mod qi
@@ -2634,7 +4157,7 @@ namespace seal
                     if (qk > qi)
                     {
                         // This cannot be spared. NTT only tolerates input that is less than 4*modulus (i.e. qk <=4*qi).
-                        modulo_poly_coeffs(t_last, coeff_count, get<1>(J), t_ntt);
+                        kernels.modulo_poly_coeffs(t_last, coeff_count, get<1>(J), t_ntt);
                     }
                     else
                     {
@@ -2649,7 +4172,7 @@ namespace seal
                     if (scheme == scheme_type::ckks)
                     {
                         // This ntt_negacyclic_harvey_lazy results in [0, 4*qi).
-                        ntt_negacyclic_harvey_lazy(t_ntt, get<2>(J));
+                        kernels.ntt_negacyclic_harvey_lazy(t_ntt, get<2>(J));
 #if SEAL_USER_MOD_BIT_COUNT_MAX > 60
                         // Reduce from [0, 4qi) to [0, 2qi)
                         SEAL_ITERATE(
@@ -2661,7 +4184,7 @@ namespace seal
                     }
                     else if (scheme == scheme_type::bfv)
                     {
-                        inverse_ntt_negacyclic_harvey_lazy(get<0, 1>(J), get<2>(J));
+                        kernels.inverse_ntt_negacyclic_harvey_lazy(get<0, 1>(J), get<2>(J));
                     }
 
                     // ((ct mod qi) - (ct mod qk)) mod qi with output in [0, 2 * qi_lazy)
@@ -2670,7 +4193,7 @@ namespace seal
 
                     // qk^(-1) * ((ct mod qi) - (ct mod qk)) mod qi
                     multiply_poly_scalar_coeffmod(get<0, 1>(J), coeff_count, get<3>(J), get<1>(J), get<0, 1>(J));
-                    add_poly_coeffmod(get<0, 1>(J), get<0, 0>(J), coeff_count, get<1>(J), get<0, 0>(J));
+                    kernels.add_poly_coeffmod(get<0, 1>(J), get<0, 0>(J), coeff_count, get<1>(J), get<0, 0>(J));
                 });
             }
         });
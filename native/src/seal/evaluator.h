@@ -5,11 +5,14 @@
 
 #include "seal/ciphertext.h"
 #include "seal/context.h"
+#include "seal/extendedciphertext.h"
 #include "seal/galoiskeys.h"
+#include "seal/lineartransform.h"
 #include "seal/memorymanager.h"
 #include "seal/modulus.h"
 #include "seal/plaintext.h"
 #include "seal/relinkeys.h"
+#include "seal/rotationplan.h"
 #include "seal/secretkey.h"
 #include "seal/valcheck.h"
 #include "seal/util/iterator.h"
@@ -157,6 +160,31 @@ namespace seal
         */
         void add_many(const std::vector<Ciphertext> &encrypteds, Ciphertext &destination) const;
 
+        /**
+        Adds together a vector of ciphertexts and stores the result in the destination parameter. This is a parallel
+        version of add_many: the ciphertexts are split into contiguous chunks that are summed up concurrently on the
+        internal thread pool (see seal/util/threadpool.h), and the partial sums are then added together. The partial
+        sums are allocated concurrently from the memory pool pointed to by the given MemoryPoolHandle. If this pool is
+        not thread-safe, or if SEAL_USE_THREAD_POOL is not defined, the ciphertexts are added serially as in add_many.
+        The result is identical to that of add_many.
+
+        @param[in] encrypteds The ciphertexts to add
+        @param[out] destination The ciphertext to overwrite with the addition result
+        @param[in] thread_count The maximum number of threads to use, or 0 to use all threads of the thread pool
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if encrypteds is empty
+        @throws std::invalid_argument if encrypteds are not valid for the encryption
+        parameters
+        @throws std::invalid_argument if encrypteds are in different NTT forms
+        @throws std::invalid_argument if encrypteds are at different level or scale
+        @throws std::invalid_argument if destination is one of encrypteds
+        @throws std::invalid_argument if pool is uninitialized
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        void add_many_parallel(
+            const std::vector<Ciphertext> &encrypteds, Ciphertext &destination, std::size_t thread_count = 0,
+            MemoryPoolHandle pool = MemoryManager::GetPool()) const;
+
         /**
         Subtracts two ciphertexts. This function computes the difference of encrypted1 and encrypted2, and stores the
         result in encrypted1.
@@ -282,6 +310,61 @@ namespace seal
             square_inplace(destination, std::move(pool));
         }
 
+        /**
+        Computes the sum of the products of pairs of ciphertexts, i.e., the inner product of two vectors of
+        ciphertexts, and stores the result in the destination parameter. The result is not relinearized, so that a
+        single relinearization suffices for the entire sum; for ciphertexts of size 2 the result has size 3. For the
+        CKKS and BGV schemes the products of ciphertexts of size 2 are accumulated directly in the NTT domain with lazy
+        modular reduction, avoiding the allocation of intermediate ciphertexts. Dynamic memory allocations in the
+        process are allocated from the memory pool pointed to by the given MemoryPoolHandle.
+
+        @param[in] encrypteds1 The first vector of ciphertexts
+        @param[in] encrypteds2 The second vector of ciphertexts
+        @param[out] destination The ciphertext to overwrite with the sum of products
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if encrypteds1 or encrypteds2 is empty or their sizes differ
+        @throws std::invalid_argument if any of the ciphertexts is not valid for the encryption parameters
+        @throws std::invalid_argument if the ciphertexts are at different level or have mismatching scales
+        @throws std::invalid_argument if any of the ciphertexts is not in the default NTT form
+        @throws std::invalid_argument if the output scale is too large for the encryption parameters
+        @throws std::invalid_argument if pool is uninitialized
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        void multiply_accumulate(
+            const std::vector<Ciphertext> &encrypteds1, const std::vector<Ciphertext> &encrypteds2,
+            Ciphertext &destination, MemoryPoolHandle pool = MemoryManager::GetPool()) const;
+
+        /**
+        Computes the inner product of two vectors of ciphertexts and relinearizes the result once, and stores the
+        result in the destination parameter. This is equivalent to multiplying and relinearizing each pair of
+        ciphertexts and adding up the results, but needs only a single relinearization. Dynamic memory allocations in
+        the process are allocated from the memory pool pointed to by the given MemoryPoolHandle.
+
+        @param[in] encrypteds1 The first vector of ciphertexts
+        @param[in] encrypteds2 The second vector of ciphertexts
+        @param[in] relin_keys The relinearization keys
+        @param[out] destination The ciphertext to overwrite with the inner product
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if encrypteds1 or encrypteds2 is empty or their sizes differ
+        @throws std::invalid_argument if any of the ciphertexts or relin_keys is not valid for the encryption
+        parameters
+        @throws std::invalid_argument if the ciphertexts are at different level or have mismatching scales
+        @throws std::invalid_argument if any of the ciphertexts is not in the default NTT form
+        @throws std::invalid_argument if the output scale is too large for the encryption parameters
+        @throws std::invalid_argument if the size of relin_keys is too small
+        @throws std::invalid_argument if pool is uninitialized
+        @throws std::logic_error if keyswitching is not supported by the context
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        inline void inner_product(
+            const std::vector<Ciphertext> &encrypteds1, const std::vector<Ciphertext> &encrypteds2,
+            const RelinKeys &relin_keys, Ciphertext &destination,
+            MemoryPoolHandle pool = MemoryManager::GetPool()) const
+        {
+            multiply_accumulate(encrypteds1, encrypteds2, destination, pool);
+            relinearize_inplace(destination, relin_keys, std::move(pool));
+        }
+
         /**
         Relinearizes a ciphertext. This functions relinearizes encrypted, reducing its size down to 2. If the size of
         encrypted is K+1, the given relinearization keys need to have size at least K-1. Dynamic memory allocations in
@@ -598,6 +681,35 @@ namespace seal
             const std::vector<Ciphertext> &encrypteds, const RelinKeys &relin_keys, Ciphertext &destination,
             MemoryPoolHandle pool = MemoryManager::GetPool()) const;
 
+        /**
+        Multiplies several ciphertexts together. This is a parallel version of multiply_many: the multiplication tree
+        of multiply_many is evaluated level by level, and the independent products of each level are computed
+        concurrently on the internal thread pool (see seal/util/threadpool.h). Relinearization is performed after
+        every multiplication. The products are allocated concurrently from the memory pool pointed to by the given
+        MemoryPoolHandle, and only the final result is copied to destination. If this pool is not thread-safe, or if
+        SEAL_USE_THREAD_POOL is not defined, the ciphertexts are multiplied serially as in multiply_many. The result is
+        identical to that of multiply_many.
+
+        @param[in] encrypteds The ciphertexts to multiply
+        @param[in] relin_keys The relinearization keys
+        @param[out] destination The ciphertext to overwrite with the multiplication result
+        @param[in] thread_count The maximum number of threads to use, or 0 to use all threads of the thread pool
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::logic_error if scheme is not scheme_type::bfv or scheme_type::bgv
+        @throws std::invalid_argument if encrypteds is empty
+        @throws std::invalid_argument if ciphertexts or relin_keys are not valid for the encryption parameters
+        @throws std::invalid_argument if encrypteds are not in the default NTT form
+        @throws std::invalid_argument if the output scale is too large for the encryption parameters
+        @throws std::invalid_argument if the size of relin_keys is too small
+        @throws std::invalid_argument if destination is one of encrypteds
+        @throws std::invalid_argument if pool is uninitialized
+        @throws std::logic_error if keyswitching is not supported by the context
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        void multiply_many_parallel(
+            const std::vector<Ciphertext> &encrypteds, const RelinKeys &relin_keys, Ciphertext &destination,
+            std::size_t thread_count = 0, MemoryPoolHandle pool = MemoryManager::GetPool()) const;
+
         /**
         Exponentiates a ciphertext. This functions raises encrypted to a power. Dynamic memory allocations in the
         process are allocated from the memory pool pointed to by the given MemoryPoolHandle. The exponentiation is done
@@ -717,11 +829,16 @@ namespace seal
         Multiplies a ciphertext with a plaintext. The plaintext cannot be identically 0. Dynamic memory allocations in
         the process are allocated from the memory pool pointed to by the given MemoryPoolHandle.
 
+        A ciphertext that is not in NTT form can also be multiplied with a plaintext that has been transformed to NTT
+        form at the level of the ciphertext with transform_to_ntt_inplace. This avoids lifting and transforming the
+        plaintext on every call when the same plaintext multiplies many BFV or BGV ciphertexts.
+
         @param[in] encrypted The ciphertext to multiply
         @param[in] plain The plaintext to multiply
         @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
         @throws std::invalid_argument if encrypted or plain is not valid for the encryption parameters
-        @throws std::invalid_argument if encrypted and plain are in different NTT forms
+        @throws std::invalid_argument if encrypted is in NTT form and plain is not
+        @throws std::invalid_argument if plain is in NTT form and encrypted and plain are at different levels
         @throws std::invalid_argument if the output scale is too large for the encryption parameters
         @throws std::invalid_argument if pool is uninitialized
         @throws std::logic_error if result ciphertext is transparent
@@ -732,14 +849,17 @@ namespace seal
         /**
         Multiplies a ciphertext with a plaintext. This function multiplies a ciphertext with a plaintext and stores the
         result in the destination parameter. The plaintext cannot be identically 0. Dynamic memory allocations in the
-        process are allocated from the memory pool pointed to by the given MemoryPoolHandle.
+        process are allocated from the memory pool pointed to by the given MemoryPoolHandle. As in
+        multiply_plain_inplace, a ciphertext that is not in NTT form can be multiplied with a plaintext in NTT form at
+        the same level.
 
         @param[in] encrypted The ciphertext to multiply
         @param[in] plain The plaintext to multiply
         @param[out] destination The ciphertext to overwrite with the multiplication result
         @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
         @throws std::invalid_argument if encrypted or plain is not valid for the encryption parameters
-        @throws std::invalid_argument if encrypted and plain are in different NTT forms
+        @throws std::invalid_argument if encrypted is in NTT form and plain is not
+        @throws std::invalid_argument if plain is in NTT form and encrypted and plain are at different levels
         @throws std::invalid_argument if the output scale is too large for the encryption parameters
         @throws std::invalid_argument if pool is uninitialized
         @throws std::logic_error if result ciphertext is transparent
@@ -752,6 +872,33 @@ namespace seal
             multiply_plain_inplace(destination, plain, std::move(pool));
         }
 
+        /**
+        Computes the sum of the products of ciphertexts with plaintexts, i.e., the inner product of a vector of
+        ciphertexts with a vector of plaintexts, and stores the result in the destination parameter. All operands must
+        be in NTT form. The products are accumulated in 128-bit precision and reduced modulo the coefficient modulus
+        only once for every batch of terms that fits in 128 bits, which is considerably faster than multiplying and
+        adding the pairs one by one. For the BFV and BGV schemes the ciphertexts can be transformed to NTT form with
+        transform_to_ntt, and the plaintexts with transform_to_ntt for the level of the ciphertexts. Dynamic memory
+        allocations in the process are allocated from the memory pool pointed to by the given MemoryPoolHandle.
+
+        @param[in] encrypteds The vector of ciphertexts
+        @param[in] plains The vector of plaintexts
+        @param[out] destination The ciphertext to overwrite with the inner product
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if encrypteds or plains is empty or their sizes differ
+        @throws std::invalid_argument if any of the ciphertexts or plaintexts is not valid for the encryption
+        parameters
+        @throws std::invalid_argument if any of the ciphertexts or plaintexts is not in NTT form
+        @throws std::invalid_argument if the operands are at different level
+        @throws std::invalid_argument if the products have mismatching scales or correction factors
+        @throws std::invalid_argument if the output scale is too large for the encryption parameters
+        @throws std::invalid_argument if pool is uninitialized
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        void inner_product_plain(
+            const std::vector<Ciphertext> &encrypteds, const std::vector<Plaintext> &plains, Ciphertext &destination,
+            MemoryPoolHandle pool = MemoryManager::GetPool()) const;
+
         /**
         Transforms a plaintext to NTT domain. This functions applies the Number Theoretic Transform to a plaintext by
         first embedding integers modulo the plaintext modulus to integers modulo the coefficient modulus and then
@@ -998,6 +1145,110 @@ namespace seal
             rotate_rows_inplace(destination, steps, galois_keys, std::move(pool));
         }
 
+        /**
+        Rotates plaintext matrix rows cyclically following a RotationPlan. This function behaves like rotate_rows,
+        except that the rotation is composed from the Galois keys the plan selected as recorded in the plan, instead
+        of from the non-adjacent form of steps. Dynamic memory allocations in the process are allocated from the
+        memory pool pointed to by the given MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext to rotate
+        @param[in] steps The number of steps to rotate (positive left, negative right)
+        @param[in] galois_keys The Galois keys, containing at least the keys for plan.galois_elts()
+        @param[in] plan The rotation plan
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::logic_error if scheme is not scheme_type::bfv or scheme_type::bgv
+        @throws std::logic_error if the encryption parameters do not support batching
+        @throws std::invalid_argument if encrypted, galois_keys, or plan is not valid for
+        the encryption parameters
+        @throws std::invalid_argument if encrypted is not in the default NTT form
+        @throws std::invalid_argument if encrypted has size larger than 2
+        @throws std::invalid_argument if plan does not cover steps
+        @throws std::invalid_argument if necessary Galois keys are not present
+        @throws std::invalid_argument if pool is uninitialized
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        inline void rotate_rows_inplace(
+            Ciphertext &encrypted, int steps, const GaloisKeys &galois_keys, const RotationPlan &plan,
+            MemoryPoolHandle pool = MemoryManager::GetPool()) const
+        {
+            auto scheme = context_.key_context_data()->parms().scheme();
+            if (scheme != scheme_type::bfv && scheme != scheme_type::bgv)
+            {
+                throw std::logic_error("unsupported scheme");
+            }
+            rotate_internal(encrypted, steps, galois_keys, plan, std::move(pool));
+        }
+
+        /**
+        Rotates plaintext matrix rows cyclically following a RotationPlan and writes the result to the destination
+        parameter. Dynamic memory allocations in the process are allocated from the memory pool pointed to by the
+        given MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext to rotate
+        @param[in] steps The number of steps to rotate (positive left, negative right)
+        @param[in] galois_keys The Galois keys, containing at least the keys for plan.galois_elts()
+        @param[in] plan The rotation plan
+        @param[out] destination The ciphertext to overwrite with the rotated result
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::logic_error if scheme is not scheme_type::bfv or scheme_type::bgv
+        @throws std::logic_error if the encryption parameters do not support batching
+        @throws std::invalid_argument if encrypted, galois_keys, or plan is not valid for
+        the encryption parameters
+        @throws std::invalid_argument if encrypted is not in the default NTT form
+        @throws std::invalid_argument if encrypted has size larger than 2
+        @throws std::invalid_argument if plan does not cover steps
+        @throws std::invalid_argument if necessary Galois keys are not present
+        @throws std::invalid_argument if pool is uninitialized
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        inline void rotate_rows(
+            const Ciphertext &encrypted, int steps, const GaloisKeys &galois_keys, const RotationPlan &plan,
+            Ciphertext &destination, MemoryPoolHandle pool = MemoryManager::GetPool()) const
+        {
+            destination = encrypted;
+            rotate_rows_inplace(destination, steps, galois_keys, plan, std::move(pool));
+        }
+
+        /**
+        Rotates plaintext matrix rows cyclically by several step counts at once. When batching is used with the
+        BFV/BGV scheme, this function computes the rotations of the encrypted plaintext matrix rows by each of the
+        given step counts and writes the results to the destination vector, so that destination[i] holds the rotation
+        by steps[i]. The keyswitching input is decomposed and transformed to NTT form only once and shared by all
+        rotations (hoisting), which makes this considerably faster than calling rotate_rows for each step count.
+        Step counts for which no Galois key is present are computed without hoisting as in rotate_rows. Dynamic memory
+        allocations in the process are allocated from the memory pool pointed to by the given MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext to rotate
+        @param[in] steps The numbers of steps to rotate (positive left, negative right)
+        @param[in] galois_keys The Galois keys
+        @param[out] destination The vector of ciphertexts to overwrite with the rotated results
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::logic_error if scheme is not scheme_type::bfv or scheme_type::bgv
+        @throws std::logic_error if the encryption parameters do not support batching
+        @throws std::invalid_argument if encrypted or galois_keys is not valid for
+        the encryption parameters
+        @throws std::invalid_argument if galois_keys do not correspond to the top
+        level parameters in the current context
+        @throws std::invalid_argument if encrypted is in NTT form
+        @throws std::invalid_argument if encrypted has size larger than 2
+        @throws std::invalid_argument if any of steps has too big absolute value
+        @throws std::invalid_argument if necessary Galois keys are not present
+        @throws std::invalid_argument if pool is uninitialized
+        @throws std::logic_error if keyswitching is not supported by the context
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        inline void rotate_rows_many(
+            const Ciphertext &encrypted, const std::vector<int> &steps, const GaloisKeys &galois_keys,
+            std::vector<Ciphertext> &destination, MemoryPoolHandle pool = MemoryManager::GetPool()) const
+        {
+            auto scheme = context_.key_context_data()->parms().scheme();
+            if (scheme != scheme_type::bfv && scheme != scheme_type::bgv)
+            {
+                throw std::logic_error("unsupported scheme");
+            }
+            rotate_many_internal(encrypted, steps, galois_keys, destination, std::move(pool));
+        }
+
         /**
         Rotates plaintext matrix columns cyclically. When batching is used with the BFV scheme, this function rotates
         the encrypted plaintext matrix columns cyclically. Since the size of the batched matrix is 2-by-(N/2), where N
@@ -1133,6 +1384,105 @@ namespace seal
             rotate_vector_inplace(destination, steps, galois_keys, std::move(pool));
         }
 
+        /**
+        Rotates plaintext vector cyclically following a RotationPlan. This function behaves like rotate_vector, except
+        that the rotation is composed from the Galois keys the plan selected as recorded in the plan, instead of from
+        the non-adjacent form of steps. Dynamic memory allocations in the process are allocated from the memory pool
+        pointed to by the given MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext to rotate
+        @param[in] steps The number of steps to rotate (positive left, negative right)
+        @param[in] galois_keys The Galois keys, containing at least the keys for plan.galois_elts()
+        @param[in] plan The rotation plan
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::logic_error if scheme is not scheme_type::ckks
+        @throws std::invalid_argument if encrypted, galois_keys, or plan is not valid for
+        the encryption parameters
+        @throws std::invalid_argument if encrypted is not in the default NTT form
+        @throws std::invalid_argument if encrypted has size larger than 2
+        @throws std::invalid_argument if plan does not cover steps
+        @throws std::invalid_argument if necessary Galois keys are not present
+        @throws std::invalid_argument if pool is uninitialized
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        inline void rotate_vector_inplace(
+            Ciphertext &encrypted, int steps, const GaloisKeys &galois_keys, const RotationPlan &plan,
+            MemoryPoolHandle pool = MemoryManager::GetPool()) const
+        {
+            if (context_.key_context_data()->parms().scheme() != scheme_type::ckks)
+            {
+                throw std::logic_error("unsupported scheme");
+            }
+            rotate_internal(encrypted, steps, galois_keys, plan, std::move(pool));
+        }
+
+        /**
+        Rotates plaintext vector cyclically following a RotationPlan and writes the result to the destination
+        parameter. Dynamic memory allocations in the process are allocated from the memory pool pointed to by the
+        given MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext to rotate
+        @param[in] steps The number of steps to rotate (positive left, negative right)
+        @param[in] galois_keys The Galois keys, containing at least the keys for plan.galois_elts()
+        @param[in] plan The rotation plan
+        @param[out] destination The ciphertext to overwrite with the rotated result
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::logic_error if scheme is not scheme_type::ckks
+        @throws std::invalid_argument if encrypted, galois_keys, or plan is not valid for
+        the encryption parameters
+        @throws std::invalid_argument if encrypted is not in the default NTT form
+        @throws std::invalid_argument if encrypted has size larger than 2
+        @throws std::invalid_argument if plan does not cover steps
+        @throws std::invalid_argument if necessary Galois keys are not present
+        @throws std::invalid_argument if pool is uninitialized
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        inline void rotate_vector(
+            const Ciphertext &encrypted, int steps, const GaloisKeys &galois_keys, const RotationPlan &plan,
+            Ciphertext &destination, MemoryPoolHandle pool = MemoryManager::GetPool()) const
+        {
+            destination = encrypted;
+            rotate_vector_inplace(destination, steps, galois_keys, plan, std::move(pool));
+        }
+
+        /**
+        Rotates plaintext vector cyclically by several step counts at once. When using the CKKS scheme, this function
+        computes the rotations of the encrypted plaintext vector by each of the given step counts and writes the
+        results to the destination vector, so that destination[i] holds the rotation by steps[i]. The keyswitching
+        input is decomposed and transformed to NTT form only once and shared by all rotations (hoisting), which makes
+        this considerably faster than calling rotate_vector for each step count. Step counts for which no Galois key is
+        present are computed without hoisting as in rotate_vector. Dynamic memory allocations in the process are
+        allocated from the memory pool pointed to by the given MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext to rotate
+        @param[in] steps The numbers of steps to rotate (positive left, negative right)
+        @param[in] galois_keys The Galois keys
+        @param[out] destination The vector of ciphertexts to overwrite with the rotated results
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::logic_error if scheme is not scheme_type::ckks
+        @throws std::invalid_argument if encrypted or galois_keys is not valid for
+        the encryption parameters
+        @throws std::invalid_argument if galois_keys do not correspond to the top
+        level parameters in the current context
+        @throws std::invalid_argument if encrypted is not in the default NTT form
+        @throws std::invalid_argument if encrypted has size larger than 2
+        @throws std::invalid_argument if any of steps has too big absolute value
+        @throws std::invalid_argument if necessary Galois keys are not present
+        @throws std::invalid_argument if pool is uninitialized
+        @throws std::logic_error if keyswitching is not supported by the context
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        inline void rotate_vector_many(
+            const Ciphertext &encrypted, const std::vector<int> &steps, const GaloisKeys &galois_keys,
+            std::vector<Ciphertext> &destination, MemoryPoolHandle pool = MemoryManager::GetPool()) const
+        {
+            if (context_.key_context_data()->parms().scheme() != scheme_type::ckks)
+            {
+                throw std::logic_error("unsupported scheme");
+            }
+            rotate_many_internal(encrypted, steps, galois_keys, destination, std::move(pool));
+        }
+
         /**
         Complex conjugates plaintext slot values. When using the CKKS scheme, this function complex conjugates all
         values in the underlying plaintext. Dynamic memory allocations in the process are allocated from the memory pool
@@ -1194,6 +1544,179 @@ namespace seal
             complex_conjugate_inplace(destination, galois_keys, std::move(pool));
         }
 
+        /**
+        Applies a Galois automorphism to a ciphertext and writes the result to an extended ciphertext without dividing
+        the keyswitched part by the special primes. The results of several such operations on ciphertexts at the same
+        level can be summed up with add_extended, and mod_down performs the division only once for the final sum. The
+        Galois key for galois_elt must be present. Dynamic memory allocations in the process are allocated from the
+        memory pool pointed to by the given MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext to apply the Galois automorphism to
+        @param[in] galois_elt The Galois element
+        @param[in] galois_keys The Galois keys
+        @param[out] destination The extended ciphertext to overwrite with the result
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if encrypted or galois_keys is not valid for
+        the encryption parameters
+        @throws std::invalid_argument if galois_keys do not correspond to the top
+        level parameters in the current context
+        @throws std::invalid_argument if encrypted is not in the default NTT form
+        @throws std::invalid_argument if encrypted has size larger than 2
+        @throws std::invalid_argument if the Galois element is not valid
+        @throws std::invalid_argument if necessary Galois keys are not present
+        @throws std::invalid_argument if pool is uninitialized
+        @throws std::logic_error if keyswitching is not supported by the context
+        */
+        void apply_galois_extended(
+            const Ciphertext &encrypted, std::uint32_t galois_elt, const GaloisKeys &galois_keys,
+            ExtendedCiphertext &destination, MemoryPoolHandle pool = MemoryManager::GetPool()) const;
+
+        /**
+        Rotates a ciphertext and writes the result to an extended ciphertext without dividing the keyswitched part by
+        the special primes. For BFV/BGV the matrix rows are rotated as in rotate_rows, for CKKS the vector is rotated
+        as in rotate_vector. Unlike these functions, a Galois key for the given number of steps must be present. Dynamic
+        memory allocations in the process are allocated from the memory pool pointed to by the given MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext to rotate
+        @param[in] steps The number of steps to rotate (positive left, negative right)
+        @param[in] galois_keys The Galois keys
+        @param[out] destination The extended ciphertext to overwrite with the rotated result
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::logic_error if the encryption parameters do not support batching
+        @throws std::invalid_argument if encrypted or galois_keys is not valid for
+        the encryption parameters
+        @throws std::invalid_argument if galois_keys do not correspond to the top
+        level parameters in the current context
+        @throws std::invalid_argument if encrypted is not in the default NTT form
+        @throws std::invalid_argument if encrypted has size larger than 2
+        @throws std::invalid_argument if steps has too big absolute value
+        @throws std::invalid_argument if necessary Galois keys are not present
+        @throws std::invalid_argument if pool is uninitialized
+        @throws std::logic_error if keyswitching is not supported by the context
+        */
+        void rotate_extended(
+            const Ciphertext &encrypted, int steps, const GaloisKeys &galois_keys, ExtendedCiphertext &destination,
+            MemoryPoolHandle pool = MemoryManager::GetPool()) const;
+
+        /**
+        Adds two extended ciphertexts. This function adds together encrypted1 and encrypted2 and stores the result in
+        encrypted1.
+
+        @param[in] encrypted1 The first extended ciphertext to add
+        @param[in] encrypted2 The second extended ciphertext to add
+        @throws std::invalid_argument if encrypted1 or encrypted2 is empty or not valid
+        for the encryption parameters
+        @throws std::invalid_argument if encrypted1 and encrypted2 are at different
+        level or scale, or have different correction factors
+        */
+        void add_extended_inplace(ExtendedCiphertext &encrypted1, const ExtendedCiphertext &encrypted2) const;
+
+        /**
+        Adds two extended ciphertexts. This function adds together encrypted1 and encrypted2 and stores the result in
+        the destination parameter.
+
+        @param[in] encrypted1 The first extended ciphertext to add
+        @param[in] encrypted2 The second extended ciphertext to add
+        @param[out] destination The extended ciphertext to overwrite with the addition result
+        @throws std::invalid_argument if encrypted1 or encrypted2 is empty or not valid
+        for the encryption parameters
+        @throws std::invalid_argument if encrypted1 and encrypted2 are at different
+        level or scale, or have different correction factors
+        */
+        inline void add_extended(
+            const ExtendedCiphertext &encrypted1, const ExtendedCiphertext &encrypted2,
+            ExtendedCiphertext &destination) const
+        {
+            if (&encrypted2 == &destination)
+            {
+                add_extended_inplace(destination, encrypted1);
+            }
+            else
+            {
+                destination = encrypted1;
+                add_extended_inplace(destination, encrypted2);
+            }
+        }
+
+        /**
+        Divides the keyswitched part of an extended ciphertext by the special primes and adds it to the ciphertext
+        part, producing a regular ciphertext at the same level. Dynamic memory allocations in the process are allocated
+        from the memory pool pointed to by the given MemoryPoolHandle.
+
+        @param[in] encrypted The extended ciphertext to convert
+        @param[out] destination The ciphertext to overwrite with the result
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if encrypted is empty or not valid for the
+        encryption parameters
+        @throws std::invalid_argument if pool is uninitialized
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        void mod_down(
+            const ExtendedCiphertext &encrypted, Ciphertext &destination,
+            MemoryPoolHandle pool = MemoryManager::GetPool()) const;
+
+        /**
+        Multiplies a batched ciphertext by a plaintext matrix. The matrix is given as a LinearTransform holding its
+        encoded diagonals, which must be prepared for the level of encrypted. The product is computed with the diagonal
+        method using baby-step giant-step rotations: the baby-step rotations share one hoisted decomposition of
+        encrypted, and the giant-step rotations are summed up in the extended base so that the division by the special
+        primes is performed only once. For CKKS the scale of the result is the product of the scales of encrypted and
+        the LinearTransform. Galois keys should be present for the steps returned by LinearTransform::galois_steps;
+        missing keys are replaced with compositions of rotations at a higher cost. Dynamic memory allocations in the
+        process are allocated from the memory pool pointed to by the given MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext to multiply
+        @param[in] transform The LinearTransform to apply
+        @param[in] galois_keys The Galois keys
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::logic_error if the encryption parameters do not support batching
+        @throws std::invalid_argument if encrypted, transform, or galois_keys is not
+        valid for the encryption parameters
+        @throws std::invalid_argument if transform is not prepared for the level of
+        encrypted
+        @throws std::invalid_argument if encrypted is not in the default NTT form
+        @throws std::invalid_argument if encrypted has size larger than 2
+        @throws std::invalid_argument if necessary Galois keys are not present
+        @throws std::invalid_argument if pool is uninitialized
+        @throws std::logic_error if keyswitching is not supported by the context
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        void linear_transform_inplace(
+            Ciphertext &encrypted, const LinearTransform &transform, const GaloisKeys &galois_keys,
+            MemoryPoolHandle pool = MemoryManager::GetPool()) const;
+
+        /**
+        Multiplies a batched ciphertext by a plaintext matrix and stores the result in the destination parameter. The
+        matrix is given as a LinearTransform holding its encoded diagonals, which must be prepared for the level of
+        encrypted. Dynamic memory allocations in the process are allocated from the memory pool pointed to by the given
+        MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext to multiply
+        @param[in] transform The LinearTransform to apply
+        @param[in] galois_keys The Galois keys
+        @param[out] destination The ciphertext to overwrite with the result
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::logic_error if the encryption parameters do not support batching
+        @throws std::invalid_argument if encrypted, transform, or galois_keys is not
+        valid for the encryption parameters
+        @throws std::invalid_argument if transform is not prepared for the level of
+        encrypted
+        @throws std::invalid_argument if encrypted is not in the default NTT form
+        @throws std::invalid_argument if encrypted has size larger than 2
+        @throws std::invalid_argument if necessary Galois keys are not present
+        @throws std::invalid_argument if pool is uninitialized
+        @throws std::logic_error if keyswitching is not supported by the context
+        @throws std::logic_error if result ciphertext is transparent
+        @see linear_transform_inplace for more details.
+        */
+        inline void linear_transform(
+            const Ciphertext &encrypted, const LinearTransform &transform, const GaloisKeys &galois_keys,
+            Ciphertext &destination, MemoryPoolHandle pool = MemoryManager::GetPool()) const
+        {
+            destination = encrypted;
+            linear_transform_inplace(destination, transform, galois_keys, std::move(pool));
+        }
+
         /**
         Enables access to private members of seal::Evaluator for SEAL_C.
         */
@@ -1210,6 +1733,8 @@ namespace seal
 
         void bfv_multiply(Ciphertext &encrypted1, const Ciphertext &encrypted2, MemoryPoolHandle pool) const;
 
+        void bfv_multiply_hps(Ciphertext &encrypted1, const Ciphertext &encrypted2, MemoryPoolHandle pool) const;
+
         void ckks_multiply(Ciphertext &encrypted1, const Ciphertext &encrypted2, MemoryPoolHandle pool) const;
 
         void bgv_multiply(Ciphertext &encrypted1, const Ciphertext &encrypted2, MemoryPoolHandle pool) const;
@@ -1234,6 +1759,14 @@ namespace seal
         void rotate_internal(
             Ciphertext &encrypted, int steps, const GaloisKeys &galois_keys, MemoryPoolHandle pool) const;
 
+        void rotate_internal(
+            Ciphertext &encrypted, int steps, const GaloisKeys &galois_keys, const RotationPlan &plan,
+            MemoryPoolHandle pool) const;
+
+        void rotate_many_internal(
+            const Ciphertext &encrypted, const std::vector<int> &steps, const GaloisKeys &galois_keys,
+            std::vector<Ciphertext> &destination, MemoryPoolHandle pool) const;
+
         inline void conjugate_internal(
             Ciphertext &encrypted, const GaloisKeys &galois_keys, MemoryPoolHandle pool) const
         {
@@ -1261,10 +1794,29 @@ namespace seal
             Ciphertext &encrypted, util::ConstRNSIter target_iter, const KSwitchKeys &kswitch_keys,
             std::size_t key_index, MemoryPoolHandle pool = MemoryManager::GetPool()) const;
 
+        // Hybrid keyswitching phases: extend each digit of the target to the base q U p in NTT form, take the
+        // inner product with the keyswitching keys in the extended base, and finally divide by P and add the
+        // result to the ciphertext.
+        void kswitch_decompose(
+            const SEALContext::ContextData &context_data, util::ConstRNSIter target_iter,
+            util::ConstRNSIter target_ntt_iter, util::PolyIter destination, MemoryPoolHandle pool) const;
+
+        void kswitch_inner_product(
+            const SEALContext::ContextData &context_data, util::ConstPolyIter decomposed,
+            const std::vector<PublicKey> &key_vector, util::PolyIter destination, MemoryPoolHandle pool) const;
+
+        void kswitch_mod_down_add(
+            const SEALContext::ContextData &context_data, util::PolyIter t_poly_prod_iter,
+            std::size_t key_component_count, Ciphertext &encrypted, MemoryPoolHandle pool) const;
+
         void multiply_plain_normal(Ciphertext &encrypted, const Plaintext &plain, MemoryPoolHandle pool) const;
 
         void multiply_plain_ntt(Ciphertext &encrypted_ntt, const Plaintext &plain_ntt) const;
 
+        void inner_product_plain_internal(
+            const std::vector<const Ciphertext *> &encrypteds, const std::vector<const Plaintext *> &plains,
+            Ciphertext &destination, MemoryPoolHandle pool) const;
+
         SEALContext context_;
     };
 } // namespace seal
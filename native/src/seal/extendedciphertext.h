@@ -0,0 +1,149 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "seal/ciphertext.h"
+#include "seal/context.h"
+#include "seal/dynarray.h"
+#include "seal/memorymanager.h"
+#include "seal/util/common.h"
+#include "seal/util/defines.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace seal
+{
+    /**
+    Class to store a ciphertext whose keyswitched part has not yet been divided
+    by the special primes. Every keyswitching operation ends with a division by
+    the product P of the special primes (ModDown). When many keyswitched results
+    are summed up, e.g., in baby-step giant-step linear transforms, it suffices
+    to perform this division once for the final sum. An extended ciphertext
+    consists of a regular ciphertext part of size 2 and a keyswitched part of
+    two polynomials in NTT form with respect to the primes of the ciphertext
+    part extended by the special primes. The value of an extended ciphertext is
+    the ciphertext part plus the keyswitched part divided by P.
+
+    Extended ciphertexts are created by Evaluator::rotate_extended, summed up by
+    Evaluator::add_extended, and converted back to a regular ciphertext by
+    Evaluator::mod_down. The data is not meant to be modified directly by the
+    user, and extended ciphertexts cannot be serialized.
+
+    @par Thread Safety
+    In general, reading from an extended ciphertext is thread-safe as long as no
+    other thread is concurrently mutating it.
+
+    @see Evaluator::rotate_extended, Evaluator::add_extended, and Evaluator::mod_down.
+    */
+    class ExtendedCiphertext
+    {
+    public:
+        using ct_coeff_type = Ciphertext::ct_coeff_type;
+
+        /**
+        Constructs an empty extended ciphertext allocating no memory.
+
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        ExtendedCiphertext(MemoryPoolHandle pool = MemoryManager::GetPool()) : base_(pool), ext_data_(pool)
+        {}
+
+        /**
+        Creates a new extended ciphertext by copying a given one.
+
+        @param[in] copy The extended ciphertext to copy from
+        */
+        ExtendedCiphertext(const ExtendedCiphertext &copy) = default;
+
+        /**
+        Creates a new extended ciphertext by moving a given one.
+
+        @param[in] source The extended ciphertext to move from
+        */
+        ExtendedCiphertext(ExtendedCiphertext &&source) = default;
+
+        /**
+        Copies a given extended ciphertext to the current one.
+
+        @param[in] assign The extended ciphertext to copy from
+        */
+        ExtendedCiphertext &operator=(const ExtendedCiphertext &assign) = default;
+
+        /**
+        Moves a given extended ciphertext to the current one.
+
+        @param[in] assign The extended ciphertext to move from
+        */
+        ExtendedCiphertext &operator=(ExtendedCiphertext &&assign) = default;
+
+        /**
+        Returns a reference to the regular ciphertext part.
+        */
+        SEAL_NODISCARD inline const Ciphertext &base() const noexcept
+        {
+            return base_;
+        }
+
+        /**
+        Returns a const pointer to the beginning of the keyswitched part.
+        */
+        SEAL_NODISCARD inline const ct_coeff_type *ext_data() const noexcept
+        {
+            return ext_data_.cbegin();
+        }
+
+        /**
+        Returns the number of primes in the extended base of the keyswitched part,
+        i.e., the number of primes of the ciphertext part plus the number of special
+        primes.
+        */
+        SEAL_NODISCARD inline std::size_t ext_modulus_size() const noexcept
+        {
+            return ext_modulus_size_;
+        }
+
+        /**
+        Returns a reference to parms_id of the ciphertext part.
+        */
+        SEAL_NODISCARD inline const parms_id_type &parms_id() const noexcept
+        {
+            return base_.parms_id();
+        }
+
+        /**
+        Returns a reference to the scale. This is only needed when using the CKKS
+        encryption scheme.
+        */
+        SEAL_NODISCARD inline double scale() const noexcept
+        {
+            return base_.scale();
+        }
+
+        /**
+        Returns whether the extended ciphertext holds no data.
+        */
+        SEAL_NODISCARD inline bool empty() const noexcept
+        {
+            return !ext_modulus_size_;
+        }
+
+        /**
+        Returns the currently used MemoryPoolHandle.
+        */
+        SEAL_NODISCARD inline MemoryPoolHandle pool() const noexcept
+        {
+            return ext_data_.pool();
+        }
+
+    private:
+        friend class Evaluator;
+
+        Ciphertext base_;
+
+        DynArray<ct_coeff_type> ext_data_;
+
+        std::size_t ext_modulus_size_ = 0;
+    };
+} // namespace seal
@@ -317,6 +317,35 @@ namespace seal
             throw logic_error("invalid parameters");
         }
 
+        // With hybrid keyswitching there is one key component per digit; the component for a digit encrypts
+        // prod(special primes) * new_key on each prime of the digit.
+        auto kswitch_tool = context_.first_context_data()->kswitch_tool();
+        if (kswitch_tool)
+        {
+            size_t digit_count = kswitch_tool->digit_count();
+            size_t digit_size = kswitch_tool->digit_size();
+            auto p_mod_q = kswitch_tool->p_mod_q();
+
+            // KSwitchKeys data allocated from pool given by MemoryManager::GetPool.
+            destination.resize(digit_count);
+
+            SEAL_ITERATE(iter(destination, size_t(0)), digit_count, [&](auto I) {
+                encrypt_zero_symmetric(
+                    secret_key_, context_, key_context_data.parms_id(), true, save_seed, get<0>(I).data());
+
+                size_t digit_begin = get<1>(I) * digit_size;
+                SEAL_ALLOCATE_GET_COEFF_ITER(temp, coeff_count, pool_);
+                RNSIter destination_iter = *iter(get<0>(I).data());
+                SEAL_ITERATE(
+                    iter(new_key, key_modulus, p_mod_q, destination_iter) + digit_begin,
+                    kswitch_tool->digit_modulus_size(get<1>(I)), [&](auto J) {
+                        multiply_poly_scalar_coeffmod(get<0>(J), coeff_count, get<2>(J), get<1>(J), temp);
+                        add_poly_coeffmod(get<3>(J), temp, coeff_count, get<1>(J), get<3>(J));
+                    });
+            });
+            return;
+        }
+
         // KSwitchKeys data allocated from pool given by MemoryManager::GetPool.
         destination.resize(decomp_mod_count);
 
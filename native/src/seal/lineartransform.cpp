@@ -0,0 +1,229 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/batchencoder.h"
+#include "seal/ckks.h"
+#include "seal/evaluator.h"
+#include "seal/lineartransform.h"
+#include "seal/util/common.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace std;
+using namespace seal::util;
+
+namespace seal
+{
+    LinearTransform::LinearTransform(
+        const SEALContext &context, const vector<vector<uint64_t>> &matrix, parms_id_type parms_id,
+        size_t baby_step_count, MemoryPoolHandle pool)
+        : pool_(move(pool)), context_(context)
+    {
+        if (!pool_)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+        if (!context_.parameters_set())
+        {
+            throw invalid_argument("encryption parameters are not set correctly");
+        }
+
+        auto &context_data = *context_.first_context_data();
+        scheme_ = context_data.parms().scheme();
+        if (scheme_ != scheme_type::bfv && scheme_ != scheme_type::bgv)
+        {
+            throw invalid_argument("unsupported scheme");
+        }
+        if (!context_data.qualifiers().using_batching)
+        {
+            throw invalid_argument("encryption parameters are not valid for batching");
+        }
+
+        initialize(context_data, matrix, baby_step_count, batched_diagonals_);
+        prepare(parms_id);
+    }
+
+    LinearTransform::LinearTransform(
+        const SEALContext &context, const vector<vector<double>> &matrix, parms_id_type parms_id, double scale,
+        size_t baby_step_count, MemoryPoolHandle pool)
+        : LinearTransform(
+              context,
+              [&matrix]() {
+                  vector<vector<complex<double>>> complex_matrix;
+                  complex_matrix.reserve(matrix.size());
+                  for (auto &row : matrix)
+                  {
+                      complex_matrix.emplace_back(row.cbegin(), row.cend());
+                  }
+                  return complex_matrix;
+              }(),
+              parms_id, scale, baby_step_count, move(pool))
+    {}
+
+    LinearTransform::LinearTransform(
+        const SEALContext &context, const vector<vector<complex<double>>> &matrix, parms_id_type parms_id,
+        double scale, size_t baby_step_count, MemoryPoolHandle pool)
+        : pool_(move(pool)), context_(context), scale_(scale)
+    {
+        if (!pool_)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+        if (!context_.parameters_set())
+        {
+            throw invalid_argument("encryption parameters are not set correctly");
+        }
+
+        auto &context_data = *context_.first_context_data();
+        scheme_ = context_data.parms().scheme();
+        if (scheme_ != scheme_type::ckks)
+        {
+            throw invalid_argument("unsupported scheme");
+        }
+
+        initialize(context_data, matrix, baby_step_count, complex_diagonals_);
+        prepare(parms_id);
+    }
+
+    template <typename T>
+    void LinearTransform::initialize(
+        const SEALContext::ContextData &context_data, const vector<vector<T>> &matrix, size_t baby_step_count,
+        vector<vector<T>> &destination)
+    {
+        key_parms_id_ = context_.key_parms_id();
+
+        // The matrix is applied to each row of N/2 slots
+        size_t row_size = context_data.parms().poly_modulus_degree() >> 1;
+        dimension_ = matrix.size();
+        if (!dimension_ || dimension_ > row_size || row_size % dimension_)
+        {
+            throw invalid_argument("matrix has invalid dimension");
+        }
+        if (any_of(matrix.cbegin(), matrix.cend(), [&](auto &row) { return row.size() != dimension_; }))
+        {
+            throw invalid_argument("matrix is not square");
+        }
+        if (baby_step_count > dimension_)
+        {
+            throw invalid_argument("baby_step_count is too large");
+        }
+
+        // Balance the number of baby steps and giant steps
+        baby_step_count_ = baby_step_count
+                               ? baby_step_count
+                               : static_cast<size_t>(ceil(sqrt(static_cast<double>(dimension_))));
+        giant_step_count_ = (dimension_ + baby_step_count_ - 1) / baby_step_count_;
+
+        // Diagonal k = n1 * g + b is pre-rotated to the right by n1 * g and tiled with period dimension_:
+        // diagonal[j] = M[(j - n1 * g) mod d][(j + b) mod d]
+        destination.assign(dimension_, vector<T>());
+        nonzero_diagonals_.assign(dimension_, false);
+        for (size_t k = 0; k < dimension_; k++)
+        {
+            size_t shift = (k / baby_step_count_) * baby_step_count_;
+            size_t baby_step = k - shift;
+            vector<T> diagonal(row_size);
+            bool nonzero = false;
+            for (size_t j = 0; j < dimension_; j++)
+            {
+                diagonal[j] = matrix[(j + dimension_ - shift) % dimension_][(j + baby_step) % dimension_];
+                nonzero = nonzero || (diagonal[j] != T());
+            }
+            if (!nonzero)
+            {
+                continue;
+            }
+            for (size_t j = dimension_; j < row_size; j++)
+            {
+                diagonal[j] = diagonal[j % dimension_];
+            }
+            destination[k] = move(diagonal);
+            nonzero_diagonals_[k] = true;
+        }
+    }
+
+    void LinearTransform::prepare(parms_id_type parms_id)
+    {
+        auto context_data_ptr = context_.get_context_data(parms_id);
+        if (!context_data_ptr || context_data_ptr->chain_index() > context_.first_context_data()->chain_index())
+        {
+            throw invalid_argument("parms_id is not valid for the current context");
+        }
+        if (is_prepared(parms_id))
+        {
+            return;
+        }
+
+        vector<Plaintext> encoded(dimension_, Plaintext(pool_));
+        if (scheme_ == scheme_type::ckks)
+        {
+            CKKSEncoder encoder(context_);
+            for (size_t k = 0; k < dimension_; k++)
+            {
+                if (nonzero_diagonals_[k])
+                {
+                    encoder.encode(complex_diagonals_[k], parms_id, scale_, encoded[k], pool_);
+                }
+            }
+        }
+        else
+        {
+            // Both rows of the plaintext matrix hold the same diagonal
+            BatchEncoder encoder(context_);
+            Evaluator evaluator(context_);
+            for (size_t k = 0; k < dimension_; k++)
+            {
+                if (nonzero_diagonals_[k])
+                {
+                    vector<uint64_t> values(batched_diagonals_[k]);
+                    values.insert(values.end(), batched_diagonals_[k].cbegin(), batched_diagonals_[k].cend());
+                    encoder.encode(values, encoded[k]);
+                    evaluator.transform_to_ntt_inplace(encoded[k], parms_id, pool_);
+                }
+            }
+        }
+        encoded_diagonals_.emplace(parms_id, move(encoded));
+    }
+
+    const vector<Plaintext> &LinearTransform::diagonals(parms_id_type parms_id) const
+    {
+        auto it = encoded_diagonals_.find(parms_id);
+        if (it == encoded_diagonals_.end())
+        {
+            throw invalid_argument("diagonals are not prepared for parms_id");
+        }
+        return it->second;
+    }
+
+    vector<int> LinearTransform::galois_steps() const
+    {
+        vector<int> steps;
+
+        // Baby steps that are used by at least one nonzero diagonal
+        for (size_t b = 1; b < baby_step_count_; b++)
+        {
+            for (size_t k = b; k < dimension_; k += baby_step_count_)
+            {
+                if (nonzero_diagonals_[k])
+                {
+                    steps.push_back(static_cast<int>(b));
+                    break;
+                }
+            }
+        }
+
+        // Giant steps with at least one nonzero diagonal
+        for (size_t g = 1; g < giant_step_count_; g++)
+        {
+            size_t begin = g * baby_step_count_;
+            size_t end = min(begin + baby_step_count_, dimension_);
+            if (any_of(nonzero_diagonals_.cbegin() + static_cast<ptrdiff_t>(begin),
+                    nonzero_diagonals_.cbegin() + static_cast<ptrdiff_t>(end), [](bool nonzero) { return nonzero; }))
+            {
+                steps.push_back(static_cast<int>(begin));
+            }
+        }
+        return steps;
+    }
+} // namespace seal
@@ -0,0 +1,250 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "seal/context.h"
+#include "seal/encryptionparams.h"
+#include "seal/memorymanager.h"
+#include "seal/plaintext.h"
+#include "seal/util/defines.h"
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace seal
+{
+    /**
+    Stores a square plaintext matrix in the form used by Evaluator::linear_transform
+    for computing encrypted matrix-vector products with the diagonal method and
+    baby-step giant-step rotations.
+
+    A matrix M of dimension d is represented by its generalized diagonals, where the
+    k-th diagonal holds the entries M[j][(j + k) mod d]. With n1 baby steps and
+    n2 = ceil(d / n1) giant steps, the product is computed as a sum over the giant
+    steps g of rotations by n1*g of inner sums over the baby steps b of the diagonal
+    n1*g + b multiplied with the input rotated by b. This needs only about n1 + n2
+    rotations instead of d, and all baby-step rotations share a single hoisted
+    decomposition of the input. The diagonals are stored pre-rotated by -n1*g so
+    that no plaintext rotations are needed at evaluation time. Diagonals that are
+    identically zero are skipped.
+
+    The dimension d must divide the number of slots in a row of the plaintext
+    matrix, i.e., N/2 where N is the degree of the polynomial modulus. When d is
+    smaller than N/2, the input vector must be replicated with period d, and so is
+    the output. For BFV and BGV the same matrix is applied to both rows of the
+    plaintext matrix.
+
+    @par Encoded Diagonals
+    The diagonals are encoded and transformed to NTT form separately for each level
+    of the modulus switching chain, as plaintexts in NTT form are specific to a
+    parms_id. The level given to the constructor is prepared immediately; further
+    levels must be prepared by calling prepare before evaluating ciphertexts at
+    those levels.
+
+    @par Thread Safety
+    In general, reading from LinearTransform is thread-safe as long as no other
+    thread is concurrently mutating it, e.g., by calling prepare.
+
+    @see Evaluator::linear_transform for evaluating a LinearTransform.
+    */
+    class LinearTransform
+    {
+    public:
+        /**
+        Creates a LinearTransform from a matrix of integers modulo the plaintext modulus
+        for the BFV or BGV scheme.
+
+        @param[in] context The SEALContext
+        @param[in] matrix The matrix given as a vector of rows
+        @param[in] parms_id The level to prepare the encoded diagonals for
+        @param[in] baby_step_count The number of baby steps, or 0 to choose it automatically
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if the encryption parameters are not valid for batching
+        @throws std::invalid_argument if scheme is not scheme_type::bfv or scheme_type::bgv
+        @throws std::invalid_argument if matrix is not square or its dimension does not
+        divide the row size of the plaintext matrix
+        @throws std::invalid_argument if baby_step_count is larger than the dimension
+        @throws std::invalid_argument if parms_id is not valid for the context
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        LinearTransform(
+            const SEALContext &context, const std::vector<std::vector<std::uint64_t>> &matrix,
+            parms_id_type parms_id, std::size_t baby_step_count = 0,
+            MemoryPoolHandle pool = MemoryManager::GetPool());
+
+        /**
+        Creates a LinearTransform from a matrix of real numbers for the CKKS scheme.
+        The diagonals are encoded with the given scale.
+
+        @param[in] context The SEALContext
+        @param[in] matrix The matrix given as a vector of rows
+        @param[in] parms_id The level to prepare the encoded diagonals for
+        @param[in] scale The scale to encode the diagonals with
+        @param[in] baby_step_count The number of baby steps, or 0 to choose it automatically
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if the encryption parameters are not valid
+        @throws std::invalid_argument if scheme is not scheme_type::ckks
+        @throws std::invalid_argument if matrix is not square or its dimension does not
+        divide the number of slots
+        @throws std::invalid_argument if baby_step_count is larger than the dimension
+        @throws std::invalid_argument if parms_id is not valid for the context
+        @throws std::invalid_argument if scale is not strictly positive or is too large
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        LinearTransform(
+            const SEALContext &context, const std::vector<std::vector<double>> &matrix, parms_id_type parms_id,
+            double scale, std::size_t baby_step_count = 0, MemoryPoolHandle pool = MemoryManager::GetPool());
+
+        /**
+        Creates a LinearTransform from a matrix of complex numbers for the CKKS scheme.
+        The diagonals are encoded with the given scale.
+
+        @param[in] context The SEALContext
+        @param[in] matrix The matrix given as a vector of rows
+        @param[in] parms_id The level to prepare the encoded diagonals for
+        @param[in] scale The scale to encode the diagonals with
+        @param[in] baby_step_count The number of baby steps, or 0 to choose it automatically
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if the encryption parameters are not valid
+        @throws std::invalid_argument if scheme is not scheme_type::ckks
+        @throws std::invalid_argument if matrix is not square or its dimension does not
+        divide the number of slots
+        @throws std::invalid_argument if baby_step_count is larger than the dimension
+        @throws std::invalid_argument if parms_id is not valid for the context
+        @throws std::invalid_argument if scale is not strictly positive or is too large
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        LinearTransform(
+            const SEALContext &context, const std::vector<std::vector<std::complex<double>>> &matrix,
+            parms_id_type parms_id, double scale, std::size_t baby_step_count = 0,
+            MemoryPoolHandle pool = MemoryManager::GetPool());
+
+        /**
+        Encodes the diagonals for the given level unless already done.
+
+        @param[in] parms_id The level to prepare the encoded diagonals for
+        @throws std::invalid_argument if parms_id is not valid for the context
+        */
+        void prepare(parms_id_type parms_id);
+
+        /**
+        Returns whether the diagonals have been encoded for the given level.
+
+        @param[in] parms_id The level to check
+        */
+        SEAL_NODISCARD inline bool is_prepared(parms_id_type parms_id) const
+        {
+            return encoded_diagonals_.find(parms_id) != encoded_diagonals_.end();
+        }
+
+        /**
+        Returns the encoded and pre-rotated diagonals for the given level. The plaintext
+        at index n1*g + b holds the diagonal for giant step g and baby step b; it is
+        empty if the diagonal is identically zero.
+
+        @param[in] parms_id The level of the diagonals
+        @throws std::invalid_argument if the diagonals are not prepared for parms_id
+        */
+        SEAL_NODISCARD const std::vector<Plaintext> &diagonals(parms_id_type parms_id) const;
+
+        /**
+        Returns whether the diagonal with the given index is identically zero.
+
+        @param[in] index The index of the diagonal
+        */
+        SEAL_NODISCARD inline bool is_zero_diagonal(std::size_t index) const
+        {
+            return !nonzero_diagonals_.at(index);
+        }
+
+        /**
+        Returns the rotation steps Evaluator::linear_transform uses. Galois keys should
+        be generated for these steps, e.g., with KeyGenerator::create_galois_keys.
+        */
+        SEAL_NODISCARD std::vector<int> galois_steps() const;
+
+        /**
+        Returns the scheme the LinearTransform was created for.
+        */
+        SEAL_NODISCARD inline scheme_type scheme() const noexcept
+        {
+            return scheme_;
+        }
+
+        /**
+        Returns the dimension of the matrix.
+        */
+        SEAL_NODISCARD inline std::size_t dimension() const noexcept
+        {
+            return dimension_;
+        }
+
+        /**
+        Returns the number of baby steps.
+        */
+        SEAL_NODISCARD inline std::size_t baby_step_count() const noexcept
+        {
+            return baby_step_count_;
+        }
+
+        /**
+        Returns the number of giant steps.
+        */
+        SEAL_NODISCARD inline std::size_t giant_step_count() const noexcept
+        {
+            return giant_step_count_;
+        }
+
+        /**
+        Returns the scale the diagonals are encoded with. This is only used by the
+        CKKS scheme.
+        */
+        SEAL_NODISCARD inline double scale() const noexcept
+        {
+            return scale_;
+        }
+
+        /**
+        Returns the parms_id of the top level of the context the LinearTransform
+        was created for.
+        */
+        SEAL_NODISCARD inline const parms_id_type &key_parms_id() const noexcept
+        {
+            return key_parms_id_;
+        }
+
+    private:
+        template <typename T>
+        void initialize(
+            const SEALContext::ContextData &context_data, const std::vector<std::vector<T>> &matrix,
+            std::size_t baby_step_count, std::vector<std::vector<T>> &destination);
+
+        MemoryPoolHandle pool_;
+
+        SEALContext context_;
+
+        scheme_type scheme_;
+
+        parms_id_type key_parms_id_;
+
+        std::size_t dimension_ = 0;
+
+        std::size_t baby_step_count_ = 0;
+
+        std::size_t giant_step_count_ = 0;
+
+        double scale_ = 1.0;
+
+        std::vector<bool> nonzero_diagonals_;
+
+        // Tiled and pre-rotated diagonals; only one of these is used depending on the scheme
+        std::vector<std::vector<std::uint64_t>> batched_diagonals_;
+
+        std::vector<std::vector<std::complex<double>>> complex_diagonals_;
+
+        std::unordered_map<parms_id_type, std::vector<Plaintext>> encoded_diagonals_;
+    };
+} // namespace seal
@@ -2,13 +2,88 @@
 // Licensed under the MIT license.
 
 #include "seal/memorymanager.h"
+#include "seal/util/common.h"
+#include <algorithm>
 
 using namespace std;
+using namespace seal::util;
 
 namespace seal
 {
+    MemoryPoolStats MemoryPoolHandle::stats() const
+    {
+        MemoryPoolStats pool_stats;
+        if (!pool_)
+        {
+            return pool_stats;
+        }
+
+        pool_stats.size_classes = pool_->stats();
+        for (auto &size_class : pool_stats.size_classes)
+        {
+            pool_stats.alloc_byte_count =
+                add_safe(pool_stats.alloc_byte_count, mul_safe(size_class.item_count, size_class.item_byte_count));
+            pool_stats.in_use_byte_count = add_safe(
+                pool_stats.in_use_byte_count,
+                mul_safe(min(size_class.in_use_count, size_class.item_count), size_class.item_byte_count));
+        }
+        pool_stats.cached_byte_count = pool_stats.alloc_byte_count - pool_stats.in_use_byte_count;
+        return pool_stats;
+    }
+
 #ifndef _M_CEE
     mutex MemoryManager::switch_mutex_;
+
+    MemoryPoolTrimmer::MemoryPoolTrimmer(
+        MemoryPoolHandle pool, chrono::milliseconds period, size_t target_byte_count)
+        : pool_(move(pool)), period_(period), target_byte_count_(target_byte_count)
+    {
+        if (!pool_)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+        if (!static_cast<util::MemoryPool &>(pool_).is_thread_safe())
+        {
+            throw invalid_argument("pool is not thread-safe");
+        }
+        if (period_.count() <= 0)
+        {
+            throw invalid_argument("period must be positive");
+        }
+        thread_ = thread(&MemoryPoolTrimmer::run, this);
+    }
+
+    MemoryPoolTrimmer::~MemoryPoolTrimmer() noexcept
+    {
+        {
+            lock_guard<mutex> lock(stop_mutex_);
+            stop_ = true;
+        }
+        stop_cv_.notify_all();
+        thread_.join();
+    }
+
+    void MemoryPoolTrimmer::run() noexcept
+    {
+        size_t last_byte_count = pool_.alloc_byte_count();
+        unique_lock<mutex> lock(stop_mutex_);
+        while (!stop_cv_.wait_for(lock, period_, [this] { return stop_; }))
+        {
+            size_t byte_count = pool_.alloc_byte_count();
+            if (byte_count <= last_byte_count)
+            {
+                try
+                {
+                    freed_byte_count_.fetch_add(pool_.trim(target_byte_count_), memory_order_relaxed);
+                }
+                catch (...)
+                {
+                    // Trimming failed to allocate scratch space; try again in the next period
+                }
+            }
+            last_byte_count = pool_.alloc_byte_count();
+        }
+    }
 #else
 #pragma message("WARNING: MemoryManager compiled thread-unsafe and MMProfGuard disabled to support /clr")
 #endif
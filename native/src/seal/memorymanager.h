@@ -10,6 +10,7 @@
 #include <stdexcept>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 /*
 For .NET Framework wrapper support (C++/CLI) we need to
@@ -18,12 +19,59 @@ For .NET Framework wrapper support (C++/CLI) we need to
     (2) disable thread-safe memory pools.
 */
 #ifndef _M_CEE
+#include <chrono>
+#include <condition_variable>
 #include <mutex>
 #include <thread>
 #endif
 
 namespace seal
 {
+    /**
+    Allocation statistics of a memory pool, as returned by MemoryPoolHandle::stats().
+    A memory pool serves each allocation with an item of a fixed byte size that
+    is at least the requested size, and keeps the items that are no longer in use
+    cached for later allocations of the same size.
+    */
+    struct MemoryPoolStats
+    {
+        /**
+        Statistics of the items of one byte size: the item byte count, the number
+        of items allocated and in use, the largest number of items in use at the
+        same time, and the number of allocations served by cached items (reuse_count)
+        and by items that were never in use before (fresh_count).
+        */
+        using SizeClass = util::MemoryPoolHeadStats;
+
+        /**
+        The statistics of each item byte size, in increasing order of byte size.
+        */
+        std::vector<SizeClass> size_classes;
+
+        /**
+        The number of bytes allocated.
+        */
+        std::size_t alloc_byte_count = 0;
+
+        /**
+        The number of allocated bytes in items in use.
+        */
+        std::size_t in_use_byte_count = 0;
+
+        /**
+        The number of allocated bytes in items cached for later allocations.
+        */
+        std::size_t cached_byte_count = 0;
+    };
+
+    /**
+    A sampled allocation of a memory pool, as returned by MemoryPoolHandle::trace().
+    It holds the index of the allocation among all allocations since tracing was
+    enabled, the number of bytes requested, and the name of the Evaluator function
+    the allocation was made for, or nullptr for allocations made elsewhere.
+    */
+    using MemoryPoolTraceEntry = util::MemoryPoolTraceEntry;
+
     /**
     Manages a shared pointer to a memory pool. Microsoft SEAL uses memory pools
     for improved performance due to the large number of memory allocations
@@ -48,6 +96,23 @@ namespace seal
     the user can optionally create such thread-unsafe memory pools and use them
     just as they would use thread-safe memory pools.
 
+    @par Size-Class Memory Pools
+    The default thread-safe memory pools serialize the allocations of each size
+    with a lock, which becomes a bottleneck when many threads share a pool. As an
+    alternative, the user can create memory pools that round allocation sizes up
+    to a small number of size classes and keep a cache of free allocations for
+    each thread, so that most allocations and deallocations do not touch any
+    shared state. Such pools are returned by MemoryPoolHandle::GlobalSizeClass()
+    and MemoryPoolHandle::NewSizeClass(), and the MMProfSizeClass memory manager
+    profile makes all default allocations use the global size-class memory pool.
+
+    @par Arena Memory Pools
+    When all memory allocated during a short task can be released together, an
+    arena memory pool returned by MemoryPoolHandle::Arena() serves allocations
+    from a region reserved up front without any locking or searching, and the
+    MMProfArena memory manager profile resets the arena when it goes out of
+    scope.
+
     @par Initialized and Uninitialized Handles
     A MemoryPoolHandle has to be set to point either to the global memory pool,
     or to a new memory pool. If this is not done, the MemoryPoolHandle is
@@ -153,13 +218,66 @@ namespace seal
         /**
         Returns a MemoryPoolHandle pointing to a new thread-safe memory pool.
 
+        Large data such as GaloisKeys and RelinKeys, which take their memory pool
+        from the memory manager when they are created, can be placed in huge pages
+        by creating or loading them while an MMProfGuard with an MMProfFixed for a
+        memory pool using huge pages is in effect. This reduces the TLB misses when
+        the keys are walked during key switching.
+
         @param[in] clear_on_destruction Indicates whether the memory pool data
         should be cleared when destroyed. This can be important when memory pools
         are used to store private data.
+        @param[in] huge_pages Indicates whether allocations of at least 2 MiB
+        should be mapped from transparent huge pages. This has no effect if
+        Microsoft SEAL was built without SEAL_USE_HUGE_PAGES, and the operating
+        system may still back the memory with regular pages.
+        */
+        SEAL_NODISCARD inline static MemoryPoolHandle New(bool clear_on_destruction = false, bool huge_pages = false)
+        {
+            return MemoryPoolHandle(std::make_shared<util::MemoryPoolMT>(clear_on_destruction, huge_pages));
+        }
+
+        /**
+        Returns a MemoryPoolHandle pointing to the global size-class memory pool.
+        */
+        SEAL_NODISCARD inline static MemoryPoolHandle GlobalSizeClass() noexcept
+        {
+            return util::global_variables::global_size_class_memory_pool;
+        }
+
+        /**
+        Returns a MemoryPoolHandle pointing to a new thread-safe size-class memory
+        pool. Allocation sizes are rounded up to one of 8 sizes between consecutive
+        powers of two, and each thread keeps a cache of free allocations of each
+        size, which lets many threads allocate concurrently without contention.
+
+        @param[in] clear_on_destruction Indicates whether the memory pool data
+        should be cleared when destroyed. This can be important when memory pools
+        are used to store private data.
+        */
+        SEAL_NODISCARD inline static MemoryPoolHandle NewSizeClass(bool clear_on_destruction = false)
+        {
+            return MemoryPoolHandle(std::make_shared<util::MemoryPoolSC>(clear_on_destruction));
+        }
+
+        /**
+        Returns a MemoryPoolHandle pointing to a new thread-safe arena memory
+        pool. The arena reserves a single region of the given size up front and
+        serves allocations by advancing an offset into it; releasing memory to an
+        arena does not make it available again until the arena is reset, for
+        example by the MMProfArena memory manager profile. Allocations that do
+        not fit into the rest of the region come from an internal thread-safe
+        memory pool instead.
+
+        @param[in] capacity The size of the region in bytes
+        @param[in] clear_on_destruction Indicates whether the memory pool data
+        should be cleared when reset or destroyed. This can be important when
+        memory pools are used to store private data.
+        @throws std::invalid_argument if capacity is zero or too large
         */
-        SEAL_NODISCARD inline static MemoryPoolHandle New(bool clear_on_destruction = false)
+        SEAL_NODISCARD inline static MemoryPoolHandle Arena(std::size_t capacity, bool clear_on_destruction = false)
         {
-            return MemoryPoolHandle(std::make_shared<util::MemoryPoolMT>(clear_on_destruction));
+            return MemoryPoolHandle(std::make_shared<util::MemoryPoolArena>(capacity, clear_on_destruction));
         }
 
         /**
@@ -200,6 +318,73 @@ namespace seal
             return !pool_ ? std::size_t(0) : pool_->alloc_byte_count();
         }
 
+        /**
+        Releases memory the memory pool is not using. Allocations with no part in
+        use are freed, largest first, until alloc_byte_count() is at most the given
+        target. If that is not enough, the pages of large unused parts of the other
+        allocations are returned to the operating system where this is supported;
+        they stay counted by alloc_byte_count() and are reallocated on next use.
+        Size-class memory pools count the allocations cached by threads other than
+        the calling one as in use. A memory pool that is not thread-safe, such as
+        the thread-local memory pool, may only be trimmed by the thread that uses
+        it.
+
+        @param[in] target_byte_count The number of bytes the memory pool may keep
+        @throws std::logic_error if the MemoryPoolHandle is uninitialized
+        @return The number of bytes freed
+        */
+        inline std::size_t trim(std::size_t target_byte_count = 0)
+        {
+            if (!pool_)
+            {
+                throw std::logic_error("pool not initialized");
+            }
+            return pool_->trim(target_byte_count);
+        }
+
+        /**
+        Returns the allocation statistics of the memory pool, or empty statistics
+        if the MemoryPoolHandle is uninitialized. The statistics of an item size
+        start over when trim() frees all of its memory. For size-class memory pools
+        the allocations cached by threads count as in use for the peak number of
+        items in use, and the statistics are approximate while other threads use
+        the pool.
+        */
+        SEAL_NODISCARD MemoryPoolStats stats() const;
+
+        /**
+        Starts tracing the allocations of the memory pool, discarding the previous
+        trace. Every sample_period-th allocation is recorded together with the
+        Evaluator function it is made for, and the trace keeps the most recent
+        capacity entries. Tracing makes all threads allocating from the pool update
+        a shared counter, so it should only be enabled while looking for allocation
+        hot spots.
+
+        @param[in] sample_period The number of allocations per recorded allocation,
+        or zero to stop tracing
+        @param[in] capacity The number of entries the trace keeps
+        @throws std::logic_error if the MemoryPoolHandle is uninitialized
+        @throws std::invalid_argument if sample_period is non-zero and capacity is
+        zero or larger than util::MemoryPool::max_trace_capacity
+        */
+        inline void set_trace(std::uint64_t sample_period, std::size_t capacity = 1024)
+        {
+            if (!pool_)
+            {
+                throw std::logic_error("pool not initialized");
+            }
+            pool_->set_trace(sample_period, capacity);
+        }
+
+        /**
+        Returns the entries of the allocation trace, oldest first, or an empty
+        trace if the MemoryPoolHandle is uninitialized.
+        */
+        SEAL_NODISCARD inline std::vector<MemoryPoolTraceEntry> trace() const
+        {
+            return !pool_ ? std::vector<MemoryPoolTraceEntry>() : pool_->trace();
+        }
+
         /**
         Returns the number of MemoryPoolHandle objects sharing this memory pool.
         */
@@ -316,6 +501,38 @@ namespace seal
     private:
     };
 
+    /**
+    A memory manager profile that always returns a MemoryPoolHandle pointing to
+    the global size-class memory pool. Switching to this profile, for example with
+    MMProfGuard, moves all default allocations to a memory pool that scales to
+    many threads allocating concurrently.
+    */
+    class MMProfSizeClass : public MMProf
+    {
+    public:
+        /**
+        Creates a new MMProfSizeClass.
+        */
+        MMProfSizeClass() = default;
+
+        /**
+        Destroys the MMProfSizeClass.
+        */
+        virtual ~MMProfSizeClass() noexcept override
+        {}
+
+        /**
+        Returns a MemoryPoolHandle pointing to the global size-class memory pool.
+        The mm_prof_opt_t input parameter has no effect.
+        */
+        SEAL_NODISCARD inline virtual MemoryPoolHandle get_pool(mm_prof_opt_t) override
+        {
+            return MemoryPoolHandle::GlobalSizeClass();
+        }
+
+    private:
+    };
+
     /**
     A memory manager profile that always returns a MemoryPoolHandle pointing to
     the new thread-safe memory pool. This profile should not be used except in
@@ -387,6 +604,90 @@ namespace seal
     private:
         MemoryPoolHandle pool_;
     };
+
+    /**
+    A memory manager profile that always returns a MemoryPoolHandle pointing to
+    an arena memory pool (see MemoryPoolHandle::Arena), and that resets the arena
+    when the profile is destroyed. Combined with MMProfGuard, this lets a scope
+    such as the handling of a single request allocate all of its temporary data
+    by advancing an offset into a pre-reserved region, and give all of it back at
+    once when the scope ends:
+
+        auto arena = MemoryPoolHandle::Arena(64 * 1024 * 1024);
+        {
+            MMProfGuard guard(std::make_unique<MMProfArena>(arena));
+            // Default allocations in this scope come from the arena
+        }
+        // The arena is now empty
+
+    The reset only takes place if no memory from the region is in use anymore;
+    objects allocated from the arena that outlive the scope keep the region as it
+    is until the next reset. Note that MMProfGuard changes the profile for all
+    threads.
+    */
+    class MMProfArena : public MMProf
+    {
+    public:
+        /**
+        Creates a new MMProfArena with a new arena memory pool.
+
+        @param[in] capacity The size of the region of the arena in bytes
+        @throws std::invalid_argument if capacity is zero or too large
+        */
+        MMProfArena(std::size_t capacity) : pool_(MemoryPoolHandle::Arena(capacity))
+        {}
+
+        /**
+        Creates a new MMProfArena using an existing arena memory pool, which lets
+        the region be reused across many scopes.
+
+        @param[in] pool The MemoryPoolHandle pointing to an arena memory pool
+        @throws std::invalid_argument if pool is uninitialized or not an arena
+        memory pool
+        */
+        MMProfArena(MemoryPoolHandle pool) : pool_(std::move(pool))
+        {
+            if (!pool_)
+            {
+                throw std::invalid_argument("pool is uninitialized");
+            }
+            if (!dynamic_cast<util::MemoryPoolArena *>(&static_cast<util::MemoryPool &>(pool_)))
+            {
+                throw std::invalid_argument("pool is not an arena memory pool");
+            }
+        }
+
+        /**
+        Destroys the MMProfArena and resets the arena.
+        */
+        virtual ~MMProfArena() noexcept override
+        {
+            reset();
+        }
+
+        /**
+        Returns a MemoryPoolHandle pointing to the arena memory pool. The
+        mm_prof_opt_t input parameter has no effect.
+        */
+        SEAL_NODISCARD inline virtual MemoryPoolHandle get_pool(mm_prof_opt_t) override
+        {
+            return pool_;
+        }
+
+        /**
+        Makes the whole region of the arena available again, and returns true if
+        successful. Returns false, leaving the arena unchanged, if memory from the
+        region is still in use. This function must not be called while other
+        threads allocate from the arena.
+        */
+        bool reset() noexcept
+        {
+            return static_cast<util::MemoryPoolArena &>(static_cast<util::MemoryPool &>(pool_)).reset();
+        }
+
+    private:
+        MemoryPoolHandle pool_;
+    };
 #ifndef _M_CEE
     /**
     A memory manager profile that always returns a MemoryPoolHandle pointing to
@@ -549,6 +850,67 @@ namespace seal
 #endif
     };
 #ifndef _M_CEE
+    /**
+    Trims a memory pool in a background thread. Memory pools only grow by default,
+    so that a burst of large allocations stays allocated for as long as the pool
+    exists. A MemoryPoolTrimmer wakes up once every period and, if the memory pool
+    did not grow since the previous wake-up, trims it to the target byte count with
+    MemoryPoolHandle::trim. Memory that is needed steadily is therefore kept, while
+    memory left over from a burst is released once the burst has passed. The thread
+    stops when the MemoryPoolTrimmer is destroyed, which keeps the pool alive until
+    then.
+    */
+    class MemoryPoolTrimmer
+    {
+    public:
+        /**
+        Creates a new MemoryPoolTrimmer and starts its thread.
+
+        @param[in] pool The MemoryPoolHandle pointing to the memory pool to trim
+        @param[in] period The time between checks of the memory pool
+        @param[in] target_byte_count The number of bytes the memory pool may keep
+        @throws std::invalid_argument if pool is uninitialized or not thread-safe,
+        or if period is not positive
+        */
+        MemoryPoolTrimmer(MemoryPoolHandle pool, std::chrono::milliseconds period, std::size_t target_byte_count = 0);
+
+        /**
+        Stops the thread and destroys the MemoryPoolTrimmer.
+        */
+        ~MemoryPoolTrimmer() noexcept;
+
+        /**
+        Returns the number of bytes freed by the MemoryPoolTrimmer so far.
+        */
+        SEAL_NODISCARD inline std::size_t freed_byte_count() const noexcept
+        {
+            return freed_byte_count_.load(std::memory_order_relaxed);
+        }
+
+    private:
+        MemoryPoolTrimmer(const MemoryPoolTrimmer &copy) = delete;
+
+        MemoryPoolTrimmer &operator=(const MemoryPoolTrimmer &assign) = delete;
+
+        void run() noexcept;
+
+        MemoryPoolHandle pool_;
+
+        std::chrono::milliseconds period_;
+
+        std::size_t target_byte_count_;
+
+        std::atomic<std::size_t> freed_byte_count_{ 0 };
+
+        std::mutex stop_mutex_;
+
+        std::condition_variable stop_cv_;
+
+        bool stop_ = false;
+
+        std::thread thread_;
+    };
+
     /**
     Class for a scoped switch of memory manager profile. This class acts as a scoped
     "guard" for changing the memory manager profile so that the programmer does
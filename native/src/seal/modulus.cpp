@@ -72,6 +72,7 @@ namespace seal
             uint64_count_ = 1;
             value_ = 0;
             const_ratio_ = { { 0, 0, 0 } };
+            montgomery_inverse_ = 0;
             is_prime_ = false;
         }
         else if ((value >> SEAL_MOD_BIT_COUNT_MAX != 0) || (value == 1))
@@ -97,6 +98,18 @@ namespace seal
             // We store also the remainder
             const_ratio_[2] = numerator[0];
 
+            // Compute the Montgomery constant for odd values with Newton's iteration; the initial value is correct to
+            // three bits since value^2 = 1 mod 8, and each step doubles the number of correct bits.
+            montgomery_inverse_ = 0;
+            if (value_ & 1)
+            {
+                montgomery_inverse_ = value_;
+                for (int i = 0; i < 5; i++)
+                {
+                    montgomery_inverse_ *= 2 - value_ * montgomery_inverse_;
+                }
+            }
+
             uint64_count_ = 1;
 
             // Set the primality flag
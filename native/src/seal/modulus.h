@@ -127,6 +127,15 @@ namespace seal
             return const_ratio_;
         }
 
+        /**
+        Returns the inverse of the value of the current Modulus modulo 2^64, which is the constant for Montgomery
+        reduction (see util::montgomery_reduce_128), if the value is odd, and zero otherwise.
+        */
+        SEAL_NODISCARD inline std::uint64_t montgomery_inverse() const noexcept
+        {
+            return montgomery_inverse_;
+        }
+
         /**
         Returns whether the value of the current Modulus is zero.
         */
@@ -372,6 +381,8 @@ namespace seal
 
         std::array<std::uint64_t, 3> const_ratio_{ { 0, 0, 0 } };
 
+        std::uint64_t montgomery_inverse_ = 0;
+
         std::size_t uint64_count_ = 0;
 
         int bit_count_ = 0;
@@ -0,0 +1,241 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/rotationplan.h"
+#include "seal/util/common.h"
+#include "seal/util/galois.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+using namespace std;
+using namespace seal::util;
+
+namespace seal
+{
+    namespace
+    {
+        constexpr uint32_t unreachable = numeric_limits<uint32_t>::max();
+
+        // Breadth-first search over Z_n from 0 with an edge x -> x + g for every generator g. On return, dist[x]
+        // is the least number of generators summing to x, and last[x] (if given) the index of the last of them.
+        void shortest_paths(size_t n, const vector<size_t> &generators, vector<uint32_t> &dist, vector<size_t> *last)
+        {
+            dist.assign(n, unreachable);
+            if (last)
+            {
+                last->assign(n, 0);
+            }
+            vector<size_t> queue;
+            queue.reserve(n);
+            queue.push_back(0);
+            dist[0] = 0;
+            for (size_t head = 0; head < queue.size(); head++)
+            {
+                size_t x = queue[head];
+                for (size_t i = 0; i < generators.size(); i++)
+                {
+                    size_t y = x + generators[i];
+                    y -= (y >= n) ? n : 0;
+                    if (dist[y] == unreachable)
+                    {
+                        dist[y] = dist[x] + 1;
+                        if (last)
+                        {
+                            (*last)[y] = i;
+                        }
+                        queue.push_back(y);
+                    }
+                }
+            }
+        }
+
+        // Total number of key switches for reaching all targets; an unreachable target counts as n
+        uint64_t total_cost(size_t n, const vector<size_t> &generators, const vector<size_t> &targets)
+        {
+            vector<uint32_t> dist;
+            shortest_paths(n, generators, dist, nullptr);
+            uint64_t cost = 0;
+            for (auto target : targets)
+            {
+                cost += (dist[target] == unreachable) ? n : dist[target];
+            }
+            return cost;
+        }
+    } // namespace
+
+    RotationPlan::RotationPlan(const SEALContext &context, const vector<int> &steps, size_t key_budget_bytes)
+    {
+        if (!context.parameters_set())
+        {
+            throw invalid_argument("encryption parameters are not set correctly");
+        }
+        auto &key_context_data = *context.key_context_data();
+        if (!key_context_data.qualifiers().using_batching)
+        {
+            throw invalid_argument("encryption parameters are not valid for batching");
+        }
+        key_parms_id_ = context.key_parms_id();
+        row_size_ = key_context_data.parms().poly_modulus_degree() >> 1;
+        size_t max_key_count = key_budget_bytes / galois_key_byte_count(context);
+
+        // Distinct nonzero steps in [0, row_size_)
+        vector<size_t> targets;
+        for (auto step : steps)
+        {
+            size_t target = reduce_step(step);
+            if (target && find(targets.cbegin(), targets.cend(), target) == targets.cend())
+            {
+                targets.push_back(target);
+            }
+        }
+
+        vector<size_t> keys;
+        if (targets.size() <= max_key_count)
+        {
+            // Every step gets its own key
+            keys = targets;
+        }
+        else
+        {
+            // Candidate keys are the steps themselves and the positive and negative powers of two. Keys are added
+            // greedily by largest reduction in the total number of key switches. Gains are re-evaluated lazily:
+            // a candidate is accepted once its fresh gain is at least the stale gains of all other candidates.
+            vector<size_t> candidates = targets;
+            for (size_t power = 1; power < row_size_; power <<= 1)
+            {
+                for (auto candidate : { power, row_size_ - power })
+                {
+                    if (find(candidates.cbegin(), candidates.cend(), candidate) == candidates.cend())
+                    {
+                        candidates.push_back(candidate);
+                    }
+                }
+            }
+
+            vector<uint64_t> gains(candidates.size(), numeric_limits<uint64_t>::max());
+            vector<bool> chosen(candidates.size(), false);
+            uint64_t cost = total_cost(row_size_, keys, targets);
+            while (keys.size() < max_key_count && cost > targets.size())
+            {
+                size_t best = 0;
+                uint64_t best_gain = 0;
+                while (true)
+                {
+                    size_t top = candidates.size();
+                    for (size_t i = 0; i < candidates.size(); i++)
+                    {
+                        if (!chosen[i] && (top == candidates.size() || gains[i] > gains[top]))
+                        {
+                            top = i;
+                        }
+                    }
+                    if (top == candidates.size() || !gains[top])
+                    {
+                        break;
+                    }
+
+                    keys.push_back(candidates[top]);
+                    uint64_t new_cost = total_cost(row_size_, keys, targets);
+                    keys.pop_back();
+                    gains[top] = cost - min(cost, new_cost);
+
+                    bool is_best = true;
+                    for (size_t i = 0; i < candidates.size(); i++)
+                    {
+                        is_best = is_best && (chosen[i] || i == top || gains[i] <= gains[top]);
+                    }
+                    if (is_best)
+                    {
+                        best = top;
+                        best_gain = gains[top];
+                        break;
+                    }
+                }
+                if (!best_gain)
+                {
+                    break;
+                }
+                chosen[best] = true;
+                keys.push_back(candidates[best]);
+                cost -= best_gain;
+            }
+        }
+
+        // Keys are stored as signed steps of least absolute value
+        auto galois_tool = key_context_data.galois_tool();
+        for (auto key : keys)
+        {
+            int key_step = (key > (row_size_ >> 1)) ? -safe_cast<int>(row_size_ - key) : safe_cast<int>(key);
+            key_steps_.push_back(key_step);
+            galois_elts_.push_back(galois_tool->get_elt_from_step(key_step));
+        }
+
+        // Record a shortest decomposition of every step
+        vector<uint32_t> dist;
+        vector<size_t> last;
+        shortest_paths(row_size_, keys, dist, &last);
+        for (auto target : targets)
+        {
+            if (dist[target] == unreachable)
+            {
+                throw invalid_argument("key_budget_bytes is too small");
+            }
+            vector<int> decomposition;
+            for (size_t x = target; x; x = (x + row_size_ - keys[last[x]]) % row_size_)
+            {
+                decomposition.push_back(key_steps_[last[x]]);
+            }
+            max_key_switch_count_ = max(max_key_switch_count_, decomposition.size());
+            decompositions_.emplace(target, move(decomposition));
+        }
+    }
+
+    size_t RotationPlan::galois_key_byte_count(const SEALContext &context)
+    {
+        if (!context.using_keyswitching())
+        {
+            throw invalid_argument("encryption parameters do not support keyswitching");
+        }
+
+        // One key component per decomposition digit, each holding two polynomials over the key modulus
+        auto &first_context_data = *context.first_context_data();
+        auto &key_parms = context.key_context_data()->parms();
+        size_t component_count = first_context_data.kswitch_tool() ? first_context_data.kswitch_tool()->digit_count()
+                                                                    : first_context_data.parms().coeff_modulus().size();
+        return mul_safe(
+            component_count, size_t(2), key_parms.poly_modulus_degree(), key_parms.coeff_modulus().size(),
+            sizeof(uint64_t));
+    }
+
+    bool RotationPlan::contains(int steps) const
+    {
+        size_t target = reduce_step(steps);
+        return !target || decompositions_.find(target) != decompositions_.end();
+    }
+
+    const vector<int> &RotationPlan::decomposition(int steps) const
+    {
+        size_t target = reduce_step(steps);
+        if (!target)
+        {
+            return empty_decomposition_;
+        }
+        auto it = decompositions_.find(target);
+        if (it == decompositions_.end())
+        {
+            throw invalid_argument("steps is not in the rotation plan");
+        }
+        return it->second;
+    }
+
+    size_t RotationPlan::reduce_step(int steps) const
+    {
+        size_t abs_steps = static_cast<size_t>(abs(static_cast<long long>(steps)));
+        if (abs_steps >= row_size_)
+        {
+            throw invalid_argument("step count too large");
+        }
+        return (steps < 0) ? (row_size_ - abs_steps) % row_size_ : abs_steps;
+    }
+} // namespace seal
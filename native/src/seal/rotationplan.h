@@ -0,0 +1,141 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "seal/context.h"
+#include "seal/encryptionparams.h"
+#include "seal/util/defines.h"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace seal
+{
+    /**
+    Selects a set of Galois keys for a given set of rotation steps under a memory
+    budget, and records how each of the steps is composed from the selected keys.
+
+    Without a key for a particular step, Evaluator::rotate_rows and Evaluator::rotate_vector
+    decompose the step into its non-adjacent form and rotate by each term separately, which
+    with the default power-of-two keys can take up to log(N)/2 key switches per rotation.
+    A RotationPlan instead chooses the keys for the steps an application actually needs: if
+    the budget allows a key for every step, each rotation is a single key switch; otherwise
+    keys are selected greedily to minimize the total number of key switches over all steps,
+    with each step composed from the selected keys along a shortest path. The rotations in
+    the plan are then performed by passing it to Evaluator::rotate_rows or
+    Evaluator::rotate_vector.
+
+    Rotations act on rows of N/2 slots, where N is the degree of the polynomial modulus, so
+    steps are considered modulo N/2; in particular steps s and s - N/2 are equivalent.
+
+    @par Thread Safety
+    RotationPlan is immutable after construction and can be read from several threads
+    concurrently.
+
+    @see KeyGenerator::create_galois_keys for generating the Galois keys the plan uses.
+    */
+    class RotationPlan
+    {
+    public:
+        /**
+        Creates a RotationPlan for the given rotation steps such that the Galois keys it
+        uses take at most the given number of bytes.
+
+        @param[in] context The SEALContext
+        @param[in] steps The rotation steps the application needs (positive left, negative right)
+        @param[in] key_budget_bytes The maximum total size of the Galois keys in bytes
+        @throws std::invalid_argument if the encryption parameters are not valid for batching
+        @throws std::invalid_argument if the encryption parameters do not support keyswitching
+        @throws std::invalid_argument if some step has absolute value at least N/2
+        @throws std::invalid_argument if key_budget_bytes is too small to reach all steps
+        */
+        RotationPlan(const SEALContext &context, const std::vector<int> &steps, std::size_t key_budget_bytes);
+
+        /**
+        Returns the size in bytes of a single Galois key for the given context.
+
+        @param[in] context The SEALContext
+        @throws std::invalid_argument if the encryption parameters do not support keyswitching
+        */
+        SEAL_NODISCARD static std::size_t galois_key_byte_count(const SEALContext &context);
+
+        /**
+        Returns the Galois elements for which keys should be generated with
+        KeyGenerator::create_galois_keys.
+        */
+        SEAL_NODISCARD inline const std::vector<std::uint32_t> &galois_elts() const noexcept
+        {
+            return galois_elts_;
+        }
+
+        /**
+        Returns the rotation steps corresponding to galois_elts().
+        */
+        SEAL_NODISCARD inline const std::vector<int> &key_steps() const noexcept
+        {
+            return key_steps_;
+        }
+
+        /**
+        Returns whether the plan covers the given rotation step.
+
+        @param[in] steps The rotation step
+        */
+        SEAL_NODISCARD bool contains(int steps) const;
+
+        /**
+        Returns the key steps whose rotations compose the given rotation step. The
+        result is empty when steps is 0 modulo N/2.
+
+        @param[in] steps The rotation step
+        @throws std::invalid_argument if the plan does not cover steps
+        */
+        SEAL_NODISCARD const std::vector<int> &decomposition(int steps) const;
+
+        /**
+        Returns the number of key switches a rotation by the given step takes.
+
+        @param[in] steps The rotation step
+        @throws std::invalid_argument if the plan does not cover steps
+        */
+        SEAL_NODISCARD inline std::size_t key_switch_count(int steps) const
+        {
+            return decomposition(steps).size();
+        }
+
+        /**
+        Returns the largest number of key switches any rotation in the plan takes.
+        */
+        SEAL_NODISCARD inline std::size_t max_key_switch_count() const noexcept
+        {
+            return max_key_switch_count_;
+        }
+
+        /**
+        Returns the parms_id of the key level the plan was created for.
+        */
+        SEAL_NODISCARD inline const parms_id_type &key_parms_id() const noexcept
+        {
+            return key_parms_id_;
+        }
+
+    private:
+        SEAL_NODISCARD std::size_t reduce_step(int steps) const;
+
+        parms_id_type key_parms_id_ = parms_id_zero;
+
+        std::size_t row_size_ = 0;
+
+        std::vector<int> key_steps_{};
+
+        std::vector<std::uint32_t> galois_elts_{};
+
+        std::unordered_map<std::size_t, std::vector<int>> decompositions_{};
+
+        std::vector<int> empty_decomposition_{};
+
+        std::size_t max_key_switch_count_ = 0;
+    };
+} // namespace seal
@@ -12,8 +12,10 @@
 #include "seal/encryptionparams.h"
 #include "seal/encryptor.h"
 #include "seal/evaluator.h"
+#include "seal/extendedciphertext.h"
 #include "seal/galoiskeys.h"
 #include "seal/keygenerator.h"
+#include "seal/lineartransform.h"
 #include "seal/memorymanager.h"
 #include "seal/modulus.h"
 #include "seal/plaintext.h"
@@ -21,6 +23,7 @@
 #include "seal/randomgen.h"
 #include "seal/randomtostd.h"
 #include "seal/relinkeys.h"
+#include "seal/rotationplan.h"
 #include "seal/secretkey.h"
 #include "seal/serializable.h"
 #include "seal/serialization.h"
@@ -0,0 +1,104 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+// Lane-wise 64-bit integer arithmetic shared by the translation units that are compiled with AVX2 or AVX-512 enabled
+// (see nttavx.h and polyarithavx.h). Only those translation units may include this header; the AVX-512 functions are
+// available only where AVX-512 is enabled. The functions have internal linkage so that a copy compiled for one
+// instruction set can never be linked into code compiled for another.
+#include <cstdint>
+#include <immintrin.h>
+
+namespace seal
+{
+    namespace util
+    {
+        namespace
+        {
+            // Moduli below this bound are narrow: values less than 4 * modulus fit in 32 bits, so products of such
+            // values with each other or with 32-bit constants take a single 32x32-bit lane multiplication
+            constexpr std::uint64_t narrow_modulus_bound = std::uint64_t(1) << 30;
+
+#ifdef __AVX2__
+            // Lane-wise 128-bit products of a and b, computed from four 32x32-bit partial products
+            inline void mul_epu64(__m256i a, __m256i b, __m256i &hi, __m256i &lo)
+            {
+                __m256i a_hi = _mm256_srli_epi64(a, 32);
+                __m256i b_hi = _mm256_srli_epi64(b, 32);
+                __m256i lo_lo = _mm256_mul_epu32(a, b);
+                __m256i lo_hi = _mm256_mul_epu32(a, b_hi);
+                __m256i hi_lo = _mm256_mul_epu32(a_hi, b);
+                __m256i hi_hi = _mm256_mul_epu32(a_hi, b_hi);
+
+                // Sum of the middle 32-bit columns; the carry out of it goes to the high word
+                __m256i mask = _mm256_set1_epi64x(0xFFFFFFFF);
+                __m256i mid = _mm256_add_epi64(_mm256_srli_epi64(lo_lo, 32), _mm256_and_si256(lo_hi, mask));
+                mid = _mm256_add_epi64(mid, _mm256_and_si256(hi_lo, mask));
+                hi = _mm256_add_epi64(hi_hi, _mm256_srli_epi64(lo_hi, 32));
+                hi = _mm256_add_epi64(hi, _mm256_srli_epi64(hi_lo, 32));
+                hi = _mm256_add_epi64(hi, _mm256_srli_epi64(mid, 32));
+                lo = _mm256_add_epi64(lo_lo, _mm256_slli_epi64(_mm256_add_epi64(lo_hi, hi_lo), 32));
+            }
+
+            // High 64 bits of the lane-wise products
+            inline __m256i mulhi_epu64(__m256i a, __m256i b)
+            {
+                __m256i hi, lo;
+                mul_epu64(a, b, hi, lo);
+                return hi;
+            }
+
+            // Low 64 bits of the lane-wise products
+            inline __m256i mullo_epu64(__m256i a, __m256i b)
+            {
+                __m256i cross = _mm256_add_epi64(
+                    _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)), _mm256_mul_epu32(_mm256_srli_epi64(a, 32), b));
+                return _mm256_add_epi64(_mm256_mul_epu32(a, b), _mm256_slli_epi64(cross, 32));
+            }
+
+            // Subtracts bound from the lanes that are at least bound; all values are less than 2^63
+            inline __m256i guard(__m256i a, __m256i bound)
+            {
+                __m256i below = _mm256_cmpgt_epi64(bound, a);
+                return _mm256_sub_epi64(a, _mm256_andnot_si256(below, bound));
+            }
+#endif
+#ifdef __AVX512F__
+            // Lane-wise 128-bit products of a and b, computed from four 32x32-bit partial products
+            inline void mul_epu64(__m512i a, __m512i b, __m512i &hi, __m512i &lo)
+            {
+                __m512i a_hi = _mm512_srli_epi64(a, 32);
+                __m512i b_hi = _mm512_srli_epi64(b, 32);
+                __m512i lo_lo = _mm512_mul_epu32(a, b);
+                __m512i lo_hi = _mm512_mul_epu32(a, b_hi);
+                __m512i hi_lo = _mm512_mul_epu32(a_hi, b);
+                __m512i hi_hi = _mm512_mul_epu32(a_hi, b_hi);
+
+                // Sum of the middle 32-bit columns; the carry out of it goes to the high word
+                __m512i mask = _mm512_set1_epi64(0xFFFFFFFF);
+                __m512i mid = _mm512_add_epi64(_mm512_srli_epi64(lo_lo, 32), _mm512_and_si512(lo_hi, mask));
+                mid = _mm512_add_epi64(mid, _mm512_and_si512(hi_lo, mask));
+                hi = _mm512_add_epi64(hi_hi, _mm512_srli_epi64(lo_hi, 32));
+                hi = _mm512_add_epi64(hi, _mm512_srli_epi64(hi_lo, 32));
+                hi = _mm512_add_epi64(hi, _mm512_srli_epi64(mid, 32));
+                lo = _mm512_add_epi64(lo_lo, _mm512_slli_epi64(_mm512_add_epi64(lo_hi, hi_lo), 32));
+            }
+
+            // High 64 bits of the lane-wise products
+            inline __m512i mulhi_epu64(__m512i a, __m512i b)
+            {
+                __m512i hi, lo;
+                mul_epu64(a, b, hi, lo);
+                return hi;
+            }
+
+            // Subtracts bound from the lanes that are at least bound
+            inline __m512i guard(__m512i a, __m512i bound)
+            {
+                return _mm512_min_epu64(a, _mm512_sub_epi64(a, bound));
+            }
+#endif
+        } // namespace
+    } // namespace util
+} // namespace seal
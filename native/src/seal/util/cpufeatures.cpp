@@ -0,0 +1,94 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/util/cpufeatures.h"
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define SEAL_X86
+#if SEAL_COMPILER == SEAL_COMPILER_MSVC
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+using namespace std;
+
+namespace seal
+{
+    namespace util
+    {
+        namespace
+        {
+#ifdef SEAL_X86
+            // Executes CPUID for the given leaf and subleaf and writes eax, ebx, ecx, edx to regs
+            void cpuid(uint32_t leaf, uint32_t subleaf, uint32_t regs[4])
+            {
+#if SEAL_COMPILER == SEAL_COMPILER_MSVC
+                int info[4];
+                __cpuidex(info, static_cast<int>(leaf), static_cast<int>(subleaf));
+                for (int i = 0; i < 4; i++)
+                {
+                    regs[i] = static_cast<uint32_t>(info[i]);
+                }
+#else
+                __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+            }
+
+            // Returns the low word of the XCR0 register, which tells which register states the OS saves
+            uint32_t xgetbv0()
+            {
+#if SEAL_COMPILER == SEAL_COMPILER_MSVC
+                return static_cast<uint32_t>(_xgetbv(0));
+#else
+                uint32_t eax, edx;
+                __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+                return eax;
+#endif
+            }
+#endif
+            CPUFeatures detect_cpu_features() noexcept
+            {
+                CPUFeatures features;
+#ifdef SEAL_X86
+                uint32_t regs[4];
+                cpuid(0, 0, regs);
+                uint32_t max_leaf = regs[0];
+                if (max_leaf < 7)
+                {
+                    return features;
+                }
+
+                // AVX requires the OS to use XSAVE; XCR0 then tells whether the YMM and ZMM states are saved
+                cpuid(1, 0, regs);
+                bool osxsave = (regs[2] >> 27) & 1;
+                bool avx = (regs[2] >> 28) & 1;
+                if (!osxsave || !avx)
+                {
+                    return features;
+                }
+                bool fma = (regs[2] >> 12) & 1;
+                uint32_t xcr0 = xgetbv0();
+                bool ymm_saved = (xcr0 & 0x6) == 0x6;
+                bool zmm_saved = (xcr0 & 0xE6) == 0xE6;
+                features.fma = ymm_saved && fma;
+
+                cpuid(7, 0, regs);
+                features.avx2 = ymm_saved && ((regs[1] >> 5) & 1);
+                features.avx512f = zmm_saved && ((regs[1] >> 16) & 1);
+                features.avx512dq = features.avx512f && ((regs[1] >> 17) & 1);
+                features.avx512ifma = features.avx512f && ((regs[1] >> 21) & 1);
+#endif
+                return features;
+            }
+        } // namespace
+
+        const CPUFeatures &cpu_features() noexcept
+        {
+            static const CPUFeatures features = detect_cpu_features();
+            return features;
+        }
+    } // namespace util
+} // namespace seal
@@ -0,0 +1,35 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "seal/util/defines.h"
+
+namespace seal
+{
+    namespace util
+    {
+        /**
+        Instruction set extensions of the CPU the library runs on that vectorized code paths are dispatched on. An
+        extension is only reported as available if the operating system also saves the corresponding registers on
+        context switches. All flags are false on processors other than x86 and x86-64.
+        */
+        struct CPUFeatures
+        {
+            bool fma = false;
+
+            bool avx2 = false;
+
+            bool avx512f = false;
+
+            bool avx512dq = false;
+
+            bool avx512ifma = false;
+        };
+
+        /**
+        Returns the features of the CPU, which are detected once on the first call.
+        */
+        SEAL_NODISCARD const CPUFeatures &cpu_features() noexcept;
+    } // namespace util
+} // namespace seal
@@ -59,6 +59,12 @@ static_assert(sizeof(unsigned long long) == 8, "Require sizeof(unsigned long lon
 #endif
 #define SEAL_CIPHERTEXT_SIZE_MIN 2
 
+// NTTs of more coefficients are computed in blocks of 2^SEAL_NTT_BLOCK_COEFF_COUNT_POWER coefficients that fit in cache
+#define SEAL_NTT_BLOCK_COEFF_COUNT_POWER 12
+
+// Fast base conversions are computed in blocks of 2^SEAL_BASE_CONVERT_BLOCK_COEFF_COUNT_POWER coefficients
+#define SEAL_BASE_CONVERT_BLOCK_COEFF_COUNT_POWER 8
+
 // How many pairs of modular integers can we multiply and accumulate in a 128-bit data type
 #if SEAL_MOD_BIT_COUNT_MAX > 32
 #define SEAL_MULTIPLY_ACCUMULATE_MOD_MAX (1 << (128 - (SEAL_MOD_BIT_COUNT_MAX << 1)))
@@ -164,6 +170,11 @@ namespace seal
 #define SEAL_ITERATE std::for_each_n
 #endif
 
+// Same as SEAL_ITERATE, but runs the iterations on the internal thread pool if SEAL_USE_THREAD_POOL is defined. If the
+// lambda function allocates from a MemoryPoolHandle, it must be passed as an additional first argument; with a memory
+// pool that is not thread-safe the iterations are run serially.
+#define SEAL_ITERATE_PARALLEL seal::util::parallel_for_each_n
+
 // Allocate "size" bytes in memory and returns a seal_byte pointer
 // If SEAL_USE_ALIGNED_ALLOC is defined, use _aligned_malloc and ::aligned_alloc (or std::malloc)
 // Use `new seal_byte[size]` as fallback
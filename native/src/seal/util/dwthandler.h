@@ -355,6 +355,235 @@ namespace seal
                 }
             }
 
+            /**
+            Performs the same transform as transform_to_rev with better locality for large sizes, with identical
+            output. The layers whose groups span more than 2^log_block values are merged pairwise into radix-4 passes
+            over all values. Each of the remaining layers acts independently on blocks of 2^log_block consecutive
+            values, so each block is then transformed completely while it stays in cache. If log_block equals log_n,
+            this is the same as transform_to_rev.
+
+            @param[values] inputs in normal order, outputs in bit-reversed order
+            @param[log_n] log 2 of the DWT size
+            @param[roots] powers of a root in bit-reversed order
+            @param[log_block] log 2 of the block size
+            @param[block_roots] for each block in turn, the powers of the root used by its layers, in the order
+            transform_to_rev of size 2^log_block uses them; the same as roots if log_block equals log_n
+            */
+            void transform_to_rev_blocked(
+                ValueType *values, int log_n, const RootType *roots, int log_block, const RootType *block_roots) const
+            {
+                std::size_t n = std::size_t(1) << log_n;
+                std::size_t block = std::size_t(1) << log_block;
+                std::size_t m = 1;
+                std::size_t gap = n >> 1;
+
+                // Pairs of layers with gaps at least the block size
+                for (; (gap >> 1) >= block; m <<= 2, gap >>= 2)
+                {
+                    std::size_t quarter = gap >> 1;
+                    for (std::size_t i = 0; i < m; i++)
+                    {
+                        RootType r = roots[m + i];
+                        RootType r0 = roots[(m + i) << 1];
+                        RootType r1 = roots[((m + i) << 1) + 1];
+                        ValueType *x0 = values + 2 * gap * i;
+                        ValueType *x1 = x0 + quarter;
+                        ValueType *x2 = x1 + quarter;
+                        ValueType *x3 = x2 + quarter;
+                        for (std::size_t j = 0; j < quarter; j++)
+                        {
+                            ValueType u = arithmetic_.guard(*x0);
+                            ValueType v = arithmetic_.mul_root(*x2, r);
+                            ValueType a0 = arithmetic_.add(u, v);
+                            ValueType a2 = arithmetic_.sub(u, v);
+                            u = arithmetic_.guard(*x1);
+                            v = arithmetic_.mul_root(*x3, r);
+                            ValueType a1 = arithmetic_.add(u, v);
+                            ValueType a3 = arithmetic_.sub(u, v);
+
+                            u = arithmetic_.guard(a0);
+                            v = arithmetic_.mul_root(a1, r0);
+                            *x0++ = arithmetic_.add(u, v);
+                            *x1++ = arithmetic_.sub(u, v);
+                            u = arithmetic_.guard(a2);
+                            v = arithmetic_.mul_root(a3, r1);
+                            *x2++ = arithmetic_.add(u, v);
+                            *x3++ = arithmetic_.sub(u, v);
+                        }
+                    }
+                }
+
+                // A single remaining layer with gap at least the block size
+                if (gap >= block)
+                {
+                    for (std::size_t i = 0; i < m; i++)
+                    {
+                        RootType r = roots[m + i];
+                        ValueType *x = values + 2 * gap * i;
+                        ValueType *y = x + gap;
+                        for (std::size_t j = 0; j < gap; j++)
+                        {
+                            ValueType u = arithmetic_.guard(*x);
+                            ValueType v = arithmetic_.mul_root(*y, r);
+                            *x++ = arithmetic_.add(u, v);
+                            *y++ = arithmetic_.sub(u, v);
+                        }
+                    }
+                }
+
+                for (std::size_t offset = 0; offset < n; offset += block)
+                {
+                    transform_to_rev(values + offset, log_block, block_roots + offset);
+                }
+            }
+
+            /**
+            Performs the same transform as transform_from_rev with better locality for large sizes, with identical
+            output. Each block of 2^log_block consecutive values is first transformed completely by the layers whose
+            groups span at most the block. The remaining layers are merged pairwise into radix-4 passes over all
+            values. If log_block equals log_n, this is the same as transform_from_rev.
+
+            @param[values] inputs in bit-reversed order, outputs in normal order
+            @param[log_n] log 2 of the DWT size
+            @param[roots] powers of a root in scrambled order
+            @param[log_block] log 2 of the block size
+            @param[block_roots] for each block in turn, the powers of the root used by its layers, in the order
+            transform_from_rev of size 2^log_block uses them; the same as roots if log_block equals log_n
+            @param[scalar] an optional scalar that is multiplied to all output values
+            */
+            void transform_from_rev_blocked(
+                ValueType *values, int log_n, const RootType *roots, int log_block, const RootType *block_roots,
+                const ScalarType *scalar = nullptr) const
+            {
+                if (log_block == log_n)
+                {
+                    transform_from_rev(values, log_n, block_roots, scalar);
+                    return;
+                }
+
+                std::size_t n = std::size_t(1) << log_n;
+                std::size_t block = std::size_t(1) << log_block;
+                for (std::size_t offset = 0; offset < n; offset += block)
+                {
+                    transform_from_rev(values + offset, log_block, block_roots + offset);
+                }
+
+                // The layer with m groups uses the powers starting from index n - 2m + 1
+                std::size_t m = n >> (log_block + 1);
+                std::size_t gap = block;
+                int layer_count = log_n - log_block;
+
+                // With an odd number of layers, a single layer comes first so that the last pass is radix-4
+                if ((layer_count & 1) && layer_count > 1)
+                {
+                    const RootType *layer_roots = roots + (n - 2 * m + 1);
+                    for (std::size_t i = 0; i < m; i++)
+                    {
+                        RootType r = layer_roots[i];
+                        ValueType *x = values + 2 * gap * i;
+                        ValueType *y = x + gap;
+                        for (std::size_t j = 0; j < gap; j++)
+                        {
+                            ValueType u = *x;
+                            ValueType v = *y;
+                            *x++ = arithmetic_.guard(arithmetic_.add(u, v));
+                            *y++ = arithmetic_.mul_root(arithmetic_.sub(u, v), r);
+                        }
+                    }
+                    m >>= 1;
+                    gap <<= 1;
+                    layer_count--;
+                }
+
+                // Pairs of layers; the second layer of the last pair is the last layer and applies the scalar
+                for (; layer_count >= 2; m >>= 2, gap <<= 2, layer_count -= 2)
+                {
+                    const RootType *first_roots = roots + (n - 2 * m + 1);
+                    const RootType *second_roots = roots + (n - m + 1);
+                    bool last = (layer_count == 2);
+                    for (std::size_t i = 0; i < (m >> 1); i++)
+                    {
+                        RootType r0 = first_roots[i << 1];
+                        RootType r1 = first_roots[(i << 1) + 1];
+                        RootType r = second_roots[i];
+                        ValueType *x0 = values + 4 * gap * i;
+                        ValueType *x1 = x0 + gap;
+                        ValueType *x2 = x1 + gap;
+                        ValueType *x3 = x2 + gap;
+                        if (last && scalar != nullptr)
+                        {
+                            RootType scaled_r = arithmetic_.mul_root_scalar(r, *scalar);
+                            for (std::size_t j = 0; j < gap; j++)
+                            {
+                                ValueType u = *x0;
+                                ValueType v = *x1;
+                                ValueType a0 = arithmetic_.guard(arithmetic_.add(u, v));
+                                ValueType a1 = arithmetic_.mul_root(arithmetic_.sub(u, v), r0);
+                                u = *x2;
+                                v = *x3;
+                                ValueType a2 = arithmetic_.guard(arithmetic_.add(u, v));
+                                ValueType a3 = arithmetic_.mul_root(arithmetic_.sub(u, v), r1);
+
+                                u = arithmetic_.guard(a0);
+                                *x0++ = arithmetic_.mul_scalar(arithmetic_.guard(arithmetic_.add(u, a2)), *scalar);
+                                *x2++ = arithmetic_.mul_root(arithmetic_.sub(u, a2), scaled_r);
+                                u = arithmetic_.guard(a1);
+                                *x1++ = arithmetic_.mul_scalar(arithmetic_.guard(arithmetic_.add(u, a3)), *scalar);
+                                *x3++ = arithmetic_.mul_root(arithmetic_.sub(u, a3), scaled_r);
+                            }
+                        }
+                        else
+                        {
+                            for (std::size_t j = 0; j < gap; j++)
+                            {
+                                ValueType u = *x0;
+                                ValueType v = *x1;
+                                ValueType a0 = arithmetic_.guard(arithmetic_.add(u, v));
+                                ValueType a1 = arithmetic_.mul_root(arithmetic_.sub(u, v), r0);
+                                u = *x2;
+                                v = *x3;
+                                ValueType a2 = arithmetic_.guard(arithmetic_.add(u, v));
+                                ValueType a3 = arithmetic_.mul_root(arithmetic_.sub(u, v), r1);
+
+                                *x0++ = arithmetic_.guard(arithmetic_.add(a0, a2));
+                                *x2++ = arithmetic_.mul_root(arithmetic_.sub(a0, a2), r);
+                                *x1++ = arithmetic_.guard(arithmetic_.add(a1, a3));
+                                *x3++ = arithmetic_.mul_root(arithmetic_.sub(a1, a3), r);
+                            }
+                        }
+                    }
+                }
+
+                // A single last layer
+                if (layer_count == 1)
+                {
+                    RootType r = roots[n - 1];
+                    ValueType *x = values;
+                    ValueType *y = x + gap;
+                    if (scalar != nullptr)
+                    {
+                        RootType scaled_r = arithmetic_.mul_root_scalar(r, *scalar);
+                        for (std::size_t j = 0; j < gap; j++)
+                        {
+                            ValueType u = arithmetic_.guard(*x);
+                            ValueType v = *y;
+                            *x++ = arithmetic_.mul_scalar(arithmetic_.guard(arithmetic_.add(u, v)), *scalar);
+                            *y++ = arithmetic_.mul_root(arithmetic_.sub(u, v), scaled_r);
+                        }
+                    }
+                    else
+                    {
+                        for (std::size_t j = 0; j < gap; j++)
+                        {
+                            ValueType u = *x;
+                            ValueType v = *y;
+                            *x++ = arithmetic_.guard(arithmetic_.add(u, v));
+                            *y++ = arithmetic_.mul_root(arithmetic_.sub(u, v), r);
+                        }
+                    }
+                }
+            }
+
         private:
             Arithmetic<ValueType, RootType, ScalarType> arithmetic_;
         };
@@ -0,0 +1,242 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/util/common.h"
+#include "seal/util/cpufeatures.h"
+#include "seal/util/croots.h"
+#include "seal/util/fft.h"
+#include "seal/util/fftavx.h"
+#include "seal/util/uintcore.h"
+#include <atomic>
+#include <complex>
+#include <stdexcept>
+
+using namespace std;
+
+namespace seal
+{
+    namespace util
+    {
+        namespace
+        {
+            fft_kernel_type fastest_fft_kernel() noexcept
+            {
+                for (auto kernel : { fft_kernel_type::avx512, fft_kernel_type::avx2 })
+                {
+                    if (fft_kernel_supported(kernel))
+                    {
+                        return kernel;
+                    }
+                }
+                return fft_kernel_type::scalar;
+            }
+
+            atomic<fft_kernel_type> &fft_kernel() noexcept
+            {
+                static atomic<fft_kernel_type> kernel(fastest_fft_kernel());
+                return kernel;
+            }
+
+            // The vectorized kernels require at least 16 values
+            constexpr int fft_kernel_log_n_min = 4;
+
+            // Cooley-Tukey butterfly of transform_to_rev: (x, y) = (x + y * w, x - y * w)
+            inline void forward_butterfly(
+                double &x_re, double &x_im, double &y_re, double &y_im, double w_re, double w_im)
+            {
+                double v_re = y_re * w_re - y_im * w_im;
+                double v_im = y_re * w_im + y_im * w_re;
+                y_re = x_re - v_re;
+                y_im = x_im - v_im;
+                x_re += v_re;
+                x_im += v_im;
+            }
+
+            // Gentleman-Sande butterfly of transform_from_rev: (x, y) = (x + y, (x - y) * w)
+            inline void inverse_butterfly(
+                double &x_re, double &x_im, double &y_re, double &y_im, double w_re, double w_im)
+            {
+                double d_re = x_re - y_re;
+                double d_im = x_im - y_im;
+                x_re += y_re;
+                x_im += y_im;
+                y_re = d_re * w_re - d_im * w_im;
+                y_im = d_re * w_im + d_im * w_re;
+            }
+        } // namespace
+
+        bool fft_kernel_supported(fft_kernel_type kernel) noexcept
+        {
+            switch (kernel)
+            {
+            case fft_kernel_type::scalar:
+                return true;
+#ifdef SEAL_USE_AVX2_NTT
+            case fft_kernel_type::avx2:
+                return cpu_features().avx2 && cpu_features().fma;
+#endif
+#ifdef SEAL_USE_AVX512_NTT
+            case fft_kernel_type::avx512:
+                return cpu_features().avx512f;
+#endif
+            default:
+                return false;
+            }
+        }
+
+        fft_kernel_type get_fft_kernel() noexcept
+        {
+            return fft_kernel().load(memory_order_relaxed);
+        }
+
+        void set_fft_kernel(fft_kernel_type kernel)
+        {
+            if (!fft_kernel_supported(kernel))
+            {
+                throw invalid_argument("kernel is not supported");
+            }
+            fft_kernel().store(kernel, memory_order_relaxed);
+        }
+
+        SpecialFFT::SpecialFFT(int log_n, MemoryPoolHandle pool) : log_n_(log_n), pool_(move(pool))
+        {
+            if (log_n_ < 1 || log_n_ > get_power_of_two(SEAL_POLY_MOD_DEGREE_MAX))
+            {
+                throw invalid_argument("log_n is out of range");
+            }
+            if (!pool_)
+            {
+                throw invalid_argument("pool is uninitialized");
+            }
+
+            size_t n = size_t(1) << log_n_;
+            root_real_ = allocate<double>(n, pool_, 0);
+            root_imag_ = allocate<double>(n, pool_, 0);
+            inv_root_real_ = allocate<double>(n, pool_, 0);
+            inv_root_imag_ = allocate<double>(n, pool_, 0);
+
+            // Powers of the primitive 2n-th root have 4-fold symmetry
+            if (n >= 4)
+            {
+                ComplexRoots complex_roots(n << 1, pool_);
+                for (size_t i = 1; i < n; i++)
+                {
+                    complex<double> root = complex_roots.get_root(reverse_bits(i, log_n_));
+                    complex<double> inv_root = conj(complex_roots.get_root(reverse_bits(i - 1, log_n_) + 1));
+                    root_real_[i] = root.real();
+                    root_imag_[i] = root.imag();
+                    inv_root_real_[i] = inv_root.real();
+                    inv_root_imag_[i] = inv_root.imag();
+                }
+            }
+            else
+            {
+                root_imag_[1] = 1;
+                inv_root_imag_[1] = -1;
+            }
+        }
+
+        void SpecialFFT::transform_to_rev(double *real, double *imag) const
+        {
+            if (log_n_ >= fft_kernel_log_n_min)
+            {
+                switch (fft_kernel().load(memory_order_relaxed))
+                {
+#ifdef SEAL_USE_AVX512_NTT
+                case fft_kernel_type::avx512:
+                    special_fft_to_rev_avx512(real, imag, log_n_, root_real_.get(), root_imag_.get());
+                    return;
+#endif
+#ifdef SEAL_USE_AVX2_NTT
+                case fft_kernel_type::avx2:
+                    special_fft_to_rev_avx2(real, imag, log_n_, root_real_.get(), root_imag_.get());
+                    return;
+#endif
+                default:
+                    break;
+                }
+            }
+
+            // The layer with m groups uses the powers starting from index m
+            size_t n = size_t(1) << log_n_;
+            size_t gap = n >> 1;
+            for (size_t m = 1; m < n; m <<= 1, gap >>= 1)
+            {
+                for (size_t i = 0; i < m; i++)
+                {
+                    double w_re = root_real_[m + i];
+                    double w_im = root_imag_[m + i];
+                    double *x_re = real + 2 * gap * i;
+                    double *x_im = imag + 2 * gap * i;
+                    double *y_re = x_re + gap;
+                    double *y_im = x_im + gap;
+                    for (size_t j = 0; j < gap; j++)
+                    {
+                        forward_butterfly(x_re[j], x_im[j], y_re[j], y_im[j], w_re, w_im);
+                    }
+                }
+            }
+        }
+
+        void SpecialFFT::transform_from_rev(double *real, double *imag, const double *scalar) const
+        {
+            if (log_n_ >= fft_kernel_log_n_min)
+            {
+                switch (fft_kernel().load(memory_order_relaxed))
+                {
+#ifdef SEAL_USE_AVX512_NTT
+                case fft_kernel_type::avx512:
+                    special_fft_from_rev_avx512(
+                        real, imag, log_n_, inv_root_real_.get(), inv_root_imag_.get(), scalar);
+                    return;
+#endif
+#ifdef SEAL_USE_AVX2_NTT
+                case fft_kernel_type::avx2:
+                    special_fft_from_rev_avx2(real, imag, log_n_, inv_root_real_.get(), inv_root_imag_.get(), scalar);
+                    return;
+#endif
+                default:
+                    break;
+                }
+            }
+
+            // The layers consume the powers one after another, starting from index 1
+            size_t n = size_t(1) << log_n_;
+            const double *root_real = inv_root_real_.get() + 1;
+            const double *root_imag = inv_root_imag_.get() + 1;
+            size_t gap = 1;
+            for (size_t m = n >> 1; m > 1; m >>= 1, gap <<= 1)
+            {
+                for (size_t i = 0; i < m; i++)
+                {
+                    double w_re = *root_real++;
+                    double w_im = *root_imag++;
+                    double *x_re = real + 2 * gap * i;
+                    double *x_im = imag + 2 * gap * i;
+                    double *y_re = x_re + gap;
+                    double *y_im = x_im + gap;
+                    for (size_t j = 0; j < gap; j++)
+                    {
+                        inverse_butterfly(x_re[j], x_im[j], y_re[j], y_im[j], w_re, w_im);
+                    }
+                }
+            }
+
+            // The last layer also multiplies by the scalar, which is merged into its root
+            double s = scalar ? *scalar : 1.0;
+            double w_re = *root_real * s;
+            double w_im = *root_imag * s;
+            double *y_re = real + gap;
+            double *y_im = imag + gap;
+            for (size_t j = 0; j < gap; j++)
+            {
+                inverse_butterfly(real[j], imag[j], y_re[j], y_im[j], w_re, w_im);
+                if (scalar)
+                {
+                    real[j] *= s;
+                    imag[j] *= s;
+                }
+            }
+        }
+    } // namespace util
+} // namespace seal
@@ -0,0 +1,111 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "seal/memorymanager.h"
+#include "seal/util/defines.h"
+#include "seal/util/pointer.h"
+#include <cstdint>
+
+namespace seal
+{
+    namespace util
+    {
+        /**
+        Identifies an implementation of the special FFT of SpecialFFT. All implementations compute the same transforms
+        up to floating-point rounding; the vectorized ones are used for transforms of at least 16 values.
+        */
+        enum class fft_kernel_type : std::uint8_t
+        {
+            // Portable scalar butterflies
+            scalar = 0x0,
+
+            // AVX2 radix-4 butterflies with FMA
+            avx2 = 0x1,
+
+            // AVX-512F radix-4 butterflies
+            avx512 = 0x2
+        };
+
+        /**
+        Returns whether the given FFT kernel is built into the library and supported by the CPU.
+
+        @param[in] kernel The FFT kernel
+        */
+        SEAL_NODISCARD bool fft_kernel_supported(fft_kernel_type kernel) noexcept;
+
+        /**
+        Returns the FFT kernel in use. Unless set_fft_kernel is called, this is the fastest kernel supported by the
+        CPU, which is determined once on first use.
+        */
+        SEAL_NODISCARD fft_kernel_type get_fft_kernel() noexcept;
+
+        /**
+        Selects the FFT kernel used by all subsequent transforms, e.g., for testing or benchmarking a particular
+        implementation. This must not be called while transforms run on other threads.
+
+        @param[in] kernel The FFT kernel
+        @throws std::invalid_argument if kernel is not supported
+        */
+        void set_fft_kernel(fft_kernel_type kernel);
+
+        /**
+        Computes the DWT over the complex field that CKKSEncoder uses to map between slots and coefficients, with the
+        same results as DWTHandler<std::complex<double>, std::complex<double>, double> up to floating-point rounding.
+        The values are stored as separate arrays of real and imaginary parts, and so are the powers of the primitive
+        2n-th root of unity. The powers are kept in the order in which the layers of the transforms consume them, so
+        every layer reads its roots from a contiguous range. The vectorized kernels merge pairs of layers into radix-4
+        passes, which halves the loads and stores of values.
+        */
+        class SpecialFFT
+        {
+        public:
+            /**
+            Creates the roots for transforms of 2^log_n values.
+
+            @param[in] log_n log 2 of the transform size, which is at least 1
+            @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+            @throws std::invalid_argument if log_n is less than 1 or pool is uninitialized
+            */
+            SpecialFFT(int log_n, MemoryPoolHandle pool = MemoryManager::GetPool());
+
+            SpecialFFT(const SpecialFFT &copy) = delete;
+
+            SpecialFFT &operator=(const SpecialFFT &assign) = delete;
+
+            SEAL_NODISCARD inline int log_n() const noexcept
+            {
+                return log_n_;
+            }
+
+            /**
+            Same as DWTHandler::transform_to_rev with the powers of the root in bit-reversed order: real and imag hold
+            the parts of the 2^log_n input values in normal order, and of the output values in bit-reversed order.
+            */
+            void transform_to_rev(double *real, double *imag) const;
+
+            /**
+            Same as DWTHandler::transform_from_rev with the powers of the inverse root in scrambled order: real and
+            imag hold the parts of the 2^log_n input values in bit-reversed order, and of the output values in normal
+            order. If scalar is given, all output values are multiplied by it.
+            */
+            void transform_from_rev(double *real, double *imag, const double *scalar = nullptr) const;
+
+        private:
+            int log_n_;
+
+            MemoryPoolHandle pool_;
+
+            // Parts of the 1~(n-1)-th powers of the root in bit-reversed order; the 0-th power is left unset.
+            Pointer<double> root_real_;
+
+            Pointer<double> root_imag_;
+
+            // Parts of the 1~(n-1)-th powers of the inverse root in scrambled order; the 0-th power is left unset.
+            Pointer<double> inv_root_real_;
+
+            Pointer<double> inv_root_imag_;
+        };
+    } // namespace util
+} // namespace seal
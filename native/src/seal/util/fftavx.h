@@ -0,0 +1,40 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "seal/util/config.h"
+
+namespace seal
+{
+    namespace util
+    {
+        /*
+        Vectorized counterparts of the transforms of SpecialFFT. As for the NTT kernels in nttavx.h, each instruction
+        set lives in a translation unit of its own that includes no other headers of the library, and these functions
+        must only be called after checking that the CPU supports the instruction set (see fft_kernel_supported in
+        fft.h). They take plain arrays:
+
+        - real and imag hold the parts of 2^log_n values, where log_n is at least 4;
+        - root_real and root_imag, or inv_root_real and inv_root_imag, hold the parts of the powers of the root, or of
+          the inverse root, in the order of SpecialFFT, where the 0-th power is unused;
+        - scalar, if given, multiplies all output values of the inverse transform.
+        */
+#ifdef SEAL_USE_AVX2_NTT
+        void special_fft_to_rev_avx2(
+            double *real, double *imag, int log_n, const double *root_real, const double *root_imag);
+
+        void special_fft_from_rev_avx2(
+            double *real, double *imag, int log_n, const double *inv_root_real, const double *inv_root_imag,
+            const double *scalar);
+#endif
+#ifdef SEAL_USE_AVX512_NTT
+        void special_fft_to_rev_avx512(
+            double *real, double *imag, int log_n, const double *root_real, const double *root_imag);
+
+        void special_fft_from_rev_avx512(
+            double *real, double *imag, int log_n, const double *inv_root_real, const double *inv_root_imag,
+            const double *scalar);
+#endif
+    } // namespace util
+} // namespace seal
@@ -0,0 +1,318 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+// This file is compiled with AVX2 and FMA enabled; see fftavx.h for why it must not include other headers of the
+// library.
+#include "seal/util/fftavx.h"
+
+#ifdef SEAL_USE_AVX2_NTT
+#include <cstddef>
+#include <immintrin.h>
+
+using namespace std;
+
+namespace seal
+{
+    namespace util
+    {
+        namespace
+        {
+            // Four complex values as separate vectors of real and imaginary parts
+            struct Complex
+            {
+                __m256d re;
+                __m256d im;
+            };
+
+            inline Complex load(const double *real, const double *imag)
+            {
+                return { _mm256_loadu_pd(real), _mm256_loadu_pd(imag) };
+            }
+
+            inline void store(double *real, double *imag, Complex a)
+            {
+                _mm256_storeu_pd(real, a.re);
+                _mm256_storeu_pd(imag, a.im);
+            }
+
+            inline Complex broadcast(const double *real, const double *imag)
+            {
+                return { _mm256_broadcast_sd(real), _mm256_broadcast_sd(imag) };
+            }
+
+            inline Complex mul(Complex a, Complex w)
+            {
+                return { _mm256_fmsub_pd(a.re, w.re, _mm256_mul_pd(a.im, w.im)),
+                         _mm256_fmadd_pd(a.re, w.im, _mm256_mul_pd(a.im, w.re)) };
+            }
+
+            inline Complex mul_scalar(Complex a, __m256d s)
+            {
+                return { _mm256_mul_pd(a.re, s), _mm256_mul_pd(a.im, s) };
+            }
+
+            // Cooley-Tukey butterfly of transform_to_rev
+            inline void forward_butterfly(Complex &x, Complex &y, Complex w)
+            {
+                Complex v = mul(y, w);
+                y = { _mm256_sub_pd(x.re, v.re), _mm256_sub_pd(x.im, v.im) };
+                x = { _mm256_add_pd(x.re, v.re), _mm256_add_pd(x.im, v.im) };
+            }
+
+            // Gentleman-Sande butterfly of transform_from_rev
+            inline void inverse_butterfly(Complex &x, Complex &y, Complex w)
+            {
+                Complex d = { _mm256_sub_pd(x.re, y.re), _mm256_sub_pd(x.im, y.im) };
+                x = { _mm256_add_pd(x.re, y.re), _mm256_add_pd(x.im, y.im) };
+                y = mul(d, w);
+            }
+
+            template <bool Inverse>
+            inline void butterfly(Complex &x, Complex &y, Complex w)
+            {
+                if (Inverse)
+                {
+                    inverse_butterfly(x, y, w);
+                }
+                else
+                {
+                    forward_butterfly(x, y, w);
+                }
+            }
+
+            // A layer of m groups with gap at least 4; every group uses a single root
+            template <bool Inverse>
+            void radix2_layer(
+                double *real, double *imag, size_t m, size_t gap, const double *root_real, const double *root_imag)
+            {
+                for (size_t i = 0; i < m; i++)
+                {
+                    Complex w = broadcast(root_real + i, root_imag + i);
+                    double *x_re = real + 2 * gap * i;
+                    double *x_im = imag + 2 * gap * i;
+                    for (size_t j = 0; j < gap; j += 4)
+                    {
+                        Complex x = load(x_re + j, x_im + j);
+                        Complex y = load(x_re + gap + j, x_im + gap + j);
+                        butterfly<Inverse>(x, y, w);
+                        store(x_re + j, x_im + j, x);
+                        store(x_re + gap + j, x_im + gap + j, y);
+                    }
+                }
+            }
+
+            // Two forward layers in one pass: the layer of m groups with gap at least 8, then the layer of 2m groups
+            // with half the gap. The roots of the second layer follow those of the first.
+            void forward_radix4_layers(
+                double *real, double *imag, size_t m, size_t gap, const double *root_real, const double *root_imag)
+            {
+                size_t quarter = gap >> 1;
+                for (size_t i = 0; i < m; i++)
+                {
+                    Complex w = broadcast(root_real + i, root_imag + i);
+                    Complex w0 = broadcast(root_real + m + 2 * i, root_imag + m + 2 * i);
+                    Complex w1 = broadcast(root_real + m + 2 * i + 1, root_imag + m + 2 * i + 1);
+                    double *re = real + 2 * gap * i;
+                    double *im = imag + 2 * gap * i;
+                    for (size_t j = 0; j < quarter; j += 4)
+                    {
+                        Complex x0 = load(re + j, im + j);
+                        Complex x1 = load(re + quarter + j, im + quarter + j);
+                        Complex x2 = load(re + 2 * quarter + j, im + 2 * quarter + j);
+                        Complex x3 = load(re + 3 * quarter + j, im + 3 * quarter + j);
+                        forward_butterfly(x0, x2, w);
+                        forward_butterfly(x1, x3, w);
+                        forward_butterfly(x0, x1, w0);
+                        forward_butterfly(x2, x3, w1);
+                        store(re + j, im + j, x0);
+                        store(re + quarter + j, im + quarter + j, x1);
+                        store(re + 2 * quarter + j, im + 2 * quarter + j, x2);
+                        store(re + 3 * quarter + j, im + 3 * quarter + j, x3);
+                    }
+                }
+            }
+
+            // Two inverse layers in one pass: the layer of m groups with gap at least 4, then the layer of m/2 groups
+            // with twice the gap. The roots of the second layer follow those of the first. If Scaled, the output is
+            // multiplied by s, which is merged into the roots of the second layer.
+            template <bool Scaled>
+            void inverse_radix4_layers(
+                double *real, double *imag, size_t m, size_t gap, const double *root_real, const double *root_imag,
+                __m256d s)
+            {
+                for (size_t i = 0; i < (m >> 1); i++)
+                {
+                    Complex w0 = broadcast(root_real + 2 * i, root_imag + 2 * i);
+                    Complex w1 = broadcast(root_real + 2 * i + 1, root_imag + 2 * i + 1);
+                    Complex w = broadcast(root_real + m + i, root_imag + m + i);
+                    if (Scaled)
+                    {
+                        w = mul_scalar(w, s);
+                    }
+                    double *re = real + 4 * gap * i;
+                    double *im = imag + 4 * gap * i;
+                    for (size_t j = 0; j < gap; j += 4)
+                    {
+                        Complex x0 = load(re + j, im + j);
+                        Complex x1 = load(re + gap + j, im + gap + j);
+                        Complex x2 = load(re + 2 * gap + j, im + 2 * gap + j);
+                        Complex x3 = load(re + 3 * gap + j, im + 3 * gap + j);
+                        inverse_butterfly(x0, x1, w0);
+                        inverse_butterfly(x2, x3, w1);
+                        inverse_butterfly(x0, x2, w);
+                        inverse_butterfly(x1, x3, w);
+                        if (Scaled)
+                        {
+                            x0 = mul_scalar(x0, s);
+                            x1 = mul_scalar(x1, s);
+                        }
+                        store(re + j, im + j, x0);
+                        store(re + gap + j, im + gap + j, x1);
+                        store(re + 2 * gap + j, im + 2 * gap + j, x2);
+                        store(re + 3 * gap + j, im + 3 * gap + j, x3);
+                    }
+                }
+            }
+
+            // The last inverse layer, with a single group, multiplied by s
+            void scaled_last_layer(
+                double *real, double *imag, size_t gap, const double *root_real, const double *root_imag, __m256d s)
+            {
+                Complex w = mul_scalar(broadcast(root_real, root_imag), s);
+                for (size_t j = 0; j < gap; j += 4)
+                {
+                    Complex x = load(real + j, imag + j);
+                    Complex y = load(real + gap + j, imag + gap + j);
+                    inverse_butterfly(x, y, w);
+                    store(real + j, imag + j, mul_scalar(x, s));
+                    store(real + gap + j, imag + gap + j, y);
+                }
+            }
+
+            // A layer of m groups with gap 2: eight values hold two groups [x0 x1 y0 y1 | x0' x1' y0' y1']
+            template <bool Inverse>
+            void gap2_layer(double *real, double *imag, size_t m, const double *root_real, const double *root_imag)
+            {
+                for (size_t i = 0; i < m; i += 2, real += 8, imag += 8)
+                {
+                    Complex v0 = load(real, imag);
+                    Complex v1 = load(real + 4, imag + 4);
+                    Complex x = { _mm256_permute2f128_pd(v0.re, v1.re, 0x20),
+                                  _mm256_permute2f128_pd(v0.im, v1.im, 0x20) };
+                    Complex y = { _mm256_permute2f128_pd(v0.re, v1.re, 0x31),
+                                  _mm256_permute2f128_pd(v0.im, v1.im, 0x31) };
+
+                    // Roots of the two groups as [w w w' w']
+                    Complex w = { _mm256_permute4x64_pd(
+                                      _mm256_castpd128_pd256(_mm_loadu_pd(root_real + i)), _MM_SHUFFLE(1, 1, 0, 0)),
+                                  _mm256_permute4x64_pd(
+                                      _mm256_castpd128_pd256(_mm_loadu_pd(root_imag + i)), _MM_SHUFFLE(1, 1, 0, 0)) };
+
+                    butterfly<Inverse>(x, y, w);
+                    store(
+                        real, imag,
+                        { _mm256_permute2f128_pd(x.re, y.re, 0x20), _mm256_permute2f128_pd(x.im, y.im, 0x20) });
+                    store(
+                        real + 4, imag + 4,
+                        { _mm256_permute2f128_pd(x.re, y.re, 0x31), _mm256_permute2f128_pd(x.im, y.im, 0x31) });
+                }
+            }
+
+            // A layer of m groups with gap 1: eight values hold four groups, which the unpacking sees in the order
+            // 0, 2, 1, 3
+            template <bool Inverse>
+            void gap1_layer(double *real, double *imag, size_t m, const double *root_real, const double *root_imag)
+            {
+                for (size_t i = 0; i < m; i += 4, real += 8, imag += 8)
+                {
+                    Complex v0 = load(real, imag);
+                    Complex v1 = load(real + 4, imag + 4);
+                    Complex x = { _mm256_unpacklo_pd(v0.re, v1.re), _mm256_unpacklo_pd(v0.im, v1.im) };
+                    Complex y = { _mm256_unpackhi_pd(v0.re, v1.re), _mm256_unpackhi_pd(v0.im, v1.im) };
+
+                    Complex w = { _mm256_permute4x64_pd(_mm256_loadu_pd(root_real + i), _MM_SHUFFLE(3, 1, 2, 0)),
+                                  _mm256_permute4x64_pd(_mm256_loadu_pd(root_imag + i), _MM_SHUFFLE(3, 1, 2, 0)) };
+
+                    butterfly<Inverse>(x, y, w);
+                    store(real, imag, { _mm256_unpacklo_pd(x.re, y.re), _mm256_unpacklo_pd(x.im, y.im) });
+                    store(real + 4, imag + 4, { _mm256_unpackhi_pd(x.re, y.re), _mm256_unpackhi_pd(x.im, y.im) });
+                }
+            }
+        } // namespace
+
+        void special_fft_to_rev_avx2(
+            double *real, double *imag, int log_n, const double *root_real, const double *root_imag)
+        {
+            size_t n = size_t(1) << log_n;
+
+            // The layer with m groups uses the powers starting from index m
+            size_t m = 1;
+            size_t gap = n >> 1;
+            for (; gap >= 8; m <<= 2, gap >>= 2)
+            {
+                forward_radix4_layers(real, imag, m, gap, root_real + m, root_imag + m);
+            }
+            if (gap == 4)
+            {
+                radix2_layer<false>(real, imag, m, gap, root_real + m, root_imag + m);
+                m <<= 1;
+            }
+            gap2_layer<false>(real, imag, m, root_real + m, root_imag + m);
+            m <<= 1;
+            gap1_layer<false>(real, imag, m, root_real + m, root_imag + m);
+        }
+
+        void special_fft_from_rev_avx2(
+            double *real, double *imag, int log_n, const double *inv_root_real, const double *inv_root_imag,
+            const double *scalar)
+        {
+            size_t n = size_t(1) << log_n;
+
+            // The layers consume the powers one after another, starting from index 1
+            const double *root_real = inv_root_real + 1;
+            const double *root_imag = inv_root_imag + 1;
+            size_t m = n >> 1;
+            gap1_layer<true>(real, imag, m, root_real, root_imag);
+            root_real += m;
+            root_imag += m;
+            m >>= 1;
+            gap2_layer<true>(real, imag, m, root_real, root_imag);
+            root_real += m;
+            root_imag += m;
+            m >>= 1;
+
+            // The remaining log_n - 2 layers are merged into radix-4 passes after at most one radix-2 layer; the last
+            // pass multiplies by the scalar
+            __m256d s = _mm256_set1_pd(scalar ? *scalar : 1.0);
+            size_t gap = 4;
+            if ((log_n - 2) & 1)
+            {
+                if (m == 1)
+                {
+                    scaled_last_layer(real, imag, gap, root_real, root_imag, s);
+                    return;
+                }
+                radix2_layer<true>(real, imag, m, gap, root_real, root_imag);
+                root_real += m;
+                root_imag += m;
+                m >>= 1;
+                gap <<= 1;
+            }
+            for (; m > 2; m >>= 2, gap <<= 2)
+            {
+                inverse_radix4_layers<false>(real, imag, m, gap, root_real, root_imag, s);
+                root_real += m + (m >> 1);
+                root_imag += m + (m >> 1);
+            }
+            if (scalar)
+            {
+                inverse_radix4_layers<true>(real, imag, m, gap, root_real, root_imag, s);
+            }
+            else
+            {
+                inverse_radix4_layers<false>(real, imag, m, gap, root_real, root_imag, s);
+            }
+        }
+    } // namespace util
+} // namespace seal
+#endif
@@ -0,0 +1,398 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+// This file is compiled with AVX-512 enabled; see fftavx.h for why it must not include other headers of the library.
+#include "seal/util/fftavx.h"
+
+#ifdef SEAL_USE_AVX512_NTT
+#include <cstddef>
+#include <immintrin.h>
+
+using namespace std;
+
+namespace seal
+{
+    namespace util
+    {
+        namespace
+        {
+            // Eight complex values as separate vectors of real and imaginary parts
+            struct Complex
+            {
+                __m512d re;
+                __m512d im;
+            };
+
+            inline Complex load(const double *real, const double *imag)
+            {
+                return { _mm512_loadu_pd(real), _mm512_loadu_pd(imag) };
+            }
+
+            inline void store(double *real, double *imag, Complex a)
+            {
+                _mm512_storeu_pd(real, a.re);
+                _mm512_storeu_pd(imag, a.im);
+            }
+
+            inline Complex broadcast(const double *real, const double *imag)
+            {
+                return { _mm512_set1_pd(*real), _mm512_set1_pd(*imag) };
+            }
+
+            inline Complex mul(Complex a, Complex w)
+            {
+                return { _mm512_fmsub_pd(a.re, w.re, _mm512_mul_pd(a.im, w.im)),
+                         _mm512_fmadd_pd(a.re, w.im, _mm512_mul_pd(a.im, w.re)) };
+            }
+
+            inline Complex mul_scalar(Complex a, __m512d s)
+            {
+                return { _mm512_mul_pd(a.re, s), _mm512_mul_pd(a.im, s) };
+            }
+
+            // Cooley-Tukey butterfly of transform_to_rev
+            inline void forward_butterfly(Complex &x, Complex &y, Complex w)
+            {
+                Complex v = mul(y, w);
+                y = { _mm512_sub_pd(x.re, v.re), _mm512_sub_pd(x.im, v.im) };
+                x = { _mm512_add_pd(x.re, v.re), _mm512_add_pd(x.im, v.im) };
+            }
+
+            // Gentleman-Sande butterfly of transform_from_rev
+            inline void inverse_butterfly(Complex &x, Complex &y, Complex w)
+            {
+                Complex d = { _mm512_sub_pd(x.re, y.re), _mm512_sub_pd(x.im, y.im) };
+                x = { _mm512_add_pd(x.re, y.re), _mm512_add_pd(x.im, y.im) };
+                y = mul(d, w);
+            }
+
+            template <bool Inverse>
+            inline void butterfly(Complex &x, Complex &y, Complex w)
+            {
+                if (Inverse)
+                {
+                    inverse_butterfly(x, y, w);
+                }
+                else
+                {
+                    forward_butterfly(x, y, w);
+                }
+            }
+
+            // A layer of m groups with gap at least 8; every group uses a single root
+            template <bool Inverse>
+            void radix2_layer(
+                double *real, double *imag, size_t m, size_t gap, const double *root_real, const double *root_imag)
+            {
+                for (size_t i = 0; i < m; i++)
+                {
+                    Complex w = broadcast(root_real + i, root_imag + i);
+                    double *x_re = real + 2 * gap * i;
+                    double *x_im = imag + 2 * gap * i;
+                    for (size_t j = 0; j < gap; j += 8)
+                    {
+                        Complex x = load(x_re + j, x_im + j);
+                        Complex y = load(x_re + gap + j, x_im + gap + j);
+                        butterfly<Inverse>(x, y, w);
+                        store(x_re + j, x_im + j, x);
+                        store(x_re + gap + j, x_im + gap + j, y);
+                    }
+                }
+            }
+
+            // Same as in fftavx2.cpp, with gap at least 16
+            void forward_radix4_layers(
+                double *real, double *imag, size_t m, size_t gap, const double *root_real, const double *root_imag)
+            {
+                size_t quarter = gap >> 1;
+                for (size_t i = 0; i < m; i++)
+                {
+                    Complex w = broadcast(root_real + i, root_imag + i);
+                    Complex w0 = broadcast(root_real + m + 2 * i, root_imag + m + 2 * i);
+                    Complex w1 = broadcast(root_real + m + 2 * i + 1, root_imag + m + 2 * i + 1);
+                    double *re = real + 2 * gap * i;
+                    double *im = imag + 2 * gap * i;
+                    for (size_t j = 0; j < quarter; j += 8)
+                    {
+                        Complex x0 = load(re + j, im + j);
+                        Complex x1 = load(re + quarter + j, im + quarter + j);
+                        Complex x2 = load(re + 2 * quarter + j, im + 2 * quarter + j);
+                        Complex x3 = load(re + 3 * quarter + j, im + 3 * quarter + j);
+                        forward_butterfly(x0, x2, w);
+                        forward_butterfly(x1, x3, w);
+                        forward_butterfly(x0, x1, w0);
+                        forward_butterfly(x2, x3, w1);
+                        store(re + j, im + j, x0);
+                        store(re + quarter + j, im + quarter + j, x1);
+                        store(re + 2 * quarter + j, im + 2 * quarter + j, x2);
+                        store(re + 3 * quarter + j, im + 3 * quarter + j, x3);
+                    }
+                }
+            }
+
+            // Same as in fftavx2.cpp, with gap at least 8
+            template <bool Scaled>
+            void inverse_radix4_layers(
+                double *real, double *imag, size_t m, size_t gap, const double *root_real, const double *root_imag,
+                __m512d s)
+            {
+                for (size_t i = 0; i < (m >> 1); i++)
+                {
+                    Complex w0 = broadcast(root_real + 2 * i, root_imag + 2 * i);
+                    Complex w1 = broadcast(root_real + 2 * i + 1, root_imag + 2 * i + 1);
+                    Complex w = broadcast(root_real + m + i, root_imag + m + i);
+                    if (Scaled)
+                    {
+                        w = mul_scalar(w, s);
+                    }
+                    double *re = real + 4 * gap * i;
+                    double *im = imag + 4 * gap * i;
+                    for (size_t j = 0; j < gap; j += 8)
+                    {
+                        Complex x0 = load(re + j, im + j);
+                        Complex x1 = load(re + gap + j, im + gap + j);
+                        Complex x2 = load(re + 2 * gap + j, im + 2 * gap + j);
+                        Complex x3 = load(re + 3 * gap + j, im + 3 * gap + j);
+                        inverse_butterfly(x0, x1, w0);
+                        inverse_butterfly(x2, x3, w1);
+                        inverse_butterfly(x0, x2, w);
+                        inverse_butterfly(x1, x3, w);
+                        if (Scaled)
+                        {
+                            x0 = mul_scalar(x0, s);
+                            x1 = mul_scalar(x1, s);
+                        }
+                        store(re + j, im + j, x0);
+                        store(re + gap + j, im + gap + j, x1);
+                        store(re + 2 * gap + j, im + 2 * gap + j, x2);
+                        store(re + 3 * gap + j, im + 3 * gap + j, x3);
+                    }
+                }
+            }
+
+            // The last inverse layer, with a single group, multiplied by s
+            void scaled_last_layer(
+                double *real, double *imag, size_t gap, const double *root_real, const double *root_imag, __m512d s)
+            {
+                Complex w = mul_scalar(broadcast(root_real, root_imag), s);
+                for (size_t j = 0; j < gap; j += 8)
+                {
+                    Complex x = load(real + j, imag + j);
+                    Complex y = load(real + gap + j, imag + gap + j);
+                    inverse_butterfly(x, y, w);
+                    store(real + j, imag + j, mul_scalar(x, s));
+                    store(real + gap + j, imag + gap + j, y);
+                }
+            }
+
+            // Lane permutations of a layer with gap 4, 2, or 1, where sixteen values hold 8 / Gap groups: split
+            // gathers the x and y halves of the groups from two vectors, merge scatters them back, and root holds the
+            // group of each lane of x
+            template <size_t Gap>
+            struct SmallGapLanes;
+
+            template <>
+            struct SmallGapLanes<4>
+            {
+                static __m512i split_x()
+                {
+                    return _mm512_set_epi64(11, 10, 9, 8, 3, 2, 1, 0);
+                }
+                static __m512i split_y()
+                {
+                    return _mm512_set_epi64(15, 14, 13, 12, 7, 6, 5, 4);
+                }
+                static __m512i merge0()
+                {
+                    return split_x();
+                }
+                static __m512i merge1()
+                {
+                    return split_y();
+                }
+                static __m512i root()
+                {
+                    return _mm512_set_epi64(1, 1, 1, 1, 0, 0, 0, 0);
+                }
+            };
+
+            template <>
+            struct SmallGapLanes<2>
+            {
+                static __m512i split_x()
+                {
+                    return _mm512_set_epi64(13, 12, 9, 8, 5, 4, 1, 0);
+                }
+                static __m512i split_y()
+                {
+                    return _mm512_set_epi64(15, 14, 11, 10, 7, 6, 3, 2);
+                }
+                static __m512i merge0()
+                {
+                    return _mm512_set_epi64(11, 10, 3, 2, 9, 8, 1, 0);
+                }
+                static __m512i merge1()
+                {
+                    return _mm512_set_epi64(15, 14, 7, 6, 13, 12, 5, 4);
+                }
+                static __m512i root()
+                {
+                    return _mm512_set_epi64(3, 3, 2, 2, 1, 1, 0, 0);
+                }
+            };
+
+            template <>
+            struct SmallGapLanes<1>
+            {
+                static __m512i split_x()
+                {
+                    return _mm512_set_epi64(14, 12, 10, 8, 6, 4, 2, 0);
+                }
+                static __m512i split_y()
+                {
+                    return _mm512_set_epi64(15, 13, 11, 9, 7, 5, 3, 1);
+                }
+                static __m512i merge0()
+                {
+                    return _mm512_set_epi64(11, 3, 10, 2, 9, 1, 8, 0);
+                }
+                static __m512i merge1()
+                {
+                    return _mm512_set_epi64(15, 7, 14, 6, 13, 5, 12, 4);
+                }
+                static __m512i root()
+                {
+                    return _mm512_set_epi64(7, 6, 5, 4, 3, 2, 1, 0);
+                }
+            };
+
+            // Loads the roots of the 8 / Gap groups in sixteen values without reading past them
+            template <size_t Gap>
+            inline __m512d load_small_gap_roots(const double *roots)
+            {
+                switch (Gap)
+                {
+                case 4:
+                    return _mm512_castpd128_pd512(_mm_loadu_pd(roots));
+                case 2:
+                    return _mm512_castpd256_pd512(_mm256_loadu_pd(roots));
+                default:
+                    return _mm512_loadu_pd(roots);
+                }
+            }
+
+            // A layer of m groups with gap 4, 2, or 1
+            template <size_t Gap, bool Inverse>
+            void small_gap_layer(
+                double *real, double *imag, size_t m, const double *root_real, const double *root_imag)
+            {
+                using Lanes = SmallGapLanes<Gap>;
+                const __m512i split_x = Lanes::split_x();
+                const __m512i split_y = Lanes::split_y();
+                const __m512i merge0 = Lanes::merge0();
+                const __m512i merge1 = Lanes::merge1();
+                const __m512i root = Lanes::root();
+                for (size_t i = 0; i < m; i += 8 / Gap, real += 16, imag += 16)
+                {
+                    Complex v0 = load(real, imag);
+                    Complex v1 = load(real + 8, imag + 8);
+                    Complex x = { _mm512_permutex2var_pd(v0.re, split_x, v1.re),
+                                  _mm512_permutex2var_pd(v0.im, split_x, v1.im) };
+                    Complex y = { _mm512_permutex2var_pd(v0.re, split_y, v1.re),
+                                  _mm512_permutex2var_pd(v0.im, split_y, v1.im) };
+                    Complex w = { _mm512_permutexvar_pd(root, load_small_gap_roots<Gap>(root_real + i)),
+                                  _mm512_permutexvar_pd(root, load_small_gap_roots<Gap>(root_imag + i)) };
+
+                    butterfly<Inverse>(x, y, w);
+                    store(
+                        real, imag,
+                        { _mm512_permutex2var_pd(x.re, merge0, y.re), _mm512_permutex2var_pd(x.im, merge0, y.im) });
+                    store(
+                        real + 8, imag + 8,
+                        { _mm512_permutex2var_pd(x.re, merge1, y.re), _mm512_permutex2var_pd(x.im, merge1, y.im) });
+                }
+            }
+        } // namespace
+
+        void special_fft_to_rev_avx512(
+            double *real, double *imag, int log_n, const double *root_real, const double *root_imag)
+        {
+            size_t n = size_t(1) << log_n;
+
+            // The layer with m groups uses the powers starting from index m
+            size_t m = 1;
+            size_t gap = n >> 1;
+            for (; gap >= 16; m <<= 2, gap >>= 2)
+            {
+                forward_radix4_layers(real, imag, m, gap, root_real + m, root_imag + m);
+            }
+            if (gap == 8)
+            {
+                radix2_layer<false>(real, imag, m, gap, root_real + m, root_imag + m);
+                m <<= 1;
+            }
+            small_gap_layer<4, false>(real, imag, m, root_real + m, root_imag + m);
+            m <<= 1;
+            small_gap_layer<2, false>(real, imag, m, root_real + m, root_imag + m);
+            m <<= 1;
+            small_gap_layer<1, false>(real, imag, m, root_real + m, root_imag + m);
+        }
+
+        void special_fft_from_rev_avx512(
+            double *real, double *imag, int log_n, const double *inv_root_real, const double *inv_root_imag,
+            const double *scalar)
+        {
+            size_t n = size_t(1) << log_n;
+
+            // The layers consume the powers one after another, starting from index 1
+            const double *root_real = inv_root_real + 1;
+            const double *root_imag = inv_root_imag + 1;
+            size_t m = n >> 1;
+            small_gap_layer<1, true>(real, imag, m, root_real, root_imag);
+            root_real += m;
+            root_imag += m;
+            m >>= 1;
+            small_gap_layer<2, true>(real, imag, m, root_real, root_imag);
+            root_real += m;
+            root_imag += m;
+            m >>= 1;
+            small_gap_layer<4, true>(real, imag, m, root_real, root_imag);
+            root_real += m;
+            root_imag += m;
+            m >>= 1;
+
+            // The remaining log_n - 3 layers are merged into radix-4 passes after at most one radix-2 layer; the last
+            // pass multiplies by the scalar
+            __m512d s = _mm512_set1_pd(scalar ? *scalar : 1.0);
+            size_t gap = 8;
+            if ((log_n - 3) & 1)
+            {
+                if (m == 1)
+                {
+                    scaled_last_layer(real, imag, gap, root_real, root_imag, s);
+                    return;
+                }
+                radix2_layer<true>(real, imag, m, gap, root_real, root_imag);
+                root_real += m;
+                root_imag += m;
+                m >>= 1;
+                gap <<= 1;
+            }
+            for (; m > 2; m >>= 2, gap <<= 2)
+            {
+                inverse_radix4_layers<false>(real, imag, m, gap, root_real, root_imag, s);
+                root_real += m + (m >> 1);
+                root_imag += m + (m >> 1);
+            }
+            if (scalar)
+            {
+                inverse_radix4_layers<true>(real, imag, m, gap, root_real, root_imag, s);
+            }
+            else
+            {
+                inverse_radix4_layers<false>(real, imag, m, gap, root_real, root_imag, s);
+            }
+        }
+    } // namespace util
+} // namespace seal
+#endif
@@ -13,6 +13,8 @@ namespace seal
         namespace global_variables
         {
             shared_ptr<MemoryPool> const global_memory_pool{ make_shared<MemoryPoolMT>() };
+
+            shared_ptr<MemoryPool> const global_size_class_memory_pool{ make_shared<MemoryPoolSC>() };
 #ifndef _M_CEE
             thread_local shared_ptr<MemoryPool> const tls_memory_pool{ make_shared<MemoryPoolST>() };
 #else
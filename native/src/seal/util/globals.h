@@ -21,6 +21,8 @@ namespace seal
         {
             extern std::shared_ptr<MemoryPool> const global_memory_pool;
 
+            extern std::shared_ptr<MemoryPool> const global_size_class_memory_pool;
+
 /*
 For .NET Framework wrapper support (C++/CLI) we need to
     (1) compile the MemoryManager class as thread-unsafe because C++
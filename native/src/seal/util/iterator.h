@@ -261,10 +261,13 @@ namespace seal
         the start index.
 
         @par Note on allocations
-        In the future we hope to use the parallel version of std::for_each_n, introduced in C++17. For this to work, be
-        mindful of how you use heap allocations in the lambda functions. Specifically, in heavy lambda functions it is
-        probably a good idea to call seal::util::allocate inside the lambda function for any allocations needed, rather
-        than using allocations captured from outside the lambda function.
+        The SEAL_ITERATE_PARALLEL macro runs the iterations on an internal thread pool when the library is built with
+        SEAL_USE_THREAD_POOL (see seal/util/threadpool.h). For this to work, be mindful of how you use heap allocations
+        in the lambda functions. Specifically, in heavy lambda functions it is probably a good idea to call
+        seal::util::allocate inside the lambda function for any allocations needed, rather than using allocations
+        captured from outside the lambda function. If the lambda function allocates from a MemoryPoolHandle, pass it
+        as an additional first argument to SEAL_ITERATE_PARALLEL so that a memory pool that is not thread-safe is never
+        used concurrently.
 
         @par Iterators to temporary allocations
         In many cases one may want to allocate a temporary buffer and create an iterator pointing to it. However, care
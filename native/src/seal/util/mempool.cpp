@@ -5,8 +5,15 @@
 #include "seal/util/mempool.h"
 #include "seal/util/uintarith.h"
 #include <cmath>
+#include <cstdint>
+#include <functional>
 #include <numeric>
 #include <stdexcept>
+#include <unordered_map>
+#if defined(SEAL_USE_MADVISE) || defined(SEAL_USE_HUGE_PAGES)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 using namespace std;
 
@@ -26,9 +33,420 @@ namespace seal
         // ensure symbol is created.
         constexpr size_t MemoryPool::first_alloc_count;
 
-        MemoryPoolHeadMT::MemoryPoolHeadMT(size_t item_byte_count, bool clear_on_destruction)
-            : clear_on_destruction_(clear_on_destruction), locked_(false), item_byte_count_(item_byte_count),
-              item_count_(MemoryPool::first_alloc_count), first_item_(nullptr)
+        // Required for C++14 compliance: static constexpr member variables are not necessarily inlined so need to
+        // ensure symbol is created.
+        constexpr size_t MemoryPool::discard_min_byte_count;
+
+        // Required for C++14 compliance: static constexpr member variables are not necessarily inlined so need to
+        // ensure symbol is created.
+        constexpr size_t MemoryPool::max_trace_capacity;
+
+        // Required for C++14 compliance: static constexpr member variables are not necessarily inlined so need to
+        // ensure symbol is created.
+        constexpr size_t MemoryPool::huge_page_byte_count;
+
+        // Required for C++14 compliance: static constexpr member variables are not necessarily inlined so need to
+        // ensure symbol is created.
+        constexpr size_t MemoryPoolHeadSC::central_list_count;
+
+        // Required for C++14 compliance: static constexpr member variables are not necessarily inlined so need to
+        // ensure symbol is created.
+        constexpr size_t MemoryPoolHeadSC::magazine_byte_count;
+
+        // Required for C++14 compliance: static constexpr member variables are not necessarily inlined so need to
+        // ensure symbol is created.
+        constexpr size_t MemoryPoolHeadSC::max_magazine_capacity;
+
+        // Required for C++14 compliance: static constexpr member variables are not necessarily inlined so need to
+        // ensure symbol is created.
+        constexpr size_t MemoryPoolSC::size_class_count;
+
+        // Required for C++14 compliance: static constexpr member variables are not necessarily inlined so need to
+        // ensure symbol is created.
+        constexpr size_t MemoryPoolArena::alignment;
+
+        namespace
+        {
+#ifdef SEAL_USE_MADVISE
+            // Returns the pages that lie entirely within the given range to the operating system
+            void discard_pages(seal_byte *data, size_t byte_count) noexcept
+            {
+                static const uintptr_t page_byte_count = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+                uintptr_t begin = (reinterpret_cast<uintptr_t>(data) + page_byte_count - 1) & ~(page_byte_count - 1);
+                uintptr_t end = (reinterpret_cast<uintptr_t>(data) + byte_count) & ~(page_byte_count - 1);
+                if (begin < end)
+                {
+                    // On failure the pages simply stay resident
+                    madvise(reinterpret_cast<void *>(begin), end - begin, MADV_DONTNEED);
+                }
+            }
+#else
+            void discard_pages(seal_byte *, size_t) noexcept
+            {}
+#endif
+#ifdef SEAL_USE_HUGE_PAGES
+            SEAL_NODISCARD inline size_t huge_page_mapping_byte_count(size_t byte_count) noexcept
+            {
+                return (byte_count + MemoryPool::huge_page_byte_count - 1) & ~(MemoryPool::huge_page_byte_count - 1);
+            }
+
+            // Allocates memory for the items of a memory pool head; large allocations of heads using huge pages are
+            // mapped aligned to the huge page size and marked for transparent huge pages
+            SEAL_NODISCARD seal_byte *alloc_memory(size_t byte_count, bool huge_pages)
+            {
+                if (!huge_pages || byte_count < MemoryPool::huge_page_byte_count)
+                {
+                    return SEAL_MALLOC(byte_count);
+                }
+
+                // Map one huge page more than needed and unmap the unaligned ends
+                size_t mapping_byte_count = huge_page_mapping_byte_count(byte_count);
+                void *mapping = mmap(
+                    nullptr, mapping_byte_count + MemoryPool::huge_page_byte_count, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (mapping == MAP_FAILED)
+                {
+                    throw bad_alloc();
+                }
+                uintptr_t begin = reinterpret_cast<uintptr_t>(mapping);
+                uintptr_t end = begin + mapping_byte_count + MemoryPool::huge_page_byte_count;
+                uintptr_t aligned_begin =
+                    (begin + MemoryPool::huge_page_byte_count - 1) & ~(MemoryPool::huge_page_byte_count - 1);
+                uintptr_t aligned_end = aligned_begin + mapping_byte_count;
+                if (aligned_begin > begin)
+                {
+                    munmap(mapping, aligned_begin - begin);
+                }
+                if (end > aligned_end)
+                {
+                    munmap(reinterpret_cast<void *>(aligned_end), end - aligned_end);
+                }
+
+                // On failure the memory is simply backed by regular pages
+                madvise(reinterpret_cast<void *>(aligned_begin), mapping_byte_count, MADV_HUGEPAGE);
+                return reinterpret_cast<seal_byte *>(aligned_begin);
+            }
+
+            void free_memory(seal_byte *data, size_t byte_count, bool huge_pages) noexcept
+            {
+                if (!huge_pages || byte_count < MemoryPool::huge_page_byte_count)
+                {
+                    SEAL_FREE(data);
+                    return;
+                }
+                munmap(data, huge_page_mapping_byte_count(byte_count));
+            }
+#else
+            SEAL_NODISCARD inline seal_byte *alloc_memory(size_t byte_count, bool)
+            {
+                return SEAL_MALLOC(byte_count);
+            }
+
+            inline void free_memory(seal_byte *data, size_t, bool) noexcept
+            {
+                SEAL_FREE(data);
+            }
+#endif
+            void discard_free_items(MemoryPoolItem *first_item, size_t item_byte_count) noexcept
+            {
+                if (item_byte_count < MemoryPool::discard_min_byte_count)
+                {
+                    return;
+                }
+                for (MemoryPoolItem *item = first_item; item; item = item->next())
+                {
+                    discard_pages(item->data(), item_byte_count);
+                }
+            }
+
+            // Selects the allocations all of whose items are in the free list starting at first_item, largest first,
+            // until at least byte_count bytes are selected. The items of the selected allocations are removed from
+            // the free list, and deleted if delete_items is true.
+            vector<bool> select_unused_allocs(
+                const vector<MemoryPoolHead::allocation> &allocs, MemoryPoolItem *&first_item, size_t item_byte_count,
+                size_t byte_count, bool delete_items)
+            {
+                vector<bool> selected(allocs.size(), false);
+                if (!byte_count)
+                {
+                    return selected;
+                }
+
+                // The allocations ordered by address locate the allocation of each item
+                vector<size_t> by_address(allocs.size());
+                iota(by_address.begin(), by_address.end(), size_t(0));
+                sort(by_address.begin(), by_address.end(), [&](size_t a, size_t b) {
+                    return less<const seal_byte *>()(allocs[a].data_ptr, allocs[b].data_ptr);
+                });
+                auto alloc_index = [&](MemoryPoolItem *item) {
+                    auto it = upper_bound(
+                        by_address.begin(), by_address.end(), item->data(), [&](const seal_byte *data, size_t index) {
+                            return less<const seal_byte *>()(data, allocs[index].data_ptr);
+                        });
+                    return *(it - 1);
+                };
+
+                vector<size_t> free_counts(allocs.size(), 0);
+                for (MemoryPoolItem *item = first_item; item; item = item->next())
+                {
+                    free_counts[alloc_index(item)]++;
+                }
+
+                // Items that were never handed out are not in the free list
+                vector<size_t> unused;
+                for (size_t i = 0; i < allocs.size(); i++)
+                {
+                    if (free_counts[i] == allocs[i].size - allocs[i].free)
+                    {
+                        unused.push_back(i);
+                    }
+                }
+                stable_sort(
+                    unused.begin(), unused.end(), [&](size_t a, size_t b) { return allocs[a].size > allocs[b].size; });
+
+                size_t selected_byte_count = 0;
+                for (size_t index : unused)
+                {
+                    if (selected_byte_count >= byte_count)
+                    {
+                        break;
+                    }
+                    selected[index] = true;
+                    selected_byte_count = add_safe(selected_byte_count, mul_safe(allocs[index].size, item_byte_count));
+                }
+
+                MemoryPoolItem **link = &first_item;
+                while (*link)
+                {
+                    MemoryPoolItem *item = *link;
+                    if (selected[alloc_index(item)])
+                    {
+                        *link = item->next();
+                        if (delete_items)
+                        {
+                            delete item;
+                        }
+                    }
+                    else
+                    {
+                        link = &item->next();
+                    }
+                }
+                return selected;
+            }
+
+            // Frees and removes the selected allocations, and returns the number of items they could hold
+            size_t free_selected_allocs(
+                vector<MemoryPoolHead::allocation> &allocs, const vector<bool> &selected, size_t item_byte_count,
+                bool clear_on_destruction, bool huge_pages) noexcept
+            {
+                size_t freed_item_count = 0;
+                size_t kept_count = 0;
+                for (size_t i = 0; i < allocs.size(); i++)
+                {
+                    if (!selected[i])
+                    {
+                        allocs[kept_count++] = allocs[i];
+                        continue;
+                    }
+
+                    // Trimmed memory may hold private data just like the memory of a destroyed pool
+                    if (clear_on_destruction)
+                    {
+                        seal_memzero(allocs[i].data_ptr, allocs[i].size * item_byte_count);
+                    }
+                    free_memory(allocs[i].data_ptr, allocs[i].size * item_byte_count, huge_pages);
+                    freed_item_count += allocs[i].size;
+                }
+                allocs.erase(allocs.begin() + static_cast<ptrdiff_t>(kept_count), allocs.end());
+                return freed_item_count;
+            }
+
+            // Frees unused allocations of the heads in the given order until at most target_byte_count bytes are
+            // allocated, and discards the pages of large free items if that is not enough
+            template <typename HeadIt>
+            size_t trim_heads(HeadIt first, HeadIt last, size_t alloc_byte_count, size_t target_byte_count)
+            {
+                size_t freed_byte_count = 0;
+                for (HeadIt it = first; it != last && alloc_byte_count - freed_byte_count > target_byte_count; ++it)
+                {
+                    if (*it)
+                    {
+                        freed_byte_count +=
+                            (*it)->free_unused(alloc_byte_count - freed_byte_count - target_byte_count);
+                    }
+                }
+                if (alloc_byte_count - freed_byte_count > target_byte_count)
+                {
+                    for (HeadIt it = first; it != last; ++it)
+                    {
+                        if (*it)
+                        {
+                            (*it)->discard_free();
+                        }
+                    }
+                }
+                return freed_byte_count;
+            }
+
+            // Live instances of MemoryPoolSC by id, so that exiting threads can tell which of the pools they hold
+            // magazines for still exist
+            struct MemoryPoolSCRegistry
+            {
+                ReaderWriterLocker locker;
+
+                unordered_map<uint64_t, MemoryPoolSC *> pools;
+            };
+
+            MemoryPoolSCRegistry &sc_registry()
+            {
+                // Never destroyed, as pools and thread caches may outlive any other static object
+                static MemoryPoolSCRegistry *registry = new MemoryPoolSCRegistry;
+                return *registry;
+            }
+
+            atomic<uint64_t> sc_next_id{ 0 };
+
+            // Set when the thread cache table of the thread is destroyed; a pool used after that (e.g. by the
+            // destructor of a static object) falls back to the central free lists
+            thread_local bool sc_thread_exiting = false;
+
+            // Increments a counter that only the calling thread writes, but any thread may read
+            inline void increment_owned(atomic<uint64_t> &counter) noexcept
+            {
+                counter.store(counter.load(memory_order_relaxed) + 1, memory_order_relaxed);
+            }
+
+            // Name of the outermost AllocationScope of the calling thread
+            thread_local const char *allocation_scope_function = nullptr;
+        } // namespace
+
+        AllocationScope::AllocationScope(const char *function) noexcept : outermost_(!allocation_scope_function)
+        {
+            if (outermost_)
+            {
+                allocation_scope_function = function;
+            }
+        }
+
+        AllocationScope::~AllocationScope() noexcept
+        {
+            if (outermost_)
+            {
+                allocation_scope_function = nullptr;
+            }
+        }
+
+        const char *AllocationScope::current() noexcept
+        {
+            return allocation_scope_function;
+        }
+
+        struct MemoryPoolSC::ThreadCache
+        {
+            struct magazine
+            {
+                MemoryPoolItem *first = nullptr;
+
+                size_t count = 0;
+
+                // Counters of the items got from and added to the magazine by its thread
+                atomic<uint64_t> get_count{ 0 };
+
+                atomic<uint64_t> fresh_count{ 0 };
+
+                atomic<uint64_t> add_count{ 0 };
+            };
+
+            magazine magazines[MemoryPoolSC::size_class_count];
+
+            // Central free list each magazine of this cache tries first
+            size_t list_hint = 0;
+        };
+
+        class MemoryPoolSC::ThreadCacheTable
+        {
+        public:
+            ThreadCacheTable() = default;
+
+            ~ThreadCacheTable() noexcept
+            {
+                sc_thread_exiting = true;
+                auto &registry = sc_registry();
+                ReaderLock lock(registry.locker.acquire_read());
+                for (auto &curr_entry : entries_)
+                {
+                    auto it = registry.pools.find(curr_entry.pool_id);
+                    if (it != registry.pools.end())
+                    {
+                        it->second->release_thread_cache(curr_entry.cache);
+                    }
+                }
+            }
+
+            SEAL_NODISCARD inline ThreadCache *find(uint64_t pool_id) noexcept
+            {
+                if (last_ < entries_.size() && entries_[last_].pool_id == pool_id)
+                {
+                    return entries_[last_].cache;
+                }
+                for (size_t i = 0; i < entries_.size(); i++)
+                {
+                    if (entries_[i].pool_id == pool_id)
+                    {
+                        last_ = i;
+                        return entries_[i].cache;
+                    }
+                }
+                return nullptr;
+            }
+
+            void insert(uint64_t pool_id, ThreadCache *cache)
+            {
+                // Drop the entries of destroyed pools once in a while
+                if (entries_.size() >= prune_size_)
+                {
+                    auto &registry = sc_registry();
+                    ReaderLock lock(registry.locker.acquire_read());
+                    entries_.erase(
+                        remove_if(
+                            entries_.begin(), entries_.end(),
+                            [&](const entry &curr_entry) { return !registry.pools.count(curr_entry.pool_id); }),
+                        entries_.end());
+                    prune_size_ = max<size_t>(min_prune_size, 2 * entries_.size());
+                }
+                entries_.push_back({ pool_id, cache });
+                last_ = entries_.size() - 1;
+            }
+
+        private:
+            ThreadCacheTable(const ThreadCacheTable &copy) = delete;
+
+            ThreadCacheTable &operator=(const ThreadCacheTable &assign) = delete;
+
+            struct entry
+            {
+                uint64_t pool_id;
+
+                ThreadCache *cache;
+            };
+
+            static constexpr size_t min_prune_size = 8;
+
+            vector<entry> entries_;
+
+            size_t last_ = 0;
+
+            size_t prune_size_ = min_prune_size;
+        };
+
+        // Required for C++14 compliance: static constexpr member variables are not necessarily inlined so need to
+        // ensure symbol is created.
+        constexpr size_t MemoryPoolSC::ThreadCacheTable::min_prune_size;
+
+        MemoryPoolHeadMT::MemoryPoolHeadMT(size_t item_byte_count, bool clear_on_destruction, bool huge_pages)
+            : clear_on_destruction_(clear_on_destruction), huge_pages_(huge_pages), locked_(false),
+              item_byte_count_(item_byte_count), item_count_(MemoryPool::first_alloc_count), first_item_(nullptr)
         {
             if ((item_byte_count_ == 0) || (item_byte_count_ > MemoryPool::max_batch_alloc_byte_count) ||
                 (mul_safe(item_byte_count_, MemoryPool::first_alloc_count) > MemoryPool::max_batch_alloc_byte_count))
@@ -40,7 +458,8 @@ namespace seal
             allocation new_alloc;
             try
             {
-                new_alloc.data_ptr = SEAL_MALLOC(mul_safe(MemoryPool::first_alloc_count, item_byte_count_));
+                new_alloc.data_ptr =
+                    alloc_memory(mul_safe(MemoryPool::first_alloc_count, item_byte_count_), huge_pages_);
             }
             catch (const bad_alloc &)
             {
@@ -83,7 +502,7 @@ namespace seal
                     seal_memzero(alloc.data_ptr, curr_alloc_byte_count);
 
                     // Delete this allocation
-                    SEAL_FREE(alloc.data_ptr);
+                    free_memory(alloc.data_ptr, curr_alloc_byte_count, huge_pages_);
                 }
             }
             else
@@ -92,7 +511,7 @@ namespace seal
                 for (auto &alloc : allocs_)
                 {
                     // Delete this allocation
-                    SEAL_FREE(alloc.data_ptr);
+                    free_memory(alloc.data_ptr, item_byte_count_ * alloc.size, huge_pages_);
                 }
             }
 
@@ -111,33 +530,34 @@ namespace seal
             // Is pool empty?
             if (old_first == nullptr)
             {
-                allocation &last_alloc = allocs_.back();
                 MemoryPoolItem *new_item = nullptr;
-                if (last_alloc.free > 0)
+                if (!allocs_.empty() && allocs_.back().free > 0)
                 {
                     // Pool is empty; there is memory
-                    new_item = new MemoryPoolItem(last_alloc.head_ptr);
+                    allocation &last_alloc = allocs_.back();
+                    new_item = new MemoryPoolItem(last_alloc.head_ptr, item_byte_count_);
                     last_alloc.free--;
                     last_alloc.head_ptr += item_byte_count_;
                 }
                 else
                 {
-                    // Pool is empty; there is no memory
+                    // Pool is empty; there is no memory, or all of it was trimmed
                     allocation new_alloc;
 
                     // Increase allocation size unless we are already at max
-                    size_t new_size = safe_cast<size_t>(
-                        ceil(MemoryPool::alloc_size_multiplier * static_cast<double>(last_alloc.size)));
+                    size_t last_size = allocs_.empty() ? MemoryPool::first_alloc_count : allocs_.back().size;
+                    size_t new_size =
+                        safe_cast<size_t>(ceil(MemoryPool::alloc_size_multiplier * static_cast<double>(last_size)));
                     size_t new_alloc_byte_count = mul_safe(new_size, item_byte_count_);
                     if (new_alloc_byte_count > MemoryPool::max_batch_alloc_byte_count)
                     {
-                        new_size = last_alloc.size;
+                        new_size = last_size;
                         new_alloc_byte_count = new_size * item_byte_count_;
                     }
 
                     try
                     {
-                        new_alloc.data_ptr = SEAL_MALLOC(new_alloc_byte_count);
+                        new_alloc.data_ptr = alloc_memory(new_alloc_byte_count, huge_pages_);
                     }
                     catch (const bad_alloc &)
                     {
@@ -150,9 +570,11 @@ namespace seal
                     new_alloc.head_ptr = new_alloc.data_ptr + item_byte_count_;
                     allocs_.push_back(new_alloc);
                     item_count_ += new_size;
-                    new_item = new MemoryPoolItem(new_alloc.data_ptr);
+                    new_item = new MemoryPoolItem(new_alloc.data_ptr, item_byte_count_);
                 }
 
+                fresh_count_++;
+                peak_in_use_count_ = max(peak_in_use_count_, ++in_use_count_);
                 locked_.store(false, memory_order_release);
                 return new_item;
             }
@@ -160,12 +582,71 @@ namespace seal
             // Pool is not empty
             first_item_ = old_first->next();
             old_first->next() = nullptr;
+            reuse_count_++;
+            peak_in_use_count_ = max(peak_in_use_count_, ++in_use_count_);
             locked_.store(false, memory_order_release);
             return old_first;
         }
 
-        MemoryPoolHeadST::MemoryPoolHeadST(size_t item_byte_count, bool clear_on_destruction)
-            : clear_on_destruction_(clear_on_destruction), item_byte_count_(item_byte_count),
+        size_t MemoryPoolHeadMT::free_unused(size_t byte_count)
+        {
+            bool expected = false;
+            while (!locked_.compare_exchange_strong(expected, true, memory_order_acquire))
+            {
+                expected = false;
+            }
+
+            size_t freed_item_count = 0;
+            try
+            {
+                MemoryPoolItem *first_item = first_item_;
+                vector<bool> selected = select_unused_allocs(allocs_, first_item, item_byte_count_, byte_count, true);
+                first_item_ = first_item;
+                freed_item_count =
+                    free_selected_allocs(allocs_, selected, item_byte_count_, clear_on_destruction_, huge_pages_);
+                item_count_ = item_count_ - freed_item_count;
+            }
+            catch (...)
+            {
+                locked_.store(false, memory_order_release);
+                throw;
+            }
+
+            locked_.store(false, memory_order_release);
+            return freed_item_count * item_byte_count_;
+        }
+
+        void MemoryPoolHeadMT::discard_free() noexcept
+        {
+            bool expected = false;
+            while (!locked_.compare_exchange_strong(expected, true, memory_order_acquire))
+            {
+                expected = false;
+            }
+            discard_free_items(first_item_, item_byte_count_);
+            locked_.store(false, memory_order_release);
+        }
+
+        MemoryPoolHeadStats MemoryPoolHeadMT::stats() const
+        {
+            bool expected = false;
+            while (!locked_.compare_exchange_strong(expected, true, memory_order_acquire))
+            {
+                expected = false;
+            }
+            MemoryPoolHeadStats head_stats;
+            head_stats.item_byte_count = item_byte_count_;
+            head_stats.item_count = item_count_;
+            head_stats.reuse_count = reuse_count_;
+            head_stats.fresh_count = fresh_count_;
+            head_stats.in_use_count = in_use_count_;
+            head_stats.peak_in_use_count = peak_in_use_count_;
+            locked_.store(false, memory_order_release);
+            return head_stats;
+        }
+
+        MemoryPoolHeadST::MemoryPoolHeadST(size_t item_byte_count, bool clear_on_destruction, bool huge_pages)
+            : clear_on_destruction_(clear_on_destruction), huge_pages_(huge_pages), item_byte_count_(item_byte_count),
               item_count_(MemoryPool::first_alloc_count), first_item_(nullptr)
         {
             if ((item_byte_count_ == 0) || (item_byte_count_ > MemoryPool::max_batch_alloc_byte_count) ||
@@ -178,7 +659,8 @@ namespace seal
             allocation new_alloc;
             try
             {
-                new_alloc.data_ptr = SEAL_MALLOC(mul_safe(MemoryPool::first_alloc_count, item_byte_count_));
+                new_alloc.data_ptr =
+                    alloc_memory(mul_safe(MemoryPool::first_alloc_count, item_byte_count_), huge_pages_);
             }
             catch (const bad_alloc &)
             {
@@ -215,7 +697,7 @@ namespace seal
                     seal_memzero(alloc.data_ptr, curr_alloc_byte_count);
 
                     // Delete this allocation
-                    SEAL_FREE(alloc.data_ptr);
+                    free_memory(alloc.data_ptr, curr_alloc_byte_count, huge_pages_);
                 }
             }
             else
@@ -224,7 +706,7 @@ namespace seal
                 for (auto &alloc : allocs_)
                 {
                     // Delete this allocation
-                    SEAL_FREE(alloc.data_ptr);
+                    free_memory(alloc.data_ptr, item_byte_count_ * alloc.size, huge_pages_);
                 }
             }
 
@@ -238,33 +720,34 @@ namespace seal
             // Is pool empty?
             if (old_first == nullptr)
             {
-                allocation &last_alloc = allocs_.back();
                 MemoryPoolItem *new_item = nullptr;
-                if (last_alloc.free > 0)
+                if (!allocs_.empty() && allocs_.back().free > 0)
                 {
                     // Pool is empty; there is memory
-                    new_item = new MemoryPoolItem(last_alloc.head_ptr);
+                    allocation &last_alloc = allocs_.back();
+                    new_item = new MemoryPoolItem(last_alloc.head_ptr, item_byte_count_);
                     last_alloc.free--;
                     last_alloc.head_ptr += item_byte_count_;
                 }
                 else
                 {
-                    // Pool is empty; there is no memory
+                    // Pool is empty; there is no memory, or all of it was trimmed
                     allocation new_alloc;
 
                     // Increase allocation size unless we are already at max
-                    size_t new_size = safe_cast<size_t>(
-                        ceil(MemoryPool::alloc_size_multiplier * static_cast<double>(last_alloc.size)));
+                    size_t last_size = allocs_.empty() ? MemoryPool::first_alloc_count : allocs_.back().size;
+                    size_t new_size =
+                        safe_cast<size_t>(ceil(MemoryPool::alloc_size_multiplier * static_cast<double>(last_size)));
                     size_t new_alloc_byte_count = mul_safe(new_size, item_byte_count_);
                     if (new_alloc_byte_count > MemoryPool::max_batch_alloc_byte_count)
                     {
-                        new_size = last_alloc.size;
+                        new_size = last_size;
                         new_alloc_byte_count = new_size * item_byte_count_;
                     }
 
                     try
                     {
-                        new_alloc.data_ptr = SEAL_MALLOC(new_alloc_byte_count);
+                        new_alloc.data_ptr = alloc_memory(new_alloc_byte_count, huge_pages_);
                     }
                     catch (const bad_alloc &)
                     {
@@ -277,18 +760,48 @@ namespace seal
                     new_alloc.head_ptr = new_alloc.data_ptr + item_byte_count_;
                     allocs_.push_back(new_alloc);
                     item_count_ += new_size;
-                    new_item = new MemoryPoolItem(new_alloc.data_ptr);
+                    new_item = new MemoryPoolItem(new_alloc.data_ptr, item_byte_count_);
                 }
 
+                fresh_count_++;
+                peak_in_use_count_ = max(peak_in_use_count_, ++in_use_count_);
                 return new_item;
             }
 
             // Pool is not empty
             first_item_ = old_first->next();
             old_first->next() = nullptr;
+            reuse_count_++;
+            peak_in_use_count_ = max(peak_in_use_count_, ++in_use_count_);
             return old_first;
         }
 
+        size_t MemoryPoolHeadST::free_unused(size_t byte_count)
+        {
+            vector<bool> selected = select_unused_allocs(allocs_, first_item_, item_byte_count_, byte_count, true);
+            size_t freed_item_count =
+                free_selected_allocs(allocs_, selected, item_byte_count_, clear_on_destruction_, huge_pages_);
+            item_count_ -= freed_item_count;
+            return freed_item_count * item_byte_count_;
+        }
+
+        void MemoryPoolHeadST::discard_free() noexcept
+        {
+            discard_free_items(first_item_, item_byte_count_);
+        }
+
+        MemoryPoolHeadStats MemoryPoolHeadST::stats() const
+        {
+            MemoryPoolHeadStats head_stats;
+            head_stats.item_byte_count = item_byte_count_;
+            head_stats.item_count = item_count_;
+            head_stats.reuse_count = reuse_count_;
+            head_stats.fresh_count = fresh_count_;
+            head_stats.in_use_count = in_use_count_;
+            head_stats.peak_in_use_count = peak_in_use_count_;
+            return head_stats;
+        }
+
         const size_t MemoryPool::max_single_alloc_byte_count = []() -> size_t {
             int bit_shift = static_cast<int>(ceil(log2(MemoryPool::alloc_size_multiplier)));
             if (bit_shift < 0 || unsigned_geq(bit_shift, sizeof(size_t) * static_cast<size_t>(bits_per_byte)))
@@ -307,6 +820,67 @@ namespace seal
             return numeric_limits<size_t>::max() >> bit_shift;
         }();
 
+        void MemoryPool::set_trace(uint64_t sample_period, size_t capacity)
+        {
+            if (sample_period && (!capacity || capacity > max_trace_capacity))
+            {
+                throw invalid_argument("capacity is out of range");
+            }
+
+            WriterLock lock(trace_locker_.acquire_write());
+            trace_sample_period_.store(0, memory_order_relaxed);
+            trace_entries_.clear();
+            trace_entries_.shrink_to_fit();
+            trace_entries_.reserve(sample_period ? capacity : 0);
+            trace_capacity_ = sample_period ? capacity : 0;
+            trace_next_ = 0;
+            trace_allocation_count_.store(0, memory_order_relaxed);
+            trace_sample_period_.store(sample_period, memory_order_relaxed);
+        }
+
+        vector<MemoryPoolTraceEntry> MemoryPool::trace() const
+        {
+            ReaderLock lock(trace_locker_.acquire_read());
+            vector<MemoryPoolTraceEntry> entries;
+            entries.reserve(trace_entries_.size());
+            entries.insert(
+                entries.end(), trace_entries_.cbegin() + static_cast<ptrdiff_t>(trace_next_), trace_entries_.cend());
+            entries.insert(
+                entries.end(), trace_entries_.cbegin(), trace_entries_.cbegin() + static_cast<ptrdiff_t>(trace_next_));
+            return entries;
+        }
+
+        void MemoryPool::record_allocation(size_t byte_count)
+        {
+            uint64_t allocation_index = trace_allocation_count_.fetch_add(1, memory_order_relaxed);
+            uint64_t sample_period = trace_sample_period_.load(memory_order_relaxed);
+            if (!sample_period || allocation_index % sample_period)
+            {
+                return;
+            }
+
+            MemoryPoolTraceEntry entry;
+            entry.allocation_index = allocation_index;
+            entry.byte_count = byte_count;
+            entry.function = AllocationScope::current();
+
+            // Capacity for the entries was reserved by set_trace
+            WriterLock lock(trace_locker_.acquire_write());
+            if (!trace_capacity_)
+            {
+                return;
+            }
+            if (trace_entries_.size() < trace_capacity_)
+            {
+                trace_entries_.push_back(entry);
+            }
+            else
+            {
+                trace_entries_[trace_next_] = entry;
+                trace_next_ = (trace_next_ + 1) % trace_capacity_;
+            }
+        }
+
         MemoryPoolMT::~MemoryPoolMT() noexcept
         {
             WriterLock lock(pools_locker_.acquire_write());
@@ -327,6 +901,7 @@ namespace seal
             {
                 return Pointer<seal_byte>();
             }
+            trace_allocation(byte_count);
 
             // Attempt to find size.
             ReaderLock reader_lock(pools_locker_.acquire_read());
@@ -382,7 +957,7 @@ namespace seal
                 throw runtime_error("maximum pool head count reached");
             }
 
-            MemoryPoolHead *new_head = new MemoryPoolHeadMT(byte_count, clear_on_destruction_);
+            MemoryPoolHead *new_head = new MemoryPoolHeadMT(byte_count, clear_on_destruction_, huge_pages_);
             if (!pools_.empty())
             {
                 pools_.insert(pools_.begin() + static_cast<ptrdiff_t>(start), new_head);
@@ -404,25 +979,64 @@ namespace seal
             });
         }
 
-        MemoryPoolST::~MemoryPoolST() noexcept
+        vector<MemoryPoolHeadStats> MemoryPoolMT::stats() const
         {
-            for (MemoryPoolHead *head : pools_)
+            // The heads are ordered by decreasing item byte count
+            ReaderLock lock(pools_locker_.acquire_read());
+            vector<MemoryPoolHeadStats> pool_stats;
+            pool_stats.reserve(pools_.size());
+            for (auto it = pools_.crbegin(); it != pools_.crend(); ++it)
             {
-                delete head;
+                pool_stats.push_back((*it)->stats());
             }
-            pools_.clear();
+            return pool_stats;
         }
 
-        Pointer<seal_byte> MemoryPoolST::get_for_byte_count(size_t byte_count)
+        size_t MemoryPoolMT::trim(size_t target_byte_count)
         {
-            if (byte_count > MemoryPool::max_single_alloc_byte_count)
-            {
-                throw invalid_argument("invalid allocation size");
-            }
+            WriterLock lock(pools_locker_.acquire_write());
+            size_t byte_count =
+                accumulate(pools_.cbegin(), pools_.cend(), size_t(0), [](size_t byte_count, MemoryPoolHead *head) {
+                    return add_safe(byte_count, mul_safe(head->item_count(), head->item_byte_count()));
+                });
+            size_t freed_byte_count = trim_heads(pools_.begin(), pools_.end(), byte_count, target_byte_count);
+
+            // Heads left without allocations have no items in use
+            pools_.erase(
+                remove_if(
+                    pools_.begin(), pools_.end(),
+                    [](MemoryPoolHead *head) {
+                        if (head->item_count())
+                        {
+                            return false;
+                        }
+                        delete head;
+                        return true;
+                    }),
+                pools_.end());
+            return freed_byte_count;
+        }
+
+        MemoryPoolST::~MemoryPoolST() noexcept
+        {
+            for (MemoryPoolHead *head : pools_)
+            {
+                delete head;
+            }
+            pools_.clear();
+        }
+
+        Pointer<seal_byte> MemoryPoolST::get_for_byte_count(size_t byte_count)
+        {
+            if (byte_count > MemoryPool::max_single_alloc_byte_count)
+            {
+                throw invalid_argument("invalid allocation size");
+            }
             else if (byte_count == 0)
             {
                 return Pointer<seal_byte>();
             }
+            trace_allocation(byte_count);
 
             // Attempt to find size.
             size_t start = 0;
@@ -453,7 +1067,7 @@ namespace seal
                 throw runtime_error("maximum pool head count reached");
             }
 
-            MemoryPoolHead *new_head = new MemoryPoolHeadST(byte_count, clear_on_destruction_);
+            MemoryPoolHead *new_head = new MemoryPoolHeadST(byte_count, clear_on_destruction_, huge_pages_);
             if (!pools_.empty())
             {
                 pools_.insert(pools_.begin() + static_cast<ptrdiff_t>(start), new_head);
@@ -472,5 +1086,867 @@ namespace seal
                 return add_safe(byte_count, mul_safe(head->item_count(), head->item_byte_count()));
             });
         }
+
+        vector<MemoryPoolHeadStats> MemoryPoolST::stats() const
+        {
+            // The heads are ordered by decreasing item byte count
+            vector<MemoryPoolHeadStats> pool_stats;
+            pool_stats.reserve(pools_.size());
+            for (auto it = pools_.crbegin(); it != pools_.crend(); ++it)
+            {
+                pool_stats.push_back((*it)->stats());
+            }
+            return pool_stats;
+        }
+
+        size_t MemoryPoolST::trim(size_t target_byte_count)
+        {
+            size_t freed_byte_count = trim_heads(pools_.begin(), pools_.end(), alloc_byte_count(), target_byte_count);
+
+            // Heads left without allocations have no items in use
+            pools_.erase(
+                remove_if(
+                    pools_.begin(), pools_.end(),
+                    [](MemoryPoolHead *head) {
+                        if (head->item_count())
+                        {
+                            return false;
+                        }
+                        delete head;
+                        return true;
+                    }),
+                pools_.end());
+            return freed_byte_count;
+        }
+
+        MemoryPoolHeadSC::MemoryPoolHeadSC(MemoryPoolSC &pool, size_t size_class, bool clear_on_destruction)
+            : pool_(pool), clear_on_destruction_(clear_on_destruction), size_class_(size_class),
+              item_byte_count_(MemoryPoolSC::size_class_byte_count(size_class)),
+              magazine_capacity_(
+                  max<size_t>(min(magazine_byte_count / item_byte_count_, max_magazine_capacity), 1)),
+              item_count_(0), held_count_(0), peak_held_count_(0), direct_get_count_(0), direct_fresh_count_(0),
+              direct_add_count_(0)
+        {
+            if (size_class_ >= MemoryPoolSC::size_class_count ||
+                item_byte_count_ > MemoryPool::max_batch_alloc_byte_count)
+            {
+                throw invalid_argument("invalid allocation size");
+            }
+            for (auto &list : central_lists_)
+            {
+                list.store(nullptr, memory_order_relaxed);
+            }
+        }
+
+        MemoryPoolHeadSC::~MemoryPoolHeadSC() noexcept
+        {
+            WriterLock lock(allocs_locker_.acquire_write());
+
+            // The items are trivially destructible, so only their storage needs to be released
+            for (MemoryPoolItem *items : item_blocks_)
+            {
+                ::operator delete(items);
+            }
+            item_blocks_.clear();
+
+            for (auto &alloc : allocs_)
+            {
+                // Do we need to clear the memory?
+                if (clear_on_destruction_)
+                {
+                    seal_memzero(alloc.data_ptr, mul_safe(item_byte_count_, alloc.size));
+                }
+
+                // Delete this allocation
+                SEAL_FREE(alloc.data_ptr);
+            }
+            allocs_.clear();
+        }
+
+        MemoryPoolItem *MemoryPoolHeadSC::get()
+        {
+            MemoryPoolSC::ThreadCache *cache = pool_.thread_cache();
+            MemoryPoolItem *item = nullptr;
+            if (cache)
+            {
+                auto &magazine = cache->magazines[size_class_];
+                if (!magazine.count)
+                {
+                    magazine.first = get_batch(magazine.count, cache->list_hint);
+                }
+                item = magazine.first;
+                magazine.first = item->next();
+                magazine.count--;
+                increment_owned(magazine.get_count);
+                if (!item->byte_count())
+                {
+                    increment_owned(magazine.fresh_count);
+                }
+            }
+            else
+            {
+                // Without a magazine the rest of the batch goes straight back to the central free lists
+                size_t count = 0;
+                item = get_batch(count, 0);
+                direct_get_count_.fetch_add(1, memory_order_relaxed);
+                if (!item->byte_count())
+                {
+                    direct_fresh_count_.fetch_add(1, memory_order_relaxed);
+                }
+                if (count > 1)
+                {
+                    MemoryPoolItem *last = item->next();
+                    while (last->next())
+                    {
+                        last = last->next();
+                    }
+                    add_batch(item->next(), last, count - 1, 0);
+                }
+            }
+
+            item->next() = nullptr;
+            item->byte_count() = item_byte_count_;
+            return item;
+        }
+
+        void MemoryPoolHeadSC::add(MemoryPoolItem *new_first) noexcept
+        {
+            // Items released by a thread that never allocated from the pool also go to a magazine of its own
+            MemoryPoolSC::ThreadCache *cache = nullptr;
+            try
+            {
+                cache = pool_.thread_cache();
+            }
+            catch (...)
+            {
+                // Creating the magazines failed, so return the item directly to the central free lists
+            }
+            if (!cache)
+            {
+                direct_add_count_.fetch_add(1, memory_order_relaxed);
+                add_batch(new_first, new_first, 1, 0);
+                return;
+            }
+
+            auto &magazine = cache->magazines[size_class_];
+            increment_owned(magazine.add_count);
+            new_first->next() = magazine.first;
+            magazine.first = new_first;
+            if (++magazine.count <= magazine_capacity_)
+            {
+                return;
+            }
+
+            // The magazine overflows, so keep the most recently added half and return the rest
+            size_t keep_count = magazine_capacity_ / 2;
+            MemoryPoolItem *last_kept = nullptr;
+            MemoryPoolItem *first = magazine.first;
+            for (size_t i = 0; i < keep_count; i++)
+            {
+                last_kept = first;
+                first = first->next();
+            }
+            if (last_kept)
+            {
+                last_kept->next() = nullptr;
+            }
+            else
+            {
+                magazine.first = nullptr;
+            }
+
+            MemoryPoolItem *last = first;
+            while (last->next())
+            {
+                last = last->next();
+            }
+            add_batch(first, last, magazine.count - keep_count, cache->list_hint);
+            magazine.count = keep_count;
+        }
+
+        size_t MemoryPoolHeadSC::free_unused(size_t byte_count)
+        {
+            WriterLock lock(allocs_locker_.acquire_write());
+            MemoryPoolItem *first_item = take_free_items();
+            size_t freed_item_count = 0;
+            try
+            {
+                vector<bool> selected = select_unused_allocs(allocs_, first_item, item_byte_count_, byte_count, false);
+                size_t kept_count = 0;
+                size_t freed_held_count = 0;
+                for (size_t i = 0; i < item_blocks_.size(); i++)
+                {
+                    if (selected[i])
+                    {
+                        ::operator delete(item_blocks_[i]);
+                        freed_held_count += allocs_[i].size - allocs_[i].free;
+                    }
+                    else
+                    {
+                        item_blocks_[kept_count++] = item_blocks_[i];
+                    }
+                }
+                item_blocks_.resize(kept_count);
+                freed_item_count =
+                    free_selected_allocs(allocs_, selected, item_byte_count_, clear_on_destruction_, false);
+                item_count_.fetch_sub(freed_item_count, memory_order_relaxed);
+                held_count_.fetch_sub(freed_held_count, memory_order_relaxed);
+            }
+            catch (...)
+            {
+                return_free_items(first_item);
+                throw;
+            }
+
+            return_free_items(first_item);
+            return freed_item_count * item_byte_count_;
+        }
+
+        void MemoryPoolHeadSC::discard_free() noexcept
+        {
+            if (item_byte_count_ < MemoryPool::discard_min_byte_count)
+            {
+                return;
+            }
+            MemoryPoolItem *first_item = take_free_items();
+            discard_free_items(first_item, item_byte_count_);
+            return_free_items(first_item);
+        }
+
+        MemoryPoolItem *MemoryPoolHeadSC::take_free_items() noexcept
+        {
+            MemoryPoolItem *first_item = nullptr;
+            size_t taken_count = 0;
+            for (auto &list : central_lists_)
+            {
+                MemoryPoolItem *taken = list.exchange(nullptr, memory_order_acquire);
+                while (taken)
+                {
+                    MemoryPoolItem *next = taken->next();
+                    taken->next() = first_item;
+                    first_item = taken;
+                    taken = next;
+                    taken_count++;
+                }
+            }
+            add_held_count(taken_count);
+
+            MemoryPoolSC::ThreadCache *cache = nullptr;
+            try
+            {
+                cache = pool_.thread_cache();
+            }
+            catch (...)
+            {
+                // Without magazines the calling thread holds no free items
+            }
+            if (cache)
+            {
+                auto &magazine = cache->magazines[size_class_];
+                while (magazine.first)
+                {
+                    MemoryPoolItem *next = magazine.first->next();
+                    magazine.first->next() = first_item;
+                    first_item = magazine.first;
+                    magazine.first = next;
+                }
+                magazine.count = 0;
+            }
+            return first_item;
+        }
+
+        void MemoryPoolHeadSC::return_free_items(MemoryPoolItem *first_item) noexcept
+        {
+            if (!first_item)
+            {
+                return;
+            }
+            size_t count = 1;
+            MemoryPoolItem *last = first_item;
+            while (last->next())
+            {
+                last = last->next();
+                count++;
+            }
+            add_batch(first_item, last, count, 0);
+        }
+
+        MemoryPoolItem *MemoryPoolHeadSC::take_batch(size_t &count, size_t list_hint) noexcept
+        {
+            // While in a central free list, the byte count of the first item of a batch is the number of items
+            for (size_t i = 0; i < central_list_count; i++)
+            {
+                auto &list = central_lists_[(list_hint + i) % central_list_count];
+                if (list.load(memory_order_relaxed))
+                {
+                    MemoryPoolItem *first = list.exchange(nullptr, memory_order_acquire);
+                    if (first)
+                    {
+                        count = first->byte_count();
+                        add_held_count(count);
+                        return first;
+                    }
+                }
+            }
+            return nullptr;
+        }
+
+        MemoryPoolItem *MemoryPoolHeadSC::get_batch(size_t &count, size_t list_hint)
+        {
+            MemoryPoolItem *first = take_batch(count, list_hint);
+            if (first)
+            {
+                return first;
+            }
+
+            // The central free lists are empty, so construct new items, allocating more memory if needed; a byte
+            // count of zero marks the items that were never in use
+            size_t batch_count = max<size_t>(magazine_capacity_ / 2, 1);
+            WriterLock lock(allocs_locker_.acquire_write());
+
+            // A concurrent free_unused empties the central free lists while it holds the lock, and returns the items
+            // it keeps before releasing it
+            first = take_batch(count, list_hint);
+            if (first)
+            {
+                return first;
+            }
+            if (allocs_.empty() || !allocs_.back().free)
+            {
+                // Increase allocation size unless we are already at max
+                size_t new_size = batch_count;
+                if (!allocs_.empty())
+                {
+                    new_size = max(
+                        new_size, safe_cast<size_t>(ceil(
+                                      MemoryPool::alloc_size_multiplier * static_cast<double>(allocs_.back().size))));
+                }
+                new_size = max<size_t>(min(new_size, MemoryPool::max_batch_alloc_byte_count / item_byte_count_), 1);
+
+                allocation new_alloc;
+                new_alloc.data_ptr = SEAL_MALLOC(mul_safe(new_size, item_byte_count_));
+                MemoryPoolItem *items = nullptr;
+                try
+                {
+                    items = static_cast<MemoryPoolItem *>(::operator new(mul_safe(new_size, sizeof(MemoryPoolItem))));
+                    item_blocks_.reserve(item_blocks_.size() + 1);
+                    allocs_.reserve(allocs_.size() + 1);
+                }
+                catch (...)
+                {
+                    ::operator delete(items);
+                    SEAL_FREE(new_alloc.data_ptr);
+                    throw;
+                }
+
+                new_alloc.size = new_size;
+                new_alloc.free = new_size;
+                new_alloc.head_ptr = new_alloc.data_ptr;
+                allocs_.push_back(new_alloc);
+                item_blocks_.push_back(items);
+                item_count_.fetch_add(new_size, memory_order_relaxed);
+            }
+
+            allocation &last_alloc = allocs_.back();
+            MemoryPoolItem *items = item_blocks_.back() + (last_alloc.size - last_alloc.free);
+            count = min(batch_count, last_alloc.free);
+            for (size_t i = 0; i < count; i++)
+            {
+                new (items + i) MemoryPoolItem(last_alloc.head_ptr, 0);
+                items[i].next() = (i + 1 < count) ? items + i + 1 : nullptr;
+                last_alloc.head_ptr += item_byte_count_;
+            }
+            last_alloc.free -= count;
+            add_held_count(count);
+            return items;
+        }
+
+        void MemoryPoolHeadSC::add_batch(
+            MemoryPoolItem *first, MemoryPoolItem *last, size_t count, size_t list_hint) noexcept
+        {
+            held_count_.fetch_sub(count, memory_order_relaxed);
+            last->next() = nullptr;
+            first->byte_count() = count;
+            while (true)
+            {
+                for (size_t i = 0; i < central_list_count; i++)
+                {
+                    MemoryPoolItem *expected = nullptr;
+                    if (central_lists_[(list_hint + i) % central_list_count].compare_exchange_strong(
+                            expected, first, memory_order_release, memory_order_relaxed))
+                    {
+                        return;
+                    }
+                }
+
+                // All central free lists are taken, so merge one of them into the batch and try again
+                MemoryPoolItem *taken = central_lists_[list_hint % central_list_count].exchange(
+                    nullptr, memory_order_acquire);
+                if (taken)
+                {
+                    last->next() = taken;
+                    first->byte_count() += taken->byte_count();
+                    while (last->next())
+                    {
+                        last = last->next();
+                    }
+                }
+            }
+        }
+
+        void MemoryPoolHeadSC::add_held_count(size_t count) noexcept
+        {
+            size_t held_count = held_count_.fetch_add(count, memory_order_relaxed) + count;
+            size_t peak_held_count = peak_held_count_.load(memory_order_relaxed);
+            while (held_count > peak_held_count &&
+                   !peak_held_count_.compare_exchange_weak(peak_held_count, held_count, memory_order_relaxed))
+            {
+            }
+        }
+
+        MemoryPoolHeadStats MemoryPoolHeadSC::stats() const
+        {
+            MemoryPoolHeadStats head_stats;
+            head_stats.item_byte_count = item_byte_count_;
+            head_stats.item_count = item_count_.load(memory_order_relaxed);
+            head_stats.peak_in_use_count = peak_held_count_.load(memory_order_relaxed);
+
+            uint64_t get_count = direct_get_count_.load(memory_order_relaxed);
+            uint64_t fresh_count = direct_fresh_count_.load(memory_order_relaxed);
+            uint64_t add_count = direct_add_count_.load(memory_order_relaxed);
+            {
+                ReaderLock lock(pool_.thread_caches_locker_.acquire_read());
+                for (const MemoryPoolSC::ThreadCache *cache : pool_.thread_caches_)
+                {
+                    auto &magazine = cache->magazines[size_class_];
+                    get_count += magazine.get_count.load(memory_order_relaxed);
+                    fresh_count += magazine.fresh_count.load(memory_order_relaxed);
+                    add_count += magazine.add_count.load(memory_order_relaxed);
+                }
+            }
+
+            // The counters of different threads are read at different times
+            fresh_count = min(fresh_count, get_count);
+            head_stats.fresh_count = fresh_count;
+            head_stats.reuse_count = get_count - fresh_count;
+            head_stats.in_use_count = get_count > add_count ? safe_cast<size_t>(get_count - add_count) : 0;
+            head_stats.peak_in_use_count = max(head_stats.peak_in_use_count, head_stats.in_use_count);
+            return head_stats;
+        }
+
+        MemoryPoolSC::MemoryPoolSC(bool clear_on_destruction)
+            : clear_on_destruction_(clear_on_destruction), id_(sc_next_id.fetch_add(1, memory_order_relaxed)),
+              head_count_(0)
+        {
+            for (auto &head : heads_)
+            {
+                head.store(nullptr, memory_order_relaxed);
+            }
+
+            auto &registry = sc_registry();
+            WriterLock lock(registry.locker.acquire_write());
+            registry.pools.emplace(id_, this);
+        }
+
+        MemoryPoolSC::~MemoryPoolSC() noexcept
+        {
+            // After this no exiting thread returns items to the pool
+            {
+                auto &registry = sc_registry();
+                WriterLock lock(registry.locker.acquire_write());
+                registry.pools.erase(id_);
+            }
+
+            // The magazines only refer to items owned by the heads
+            WriterLock lock(thread_caches_locker_.acquire_write());
+            for (ThreadCache *cache : thread_caches_)
+            {
+                delete cache;
+            }
+            thread_caches_.clear();
+            free_thread_caches_.clear();
+
+            for (auto &head : heads_)
+            {
+                delete head.exchange(nullptr, memory_order_acquire);
+            }
+        }
+
+        size_t MemoryPoolSC::size_class(size_t byte_count) noexcept
+        {
+            if (byte_count <= 64)
+            {
+                return (byte_count - 1) >> 3;
+            }
+
+            // The 3 bits below the leading bit of byte_count - 1 select one of 8 classes
+            int shift = get_significant_bit_count(static_cast<uint64_t>(byte_count - 1)) - 4;
+            return 8 + 8 * static_cast<size_t>(shift - 3) + (((byte_count - 1) >> shift) & 7);
+        }
+
+        size_t MemoryPoolSC::size_class_byte_count(size_t size_class) noexcept
+        {
+            if (size_class < 8)
+            {
+                return (size_class + 1) << 3;
+            }
+            return (9 + (size_class & 7)) << (3 + (size_class - 8) / 8);
+        }
+
+        Pointer<seal_byte> MemoryPoolSC::get_for_byte_count(size_t byte_count)
+        {
+            if (byte_count > max_single_alloc_byte_count)
+            {
+                throw invalid_argument("invalid allocation size");
+            }
+            else if (byte_count == 0)
+            {
+                return Pointer<seal_byte>();
+            }
+            trace_allocation(byte_count);
+
+            size_t index = size_class(byte_count);
+            MemoryPoolHeadSC *head = heads_[index].load(memory_order_acquire);
+            if (!head)
+            {
+                // Another thread may create the same head concurrently, in which case ours is discarded
+                auto new_head = make_unique<MemoryPoolHeadSC>(*this, index, clear_on_destruction_);
+                if (heads_[index].compare_exchange_strong(head, new_head.get(), memory_order_acq_rel))
+                {
+                    head = new_head.release();
+                    head_count_.fetch_add(1, memory_order_relaxed);
+                }
+            }
+
+            MemoryPoolItem *item = head->get();
+            item->byte_count() = byte_count;
+            return Pointer<seal_byte>(head, item);
+        }
+
+        size_t MemoryPoolSC::alloc_byte_count() const
+        {
+            size_t byte_count = 0;
+            for (auto &head : heads_)
+            {
+                MemoryPoolHeadSC *curr_head = head.load(memory_order_acquire);
+                if (curr_head)
+                {
+                    byte_count = add_safe(byte_count, mul_safe(curr_head->item_count(), curr_head->item_byte_count()));
+                }
+            }
+            return byte_count;
+        }
+
+        vector<MemoryPoolHeadStats> MemoryPoolSC::stats() const
+        {
+            vector<MemoryPoolHeadStats> pool_stats;
+            for (auto &head : heads_)
+            {
+                MemoryPoolHeadSC *curr_head = head.load(memory_order_acquire);
+                if (curr_head)
+                {
+                    pool_stats.push_back(curr_head->stats());
+                }
+            }
+            return pool_stats;
+        }
+
+        size_t MemoryPoolSC::trim(size_t target_byte_count)
+        {
+            // Largest size classes first
+            vector<MemoryPoolHeadSC *> heads;
+            for (size_t index = size_class_count; index-- > 0;)
+            {
+                heads.push_back(heads_[index].load(memory_order_acquire));
+            }
+            return trim_heads(heads.begin(), heads.end(), alloc_byte_count(), target_byte_count);
+        }
+
+        MemoryPoolSC::ThreadCache *MemoryPoolSC::thread_cache()
+        {
+            if (sc_thread_exiting)
+            {
+                return nullptr;
+            }
+
+            thread_local ThreadCacheTable table;
+            ThreadCache *cache = table.find(id_);
+            if (cache)
+            {
+                return cache;
+            }
+
+            // Reuse the cache of an exited thread if there is one
+            {
+                WriterLock lock(thread_caches_locker_.acquire_write());
+                if (!free_thread_caches_.empty())
+                {
+                    cache = free_thread_caches_.back();
+                    free_thread_caches_.pop_back();
+                }
+                else
+                {
+                    auto new_cache = make_unique<ThreadCache>();
+                    new_cache->list_hint = thread_caches_.size();
+                    thread_caches_.reserve(thread_caches_.size() + 1);
+                    free_thread_caches_.reserve(thread_caches_.size() + 1);
+                    thread_caches_.push_back(new_cache.release());
+                    cache = thread_caches_.back();
+                }
+            }
+
+            try
+            {
+                table.insert(id_, cache);
+            }
+            catch (...)
+            {
+                WriterLock lock(thread_caches_locker_.acquire_write());
+                free_thread_caches_.push_back(cache);
+                throw;
+            }
+            return cache;
+        }
+
+        void MemoryPoolSC::release_thread_cache(ThreadCache *cache) noexcept
+        {
+            for (size_t index = 0; index < size_class_count; index++)
+            {
+                auto &magazine = cache->magazines[index];
+                if (magazine.count)
+                {
+                    MemoryPoolItem *last = magazine.first;
+                    while (last->next())
+                    {
+                        last = last->next();
+                    }
+                    heads_[index].load(memory_order_acquire)->add_batch(
+                        magazine.first, last, magazine.count, cache->list_hint);
+                    magazine.first = nullptr;
+                    magazine.count = 0;
+                }
+            }
+
+            // Capacity for this was reserved when the cache was created
+            WriterLock lock(thread_caches_locker_.acquire_write());
+            free_thread_caches_.push_back(cache);
+        }
+
+        /*
+        Head of the region of MemoryPoolArena. Each allocation takes MemoryPoolArena::alignment bytes for its item,
+        which is constructed right before the data, and the byte count rounded up to MemoryPoolArena::alignment.
+        */
+        class MemoryPoolArena::Region : public MemoryPoolHead
+        {
+        public:
+            Region(size_t capacity, bool clear_on_destruction)
+                : clear_on_destruction_(clear_on_destruction), capacity_(round_capacity(capacity)), offset_(0),
+                  peak_offset_(0), total_byte_count_(0), in_use_count_(0)
+            {
+                static_assert(sizeof(MemoryPoolItem) <= alignment, "MemoryPoolItem does not fit the alignment");
+
+                // The allocation is aligned only if its size is a multiple of 64 bytes
+                data_ = SEAL_MALLOC(capacity_ + alignment);
+                uintptr_t address = reinterpret_cast<uintptr_t>(data_);
+                base_ = data_ + ((alignment - address % alignment) % alignment);
+            }
+
+            ~Region() noexcept override
+            {
+                if (clear_on_destruction_)
+                {
+                    seal_memzero(base_, peak_offset_.load(memory_order_relaxed));
+                }
+                SEAL_FREE(data_);
+            }
+
+            SEAL_NODISCARD inline size_t item_byte_count() const noexcept override
+            {
+                return 1;
+            }
+
+            SEAL_NODISCARD inline size_t item_count() const noexcept override
+            {
+                return capacity_;
+            }
+
+            SEAL_NODISCARD MemoryPoolItem *get() override
+            {
+                throw logic_error("region items are only allocated by byte count");
+            }
+
+            inline void add(MemoryPoolItem *) noexcept override
+            {
+                in_use_count_.fetch_sub(1, memory_order_release);
+            }
+
+            size_t free_unused(size_t) override
+            {
+                return 0;
+            }
+
+            void discard_free() noexcept override
+            {}
+
+            SEAL_NODISCARD MemoryPoolHeadStats stats() const override
+            {
+                MemoryPoolHeadStats head_stats;
+                head_stats.item_byte_count = 1;
+                head_stats.item_count = capacity_;
+                head_stats.in_use_count = offset_.load(memory_order_relaxed);
+                head_stats.peak_in_use_count = peak_offset_.load(memory_order_relaxed);
+
+                // Every byte below the peak offset was new when it was first used
+                head_stats.fresh_count = head_stats.peak_in_use_count;
+                head_stats.reuse_count = total_byte_count_.load(memory_order_relaxed) - head_stats.fresh_count;
+                return head_stats;
+            }
+
+            SEAL_NODISCARD inline size_t used_byte_count() const noexcept
+            {
+                return offset_.load(memory_order_relaxed);
+            }
+
+            // Returns a new item, or nullptr if the rest of the region is too small
+            SEAL_NODISCARD MemoryPoolItem *allocate(size_t byte_count) noexcept
+            {
+                if (byte_count > capacity_ - alignment)
+                {
+                    return nullptr;
+                }
+                size_t item_byte_count = alignment + (byte_count + alignment - 1) / alignment * alignment;
+                size_t offset = offset_.load(memory_order_relaxed);
+                do
+                {
+                    if (capacity_ - offset < item_byte_count)
+                    {
+                        return nullptr;
+                    }
+                } while (!offset_.compare_exchange_weak(offset, offset + item_byte_count, memory_order_relaxed));
+
+                in_use_count_.fetch_add(1, memory_order_relaxed);
+                total_byte_count_.fetch_add(item_byte_count, memory_order_relaxed);
+                size_t peak_offset = peak_offset_.load(memory_order_relaxed);
+                while (offset + item_byte_count > peak_offset &&
+                       !peak_offset_.compare_exchange_weak(
+                           peak_offset, offset + item_byte_count, memory_order_relaxed))
+                {
+                }
+
+                seal_byte *data = base_ + offset + alignment;
+                return new (data - sizeof(MemoryPoolItem)) MemoryPoolItem(data, byte_count);
+            }
+
+            bool reset() noexcept
+            {
+                if (in_use_count_.load(memory_order_acquire))
+                {
+                    return false;
+                }
+                if (clear_on_destruction_)
+                {
+                    seal_memzero(base_, offset_.load(memory_order_relaxed));
+                }
+                offset_.store(0, memory_order_relaxed);
+                return true;
+            }
+
+        private:
+            Region(const Region &copy) = delete;
+
+            // Rounds capacity up to a multiple of the alignment, leaving room to align the allocation of the region
+            SEAL_NODISCARD static size_t round_capacity(size_t capacity)
+            {
+                if (!capacity || capacity > MemoryPool::max_batch_alloc_byte_count - 2 * alignment)
+                {
+                    throw invalid_argument("invalid allocation size");
+                }
+                return (capacity + alignment - 1) / alignment * alignment;
+            }
+
+            Region &operator=(const Region &assign) = delete;
+
+            const bool clear_on_destruction_;
+
+            const size_t capacity_;
+
+            seal_byte *data_ = nullptr;
+
+            // First aligned byte of data_
+            seal_byte *base_ = nullptr;
+
+            atomic<size_t> offset_;
+
+            atomic<size_t> peak_offset_;
+
+            // Number of bytes taken by all allocations since the region was created
+            atomic<uint64_t> total_byte_count_;
+
+            atomic<size_t> in_use_count_;
+        };
+
+        MemoryPoolArena::MemoryPoolArena(size_t capacity, bool clear_on_destruction)
+            : region_(make_unique<Region>(capacity, clear_on_destruction)), overflow_(clear_on_destruction)
+        {}
+
+        MemoryPoolArena::~MemoryPoolArena() noexcept = default;
+
+        Pointer<seal_byte> MemoryPoolArena::get_for_byte_count(size_t byte_count)
+        {
+            if (byte_count > max_single_alloc_byte_count)
+            {
+                throw invalid_argument("invalid allocation size");
+            }
+            else if (byte_count == 0)
+            {
+                return Pointer<seal_byte>();
+            }
+            trace_allocation(byte_count);
+
+            MemoryPoolItem *item = region_->allocate(byte_count);
+            if (item)
+            {
+                return Pointer<seal_byte>(region_.get(), item);
+            }
+            return overflow_.get_for_byte_count(byte_count);
+        }
+
+        size_t MemoryPoolArena::pool_count() const
+        {
+            return overflow_.pool_count() + 1;
+        }
+
+        size_t MemoryPoolArena::alloc_byte_count() const
+        {
+            return add_safe(region_->item_count(), overflow_.alloc_byte_count());
+        }
+
+        size_t MemoryPoolArena::trim(size_t target_byte_count)
+        {
+            size_t capacity = region_->item_count();
+            return overflow_.trim(target_byte_count > capacity ? target_byte_count - capacity : 0);
+        }
+
+        vector<MemoryPoolHeadStats> MemoryPoolArena::stats() const
+        {
+            vector<MemoryPoolHeadStats> pool_stats = overflow_.stats();
+            pool_stats.insert(pool_stats.begin(), region_->stats());
+            return pool_stats;
+        }
+
+        size_t MemoryPoolArena::capacity() const noexcept
+        {
+            return region_->item_count();
+        }
+
+        size_t MemoryPoolArena::used_byte_count() const noexcept
+        {
+            return region_->used_byte_count();
+        }
+
+        bool MemoryPoolArena::reset() noexcept
+        {
+            return region_->reset();
+        }
     } // namespace util
 } // namespace seal
@@ -34,7 +34,7 @@ namespace seal
         class MemoryPoolItem
         {
         public:
-            MemoryPoolItem(seal_byte *data) noexcept : data_(data)
+            MemoryPoolItem(seal_byte *data, std::size_t byte_count) noexcept : data_(data), byte_count_(byte_count)
             {}
 
             SEAL_NODISCARD inline seal_byte *data() noexcept
@@ -47,6 +47,17 @@ namespace seal
                 return data_;
             }
 
+            // Number of bytes requested for the item, which is at most the item_byte_count of its head
+            SEAL_NODISCARD inline std::size_t &byte_count() noexcept
+            {
+                return byte_count_;
+            }
+
+            SEAL_NODISCARD inline std::size_t byte_count() const noexcept
+            {
+                return byte_count_;
+            }
+
             SEAL_NODISCARD inline MemoryPoolItem *&next() noexcept
             {
                 return next_;
@@ -64,9 +75,70 @@ namespace seal
 
             seal_byte *data_ = nullptr;
 
+            std::size_t byte_count_ = 0;
+
             MemoryPoolItem *next_ = nullptr;
         };
 
+        // Allocation counters of the items of one byte size
+        struct MemoryPoolHeadStats
+        {
+            // Byte size of the items
+            std::size_t item_byte_count = 0;
+
+            // Number of items allocated
+            std::size_t item_count = 0;
+
+            // Number of allocations served by items that were in use before
+            std::uint64_t reuse_count = 0;
+
+            // Number of allocations served by items that were never in use before
+            std::uint64_t fresh_count = 0;
+
+            // Number of items in use
+            std::size_t in_use_count = 0;
+
+            // Largest number of items in use at the same time
+            std::size_t peak_in_use_count = 0;
+        };
+
+        // A sampled allocation of a memory pool
+        struct MemoryPoolTraceEntry
+        {
+            // Index of the allocation among all allocations since tracing was enabled
+            std::uint64_t allocation_index = 0;
+
+            // Number of bytes requested
+            std::size_t byte_count = 0;
+
+            // Name of the library function the allocation was made for, or nullptr if unknown
+            const char *function = nullptr;
+        };
+
+        /*
+        Names the library function that the calling thread makes allocations for while the object is alive, which
+        memory pool traces record with each sampled allocation. Nested scopes keep the name of the outermost one, so
+        that allocations are attributed to the function called by the application. The name must be a string with
+        static storage duration.
+        */
+        class AllocationScope
+        {
+        public:
+            AllocationScope(const char *function) noexcept;
+
+            ~AllocationScope() noexcept;
+
+            // Returns the name of the outermost scope of the calling thread, or nullptr if there is none
+            SEAL_NODISCARD static const char *current() noexcept;
+
+        private:
+            AllocationScope(const AllocationScope &copy) = delete;
+
+            AllocationScope &operator=(const AllocationScope &assign) = delete;
+
+            bool outermost_;
+        };
+
         class MemoryPoolHead
         {
         public:
@@ -101,13 +173,24 @@ namespace seal
 
             // Return item back to this pool
             virtual void add(MemoryPoolItem *new_first) noexcept = 0;
+
+            // Frees allocations with no items in use, largest first, until at least byte_count bytes are freed or
+            // no such allocations are left; returns the number of bytes freed
+            virtual std::size_t free_unused(std::size_t byte_count) = 0;
+
+            // Returns the pages of free items of at least MemoryPool::discard_min_byte_count bytes to the operating
+            // system; their address space stays allocated and the pages are reallocated as zeros on first access
+            virtual void discard_free() noexcept = 0;
+
+            // Returns the allocation counters of the items
+            SEAL_NODISCARD virtual MemoryPoolHeadStats stats() const = 0;
         };
 
         class MemoryPoolHeadMT : public MemoryPoolHead
         {
         public:
             // Creates a new MemoryPoolHeadMT with allocation for one single item.
-            MemoryPoolHeadMT(std::size_t item_byte_count, bool clear_on_destruction = false);
+            MemoryPoolHeadMT(std::size_t item_byte_count, bool clear_on_destruction = false, bool huge_pages = false);
 
             ~MemoryPoolHeadMT() noexcept override;
 
@@ -135,9 +218,16 @@ namespace seal
                 MemoryPoolItem *old_first = first_item_;
                 new_first->next() = old_first;
                 first_item_ = new_first;
+                in_use_count_--;
                 locked_.store(false, std::memory_order_release);
             }
 
+            std::size_t free_unused(std::size_t byte_count) override;
+
+            void discard_free() noexcept override;
+
+            SEAL_NODISCARD MemoryPoolHeadStats stats() const override;
+
         private:
             MemoryPoolHeadMT(const MemoryPoolHeadMT &copy) = delete;
 
@@ -145,6 +235,8 @@ namespace seal
 
             const bool clear_on_destruction_;
 
+            const bool huge_pages_;
+
             mutable std::atomic<bool> locked_;
 
             const std::size_t item_byte_count_;
@@ -154,13 +246,21 @@ namespace seal
             std::vector<allocation> allocs_;
 
             MemoryPoolItem *volatile first_item_;
+
+            std::uint64_t reuse_count_ = 0;
+
+            std::uint64_t fresh_count_ = 0;
+
+            std::size_t in_use_count_ = 0;
+
+            std::size_t peak_in_use_count_ = 0;
         };
 
         class MemoryPoolHeadST : public MemoryPoolHead
         {
         public:
             // Creates a new MemoryPoolHeadST with allocation for one single item.
-            MemoryPoolHeadST(std::size_t item_byte_count, bool clear_on_destruction = false);
+            MemoryPoolHeadST(std::size_t item_byte_count, bool clear_on_destruction = false, bool huge_pages = false);
 
             ~MemoryPoolHeadST() noexcept override;
 
@@ -182,8 +282,15 @@ namespace seal
             {
                 new_first->next() = first_item_;
                 first_item_ = new_first;
+                in_use_count_--;
             }
 
+            std::size_t free_unused(std::size_t byte_count) override;
+
+            void discard_free() noexcept override;
+
+            SEAL_NODISCARD MemoryPoolHeadStats stats() const override;
+
         private:
             MemoryPoolHeadST(const MemoryPoolHeadST &copy) = delete;
 
@@ -191,6 +298,8 @@ namespace seal
 
             const bool clear_on_destruction_;
 
+            const bool huge_pages_;
+
             std::size_t item_byte_count_;
 
             std::size_t item_count_;
@@ -198,6 +307,14 @@ namespace seal
             std::vector<allocation> allocs_;
 
             MemoryPoolItem *first_item_;
+
+            std::uint64_t reuse_count_ = 0;
+
+            std::uint64_t fresh_count_ = 0;
+
+            std::size_t in_use_count_ = 0;
+
+            std::size_t peak_in_use_count_ = 0;
         };
 
         class MemoryPool
@@ -216,6 +333,18 @@ namespace seal
 
             static constexpr std::size_t first_alloc_count = 1;
 
+            // Smallest free items whose pages trim returns to the operating system
+            static constexpr std::size_t discard_min_byte_count = std::size_t(1) << 16;
+
+            // Smallest allocations that memory pools using huge pages map from transparent huge pages, to whose size
+            // the mappings are aligned
+            static constexpr std::size_t huge_page_byte_count = std::size_t(1) << 21;
+
+            // Largest number of entries an allocation trace can hold
+            static constexpr std::size_t max_trace_capacity = std::size_t(1) << 20;
+
+            MemoryPool() = default;
+
             virtual ~MemoryPool() = default;
 
             virtual Pointer<seal_byte> get_for_byte_count(std::size_t byte_count) = 0;
@@ -223,12 +352,60 @@ namespace seal
             virtual std::size_t pool_count() const = 0;
 
             virtual std::size_t alloc_byte_count() const = 0;
+
+            // Frees allocations with no items in use until alloc_byte_count is at most target_byte_count, and if that
+            // is not enough, discards the pages of large free items; returns the number of bytes freed
+            virtual std::size_t trim(std::size_t target_byte_count) = 0;
+
+            // Whether allocations may be requested concurrently from several threads
+            virtual bool is_thread_safe() const noexcept = 0;
+
+            // Returns the allocation counters of each item byte size, in increasing order of item byte size
+            SEAL_NODISCARD virtual std::vector<MemoryPoolHeadStats> stats() const = 0;
+
+            // Starts recording every sample_period-th allocation in a trace holding the capacity most recent ones,
+            // discarding the previous trace; a sample_period of zero stops tracing
+            void set_trace(std::uint64_t sample_period, std::size_t capacity);
+
+            // Returns the entries of the trace, oldest first
+            SEAL_NODISCARD std::vector<MemoryPoolTraceEntry> trace() const;
+
+        protected:
+            // Called by get_for_byte_count for each allocation
+            inline void trace_allocation(std::size_t byte_count)
+            {
+                if (trace_sample_period_.load(std::memory_order_relaxed))
+                {
+                    record_allocation(byte_count);
+                }
+            }
+
+        private:
+            MemoryPool(const MemoryPool &copy) = delete;
+
+            MemoryPool &operator=(const MemoryPool &assign) = delete;
+
+            void record_allocation(std::size_t byte_count);
+
+            std::atomic<std::uint64_t> trace_sample_period_{ 0 };
+
+            std::atomic<std::uint64_t> trace_allocation_count_{ 0 };
+
+            mutable ReaderWriterLocker trace_locker_;
+
+            std::size_t trace_capacity_ = 0;
+
+            // Ring buffer of the trace entries; trace_next_ is the position of the oldest once it is full
+            std::vector<MemoryPoolTraceEntry> trace_entries_;
+
+            std::size_t trace_next_ = 0;
         };
 
         class MemoryPoolMT : public MemoryPool
         {
         public:
-            MemoryPoolMT(bool clear_on_destruction = false) : clear_on_destruction_(clear_on_destruction){};
+            MemoryPoolMT(bool clear_on_destruction = false, bool huge_pages = false)
+                : clear_on_destruction_(clear_on_destruction), huge_pages_(huge_pages){};
 
             ~MemoryPoolMT() noexcept override;
 
@@ -242,6 +419,21 @@ namespace seal
 
             SEAL_NODISCARD std::size_t alloc_byte_count() const override;
 
+            std::size_t trim(std::size_t target_byte_count) override;
+
+            SEAL_NODISCARD inline bool is_thread_safe() const noexcept override
+            {
+                return true;
+            }
+
+            SEAL_NODISCARD std::vector<MemoryPoolHeadStats> stats() const override;
+
+            // Whether allocations of at least huge_page_byte_count bytes are requested to use huge pages
+            SEAL_NODISCARD inline bool huge_pages() const noexcept
+            {
+                return huge_pages_;
+            }
+
         protected:
             MemoryPoolMT(const MemoryPoolMT &copy) = delete;
 
@@ -249,6 +441,8 @@ namespace seal
 
             const bool clear_on_destruction_;
 
+            const bool huge_pages_;
+
             mutable ReaderWriterLocker pools_locker_;
 
             std::vector<MemoryPoolHead *> pools_;
@@ -257,7 +451,8 @@ namespace seal
         class MemoryPoolST : public MemoryPool
         {
         public:
-            MemoryPoolST(bool clear_on_destruction = false) : clear_on_destruction_(clear_on_destruction){};
+            MemoryPoolST(bool clear_on_destruction = false, bool huge_pages = false)
+                : clear_on_destruction_(clear_on_destruction), huge_pages_(huge_pages){};
 
             ~MemoryPoolST() noexcept override;
 
@@ -270,6 +465,21 @@ namespace seal
 
             std::size_t alloc_byte_count() const override;
 
+            std::size_t trim(std::size_t target_byte_count) override;
+
+            SEAL_NODISCARD inline bool is_thread_safe() const noexcept override
+            {
+                return false;
+            }
+
+            SEAL_NODISCARD std::vector<MemoryPoolHeadStats> stats() const override;
+
+            // Whether allocations of at least huge_page_byte_count bytes are requested to use huge pages
+            SEAL_NODISCARD inline bool huge_pages() const noexcept
+            {
+                return huge_pages_;
+            }
+
         protected:
             MemoryPoolST(const MemoryPoolST &copy) = delete;
 
@@ -277,7 +487,265 @@ namespace seal
 
             const bool clear_on_destruction_;
 
+            const bool huge_pages_;
+
             std::vector<MemoryPoolHead *> pools_;
         };
+
+        class MemoryPoolSC;
+
+        /*
+        Head of MemoryPoolSC serving all allocations that round up to the same size class. Free items live in the
+        magazines of the threads that released them, and in a few central free lists that the magazines exchange
+        whole batches of items with. The central free lists are lock-free: a batch is pushed into an empty list with
+        compare-and-swap and popped by exchanging the list with null, so that no thread ever reads the links of a
+        batch it does not own. Only allocating fresh memory takes a lock.
+        */
+        class MemoryPoolHeadSC : public MemoryPoolHead
+        {
+        public:
+            // Creates a new MemoryPoolHeadSC without any allocations.
+            MemoryPoolHeadSC(MemoryPoolSC &pool, std::size_t size_class, bool clear_on_destruction = false);
+
+            ~MemoryPoolHeadSC() noexcept override;
+
+            // Byte size of the allocations (items) owned by this pool
+            SEAL_NODISCARD inline std::size_t item_byte_count() const noexcept override
+            {
+                return item_byte_count_;
+            }
+
+            // Returns the total number of items allocated
+            SEAL_NODISCARD inline std::size_t item_count() const noexcept override
+            {
+                return item_count_.load(std::memory_order_relaxed);
+            }
+
+            // Size class of the items
+            SEAL_NODISCARD inline std::size_t size_class() const noexcept
+            {
+                return size_class_;
+            }
+
+            // Number of items above which a magazine returns items to the central free lists
+            SEAL_NODISCARD inline std::size_t magazine_capacity() const noexcept
+            {
+                return magazine_capacity_;
+            }
+
+            SEAL_NODISCARD MemoryPoolItem *get() override;
+
+            void add(MemoryPoolItem *new_first) noexcept override;
+
+            // Only items in the central free lists and in the magazine of the calling thread count as unused
+            std::size_t free_unused(std::size_t byte_count) override;
+
+            void discard_free() noexcept override;
+
+            SEAL_NODISCARD MemoryPoolHeadStats stats() const override;
+
+            // Removes a batch of items from the central free lists, or allocates new items if the lists are empty;
+            // returns the first item of the batch and stores the number of items in count
+            SEAL_NODISCARD MemoryPoolItem *get_batch(std::size_t &count, std::size_t list_hint);
+
+            // Adds the batch of count items linked from first to last to the central free lists
+            void add_batch(
+                MemoryPoolItem *first, MemoryPoolItem *last, std::size_t count, std::size_t list_hint) noexcept;
+
+            // Number of central free lists
+            static constexpr std::size_t central_list_count = 8;
+
+            // Magazines of large items hold about this many bytes
+            static constexpr std::size_t magazine_byte_count = std::size_t(1) << 18;
+
+            // Largest number of items held by a magazine
+            static constexpr std::size_t max_magazine_capacity = 32;
+
+        private:
+            MemoryPoolHeadSC(const MemoryPoolHeadSC &copy) = delete;
+
+            MemoryPoolHeadSC &operator=(const MemoryPoolHeadSC &assign) = delete;
+
+            // Removes all items from the central free lists and the magazine of the calling thread
+            SEAL_NODISCARD MemoryPoolItem *take_free_items() noexcept;
+
+            // Removes a batch of items from the central free lists, or returns nullptr if they are empty
+            SEAL_NODISCARD MemoryPoolItem *take_batch(std::size_t &count, std::size_t list_hint) noexcept;
+
+            // Adds the items linked from first_item to the central free lists
+            void return_free_items(MemoryPoolItem *first_item) noexcept;
+
+            // Counts items that left the central free lists
+            void add_held_count(std::size_t count) noexcept;
+
+            MemoryPoolSC &pool_;
+
+            const bool clear_on_destruction_;
+
+            const std::size_t size_class_;
+
+            const std::size_t item_byte_count_;
+
+            const std::size_t magazine_capacity_;
+
+            std::atomic<std::size_t> item_count_;
+
+            std::atomic<MemoryPoolItem *> central_lists_[central_list_count];
+
+            // Items outside the central free lists, which are in use or in magazines
+            std::atomic<std::size_t> held_count_;
+
+            std::atomic<std::size_t> peak_held_count_;
+
+            // Counters of the items got and added without a magazine
+            std::atomic<std::uint64_t> direct_get_count_;
+
+            std::atomic<std::uint64_t> direct_fresh_count_;
+
+            std::atomic<std::uint64_t> direct_add_count_;
+
+            ReaderWriterLocker allocs_locker_;
+
+            std::vector<allocation> allocs_;
+
+            // The items of each allocation are constructed in a block of their own
+            std::vector<MemoryPoolItem *> item_blocks_;
+        };
+
+        /*
+        Thread-safe memory pool that rounds allocation sizes up to size classes: 8 multiples of 8 bytes up to 64
+        bytes, and then 8 classes between consecutive powers of two, so that at most 1/8 of an item goes unused. The
+        heads of the size classes are found by index without locking, and each thread gets and adds items through its
+        own magazine of free items for each size class, which touches no shared state until the magazine runs empty
+        or overflows. A thread that exits returns the items of its magazines to the central free lists.
+        */
+        class MemoryPoolSC : public MemoryPool
+        {
+            friend class MemoryPoolHeadSC;
+
+        public:
+            // Number of size classes needed to cover max_single_alloc_byte_count
+            static constexpr std::size_t size_class_count =
+                8 * (sizeof(std::size_t) * static_cast<std::size_t>(bits_per_byte) - 6);
+
+            MemoryPoolSC(bool clear_on_destruction = false);
+
+            ~MemoryPoolSC() noexcept override;
+
+            SEAL_NODISCARD Pointer<seal_byte> get_for_byte_count(std::size_t byte_count) override;
+
+            SEAL_NODISCARD inline std::size_t pool_count() const override
+            {
+                return head_count_.load(std::memory_order_relaxed);
+            }
+
+            SEAL_NODISCARD std::size_t alloc_byte_count() const override;
+
+            // Free items in the magazines of threads other than the calling one count as in use
+            std::size_t trim(std::size_t target_byte_count) override;
+
+            SEAL_NODISCARD inline bool is_thread_safe() const noexcept override
+            {
+                return true;
+            }
+
+            // Items cached in the magazines of threads count as in use for peak_in_use_count, and the other counts
+            // are approximate while other threads use the pool
+            SEAL_NODISCARD std::vector<MemoryPoolHeadStats> stats() const override;
+
+            // Returns the size class of a non-zero byte count
+            SEAL_NODISCARD static std::size_t size_class(std::size_t byte_count) noexcept;
+
+            // Returns the item byte count of a size class
+            SEAL_NODISCARD static std::size_t size_class_byte_count(std::size_t size_class) noexcept;
+
+        private:
+            MemoryPoolSC(const MemoryPoolSC &copy) = delete;
+
+            MemoryPoolSC &operator=(const MemoryPoolSC &assign) = delete;
+
+            struct ThreadCache;
+
+            class ThreadCacheTable;
+
+            // Returns the magazines of the calling thread, creating them on first use, or nullptr if the thread is
+            // exiting
+            SEAL_NODISCARD ThreadCache *thread_cache();
+
+            // Returns the items of a thread cache to the central free lists and makes it available to other threads
+            void release_thread_cache(ThreadCache *cache) noexcept;
+
+            const bool clear_on_destruction_;
+
+            // Identifies the pool in the thread cache tables; never reused
+            const std::uint64_t id_;
+
+            std::atomic<std::size_t> head_count_;
+
+            std::atomic<MemoryPoolHeadSC *> heads_[size_class_count];
+
+            ReaderWriterLocker thread_caches_locker_;
+
+            std::vector<ThreadCache *> thread_caches_;
+
+            std::vector<ThreadCache *> free_thread_caches_;
+        };
+
+        /*
+        Thread-safe memory pool that serves allocations from a single region reserved up front. An allocation only
+        advances an offset into the region, and releasing an allocation only counts it as no longer in use, so that
+        neither takes a lock or searches for memory. Memory released in the region is not reused until reset makes
+        the whole region available again, once no allocation from it is in use. Allocations that do not fit in the
+        rest of the region are served by an overflow memory pool.
+        */
+        class MemoryPoolArena : public MemoryPool
+        {
+        public:
+            // Alignment of the allocations in the region, each of which also takes this many bytes for bookkeeping
+            static constexpr std::size_t alignment = 64;
+
+            MemoryPoolArena(std::size_t capacity, bool clear_on_destruction = false);
+
+            ~MemoryPoolArena() noexcept override;
+
+            SEAL_NODISCARD Pointer<seal_byte> get_for_byte_count(std::size_t byte_count) override;
+
+            // The region counts as one allocation size
+            SEAL_NODISCARD std::size_t pool_count() const override;
+
+            SEAL_NODISCARD std::size_t alloc_byte_count() const override;
+
+            // Only trims the overflow memory pool
+            std::size_t trim(std::size_t target_byte_count) override;
+
+            SEAL_NODISCARD inline bool is_thread_safe() const noexcept override
+            {
+                return true;
+            }
+
+            // The region comes first, as items of one byte of which the bytes used since the last reset are in use
+            SEAL_NODISCARD std::vector<MemoryPoolHeadStats> stats() const override;
+
+            // Number of bytes in the region
+            SEAL_NODISCARD std::size_t capacity() const noexcept;
+
+            // Number of bytes of the region used since the last reset
+            SEAL_NODISCARD std::size_t used_byte_count() const noexcept;
+
+            // Makes the whole region available again if no allocation from it is in use, and returns whether it did;
+            // must not be called concurrently with allocations from the pool
+            bool reset() noexcept;
+
+        private:
+            MemoryPoolArena(const MemoryPoolArena &copy) = delete;
+
+            MemoryPoolArena &operator=(const MemoryPoolArena &assign) = delete;
+
+            class Region;
+
+            std::unique_ptr<Region> region_;
+
+            MemoryPoolMT overflow_;
+        };
     } // namespace util
 } // namespace seal
@@ -1,10 +1,13 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT license.
 
+#include "seal/util/cpufeatures.h"
 #include "seal/util/ntt.h"
+#include "seal/util/nttavx.h"
 #include "seal/util/uintarith.h"
 #include "seal/util/uintarithsmallmod.h"
 #include <algorithm>
+#include <atomic>
 #ifdef SEAL_USE_INTEL_HEXL
 #include "seal/memorymanager.h"
 #include "seal/util/iterator.h"
@@ -226,6 +229,210 @@ namespace seal
 {
     namespace util
     {
+        namespace
+        {
+            ntt_kernel_type fastest_ntt_kernel() noexcept
+            {
+                for (auto kernel : { ntt_kernel_type::avx512ifma, ntt_kernel_type::avx512, ntt_kernel_type::avx2 })
+                {
+                    if (ntt_kernel_supported(kernel))
+                    {
+                        return kernel;
+                    }
+                }
+                return ntt_kernel_type::scalar;
+            }
+
+            atomic<ntt_kernel_type> &ntt_kernel() noexcept
+            {
+                static atomic<ntt_kernel_type> kernel(fastest_ntt_kernel());
+                return kernel;
+            }
+
+#ifndef SEAL_USE_INTEL_HEXL
+            // The vectorized kernels view the tables as (operand, quotient) pairs of 64-bit words
+            static_assert(
+                sizeof(MultiplyUIntModOperand) == 2 * sizeof(uint64_t), "MultiplyUIntModOperand must be two words");
+
+            // The vectorized kernels require at least 16 coefficients
+            constexpr int ntt_kernel_coeff_count_power_min = 4;
+
+#ifdef SEAL_USE_AVX512_NTT
+            // The IFMA kernels require inputs less than 2^52, i.e., moduli less than 2^50
+            constexpr uint64_t ntt_kernel_ifma_modulus_bound = uint64_t(1) << 50;
+#endif
+
+            // Runs the selected vectorized forward kernel; returns false if the scalar implementation must be used
+            bool ntt_negacyclic_harvey_lazy_vectorized(SEAL_MAYBE_UNUSED CoeffIter operand, const NTTTables &tables)
+            {
+                if (tables.coeff_count_power() < ntt_kernel_coeff_count_power_min)
+                {
+                    return false;
+                }
+                SEAL_MAYBE_UNUSED uint64_t modulus = tables.modulus().value();
+                SEAL_MAYBE_UNUSED int log_n = tables.coeff_count_power();
+                SEAL_MAYBE_UNUSED int log_block = tables.block_coeff_count_power();
+                SEAL_MAYBE_UNUSED auto roots = reinterpret_cast<const uint64_t *>(tables.get_from_root_powers());
+                SEAL_MAYBE_UNUSED auto block_roots =
+                    reinterpret_cast<const uint64_t *>(tables.get_from_block_root_powers());
+                switch (ntt_kernel().load(memory_order_relaxed))
+                {
+#ifdef SEAL_USE_AVX512_NTT
+                case ntt_kernel_type::avx512ifma:
+                    if (modulus < ntt_kernel_ifma_modulus_bound)
+                    {
+                        ntt_negacyclic_harvey_lazy_avx512ifma(operand, log_n, roots, log_block, block_roots, modulus);
+                        return true;
+                    }
+                    ntt_negacyclic_harvey_lazy_avx512(operand, log_n, roots, log_block, block_roots, modulus);
+                    return true;
+
+                case ntt_kernel_type::avx512:
+                    ntt_negacyclic_harvey_lazy_avx512(operand, log_n, roots, log_block, block_roots, modulus);
+                    return true;
+#endif
+#ifdef SEAL_USE_AVX2_NTT
+                case ntt_kernel_type::avx2:
+                    ntt_negacyclic_harvey_lazy_avx2(operand, log_n, roots, log_block, block_roots, modulus);
+                    return true;
+#endif
+                default:
+                    return false;
+                }
+            }
+
+            // Runs the selected vectorized inverse kernel; returns false if the scalar implementation must be used
+            bool inverse_ntt_negacyclic_harvey_lazy_vectorized(
+                SEAL_MAYBE_UNUSED CoeffIter operand, const NTTTables &tables)
+            {
+                ntt_kernel_type kernel = ntt_kernel().load(memory_order_relaxed);
+                if (tables.coeff_count_power() < ntt_kernel_coeff_count_power_min || kernel == ntt_kernel_type::scalar)
+                {
+                    return false;
+                }
+
+                // As in DWTHandler::transform_from_rev, n^(-1) is merged into the root of the last layer
+                const Modulus &modulus = tables.modulus();
+                const MultiplyUIntModOperand *inv_root_powers = tables.get_from_inv_root_powers();
+                MultiplyUIntModOperand inv_degree_modulo = tables.inv_degree_modulo();
+                MultiplyUIntModOperand scaled_last_inv_root;
+                scaled_last_inv_root.set(
+                    multiply_uint_mod(inv_root_powers[tables.coeff_count() - 1].operand, inv_degree_modulo, modulus),
+                    modulus);
+
+                SEAL_MAYBE_UNUSED int log_n = tables.coeff_count_power();
+                SEAL_MAYBE_UNUSED int log_block = tables.block_coeff_count_power();
+                SEAL_MAYBE_UNUSED auto roots = reinterpret_cast<const uint64_t *>(inv_root_powers);
+                SEAL_MAYBE_UNUSED auto block_roots =
+                    reinterpret_cast<const uint64_t *>(tables.get_from_block_inv_root_powers());
+                SEAL_MAYBE_UNUSED auto inv_degree = reinterpret_cast<const uint64_t *>(&inv_degree_modulo);
+                SEAL_MAYBE_UNUSED auto scaled_root = reinterpret_cast<const uint64_t *>(&scaled_last_inv_root);
+                switch (kernel)
+                {
+#ifdef SEAL_USE_AVX512_NTT
+                case ntt_kernel_type::avx512ifma:
+                    if (modulus.value() < ntt_kernel_ifma_modulus_bound)
+                    {
+                        inverse_ntt_negacyclic_harvey_lazy_avx512ifma(
+                            operand, log_n, roots, log_block, block_roots, modulus.value(), inv_degree, scaled_root);
+                        return true;
+                    }
+                    inverse_ntt_negacyclic_harvey_lazy_avx512(
+                        operand, log_n, roots, log_block, block_roots, modulus.value(), inv_degree, scaled_root);
+                    return true;
+
+                case ntt_kernel_type::avx512:
+                    inverse_ntt_negacyclic_harvey_lazy_avx512(
+                        operand, log_n, roots, log_block, block_roots, modulus.value(), inv_degree, scaled_root);
+                    return true;
+#endif
+#ifdef SEAL_USE_AVX2_NTT
+                case ntt_kernel_type::avx2:
+                    inverse_ntt_negacyclic_harvey_lazy_avx2(
+                        operand, log_n, roots, log_block, block_roots, modulus.value(), inv_degree, scaled_root);
+                    return true;
+#endif
+                default:
+                    return false;
+                }
+            }
+
+            // Reduces the output of the lazy forward transform, or of the lazy inverse transform if inverse is set,
+            // to [0, q) while it is still in cache
+            void reduce_ntt_output(CoeffIter operand, const NTTTables &tables, bool inverse)
+            {
+                uint64_t modulus = tables.modulus().value();
+                if (tables.coeff_count_power() >= ntt_kernel_coeff_count_power_min)
+                {
+                    switch (ntt_kernel().load(memory_order_relaxed))
+                    {
+#ifdef SEAL_USE_AVX512_NTT
+                    case ntt_kernel_type::avx512ifma:
+                    case ntt_kernel_type::avx512:
+                        ntt_negacyclic_harvey_reduce_avx512(operand, tables.coeff_count_power(), modulus, inverse);
+                        return;
+#endif
+#ifdef SEAL_USE_AVX2_NTT
+                    case ntt_kernel_type::avx2:
+                        ntt_negacyclic_harvey_reduce_avx2(operand, tables.coeff_count_power(), modulus, inverse);
+                        return;
+#endif
+                    default:
+                        break;
+                    }
+                }
+
+                // The outputs are uniformly distributed, so branches on them are mispredicted half the time
+                uint64_t two_times_modulus = modulus << 1;
+                if (!inverse)
+                {
+                    SEAL_ITERATE(operand, tables.coeff_count(), [&](auto &I) {
+                        I -= SEAL_COND_SELECT(I >= two_times_modulus, two_times_modulus, 0);
+                    });
+                }
+                SEAL_ITERATE(operand, tables.coeff_count(), [&](auto &I) {
+                    I -= SEAL_COND_SELECT(I >= modulus, modulus, 0);
+                });
+            }
+#endif
+        } // namespace
+
+        bool ntt_kernel_supported(ntt_kernel_type kernel) noexcept
+        {
+            switch (kernel)
+            {
+            case ntt_kernel_type::scalar:
+                return true;
+#ifdef SEAL_USE_AVX2_NTT
+            case ntt_kernel_type::avx2:
+                return cpu_features().avx2;
+#endif
+#ifdef SEAL_USE_AVX512_NTT
+            case ntt_kernel_type::avx512:
+                return cpu_features().avx512f && cpu_features().avx512dq;
+
+            case ntt_kernel_type::avx512ifma:
+                return cpu_features().avx512f && cpu_features().avx512dq && cpu_features().avx512ifma;
+#endif
+            default:
+                return false;
+            }
+        }
+
+        ntt_kernel_type get_ntt_kernel() noexcept
+        {
+            return ntt_kernel().load(memory_order_relaxed);
+        }
+
+        void set_ntt_kernel(ntt_kernel_type kernel)
+        {
+            if (!ntt_kernel_supported(kernel))
+            {
+                throw invalid_argument("kernel is not supported");
+            }
+            ntt_kernel().store(kernel, memory_order_relaxed);
+        }
+
         NTTTables::NTTTables(int coeff_count_power, const Modulus &modulus, MemoryPoolHandle pool) : pool_(move(pool))
         {
 #ifdef SEAL_DEBUG
@@ -286,6 +493,36 @@ namespace seal
             }
             inv_root_powers_[0].set(static_cast<uint64_t>(1), modulus_);
 
+            // Large NTTs are computed in blocks; gather the powers each block uses so that they are contiguous
+#ifdef SEAL_USE_INTEL_HEXL
+            block_coeff_count_power_ = coeff_count_power_;
+#else
+            block_coeff_count_power_ = min(coeff_count_power_, SEAL_NTT_BLOCK_COEFF_COUNT_POWER);
+#endif
+            if (block_coeff_count_power_ < coeff_count_power_)
+            {
+                size_t block_count = coeff_count_ >> block_coeff_count_power_;
+                size_t block_coeff_count = size_t(1) << block_coeff_count_power_;
+                block_root_powers_ = allocate<MultiplyUIntModOperand>(coeff_count_, pool_);
+                block_inv_root_powers_ = allocate<MultiplyUIntModOperand>(coeff_count_, pool_);
+                for (size_t k = 0; k < block_count; k++)
+                {
+                    MultiplyUIntModOperand *block_roots = block_root_powers_.get() + k * block_coeff_count;
+                    MultiplyUIntModOperand *block_inv_roots = block_inv_root_powers_.get() + k * block_coeff_count;
+                    block_roots[0] = root_powers_[0];
+                    block_inv_roots[0] = inv_root_powers_[0];
+
+                    // A layer with m groups per block has block_count * m groups in total
+                    for (size_t m = 1; m < block_coeff_count; m <<= 1)
+                    {
+                        copy_n(root_powers_.get() + block_count * m + k * m, m, block_roots + m);
+                        copy_n(
+                            inv_root_powers_.get() + (coeff_count_ - 2 * block_count * m + 1) + k * m, m,
+                            block_inv_roots + (block_coeff_count - 2 * m + 1));
+                    }
+                }
+            }
+
             // Compute n^(-1) modulo q.
             uint64_t degree_uint = static_cast<uint64_t>(coeff_count_);
             if (!try_invert_uint_mod(degree_uint, modulus_, inv_degree_modulo_.operand))
@@ -399,8 +636,13 @@ namespace seal
 
             intel::seal_ext::compute_forward_ntt(operand, N, p, root, 4, 4);
 #else
-            tables.ntt_handler().transform_to_rev(
-                operand.ptr(), tables.coeff_count_power(), tables.get_from_root_powers());
+            if (ntt_negacyclic_harvey_lazy_vectorized(operand, tables))
+            {
+                return;
+            }
+            tables.ntt_handler().transform_to_rev_blocked(
+                operand.ptr(), tables.coeff_count_power(), tables.get_from_root_powers(),
+                tables.block_coeff_count_power(), tables.get_from_block_root_powers());
 #endif
         }
 
@@ -414,24 +656,9 @@ namespace seal
             intel::seal_ext::compute_forward_ntt(operand, N, p, root, 4, 1);
 #else
             ntt_negacyclic_harvey_lazy(operand, tables);
-            // Finally maybe we need to reduce every coefficient modulo q, but we
+            // Finally we need to reduce every coefficient modulo q, but we
             // know that they are in the range [0, 4q).
-            // Since word size is controlled this is fast.
-            std::uint64_t modulus = tables.modulus().value();
-            std::uint64_t two_times_modulus = modulus * 2;
-            std::size_t n = std::size_t(1) << tables.coeff_count_power();
-
-            SEAL_ITERATE(operand, n, [&](auto &I) {
-                // Note: I must be passed to the lambda by reference.
-                if (I >= two_times_modulus)
-                {
-                    I -= two_times_modulus;
-                }
-                if (I >= modulus)
-                {
-                    I -= modulus;
-                }
-            });
+            reduce_ntt_output(operand, tables, false);
 #endif
         }
 
@@ -443,9 +670,14 @@ namespace seal
             uint64_t root = tables.get_root();
             intel::seal_ext::compute_inverse_ntt(operand, N, p, root, 2, 2);
 #else
+            if (inverse_ntt_negacyclic_harvey_lazy_vectorized(operand, tables))
+            {
+                return;
+            }
             MultiplyUIntModOperand inv_degree_modulo = tables.inv_degree_modulo();
-            tables.ntt_handler().transform_from_rev(
-                operand.ptr(), tables.coeff_count_power(), tables.get_from_inv_root_powers(), &inv_degree_modulo);
+            tables.ntt_handler().transform_from_rev_blocked(
+                operand.ptr(), tables.coeff_count_power(), tables.get_from_inv_root_powers(),
+                tables.block_coeff_count_power(), tables.get_from_block_inv_root_powers(), &inv_degree_modulo);
 #endif
         }
 
@@ -458,19 +690,69 @@ namespace seal
             intel::seal_ext::compute_inverse_ntt(operand, N, p, root, 2, 1);
 #else
             inverse_ntt_negacyclic_harvey_lazy(operand, tables);
-            std::uint64_t modulus = tables.modulus().value();
-            std::size_t n = std::size_t(1) << tables.coeff_count_power();
 
             // Final adjustments; compute a[j] = a[j] * n^{-1} mod q.
             // We incorporated the final adjustment in the butterfly. Only need to reduce here.
-            SEAL_ITERATE(operand, n, [&](auto &I) {
-                // Note: I must be passed to the lambda by reference.
-                if (I >= modulus)
-                {
-                    I -= modulus;
-                }
-            });
+            reduce_ntt_output(operand, tables, true);
 #endif
         }
+
+        template <int CoeffCountPower>
+        void ntt_negacyclic_harvey_lazy_fixed(CoeffIter operand, const NTTTables &tables)
+        {
+#ifdef SEAL_DEBUG
+            if (tables.coeff_count_power() != CoeffCountPower)
+            {
+                throw invalid_argument("tables");
+            }
+#endif
+#ifdef SEAL_USE_INTEL_HEXL
+            ntt_negacyclic_harvey_lazy(operand, tables);
+#else
+            if (ntt_negacyclic_harvey_lazy_vectorized(operand, tables))
+            {
+                return;
+            }
+            constexpr int block_coeff_count_power = min(CoeffCountPower, SEAL_NTT_BLOCK_COEFF_COUNT_POWER);
+            tables.ntt_handler().transform_to_rev_blocked(
+                operand.ptr(), CoeffCountPower, tables.get_from_root_powers(), block_coeff_count_power,
+                tables.get_from_block_root_powers());
+#endif
+        }
+
+        template <int CoeffCountPower>
+        void inverse_ntt_negacyclic_harvey_lazy_fixed(CoeffIter operand, const NTTTables &tables)
+        {
+#ifdef SEAL_DEBUG
+            if (tables.coeff_count_power() != CoeffCountPower)
+            {
+                throw invalid_argument("tables");
+            }
+#endif
+#ifdef SEAL_USE_INTEL_HEXL
+            inverse_ntt_negacyclic_harvey_lazy(operand, tables);
+#else
+            if (inverse_ntt_negacyclic_harvey_lazy_vectorized(operand, tables))
+            {
+                return;
+            }
+            constexpr int block_coeff_count_power = min(CoeffCountPower, SEAL_NTT_BLOCK_COEFF_COUNT_POWER);
+            MultiplyUIntModOperand inv_degree_modulo = tables.inv_degree_modulo();
+            tables.ntt_handler().transform_from_rev_blocked(
+                operand.ptr(), CoeffCountPower, tables.get_from_inv_root_powers(), block_coeff_count_power,
+                tables.get_from_block_inv_root_powers(), &inv_degree_modulo);
+#endif
+        }
+
+        template void ntt_negacyclic_harvey_lazy_fixed<12>(CoeffIter, const NTTTables &);
+        template void ntt_negacyclic_harvey_lazy_fixed<13>(CoeffIter, const NTTTables &);
+        template void ntt_negacyclic_harvey_lazy_fixed<14>(CoeffIter, const NTTTables &);
+        template void ntt_negacyclic_harvey_lazy_fixed<15>(CoeffIter, const NTTTables &);
+        template void ntt_negacyclic_harvey_lazy_fixed<16>(CoeffIter, const NTTTables &);
+        template void inverse_ntt_negacyclic_harvey_lazy_fixed<12>(CoeffIter, const NTTTables &);
+        template void inverse_ntt_negacyclic_harvey_lazy_fixed<13>(CoeffIter, const NTTTables &);
+        template void inverse_ntt_negacyclic_harvey_lazy_fixed<14>(CoeffIter, const NTTTables &);
+        template void inverse_ntt_negacyclic_harvey_lazy_fixed<15>(CoeffIter, const NTTTables &);
+        template void inverse_ntt_negacyclic_harvey_lazy_fixed<16>(CoeffIter, const NTTTables &);
     } // namespace util
 } // namespace seal
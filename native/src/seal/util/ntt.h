@@ -9,6 +9,7 @@
 #include "seal/util/dwthandler.h"
 #include "seal/util/iterator.h"
 #include "seal/util/pointer.h"
+#include "seal/util/threadpool.h"
 #include "seal/util/uintarithsmallmod.h"
 #include "seal/util/uintcore.h"
 #include <stdexcept>
@@ -76,13 +77,23 @@ namespace seal
 
             NTTTables(NTTTables &copy)
                 : pool_(copy.pool_), root_(copy.root_), coeff_count_power_(copy.coeff_count_power_),
-                  coeff_count_(copy.coeff_count_), modulus_(copy.modulus_), inv_degree_modulo_(copy.inv_degree_modulo_)
+                  coeff_count_(copy.coeff_count_), block_coeff_count_power_(copy.block_coeff_count_power_),
+                  modulus_(copy.modulus_), inv_degree_modulo_(copy.inv_degree_modulo_)
             {
                 root_powers_ = allocate<MultiplyUIntModOperand>(coeff_count_, pool_);
                 inv_root_powers_ = allocate<MultiplyUIntModOperand>(coeff_count_, pool_);
 
                 std::copy_n(copy.root_powers_.get(), coeff_count_, root_powers_.get());
                 std::copy_n(copy.inv_root_powers_.get(), coeff_count_, inv_root_powers_.get());
+
+                if (copy.block_root_powers_)
+                {
+                    block_root_powers_ = allocate<MultiplyUIntModOperand>(coeff_count_, pool_);
+                    block_inv_root_powers_ = allocate<MultiplyUIntModOperand>(coeff_count_, pool_);
+
+                    std::copy_n(copy.block_root_powers_.get(), coeff_count_, block_root_powers_.get());
+                    std::copy_n(copy.block_inv_root_powers_.get(), coeff_count_, block_inv_root_powers_.get());
+                }
             }
 
             NTTTables(int coeff_count_power, const Modulus &modulus, MemoryPoolHandle pool = MemoryManager::GetPool());
@@ -102,6 +113,23 @@ namespace seal
                 return inv_root_powers_.get();
             }
 
+            /**
+            Returns the powers of root_ used by the blocked NTT; see DWTHandler::transform_to_rev_blocked.
+            */
+            SEAL_NODISCARD inline const MultiplyUIntModOperand *get_from_block_root_powers() const
+            {
+                return block_root_powers_ ? block_root_powers_.get() : root_powers_.get();
+            }
+
+            /**
+            Returns the powers of inv_root_ used by the blocked inverse NTT; see
+            DWTHandler::transform_from_rev_blocked.
+            */
+            SEAL_NODISCARD inline const MultiplyUIntModOperand *get_from_block_inv_root_powers() const
+            {
+                return block_inv_root_powers_ ? block_inv_root_powers_.get() : inv_root_powers_.get();
+            }
+
             SEAL_NODISCARD inline MultiplyUIntModOperand get_from_root_powers(std::size_t index) const
             {
 #ifdef SEAL_DEBUG
@@ -144,6 +172,15 @@ namespace seal
                 return coeff_count_;
             }
 
+            /**
+            Returns log 2 of the number of coefficients that the NTT transforms in a block; equals
+            coeff_count_power() if the NTT is not blocked.
+            */
+            SEAL_NODISCARD inline int block_coeff_count_power() const
+            {
+                return block_coeff_count_power_;
+            }
+
             const NTTHandler &ntt_handler() const
             {
                 return ntt_handler_;
@@ -166,6 +203,8 @@ namespace seal
 
             std::size_t coeff_count_ = 0;
 
+            int block_coeff_count_power_ = 0;
+
             Modulus modulus_;
 
             // Inverse of coeff_count_ modulo modulus_.
@@ -177,11 +216,61 @@ namespace seal
             // Holds 1~(n-1)-th powers of inv_root_ in scrambled order, the 0-th power is left unset.
             Pointer<MultiplyUIntModOperand> inv_root_powers_;
 
+            // For each block of the blocked NTT in turn, holds the powers of root_ that its layers use, in the order of
+            // root_powers_ for a single block. Unset if the NTT is not blocked.
+            Pointer<MultiplyUIntModOperand> block_root_powers_;
+
+            // For each block of the blocked inverse NTT in turn, holds the powers of inv_root_ that its layers use, in
+            // the order of inv_root_powers_ for a single block. Unset if the NTT is not blocked.
+            Pointer<MultiplyUIntModOperand> block_inv_root_powers_;
+
             ModArithLazy mod_arith_lazy_;
 
             NTTHandler ntt_handler_;
         };
 
+        /**
+        Identifies an implementation of the lazy forward and inverse negacyclic NTT. All implementations compute the
+        same transforms with the same output ranges; the vectorized ones are used for transforms of at least 16
+        coefficients. When SEAL is built with Intel HEXL, the NTT is always computed by HEXL instead.
+        */
+        enum class ntt_kernel_type : std::uint8_t
+        {
+            // Portable scalar butterflies
+            scalar = 0x0,
+
+            // AVX2 butterflies with 64-bit products computed from 32x32-bit partial products
+            avx2 = 0x1,
+
+            // AVX-512F/DQ butterflies
+            avx512 = 0x2,
+
+            // AVX-512 IFMA butterflies with 52-bit products for moduli less than 2^50, avx512 for larger moduli
+            avx512ifma = 0x3
+        };
+
+        /**
+        Returns whether the given NTT kernel is built into the library and supported by the CPU.
+
+        @param[in] kernel The NTT kernel
+        */
+        SEAL_NODISCARD bool ntt_kernel_supported(ntt_kernel_type kernel) noexcept;
+
+        /**
+        Returns the NTT kernel in use. Unless set_ntt_kernel is called, this is the fastest kernel supported by the
+        CPU, which is determined once on first use.
+        */
+        SEAL_NODISCARD ntt_kernel_type get_ntt_kernel() noexcept;
+
+        /**
+        Selects the NTT kernel used by all subsequent transforms, e.g., for testing or benchmarking a particular
+        implementation. This must not be called while transforms run on other threads.
+
+        @param[in] kernel The NTT kernel
+        @throws std::invalid_argument if kernel is not supported
+        */
+        void set_ntt_kernel(ntt_kernel_type kernel);
+
         /**
         Allocate and construct an array of NTTTables each with different a modulus.
 
@@ -194,6 +283,11 @@ namespace seal
 
         void ntt_negacyclic_harvey_lazy(CoeffIter operand, const NTTTables &tables);
 
+        // Same as above for tables with coeff_count_power equal to CoeffCountPower, which makes the loop bounds of the
+        // scalar transform compile-time constants; instantiated for 12 to 16 (see PolyKernels)
+        template <int CoeffCountPower>
+        void ntt_negacyclic_harvey_lazy_fixed(CoeffIter operand, const NTTTables &tables);
+
         inline void ntt_negacyclic_harvey_lazy(
             RNSIter operand, std::size_t coeff_modulus_size, ConstNTTTablesIter tables)
         {
@@ -207,7 +301,7 @@ namespace seal
                 throw std::invalid_argument("tables");
             }
 #endif
-            SEAL_ITERATE(iter(operand, tables), coeff_modulus_size, [&](auto I) {
+            SEAL_ITERATE_PARALLEL(iter(operand, tables), coeff_modulus_size, [&](auto I) {
                 ntt_negacyclic_harvey_lazy(get<0>(I), get<1>(I));
             });
         }
@@ -224,8 +318,12 @@ namespace seal
                 throw std::invalid_argument("tables");
             }
 #endif
-            SEAL_ITERATE(
-                operand, size, [&](auto I) { ntt_negacyclic_harvey_lazy(I, operand.coeff_modulus_size(), tables); });
+            // Transform all polynomials and RNS components in a single loop
+            std::size_t coeff_modulus_size = operand.coeff_modulus_size();
+            SEAL_ITERATE_PARALLEL(iter(std::size_t(0)), size * coeff_modulus_size, [&](auto I) {
+                std::size_t rns_index = I % coeff_modulus_size;
+                ntt_negacyclic_harvey_lazy(operand[I / coeff_modulus_size][rns_index], tables[rns_index]);
+            });
         }
 
         void ntt_negacyclic_harvey(CoeffIter operand, const NTTTables &tables);
@@ -242,7 +340,7 @@ namespace seal
                 throw std::invalid_argument("tables");
             }
 #endif
-            SEAL_ITERATE(iter(operand, tables), coeff_modulus_size, [&](auto I) {
+            SEAL_ITERATE_PARALLEL(iter(operand, tables), coeff_modulus_size, [&](auto I) {
                 ntt_negacyclic_harvey(get<0>(I), get<1>(I));
             });
         }
@@ -259,12 +357,21 @@ namespace seal
                 throw std::invalid_argument("tables");
             }
 #endif
-            SEAL_ITERATE(
-                operand, size, [&](auto I) { ntt_negacyclic_harvey(I, operand.coeff_modulus_size(), tables); });
+            // Transform all polynomials and RNS components in a single loop
+            std::size_t coeff_modulus_size = operand.coeff_modulus_size();
+            SEAL_ITERATE_PARALLEL(iter(std::size_t(0)), size * coeff_modulus_size, [&](auto I) {
+                std::size_t rns_index = I % coeff_modulus_size;
+                ntt_negacyclic_harvey(operand[I / coeff_modulus_size][rns_index], tables[rns_index]);
+            });
         }
 
         void inverse_ntt_negacyclic_harvey_lazy(CoeffIter operand, const NTTTables &tables);
 
+        // Same as above for tables with coeff_count_power equal to CoeffCountPower, which makes the loop bounds of the
+        // scalar transform compile-time constants; instantiated for 12 to 16 (see PolyKernels)
+        template <int CoeffCountPower>
+        void inverse_ntt_negacyclic_harvey_lazy_fixed(CoeffIter operand, const NTTTables &tables);
+
         inline void inverse_ntt_negacyclic_harvey_lazy(
             RNSIter operand, std::size_t coeff_modulus_size, ConstNTTTablesIter tables)
         {
@@ -278,7 +385,7 @@ namespace seal
                 throw std::invalid_argument("tables");
             }
 #endif
-            SEAL_ITERATE(iter(operand, tables), coeff_modulus_size, [&](auto I) {
+            SEAL_ITERATE_PARALLEL(iter(operand, tables), coeff_modulus_size, [&](auto I) {
                 inverse_ntt_negacyclic_harvey_lazy(get<0>(I), get<1>(I));
             });
         }
@@ -295,8 +402,11 @@ namespace seal
                 throw std::invalid_argument("tables");
             }
 #endif
-            SEAL_ITERATE(operand, size, [&](auto I) {
-                inverse_ntt_negacyclic_harvey_lazy(I, operand.coeff_modulus_size(), tables);
+            // Transform all polynomials and RNS components in a single loop
+            std::size_t coeff_modulus_size = operand.coeff_modulus_size();
+            SEAL_ITERATE_PARALLEL(iter(std::size_t(0)), size * coeff_modulus_size, [&](auto I) {
+                std::size_t rns_index = I % coeff_modulus_size;
+                inverse_ntt_negacyclic_harvey_lazy(operand[I / coeff_modulus_size][rns_index], tables[rns_index]);
             });
         }
 
@@ -315,7 +425,7 @@ namespace seal
                 throw std::invalid_argument("tables");
             }
 #endif
-            SEAL_ITERATE(iter(operand, tables), coeff_modulus_size, [&](auto I) {
+            SEAL_ITERATE_PARALLEL(iter(operand, tables), coeff_modulus_size, [&](auto I) {
                 inverse_ntt_negacyclic_harvey(get<0>(I), get<1>(I));
             });
         }
@@ -332,8 +442,12 @@ namespace seal
                 throw std::invalid_argument("tables");
             }
 #endif
-            SEAL_ITERATE(
-                operand, size, [&](auto I) { inverse_ntt_negacyclic_harvey(I, operand.coeff_modulus_size(), tables); });
+            // Transform all polynomials and RNS components in a single loop
+            std::size_t coeff_modulus_size = operand.coeff_modulus_size();
+            SEAL_ITERATE_PARALLEL(iter(std::size_t(0)), size * coeff_modulus_size, [&](auto I) {
+                std::size_t rns_index = I % coeff_modulus_size;
+                inverse_ntt_negacyclic_harvey(operand[I / coeff_modulus_size][rns_index], tables[rns_index]);
+            });
         }
 
         void ntt_negacyclic_harvey_new(CoeffIter operand, const NTTTables &tables);
@@ -0,0 +1,71 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "seal/util/config.h"
+#include <cstdint>
+
+namespace seal
+{
+    namespace util
+    {
+        /*
+        Vectorized counterparts of the lazy NTT butterflies of DWTHandler. Each instruction set lives in a translation
+        unit of its own that is compiled with that instruction set enabled, so these functions must only be called
+        after checking that the CPU supports it (see ntt_kernel_supported in ntt.h). To keep code compiled for a
+        specific instruction set from being shared with the rest of the library, these translation units include no
+        other headers of the library but avxarith.h, whose functions have internal linkage, and the functions take plain
+        arrays:
+
+        - operand holds 2^coeff_count_power values, where coeff_count_power is at least 4;
+        - root_powers and inv_root_powers point to the arrays of MultiplyUIntModOperand in NTTTables, viewed as
+          consecutive (operand, quotient) pairs of 64-bit words;
+        - block_coeff_count_power, block_root_powers, and block_inv_root_powers are those of NTTTables, which
+          describe the blocked traversal of DWTHandler::transform_to_rev_blocked and transform_from_rev_blocked;
+        - inv_degree_modulo is n^(-1) and scaled_last_inv_root is the last power in inv_root_powers times n^(-1), both
+          as (operand, quotient) pairs;
+        - modulus is at most 61 bits, or less than 2^50 for the AVX-512 IFMA kernels. The AVX2 and AVX-512 kernels
+          compute the products of narrow moduli, which are less than 2^30, with 32x32-bit lane multiplications.
+
+        The forward transform takes input in [0, 4 * modulus) and the inverse transform takes input in
+        [0, 2 * modulus); the output ranges are the same as those of the scalar implementation. The reduce functions
+        bring the output of the forward transform, or of the inverse transform if inverse is set, to [0, modulus).
+        */
+#ifdef SEAL_USE_AVX2_NTT
+        void ntt_negacyclic_harvey_lazy_avx2(
+            std::uint64_t *operand, int coeff_count_power, const std::uint64_t *root_powers,
+            int block_coeff_count_power, const std::uint64_t *block_root_powers, std::uint64_t modulus);
+
+        void inverse_ntt_negacyclic_harvey_lazy_avx2(
+            std::uint64_t *operand, int coeff_count_power, const std::uint64_t *inv_root_powers,
+            int block_coeff_count_power, const std::uint64_t *block_inv_root_powers, std::uint64_t modulus,
+            const std::uint64_t *inv_degree_modulo, const std::uint64_t *scaled_last_inv_root);
+
+        void ntt_negacyclic_harvey_reduce_avx2(
+            std::uint64_t *operand, int coeff_count_power, std::uint64_t modulus, bool inverse);
+#endif
+#ifdef SEAL_USE_AVX512_NTT
+        void ntt_negacyclic_harvey_lazy_avx512(
+            std::uint64_t *operand, int coeff_count_power, const std::uint64_t *root_powers,
+            int block_coeff_count_power, const std::uint64_t *block_root_powers, std::uint64_t modulus);
+
+        void inverse_ntt_negacyclic_harvey_lazy_avx512(
+            std::uint64_t *operand, int coeff_count_power, const std::uint64_t *inv_root_powers,
+            int block_coeff_count_power, const std::uint64_t *block_inv_root_powers, std::uint64_t modulus,
+            const std::uint64_t *inv_degree_modulo, const std::uint64_t *scaled_last_inv_root);
+
+        void ntt_negacyclic_harvey_lazy_avx512ifma(
+            std::uint64_t *operand, int coeff_count_power, const std::uint64_t *root_powers,
+            int block_coeff_count_power, const std::uint64_t *block_root_powers, std::uint64_t modulus);
+
+        void inverse_ntt_negacyclic_harvey_lazy_avx512ifma(
+            std::uint64_t *operand, int coeff_count_power, const std::uint64_t *inv_root_powers,
+            int block_coeff_count_power, const std::uint64_t *block_inv_root_powers, std::uint64_t modulus,
+            const std::uint64_t *inv_degree_modulo, const std::uint64_t *scaled_last_inv_root);
+
+        void ntt_negacyclic_harvey_reduce_avx512(
+            std::uint64_t *operand, int coeff_count_power, std::uint64_t modulus, bool inverse);
+#endif
+    } // namespace util
+} // namespace seal
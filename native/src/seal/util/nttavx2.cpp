@@ -0,0 +1,346 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+// This file is compiled with AVX2 enabled; see nttavx.h for why it must not include other headers of the library.
+#include "seal/util/nttavx.h"
+
+#ifdef SEAL_USE_AVX2_NTT
+#include "seal/util/avxarith.h"
+#include <cstddef>
+#include <immintrin.h>
+
+using namespace std;
+
+namespace seal
+{
+    namespace util
+    {
+        namespace
+        {
+            // As in nttavx512.cpp, Harvey's multiplication works in words of QuotientBits bits, which is 64 or, for
+            // narrow moduli, 32: the quotient of a root is the 64-bit quotient shifted right by 64 - QuotientBits
+            template <int QuotientBits>
+            inline __m256i load_quotient(__m256i w_quot)
+            {
+                return (QuotientBits < 64) ? _mm256_srli_epi64(w_quot, 64 - QuotientBits) : w_quot;
+            }
+
+            // Same as multiply_uint_mod_lazy: y * w mod q in [0, 2q), where w_quot = floor(w * 2^QuotientBits / q)
+            template <int QuotientBits>
+            inline __m256i mul_root_lazy(__m256i y, __m256i w, __m256i w_quot, __m256i q)
+            {
+                if (QuotientBits == 32)
+                {
+                    __m256i quot = _mm256_srli_epi64(_mm256_mul_epu32(y, w_quot), 32);
+                    return _mm256_sub_epi64(_mm256_mul_epu32(y, w), _mm256_mul_epu32(quot, q));
+                }
+                __m256i quot = mulhi_epu64(y, w_quot);
+                return _mm256_sub_epi64(mullo_epu64(y, w), mullo_epu64(quot, q));
+            }
+
+            // Cooley-Tukey butterfly of transform_to_rev: inputs and outputs are in [0, 4q)
+            template <int QuotientBits>
+            inline void forward_butterfly(__m256i &x, __m256i &y, __m256i w, __m256i w_quot, __m256i q, __m256i two_q)
+            {
+                __m256i u = guard(x, two_q);
+                __m256i v = mul_root_lazy<QuotientBits>(y, w, w_quot, q);
+                x = _mm256_add_epi64(u, v);
+                y = _mm256_sub_epi64(_mm256_add_epi64(u, two_q), v);
+            }
+
+            // Gentleman-Sande butterfly of transform_from_rev: inputs and outputs are in [0, 2q)
+            template <int QuotientBits>
+            inline void inverse_butterfly(__m256i &x, __m256i &y, __m256i w, __m256i w_quot, __m256i q, __m256i two_q)
+            {
+                __m256i u = x;
+                x = guard(_mm256_add_epi64(u, y), two_q);
+                y = mul_root_lazy<QuotientBits>(_mm256_sub_epi64(_mm256_add_epi64(u, two_q), y), w, w_quot, q);
+            }
+
+            template <int QuotientBits, bool Inverse>
+            inline void butterfly(__m256i &x, __m256i &y, __m256i w, __m256i w_quot, __m256i q, __m256i two_q)
+            {
+                if (Inverse)
+                {
+                    inverse_butterfly<QuotientBits>(x, y, w, w_quot, q, two_q);
+                }
+                else
+                {
+                    forward_butterfly<QuotientBits>(x, y, w, w_quot, q, two_q);
+                }
+            }
+
+            // A layer of m groups with gap at least 4; every group uses a single root
+            template <int QuotientBits, bool Inverse>
+            void large_gap_layer(
+                uint64_t *values, size_t m, size_t gap, const uint64_t *roots, __m256i q, __m256i two_q)
+            {
+                for (size_t i = 0; i < m; i++, roots += 2)
+                {
+                    __m256i w = _mm256_set1_epi64x(static_cast<long long>(roots[0]));
+                    __m256i w_quot = load_quotient<QuotientBits>(_mm256_set1_epi64x(static_cast<long long>(roots[1])));
+                    uint64_t *x_ptr = values + 2 * gap * i;
+                    uint64_t *y_ptr = x_ptr + gap;
+                    for (size_t j = 0; j < gap; j += 4)
+                    {
+                        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(x_ptr + j));
+                        __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(y_ptr + j));
+                        butterfly<QuotientBits, Inverse>(x, y, w, w_quot, q, two_q);
+                        _mm256_storeu_si256(reinterpret_cast<__m256i *>(x_ptr + j), x);
+                        _mm256_storeu_si256(reinterpret_cast<__m256i *>(y_ptr + j), y);
+                    }
+                }
+            }
+
+            // A layer of m groups with gap 2: eight values hold two groups [x0 x1 y0 y1 | x0' x1' y0' y1']
+            template <int QuotientBits, bool Inverse>
+            void gap2_layer(uint64_t *values, size_t m, const uint64_t *roots, __m256i q, __m256i two_q)
+            {
+                for (size_t i = 0; i < m; i += 2, roots += 4, values += 8)
+                {
+                    __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values));
+                    __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values + 4));
+                    __m256i x = _mm256_permute2x128_si256(v0, v1, 0x20);
+                    __m256i y = _mm256_permute2x128_si256(v0, v1, 0x31);
+
+                    // Roots of the two groups as [w w w' w'] and their quotients
+                    __m256i r = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(roots));
+                    __m256i w = _mm256_permute4x64_epi64(r, _MM_SHUFFLE(2, 2, 0, 0));
+                    __m256i w_quot = load_quotient<QuotientBits>(_mm256_permute4x64_epi64(r, _MM_SHUFFLE(3, 3, 1, 1)));
+
+                    butterfly<QuotientBits, Inverse>(x, y, w, w_quot, q, two_q);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(values), _mm256_permute2x128_si256(x, y, 0x20));
+                    _mm256_storeu_si256(
+                        reinterpret_cast<__m256i *>(values + 4), _mm256_permute2x128_si256(x, y, 0x31));
+                }
+            }
+
+            // A layer of m groups with gap 1: eight values hold four groups, which the unpacking sees in the order
+            // 0, 2, 1, 3
+            template <int QuotientBits, bool Inverse>
+            void gap1_layer(uint64_t *values, size_t m, const uint64_t *roots, __m256i q, __m256i two_q)
+            {
+                for (size_t i = 0; i < m; i += 4, roots += 8, values += 8)
+                {
+                    __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values));
+                    __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values + 4));
+                    __m256i x = _mm256_unpacklo_epi64(v0, v1);
+                    __m256i y = _mm256_unpackhi_epi64(v0, v1);
+
+                    __m256i r0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(roots));
+                    __m256i r1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(roots + 4));
+                    __m256i w = _mm256_unpacklo_epi64(r0, r1);
+                    __m256i w_quot = load_quotient<QuotientBits>(_mm256_unpackhi_epi64(r0, r1));
+
+                    butterfly<QuotientBits, Inverse>(x, y, w, w_quot, q, two_q);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(values), _mm256_unpacklo_epi64(x, y));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(values + 4), _mm256_unpackhi_epi64(x, y));
+                }
+            }
+
+            // Last layer of transform_from_rev, which also multiplies by n^(-1): s is n^(-1) and w is the root
+            // multiplied by n^(-1)
+            template <int QuotientBits>
+            inline void scaled_inverse_butterfly(
+                __m256i &x, __m256i &y, __m256i s, __m256i s_quot, __m256i w, __m256i w_quot, __m256i q,
+                __m256i two_q)
+            {
+                __m256i u = guard(x, two_q);
+                x = mul_root_lazy<QuotientBits>(guard(_mm256_add_epi64(u, y), two_q), s, s_quot, q);
+                y = mul_root_lazy<QuotientBits>(_mm256_sub_epi64(_mm256_add_epi64(u, two_q), y), w, w_quot, q);
+            }
+
+            // The last inverse layer, with a single group
+            template <int QuotientBits>
+            void scaled_last_layer(
+                uint64_t *values, size_t gap, const uint64_t *inv_degree_modulo, const uint64_t *scaled_last_inv_root,
+                __m256i q, __m256i two_q)
+            {
+                __m256i s = _mm256_set1_epi64x(static_cast<long long>(inv_degree_modulo[0]));
+                __m256i s_quot =
+                    load_quotient<QuotientBits>(_mm256_set1_epi64x(static_cast<long long>(inv_degree_modulo[1])));
+                __m256i w = _mm256_set1_epi64x(static_cast<long long>(scaled_last_inv_root[0]));
+                __m256i w_quot =
+                    load_quotient<QuotientBits>(_mm256_set1_epi64x(static_cast<long long>(scaled_last_inv_root[1])));
+                uint64_t *x_ptr = values;
+                uint64_t *y_ptr = values + gap;
+                for (size_t j = 0; j < gap; j += 4)
+                {
+                    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(x_ptr + j));
+                    __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(y_ptr + j));
+                    scaled_inverse_butterfly<QuotientBits>(x, y, s, s_quot, w, w_quot, q, two_q);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(x_ptr + j), x);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(y_ptr + j), y);
+                }
+            }
+
+            // Same as DWTHandler::transform_to_rev
+            template <int QuotientBits>
+            void transform_to_rev(uint64_t *values, int log_n, const uint64_t *root_powers, __m256i q, __m256i two_q)
+            {
+                size_t n = size_t(1) << log_n;
+
+                // The roots of each layer follow those of the previous layer, starting from the power at index 1
+                const uint64_t *roots = root_powers + 2;
+                size_t m = 1;
+                size_t gap = n >> 1;
+                for (; gap >= 4; m <<= 1, gap >>= 1)
+                {
+                    large_gap_layer<QuotientBits, false>(values, m, gap, roots, q, two_q);
+                    roots += 2 * m;
+                }
+                gap2_layer<QuotientBits, false>(values, m, roots, q, two_q);
+                roots += 2 * m;
+                m <<= 1;
+                gap1_layer<QuotientBits, false>(values, m, roots, q, two_q);
+            }
+
+            // Same as DWTHandler::transform_from_rev; the last layer multiplies by n^(-1) only if inv_degree_modulo
+            // is given
+            template <int QuotientBits>
+            void transform_from_rev(
+                uint64_t *values, int log_n, const uint64_t *inv_root_powers, const uint64_t *inv_degree_modulo,
+                const uint64_t *scaled_last_inv_root, __m256i q, __m256i two_q)
+            {
+                size_t n = size_t(1) << log_n;
+                const uint64_t *roots = inv_root_powers + 2;
+                size_t m = n >> 1;
+                gap1_layer<QuotientBits, true>(values, m, roots, q, two_q);
+                roots += 2 * m;
+                m >>= 1;
+                gap2_layer<QuotientBits, true>(values, m, roots, q, two_q);
+                roots += 2 * m;
+                m >>= 1;
+                size_t gap = 4;
+                for (; m > 1; m >>= 1, gap <<= 1)
+                {
+                    large_gap_layer<QuotientBits, true>(values, m, gap, roots, q, two_q);
+                    roots += 2 * m;
+                }
+
+                // The last layer also multiplies by n^(-1), which is merged into its root
+                if (inv_degree_modulo)
+                {
+                    scaled_last_layer<QuotientBits>(values, gap, inv_degree_modulo, scaled_last_inv_root, q, two_q);
+                }
+                else
+                {
+                    large_gap_layer<QuotientBits, true>(values, 1, gap, roots, q, two_q);
+                }
+            }
+
+            // Same as DWTHandler::transform_to_rev_blocked, but the layers with gaps at least the block size are not
+            // merged into radix-4 passes, which gains nothing with the slow AVX2 multiplications
+            template <int QuotientBits>
+            void transform_to_rev_blocked(
+                uint64_t *values, int log_n, const uint64_t *root_powers, int log_block, const uint64_t *block_roots,
+                uint64_t modulus)
+            {
+                size_t n = size_t(1) << log_n;
+                size_t block = size_t(1) << log_block;
+                __m256i q = _mm256_set1_epi64x(static_cast<long long>(modulus));
+                __m256i two_q = _mm256_set1_epi64x(static_cast<long long>(modulus << 1));
+
+                size_t m = 1;
+                for (size_t gap = n >> 1; gap >= block; m <<= 1, gap >>= 1)
+                {
+                    large_gap_layer<QuotientBits, false>(values, m, gap, root_powers + 2 * m, q, two_q);
+                }
+                for (size_t offset = 0; offset < n; offset += block)
+                {
+                    transform_to_rev<QuotientBits>(values + offset, log_block, block_roots + 2 * offset, q, two_q);
+                }
+            }
+
+            // Same as DWTHandler::transform_from_rev_blocked, again without radix-4 passes
+            template <int QuotientBits>
+            void transform_from_rev_blocked(
+                uint64_t *values, int log_n, const uint64_t *inv_root_powers, int log_block,
+                const uint64_t *block_inv_roots, uint64_t modulus, const uint64_t *inv_degree_modulo,
+                const uint64_t *scaled_last_inv_root)
+            {
+                __m256i q = _mm256_set1_epi64x(static_cast<long long>(modulus));
+                __m256i two_q = _mm256_set1_epi64x(static_cast<long long>(modulus << 1));
+                if (log_block == log_n)
+                {
+                    transform_from_rev<QuotientBits>(
+                        values, log_n, inv_root_powers, inv_degree_modulo, scaled_last_inv_root, q, two_q);
+                    return;
+                }
+
+                size_t n = size_t(1) << log_n;
+                size_t block = size_t(1) << log_block;
+                for (size_t offset = 0; offset < n; offset += block)
+                {
+                    transform_from_rev<QuotientBits>(
+                        values + offset, log_block, block_inv_roots + 2 * offset, nullptr, nullptr, q, two_q);
+                }
+
+                // The layer with m groups uses the powers starting from index n - 2m + 1
+                size_t m = n >> (log_block + 1);
+                size_t gap = block;
+                for (; m > 1; m >>= 1, gap <<= 1)
+                {
+                    large_gap_layer<QuotientBits, true>(
+                        values, m, gap, inv_root_powers + 2 * (n - 2 * m + 1), q, two_q);
+                }
+                scaled_last_layer<QuotientBits>(values, gap, inv_degree_modulo, scaled_last_inv_root, q, two_q);
+            }
+        } // namespace
+
+        void ntt_negacyclic_harvey_lazy_avx2(
+            uint64_t *operand, int coeff_count_power, const uint64_t *root_powers, int block_coeff_count_power,
+            const uint64_t *block_root_powers, uint64_t modulus)
+        {
+            if (modulus < narrow_modulus_bound)
+            {
+                transform_to_rev_blocked<32>(
+                    operand, coeff_count_power, root_powers, block_coeff_count_power, block_root_powers, modulus);
+                return;
+            }
+            transform_to_rev_blocked<64>(
+                operand, coeff_count_power, root_powers, block_coeff_count_power, block_root_powers, modulus);
+        }
+
+        void inverse_ntt_negacyclic_harvey_lazy_avx2(
+            uint64_t *operand, int coeff_count_power, const uint64_t *inv_root_powers, int block_coeff_count_power,
+            const uint64_t *block_inv_root_powers, uint64_t modulus, const uint64_t *inv_degree_modulo,
+            const uint64_t *scaled_last_inv_root)
+        {
+            if (modulus < narrow_modulus_bound)
+            {
+                transform_from_rev_blocked<32>(
+                    operand, coeff_count_power, inv_root_powers, block_coeff_count_power, block_inv_root_powers,
+                    modulus, inv_degree_modulo, scaled_last_inv_root);
+                return;
+            }
+            transform_from_rev_blocked<64>(
+                operand, coeff_count_power, inv_root_powers, block_coeff_count_power, block_inv_root_powers, modulus,
+                inv_degree_modulo, scaled_last_inv_root);
+        }
+
+        void ntt_negacyclic_harvey_reduce_avx2(uint64_t *operand, int coeff_count_power, uint64_t modulus, bool inverse)
+        {
+            size_t n = size_t(1) << coeff_count_power;
+            __m256i q = _mm256_set1_epi64x(static_cast<long long>(modulus));
+            __m256i two_q = _mm256_set1_epi64x(static_cast<long long>(modulus << 1));
+            if (inverse)
+            {
+                for (size_t j = 0; j < n; j += 4)
+                {
+                    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(operand + j));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(operand + j), guard(x, q));
+                }
+            }
+            else
+            {
+                for (size_t j = 0; j < n; j += 4)
+                {
+                    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(operand + j));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(operand + j), guard(guard(x, two_q), q));
+                }
+            }
+        }
+    } // namespace util
+} // namespace seal
+#endif
@@ -0,0 +1,490 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+// This file is compiled with AVX-512F/DQ/IFMA enabled; see nttavx.h for why it must not include other headers of the
+// library.
+#include "seal/util/nttavx.h"
+
+#ifdef SEAL_USE_AVX512_NTT
+#include "seal/util/avxarith.h"
+#include <cstddef>
+#include <immintrin.h>
+
+using namespace std;
+
+namespace seal
+{
+    namespace util
+    {
+        namespace
+        {
+            // Harvey's multiplication works in words of QuotientBits bits: the quotient of a root is
+            // floor(w * 2^QuotientBits / q), which is the 64-bit quotient shifted right, and the input must be less
+            // than 2^QuotientBits. Since inputs are less than 4q, the 52-bit words of IFMA need q < 2^50, and the
+            // 32-bit words, whose products take a single _mm512_mul_epu32, need q < 2^30.
+            template <int QuotientBits>
+            inline __m512i load_quotient(__m512i w_quot)
+            {
+                return (QuotientBits < 64) ? _mm512_srli_epi64(w_quot, 64 - QuotientBits) : w_quot;
+            }
+
+            // Same as multiply_uint_mod_lazy: y * w mod q in [0, 2q)
+            template <int QuotientBits>
+            inline __m512i mul_root_lazy(__m512i y, __m512i w, __m512i w_quot, __m512i q)
+            {
+                if (QuotientBits == 52)
+                {
+                    __m512i zero = _mm512_setzero_si512();
+                    __m512i quot = _mm512_madd52hi_epu64(zero, y, w_quot);
+                    __m512i result =
+                        _mm512_sub_epi64(_mm512_madd52lo_epu64(zero, y, w), _mm512_madd52lo_epu64(zero, quot, q));
+                    return _mm512_and_si512(result, _mm512_set1_epi64((1LL << 52) - 1));
+                }
+                if (QuotientBits == 32)
+                {
+                    __m512i quot = _mm512_srli_epi64(_mm512_mul_epu32(y, w_quot), 32);
+                    return _mm512_sub_epi64(_mm512_mul_epu32(y, w), _mm512_mul_epu32(quot, q));
+                }
+                __m512i quot = mulhi_epu64(y, w_quot);
+                return _mm512_sub_epi64(_mm512_mullo_epi64(y, w), _mm512_mullo_epi64(quot, q));
+            }
+
+            // Cooley-Tukey butterfly of transform_to_rev (inputs and outputs in [0, 4q)) or Gentleman-Sande
+            // butterfly of transform_from_rev (inputs and outputs in [0, 2q))
+            template <int QuotientBits, bool Inverse>
+            inline void butterfly(__m512i &x, __m512i &y, __m512i w, __m512i w_quot, __m512i q, __m512i two_q)
+            {
+                if (Inverse)
+                {
+                    __m512i u = x;
+                    x = guard(_mm512_add_epi64(u, y), two_q);
+                    y = mul_root_lazy<QuotientBits>(_mm512_sub_epi64(_mm512_add_epi64(u, two_q), y), w, w_quot, q);
+                }
+                else
+                {
+                    __m512i u = guard(x, two_q);
+                    __m512i v = mul_root_lazy<QuotientBits>(y, w, w_quot, q);
+                    x = _mm512_add_epi64(u, v);
+                    y = _mm512_sub_epi64(_mm512_add_epi64(u, two_q), v);
+                }
+            }
+
+            // A layer of m groups with gap at least 8; every group uses a single root
+            template <int QuotientBits, bool Inverse>
+            void large_gap_layer(
+                uint64_t *values, size_t m, size_t gap, const uint64_t *roots, __m512i q, __m512i two_q)
+            {
+                for (size_t i = 0; i < m; i++, roots += 2)
+                {
+                    __m512i w = _mm512_set1_epi64(static_cast<long long>(roots[0]));
+                    __m512i w_quot = load_quotient<QuotientBits>(_mm512_set1_epi64(static_cast<long long>(roots[1])));
+                    uint64_t *x_ptr = values + 2 * gap * i;
+                    uint64_t *y_ptr = x_ptr + gap;
+                    for (size_t j = 0; j < gap; j += 8)
+                    {
+                        __m512i x = _mm512_loadu_si512(x_ptr + j);
+                        __m512i y = _mm512_loadu_si512(y_ptr + j);
+                        butterfly<QuotientBits, Inverse>(x, y, w, w_quot, q, two_q);
+                        _mm512_storeu_si512(x_ptr + j, x);
+                        _mm512_storeu_si512(y_ptr + j, y);
+                    }
+                }
+            }
+
+            // Lane permutations for the layers with gap 1, 2, and 4, which operate on 16 values at a time: the
+            // indices select the x and y operands from the 16 values, put the results back in place, and select the
+            // root and quotient for each lane from the (operand, quotient) pairs of the 8 / gap groups.
+            alignas(64) const uint64_t small_gap_indices[3][6][8] = {
+                { { 0, 2, 4, 6, 8, 10, 12, 14 },
+                  { 1, 3, 5, 7, 9, 11, 13, 15 },
+                  { 0, 8, 1, 9, 2, 10, 3, 11 },
+                  { 4, 12, 5, 13, 6, 14, 7, 15 },
+                  { 0, 2, 4, 6, 8, 10, 12, 14 },
+                  { 1, 3, 5, 7, 9, 11, 13, 15 } },
+                { { 0, 1, 4, 5, 8, 9, 12, 13 },
+                  { 2, 3, 6, 7, 10, 11, 14, 15 },
+                  { 0, 1, 8, 9, 2, 3, 10, 11 },
+                  { 4, 5, 12, 13, 6, 7, 14, 15 },
+                  { 0, 0, 2, 2, 4, 4, 6, 6 },
+                  { 1, 1, 3, 3, 5, 5, 7, 7 } },
+                { { 0, 1, 2, 3, 8, 9, 10, 11 },
+                  { 4, 5, 6, 7, 12, 13, 14, 15 },
+                  { 0, 1, 2, 3, 8, 9, 10, 11 },
+                  { 4, 5, 6, 7, 12, 13, 14, 15 },
+                  { 0, 0, 0, 0, 2, 2, 2, 2 },
+                  { 1, 1, 1, 1, 3, 3, 3, 3 } }
+            };
+
+            // A layer of m groups with gap 2^log_gap < 8
+            template <int QuotientBits, bool Inverse>
+            void small_gap_layer(
+                uint64_t *values, size_t m, int log_gap, const uint64_t *roots, __m512i q, __m512i two_q)
+            {
+                const auto &indices = small_gap_indices[log_gap];
+                __m512i x_index = _mm512_load_si512(indices[0]);
+                __m512i y_index = _mm512_load_si512(indices[1]);
+                __m512i lo_index = _mm512_load_si512(indices[2]);
+                __m512i hi_index = _mm512_load_si512(indices[3]);
+                __m512i w_index = _mm512_load_si512(indices[4]);
+                __m512i w_quot_index = _mm512_load_si512(indices[5]);
+
+                // Each step reads the roots of 8 / gap groups, i.e., 16 / gap words
+                size_t group_count = size_t(8) >> log_gap;
+                size_t root_word_count = group_count << 1;
+                __mmask8 root_mask = static_cast<__mmask8>((root_word_count >= 8) ? 0xFF : (1 << root_word_count) - 1);
+                __m512i zero = _mm512_setzero_si512();
+                for (size_t i = 0; i < m; i += group_count, roots += root_word_count, values += 16)
+                {
+                    __m512i v0 = _mm512_loadu_si512(values);
+                    __m512i v1 = _mm512_loadu_si512(values + 8);
+                    __m512i x = _mm512_permutex2var_epi64(v0, x_index, v1);
+                    __m512i y = _mm512_permutex2var_epi64(v0, y_index, v1);
+
+                    __m512i r0 = _mm512_maskz_loadu_epi64(root_mask, roots);
+                    __m512i r1 = (root_word_count > 8) ? _mm512_loadu_si512(roots + 8) : zero;
+                    __m512i w = _mm512_permutex2var_epi64(r0, w_index, r1);
+                    __m512i w_quot = load_quotient<QuotientBits>(_mm512_permutex2var_epi64(r0, w_quot_index, r1));
+
+                    butterfly<QuotientBits, Inverse>(x, y, w, w_quot, q, two_q);
+                    _mm512_storeu_si512(values, _mm512_permutex2var_epi64(x, lo_index, y));
+                    _mm512_storeu_si512(values + 8, _mm512_permutex2var_epi64(x, hi_index, y));
+                }
+            }
+
+            // Last layer of transform_from_rev, which also multiplies by n^(-1): s is n^(-1) and w is the root
+            // multiplied by n^(-1)
+            template <int QuotientBits>
+            inline void scaled_inverse_butterfly(
+                __m512i &x, __m512i &y, __m512i s, __m512i s_quot, __m512i w, __m512i w_quot, __m512i q,
+                __m512i two_q)
+            {
+                __m512i u = guard(x, two_q);
+                x = mul_root_lazy<QuotientBits>(guard(_mm512_add_epi64(u, y), two_q), s, s_quot, q);
+                y = mul_root_lazy<QuotientBits>(_mm512_sub_epi64(_mm512_add_epi64(u, two_q), y), w, w_quot, q);
+            }
+
+            // Broadcasts the (operand, quotient) pair at root
+            template <int QuotientBits>
+            inline void load_root(const uint64_t *root, __m512i &w, __m512i &w_quot)
+            {
+                w = _mm512_set1_epi64(static_cast<long long>(root[0]));
+                w_quot = load_quotient<QuotientBits>(_mm512_set1_epi64(static_cast<long long>(root[1])));
+            }
+
+            // The layer of m groups with the given gap followed by the next layer, whose gap is at least 8, with each
+            // group of four values loaded and stored once; roots points to the first root of the first layer
+            template <int QuotientBits>
+            void radix4_forward_layers(
+                uint64_t *values, size_t m, size_t gap, const uint64_t *roots, __m512i q, __m512i two_q)
+            {
+                size_t quarter = gap >> 1;
+                for (size_t i = 0; i < m; i++)
+                {
+                    // The next layer starts 2 * m words later and this group is split into its groups 2i and 2i + 1
+                    __m512i w, w_quot, w0, w0_quot, w1, w1_quot;
+                    load_root<QuotientBits>(roots + 2 * i, w, w_quot);
+                    load_root<QuotientBits>(roots + 2 * (m + 2 * i), w0, w0_quot);
+                    load_root<QuotientBits>(roots + 2 * (m + 2 * i) + 2, w1, w1_quot);
+                    uint64_t *x0_ptr = values + 2 * gap * i;
+                    uint64_t *x1_ptr = x0_ptr + quarter;
+                    uint64_t *x2_ptr = x1_ptr + quarter;
+                    uint64_t *x3_ptr = x2_ptr + quarter;
+                    for (size_t j = 0; j < quarter; j += 8)
+                    {
+                        __m512i x0 = _mm512_loadu_si512(x0_ptr + j);
+                        __m512i x1 = _mm512_loadu_si512(x1_ptr + j);
+                        __m512i x2 = _mm512_loadu_si512(x2_ptr + j);
+                        __m512i x3 = _mm512_loadu_si512(x3_ptr + j);
+                        butterfly<QuotientBits, false>(x0, x2, w, w_quot, q, two_q);
+                        butterfly<QuotientBits, false>(x1, x3, w, w_quot, q, two_q);
+                        butterfly<QuotientBits, false>(x0, x1, w0, w0_quot, q, two_q);
+                        butterfly<QuotientBits, false>(x2, x3, w1, w1_quot, q, two_q);
+                        _mm512_storeu_si512(x0_ptr + j, x0);
+                        _mm512_storeu_si512(x1_ptr + j, x1);
+                        _mm512_storeu_si512(x2_ptr + j, x2);
+                        _mm512_storeu_si512(x3_ptr + j, x3);
+                    }
+                }
+            }
+
+            // The inverse layer of m groups with the given gap at least 8 followed by the next layer; first_roots
+            // and second_roots point to the first roots of the two layers. If Scaled, the second layer is the last
+            // layer and second_roots is scaled_last_inv_root.
+            template <int QuotientBits, bool Scaled>
+            void radix4_inverse_layers(
+                uint64_t *values, size_t m, size_t gap, const uint64_t *first_roots, const uint64_t *second_roots,
+                const uint64_t *inv_degree_modulo, __m512i q, __m512i two_q)
+            {
+                __m512i s = _mm512_setzero_si512();
+                __m512i s_quot = s;
+                if (Scaled)
+                {
+                    load_root<QuotientBits>(inv_degree_modulo, s, s_quot);
+                }
+                for (size_t i = 0; i < (m >> 1); i++)
+                {
+                    __m512i w0, w0_quot, w1, w1_quot, w, w_quot;
+                    load_root<QuotientBits>(first_roots + 4 * i, w0, w0_quot);
+                    load_root<QuotientBits>(first_roots + 4 * i + 2, w1, w1_quot);
+                    load_root<QuotientBits>(second_roots + 2 * i, w, w_quot);
+                    uint64_t *x0_ptr = values + 4 * gap * i;
+                    uint64_t *x1_ptr = x0_ptr + gap;
+                    uint64_t *x2_ptr = x1_ptr + gap;
+                    uint64_t *x3_ptr = x2_ptr + gap;
+                    for (size_t j = 0; j < gap; j += 8)
+                    {
+                        __m512i x0 = _mm512_loadu_si512(x0_ptr + j);
+                        __m512i x1 = _mm512_loadu_si512(x1_ptr + j);
+                        __m512i x2 = _mm512_loadu_si512(x2_ptr + j);
+                        __m512i x3 = _mm512_loadu_si512(x3_ptr + j);
+                        butterfly<QuotientBits, true>(x0, x1, w0, w0_quot, q, two_q);
+                        butterfly<QuotientBits, true>(x2, x3, w1, w1_quot, q, two_q);
+                        if (Scaled)
+                        {
+                            scaled_inverse_butterfly<QuotientBits>(x0, x2, s, s_quot, w, w_quot, q, two_q);
+                            scaled_inverse_butterfly<QuotientBits>(x1, x3, s, s_quot, w, w_quot, q, two_q);
+                        }
+                        else
+                        {
+                            butterfly<QuotientBits, true>(x0, x2, w, w_quot, q, two_q);
+                            butterfly<QuotientBits, true>(x1, x3, w, w_quot, q, two_q);
+                        }
+                        _mm512_storeu_si512(x0_ptr + j, x0);
+                        _mm512_storeu_si512(x1_ptr + j, x1);
+                        _mm512_storeu_si512(x2_ptr + j, x2);
+                        _mm512_storeu_si512(x3_ptr + j, x3);
+                    }
+                }
+            }
+
+            // The last inverse layer, with a single group
+            template <int QuotientBits>
+            void scaled_last_layer(
+                uint64_t *values, size_t gap, const uint64_t *inv_degree_modulo, const uint64_t *scaled_last_inv_root,
+                __m512i q, __m512i two_q)
+            {
+                __m512i s, s_quot, w, w_quot;
+                load_root<QuotientBits>(inv_degree_modulo, s, s_quot);
+                load_root<QuotientBits>(scaled_last_inv_root, w, w_quot);
+                uint64_t *x_ptr = values;
+                uint64_t *y_ptr = values + gap;
+                for (size_t j = 0; j < gap; j += 8)
+                {
+                    __m512i x = _mm512_loadu_si512(x_ptr + j);
+                    __m512i y = _mm512_loadu_si512(y_ptr + j);
+                    scaled_inverse_butterfly<QuotientBits>(x, y, s, s_quot, w, w_quot, q, two_q);
+                    _mm512_storeu_si512(x_ptr + j, x);
+                    _mm512_storeu_si512(y_ptr + j, y);
+                }
+            }
+
+            // Same as DWTHandler::transform_to_rev
+            template <int QuotientBits>
+            void transform_to_rev(uint64_t *values, int log_n, const uint64_t *root_powers, __m512i q, __m512i two_q)
+            {
+                size_t n = size_t(1) << log_n;
+
+                // The roots of each layer follow those of the previous layer, starting from the power at index 1
+                const uint64_t *roots = root_powers + 2;
+                size_t m = 1;
+                size_t gap = n >> 1;
+                for (; gap >= 8; m <<= 1, gap >>= 1)
+                {
+                    large_gap_layer<QuotientBits, false>(values, m, gap, roots, q, two_q);
+                    roots += 2 * m;
+                }
+                for (int log_gap = 2; log_gap >= 0; log_gap--, m <<= 1)
+                {
+                    small_gap_layer<QuotientBits, false>(values, m, log_gap, roots, q, two_q);
+                    roots += 2 * m;
+                }
+            }
+
+            // Same as DWTHandler::transform_from_rev; the last layer multiplies by n^(-1) only if inv_degree_modulo
+            // is given
+            template <int QuotientBits>
+            void transform_from_rev(
+                uint64_t *values, int log_n, const uint64_t *inv_root_powers, const uint64_t *inv_degree_modulo,
+                const uint64_t *scaled_last_inv_root, __m512i q, __m512i two_q)
+            {
+                size_t n = size_t(1) << log_n;
+                const uint64_t *roots = inv_root_powers + 2;
+                size_t m = n >> 1;
+                for (int log_gap = 0; log_gap <= 2; log_gap++, m >>= 1)
+                {
+                    small_gap_layer<QuotientBits, true>(values, m, log_gap, roots, q, two_q);
+                    roots += 2 * m;
+                }
+                size_t gap = 8;
+                for (; m > 1; m >>= 1, gap <<= 1)
+                {
+                    large_gap_layer<QuotientBits, true>(values, m, gap, roots, q, two_q);
+                    roots += 2 * m;
+                }
+
+                // The last layer also multiplies by n^(-1), which is merged into its root
+                if (inv_degree_modulo)
+                {
+                    scaled_last_layer<QuotientBits>(values, gap, inv_degree_modulo, scaled_last_inv_root, q, two_q);
+                }
+                else
+                {
+                    large_gap_layer<QuotientBits, true>(values, 1, gap, roots, q, two_q);
+                }
+            }
+
+            // Same as DWTHandler::transform_to_rev_blocked
+            template <int QuotientBits>
+            void transform_to_rev_blocked(
+                uint64_t *values, int log_n, const uint64_t *root_powers, int log_block, const uint64_t *block_roots,
+                uint64_t modulus)
+            {
+                size_t n = size_t(1) << log_n;
+                size_t block = size_t(1) << log_block;
+                __m512i q = _mm512_set1_epi64(static_cast<long long>(modulus));
+                __m512i two_q = _mm512_set1_epi64(static_cast<long long>(modulus << 1));
+
+                size_t m = 1;
+                size_t gap = n >> 1;
+                for (; (gap >> 1) >= block; m <<= 2, gap >>= 2)
+                {
+                    radix4_forward_layers<QuotientBits>(values, m, gap, root_powers + 2 * m, q, two_q);
+                }
+                if (gap >= block)
+                {
+                    large_gap_layer<QuotientBits, false>(values, m, gap, root_powers + 2 * m, q, two_q);
+                }
+                for (size_t offset = 0; offset < n; offset += block)
+                {
+                    transform_to_rev<QuotientBits>(values + offset, log_block, block_roots + 2 * offset, q, two_q);
+                }
+            }
+
+            // Same as DWTHandler::transform_from_rev_blocked
+            template <int QuotientBits>
+            void transform_from_rev_blocked(
+                uint64_t *values, int log_n, const uint64_t *inv_root_powers, int log_block,
+                const uint64_t *block_inv_roots, uint64_t modulus, const uint64_t *inv_degree_modulo,
+                const uint64_t *scaled_last_inv_root)
+            {
+                __m512i q = _mm512_set1_epi64(static_cast<long long>(modulus));
+                __m512i two_q = _mm512_set1_epi64(static_cast<long long>(modulus << 1));
+                if (log_block == log_n)
+                {
+                    transform_from_rev<QuotientBits>(
+                        values, log_n, inv_root_powers, inv_degree_modulo, scaled_last_inv_root, q, two_q);
+                    return;
+                }
+
+                size_t n = size_t(1) << log_n;
+                size_t block = size_t(1) << log_block;
+                for (size_t offset = 0; offset < n; offset += block)
+                {
+                    transform_from_rev<QuotientBits>(
+                        values + offset, log_block, block_inv_roots + 2 * offset, nullptr, nullptr, q, two_q);
+                }
+
+                // The layer with m groups uses the powers starting from index n - 2m + 1
+                size_t m = n >> (log_block + 1);
+                size_t gap = block;
+                int layer_count = log_n - log_block;
+                if ((layer_count & 1) && layer_count > 1)
+                {
+                    large_gap_layer<QuotientBits, true>(
+                        values, m, gap, inv_root_powers + 2 * (n - 2 * m + 1), q, two_q);
+                    m >>= 1;
+                    gap <<= 1;
+                    layer_count--;
+                }
+                for (; layer_count > 2; m >>= 2, gap <<= 2, layer_count -= 2)
+                {
+                    radix4_inverse_layers<QuotientBits, false>(
+                        values, m, gap, inv_root_powers + 2 * (n - 2 * m + 1), inv_root_powers + 2 * (n - m + 1),
+                        nullptr, q, two_q);
+                }
+                if (layer_count == 2)
+                {
+                    radix4_inverse_layers<QuotientBits, true>(
+                        values, m, gap, inv_root_powers + 2 * (n - 2 * m + 1), scaled_last_inv_root,
+                        inv_degree_modulo, q, two_q);
+                }
+                else
+                {
+                    scaled_last_layer<QuotientBits>(values, gap, inv_degree_modulo, scaled_last_inv_root, q, two_q);
+                }
+            }
+        } // namespace
+
+        void ntt_negacyclic_harvey_lazy_avx512(
+            uint64_t *operand, int coeff_count_power, const uint64_t *root_powers, int block_coeff_count_power,
+            const uint64_t *block_root_powers, uint64_t modulus)
+        {
+            if (modulus < narrow_modulus_bound)
+            {
+                transform_to_rev_blocked<32>(
+                    operand, coeff_count_power, root_powers, block_coeff_count_power, block_root_powers, modulus);
+                return;
+            }
+            transform_to_rev_blocked<64>(
+                operand, coeff_count_power, root_powers, block_coeff_count_power, block_root_powers, modulus);
+        }
+
+        void inverse_ntt_negacyclic_harvey_lazy_avx512(
+            uint64_t *operand, int coeff_count_power, const uint64_t *inv_root_powers, int block_coeff_count_power,
+            const uint64_t *block_inv_root_powers, uint64_t modulus, const uint64_t *inv_degree_modulo,
+            const uint64_t *scaled_last_inv_root)
+        {
+            if (modulus < narrow_modulus_bound)
+            {
+                transform_from_rev_blocked<32>(
+                    operand, coeff_count_power, inv_root_powers, block_coeff_count_power, block_inv_root_powers,
+                    modulus, inv_degree_modulo, scaled_last_inv_root);
+                return;
+            }
+            transform_from_rev_blocked<64>(
+                operand, coeff_count_power, inv_root_powers, block_coeff_count_power, block_inv_root_powers, modulus,
+                inv_degree_modulo, scaled_last_inv_root);
+        }
+
+        void ntt_negacyclic_harvey_lazy_avx512ifma(
+            uint64_t *operand, int coeff_count_power, const uint64_t *root_powers, int block_coeff_count_power,
+            const uint64_t *block_root_powers, uint64_t modulus)
+        {
+            transform_to_rev_blocked<52>(
+                operand, coeff_count_power, root_powers, block_coeff_count_power, block_root_powers, modulus);
+        }
+
+        void inverse_ntt_negacyclic_harvey_lazy_avx512ifma(
+            uint64_t *operand, int coeff_count_power, const uint64_t *inv_root_powers, int block_coeff_count_power,
+            const uint64_t *block_inv_root_powers, uint64_t modulus, const uint64_t *inv_degree_modulo,
+            const uint64_t *scaled_last_inv_root)
+        {
+            transform_from_rev_blocked<52>(
+                operand, coeff_count_power, inv_root_powers, block_coeff_count_power, block_inv_root_powers, modulus,
+                inv_degree_modulo, scaled_last_inv_root);
+        }
+
+        void ntt_negacyclic_harvey_reduce_avx512(
+            uint64_t *operand, int coeff_count_power, uint64_t modulus, bool inverse)
+        {
+            size_t n = size_t(1) << coeff_count_power;
+            __m512i q = _mm512_set1_epi64(static_cast<long long>(modulus));
+            __m512i two_q = _mm512_set1_epi64(static_cast<long long>(modulus << 1));
+            if (inverse)
+            {
+                for (size_t j = 0; j < n; j += 8)
+                {
+                    _mm512_storeu_si512(operand + j, guard(_mm512_loadu_si512(operand + j), q));
+                }
+            }
+            else
+            {
+                for (size_t j = 0; j < n; j += 8)
+                {
+                    _mm512_storeu_si512(operand + j, guard(guard(_mm512_loadu_si512(operand + j), two_q), q));
+                }
+            }
+        }
+    } // namespace util
+} // namespace seal
+#endif
@@ -21,6 +21,8 @@ namespace seal
         {
             friend class MemoryPoolST;
             friend class MemoryPoolMT;
+            friend class MemoryPoolSC;
+            friend class MemoryPoolArena;
 
         public:
             template <typename, typename>
@@ -43,14 +45,14 @@ namespace seal
             // Move of the same type
             Pointer(Pointer<seal_byte> &&source, seal_byte value) : Pointer(std::move(source))
             {
-                std::fill_n(data_, head_->item_byte_count(), value);
+                std::fill_n(data_, item_->byte_count(), value);
             }
 
             // Copy a range of elements
             template <typename InputIt>
             Pointer(InputIt first, Pointer<seal_byte> &&source) : Pointer(std::move(source))
             {
-                std::copy_n(first, head_->item_byte_count(), data_);
+                std::copy_n(first, item_->byte_count(), data_);
             }
 
             SEAL_NODISCARD inline seal_byte &operator[](std::size_t index)
@@ -178,6 +180,11 @@ namespace seal
                 data_ = item_->data();
             }
 
+            // Takes ownership of an item that was already obtained from head
+            Pointer(class MemoryPoolHead *head, MemoryPoolItem *item) noexcept
+                : data_(item->data()), head_(head), item_(item)
+            {}
+
             seal_byte *data_ = nullptr;
 
             MemoryPoolHead *head_ = nullptr;
@@ -192,6 +199,8 @@ namespace seal
         {
             friend class MemoryPoolST;
             friend class MemoryPoolMT;
+            friend class MemoryPoolSC;
+            friend class MemoryPoolArena;
 
         public:
             friend class Pointer<seal_byte>;
@@ -226,7 +235,7 @@ namespace seal
                     data_ = reinterpret_cast<T *>(item_->data());
                     SEAL_IF_CONSTEXPR(!std::is_trivially_constructible<T>::value)
                     {
-                        auto count = head_->item_byte_count() / sizeof(T);
+                        auto count = item_->byte_count() / sizeof(T);
                         for (auto alloc_ptr = data_; count--; alloc_ptr++)
                         {
                             new (alloc_ptr) T;
@@ -256,7 +265,7 @@ namespace seal
                 if (head_)
                 {
                     data_ = reinterpret_cast<T *>(item_->data());
-                    auto count = head_->item_byte_count() / sizeof(T);
+                    auto count = item_->byte_count() / sizeof(T);
                     for (auto alloc_ptr = data_; count--; alloc_ptr++)
                     {
                         new (alloc_ptr) T(std::forward<Args>(args)...);
@@ -285,7 +294,7 @@ namespace seal
                 if (head_)
                 {
                     data_ = reinterpret_cast<T *>(item_->data());
-                    auto count = head_->item_byte_count() / sizeof(T);
+                    auto count = item_->byte_count() / sizeof(T);
                     std::uninitialized_copy_n(first, count, data_);
                 }
                 alias_ = source.alias_;
@@ -350,7 +359,7 @@ namespace seal
                     SEAL_IF_CONSTEXPR(!std::is_trivially_destructible<T>::value)
                     {
                         // Manual destructor calls
-                        auto count = head_->item_byte_count() / sizeof(T);
+                        auto count = item_->byte_count() / sizeof(T);
                         for (auto alloc_ptr = data_; count--; alloc_ptr++)
                         {
                             alloc_ptr->~T();
@@ -413,7 +422,7 @@ namespace seal
                     data_ = reinterpret_cast<T *>(item_->data());
                     SEAL_IF_CONSTEXPR(!std::is_trivially_constructible<T>::value)
                     {
-                        auto count = head_->item_byte_count() / sizeof(T);
+                        auto count = item_->byte_count() / sizeof(T);
                         for (auto alloc_ptr = data_; count--; alloc_ptr++)
                         {
                             new (alloc_ptr) T;
@@ -473,7 +482,7 @@ namespace seal
                 data_ = reinterpret_cast<T *>(item_->data());
                 SEAL_IF_CONSTEXPR(!std::is_trivially_constructible<T>::value)
                 {
-                    auto count = head_->item_byte_count() / sizeof(T);
+                    auto count = item_->byte_count() / sizeof(T);
                     for (auto alloc_ptr = data_; count--; alloc_ptr++)
                     {
                         new (alloc_ptr) T;
@@ -493,7 +502,7 @@ namespace seal
                 head_ = head;
                 item_ = head->get();
                 data_ = reinterpret_cast<T *>(item_->data());
-                auto count = head_->item_byte_count() / sizeof(T);
+                auto count = item_->byte_count() / sizeof(T);
                 for (auto alloc_ptr = data_; count--; alloc_ptr++)
                 {
                     new (alloc_ptr) T(std::forward<Args>(args)...);
@@ -512,7 +521,7 @@ namespace seal
                 head_ = head;
                 item_ = head->get();
                 data_ = reinterpret_cast<T *>(item_->data());
-                auto count = head_->item_byte_count() / sizeof(T);
+                auto count = item_->byte_count() / sizeof(T);
                 std::uninitialized_copy_n(first, count, data_);
             }
 
@@ -531,6 +540,8 @@ namespace seal
         {
             friend class MemoryPoolST;
             friend class MemoryPoolMT;
+            friend class MemoryPoolSC;
+            friend class MemoryPoolArena;
 
         public:
             template <typename, typename>
@@ -551,7 +562,7 @@ namespace seal
             // Move of the same type
             ConstPointer(Pointer<seal_byte> &&source, seal_byte value) : ConstPointer(std::move(source))
             {
-                std::fill_n(data_, head_->item_byte_count(), value);
+                std::fill_n(data_, item_->byte_count(), value);
             }
 
             // Move of the same type
@@ -567,14 +578,14 @@ namespace seal
             // Move of the same type
             ConstPointer(ConstPointer<seal_byte> &&source, seal_byte value) : ConstPointer(std::move(source))
             {
-                std::fill_n(data_, head_->item_byte_count(), value);
+                std::fill_n(data_, item_->byte_count(), value);
             }
 
             // Copy a range of elements
             template <typename InputIt>
             ConstPointer(InputIt first, ConstPointer<seal_byte> &&source) : ConstPointer(std::move(source))
             {
-                std::copy_n(first, head_->item_byte_count(), data_);
+                std::copy_n(first, item_->byte_count(), data_);
             }
 
             inline auto &operator=(ConstPointer<seal_byte> &&assign) noexcept
@@ -731,6 +742,8 @@ namespace seal
         {
             friend class MemoryPoolST;
             friend class MemoryPoolMT;
+            friend class MemoryPoolSC;
+            friend class MemoryPoolArena;
 
         public:
             ConstPointer() = default;
@@ -761,7 +774,7 @@ namespace seal
                     data_ = reinterpret_cast<T *>(item_->data());
                     SEAL_IF_CONSTEXPR(!std::is_trivially_constructible<T>::value)
                     {
-                        auto count = head_->item_byte_count() / sizeof(T);
+                        auto count = item_->byte_count() / sizeof(T);
                         for (auto alloc_ptr = data_; count--; alloc_ptr++)
                         {
                             new (alloc_ptr) T;
@@ -791,7 +804,7 @@ namespace seal
                 if (head_)
                 {
                     data_ = reinterpret_cast<T *>(item_->data());
-                    auto count = head_->item_byte_count() / sizeof(T);
+                    auto count = item_->byte_count() / sizeof(T);
                     for (auto alloc_ptr = data_; count--; alloc_ptr++)
                     {
                         new (alloc_ptr) T(std::forward<Args>(args)...);
@@ -820,7 +833,7 @@ namespace seal
                 if (head_)
                 {
                     data_ = reinterpret_cast<T *>(item_->data());
-                    auto count = head_->item_byte_count() / sizeof(T);
+                    auto count = item_->byte_count() / sizeof(T);
                     std::uninitialized_copy_n(first, count, data_);
                 }
                 alias_ = source.alias_;
@@ -857,7 +870,7 @@ namespace seal
                     data_ = reinterpret_cast<T *>(item_->data());
                     SEAL_IF_CONSTEXPR(!std::is_trivially_constructible<T>::value)
                     {
-                        auto count = head_->item_byte_count() / sizeof(T);
+                        auto count = item_->byte_count() / sizeof(T);
                         for (auto alloc_ptr = data_; count--; alloc_ptr++)
                         {
                             new (alloc_ptr) T;
@@ -887,7 +900,7 @@ namespace seal
                 if (head_)
                 {
                     data_ = reinterpret_cast<T *>(item_->data());
-                    auto count = head_->item_byte_count() / sizeof(T);
+                    auto count = item_->byte_count() / sizeof(T);
                     for (auto alloc_ptr = data_; count--; alloc_ptr++)
                     {
                         new (alloc_ptr) T(std::forward<Args>(args)...);
@@ -916,7 +929,7 @@ namespace seal
                 if (head_)
                 {
                     data_ = reinterpret_cast<T *>(item_->data());
-                    auto count = head_->item_byte_count() / sizeof(T);
+                    auto count = item_->byte_count() / sizeof(T);
                     std::uninitialized_copy_n(first, count, data_);
                 }
                 alias_ = source.alias_;
@@ -983,7 +996,7 @@ namespace seal
                     SEAL_IF_CONSTEXPR(!std::is_trivially_destructible<T>::value)
                     {
                         // Manual destructor calls
-                        auto count = head_->item_byte_count() / sizeof(T);
+                        auto count = item_->byte_count() / sizeof(T);
                         for (auto alloc_ptr = data_; count--; alloc_ptr++)
                         {
                             alloc_ptr->~T();
@@ -1046,7 +1059,7 @@ namespace seal
                     data_ = reinterpret_cast<T *>(item_->data());
                     SEAL_IF_CONSTEXPR(!std::is_trivially_constructible<T>::value)
                     {
-                        auto count = head_->item_byte_count() / sizeof(T);
+                        auto count = item_->byte_count() / sizeof(T);
                         for (auto alloc_ptr = data_; count--; alloc_ptr++)
                         {
                             new (alloc_ptr) T;
@@ -1101,7 +1114,7 @@ namespace seal
                     data_ = reinterpret_cast<T *>(item_->data());
                     SEAL_IF_CONSTEXPR(!std::is_trivially_constructible<T>::value)
                     {
-                        auto count = head_->item_byte_count() / sizeof(T);
+                        auto count = item_->byte_count() / sizeof(T);
                         for (auto alloc_ptr = data_; count--; alloc_ptr++)
                         {
                             new (alloc_ptr) T;
@@ -1161,7 +1174,7 @@ namespace seal
                 data_ = reinterpret_cast<T *>(item_->data());
                 SEAL_IF_CONSTEXPR(!std::is_trivially_constructible<T>::value)
                 {
-                    auto count = head_->item_byte_count() / sizeof(T);
+                    auto count = item_->byte_count() / sizeof(T);
                     for (auto alloc_ptr = data_; count--; alloc_ptr++)
                     {
                         new (alloc_ptr) T;
@@ -1181,7 +1194,7 @@ namespace seal
                 head_ = head;
                 item_ = head->get();
                 data_ = reinterpret_cast<T *>(item_->data());
-                auto count = head_->item_byte_count() / sizeof(T);
+                auto count = item_->byte_count() / sizeof(T);
                 for (auto alloc_ptr = data_; count--; alloc_ptr++)
                 {
                     new (alloc_ptr) T(std::forward<Args>(args)...);
@@ -1200,7 +1213,7 @@ namespace seal
                 head_ = head;
                 item_ = head->get();
                 data_ = reinterpret_cast<T *>(item_->data());
-                auto count = head_->item_byte_count() / sizeof(T);
+                auto count = item_->byte_count() / sizeof(T);
                 std::uninitialized_copy_n(first, count, data_);
             }
 
@@ -0,0 +1,90 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "seal/util/config.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace seal
+{
+    namespace util
+    {
+        /*
+        Vectorized counterparts of the element-wise functions of polyarithsmallmod.h on a single RNS component. As for
+        the NTT kernels in nttavx.h, each instruction set lives in a translation unit of its own that includes no other
+        headers of the library but avxarith.h, and these functions must only be called after checking that the CPU
+        supports the instruction set (see polyarith_kernel_supported in polyarithsmallmod.h). They take plain arrays of
+        coeff_count values, which need not be a multiple of the vector width, and result may alias the operands:
+
+        - add_poly_coeffmod and sub_poly_coeffmod take operands less than modulus, which is at most 61 bits;
+        - multiply_poly_scalar_coeffmod takes any 64-bit values and a scalar with its quotient
+          floor(scalar * 2^64 / modulus) as in MultiplyUIntModOperand, for modulus of at most 61 bits;
+        - dyadic_product_coeffmod takes modulus of modulus_bit_count bits, where modulus_bit_count is between 2 and
+          59, and barrett_ratio = floor(2^(modulus_bit_count + 63) / modulus); each product of operands must be less
+          than 2^(modulus_bit_count + 63), which holds for instance when both operands are less than 4 * modulus;
+          for narrow moduli, which are less than 2^30, both operands must be less than 4 * modulus, and the products
+          take 32x32-bit lane multiplications;
+        - dyadic_product_montgomery_coeffmod takes an odd modulus of at most 61 bits with montgomery_inverse equal to
+          modulus^(-1) mod 2^64, any 64-bit values in operand1, and values less than modulus in operand2;
+        - linear_combination_poly_coeffmod takes poly_count polynomials of coeff_count coefficients stored one after
+          another in polys, any 64-bit values, and poly_count scalars with their quotients stored in pairs as in
+          MultiplyUIntModOperand, for modulus of at most 61 bits; result must not alias polys. If narrow_input is
+          true, the values of polys must be less than 2^32, and for narrow moduli the products then take 32x32-bit
+          lane multiplications.
+
+        All results are in [0, modulus).
+        */
+#ifdef SEAL_USE_AVX2_NTT
+        void add_poly_coeffmod_avx2(
+            const std::uint64_t *operand1, const std::uint64_t *operand2, std::size_t coeff_count,
+            std::uint64_t modulus, std::uint64_t *result);
+
+        void sub_poly_coeffmod_avx2(
+            const std::uint64_t *operand1, const std::uint64_t *operand2, std::size_t coeff_count,
+            std::uint64_t modulus, std::uint64_t *result);
+
+        void multiply_poly_scalar_coeffmod_avx2(
+            const std::uint64_t *poly, std::size_t coeff_count, std::uint64_t scalar, std::uint64_t scalar_quotient,
+            std::uint64_t modulus, std::uint64_t *result);
+
+        void dyadic_product_coeffmod_avx2(
+            const std::uint64_t *operand1, const std::uint64_t *operand2, std::size_t coeff_count,
+            std::uint64_t modulus, int modulus_bit_count, std::uint64_t barrett_ratio, std::uint64_t *result);
+
+        void dyadic_product_montgomery_coeffmod_avx2(
+            const std::uint64_t *operand1, const std::uint64_t *operand2, std::size_t coeff_count,
+            std::uint64_t modulus, std::uint64_t montgomery_inverse, std::uint64_t *result);
+
+        void linear_combination_poly_coeffmod_avx2(
+            const std::uint64_t *polys, std::size_t poly_count, std::size_t coeff_count, const std::uint64_t *scalars,
+            std::uint64_t modulus, bool narrow_input, std::uint64_t *result);
+#endif
+#ifdef SEAL_USE_AVX512_NTT
+        void add_poly_coeffmod_avx512(
+            const std::uint64_t *operand1, const std::uint64_t *operand2, std::size_t coeff_count,
+            std::uint64_t modulus, std::uint64_t *result);
+
+        void sub_poly_coeffmod_avx512(
+            const std::uint64_t *operand1, const std::uint64_t *operand2, std::size_t coeff_count,
+            std::uint64_t modulus, std::uint64_t *result);
+
+        void multiply_poly_scalar_coeffmod_avx512(
+            const std::uint64_t *poly, std::size_t coeff_count, std::uint64_t scalar, std::uint64_t scalar_quotient,
+            std::uint64_t modulus, std::uint64_t *result);
+
+        void dyadic_product_coeffmod_avx512(
+            const std::uint64_t *operand1, const std::uint64_t *operand2, std::size_t coeff_count,
+            std::uint64_t modulus, int modulus_bit_count, std::uint64_t barrett_ratio, std::uint64_t *result);
+
+        void dyadic_product_montgomery_coeffmod_avx512(
+            const std::uint64_t *operand1, const std::uint64_t *operand2, std::size_t coeff_count,
+            std::uint64_t modulus, std::uint64_t montgomery_inverse, std::uint64_t *result);
+
+        void linear_combination_poly_coeffmod_avx512(
+            const std::uint64_t *polys, std::size_t poly_count, std::size_t coeff_count, const std::uint64_t *scalars,
+            std::uint64_t modulus, bool narrow_input, std::uint64_t *result);
+#endif
+    } // namespace util
+} // namespace seal
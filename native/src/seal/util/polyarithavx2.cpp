@@ -0,0 +1,206 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+// This file is compiled with AVX2 enabled; see polyarithavx.h for why it must not include other headers of the library.
+#include "seal/util/polyarithavx.h"
+
+#ifdef SEAL_USE_AVX2_NTT
+#include "seal/util/avxarith.h"
+#include <immintrin.h>
+
+using namespace std;
+
+namespace seal
+{
+    namespace util
+    {
+        namespace
+        {
+            // Mask of the first count lanes, for count less than 4
+            inline __m256i tail_mask(size_t count)
+            {
+                return _mm256_cmpgt_epi64(
+                    _mm256_set1_epi64x(static_cast<long long>(count)), _mm256_setr_epi64x(0, 1, 2, 3));
+            }
+
+            inline __m256i load(const uint64_t *ptr)
+            {
+                return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr));
+            }
+
+            inline __m256i load(const uint64_t *ptr, __m256i mask)
+            {
+                return _mm256_maskload_epi64(reinterpret_cast<const long long *>(ptr), mask);
+            }
+
+            inline void store(uint64_t *ptr, __m256i value)
+            {
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(ptr), value);
+            }
+
+            inline void store(uint64_t *ptr, __m256i value, __m256i mask)
+            {
+                _mm256_maskstore_epi64(reinterpret_cast<long long *>(ptr), mask, value);
+            }
+
+            // Applies op to full vectors of four coefficients and then to the remaining ones under a mask
+            template <typename BinaryOp>
+            inline void transform(
+                const uint64_t *operand1, const uint64_t *operand2, size_t coeff_count, uint64_t *result, BinaryOp op)
+            {
+                size_t i = 0;
+                for (; i + 4 <= coeff_count; i += 4)
+                {
+                    store(result + i, op(load(operand1 + i), load(operand2 + i)));
+                }
+                if (i < coeff_count)
+                {
+                    __m256i mask = tail_mask(coeff_count - i);
+                    store(result + i, op(load(operand1 + i, mask), load(operand2 + i, mask)), mask);
+                }
+            }
+        } // namespace
+
+        void add_poly_coeffmod_avx2(
+            const uint64_t *operand1, const uint64_t *operand2, size_t coeff_count, uint64_t modulus, uint64_t *result)
+        {
+            const __m256i q = _mm256_set1_epi64x(static_cast<long long>(modulus));
+            transform(operand1, operand2, coeff_count, result, [&](__m256i a, __m256i b) {
+                return guard(_mm256_add_epi64(a, b), q);
+            });
+        }
+
+        void sub_poly_coeffmod_avx2(
+            const uint64_t *operand1, const uint64_t *operand2, size_t coeff_count, uint64_t modulus, uint64_t *result)
+        {
+            const __m256i q = _mm256_set1_epi64x(static_cast<long long>(modulus));
+            transform(operand1, operand2, coeff_count, result, [&](__m256i a, __m256i b) {
+                __m256i borrow = _mm256_cmpgt_epi64(b, a);
+                return _mm256_add_epi64(_mm256_sub_epi64(a, b), _mm256_and_si256(borrow, q));
+            });
+        }
+
+        void multiply_poly_scalar_coeffmod_avx2(
+            const uint64_t *poly, size_t coeff_count, uint64_t scalar, uint64_t scalar_quotient, uint64_t modulus,
+            uint64_t *result)
+        {
+            const __m256i q = _mm256_set1_epi64x(static_cast<long long>(modulus));
+            const __m256i w = _mm256_set1_epi64x(static_cast<long long>(scalar));
+            const __m256i w_quot = _mm256_set1_epi64x(static_cast<long long>(scalar_quotient));
+
+            // Same as multiply_uint_mod: the lazy product x * w - floor(x * w_quot / 2^64) * q is in [0, 2q)
+            transform(poly, poly, coeff_count, result, [&](__m256i x, __m256i) {
+                __m256i quot = mulhi_epu64(x, w_quot);
+                return guard(_mm256_sub_epi64(mullo_epu64(x, w), mullo_epu64(quot, q)), q);
+            });
+        }
+
+        void dyadic_product_coeffmod_avx2(
+            const uint64_t *operand1, const uint64_t *operand2, size_t coeff_count, uint64_t modulus,
+            int modulus_bit_count, uint64_t barrett_ratio, uint64_t *result)
+        {
+            const __m256i q = _mm256_set1_epi64x(static_cast<long long>(modulus));
+            const __m256i two_q = _mm256_add_epi64(q, q);
+            const __m128i lo_shift = _mm_cvtsi32_si128(modulus_bit_count - 1);
+            if (modulus < narrow_modulus_bound)
+            {
+                // With operands reduced to [0, q), the product z is less than 2^(2L) and the same Barrett reduction
+                // needs only 32-bit words: floor(z / 2^(L - 1)) and floor(2^(2L) / q) are both less than 2^(L + 1)
+                const __m256i ratio =
+                    _mm256_set1_epi64x(static_cast<long long>(barrett_ratio >> (63 - modulus_bit_count)));
+                const __m128i quot_shift = _mm_cvtsi32_si128(modulus_bit_count + 1);
+                transform(operand1, operand2, coeff_count, result, [&](__m256i a, __m256i b) {
+                    __m256i z = _mm256_mul_epu32(guard(guard(a, two_q), q), guard(guard(b, two_q), q));
+                    __m256i quot = _mm256_srl_epi64(_mm256_mul_epu32(_mm256_srl_epi64(z, lo_shift), ratio), quot_shift);
+                    __m256i r = _mm256_sub_epi64(z, _mm256_mul_epu32(quot, q));
+                    return guard(guard(r, two_q), q);
+                });
+                return;
+            }
+
+            const __m256i ratio = _mm256_set1_epi64x(static_cast<long long>(barrett_ratio));
+            const __m128i hi_shift = _mm_cvtsi32_si128(65 - modulus_bit_count);
+
+            // Barrett reduction of the 128-bit product z: the quotient estimate floor(z / 2^(L - 1)) * ratio / 2^64,
+            // where L is the bit count of q, is at most 2 less than floor(z / q), so the remainder is in [0, 3q).
+            transform(operand1, operand2, coeff_count, result, [&](__m256i a, __m256i b) {
+                __m256i z_hi, z_lo;
+                mul_epu64(a, b, z_hi, z_lo);
+                __m256i z_top = _mm256_or_si256(_mm256_sll_epi64(z_hi, hi_shift), _mm256_srl_epi64(z_lo, lo_shift));
+                __m256i quot = mulhi_epu64(z_top, ratio);
+                __m256i r = _mm256_sub_epi64(z_lo, mullo_epu64(quot, q));
+                return guard(guard(r, two_q), q);
+            });
+        }
+
+        void dyadic_product_montgomery_coeffmod_avx2(
+            const uint64_t *operand1, const uint64_t *operand2, size_t coeff_count, uint64_t modulus,
+            uint64_t montgomery_inverse, uint64_t *result)
+        {
+            const __m256i q = _mm256_set1_epi64x(static_cast<long long>(modulus));
+            const __m256i inv = _mm256_set1_epi64x(static_cast<long long>(montgomery_inverse));
+
+            // Montgomery reduction of the 128-bit product z as in montgomery_reduce_128; both the high word of z and
+            // the high word of (z mod 2^64) * inv * q are less than q < 2^63, so the signed comparison is exact.
+            transform(operand1, operand2, coeff_count, result, [&](__m256i a, __m256i b) {
+                __m256i z_hi, z_lo;
+                mul_epu64(a, b, z_hi, z_lo);
+                __m256i m_hi = mulhi_epu64(mullo_epu64(z_lo, inv), q);
+                __m256i borrow = _mm256_cmpgt_epi64(m_hi, z_hi);
+                return _mm256_add_epi64(_mm256_sub_epi64(z_hi, m_hi), _mm256_and_si256(borrow, q));
+            });
+        }
+
+        void linear_combination_poly_coeffmod_avx2(
+            const uint64_t *polys, size_t poly_count, size_t coeff_count, const uint64_t *scalars, uint64_t modulus,
+            bool narrow_input, uint64_t *result)
+        {
+            const __m256i q = _mm256_set1_epi64x(static_cast<long long>(modulus));
+            const __m256i two_q = _mm256_add_epi64(q, q);
+
+            // Lazy products in [0, 2q) as in multiply_poly_scalar_coeffmod_avx2, accumulated in [0, 2q)
+            auto run = [&](auto product_op) {
+                auto combine = [&](size_t offset, auto load_op) {
+                    __m256i sum = _mm256_setzero_si256();
+                    const uint64_t *poly = polys + offset;
+                    for (size_t i = 0; i < poly_count; i++, poly += coeff_count)
+                    {
+                        sum = guard(_mm256_add_epi64(sum, product_op(load_op(poly), i)), two_q);
+                    }
+                    return guard(sum, q);
+                };
+
+                size_t j = 0;
+                for (; j + 4 <= coeff_count; j += 4)
+                {
+                    store(result + j, combine(j, [](const uint64_t *ptr) { return load(ptr); }));
+                }
+                if (j < coeff_count)
+                {
+                    __m256i mask = tail_mask(coeff_count - j);
+                    store(result + j, combine(j, [&](const uint64_t *ptr) { return load(ptr, mask); }), mask);
+                }
+            };
+
+            if (narrow_input && modulus < narrow_modulus_bound)
+            {
+                // With x less than 2^32, the quotient floor(scalar * 2^32 / q), which is the 64-bit quotient shifted
+                // right by 32, still gives a lazy product in [0, 2q), and all products take 32x32-bit multiplications
+                run([&](__m256i x, size_t i) {
+                    __m256i w = _mm256_set1_epi64x(static_cast<long long>(scalars[2 * i]));
+                    __m256i w_quot = _mm256_set1_epi64x(static_cast<long long>(scalars[2 * i + 1] >> 32));
+                    __m256i quot = _mm256_srli_epi64(_mm256_mul_epu32(x, w_quot), 32);
+                    return _mm256_sub_epi64(_mm256_mul_epu32(x, w), _mm256_mul_epu32(quot, q));
+                });
+                return;
+            }
+
+            run([&](__m256i x, size_t i) {
+                __m256i w = _mm256_set1_epi64x(static_cast<long long>(scalars[2 * i]));
+                __m256i w_quot = _mm256_set1_epi64x(static_cast<long long>(scalars[2 * i + 1]));
+                return _mm256_sub_epi64(mullo_epu64(x, w), mullo_epu64(mulhi_epu64(x, w_quot), q));
+            });
+        }
+    } // namespace util
+} // namespace seal
+#endif
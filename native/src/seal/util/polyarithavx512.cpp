@@ -0,0 +1,180 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+// This file is compiled with AVX-512F/DQ/IFMA enabled; see polyarithavx.h for why it must not include other headers of
+// the library. Only AVX-512F/DQ instructions are used.
+#include "seal/util/polyarithavx.h"
+
+#ifdef SEAL_USE_AVX512_NTT
+#include "seal/util/avxarith.h"
+#include <immintrin.h>
+
+using namespace std;
+
+namespace seal
+{
+    namespace util
+    {
+        namespace
+        {
+            // Applies op to full vectors of eight coefficients and then to the remaining ones under a mask
+            template <typename BinaryOp>
+            inline void transform(
+                const uint64_t *operand1, const uint64_t *operand2, size_t coeff_count, uint64_t *result, BinaryOp op)
+            {
+                size_t i = 0;
+                for (; i + 8 <= coeff_count; i += 8)
+                {
+                    _mm512_storeu_si512(
+                        result + i, op(_mm512_loadu_si512(operand1 + i), _mm512_loadu_si512(operand2 + i)));
+                }
+                if (i < coeff_count)
+                {
+                    __mmask8 mask = static_cast<__mmask8>((1U << (coeff_count - i)) - 1);
+                    _mm512_mask_storeu_epi64(
+                        result + i, mask,
+                        op(_mm512_maskz_loadu_epi64(mask, operand1 + i), _mm512_maskz_loadu_epi64(mask, operand2 + i)));
+                }
+            }
+        } // namespace
+
+        void add_poly_coeffmod_avx512(
+            const uint64_t *operand1, const uint64_t *operand2, size_t coeff_count, uint64_t modulus, uint64_t *result)
+        {
+            const __m512i q = _mm512_set1_epi64(static_cast<long long>(modulus));
+            transform(operand1, operand2, coeff_count, result, [&](__m512i a, __m512i b) {
+                return guard(_mm512_add_epi64(a, b), q);
+            });
+        }
+
+        void sub_poly_coeffmod_avx512(
+            const uint64_t *operand1, const uint64_t *operand2, size_t coeff_count, uint64_t modulus, uint64_t *result)
+        {
+            const __m512i q = _mm512_set1_epi64(static_cast<long long>(modulus));
+            transform(operand1, operand2, coeff_count, result, [&](__m512i a, __m512i b) {
+                __m512i diff = _mm512_sub_epi64(a, b);
+                return _mm512_mask_add_epi64(diff, _mm512_cmplt_epu64_mask(a, b), diff, q);
+            });
+        }
+
+        void multiply_poly_scalar_coeffmod_avx512(
+            const uint64_t *poly, size_t coeff_count, uint64_t scalar, uint64_t scalar_quotient, uint64_t modulus,
+            uint64_t *result)
+        {
+            const __m512i q = _mm512_set1_epi64(static_cast<long long>(modulus));
+            const __m512i w = _mm512_set1_epi64(static_cast<long long>(scalar));
+            const __m512i w_quot = _mm512_set1_epi64(static_cast<long long>(scalar_quotient));
+
+            // Same as multiply_uint_mod: the lazy product x * w - floor(x * w_quot / 2^64) * q is in [0, 2q)
+            transform(poly, poly, coeff_count, result, [&](__m512i x, __m512i) {
+                __m512i quot = mulhi_epu64(x, w_quot);
+                return guard(_mm512_sub_epi64(_mm512_mullo_epi64(x, w), _mm512_mullo_epi64(quot, q)), q);
+            });
+        }
+
+        void dyadic_product_coeffmod_avx512(
+            const uint64_t *operand1, const uint64_t *operand2, size_t coeff_count, uint64_t modulus,
+            int modulus_bit_count, uint64_t barrett_ratio, uint64_t *result)
+        {
+            const __m512i q = _mm512_set1_epi64(static_cast<long long>(modulus));
+            const __m512i two_q = _mm512_add_epi64(q, q);
+            const __m128i lo_shift = _mm_cvtsi32_si128(modulus_bit_count - 1);
+            if (modulus < narrow_modulus_bound)
+            {
+                // Narrow moduli as in dyadic_product_coeffmod_avx2
+                const __m512i ratio =
+                    _mm512_set1_epi64(static_cast<long long>(barrett_ratio >> (63 - modulus_bit_count)));
+                const __m128i quot_shift = _mm_cvtsi32_si128(modulus_bit_count + 1);
+                transform(operand1, operand2, coeff_count, result, [&](__m512i a, __m512i b) {
+                    __m512i z = _mm512_mul_epu32(guard(guard(a, two_q), q), guard(guard(b, two_q), q));
+                    __m512i quot = _mm512_srl_epi64(_mm512_mul_epu32(_mm512_srl_epi64(z, lo_shift), ratio), quot_shift);
+                    __m512i r = _mm512_sub_epi64(z, _mm512_mul_epu32(quot, q));
+                    return guard(guard(r, two_q), q);
+                });
+                return;
+            }
+
+            const __m512i ratio = _mm512_set1_epi64(static_cast<long long>(barrett_ratio));
+            const __m128i hi_shift = _mm_cvtsi32_si128(65 - modulus_bit_count);
+
+            // Barrett reduction as in dyadic_product_coeffmod_avx2; the remainder is in [0, 3q)
+            transform(operand1, operand2, coeff_count, result, [&](__m512i a, __m512i b) {
+                __m512i z_hi, z_lo;
+                mul_epu64(a, b, z_hi, z_lo);
+                __m512i z_top = _mm512_or_si512(_mm512_sll_epi64(z_hi, hi_shift), _mm512_srl_epi64(z_lo, lo_shift));
+                __m512i quot = mulhi_epu64(z_top, ratio);
+                __m512i r = _mm512_sub_epi64(z_lo, _mm512_mullo_epi64(quot, q));
+                return guard(guard(r, two_q), q);
+            });
+        }
+
+        void dyadic_product_montgomery_coeffmod_avx512(
+            const uint64_t *operand1, const uint64_t *operand2, size_t coeff_count, uint64_t modulus,
+            uint64_t montgomery_inverse, uint64_t *result)
+        {
+            const __m512i q = _mm512_set1_epi64(static_cast<long long>(modulus));
+            const __m512i inv = _mm512_set1_epi64(static_cast<long long>(montgomery_inverse));
+
+            // Montgomery reduction as in dyadic_product_montgomery_coeffmod_avx2
+            transform(operand1, operand2, coeff_count, result, [&](__m512i a, __m512i b) {
+                __m512i z_hi, z_lo;
+                mul_epu64(a, b, z_hi, z_lo);
+                __m512i m_hi = mulhi_epu64(_mm512_mullo_epi64(z_lo, inv), q);
+                __m512i diff = _mm512_sub_epi64(z_hi, m_hi);
+                return _mm512_mask_add_epi64(diff, _mm512_cmplt_epu64_mask(z_hi, m_hi), diff, q);
+            });
+        }
+
+        void linear_combination_poly_coeffmod_avx512(
+            const uint64_t *polys, size_t poly_count, size_t coeff_count, const uint64_t *scalars, uint64_t modulus,
+            bool narrow_input, uint64_t *result)
+        {
+            const __m512i q = _mm512_set1_epi64(static_cast<long long>(modulus));
+            const __m512i two_q = _mm512_add_epi64(q, q);
+
+            // Lazy products in [0, 2q) as in multiply_poly_scalar_coeffmod_avx512, accumulated in [0, 2q)
+            auto run = [&](auto product_op) {
+                auto combine = [&](size_t offset, __mmask8 mask) {
+                    __m512i sum = _mm512_setzero_si512();
+                    const uint64_t *poly = polys + offset;
+                    for (size_t i = 0; i < poly_count; i++, poly += coeff_count)
+                    {
+                        __m512i x = _mm512_maskz_loadu_epi64(mask, poly);
+                        sum = guard(_mm512_add_epi64(sum, product_op(x, i)), two_q);
+                    }
+                    return guard(sum, q);
+                };
+
+                size_t j = 0;
+                for (; j + 8 <= coeff_count; j += 8)
+                {
+                    _mm512_storeu_si512(result + j, combine(j, 0xFF));
+                }
+                if (j < coeff_count)
+                {
+                    __mmask8 mask = static_cast<__mmask8>((1U << (coeff_count - j)) - 1);
+                    _mm512_mask_storeu_epi64(result + j, mask, combine(j, mask));
+                }
+            };
+
+            if (narrow_input && modulus < narrow_modulus_bound)
+            {
+                // Narrow products as in linear_combination_poly_coeffmod_avx2
+                run([&](__m512i x, size_t i) {
+                    __m512i w = _mm512_set1_epi64(static_cast<long long>(scalars[2 * i]));
+                    __m512i w_quot = _mm512_set1_epi64(static_cast<long long>(scalars[2 * i + 1] >> 32));
+                    __m512i quot = _mm512_srli_epi64(_mm512_mul_epu32(x, w_quot), 32);
+                    return _mm512_sub_epi64(_mm512_mul_epu32(x, w), _mm512_mul_epu32(quot, q));
+                });
+                return;
+            }
+
+            run([&](__m512i x, size_t i) {
+                __m512i w = _mm512_set1_epi64(static_cast<long long>(scalars[2 * i]));
+                __m512i w_quot = _mm512_set1_epi64(static_cast<long long>(scalars[2 * i + 1]));
+                return _mm512_sub_epi64(_mm512_mullo_epi64(x, w), _mm512_mullo_epi64(mulhi_epu64(x, w_quot), q));
+            });
+        }
+    } // namespace util
+} // namespace seal
+#endif
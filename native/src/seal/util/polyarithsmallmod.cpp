@@ -1,9 +1,14 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT license.
 
+#include "seal/util/cpufeatures.h"
+#include "seal/util/polyarithavx.h"
 #include "seal/util/polyarithsmallmod.h"
 #include "seal/util/uintarith.h"
 #include "seal/util/uintcore.h"
+#include <algorithm>
+#include <atomic>
+#include <limits>
 
 #ifdef SEAL_USE_INTEL_HEXL
 #include "hexl/hexl.hpp"
@@ -15,74 +20,432 @@ namespace seal
 {
     namespace util
     {
-        void modulo_poly_coeffs(ConstCoeffIter poly, std::size_t coeff_count, const Modulus &modulus, CoeffIter result)
+        namespace
         {
-#ifdef SEAL_DEBUG
-            if (!poly && coeff_count > 0)
+            polyarith_kernel_type fastest_polyarith_kernel() noexcept
             {
-                throw std::invalid_argument("poly");
+                for (auto kernel : { polyarith_kernel_type::avx512, polyarith_kernel_type::avx2 })
+                {
+                    if (polyarith_kernel_supported(kernel))
+                    {
+                        return kernel;
+                    }
+                }
+                return polyarith_kernel_type::scalar;
             }
-            if (!result && coeff_count > 0)
+
+            atomic<polyarith_kernel_type> &polyarith_kernel() noexcept
             {
-                throw std::invalid_argument("result");
+                static atomic<polyarith_kernel_type> kernel(fastest_polyarith_kernel());
+                return kernel;
             }
-            if (modulus.is_zero())
+
+            atomic<dyadic_product_backend_type> &dyadic_product_backend() noexcept
             {
-                throw std::invalid_argument("modulus");
+                static atomic<dyadic_product_backend_type> backend(dyadic_product_backend_type::automatic);
+                return backend;
             }
-#endif
 
-#ifdef SEAL_USE_INTEL_HEXL
-            intel::hexl::EltwiseReduceMod(result, poly, coeff_count, modulus.value(), modulus.value(), 1);
-#else
-            SEAL_ITERATE(
-                iter(poly, result), coeff_count, [&](auto I) { get<1>(I) = barrett_reduce_64(get<0>(I), modulus); });
+#ifndef SEAL_USE_INTEL_HEXL
+            // The vectorized dyadic product reduces products less than 2^(L + 63) for moduli of L bits; this holds
+            // for operands less than 4 * modulus when L is at most 59.
+            constexpr int polyarith_kernel_dyadic_modulus_bit_count_max = 59;
+
+            // The functions below run the selected vectorized kernel; they return false if the scalar implementation
+            // must be used.
+            bool add_poly_coeffmod_vectorized(
+                SEAL_MAYBE_UNUSED ConstCoeffIter operand1, SEAL_MAYBE_UNUSED ConstCoeffIter operand2,
+                SEAL_MAYBE_UNUSED size_t coeff_count, SEAL_MAYBE_UNUSED const Modulus &modulus,
+                SEAL_MAYBE_UNUSED CoeffIter result)
+            {
+                switch (polyarith_kernel().load(memory_order_relaxed))
+                {
+#ifdef SEAL_USE_AVX512_NTT
+                case polyarith_kernel_type::avx512:
+                    add_poly_coeffmod_avx512(operand1, operand2, coeff_count, modulus.value(), result);
+                    return true;
 #endif
-        }
+#ifdef SEAL_USE_AVX2_NTT
+                case polyarith_kernel_type::avx2:
+                    add_poly_coeffmod_avx2(operand1, operand2, coeff_count, modulus.value(), result);
+                    return true;
+#endif
+                default:
+                    return false;
+                }
+            }
 
-        void add_poly_coeffmod(
-            ConstCoeffIter operand1, ConstCoeffIter operand2, std::size_t coeff_count, const Modulus &modulus,
-            CoeffIter result)
-        {
-#ifdef SEAL_DEBUG
-            if (!operand1 && coeff_count > 0)
+            bool sub_poly_coeffmod_vectorized(
+                SEAL_MAYBE_UNUSED ConstCoeffIter operand1, SEAL_MAYBE_UNUSED ConstCoeffIter operand2,
+                SEAL_MAYBE_UNUSED size_t coeff_count, SEAL_MAYBE_UNUSED const Modulus &modulus,
+                SEAL_MAYBE_UNUSED CoeffIter result)
             {
-                throw std::invalid_argument("operand1");
+                switch (polyarith_kernel().load(memory_order_relaxed))
+                {
+#ifdef SEAL_USE_AVX512_NTT
+                case polyarith_kernel_type::avx512:
+                    sub_poly_coeffmod_avx512(operand1, operand2, coeff_count, modulus.value(), result);
+                    return true;
+#endif
+#ifdef SEAL_USE_AVX2_NTT
+                case polyarith_kernel_type::avx2:
+                    sub_poly_coeffmod_avx2(operand1, operand2, coeff_count, modulus.value(), result);
+                    return true;
+#endif
+                default:
+                    return false;
+                }
             }
-            if (!operand2 && coeff_count > 0)
+
+            bool multiply_poly_scalar_coeffmod_vectorized(
+                SEAL_MAYBE_UNUSED ConstCoeffIter poly, SEAL_MAYBE_UNUSED size_t coeff_count,
+                SEAL_MAYBE_UNUSED MultiplyUIntModOperand scalar, SEAL_MAYBE_UNUSED const Modulus &modulus,
+                SEAL_MAYBE_UNUSED CoeffIter result)
             {
-                throw std::invalid_argument("operand2");
+                switch (polyarith_kernel().load(memory_order_relaxed))
+                {
+#ifdef SEAL_USE_AVX512_NTT
+                case polyarith_kernel_type::avx512:
+                    multiply_poly_scalar_coeffmod_avx512(
+                        poly, coeff_count, scalar.operand, scalar.quotient, modulus.value(), result);
+                    return true;
+#endif
+#ifdef SEAL_USE_AVX2_NTT
+                case polyarith_kernel_type::avx2:
+                    multiply_poly_scalar_coeffmod_avx2(
+                        poly, coeff_count, scalar.operand, scalar.quotient, modulus.value(), result);
+                    return true;
+#endif
+                default:
+                    return false;
+                }
             }
-            if (modulus.is_zero())
-            {
-                throw std::invalid_argument("modulus");
+
+            bool dyadic_product_coeffmod_vectorized(
+                SEAL_MAYBE_UNUSED ConstCoeffIter operand1, SEAL_MAYBE_UNUSED ConstCoeffIter operand2,
+                SEAL_MAYBE_UNUSED size_t coeff_count, const Modulus &modulus, SEAL_MAYBE_UNUSED CoeffIter result)
+            {
+                polyarith_kernel_type kernel = polyarith_kernel().load(memory_order_relaxed);
+                int bit_count = modulus.bit_count();
+                if (kernel == polyarith_kernel_type::scalar ||
+                    bit_count > polyarith_kernel_dyadic_modulus_bit_count_max)
+                {
+                    return false;
+                }
+
+                // floor((2^(L + 63) - 1) / modulus) from const_ratio = floor(2^128 / modulus); the two differ only
+                // when modulus is a power of two, for which the former is 2^64 - 1.
+                SEAL_MAYBE_UNUSED uint64_t barrett_ratio = numeric_limits<uint64_t>::max();
+                if (modulus.value() & (modulus.value() - 1))
+                {
+                    int shift = 65 - bit_count;
+                    barrett_ratio = (modulus.const_ratio()[0] >> shift) | (modulus.const_ratio()[1] << (64 - shift));
+                }
+                switch (kernel)
+                {
+#ifdef SEAL_USE_AVX512_NTT
+                case polyarith_kernel_type::avx512:
+                    dyadic_product_coeffmod_avx512(
+                        operand1, operand2, coeff_count, modulus.value(), bit_count, barrett_ratio, result);
+                    return true;
+#endif
+#ifdef SEAL_USE_AVX2_NTT
+                case polyarith_kernel_type::avx2:
+                    dyadic_product_coeffmod_avx2(
+                        operand1, operand2, coeff_count, modulus.value(), bit_count, barrett_ratio, result);
+                    return true;
+#endif
+                default:
+                    return false;
+                }
             }
-            if (!result && coeff_count > 0)
+
+            bool dyadic_product_montgomery_coeffmod_vectorized(
+                SEAL_MAYBE_UNUSED ConstCoeffIter operand1, SEAL_MAYBE_UNUSED ConstCoeffIter operand2,
+                SEAL_MAYBE_UNUSED size_t coeff_count, SEAL_MAYBE_UNUSED const Modulus &modulus,
+                SEAL_MAYBE_UNUSED CoeffIter result)
             {
-                throw std::invalid_argument("result");
+                switch (polyarith_kernel().load(memory_order_relaxed))
+                {
+#ifdef SEAL_USE_AVX512_NTT
+                case polyarith_kernel_type::avx512:
+                    dyadic_product_montgomery_coeffmod_avx512(
+                        operand1, operand2, coeff_count, modulus.value(), modulus.montgomery_inverse(), result);
+                    return true;
+#endif
+#ifdef SEAL_USE_AVX2_NTT
+                case polyarith_kernel_type::avx2:
+                    dyadic_product_montgomery_coeffmod_avx2(
+                        operand1, operand2, coeff_count, modulus.value(), modulus.montgomery_inverse(), result);
+                    return true;
+#endif
+                default:
+                    return false;
+                }
             }
+
+#ifdef SEAL_USE_AVX2_NTT
+            // The lazy Shoup products of the AVX2 kernel are slower than the 128-bit accumulation of the scalar path
+            // for longer combinations: at n = 8192 the two break even at 8 polynomials (739 us against 760 us) and
+            // the scalar path is faster at 15 (2191 us against 2340 us)
+            constexpr size_t linear_combination_avx2_max_poly_count = 8;
+
+            // With inputs of at most 32 bits and a modulus less than 2^30 the AVX2 kernel takes 32x32-bit products and
+            // stays faster than the scalar path for long combinations: at n = 4096 and 40 polynomials it takes 177 us
+            // against 451 us
+            constexpr int linear_combination_narrow_bit_count = 30;
 #endif
-            const uint64_t modulus_value = modulus.value();
+
+            bool linear_combination_poly_coeffmod_vectorized(
+                SEAL_MAYBE_UNUSED ConstRNSIter polys, SEAL_MAYBE_UNUSED size_t poly_count,
+                SEAL_MAYBE_UNUSED const MultiplyUIntModOperand *scalars, SEAL_MAYBE_UNUSED const Modulus &modulus,
+                SEAL_MAYBE_UNUSED int input_bit_count, SEAL_MAYBE_UNUSED CoeffIter result)
+            {
+                static_assert(
+                    sizeof(MultiplyUIntModOperand) == 2 * sizeof(uint64_t), "MultiplyUIntModOperand must be packed");
+                SEAL_MAYBE_UNUSED const uint64_t *scalar_words = reinterpret_cast<const uint64_t *>(scalars);
+                SEAL_MAYBE_UNUSED bool narrow_input = input_bit_count <= 32;
+                switch (polyarith_kernel().load(memory_order_relaxed))
+                {
+#ifdef SEAL_USE_AVX512_NTT
+                case polyarith_kernel_type::avx512:
+                    linear_combination_poly_coeffmod_avx512(
+                        polys, poly_count, polys.poly_modulus_degree(), scalar_words, modulus.value(), narrow_input,
+                        result);
+                    return true;
+#endif
+#ifdef SEAL_USE_AVX2_NTT
+                case polyarith_kernel_type::avx2:
+                    if (poly_count > linear_combination_avx2_max_poly_count &&
+                        !(narrow_input && modulus.bit_count() <= linear_combination_narrow_bit_count))
+                    {
+                        return false;
+                    }
+                    linear_combination_poly_coeffmod_avx2(
+                        polys, poly_count, polys.poly_modulus_degree(), scalar_words, modulus.value(), narrow_input,
+                        result);
+                    return true;
+#endif
+                default:
+                    return false;
+                }
+            }
+#endif
+            // The routines below share their bodies with the fixed-degree instantiations at the end of this file;
+            // a non-zero FixedCount replaces coeff_count, which must equal it, with a compile-time constant.
+            template <size_t FixedCount>
+            inline void modulo_poly_coeffs_impl(
+                ConstCoeffIter poly, size_t coeff_count, const Modulus &modulus, CoeffIter result)
+            {
+#ifdef SEAL_DEBUG
+                if (FixedCount && coeff_count != FixedCount)
+                {
+                    throw std::invalid_argument("coeff_count");
+                }
+                if (!poly && coeff_count > 0)
+                {
+                    throw std::invalid_argument("poly");
+                }
+                if (!result && coeff_count > 0)
+                {
+                    throw std::invalid_argument("result");
+                }
+                if (modulus.is_zero())
+                {
+                    throw std::invalid_argument("modulus");
+                }
+#endif
+                if (FixedCount)
+                {
+                    coeff_count = FixedCount;
+                }
 
 #ifdef SEAL_USE_INTEL_HEXL
-            intel::hexl::EltwiseAddMod(&result[0], &operand1[0], &operand2[0], coeff_count, modulus_value);
+                intel::hexl::EltwiseReduceMod(result, poly, coeff_count, modulus.value(), modulus.value(), 1);
 #else
+                SEAL_ITERATE(iter(poly, result), coeff_count, [&](auto I) {
+                    get<1>(I) = barrett_reduce_64(get<0>(I), modulus);
+                });
+#endif
+            }
 
-            SEAL_ITERATE(iter(operand1, operand2, result), coeff_count, [&](auto I) {
+            template <size_t FixedCount>
+            inline void add_poly_coeffmod_impl(
+                ConstCoeffIter operand1, ConstCoeffIter operand2, size_t coeff_count, const Modulus &modulus,
+                CoeffIter result)
+            {
 #ifdef SEAL_DEBUG
-                if (get<0>(I) >= modulus_value)
+                if (FixedCount && coeff_count != FixedCount)
+                {
+                    throw std::invalid_argument("coeff_count");
+                }
+                if (!operand1 && coeff_count > 0)
                 {
                     throw std::invalid_argument("operand1");
                 }
-                if (get<1>(I) >= modulus_value)
+                if (!operand2 && coeff_count > 0)
                 {
                     throw std::invalid_argument("operand2");
                 }
+                if (modulus.is_zero())
+                {
+                    throw std::invalid_argument("modulus");
+                }
+                if (!result && coeff_count > 0)
+                {
+                    throw std::invalid_argument("result");
+                }
+                SEAL_ITERATE(iter(operand1, operand2), coeff_count, [&](auto I) {
+                    if (get<0>(I) >= modulus.value())
+                    {
+                        throw std::invalid_argument("operand1");
+                    }
+                    if (get<1>(I) >= modulus.value())
+                    {
+                        throw std::invalid_argument("operand2");
+                    }
+                });
 #endif
-                std::uint64_t sum = get<0>(I) + get<1>(I);
-                get<2>(I) = SEAL_COND_SELECT(sum >= modulus_value, sum - modulus_value, sum);
-            });
+                if (FixedCount)
+                {
+                    coeff_count = FixedCount;
+                }
+                const uint64_t modulus_value = modulus.value();
+
+#ifdef SEAL_USE_INTEL_HEXL
+                intel::hexl::EltwiseAddMod(&result[0], &operand1[0], &operand2[0], coeff_count, modulus_value);
+#else
+                if (add_poly_coeffmod_vectorized(operand1, operand2, coeff_count, modulus, result))
+                {
+                    return;
+                }
+
+                SEAL_ITERATE(iter(operand1, operand2, result), coeff_count, [&](auto I) {
+                    std::uint64_t sum = get<0>(I) + get<1>(I);
+                    get<2>(I) = SEAL_COND_SELECT(sum >= modulus_value, sum - modulus_value, sum);
+                });
+#endif
+            }
+
+            template <size_t FixedCount>
+            inline void dyadic_product_coeffmod_impl(
+                ConstCoeffIter operand1, ConstCoeffIter operand2, size_t coeff_count, const Modulus &modulus,
+                CoeffIter result)
+            {
+#ifdef SEAL_DEBUG
+                if (FixedCount && coeff_count != FixedCount)
+                {
+                    throw invalid_argument("coeff_count");
+                }
+                if (!operand1)
+                {
+                    throw invalid_argument("operand1");
+                }
+                if (!operand2)
+                {
+                    throw invalid_argument("operand2");
+                }
+                if (!result)
+                {
+                    throw invalid_argument("result");
+                }
+                if (coeff_count == 0)
+                {
+                    throw invalid_argument("coeff_count");
+                }
+                if (modulus.is_zero())
+                {
+                    throw invalid_argument("modulus");
+                }
 #endif
+                if (FixedCount)
+                {
+                    coeff_count = FixedCount;
+                }
+
+#ifdef SEAL_USE_INTEL_HEXL
+                intel::hexl::EltwiseMultMod(&result[0], &operand1[0], &operand2[0], coeff_count, modulus.value(), 4);
+#else
+                if (dyadic_product_coeffmod_vectorized(operand1, operand2, coeff_count, modulus, result))
+                {
+                    return;
+                }
+
+                const uint64_t modulus_value = modulus.value();
+                const uint64_t const_ratio_0 = modulus.const_ratio()[0];
+                const uint64_t const_ratio_1 = modulus.const_ratio()[1];
+
+                SEAL_ITERATE(iter(operand1, operand2, result), coeff_count, [&](auto I) {
+                    // Reduces z using base 2^64 Barrett reduction
+                    unsigned long long z[2], tmp1, tmp2[2], tmp3, carry;
+                    multiply_uint64(get<0>(I), get<1>(I), z);
+
+                    // Multiply input and const_ratio
+                    // Round 1
+                    multiply_uint64_hw64(z[0], const_ratio_0, &carry);
+                    multiply_uint64(z[0], const_ratio_1, tmp2);
+                    tmp3 = tmp2[1] + add_uint64(tmp2[0], carry, &tmp1);
+
+                    // Round 2
+                    multiply_uint64(z[1], const_ratio_0, tmp2);
+                    carry = tmp2[1] + add_uint64(tmp1, tmp2[0], &tmp1);
+
+                    // This is all we care about
+                    tmp1 = z[1] * const_ratio_1 + tmp3 + carry;
+
+                    // Barrett subtraction
+                    tmp3 = z[0] - tmp1 * modulus_value;
+
+                    // Claim: One more subtraction is enough
+                    get<2>(I) = SEAL_COND_SELECT(tmp3 >= modulus_value, tmp3 - modulus_value, tmp3);
+                });
+#endif
+            }
+        } // namespace
+
+        bool polyarith_kernel_supported(polyarith_kernel_type kernel) noexcept
+        {
+            switch (kernel)
+            {
+            case polyarith_kernel_type::scalar:
+                return true;
+#ifdef SEAL_USE_AVX2_NTT
+            case polyarith_kernel_type::avx2:
+                return cpu_features().avx2;
+#endif
+#ifdef SEAL_USE_AVX512_NTT
+            case polyarith_kernel_type::avx512:
+                return cpu_features().avx512f && cpu_features().avx512dq;
+#endif
+            default:
+                return false;
+            }
+        }
+
+        polyarith_kernel_type get_polyarith_kernel() noexcept
+        {
+            return polyarith_kernel().load(memory_order_relaxed);
+        }
+
+        void set_polyarith_kernel(polyarith_kernel_type kernel)
+        {
+            if (!polyarith_kernel_supported(kernel))
+            {
+                throw invalid_argument("kernel is not supported");
+            }
+            polyarith_kernel().store(kernel, memory_order_relaxed);
+        }
+
+        void modulo_poly_coeffs(ConstCoeffIter poly, std::size_t coeff_count, const Modulus &modulus, CoeffIter result)
+        {
+            modulo_poly_coeffs_impl<0>(poly, coeff_count, modulus, result);
+        }
+
+        void add_poly_coeffmod(
+            ConstCoeffIter operand1, ConstCoeffIter operand2, std::size_t coeff_count, const Modulus &modulus,
+            CoeffIter result)
+        {
+            add_poly_coeffmod_impl<0>(operand1, operand2, coeff_count, modulus, result);
         }
 
         void sub_poly_coeffmod(
@@ -106,23 +469,28 @@ namespace seal
             {
                 throw std::invalid_argument("result");
             }
-#endif
-
-            const uint64_t modulus_value = modulus.value();
-#ifdef SEAL_USE_INTEL_HEXL
-            intel::hexl::EltwiseSubMod(result, operand1, operand2, coeff_count, modulus_value);
-#else
-            SEAL_ITERATE(iter(operand1, operand2, result), coeff_count, [&](auto I) {
-#ifdef SEAL_DEBUG
-                if (get<0>(I) >= modulus_value)
+            SEAL_ITERATE(iter(operand1, operand2), coeff_count, [&](auto I) {
+                if (get<0>(I) >= modulus.value())
                 {
                     throw std::invalid_argument("operand1");
                 }
-                if (get<1>(I) >= modulus_value)
+                if (get<1>(I) >= modulus.value())
                 {
                     throw std::invalid_argument("operand2");
                 }
+            });
 #endif
+
+            const uint64_t modulus_value = modulus.value();
+#ifdef SEAL_USE_INTEL_HEXL
+            intel::hexl::EltwiseSubMod(result, operand1, operand2, coeff_count, modulus_value);
+#else
+            if (sub_poly_coeffmod_vectorized(operand1, operand2, coeff_count, modulus, result))
+            {
+                return;
+            }
+
+            SEAL_ITERATE(iter(operand1, operand2, result), coeff_count, [&](auto I) {
                 unsigned long long temp_result;
                 std::int64_t borrow = sub_uint64(get<0>(I), get<1>(I), &temp_result);
                 get<2>(I) = temp_result + (modulus_value & static_cast<std::uint64_t>(-borrow));
@@ -216,6 +584,11 @@ namespace seal
 #ifdef SEAL_USE_INTEL_HEXL
             intel::hexl::EltwiseFMAMod(&result[0], &poly[0], scalar.operand, nullptr, coeff_count, modulus.value(), 8);
 #else
+            if (multiply_poly_scalar_coeffmod_vectorized(poly, coeff_count, scalar, modulus, result))
+            {
+                return;
+            }
+
             SEAL_ITERATE(iter(poly, result), coeff_count, [&](auto I) {
                 const uint64_t x = get<0>(I);
                 get<1>(I) = multiply_uint_mod(x, scalar, modulus);
@@ -227,60 +600,203 @@ namespace seal
             ConstCoeffIter operand1, ConstCoeffIter operand2, size_t coeff_count, const Modulus &modulus,
             CoeffIter result)
         {
+            dyadic_product_coeffmod_impl<0>(operand1, operand2, coeff_count, modulus, result);
+        }
+
+        void linear_combination_poly_coeffmod(
+            ConstRNSIter polys, size_t poly_count, const MultiplyUIntModOperand *scalars, const Modulus &modulus,
+            int input_bit_count, CoeffIter result)
+        {
+            size_t coeff_count = polys.poly_modulus_degree();
 #ifdef SEAL_DEBUG
-            if (!operand1)
+            if (!polys && poly_count > 0)
             {
-                throw invalid_argument("operand1");
+                throw invalid_argument("polys");
             }
-            if (!operand2)
+            if (!scalars && poly_count > 0)
             {
-                throw invalid_argument("operand2");
+                throw invalid_argument("scalars");
             }
-            if (!result)
+            if (!result && coeff_count > 0)
             {
                 throw invalid_argument("result");
             }
-            if (coeff_count == 0)
-            {
-                throw invalid_argument("coeff_count");
-            }
             if (modulus.is_zero())
             {
                 throw invalid_argument("modulus");
             }
+            if (input_bit_count < 0 || input_bit_count > SEAL_MOD_BIT_COUNT_MAX)
+            {
+                throw invalid_argument("input_bit_count");
+            }
 #endif
-#ifdef SEAL_USE_INTEL_HEXL
-            intel::hexl::EltwiseMultMod(&result[0], &operand1[0], &operand2[0], coeff_count, modulus.value(), 4);
-#else
-            const uint64_t modulus_value = modulus.value();
-            const uint64_t const_ratio_0 = modulus.const_ratio()[0];
-            const uint64_t const_ratio_1 = modulus.const_ratio()[1];
+            if (!poly_count)
+            {
+                set_zero_uint(coeff_count, result);
+                return;
+            }
+#ifndef SEAL_USE_INTEL_HEXL
+            if (linear_combination_poly_coeffmod_vectorized(polys, poly_count, scalars, modulus, input_bit_count, result))
+            {
+                return;
+            }
+#endif
+            // Accumulate the 128-bit products and reduce only when the accumulator could otherwise overflow; the
+            // remainder of such an intermediate reduction takes the place of one product.
+            const uint64_t *poly_base = polys;
+            for (size_t j = 0; j < coeff_count; j++)
+            {
+                unsigned long long accumulator[2]{ 0, 0 };
+                size_t accumulated_count = 0;
+                const uint64_t *coeff = poly_base + j;
+                for (size_t i = 0; i < poly_count; i++, coeff += coeff_count)
+                {
+                    if (accumulated_count == SEAL_MULTIPLY_ACCUMULATE_MOD_MAX)
+                    {
+                        accumulator[0] = barrett_reduce_128(accumulator, modulus);
+                        accumulator[1] = 0;
+                        accumulated_count = 1;
+                    }
+                    unsigned long long product[2];
+                    multiply_uint64(*coeff, scalars[i].operand, product);
+                    add_uint128(product, accumulator, accumulator);
+                    accumulated_count++;
+                }
+                result[j] = barrett_reduce_128(accumulator, modulus);
+            }
+        }
 
-            SEAL_ITERATE(iter(operand1, operand2, result), coeff_count, [&](auto I) {
-                // Reduces z using base 2^64 Barrett reduction
-                unsigned long long z[2], tmp1, tmp2[2], tmp3, carry;
-                multiply_uint64(get<0>(I), get<1>(I), z);
+        dyadic_product_backend_type get_dyadic_product_backend() noexcept
+        {
+            return dyadic_product_backend().load(memory_order_relaxed);
+        }
 
-                // Multiply input and const_ratio
-                // Round 1
-                multiply_uint64_hw64(z[0], const_ratio_0, &carry);
-                multiply_uint64(z[0], const_ratio_1, tmp2);
-                tmp3 = tmp2[1] + add_uint64(tmp2[0], carry, &tmp1);
+        void set_dyadic_product_backend(dyadic_product_backend_type backend)
+        {
+            if (backend != dyadic_product_backend_type::barrett && backend != dyadic_product_backend_type::montgomery &&
+                backend != dyadic_product_backend_type::automatic)
+            {
+                throw invalid_argument("backend is not valid");
+            }
+            dyadic_product_backend().store(backend, memory_order_relaxed);
+        }
 
-                // Round 2
-                multiply_uint64(z[1], const_ratio_0, tmp2);
-                carry = tmp2[1] + add_uint64(tmp1, tmp2[0], &tmp1);
+        bool use_montgomery_dyadic_product(
+            SEAL_MAYBE_UNUSED ConstModulusIter modulus, SEAL_MAYBE_UNUSED size_t coeff_modulus_size)
+        {
+            switch (get_dyadic_product_backend())
+            {
+            case dyadic_product_backend_type::montgomery:
+                return true;
 
-                // This is all we care about
-                tmp1 = z[1] * const_ratio_1 + tmp3 + carry;
+            case dyadic_product_backend_type::automatic:
+#ifdef SEAL_USE_INTEL_HEXL
+                // Intel HEXL computes the Barrett reductions with vector instructions
+                return false;
+#else
+                if (get_polyarith_kernel() == polyarith_kernel_type::scalar)
+                {
+                    return true;
+                }
+                return any_of(modulus, modulus + coeff_modulus_size, [](const Modulus &value) {
+                    return value.bit_count() > polyarith_kernel_dyadic_modulus_bit_count_max;
+                });
+#endif
+            default:
+                return false;
+            }
+        }
 
-                // Barrett subtraction
-                tmp3 = z[0] - tmp1 * modulus_value;
+        void to_montgomery_poly_coeffmod(
+            ConstCoeffIter poly, size_t coeff_count, const Modulus &modulus, CoeffIter result)
+        {
+#ifdef SEAL_DEBUG
+            if (!poly && coeff_count > 0)
+            {
+                throw invalid_argument("poly");
+            }
+            if (!result && coeff_count > 0)
+            {
+                throw invalid_argument("result");
+            }
+            if (!(modulus.value() & 1))
+            {
+                throw invalid_argument("modulus must be odd");
+            }
+#endif
+            // Multiply by 2^64 mod modulus, which is the Montgomery reduction of 2^128 mod modulus
+            MultiplyUIntModOperand scalar;
+            scalar.set(from_montgomery(modulus.const_ratio()[2], modulus), modulus);
+            multiply_poly_scalar_coeffmod(poly, coeff_count, scalar, modulus, result);
+        }
+
+        void from_montgomery_poly_coeffmod(
+            ConstCoeffIter poly, size_t coeff_count, const Modulus &modulus, CoeffIter result)
+        {
+#ifdef SEAL_DEBUG
+            if (!poly && coeff_count > 0)
+            {
+                throw invalid_argument("poly");
+            }
+            if (!result && coeff_count > 0)
+            {
+                throw invalid_argument("result");
+            }
+            if (!(modulus.value() & 1))
+            {
+                throw invalid_argument("modulus must be odd");
+            }
+#endif
+            // Multiply by 2^(-64) mod modulus, which is the Montgomery reduction of 1
+            MultiplyUIntModOperand scalar;
+            scalar.set(from_montgomery(1, modulus), modulus);
+            multiply_poly_scalar_coeffmod(poly, coeff_count, scalar, modulus, result);
+        }
 
-                // Claim: One more subtraction is enough
-                get<2>(I) = SEAL_COND_SELECT(tmp3 >= modulus_value, tmp3 - modulus_value, tmp3);
+        void dyadic_product_montgomery_coeffmod(
+            ConstCoeffIter operand1, ConstCoeffIter operand2, size_t coeff_count, const Modulus &modulus,
+            CoeffIter result)
+        {
+#ifdef SEAL_DEBUG
+            if (!operand1 && coeff_count > 0)
+            {
+                throw invalid_argument("operand1");
+            }
+            if (!operand2 && coeff_count > 0)
+            {
+                throw invalid_argument("operand2");
+            }
+            if (!result && coeff_count > 0)
+            {
+                throw invalid_argument("result");
+            }
+            if (!(modulus.value() & 1))
+            {
+                throw invalid_argument("modulus must be odd");
+            }
+            SEAL_ITERATE(operand2, coeff_count, [&](auto I) {
+                if (I >= modulus.value())
+                {
+                    throw invalid_argument("operand2");
+                }
             });
 #endif
+#ifndef SEAL_USE_INTEL_HEXL
+            if (dyadic_product_montgomery_coeffmod_vectorized(operand1, operand2, coeff_count, modulus, result))
+            {
+                return;
+            }
+#endif
+            // The product of a 64-bit value and a value less than modulus is less than modulus * 2^64, as required by
+            // the Montgomery reduction. Unlike the Barrett reduction, this needs only two more 64-bit products.
+            const uint64_t modulus_value = modulus.value();
+            const uint64_t montgomery_inverse = modulus.montgomery_inverse();
+            SEAL_ITERATE(iter(operand1, operand2, result), coeff_count, [&](auto I) {
+                unsigned long long z[2], m_hi;
+                multiply_uint64(get<0>(I), get<1>(I), z);
+                multiply_uint64_hw64(z[0] * montgomery_inverse, modulus_value, &m_hi);
+                get<2>(I) = z[1] - m_hi + (modulus_value & static_cast<uint64_t>(-static_cast<int64_t>(z[1] < m_hi)));
+            });
         }
 
         uint64_t poly_infty_norm_coeffmod(ConstCoeffIter operand, size_t coeff_count, const Modulus &modulus)
@@ -367,5 +883,59 @@ namespace seal
                 }
             }
         }
+
+        template <size_t CoeffCount>
+        void modulo_poly_coeffs_fixed(ConstCoeffIter poly, size_t coeff_count, const Modulus &modulus, CoeffIter result)
+        {
+#ifdef SEAL_DEBUG
+            if (coeff_count != CoeffCount)
+            {
+                throw invalid_argument("coeff_count");
+            }
+#endif
+            modulo_poly_coeffs_impl<CoeffCount>(poly, coeff_count, modulus, result);
+        }
+
+        template <size_t CoeffCount>
+        void add_poly_coeffmod_fixed(
+            ConstCoeffIter operand1, ConstCoeffIter operand2, size_t coeff_count, const Modulus &modulus,
+            CoeffIter result)
+        {
+#ifdef SEAL_DEBUG
+            if (coeff_count != CoeffCount)
+            {
+                throw invalid_argument("coeff_count");
+            }
+#endif
+            add_poly_coeffmod_impl<CoeffCount>(operand1, operand2, coeff_count, modulus, result);
+        }
+
+        template <size_t CoeffCount>
+        void dyadic_product_coeffmod_fixed(
+            ConstCoeffIter operand1, ConstCoeffIter operand2, size_t coeff_count, const Modulus &modulus,
+            CoeffIter result)
+        {
+#ifdef SEAL_DEBUG
+            if (coeff_count != CoeffCount)
+            {
+                throw invalid_argument("coeff_count");
+            }
+#endif
+            dyadic_product_coeffmod_impl<CoeffCount>(operand1, operand2, coeff_count, modulus, result);
+        }
+
+#define SEAL_INSTANTIATE_FIXED_DEGREE(coeff_count)                                                                    \
+    template void modulo_poly_coeffs_fixed<coeff_count>(ConstCoeffIter, size_t, const Modulus &, CoeffIter);         \
+    template void add_poly_coeffmod_fixed<coeff_count>(                                                               \
+        ConstCoeffIter, ConstCoeffIter, size_t, const Modulus &, CoeffIter);                                          \
+    template void dyadic_product_coeffmod_fixed<coeff_count>(                                                         \
+        ConstCoeffIter, ConstCoeffIter, size_t, const Modulus &, CoeffIter);
+
+        SEAL_INSTANTIATE_FIXED_DEGREE(4096)
+        SEAL_INSTANTIATE_FIXED_DEGREE(8192)
+        SEAL_INSTANTIATE_FIXED_DEGREE(16384)
+        SEAL_INSTANTIATE_FIXED_DEGREE(32768)
+        SEAL_INSTANTIATE_FIXED_DEGREE(65536)
+#undef SEAL_INSTANTIATE_FIXED_DEGREE
     } // namespace util
 } // namespace seal
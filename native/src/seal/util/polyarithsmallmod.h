@@ -18,8 +18,55 @@ namespace seal
 {
     namespace util
     {
+        /**
+        Identifies an implementation of the element-wise add_poly_coeffmod, sub_poly_coeffmod,
+        multiply_poly_scalar_coeffmod, and dyadic_product_coeffmod on a single RNS component. All implementations
+        compute the same results; the vectorized dyadic_product_coeffmod is used for moduli of at most 59 bits and
+        operands less than 4 * modulus, and the scalar one otherwise. When SEAL is built with Intel HEXL, these
+        functions are always computed by HEXL instead.
+        */
+        enum class polyarith_kernel_type : std::uint8_t
+        {
+            // Portable scalar loops
+            scalar = 0x0,
+
+            // AVX2 with 64-bit products computed from 32x32-bit partial products
+            avx2 = 0x1,
+
+            // AVX-512F/DQ
+            avx512 = 0x2
+        };
+
+        /**
+        Returns whether the given polynomial arithmetic kernel is built into the library and supported by the CPU.
+
+        @param[in] kernel The polynomial arithmetic kernel
+        */
+        SEAL_NODISCARD bool polyarith_kernel_supported(polyarith_kernel_type kernel) noexcept;
+
+        /**
+        Returns the polynomial arithmetic kernel in use. Unless set_polyarith_kernel is called, this is the fastest
+        kernel supported by the CPU, which is determined once on first use.
+        */
+        SEAL_NODISCARD polyarith_kernel_type get_polyarith_kernel() noexcept;
+
+        /**
+        Selects the polynomial arithmetic kernel used by all subsequent calls, e.g., for testing or benchmarking a
+        particular implementation. This must not be called while such functions run on other threads.
+
+        @param[in] kernel The polynomial arithmetic kernel
+        @throws std::invalid_argument if kernel is not supported
+        */
+        void set_polyarith_kernel(polyarith_kernel_type kernel);
+
         void modulo_poly_coeffs(ConstCoeffIter poly, std::size_t coeff_count, const Modulus &modulus, CoeffIter result);
 
+        // Same as above, but the loop runs over exactly CoeffCount coefficients known at compile time; instantiated for
+        // 4096 to 65536 coefficients (see PolyKernels)
+        template <std::size_t CoeffCount>
+        void modulo_poly_coeffs_fixed(
+            ConstCoeffIter poly, std::size_t coeff_count, const Modulus &modulus, CoeffIter result);
+
         inline void modulo_poly_coeffs(
             ConstRNSIter poly, std::size_t coeff_modulus_size, ConstModulusIter modulus, RNSIter result)
         {
@@ -163,6 +210,13 @@ namespace seal
             ConstCoeffIter operand1, ConstCoeffIter operand2, std::size_t coeff_count, const Modulus &modulus,
             CoeffIter result);
 
+        // Same as above, but the loop runs over exactly CoeffCount coefficients known at compile time; instantiated for
+        // 4096 to 65536 coefficients (see PolyKernels)
+        template <std::size_t CoeffCount>
+        void add_poly_coeffmod_fixed(
+            ConstCoeffIter operand1, ConstCoeffIter operand2, std::size_t coeff_count, const Modulus &modulus,
+            CoeffIter result);
+
         inline void add_poly_coeffmod(
             ConstRNSIter operand1, ConstRNSIter operand2, std::size_t coeff_modulus_size, ConstModulusIter modulus,
             RNSIter result)
@@ -506,6 +560,13 @@ namespace seal
             ConstCoeffIter operand1, ConstCoeffIter operand2, std::size_t coeff_count, const Modulus &modulus,
             CoeffIter result);
 
+        // Same as above, but the loop runs over exactly CoeffCount coefficients known at compile time; instantiated for
+        // 4096 to 65536 coefficients (see PolyKernels)
+        template <std::size_t CoeffCount>
+        void dyadic_product_coeffmod_fixed(
+            ConstCoeffIter operand1, ConstCoeffIter operand2, std::size_t coeff_count, const Modulus &modulus,
+            CoeffIter result);
+
         inline void dyadic_product_coeffmod(
             ConstRNSIter operand1, ConstRNSIter operand2, std::size_t coeff_modulus_size, ConstModulusIter modulus,
             RNSIter result)
@@ -571,6 +632,249 @@ namespace seal
             });
         }
 
+        // Computes the linear combination of poly_count polynomials with the given scalars, i.e., the sum of
+        // polys[i] * scalars[i] modulo modulus. The scalars must be set for modulus and the coefficients of polys must
+        // be at most input_bit_count bits, which is at most SEAL_MOD_BIT_COUNT_MAX; the result is less than modulus and
+        // must not alias polys. With inputs of at most 32 bits, the vectorized kernels take 32x32-bit products for
+        // moduli less than 2^30.
+        void linear_combination_poly_coeffmod(
+            ConstRNSIter polys, std::size_t poly_count, const MultiplyUIntModOperand *scalars, const Modulus &modulus,
+            int input_bit_count, CoeffIter result);
+
+        /**
+        Identifies how Evaluator reduces the dyadic products of NTT-form polynomials when multiplying ciphertexts. With
+        the Montgomery backend, the second ciphertext is converted to Montgomery form once per multiplication, after
+        which each product needs a single Montgomery reduction instead of a 128-bit Barrett reduction; the Montgomery
+        form never leaves the multiplication, so encoding, decryption, and serialization are unaffected. All backends
+        compute the same results.
+        */
+        enum class dyadic_product_backend_type : std::uint8_t
+        {
+            // Barrett reduction of each 128-bit product (dyadic_product_coeffmod)
+            barrett = 0x0,
+
+            // Montgomery reduction of each 128-bit product (dyadic_product_montgomery_coeffmod)
+            montgomery = 0x1,
+
+            // Montgomery reduction unless the selected polynomial arithmetic kernel computes the Barrett reductions
+            // with vector instructions for all moduli of the multiplication, in which case the conversion costs more
+            // than it saves
+            automatic = 0x2
+        };
+
+        /**
+        Returns the dyadic product backend in use, which is automatic unless set_dyadic_product_backend is called.
+        */
+        SEAL_NODISCARD dyadic_product_backend_type get_dyadic_product_backend() noexcept;
+
+        /**
+        Selects the dyadic product backend used by all subsequent ciphertext multiplications, e.g., for testing or
+        benchmarking. This must not be called while such multiplications run on other threads.
+
+        @param[in] backend The dyadic product backend
+        @throws std::invalid_argument if backend is not valid
+        */
+        void set_dyadic_product_backend(dyadic_product_backend_type backend);
+
+        /**
+        Returns whether the dyadic product backend in use reduces products modulo the given moduli with the Montgomery
+        reduction.
+
+        @param[in] modulus The moduli of the products
+        @param[in] coeff_modulus_size The number of moduli
+        */
+        SEAL_NODISCARD bool use_montgomery_dyadic_product(ConstModulusIter modulus, std::size_t coeff_modulus_size);
+
+        // Converts poly to Montgomery form, i.e., multiplies it by 2^64 modulo an odd modulus; poly may take any
+        // 64-bit values and the result is less than modulus
+        void to_montgomery_poly_coeffmod(
+            ConstCoeffIter poly, std::size_t coeff_count, const Modulus &modulus, CoeffIter result);
+
+        inline void to_montgomery_poly_coeffmod(
+            ConstRNSIter poly, std::size_t coeff_modulus_size, ConstModulusIter modulus, RNSIter result)
+        {
+#ifdef SEAL_DEBUG
+            if (!poly && coeff_modulus_size > 0)
+            {
+                throw std::invalid_argument("poly");
+            }
+            if (!result && coeff_modulus_size > 0)
+            {
+                throw std::invalid_argument("result");
+            }
+            if (!modulus && coeff_modulus_size > 0)
+            {
+                throw std::invalid_argument("modulus");
+            }
+            if (poly.poly_modulus_degree() != result.poly_modulus_degree())
+            {
+                throw std::invalid_argument("incompatible iterators");
+            }
+#endif
+            auto poly_modulus_degree = result.poly_modulus_degree();
+            SEAL_ITERATE(iter(poly, modulus, result), coeff_modulus_size, [&](auto I) {
+                to_montgomery_poly_coeffmod(get<0>(I), poly_modulus_degree, get<1>(I), get<2>(I));
+            });
+        }
+
+        inline void to_montgomery_poly_coeffmod(
+            ConstPolyIter poly_array, std::size_t size, ConstModulusIter modulus, PolyIter result)
+        {
+#ifdef SEAL_DEBUG
+            if (!poly_array && size > 0)
+            {
+                throw std::invalid_argument("poly_array");
+            }
+            if (!result && size > 0)
+            {
+                throw std::invalid_argument("result");
+            }
+            if (!modulus && size > 0)
+            {
+                throw std::invalid_argument("modulus");
+            }
+            if (poly_array.coeff_modulus_size() != result.coeff_modulus_size())
+            {
+                throw std::invalid_argument("incompatible iterators");
+            }
+#endif
+            auto coeff_modulus_size = result.coeff_modulus_size();
+            SEAL_ITERATE(iter(poly_array, result), size, [&](auto I) {
+                to_montgomery_poly_coeffmod(get<0>(I), coeff_modulus_size, modulus, get<1>(I));
+            });
+        }
+
+        // Converts poly from Montgomery form, i.e., multiplies it by 2^(-64) modulo an odd modulus; poly may take any
+        // 64-bit values and the result is less than modulus
+        void from_montgomery_poly_coeffmod(
+            ConstCoeffIter poly, std::size_t coeff_count, const Modulus &modulus, CoeffIter result);
+
+        inline void from_montgomery_poly_coeffmod(
+            ConstRNSIter poly, std::size_t coeff_modulus_size, ConstModulusIter modulus, RNSIter result)
+        {
+#ifdef SEAL_DEBUG
+            if (!poly && coeff_modulus_size > 0)
+            {
+                throw std::invalid_argument("poly");
+            }
+            if (!result && coeff_modulus_size > 0)
+            {
+                throw std::invalid_argument("result");
+            }
+            if (!modulus && coeff_modulus_size > 0)
+            {
+                throw std::invalid_argument("modulus");
+            }
+            if (poly.poly_modulus_degree() != result.poly_modulus_degree())
+            {
+                throw std::invalid_argument("incompatible iterators");
+            }
+#endif
+            auto poly_modulus_degree = result.poly_modulus_degree();
+            SEAL_ITERATE(iter(poly, modulus, result), coeff_modulus_size, [&](auto I) {
+                from_montgomery_poly_coeffmod(get<0>(I), poly_modulus_degree, get<1>(I), get<2>(I));
+            });
+        }
+
+        inline void from_montgomery_poly_coeffmod(
+            ConstPolyIter poly_array, std::size_t size, ConstModulusIter modulus, PolyIter result)
+        {
+#ifdef SEAL_DEBUG
+            if (!poly_array && size > 0)
+            {
+                throw std::invalid_argument("poly_array");
+            }
+            if (!result && size > 0)
+            {
+                throw std::invalid_argument("result");
+            }
+            if (!modulus && size > 0)
+            {
+                throw std::invalid_argument("modulus");
+            }
+            if (poly_array.coeff_modulus_size() != result.coeff_modulus_size())
+            {
+                throw std::invalid_argument("incompatible iterators");
+            }
+#endif
+            auto coeff_modulus_size = result.coeff_modulus_size();
+            SEAL_ITERATE(iter(poly_array, result), size, [&](auto I) {
+                from_montgomery_poly_coeffmod(get<0>(I), coeff_modulus_size, modulus, get<1>(I));
+            });
+        }
+
+        // Computes the Montgomery products operand1 * operand2 * 2^(-64) modulo an odd modulus; with operand2 in
+        // Montgomery form, this is the product of operand1 and operand2 in standard form. Operand1 may take any 64-bit
+        // values, operand2 must be less than modulus, and the result is less than modulus.
+        void dyadic_product_montgomery_coeffmod(
+            ConstCoeffIter operand1, ConstCoeffIter operand2, std::size_t coeff_count, const Modulus &modulus,
+            CoeffIter result);
+
+        inline void dyadic_product_montgomery_coeffmod(
+            ConstRNSIter operand1, ConstRNSIter operand2, std::size_t coeff_modulus_size, ConstModulusIter modulus,
+            RNSIter result)
+        {
+#ifdef SEAL_DEBUG
+            if (!operand1 && coeff_modulus_size > 0)
+            {
+                throw std::invalid_argument("operand1");
+            }
+            if (!operand2 && coeff_modulus_size > 0)
+            {
+                throw std::invalid_argument("operand2");
+            }
+            if (!result && coeff_modulus_size > 0)
+            {
+                throw std::invalid_argument("result");
+            }
+            if (!modulus && coeff_modulus_size > 0)
+            {
+                throw std::invalid_argument("modulus");
+            }
+            if (operand1.poly_modulus_degree() != result.poly_modulus_degree() ||
+                operand2.poly_modulus_degree() != result.poly_modulus_degree())
+            {
+                throw std::invalid_argument("incompatible iterators");
+            }
+#endif
+            auto poly_modulus_degree = result.poly_modulus_degree();
+            SEAL_ITERATE(iter(operand1, operand2, modulus, result), coeff_modulus_size, [&](auto I) {
+                dyadic_product_montgomery_coeffmod(get<0>(I), get<1>(I), poly_modulus_degree, get<2>(I), get<3>(I));
+            });
+        }
+
+        inline void dyadic_product_montgomery_coeffmod(
+            ConstPolyIter operand1, ConstPolyIter operand2, std::size_t size, ConstModulusIter modulus, PolyIter result)
+        {
+#ifdef SEAL_DEBUG
+            if (!operand1 && size > 0)
+            {
+                throw std::invalid_argument("operand1");
+            }
+            if (!operand2 && size > 0)
+            {
+                throw std::invalid_argument("operand2");
+            }
+            if (!result && size > 0)
+            {
+                throw std::invalid_argument("result");
+            }
+            if (!modulus && size > 0)
+            {
+                throw std::invalid_argument("modulus");
+            }
+            if (operand1.coeff_modulus_size() != result.coeff_modulus_size() ||
+                operand2.coeff_modulus_size() != result.coeff_modulus_size())
+            {
+                throw std::invalid_argument("incompatible iterators");
+            }
+#endif
+            auto coeff_modulus_size = result.coeff_modulus_size();
+            SEAL_ITERATE(iter(operand1, operand2, result), size, [&](auto I) {
+                dyadic_product_montgomery_coeffmod(get<0>(I), get<1>(I), coeff_modulus_size, modulus, get<2>(I));
+            });
+        }
+
         std::uint64_t poly_infty_norm_coeffmod(ConstCoeffIter operand, std::size_t coeff_count, const Modulus &modulus);
 
         void negacyclic_shift_poly_coeffmod(
@@ -0,0 +1,49 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/util/polyarithsmallmod.h"
+#include "seal/util/polykernels.h"
+
+using namespace std;
+
+namespace seal
+{
+    namespace util
+    {
+        namespace
+        {
+            template <int CoeffCountPower>
+            constexpr PolyKernels make_fixed_poly_kernels() noexcept
+            {
+                constexpr size_t coeff_count = size_t(1) << CoeffCountPower;
+                return { ntt_negacyclic_harvey_lazy_fixed<CoeffCountPower>,
+                         inverse_ntt_negacyclic_harvey_lazy_fixed<CoeffCountPower>,
+                         modulo_poly_coeffs_fixed<coeff_count>, add_poly_coeffmod_fixed<coeff_count>,
+                         dyadic_product_coeffmod_fixed<coeff_count> };
+            }
+
+            constexpr PolyKernels general_poly_kernels{ ntt_negacyclic_harvey_lazy, inverse_ntt_negacyclic_harvey_lazy,
+                                                        modulo_poly_coeffs, add_poly_coeffmod,
+                                                        dyadic_product_coeffmod };
+
+            constexpr int min_fixed_coeff_count_power = 12;
+
+            constexpr int max_fixed_coeff_count_power = 16;
+
+            constexpr PolyKernels fixed_poly_kernels[] = { make_fixed_poly_kernels<12>(),
+                                                           make_fixed_poly_kernels<13>(),
+                                                           make_fixed_poly_kernels<14>(),
+                                                           make_fixed_poly_kernels<15>(),
+                                                           make_fixed_poly_kernels<16>() };
+        } // namespace
+
+        const PolyKernels &get_poly_kernels(int coeff_count_power) noexcept
+        {
+            if (coeff_count_power < min_fixed_coeff_count_power || coeff_count_power > max_fixed_coeff_count_power)
+            {
+                return general_poly_kernels;
+            }
+            return fixed_poly_kernels[coeff_count_power - min_fixed_coeff_count_power];
+        }
+    } // namespace util
+} // namespace seal
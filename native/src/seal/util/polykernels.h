@@ -0,0 +1,47 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "seal/modulus.h"
+#include "seal/util/defines.h"
+#include "seal/util/iterator.h"
+#include "seal/util/ntt.h"
+#include <cstddef>
+
+namespace seal
+{
+    namespace util
+    {
+        /**
+        Table of the routines on a single RNS component that dominate the hot loops of the evaluator. Every entry
+        behaves exactly like the function it is named after. For the common degrees 4096 to 65536 the entries are
+        instantiations in which the number of coefficients is a compile-time constant, so that their loops have
+        constant trip counts; for other degrees they are the general functions. SEALContext::ContextData holds the
+        table for its poly_modulus_degree, and the coeff_count passed to an entry must equal that degree.
+        */
+        struct PolyKernels
+        {
+            void (*ntt_negacyclic_harvey_lazy)(CoeffIter operand, const NTTTables &tables);
+
+            void (*inverse_ntt_negacyclic_harvey_lazy)(CoeffIter operand, const NTTTables &tables);
+
+            void (*modulo_poly_coeffs)(
+                ConstCoeffIter poly, std::size_t coeff_count, const Modulus &modulus, CoeffIter result);
+
+            void (*add_poly_coeffmod)(
+                ConstCoeffIter operand1, ConstCoeffIter operand2, std::size_t coeff_count, const Modulus &modulus,
+                CoeffIter result);
+
+            void (*dyadic_product_coeffmod)(
+                ConstCoeffIter operand1, ConstCoeffIter operand2, std::size_t coeff_count, const Modulus &modulus,
+                CoeffIter result);
+        };
+
+        /**
+        Returns the table of kernels for polynomials with 2^coeff_count_power coefficients. The returned reference is
+        to a static table and stays valid for the lifetime of the program.
+        */
+        SEAL_NODISCARD const PolyKernels &get_poly_kernels(int coeff_count_power) noexcept;
+    } // namespace util
+} // namespace seal
@@ -227,20 +227,19 @@ namespace seal
             sample_poly_ternary(prng, parms, u.get());
 
             // c[j] = u * public_key[j]
-            for (size_t i = 0; i < coeff_modulus_size; i++)
+            RNSIter u_iter(u.get(), coeff_count);
+            ntt_negacyclic_harvey(u_iter, coeff_modulus_size, ntt_tables);
+            for (size_t j = 0; j < encrypted_size; j++)
             {
-                ntt_negacyclic_harvey(u.get() + i * coeff_count, ntt_tables[i]);
-                for (size_t j = 0; j < encrypted_size; j++)
-                {
-                    dyadic_product_coeffmod(
-                        u.get() + i * coeff_count, public_key.data().data(j) + i * coeff_count, coeff_count,
-                        coeff_modulus[i], destination.data(j) + i * coeff_count);
+                RNSIter dst_iter(destination.data(j), coeff_count);
+                dyadic_product_coeffmod(
+                    u_iter, ConstRNSIter(public_key.data().data(j), coeff_count), coeff_modulus_size, coeff_modulus,
+                    dst_iter);
 
-                    // Addition with e_0, e_1 is in non-NTT form
-                    if (!is_ntt_form)
-                    {
-                        inverse_ntt_negacyclic_harvey(destination.data(j) + i * coeff_count, ntt_tables[i]);
-                    }
+                // Addition with e_0, e_1 is in non-NTT form
+                if (!is_ntt_form)
+                {
+                    inverse_ntt_negacyclic_harvey(dst_iter, coeff_modulus_size, ntt_tables);
                 }
             }
 
@@ -342,11 +341,9 @@ namespace seal
             {
                 // Sample non-NTT form and store the seed
                 sample_poly_uniform(ciphertext_prng, parms, c1);
-                for (size_t i = 0; i < coeff_modulus_size; i++)
-                {
-                    // Transform the c1 into NTT representation
-                    ntt_negacyclic_harvey(c1 + i * coeff_count, ntt_tables[i]);
-                }
+
+                // Transform the c1 into NTT representation
+                ntt_negacyclic_harvey(RNSIter(c1, coeff_count), coeff_modulus_size, ntt_tables);
             }
 
             // Sample e <-- chi
@@ -355,44 +352,38 @@ namespace seal
 
             // Calculate -(as+ e) (mod q) and store in c[0] in BFV/CKKS
             // Calculate -(as+pe) (mod q) and store in c[0] in BGV
-            for (size_t i = 0; i < coeff_modulus_size; i++)
+            RNSIter c0_iter(c0, coeff_count);
+            RNSIter c1_iter(c1, coeff_count);
+            RNSIter noise_iter(noise.get(), coeff_count);
+            dyadic_product_coeffmod(
+                ConstRNSIter(secret_key.data().data(), coeff_count), c1_iter, coeff_modulus_size, coeff_modulus,
+                c0_iter);
+            if (is_ntt_form)
             {
-                dyadic_product_coeffmod(
-                    secret_key.data().data() + i * coeff_count, c1 + i * coeff_count, coeff_count, coeff_modulus[i],
-                    c0 + i * coeff_count);
-                if (is_ntt_form)
-                {
-                    // Transform the noise e into NTT representation
-                    ntt_negacyclic_harvey(noise.get() + i * coeff_count, ntt_tables[i]);
-                }
-                else
-                {
-                    inverse_ntt_negacyclic_harvey(c0 + i * coeff_count, ntt_tables[i]);
-                }
-
-                if (type == scheme_type::bgv)
-                {
-                    // noise = pe instead of e in BGV
-                    multiply_poly_scalar_coeffmod(
-                        noise.get() + i * coeff_count, coeff_count, plain_modulus.value(), coeff_modulus[i],
-                        noise.get() + i * coeff_count);
-                }
+                // Transform the noise e into NTT representation
+                ntt_negacyclic_harvey(noise_iter, coeff_modulus_size, ntt_tables);
+            }
+            else
+            {
+                inverse_ntt_negacyclic_harvey(c0_iter, coeff_modulus_size, ntt_tables);
+            }
 
-                // c0 = as + noise
-                add_poly_coeffmod(
-                    noise.get() + i * coeff_count, c0 + i * coeff_count, coeff_count, coeff_modulus[i],
-                    c0 + i * coeff_count);
-                // (as + noise, a) -> (-(as + noise), a),
-                negate_poly_coeffmod(c0 + i * coeff_count, coeff_count, coeff_modulus[i], c0 + i * coeff_count);
+            if (type == scheme_type::bgv)
+            {
+                // noise = pe instead of e in BGV
+                multiply_poly_scalar_coeffmod(
+                    noise_iter, coeff_modulus_size, plain_modulus.value(), coeff_modulus, noise_iter);
             }
 
+            // c0 = as + noise
+            add_poly_coeffmod(noise_iter, c0_iter, coeff_modulus_size, coeff_modulus, c0_iter);
+            // (as + noise, a) -> (-(as + noise), a),
+            negate_poly_coeffmod(c0_iter, coeff_modulus_size, coeff_modulus, c0_iter);
+
             if (!is_ntt_form && !save_seed)
             {
-                for (size_t i = 0; i < coeff_modulus_size; i++)
-                {
-                    // Transform the c1 into non-NTT representation
-                    inverse_ntt_negacyclic_harvey(c1 + i * coeff_count, ntt_tables[i]);
-                }
+                // Transform the c1 into non-NTT representation
+                inverse_ntt_negacyclic_harvey(c1_iter, coeff_modulus_size, ntt_tables);
             }
 
             if (save_seed)
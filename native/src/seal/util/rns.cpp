@@ -5,6 +5,7 @@
 #include "seal/util/numth.h"
 #include "seal/util/polyarithsmallmod.h"
 #include "seal/util/rns.h"
+#include "seal/util/threadpool.h"
 #include "seal/util/uintarithmod.h"
 #include "seal/util/uintarithsmallmod.h"
 #include <algorithm>
@@ -427,37 +428,34 @@ namespace seal
             size_t obase_size = obase_.size();
             size_t count = in.poly_modulus_degree();
 
-            // Note that the stride size is ibase_size
-            SEAL_ALLOCATE_GET_STRIDE_ITER(temp, uint64_t, count, ibase_size, pool);
+            // The conversion is the product of the base-change matrix and the ibase_size x count matrix of
+            // [in * (prod(ibase) / q_i)^(-1)]_{q_i}. It is computed in blocks of coefficients so that the rows of the
+            // latter stay in cache while all obase rows of the result are accumulated from them.
+            int temp_bit_count = 0;
+            for (size_t i = 0; i < ibase_size; i++)
+            {
+                temp_bit_count = max(temp_bit_count, ibase_[i].bit_count());
+            }
 
-            SEAL_ITERATE(
-                iter(in, ibase_.inv_punctured_prod_mod_base_array(), ibase_.base(), size_t(0)), ibase_size,
-                [&](auto I) {
-                    // The current ibase index
-                    size_t ibase_index = get<3>(I);
+            constexpr size_t block_coeff_count_max = size_t(1) << SEAL_BASE_CONVERT_BLOCK_COEFF_COUNT_POWER;
+            size_t block_count = (count + block_coeff_count_max - 1) / block_coeff_count_max;
+            SEAL_ITERATE_PARALLEL(pool, iter(size_t(0)), block_count, [&](auto I) {
+                size_t block_offset = I * block_coeff_count_max;
+                size_t block_coeff_count = min(block_coeff_count_max, count - block_offset);
 
-                    if (get<1>(I).operand == 1)
-                    {
-                        // No multiplication needed
-                        SEAL_ITERATE(iter(get<0>(I), temp), count, [&](auto J) {
-                            // Reduce modulo ibase element
-                            get<1>(J)[ibase_index] = barrett_reduce_64(get<0>(J), get<2>(I));
-                        });
-                    }
-                    else
-                    {
-                        // Multiplication needed
-                        SEAL_ITERATE(iter(get<0>(I), temp), count, [&](auto J) {
-                            // Multiply coefficient of in with ibase_.inv_punctured_prod_mod_base_array_ element
-                            get<1>(J)[ibase_index] = multiply_uint_mod(get<0>(J), get<1>(I), get<2>(I));
-                        });
-                    }
-                });
+                SEAL_ALLOCATE_GET_RNS_ITER(temp, block_coeff_count, ibase_size, pool);
+                SEAL_ITERATE(
+                    iter(in, ibase_.inv_punctured_prod_mod_base_array(), ibase_.base(), temp), ibase_size,
+                    [&](auto J) {
+                        // Multiply coefficients of in with ibase_.inv_punctured_prod_mod_base_array_ element
+                        multiply_poly_scalar_coeffmod(
+                            get<0>(J) + block_offset, block_coeff_count, get<1>(J), get<2>(J), get<3>(J));
+                    });
 
-            SEAL_ITERATE(iter(out, base_change_matrix_, obase_.base()), obase_size, [&](auto I) {
-                SEAL_ITERATE(iter(get<0>(I), temp), count, [&](auto J) {
-                    // Compute the base conversion sum modulo obase element
-                    get<0>(J) = dot_product_mod(get<1>(J), get<1>(I).get(), ibase_size, get<2>(I));
+                SEAL_ITERATE(iter(out, base_change_operands_, obase_.base()), obase_size, [&](auto J) {
+                    // Compute the base conversion sums modulo obase element
+                    linear_combination_poly_coeffmod(
+                        temp, ibase_size, get<1>(J).get(), get<2>(J), temp_bit_count, get<0>(J) + block_offset);
                 });
             });
         }
@@ -526,7 +524,7 @@ namespace seal
             });
 
             auto p = obase_.base()[0];
-            auto q_mod_p = modulo_uint(ibase_.base_prod(), ibase_size, p);
+            auto q_mod_p = ibase_prod_mod_obase_[0];
             auto base_change_matrix_first = base_change_matrix_[0].get();
             // Final multiplication
             SEAL_ITERATE(iter(out, temp, aggregated_rounded_v), count, [&](auto J) {
@@ -538,6 +536,56 @@ namespace seal
             });
         }
 
+        void BaseConverter::exact_convert_array(ConstRNSIter in, RNSIter out, MemoryPoolHandle pool) const
+        {
+#ifdef SEAL_DEBUG
+            if (in.poly_modulus_degree() != out.poly_modulus_degree())
+            {
+                throw invalid_argument("in and out are incompatible");
+            }
+#endif
+            size_t ibase_size = ibase_.size();
+            size_t obase_size = obase_.size();
+            size_t count = in.poly_modulus_degree();
+
+            // Note that the stride size is ibase_size
+            SEAL_ALLOCATE_GET_STRIDE_ITER(temp, uint64_t, count, ibase_size, pool);
+
+            // Sum of the fractions [x_{i} * \hat{q_{i}}^{-1}]_{q_{i}} / q_{i}, and the rounded sum v
+            SEAL_ALLOCATE_GET_PTR_ITER(fraction_sum, double, count, pool);
+            fill_n(fraction_sum.ptr(), count, 0.0);
+            SEAL_ALLOCATE_GET_PTR_ITER(v, uint64_t, count, pool);
+
+            // Calculate [x_{i} * \hat{q_{i}}^{-1}]_{q_{i}}; the fractions are accumulated in the same order for every
+            // coefficient so that the result is deterministic
+            SEAL_ITERATE(
+                iter(in, ibase_.inv_punctured_prod_mod_base_array(), ibase_.base(), size_t(0)), ibase_size,
+                [&](auto I) {
+                    size_t ibase_index = get<3>(I);
+                    double inv_divisor = 1.0 / static_cast<double>(get<2>(I).value());
+                    SEAL_ITERATE(iter(get<0>(I), temp, fraction_sum), count, [&](auto J) {
+                        uint64_t value = multiply_uint_mod(get<0>(J), get<1>(I), get<2>(I));
+                        get<1>(J)[ibase_index] = value;
+                        get<2>(J) += static_cast<double>(value) * inv_divisor;
+                    });
+                });
+
+            // The sum lies in [0, ibase_size); rounding selects the centered representative
+            SEAL_ITERATE(iter(fraction_sum, v), count, [&](auto I) {
+                get<1>(I) = static_cast<uint64_t>(get<0>(I) + 0.5);
+            });
+
+            SEAL_ITERATE_PARALLEL(
+                iter(out, base_change_matrix_, obase_.base(), ibase_prod_mod_obase_), obase_size, [&](auto I) {
+                    SEAL_ITERATE(iter(get<0>(I), temp, v), count, [&](auto J) {
+                        // Compute the base conversion sum modulo obase element, minus v * [q]_{p}
+                        uint64_t sum_mod_obase = dot_product_mod(get<1>(J), get<1>(I).get(), ibase_size, get<2>(I));
+                        uint64_t v_q_mod_p = multiply_uint_mod(get<2>(J), get<3>(I), get<2>(I));
+                        get<0>(J) = sub_uint_mod(sum_mod_obase, v_q_mod_p, get<2>(I));
+                    });
+                });
+        }
+
         void BaseConverter::initialize()
         {
             // Verify that the size is not too large
@@ -559,6 +607,21 @@ namespace seal
                     get<0>(J) = modulo_uint(get<1>(J), ibase_.size(), get<1>(I));
                 });
             });
+
+            // The base-change matrix with quotients for the lazy products in fast_convert_array
+            base_change_operands_ = allocate<Pointer<MultiplyUIntModOperand>>(obase_.size(), pool_);
+            SEAL_ITERATE(iter(base_change_operands_, base_change_matrix_, obase_.base()), obase_.size(), [&](auto I) {
+                get<0>(I) = allocate<MultiplyUIntModOperand>(ibase_.size(), pool_);
+                SEAL_ITERATE(iter(get<0>(I), get<1>(I)), ibase_.size(), [&](auto J) {
+                    get<0>(J).set(get<1>(J), get<2>(I));
+                });
+            });
+
+            // Compute prod(ibase) mod obase
+            ibase_prod_mod_obase_ = allocate_uint(obase_.size(), pool_);
+            SEAL_ITERATE(iter(ibase_prod_mod_obase_, obase_.base()), obase_.size(), [&](auto I) {
+                get<0>(I) = modulo_uint(ibase_.base_prod(), ibase_.size(), get<1>(I));
+            });
         }
 
         RNSTool::RNSTool(
@@ -674,6 +737,9 @@ namespace seal
             // Set up BaseConverter for B --> q
             base_B_to_q_conv_ = allocate<BaseConverter>(pool_, *base_B_, *base_q_, pool_);
 
+            // Set up BaseConverter for Bsk --> q
+            base_Bsk_to_q_conv_ = allocate<BaseConverter>(pool_, *base_Bsk_, *base_q_, pool_);
+
             // Set up BaseConverter for B --> {m_sk}
             base_B_to_m_sk_conv_ = allocate<BaseConverter>(pool_, *base_B_, RNSBase({ m_sk_ }, pool_), pool_);
 
@@ -764,6 +830,60 @@ namespace seal
                 });
             }
 
+            if (!t_.is_zero())
+            {
+                // HPS scaling computes round(t/q * x) for x in base q U Bsk as
+                //
+                //   sum_i x_i * t * [(q/q_i)^(-1)]_{q_i} / q_i + x'_j * t * q^(-1) mod Bsk[j],
+                //
+                // where x' is the Bsk part of x. With r_i = [t * (q/q_i)^(-1)]_{q_i}, the coefficient of x_i splits
+                // into a fractional part r_i / q_i and an integer part congruent to -r_i * q_i^(-1) modulo Bsk[j]
+                // and t. The residues are split into 32-bit halves to keep the floating-point error small.
+                hps_frac_lo_ = allocate<double>(base_q_size, pool_);
+                hps_frac_hi_ = allocate<double>(base_q_size, pool_);
+                hps_int_lo_mod_Bsk_ = allocate_uint(mul_safe(base_Bsk_size, base_q_size), pool_);
+                hps_int_hi_mod_Bsk_ = allocate_uint(mul_safe(base_Bsk_size, base_q_size), pool_);
+                hps_int_lo_mod_t_ = allocate_uint(base_q_size, pool_);
+                hps_int_hi_mod_t_ = allocate_uint(base_q_size, pool_);
+                for (size_t i = 0; i < base_q_size; i++)
+                {
+                    const Modulus &qi = (*base_q_)[i];
+                    uint64_t frac_lo = multiply_uint_mod(
+                        barrett_reduce_64(t_.value(), qi), base_q_->inv_punctured_prod_mod_base_array()[i], qi);
+                    uint64_t frac_hi = multiply_uint_mod(frac_lo, barrett_reduce_64(uint64_t(1) << 32, qi), qi);
+                    hps_frac_lo_[i] = static_cast<double>(frac_lo) / static_cast<double>(qi.value());
+                    hps_frac_hi_[i] = static_cast<double>(frac_hi) / static_cast<double>(qi.value());
+
+                    auto set_int_parts = [&](const Modulus &modulus, uint64_t &int_lo, uint64_t &int_hi) {
+                        uint64_t inv_qi;
+                        if (!try_invert_uint_mod(barrett_reduce_64(qi.value(), modulus), modulus, inv_qi))
+                        {
+                            throw logic_error("invalid rns bases");
+                        }
+                        int_lo = negate_uint_mod(
+                            multiply_uint_mod(barrett_reduce_64(frac_lo, modulus), inv_qi, modulus), modulus);
+                        int_hi = negate_uint_mod(
+                            multiply_uint_mod(barrett_reduce_64(frac_hi, modulus), inv_qi, modulus), modulus);
+                    };
+                    for (size_t j = 0; j < base_Bsk_size; j++)
+                    {
+                        set_int_parts(
+                            (*base_Bsk_)[j], hps_int_lo_mod_Bsk_[j * base_q_size + i],
+                            hps_int_hi_mod_Bsk_[j * base_q_size + i]);
+                    }
+                    set_int_parts(t_, hps_int_lo_mod_t_[i], hps_int_hi_mod_t_[i]);
+                }
+
+                // Compute t * prod(q)^(-1) mod Bsk
+                t_inv_prod_q_mod_Bsk_ = allocate<MultiplyUIntModOperand>(base_Bsk_size, pool_);
+                SEAL_ITERATE(
+                    iter(t_inv_prod_q_mod_Bsk_, inv_prod_q_mod_Bsk_, base_Bsk_->base()), base_Bsk_size, [&](auto I) {
+                        get<0>(I).set(
+                            multiply_uint_mod(barrett_reduce_64(t_.value(), get<2>(I)), get<1>(I), get<2>(I)),
+                            get<2>(I));
+                    });
+            }
+
             // Compute q[last]^(-1) mod q[i] for i = 0..last-1
             // This is used by modulus switching and rescaling
             inv_q_last_mod_q_ = allocate<MultiplyUIntModOperand>(base_q_size - 1, pool_);
@@ -1200,6 +1320,161 @@ namespace seal
             });
         }
 
+        void RNSTool::exact_bconv_q_to_Bsk(ConstRNSIter input, RNSIter destination, MemoryPoolHandle pool) const
+        {
+#ifdef SEAL_DEBUG
+            if (!input)
+            {
+                throw invalid_argument("input cannot be null");
+            }
+            if (!destination)
+            {
+                throw invalid_argument("destination cannot be null");
+            }
+            if (!pool)
+            {
+                throw invalid_argument("pool is uninitialized");
+            }
+#endif
+            base_q_to_Bsk_conv_->exact_convert_array(input, destination, pool);
+        }
+
+        void RNSTool::exact_bconv_Bsk_to_q(ConstRNSIter input, RNSIter destination, MemoryPoolHandle pool) const
+        {
+#ifdef SEAL_DEBUG
+            if (!input)
+            {
+                throw invalid_argument("input cannot be null");
+            }
+            if (!destination)
+            {
+                throw invalid_argument("destination cannot be null");
+            }
+            if (!pool)
+            {
+                throw invalid_argument("pool is uninitialized");
+            }
+#endif
+            base_Bsk_to_q_conv_->exact_convert_array(input, destination, pool);
+        }
+
+        void RNSTool::hps_round_fractions(
+            ConstRNSIter input, PtrIter<uint64_t *> destination, MemoryPoolHandle pool) const
+        {
+            size_t base_q_size = base_q_->size();
+
+            SEAL_ALLOCATE_GET_PTR_ITER(fraction_sum, double, coeff_count_, pool);
+            fill_n(fraction_sum.ptr(), coeff_count_, 0.0);
+            SEAL_ITERATE(iter(input, hps_frac_lo_, hps_frac_hi_), base_q_size, [&](auto I) {
+                SEAL_ITERATE(iter(get<0>(I), fraction_sum), coeff_count_, [&](auto J) {
+                    get<1>(J) += static_cast<double>(get<0>(J) & 0xFFFFFFFFULL) * get<1>(I) +
+                                 static_cast<double>(get<0>(J) >> 32) * get<2>(I);
+                });
+            });
+
+            // The sum is non-negative and less than 2^33 * base_q_size
+            SEAL_ITERATE(iter(fraction_sum, destination), coeff_count_, [&](auto I) {
+                get<1>(I) = static_cast<uint64_t>(get<0>(I) + 0.5);
+            });
+        }
+
+        void RNSTool::hps_scale_and_round(ConstRNSIter input, RNSIter destination, MemoryPoolHandle pool) const
+        {
+#ifdef SEAL_DEBUG
+            if (!input)
+            {
+                throw invalid_argument("input cannot be null");
+            }
+            if (input.poly_modulus_degree() != coeff_count_)
+            {
+                throw invalid_argument("input is not valid for encryption parameters");
+            }
+            if (!destination)
+            {
+                throw invalid_argument("destination cannot be null");
+            }
+            if (!pool)
+            {
+                throw invalid_argument("pool is uninitialized");
+            }
+#endif
+            size_t base_q_size = base_q_->size();
+            size_t base_Bsk_size = base_Bsk_->size();
+
+            // Rounded fractional parts
+            SEAL_ALLOCATE_GET_PTR_ITER(rounded, uint64_t, coeff_count_, pool);
+            hps_round_fractions(input, rounded, pool);
+
+            // Add the integer parts modulo each Bsk prime; the sum of at most 2 * base_q_size + 2 products of 93 bits
+            // does not overflow 128 bits
+            SEAL_ITERATE_PARALLEL(
+                iter(destination, input + base_q_size, t_inv_prod_q_mod_Bsk_, base_Bsk_->base(), size_t(0)),
+                base_Bsk_size, [&](auto I) {
+                    const uint64_t *int_lo = hps_int_lo_mod_Bsk_.get() + get<4>(I) * base_q_size;
+                    const uint64_t *int_hi = hps_int_hi_mod_Bsk_.get() + get<4>(I) * base_q_size;
+                    for (size_t j = 0; j < coeff_count_; j++)
+                    {
+                        unsigned long long accumulator[2]{ rounded[j], 0 };
+                        unsigned long long product[2];
+                        for (size_t i = 0; i < base_q_size; i++)
+                        {
+                            uint64_t x = input[i][j];
+                            multiply_uint64(x & 0xFFFFFFFFULL, int_lo[i], product);
+                            add_uint128(product, accumulator, accumulator);
+                            multiply_uint64(x >> 32, int_hi[i], product);
+                            add_uint128(product, accumulator, accumulator);
+                        }
+                        uint64_t result = barrett_reduce_128(accumulator, get<3>(I));
+                        get<0>(I)[j] = add_uint_mod(
+                            result, multiply_uint_mod(get<1>(I)[j], get<2>(I), get<3>(I)), get<3>(I));
+                    }
+                });
+        }
+
+        void RNSTool::hps_decrypt_scale_and_round(
+            ConstRNSIter phase, CoeffIter destination, MemoryPoolHandle pool) const
+        {
+#ifdef SEAL_DEBUG
+            if (!phase)
+            {
+                throw invalid_argument("phase cannot be null");
+            }
+            if (phase.poly_modulus_degree() != coeff_count_)
+            {
+                throw invalid_argument("phase is not valid for encryption parameters");
+            }
+            if (!destination)
+            {
+                throw invalid_argument("destination cannot be null");
+            }
+            if (!pool)
+            {
+                throw invalid_argument("pool is uninitialized");
+            }
+#endif
+            size_t base_q_size = base_q_->size();
+
+            // Rounded fractional parts
+            SEAL_ALLOCATE_GET_PTR_ITER(rounded, uint64_t, coeff_count_, pool);
+            hps_round_fractions(phase, rounded, pool);
+
+            // Add the integer parts modulo t
+            for (size_t j = 0; j < coeff_count_; j++)
+            {
+                unsigned long long accumulator[2]{ rounded[j], 0 };
+                unsigned long long product[2];
+                for (size_t i = 0; i < base_q_size; i++)
+                {
+                    uint64_t x = phase[i][j];
+                    multiply_uint64(x & 0xFFFFFFFFULL, hps_int_lo_mod_t_[i], product);
+                    add_uint128(product, accumulator, accumulator);
+                    multiply_uint64(x >> 32, hps_int_hi_mod_t_[i], product);
+                    add_uint128(product, accumulator, accumulator);
+                }
+                destination[j] = barrett_reduce_128(accumulator, t_);
+            }
+        }
+
         void RNSTool::mod_t_and_divide_q_last_inplace(RNSIter input, MemoryPoolHandle pool) const
         {
             size_t modulus_size = base_q_->size();
@@ -1244,5 +1519,284 @@ namespace seal
             // Use exact base convension rather than convert the base through the compose API
             base_q_to_t_conv_->exact_convert_array(phase, destination, pool);
         }
+
+        KSwitchTool::KSwitchTool(
+            size_t poly_modulus_degree, const RNSBase &q, const RNSBase &p, size_t digit_size,
+            const Modulus &plain_modulus, MemoryPoolHandle pool)
+            : pool_(move(pool)), digit_size_(digit_size)
+        {
+            if (!pool_)
+            {
+                throw invalid_argument("pool is uninitialized");
+            }
+            if (!digit_size_)
+            {
+                throw invalid_argument("digit_size is invalid");
+            }
+            initialize(poly_modulus_degree, q, p, plain_modulus);
+        }
+
+        void KSwitchTool::initialize(size_t poly_modulus_degree, const RNSBase &q, const RNSBase &p, const Modulus &t)
+        {
+            // Return if q or p is out of bounds
+            if (q.size() < SEAL_COEFF_MOD_COUNT_MIN || p.size() < SEAL_COEFF_MOD_COUNT_MIN ||
+                add_safe(q.size(), p.size()) > SEAL_COEFF_MOD_COUNT_MAX)
+            {
+                throw invalid_argument("rnsbase is invalid");
+            }
+
+            // Return if coeff_count is not a power of two or out of bounds
+            int coeff_count_power = get_power_of_two(poly_modulus_degree);
+            if (coeff_count_power < 0 || poly_modulus_degree > SEAL_POLY_MOD_DEGREE_MAX ||
+                poly_modulus_degree < SEAL_POLY_MOD_DEGREE_MIN)
+            {
+                throw invalid_argument("poly_modulus_degree is invalid");
+            }
+
+            t_ = t;
+            coeff_count_ = poly_modulus_degree;
+
+            size_t base_q_size = q.size();
+            size_t base_p_size = p.size();
+            base_q_ = allocate<RNSBase>(pool_, q, pool_);
+            base_p_ = allocate<RNSBase>(pool_, p, pool_);
+            digit_count_ = divide_round_up(base_q_size, digit_size_);
+
+            // Set up a BaseConverter from each digit to the remaining primes of q followed by p; the order matches
+            // the layout of the extended polynomial so that mod_up can copy the result in two contiguous pieces
+            for (size_t j = 0; j < digit_count_; j++)
+            {
+                size_t digit_begin = j * digit_size_;
+                size_t digit_end = digit_begin + digit_modulus_size(j);
+                vector<Modulus> digit_primes(q.base() + digit_begin, q.base() + digit_end);
+                vector<Modulus> other_primes(q.base(), q.base() + digit_begin);
+                other_primes.insert(other_primes.end(), q.base() + digit_end, q.base() + base_q_size);
+                other_primes.insert(other_primes.end(), p.base(), p.base() + base_p_size);
+                digit_conv_.emplace_back(allocate<BaseConverter>(
+                    pool_, RNSBase(digit_primes, pool_), RNSBase(other_primes, pool_), pool_));
+            }
+
+            // Set up BaseConverter for p --> q
+            base_p_to_q_conv_ = allocate<BaseConverter>(pool_, *base_p_, *base_q_, pool_);
+
+            if (!t_.is_zero())
+            {
+                // Set up BaseConverter for p --> {t}
+                base_p_to_t_conv_ = allocate<BaseConverter>(pool_, *base_p_, RNSBase({ t_ }, pool_), pool_);
+            }
+
+            // Compute prod(p) mod q and prod(p)^(-1) mod q
+            uint64_t temp;
+            p_mod_q_ = allocate_uint(base_q_size, pool_);
+            inv_p_mod_q_ = allocate<MultiplyUIntModOperand>(base_q_size, pool_);
+            SEAL_ITERATE(iter(p_mod_q_, inv_p_mod_q_, base_q_->base()), base_q_size, [&](auto I) {
+                get<0>(I) = modulo_uint(base_p_->base_prod(), base_p_size, get<2>(I));
+                if (!try_invert_uint_mod(get<0>(I), get<2>(I), temp))
+                {
+                    throw logic_error("invalid rns bases");
+                }
+                get<1>(I).set(temp, get<2>(I));
+            });
+
+            // Compute floor(prod(p) / 2) modulo p and q; these are used to change from flooring to rounding
+            auto half_p(allocate_uint(base_p_size, pool_));
+            right_shift_uint(base_p_->base_prod(), 1, base_p_size, half_p.get());
+            half_p_mod_p_ = allocate_uint(base_p_size, pool_);
+            SEAL_ITERATE(iter(half_p_mod_p_, base_p_->base()), base_p_size, [&](auto I) {
+                get<0>(I) = modulo_uint(half_p.get(), base_p_size, get<1>(I));
+            });
+            half_p_mod_q_ = allocate_uint(base_q_size, pool_);
+            SEAL_ITERATE(iter(half_p_mod_q_, base_q_->base()), base_q_size, [&](auto I) {
+                get<0>(I) = modulo_uint(half_p.get(), base_p_size, get<1>(I));
+            });
+
+            if (!t_.is_zero())
+            {
+                // Compute -prod(p)^(-1) mod t
+                temp = modulo_uint(base_p_->base_prod(), base_p_size, t_);
+                if (!try_invert_uint_mod(temp, t_, temp))
+                {
+                    throw logic_error("invalid rns bases");
+                }
+                neg_inv_p_mod_t_.set(negate_uint_mod(temp, t_), t_);
+            }
+        }
+
+        void KSwitchTool::mod_up(
+            ConstRNSIter input, size_t digit_index, RNSIter destination, MemoryPoolHandle pool) const
+        {
+#ifdef SEAL_DEBUG
+            if (!input || !destination)
+            {
+                throw invalid_argument("input and destination cannot be null");
+            }
+            if (input.poly_modulus_degree() != coeff_count_ || destination.poly_modulus_degree() != coeff_count_)
+            {
+                throw invalid_argument("input is not valid for encryption parameters");
+            }
+            if (digit_index >= digit_count_)
+            {
+                throw out_of_range("digit_index");
+            }
+            if (!pool)
+            {
+                throw invalid_argument("pool is uninitialized");
+            }
+#endif
+            size_t base_q_size = base_q_->size();
+            size_t base_p_size = base_p_->size();
+            size_t digit_begin = digit_index * digit_size_;
+            size_t digit_size = digit_modulus_size(digit_index);
+            size_t other_size = base_q_size + base_p_size - digit_size;
+
+            // The digit itself needs no conversion
+            set_uint(input[digit_begin], mul_safe(digit_size, coeff_count_), destination[digit_begin]);
+
+            // Convert to the remaining primes of q followed by p
+            SEAL_ALLOCATE_GET_RNS_ITER(temp, coeff_count_, other_size, pool);
+            digit_conv_[digit_index]->fast_convert_array(input + digit_begin, temp, pool);
+            set_uint(temp, digit_begin * coeff_count_, destination);
+            set_uint(
+                temp[digit_begin], (other_size - digit_begin) * coeff_count_, destination[digit_begin + digit_size]);
+        }
+
+        void KSwitchTool::divide_and_round_p_inplace(RNSIter input, MemoryPoolHandle pool) const
+        {
+#ifdef SEAL_DEBUG
+            if (!input)
+            {
+                throw invalid_argument("input cannot be null");
+            }
+            if (input.poly_modulus_degree() != coeff_count_)
+            {
+                throw invalid_argument("input is not valid for encryption parameters");
+            }
+            if (!pool)
+            {
+                throw invalid_argument("pool is uninitialized");
+            }
+#endif
+            size_t base_q_size = base_q_->size();
+            size_t base_p_size = base_p_->size();
+            RNSIter p_input = input + base_q_size;
+
+            // Add floor(p/2) to change from flooring to rounding
+            SEAL_ITERATE(iter(p_input, half_p_mod_p_, base_p_->base()), base_p_size, [&](auto I) {
+                add_poly_scalar_coeffmod(get<0>(I), coeff_count_, get<1>(I), get<2>(I), get<0>(I));
+            });
+
+            // (ct mod p) in base q
+            SEAL_ALLOCATE_GET_RNS_ITER(temp, coeff_count_, base_q_size, pool);
+            base_p_to_q_conv_->fast_convert_array(p_input, temp, pool);
+
+            SEAL_ITERATE(
+                iter(input, temp, inv_p_mod_q_, half_p_mod_q_, base_q_->base()), base_q_size, [&](auto I) {
+                    // Subtract rounding correction here; the negative sign will turn into a plus in the next
+                    // subtraction
+                    sub_poly_scalar_coeffmod(get<1>(I), coeff_count_, get<3>(I), get<4>(I), get<1>(I));
+
+                    // (ct mod qi) - (ct mod p) mod qi
+                    sub_poly_coeffmod(get<0>(I), get<1>(I), coeff_count_, get<4>(I), get<0>(I));
+
+                    // p^(-1) * ((ct mod qi) - (ct mod p)) mod qi
+                    multiply_poly_scalar_coeffmod(get<0>(I), coeff_count_, get<2>(I), get<4>(I), get<0>(I));
+                });
+        }
+
+        void KSwitchTool::divide_and_round_p_ntt_inplace(
+            RNSIter input, ConstNTTTablesIter q_ntt_tables, ConstNTTTablesIter p_ntt_tables,
+            MemoryPoolHandle pool) const
+        {
+#ifdef SEAL_DEBUG
+            if (!input)
+            {
+                throw invalid_argument("input cannot be null");
+            }
+            if (input.poly_modulus_degree() != coeff_count_)
+            {
+                throw invalid_argument("input is not valid for encryption parameters");
+            }
+            if (!q_ntt_tables || !p_ntt_tables)
+            {
+                throw invalid_argument("rns_ntt_tables cannot be null");
+            }
+            if (!pool)
+            {
+                throw invalid_argument("pool is uninitialized");
+            }
+#endif
+            size_t base_q_size = base_q_->size();
+            size_t base_p_size = base_p_->size();
+            RNSIter p_input = input + base_q_size;
+
+            // Convert to non-NTT form and add floor(p/2) to change from flooring to rounding
+            SEAL_ITERATE(iter(p_input, half_p_mod_p_, base_p_->base(), p_ntt_tables), base_p_size, [&](auto I) {
+                inverse_ntt_negacyclic_harvey(get<0>(I), get<3>(I));
+                add_poly_scalar_coeffmod(get<0>(I), coeff_count_, get<1>(I), get<2>(I), get<0>(I));
+            });
+
+            // (ct mod p) in base q
+            SEAL_ALLOCATE_GET_RNS_ITER(temp, coeff_count_, base_q_size, pool);
+            base_p_to_q_conv_->fast_convert_array(p_input, temp, pool);
+
+            SEAL_ITERATE(
+                iter(input, temp, inv_p_mod_q_, half_p_mod_q_, base_q_->base(), q_ntt_tables), base_q_size,
+                [&](auto I) {
+                    // Subtract rounding correction and return to NTT form
+                    sub_poly_scalar_coeffmod(get<1>(I), coeff_count_, get<3>(I), get<4>(I), get<1>(I));
+                    ntt_negacyclic_harvey(get<1>(I), get<5>(I));
+
+                    // (ct mod qi) - (ct mod p) mod qi
+                    sub_poly_coeffmod(get<0>(I), get<1>(I), coeff_count_, get<4>(I), get<0>(I));
+
+                    // p^(-1) * ((ct mod qi) - (ct mod p)) mod qi
+                    multiply_poly_scalar_coeffmod(get<0>(I), coeff_count_, get<2>(I), get<4>(I), get<0>(I));
+                });
+        }
+
+        void KSwitchTool::mod_t_and_divide_p_inplace(RNSIter input, MemoryPoolHandle pool) const
+        {
+#ifdef SEAL_DEBUG
+            if (!input)
+            {
+                throw invalid_argument("input cannot be null");
+            }
+            if (input.poly_modulus_degree() != coeff_count_)
+            {
+                throw invalid_argument("input is not valid for encryption parameters");
+            }
+            if (t_.is_zero())
+            {
+                throw logic_error("plain_modulus is not set");
+            }
+            if (!pool)
+            {
+                throw invalid_argument("pool is uninitialized");
+            }
+#endif
+            size_t base_q_size = base_q_->size();
+            RNSIter p_input = input + base_q_size;
+
+            // (ct mod p) in base q and in {t}; both use the same integer representative
+            SEAL_ALLOCATE_GET_RNS_ITER(temp, coeff_count_, base_q_size, pool);
+            base_p_to_q_conv_->fast_convert_array(p_input, temp, pool);
+            SEAL_ALLOCATE_GET_COEFF_ITER(k, coeff_count_, pool);
+            base_p_to_t_conv_->fast_convert_array(p_input, RNSIter(k, coeff_count_), pool);
+
+            // k = -(ct mod p) * p^(-1) mod t, so that delta = (ct mod p) + p * k = 0 mod t
+            multiply_poly_scalar_coeffmod(k, coeff_count_, neg_inv_p_mod_t_, t_, k);
+
+            SEAL_ALLOCATE_GET_COEFF_ITER(delta, coeff_count_, pool);
+            SEAL_ITERATE(iter(input, temp, p_mod_q_, inv_p_mod_q_, base_q_->base()), base_q_size, [&](auto I) {
+                // delta = (ct mod p) + p * k mod qi
+                modulo_poly_coeffs(k, coeff_count_, get<4>(I), delta);
+                multiply_poly_scalar_coeffmod(delta, coeff_count_, get<2>(I), get<4>(I), delta);
+                add_poly_coeffmod(delta, get<1>(I), coeff_count_, get<4>(I), delta);
+
+                // p^(-1) * ((ct mod qi) - delta) mod qi
+                sub_poly_coeffmod(get<0>(I), delta, coeff_count_, get<4>(I), get<0>(I));
+                multiply_poly_scalar_coeffmod(get<0>(I), coeff_count_, get<3>(I), get<4>(I), get<0>(I));
+            });
+        }
     } // namespace util
 } // namespace seal
@@ -9,6 +9,7 @@
 #include "seal/util/ntt.h"
 #include "seal/util/pointer.h"
 #include "seal/util/uintarithsmallmod.h"
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
@@ -167,6 +168,14 @@ namespace seal
             // The exact base convertion function, only supports obase size of 1.
             void exact_convert_array(ConstRNSIter in, CoeffIter out, MemoryPoolHandle) const;
 
+            /**
+            Exact base conversion of the centered representatives of the input modulo prod(ibase) to an obase of any
+            size. The multiple of prod(ibase) in the fast base conversion sum is found by rounding a floating-point
+            approximation, which is exact unless the input is within a relative distance of about 2^(-50) of
+            prod(ibase)/2.
+            */
+            void exact_convert_array(ConstRNSIter in, RNSIter out, MemoryPoolHandle pool) const;
+
         private:
             BaseConverter(const BaseConverter &copy) = delete;
 
@@ -185,6 +194,12 @@ namespace seal
             RNSBase obase_;
 
             Pointer<Pointer<std::uint64_t>> base_change_matrix_;
+
+            // The same with quotients for multiply_uint_mod
+            Pointer<Pointer<MultiplyUIntModOperand>> base_change_operands_;
+
+            // prod(ibase) mod obase
+            Pointer<std::uint64_t> ibase_prod_mod_obase_;
         };
 
         class RNSTool
@@ -232,6 +247,26 @@ namespace seal
             */
             void decrypt_scale_and_round(ConstRNSIter phase, CoeffIter destination, MemoryPoolHandle pool) const;
 
+            /**
+            HPS exact base conversion from q to Bsk of the centered representatives modulo q
+            */
+            void exact_bconv_q_to_Bsk(ConstRNSIter input, RNSIter destination, MemoryPoolHandle pool) const;
+
+            /**
+            HPS exact base conversion from Bsk to q of the centered representatives modulo prod(Bsk)
+            */
+            void exact_bconv_Bsk_to_q(ConstRNSIter input, RNSIter destination, MemoryPoolHandle pool) const;
+
+            /**
+            HPS scaling: compute round(t/q * input) from q U Bsk to Bsk
+            */
+            void hps_scale_and_round(ConstRNSIter input, RNSIter destination, MemoryPoolHandle pool) const;
+
+            /**
+            HPS decryption scaling: compute round(t/q * |input|_q) mod t
+            */
+            void hps_decrypt_scale_and_round(ConstRNSIter phase, CoeffIter destination, MemoryPoolHandle pool) const;
+
             /**
             Remove the last q for bgv ciphertext
             */
@@ -321,6 +356,13 @@ namespace seal
             */
             void initialize(std::size_t poly_modulus_degree, const RNSBase &q, const Modulus &t);
 
+            /**
+            Computes round(sum_i x_i * (t * [(q/q_i)^(-1)]_{q_i} mod q_i) / q_i) for each coefficient x of the input
+            in base q, i.e., the rounded sum of the fractional parts of the HPS scaling sum.
+            */
+            void hps_round_fractions(ConstRNSIter input, PtrIter<std::uint64_t *> destination, MemoryPoolHandle pool)
+                const;
+
             MemoryPoolHandle pool_;
 
             std::size_t coeff_count_ = 0;
@@ -353,6 +395,9 @@ namespace seal
             // Base converter: q --> t
             Pointer<BaseConverter> base_q_to_t_conv_;
 
+            // Base converter: Bsk --> q
+            Pointer<BaseConverter> base_Bsk_to_q_conv_;
+
             // prod(q)^(-1) mod Bsk
             Pointer<MultiplyUIntModOperand> inv_prod_q_mod_Bsk_;
 
@@ -383,6 +428,27 @@ namespace seal
             // q[last]^(-1) mod q[i] for i = 0..last-1
             Pointer<MultiplyUIntModOperand> inv_q_last_mod_q_;
 
+            // HPS scaling: the residues of the input are split as x_i = 2^32 * hi + lo, and the coefficients of hi
+            // and lo in round(t/q * x) are split into fractional and integer parts
+
+            // Fractional parts for lo and hi
+            Pointer<double> hps_frac_lo_;
+
+            Pointer<double> hps_frac_hi_;
+
+            // Integer parts for lo and hi mod Bsk; row j holds the values for all q_i modulo Bsk[j]
+            Pointer<std::uint64_t> hps_int_lo_mod_Bsk_;
+
+            Pointer<std::uint64_t> hps_int_hi_mod_Bsk_;
+
+            // Integer parts for lo and hi mod t
+            Pointer<std::uint64_t> hps_int_lo_mod_t_;
+
+            Pointer<std::uint64_t> hps_int_hi_mod_t_;
+
+            // t * prod(q)^(-1) mod Bsk
+            Pointer<MultiplyUIntModOperand> t_inv_prod_q_mod_Bsk_;
+
             // NTTTables for Bsk
             Pointer<NTTTables> base_Bsk_ntt_tables_;
 
@@ -398,5 +464,133 @@ namespace seal
 
             std::uint64_t q_last_mod_t_ = 1;
         };
+
+        /**
+        Pre-computations for hybrid keyswitching at one level of the modulus switching chain. The current data
+        coefficient modulus q is split into digits of digit_size consecutive primes, and p is the product of the
+        special primes. ModUp extends a single digit to the base q U p and ModDown divides by p, both through fast
+        base conversion.
+        */
+        class KSwitchTool
+        {
+        public:
+            /**
+            @throws std::invalid_argument if poly_modulus_degree is out of range, q or p are not valid, digit_size is
+            zero, or pool is invalid.
+            @throws std::logic_error if p is not invertible modulo q or plain_modulus.
+            */
+            KSwitchTool(
+                std::size_t poly_modulus_degree, const RNSBase &q, const RNSBase &p, std::size_t digit_size,
+                const Modulus &plain_modulus, MemoryPoolHandle pool);
+
+            /**
+            Extends the digit with index digit_index of input from its own primes to q U p. Input and destination
+            are in non-NTT form; destination must hold q.size() + p.size() components.
+            */
+            void mod_up(ConstRNSIter input, std::size_t digit_index, RNSIter destination, MemoryPoolHandle pool) const;
+
+            /**
+            Computes round(input / p) in base q. Input is in base q U p and in non-NTT form; the result is written
+            to the first q.size() components of input.
+            */
+            void divide_and_round_p_inplace(RNSIter input, MemoryPoolHandle pool) const;
+
+            /**
+            Same as divide_and_round_p_inplace, but input and result are in NTT form.
+            */
+            void divide_and_round_p_ntt_inplace(
+                RNSIter input, ConstNTTTablesIter q_ntt_tables, ConstNTTTablesIter p_ntt_tables,
+                MemoryPoolHandle pool) const;
+
+            /**
+            Computes (input - delta) / p in base q, where delta = input mod p and delta = 0 mod t, as required
+            for BGV. Input is in base q U p and in non-NTT form; the result is written to the first q.size()
+            components of input.
+            */
+            void mod_t_and_divide_p_inplace(RNSIter input, MemoryPoolHandle pool) const;
+
+            SEAL_NODISCARD inline std::size_t digit_size() const noexcept
+            {
+                return digit_size_;
+            }
+
+            SEAL_NODISCARD inline std::size_t digit_count() const noexcept
+            {
+                return digit_count_;
+            }
+
+            /**
+            Returns the number of primes in the digit with index digit_index; only the last digit can be smaller
+            than digit_size.
+            */
+            SEAL_NODISCARD inline std::size_t digit_modulus_size(std::size_t digit_index) const noexcept
+            {
+                return std::min(digit_size_, base_q_->size() - digit_index * digit_size_);
+            }
+
+            SEAL_NODISCARD inline auto base_q() const noexcept
+            {
+                return base_q_.get();
+            }
+
+            SEAL_NODISCARD inline auto base_p() const noexcept
+            {
+                return base_p_.get();
+            }
+
+            SEAL_NODISCARD inline auto p_mod_q() const noexcept
+            {
+                return p_mod_q_.get();
+            }
+
+        private:
+            KSwitchTool(const KSwitchTool &copy) = delete;
+
+            KSwitchTool(KSwitchTool &&source) = delete;
+
+            KSwitchTool &operator=(const KSwitchTool &assign) = delete;
+
+            KSwitchTool &operator=(KSwitchTool &&assign) = delete;
+
+            void initialize(std::size_t poly_modulus_degree, const RNSBase &q, const RNSBase &p, const Modulus &t);
+
+            MemoryPoolHandle pool_;
+
+            std::size_t coeff_count_ = 0;
+
+            std::size_t digit_size_ = 0;
+
+            std::size_t digit_count_ = 0;
+
+            Pointer<RNSBase> base_q_;
+
+            Pointer<RNSBase> base_p_;
+
+            // Base converters: digit --> (q \ digit) U p
+            std::vector<Pointer<BaseConverter>> digit_conv_;
+
+            // Base converter: p --> q
+            Pointer<BaseConverter> base_p_to_q_conv_;
+
+            // Base converter: p --> {t}
+            Pointer<BaseConverter> base_p_to_t_conv_;
+
+            // prod(p) mod q[i]
+            Pointer<std::uint64_t> p_mod_q_;
+
+            // prod(p)^(-1) mod q[i]
+            Pointer<MultiplyUIntModOperand> inv_p_mod_q_;
+
+            // floor(prod(p) / 2) mod p[i]
+            Pointer<std::uint64_t> half_p_mod_p_;
+
+            // floor(prod(p) / 2) mod q[i]
+            Pointer<std::uint64_t> half_p_mod_q_;
+
+            // -prod(p)^(-1) mod t
+            MultiplyUIntModOperand neg_inv_p_mod_t_;
+
+            Modulus t_;
+        };
     } // namespace util
 } // namespace seal
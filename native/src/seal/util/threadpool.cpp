@@ -0,0 +1,212 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/util/threadpool.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+using namespace std;
+
+namespace seal
+{
+    namespace util
+    {
+        namespace
+        {
+            thread_local bool thread_in_parallel_region = false;
+
+            // Marks the current thread as executing a parallel loop for the lifetime of the object
+            class ParallelRegionGuard
+            {
+            public:
+                ParallelRegionGuard() noexcept : previous_(thread_in_parallel_region)
+                {
+                    thread_in_parallel_region = true;
+                }
+
+                ~ParallelRegionGuard()
+                {
+                    thread_in_parallel_region = previous_;
+                }
+
+            private:
+                bool previous_;
+            };
+
+            // State of a single parallel loop shared between the calling thread and the workers. Workers that
+            // pick up their task late may outlive the call to parallel_for, so this is reference counted.
+            struct ParallelLoop
+            {
+                ParallelLoop(size_t count, const function<void(size_t)> &func)
+                    : count(count), func(func), scope_function(AllocationScope::current())
+                {}
+
+                // Runs iterations until none are left
+                void run()
+                {
+                    ParallelRegionGuard guard;
+
+                    // Allocations of the workers are traced as made by the function that started the loop
+                    AllocationScope scope(scope_function);
+                    size_t i;
+                    while ((i = next.fetch_add(1)) < count)
+                    {
+                        try
+                        {
+                            func(i);
+                        }
+                        catch (...)
+                        {
+                            lock_guard<std::mutex> lock(done_mutex);
+                            if (!exception)
+                            {
+                                exception = current_exception();
+                            }
+                        }
+                        if (done.fetch_add(1) + 1 == count)
+                        {
+                            lock_guard<std::mutex> lock(done_mutex);
+                            done_cond.notify_all();
+                        }
+                    }
+                }
+
+                const size_t count;
+
+                // Only called for valid iterations, all of which complete before parallel_for returns
+                const function<void(size_t)> &func;
+
+                // Outermost AllocationScope of the calling thread
+                const char *const scope_function;
+
+                atomic<size_t> next{ 0 };
+
+                atomic<size_t> done{ 0 };
+
+                std::mutex done_mutex;
+
+                condition_variable done_cond;
+
+                exception_ptr exception;
+            };
+        } // namespace
+
+        ThreadPool::ThreadPool(size_t thread_count)
+        {
+            set_thread_count(thread_count);
+        }
+
+        ThreadPool::~ThreadPool()
+        {
+            stop_workers();
+        }
+
+        ThreadPool &ThreadPool::Global()
+        {
+            static ThreadPool global_pool(max<size_t>(thread::hardware_concurrency(), 1));
+            return global_pool;
+        }
+
+        size_t ThreadPool::thread_count() const
+        {
+            lock_guard<std::mutex> lock(mutex_);
+            return workers_.size() + 1;
+        }
+
+        void ThreadPool::set_thread_count(size_t thread_count)
+        {
+            stop_workers();
+            start_workers(thread_count ? thread_count - 1 : 0);
+        }
+
+        bool ThreadPool::in_parallel_region() noexcept
+        {
+            return thread_in_parallel_region;
+        }
+
+        void ThreadPool::parallel_for(size_t count, const function<void(size_t)> &func)
+        {
+            size_t helper_count;
+            {
+                lock_guard<std::mutex> lock(mutex_);
+                helper_count = min(workers_.size(), count ? count - 1 : 0);
+            }
+            if (!helper_count || in_parallel_region())
+            {
+                ParallelRegionGuard guard;
+                for (size_t i = 0; i < count; i++)
+                {
+                    func(i);
+                }
+                return;
+            }
+
+            auto loop = make_shared<ParallelLoop>(count, func);
+            {
+                lock_guard<std::mutex> lock(mutex_);
+                for (size_t i = 0; i < helper_count; i++)
+                {
+                    tasks_.emplace_back([loop] { loop->run(); });
+                }
+            }
+            cond_.notify_all();
+
+            // The calling thread takes part in the work and then waits for iterations taken by the workers
+            loop->run();
+            {
+                unique_lock<std::mutex> lock(loop->done_mutex);
+                loop->done_cond.wait(lock, [&] { return loop->done.load() == count; });
+            }
+            if (loop->exception)
+            {
+                rethrow_exception(loop->exception);
+            }
+        }
+
+        void ThreadPool::start_workers(size_t worker_count)
+        {
+            lock_guard<std::mutex> lock(mutex_);
+            stopping_ = false;
+            for (size_t i = 0; i < worker_count; i++)
+            {
+                workers_.emplace_back([this] { worker_loop(); });
+            }
+        }
+
+        void ThreadPool::stop_workers()
+        {
+            {
+                lock_guard<std::mutex> lock(mutex_);
+                stopping_ = true;
+            }
+            cond_.notify_all();
+            for (auto &worker : workers_)
+            {
+                worker.join();
+            }
+            lock_guard<std::mutex> lock(mutex_);
+            workers_.clear();
+        }
+
+        void ThreadPool::worker_loop()
+        {
+            while (true)
+            {
+                function<void()> task;
+                {
+                    unique_lock<std::mutex> lock(mutex_);
+                    cond_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+                    if (tasks_.empty())
+                    {
+                        return;
+                    }
+                    task = move(tasks_.front());
+                    tasks_.pop_front();
+                }
+                task();
+            }
+        }
+    } // namespace util
+} // namespace seal
@@ -0,0 +1,131 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "seal/util/defines.h"
+#include "seal/util/mempool.h"
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace seal
+{
+    namespace util
+    {
+        /**
+        A simple fixed-size pool of worker threads for running the independent iterations of a loop concurrently.
+        Only the loop construct parallel_for is provided: the calling thread takes part in the work, and the call
+        returns only once every iteration has completed. Parallel loops are not nested; a parallel_for issued from
+        within an iteration of another parallel_for runs serially on the calling thread.
+
+        The library uses a single process-wide instance returned by ThreadPool::Global, which starts with one
+        thread per hardware thread. The number of threads can be changed with set_thread_count; with a thread
+        count of at most one all loops run serially on the calling thread.
+        */
+        class ThreadPool
+        {
+        public:
+            ThreadPool(std::size_t thread_count);
+
+            ~ThreadPool();
+
+            ThreadPool(const ThreadPool &copy) = delete;
+
+            ThreadPool &operator=(const ThreadPool &assign) = delete;
+
+            /**
+            Returns the process-wide thread pool.
+            */
+            SEAL_NODISCARD static ThreadPool &Global();
+
+            /**
+            Returns the number of threads, including the calling thread, that work on a parallel loop.
+            */
+            SEAL_NODISCARD std::size_t thread_count() const;
+
+            /**
+            Sets the number of threads, including the calling thread, that work on a parallel loop. This must not
+            be called while a parallel loop is running.
+
+            @param[in] thread_count The number of threads; 0 or 1 disables parallelism
+            */
+            void set_thread_count(std::size_t thread_count);
+
+            /**
+            Calls func(i) for every i in [0, count), distributing the calls among the threads. The first exception
+            thrown by func is rethrown on the calling thread after all iterations have finished.
+
+            @param[in] count The number of iterations
+            @param[in] func The function to call for each iteration
+            */
+            void parallel_for(std::size_t count, const std::function<void(std::size_t)> &func);
+
+            /**
+            Returns whether the calling thread is currently executing an iteration of a parallel loop.
+            */
+            SEAL_NODISCARD static bool in_parallel_region() noexcept;
+
+        private:
+            void start_workers(std::size_t worker_count);
+
+            void stop_workers();
+
+            void worker_loop();
+
+            mutable std::mutex mutex_;
+
+            std::condition_variable cond_;
+
+            std::deque<std::function<void()>> tasks_;
+
+            std::vector<std::thread> workers_;
+
+            bool stopping_ = false;
+        };
+
+        /**
+        Parallel counterpart of seal_for_each_n: calls func(first[i]) for i in [0, size) on the threads of
+        ThreadPool::Global. The iterator must support random access through operator[].
+        */
+        template <typename ForwardIt, typename Size, typename Func>
+        inline ForwardIt parallel_for_each_n(ForwardIt first, Size size, Func &&func)
+        {
+#ifdef SEAL_USE_THREAD_POOL
+            if (size > 1 && !ThreadPool::in_parallel_region())
+            {
+                ThreadPool::Global().parallel_for(
+                    static_cast<std::size_t>(size), [&](std::size_t i) { func(first[i]); });
+                return first + size;
+            }
+#endif
+            for (; size--; (void)++first)
+            {
+                func(*first);
+            }
+            return first;
+        }
+
+        /**
+        Same as above, but the loop runs serially unless the given memory pool can be used concurrently. This must
+        be used whenever func allocates memory from the pool.
+        */
+        template <typename ForwardIt, typename Size, typename Func>
+        inline ForwardIt parallel_for_each_n(const MemoryPool &pool, ForwardIt first, Size size, Func &&func)
+        {
+            if (pool.is_thread_safe())
+            {
+                return parallel_for_each_n(first, size, std::forward<Func>(func));
+            }
+            for (; size--; (void)++first)
+            {
+                func(*first);
+            }
+            return first;
+        }
+    } // namespace util
+} // namespace seal
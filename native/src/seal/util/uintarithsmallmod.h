@@ -325,6 +325,69 @@ namespace seal
             return y.operand * x - tmp1 * p;
         }
 
+        /**
+        Returns input * 2^(-64) mod modulus (Montgomery reduction).
+        Correctness: modulus must be odd and input must be less than modulus * 2^64.
+        @param[in] input A 128-bit value
+        */
+        template <typename T, typename = std::enable_if_t<is_uint64_v<T>>>
+        SEAL_NODISCARD inline std::uint64_t montgomery_reduce_128(const T *input, const Modulus &modulus)
+        {
+#ifdef SEAL_DEBUG
+            if (!input)
+            {
+                throw std::invalid_argument("input");
+            }
+            if (!(modulus.value() & 1))
+            {
+                throw std::invalid_argument("modulus must be odd");
+            }
+            if (input[1] >= modulus.value())
+            {
+                throw std::invalid_argument("input must be less than modulus * 2^64");
+            }
+#endif
+            // The low word of m * modulus equals input[0], so subtracting it leaves a multiple of 2^64
+            unsigned long long m_hi;
+            std::uint64_t m = static_cast<std::uint64_t>(input[0]) * modulus.montgomery_inverse();
+            multiply_uint64_hw64(m, modulus.value(), &m_hi);
+            std::uint64_t hi = static_cast<std::uint64_t>(input[1]);
+            return hi - m_hi + (modulus.value() & static_cast<std::uint64_t>(-static_cast<std::int64_t>(hi < m_hi)));
+        }
+
+        /**
+        Returns (operand1 * operand2 * 2^(-64)) mod modulus. If operand2 is in Montgomery form, i.e., y * 2^64 mod
+        modulus for some y, this is (operand1 * y) mod modulus.
+        Correctness: Follows the condition of montgomery_reduce_128; this holds for operand2 less than modulus.
+        */
+        SEAL_NODISCARD inline std::uint64_t multiply_uint_mod_montgomery(
+            std::uint64_t operand1, std::uint64_t operand2, const Modulus &modulus)
+        {
+            unsigned long long z[2];
+            multiply_uint64(operand1, operand2, z);
+            return montgomery_reduce_128(z, modulus);
+        }
+
+        /**
+        Returns the Montgomery form (operand * 2^64) mod modulus of operand, computed as the Montgomery product of
+        operand and 2^128 mod modulus.
+        Correctness: modulus must be odd.
+        */
+        SEAL_NODISCARD inline std::uint64_t to_montgomery(std::uint64_t operand, const Modulus &modulus)
+        {
+            return multiply_uint_mod_montgomery(operand, modulus.const_ratio()[2], modulus);
+        }
+
+        /**
+        Returns (operand * 2^(-64)) mod modulus, i.e., the standard form of operand in Montgomery form.
+        Correctness: modulus must be odd.
+        */
+        SEAL_NODISCARD inline std::uint64_t from_montgomery(std::uint64_t operand, const Modulus &modulus)
+        {
+            std::uint64_t z[2]{ operand, 0 };
+            return montgomery_reduce_128(z, modulus);
+        }
+
         /**
         Returns value[0] = value mod modulus.
         Correctness: Follows the condition of barrett_reduce_128.
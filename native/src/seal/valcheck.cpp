@@ -156,7 +156,10 @@ namespace seal
             return false;
         }
 
-        size_t decomp_mod_count = context.first_context_data()->parms().coeff_modulus().size();
+        // With hybrid keyswitching there is one key component per digit
+        auto kswitch_tool = context.first_context_data()->kswitch_tool();
+        size_t decomp_mod_count = kswitch_tool ? kswitch_tool->digit_count()
+                                               : context.first_context_data()->parms().coeff_modulus().size();
         for (auto &a : in.data())
         {
             // Check that each highest level component has right size
@@ -147,8 +147,41 @@ namespace sealtest
             ASSERT_TRUE(parms.plain_modulus() == parms2.plain_modulus());
             ASSERT_TRUE(parms.poly_modulus_degree() == parms2.poly_modulus_degree());
             ASSERT_TRUE(parms == parms2);
+
+            parms.set_special_modulus_count(2);
+            parms.set_decomposition_number(1);
+            ASSERT_TRUE(parms != parms2);
+
+            parms.save(stream);
+            parms2.load(stream);
+            ASSERT_EQ(2, parms2.special_modulus_count());
+            ASSERT_EQ(1, parms2.decomposition_number());
+            ASSERT_TRUE(parms2.using_hybrid_keyswitching());
+            ASSERT_TRUE(parms == parms2);
         };
         encryption_parameters_save_load(scheme_type::bfv);
         encryption_parameters_save_load(scheme_type::bgv);
     }
+
+    TEST(EncryptionParametersTest, EncryptionParametersSaveLoadUncompressed)
+    {
+        // Without compression the header size is exact, with or without the keyswitching settings
+        stringstream stream;
+        EncryptionParameters parms(scheme_type::bfv);
+        EncryptionParameters parms2(scheme_type::bfv);
+        parms.set_poly_modulus_degree(256);
+        parms.set_coeff_modulus(CoeffModulus::Create(256, { 30, 60, 60 }));
+        parms.set_plain_modulus(1 << 30);
+        auto out_size = parms.save(stream, compr_mode_type::none);
+        ASSERT_EQ(parms.save_size(compr_mode_type::none), out_size);
+        ASSERT_EQ(out_size, parms2.load(stream));
+        ASSERT_TRUE(parms == parms2);
+
+        parms.set_special_modulus_count(2);
+        parms.set_decomposition_number(1);
+        out_size = parms.save(stream, compr_mode_type::none);
+        ASSERT_EQ(parms.save_size(compr_mode_type::none), out_size);
+        ASSERT_EQ(out_size, parms2.load(stream));
+        ASSERT_TRUE(parms == parms2);
+    }
 } // namespace sealtest
@@ -9,6 +9,10 @@
 #include "seal/evaluator.h"
 #include "seal/keygenerator.h"
 #include "seal/modulus.h"
+#include "seal/util/polyarithsmallmod.h"
+#include "seal/util/threadpool.h"
+#include "seal/util/uintarithsmallmod.h"
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <ctime>
@@ -1638,6 +1642,98 @@ namespace sealtest
         }
     }
 
+    TEST(EvaluatorTest, BFVEncryptMultiplyDecryptHPS)
+    {
+        auto hps_test = [](size_t poly_modulus_degree, const vector<int> &bit_sizes, int plain_bit_size) {
+            EncryptionParameters parms(scheme_type::bfv);
+            parms.set_poly_modulus_degree(poly_modulus_degree);
+            parms.set_plain_modulus(PlainModulus::Batching(poly_modulus_degree, plain_bit_size));
+            parms.set_coeff_modulus(CoeffModulus::Create(poly_modulus_degree, bit_sizes));
+
+            SEALContext context(parms, false, sec_level_type::none);
+            SEALContext hps_context(context);
+            hps_context.set_rns_method(rns_method_type::hps);
+            ASSERT_EQ(rns_method_type::behz, context.rns_method());
+            ASSERT_EQ(rns_method_type::hps, hps_context.rns_method());
+
+            KeyGenerator keygen(context);
+            PublicKey pk;
+            keygen.create_public_key(pk);
+
+            Encryptor encryptor(context, pk);
+            Evaluator evaluator(context);
+            Evaluator hps_evaluator(hps_context);
+            Decryptor decryptor(context, keygen.secret_key());
+            Decryptor hps_decryptor(hps_context, keygen.secret_key());
+            BatchEncoder batch_encoder(context);
+            uint64_t t = parms.plain_modulus().value();
+
+            vector<uint64_t> values1(batch_encoder.slot_count()), values2(batch_encoder.slot_count());
+            for (size_t i = 0; i < values1.size(); i++)
+            {
+                values1[i] = (i * 7 + 3) % t;
+                values2[i] = (t - 1 - i * i) % t;
+            }
+            Plaintext plain1, plain2, plain;
+            batch_encoder.encode(values1, plain1);
+            batch_encoder.encode(values2, plain2);
+            Ciphertext encrypted1, encrypted2, encrypted;
+            encryptor.encrypt(plain1, encrypted1);
+            encryptor.encrypt(plain2, encrypted2);
+
+            // Both methods give ciphertexts that decrypt to the same result with either method
+            Ciphertext product, hps_product;
+            evaluator.multiply(encrypted1, encrypted2, product);
+            hps_evaluator.multiply(encrypted1, encrypted2, hps_product);
+            for (auto *decrypt : { &decryptor, &hps_decryptor })
+            {
+                for (auto *ct : { &product, &hps_product })
+                {
+                    decrypt->decrypt(*ct, plain);
+                    vector<uint64_t> result;
+                    batch_encoder.decode(plain, result);
+                    for (size_t i = 0; i < result.size(); i++)
+                    {
+                        ASSERT_EQ(util::multiply_uint_mod(values1[i], values2[i], parms.plain_modulus()), result[i]);
+                    }
+                }
+            }
+            ASSERT_EQ(decryptor.invariant_noise_budget(product), decryptor.invariant_noise_budget(hps_product));
+
+            // Square, a size 3 product, and a depth-2 product
+            Ciphertext squared, cubed;
+            hps_evaluator.square(encrypted1, squared);
+            hps_evaluator.multiply(squared, encrypted1, cubed);
+            if (context.using_keyswitching())
+            {
+                RelinKeys rlk;
+                keygen.create_relin_keys(rlk);
+                hps_evaluator.relinearize_inplace(squared, rlk);
+            }
+            hps_evaluator.multiply_inplace(squared, hps_product);
+            hps_decryptor.decrypt(cubed, plain);
+            vector<uint64_t> result;
+            batch_encoder.decode(plain, result);
+            for (size_t i = 0; i < result.size(); i++)
+            {
+                uint64_t square = util::multiply_uint_mod(values1[i], values1[i], parms.plain_modulus());
+                ASSERT_EQ(util::multiply_uint_mod(square, values1[i], parms.plain_modulus()), result[i]);
+            }
+            hps_decryptor.decrypt(squared, plain);
+            batch_encoder.decode(plain, result);
+            for (size_t i = 0; i < result.size(); i++)
+            {
+                uint64_t square = util::multiply_uint_mod(values1[i], values1[i], parms.plain_modulus());
+                uint64_t product_value = util::multiply_uint_mod(values1[i], values2[i], parms.plain_modulus());
+                ASSERT_EQ(util::multiply_uint_mod(square, product_value, parms.plain_modulus()), result[i]);
+            }
+        };
+        hps_test(64, { 40, 40, 40 }, 16);
+        hps_test(64, { 60, 60, 60 }, 20);
+        hps_test(1024, { 60, 60, 60, 60 }, 50);
+        hps_test(1024, { 30, 40, 50, 60 }, 16);
+    }
+
     TEST(EvaluatorTest, BGVEncryptSubDecrypt)
     {
         EncryptionParameters parms(scheme_type::bgv);
@@ -4290,6 +4386,134 @@ namespace sealtest
         }
     }
 
+    TEST(EvaluatorTest, CKKSEncryptRotateVectorManyDecrypt)
+    {
+        auto rotate_vector_many_test = [](size_t special_modulus_count) {
+            EncryptionParameters parms(scheme_type::ckks);
+            size_t slot_size = 16;
+            parms.set_poly_modulus_degree(slot_size * 2);
+            parms.set_coeff_modulus(CoeffModulus::Create(slot_size * 2, { 60, 40, 40, 60, 60 }));
+            parms.set_special_modulus_count(special_modulus_count);
+
+            SEALContext context(parms, true, sec_level_type::none);
+            KeyGenerator keygen(context);
+            PublicKey pk;
+            keygen.create_public_key(pk);
+            GaloisKeys glk;
+            keygen.create_galois_keys(glk);
+
+            Encryptor encryptor(context, pk);
+            Evaluator evaluator(context);
+            Decryptor decryptor(context, keygen.secret_key());
+            CKKSEncoder encoder(context);
+            const double delta = static_cast<double>(1ULL << 40);
+
+            vector<complex<double>> input(slot_size);
+            for (size_t i = 0; i < slot_size; i++)
+            {
+                input[i] = complex<double>(static_cast<double>(i), -static_cast<double>(i % 3));
+            }
+            Plaintext plain;
+            encoder.encode(input, context.first_parms_id(), delta, plain);
+            Ciphertext encrypted;
+            encryptor.encrypt(plain, encrypted);
+            evaluator.mod_switch_to_next_inplace(encrypted);
+
+            // Step 5 has no Galois key of its own; step 0 is the identity
+            vector<int> steps{ 1, 2, -4, 5, 0, 7 };
+            vector<Ciphertext> rotated;
+            evaluator.rotate_vector_many(encrypted, steps, glk, rotated);
+            ASSERT_EQ(steps.size(), rotated.size());
+            for (size_t k = 0; k < steps.size(); k++)
+            {
+                ASSERT_TRUE(rotated[k].parms_id() == encrypted.parms_id());
+                ASSERT_EQ(encrypted.scale(), rotated[k].scale());
+                decryptor.decrypt(rotated[k], plain);
+                vector<complex<double>> output;
+                encoder.decode(plain, output);
+                for (size_t i = 0; i < slot_size; i++)
+                {
+                    size_t index = (i + static_cast<size_t>(steps[k] + static_cast<int>(slot_size))) % slot_size;
+                    auto &expected = input[index];
+                    ASSERT_EQ(expected.real(), round(output[i].real()));
+                    ASSERT_EQ(expected.imag(), round(output[i].imag()));
+                }
+            }
+        };
+        rotate_vector_many_test(1);
+        rotate_vector_many_test(2);
+    }
+
+    TEST(EvaluatorTest, CKKSEncryptRotateExtendedDecrypt)
+    {
+        auto rotate_extended_test = [](size_t special_modulus_count) {
+            EncryptionParameters parms(scheme_type::ckks);
+            size_t slot_size = 16;
+            parms.set_poly_modulus_degree(slot_size * 2);
+            parms.set_coeff_modulus(CoeffModulus::Create(slot_size * 2, { 60, 40, 40, 60, 60 }));
+            parms.set_special_modulus_count(special_modulus_count);
+
+            SEALContext context(parms, true, sec_level_type::none);
+            KeyGenerator keygen(context);
+            PublicKey pk;
+            keygen.create_public_key(pk);
+            GaloisKeys glk;
+            keygen.create_galois_keys(glk);
+
+            Encryptor encryptor(context, pk);
+            Evaluator evaluator(context);
+            Decryptor decryptor(context, keygen.secret_key());
+            CKKSEncoder encoder(context);
+            const double delta = static_cast<double>(1ULL << 40);
+
+            vector<complex<double>> input(slot_size);
+            for (size_t i = 0; i < slot_size; i++)
+            {
+                input[i] = complex<double>(static_cast<double>(i), static_cast<double>(i % 4));
+            }
+            Plaintext plain;
+            encoder.encode(input, context.first_parms_id(), delta, plain);
+            Ciphertext encrypted;
+            encryptor.encrypt(plain, encrypted);
+
+            // Sum of rotations by 1, 2, 4 and -8 and of the conjugate with a single division by the special primes
+            vector<int> steps{ 1, 2, 4, -8 };
+            ExtendedCiphertext sum;
+            evaluator.rotate_extended(encrypted, steps[0], glk, sum);
+            for (size_t k = 1; k < steps.size(); k++)
+            {
+                ExtendedCiphertext rotated;
+                evaluator.rotate_extended(encrypted, steps[k], glk, rotated);
+                evaluator.add_extended(sum, rotated, sum);
+            }
+            ExtendedCiphertext conjugated;
+            evaluator.apply_galois_extended(
+                encrypted, static_cast<uint32_t>(2 * parms.poly_modulus_degree() - 1), glk, conjugated);
+            evaluator.add_extended_inplace(sum, conjugated);
+
+            Ciphertext result;
+            evaluator.mod_down(sum, result);
+            ASSERT_TRUE(result.parms_id() == encrypted.parms_id());
+            ASSERT_EQ(encrypted.scale(), result.scale());
+
+            decryptor.decrypt(result, plain);
+            vector<complex<double>> output;
+            encoder.decode(plain, output);
+            for (size_t i = 0; i < slot_size; i++)
+            {
+                complex<double> expected = conj(input[i]);
+                for (int step : steps)
+                {
+                    expected += input[(i + static_cast<size_t>(step + static_cast<int>(slot_size))) % slot_size];
+                }
+                ASSERT_EQ(expected.real(), round(output[i].real()));
+                ASSERT_EQ(expected.imag(), round(output[i].imag()));
+            }
+        };
+        rotate_extended_test(1);
+        rotate_extended_test(2);
+    }
+
     TEST(EvaluatorTest, CKKSEncryptRescaleRotateDecrypt)
     {
         EncryptionParameters parms(scheme_type::ckks);
@@ -4685,6 +4909,132 @@ namespace sealtest
         ASSERT_TRUE(encrypted.parms_id() == context.first_parms_id());
     }
 
+    TEST(EvaluatorTest, BFVBGVEncryptMultiplyManyParallel)
+    {
+        for (auto scheme : { scheme_type::bfv, scheme_type::bgv })
+        {
+            EncryptionParameters parms(scheme);
+            parms.set_poly_modulus_degree(128);
+            parms.set_plain_modulus(PlainModulus::Batching(128, 20));
+            parms.set_coeff_modulus(CoeffModulus::Create(128, { 60, 60, 60, 60, 60 }));
+
+            SEALContext context(parms, false, sec_level_type::none);
+            KeyGenerator keygen(context);
+            PublicKey pk;
+            keygen.create_public_key(pk);
+            RelinKeys rlk;
+            keygen.create_relin_keys(rlk);
+
+            Encryptor encryptor(context, pk);
+            Evaluator evaluator(context);
+            Decryptor decryptor(context, keygen.secret_key());
+
+            vector<Ciphertext> encrypteds(13);
+            for (size_t i = 0; i < encrypteds.size(); i++)
+            {
+                encryptor.encrypt(Plaintext(to_string(i % 9 + 1)), encrypteds[i]);
+            }
+
+            // The same ciphertext twice is squared
+            encrypteds[5] = encrypteds[4];
+
+            for (size_t count = 1; count <= encrypteds.size(); count++)
+            {
+                vector<Ciphertext> operands(encrypteds.begin(), encrypteds.begin() + static_cast<ptrdiff_t>(count));
+                Ciphertext expected;
+                evaluator.multiply_many(operands, rlk, expected);
+                for (size_t thread_count : { 0, 1, 3 })
+                {
+                    Ciphertext product;
+                    evaluator.multiply_many_parallel(operands, rlk, product, thread_count);
+                    ASSERT_EQ(expected.size(), product.size());
+                    ASSERT_TRUE(expected.parms_id() == product.parms_id());
+                    ASSERT_EQ(expected.correction_factor(), product.correction_factor());
+                    ASSERT_TRUE(equal(expected.data(), expected.data() + expected.dyn_array().size(), product.data()));
+                }
+
+                // A memory pool that is not thread-safe is used serially
+                Ciphertext product;
+                evaluator.multiply_many_parallel(operands, rlk, product, 3, MemoryPoolHandle::ThreadLocal());
+                ASSERT_TRUE(equal(expected.data(), expected.data() + expected.dyn_array().size(), product.data()));
+            }
+
+            // Depth 3 is within the noise budget
+            Plaintext plain;
+            Ciphertext product;
+            vector<Ciphertext> operands(encrypteds.begin(), encrypteds.begin() + 7);
+            evaluator.multiply_many_parallel(operands, rlk, product);
+            decryptor.decrypt(product, plain);
+            uint64_t expected = 1;
+            for (size_t i = 0; i < operands.size(); i++)
+            {
+                expected = (expected * (i == 5 ? 5 : i % 9 + 1)) % parms.plain_modulus().value();
+            }
+            ASSERT_EQ(expected, plain[0]);
+
+            ASSERT_THROW(evaluator.multiply_many_parallel(vector<Ciphertext>{}, rlk, product), invalid_argument);
+            ASSERT_THROW(evaluator.multiply_many_parallel(encrypteds, rlk, encrypteds[3]), invalid_argument);
+            ASSERT_THROW(
+                evaluator.multiply_many_parallel(encrypteds, rlk, product, 0, MemoryPoolHandle()), invalid_argument);
+        }
+    }
+
+    TEST(EvaluatorTest, EncryptAddManyParallel)
+    {
+        for (auto scheme : { scheme_type::bfv, scheme_type::bgv })
+        {
+            EncryptionParameters parms(scheme);
+            parms.set_poly_modulus_degree(64);
+            parms.set_plain_modulus(1 << 6);
+            parms.set_coeff_modulus(CoeffModulus::Create(64, { 40, 40 }));
+
+            SEALContext context(parms, false, sec_level_type::none);
+            KeyGenerator keygen(context);
+            PublicKey pk;
+            keygen.create_public_key(pk);
+
+            Encryptor encryptor(context, pk);
+            Evaluator evaluator(context);
+            Decryptor decryptor(context, keygen.secret_key());
+
+            vector<Ciphertext> encrypteds(11);
+            for (size_t i = 0; i < encrypteds.size(); i++)
+            {
+                encryptor.encrypt(Plaintext("1x^" + to_string(i + 1) + " + 1"), encrypteds[i]);
+            }
+
+            for (size_t count = 1; count <= encrypteds.size(); count++)
+            {
+                vector<Ciphertext> operands(encrypteds.begin(), encrypteds.begin() + static_cast<ptrdiff_t>(count));
+                Ciphertext expected;
+                evaluator.add_many(operands, expected);
+                for (size_t thread_count : { 0, 2, 4 })
+                {
+                    Ciphertext sum;
+                    evaluator.add_many_parallel(operands, sum, thread_count);
+                    ASSERT_EQ(expected.size(), sum.size());
+                    ASSERT_TRUE(equal(expected.data(), expected.data() + expected.dyn_array().size(), sum.data()));
+                }
+
+                // A memory pool that is not thread-safe is used serially
+                Ciphertext sum;
+                evaluator.add_many_parallel(operands, sum, 4, MemoryPoolHandle::ThreadLocal());
+                ASSERT_TRUE(equal(expected.data(), expected.data() + expected.dyn_array().size(), sum.data()));
+            }
+
+            Plaintext plain;
+            Ciphertext sum;
+            evaluator.add_many_parallel(encrypteds, sum);
+            decryptor.decrypt(sum, plain);
+            ASSERT_EQ(
+                plain.to_string(), "1x^11 + 1x^10 + 1x^9 + 1x^8 + 1x^7 + 1x^6 + 1x^5 + 1x^4 + 1x^3 + 1x^2 + 1x^1 + B");
+
+            ASSERT_THROW(evaluator.add_many_parallel(vector<Ciphertext>{}, sum), invalid_argument);
+            ASSERT_THROW(evaluator.add_many_parallel(encrypteds, encrypteds[0]), invalid_argument);
+            ASSERT_THROW(evaluator.add_many_parallel(encrypteds, sum, 0, MemoryPoolHandle()), invalid_argument);
+        }
+    }
+
     TEST(EvaluatorTest, BFVEncryptAddManyDecrypt)
     {
         EncryptionParameters parms(scheme_type::bfv);
@@ -5320,6 +5670,112 @@ namespace sealtest
         ASSERT_TRUE(encrypted.parms_id() == context.first_parms_id());
     }
 
+    TEST(EvaluatorTest, BFVBGVMultiplyNormalByPlainNTT)
+    {
+        auto test = [](scheme_type scheme, uint64_t plain_modulus, vector<int> coeff_modulus_bit_sizes) {
+            EncryptionParameters parms(scheme);
+            parms.set_poly_modulus_degree(128);
+            parms.set_plain_modulus(plain_modulus);
+            parms.set_coeff_modulus(CoeffModulus::Create(128, coeff_modulus_bit_sizes));
+
+            SEALContext context(parms, true, sec_level_type::none);
+            KeyGenerator keygen(context);
+            PublicKey pk;
+            keygen.create_public_key(pk);
+
+            Encryptor encryptor(context, pk);
+            Evaluator evaluator(context);
+
+            Plaintext plain("1x^20 + 2x^3 + 5");
+            Plaintext plain_multiplier("Fx^10 + Ex^9 + 1x^4 + 2x^3 + 3x^2 + 4x^1 + 5");
+            Plaintext plain_multiplier_ntt = plain_multiplier;
+            evaluator.transform_to_ntt_inplace(plain_multiplier_ntt, context.first_parms_id());
+
+            Ciphertext encrypted;
+            encryptor.encrypt(plain, encrypted);
+            Ciphertext expected;
+            evaluator.multiply_plain(encrypted, plain_multiplier, expected);
+            Ciphertext result;
+            evaluator.multiply_plain(encrypted, plain_multiplier_ntt, result);
+            ASSERT_FALSE(result.is_ntt_form());
+            ASSERT_EQ(expected.dyn_array().size(), result.dyn_array().size());
+            ASSERT_TRUE(equal(expected.data(), expected.data() + expected.dyn_array().size(), result.data()));
+
+            // The plaintext must be at the level of the ciphertext
+            evaluator.mod_switch_to_next_inplace(encrypted);
+            ASSERT_THROW(evaluator.multiply_plain_inplace(encrypted, plain_multiplier_ntt), invalid_argument);
+
+            // A ciphertext in NTT form still needs a plaintext in NTT form
+            evaluator.transform_to_ntt_inplace(encrypted);
+            ASSERT_THROW(evaluator.multiply_plain_inplace(encrypted, plain_multiplier), invalid_argument);
+        };
+
+        // Fast plain lift
+        test(scheme_type::bfv, 1 << 6, { 40, 40, 40 });
+        test(scheme_type::bgv, 65537, { 40, 40, 40 });
+
+        // Plain modulus larger than the coefficient modulus primes
+        test(scheme_type::bfv, uint64_t(1) << 35, { 30, 30, 30, 30 });
+    }
+
+    TEST(EvaluatorTest, MultiplyDyadicProductBackends)
+    {
+        auto test = [](scheme_type scheme, rns_method_type rns_method) {
+            EncryptionParameters parms(scheme);
+            parms.set_poly_modulus_degree(64);
+            if (scheme != scheme_type::ckks)
+            {
+                parms.set_plain_modulus(65537);
+            }
+            parms.set_coeff_modulus(CoeffModulus::Create(64, { 60, 50, 60 }));
+
+            SEALContext context(parms, false, sec_level_type::none);
+            context.set_rns_method(rns_method);
+            KeyGenerator keygen(context);
+            PublicKey pk;
+            keygen.create_public_key(pk);
+            Encryptor encryptor(context, pk);
+            Evaluator evaluator(context);
+
+            Plaintext plain("1x^20 + 2x^3 + 5");
+            if (scheme == scheme_type::ckks)
+            {
+                CKKSEncoder encoder(context);
+                encoder.encode(vector<double>{ 1.5, -2.0, 3.25 }, pow(2.0, 30), plain);
+            }
+            Ciphertext encrypted1, encrypted2;
+            encryptor.encrypt(plain, encrypted1);
+            encryptor.encrypt(plain, encrypted2);
+
+            // Products of sizes 2 x 2 and 3 x 2, with each backend
+            vector<Ciphertext> results;
+            for (auto backend :
+                 { util::dyadic_product_backend_type::barrett, util::dyadic_product_backend_type::montgomery })
+            {
+                util::set_dyadic_product_backend(backend);
+                Ciphertext product;
+                evaluator.multiply(encrypted1, encrypted2, product);
+                results.push_back(product);
+                evaluator.multiply_inplace(product, encrypted2);
+                results.push_back(product);
+            }
+            for (size_t i = 0; i < 2; i++)
+            {
+                auto &barrett = results[i];
+                auto &montgomery = results[i + 2];
+                ASSERT_EQ(barrett.dyn_array().size(), montgomery.dyn_array().size());
+                ASSERT_TRUE(equal(barrett.data(), barrett.data() + barrett.dyn_array().size(), montgomery.data()));
+            }
+        };
+
+        util::dyadic_product_backend_type default_backend = util::get_dyadic_product_backend();
+        test(scheme_type::bfv, rns_method_type::behz);
+        test(scheme_type::bfv, rns_method_type::hps);
+        test(scheme_type::bgv, rns_method_type::behz);
+        test(scheme_type::ckks, rns_method_type::behz);
+        util::set_dyadic_product_backend(default_backend);
+    }
+
     TEST(EvaluatorTest, BFVEncryptApplyGaloisDecrypt)
     {
         EncryptionParameters parms(scheme_type::bfv);
@@ -5401,33 +5857,176 @@ namespace sealtest
         ASSERT_TRUE("1x^3 + 2x^2 + 1x^1 + 1" == plain.to_string());
     }
 
-    TEST(EvaluatorTest, BFVEncryptRotateMatrixDecrypt)
+    TEST(EvaluatorTest, BFVBGVEncryptRotateRowsManyDecrypt)
     {
-        EncryptionParameters parms(scheme_type::bfv);
-        Modulus plain_modulus(257);
-        parms.set_poly_modulus_degree(8);
-        parms.set_plain_modulus(plain_modulus);
-        parms.set_coeff_modulus(CoeffModulus::Create(8, { 40, 40 }));
+        auto rotate_rows_many_test = [](scheme_type scheme, size_t special_modulus_count) {
+            EncryptionParameters parms(scheme);
+            parms.set_poly_modulus_degree(64);
+            parms.set_plain_modulus(PlainModulus::Batching(64, 20));
+            parms.set_coeff_modulus(CoeffModulus::Create(64, { 40, 40, 40, 40, 40 }));
+            parms.set_special_modulus_count(special_modulus_count);
 
-        SEALContext context(parms, false, sec_level_type::none);
-        KeyGenerator keygen(context);
-        PublicKey pk;
-        keygen.create_public_key(pk);
-        GaloisKeys glk;
-        keygen.create_galois_keys(glk);
+            SEALContext context(parms, true, sec_level_type::none);
+            KeyGenerator keygen(context);
+            PublicKey pk;
+            keygen.create_public_key(pk);
+            GaloisKeys glk;
+            keygen.create_galois_keys(glk);
 
-        Encryptor encryptor(context, pk);
-        Evaluator evaluator(context);
-        Decryptor decryptor(context, keygen.secret_key());
-        BatchEncoder batch_encoder(context);
+            Encryptor encryptor(context, pk);
+            Evaluator evaluator(context);
+            Decryptor decryptor(context, keygen.secret_key());
+            BatchEncoder batch_encoder(context);
+            size_t row_size = batch_encoder.slot_count() / 2;
 
-        Plaintext plain;
-        vector<uint64_t> plain_vec{ 1, 2, 3, 4, 5, 6, 7, 8 };
-        batch_encoder.encode(plain_vec, plain);
-        Ciphertext encrypted;
-        encryptor.encrypt(plain, encrypted);
+            vector<uint64_t> input(batch_encoder.slot_count());
+            for (size_t i = 0; i < input.size(); i++)
+            {
+                input[i] = i * i + 1;
+            }
+            Plaintext plain;
+            batch_encoder.encode(input, plain);
+            Ciphertext encrypted;
+            encryptor.encrypt(plain, encrypted);
 
-        evaluator.rotate_columns_inplace(encrypted, glk);
+            // Step 3 has no Galois key of its own; step 0 is the identity
+            vector<int> steps{ 1, -1, 2, 3, 0, -16 };
+            vector<Ciphertext> rotated;
+            evaluator.rotate_rows_many(encrypted, steps, glk, rotated);
+            ASSERT_EQ(steps.size(), rotated.size());
+            for (size_t k = 0; k < steps.size(); k++)
+            {
+                ASSERT_TRUE(rotated[k].parms_id() == encrypted.parms_id());
+                decryptor.decrypt(rotated[k], plain);
+                vector<uint64_t> output;
+                batch_encoder.decode(plain, output);
+                for (size_t i = 0; i < output.size(); i++)
+                {
+                    size_t row = i / row_size;
+                    size_t col = (i % row_size + static_cast<size_t>(steps[k] + static_cast<int>(row_size))) % row_size;
+                    ASSERT_EQ(input[row * row_size + col], output[i]);
+                }
+            }
+
+            // Rotating an element of the destination in place
+            evaluator.mod_switch_to_next_inplace(rotated[0]);
+            evaluator.rotate_rows_many(rotated[0], { -1 }, glk, rotated);
+            ASSERT_EQ(1, rotated.size());
+            decryptor.decrypt(rotated[0], plain);
+            vector<uint64_t> output;
+            batch_encoder.decode(plain, output);
+            ASSERT_TRUE(input == output);
+        };
+        rotate_rows_many_test(scheme_type::bfv, 1);
+        rotate_rows_many_test(scheme_type::bfv, 2);
+        rotate_rows_many_test(scheme_type::bgv, 1);
+        rotate_rows_many_test(scheme_type::bgv, 2);
+    }
+
+    TEST(EvaluatorTest, BFVBGVEncryptRotateExtendedDecrypt)
+    {
+        auto rotate_extended_test = [](scheme_type scheme, size_t special_modulus_count) {
+            EncryptionParameters parms(scheme);
+            parms.set_poly_modulus_degree(64);
+            parms.set_plain_modulus(PlainModulus::Batching(64, 20));
+            parms.set_coeff_modulus(CoeffModulus::Create(64, { 40, 40, 40, 40, 40 }));
+            parms.set_special_modulus_count(special_modulus_count);
+
+            SEALContext context(parms, true, sec_level_type::none);
+            KeyGenerator keygen(context);
+            PublicKey pk;
+            keygen.create_public_key(pk);
+            GaloisKeys glk;
+            keygen.create_galois_keys(glk);
+
+            Encryptor encryptor(context, pk);
+            Evaluator evaluator(context);
+            Decryptor decryptor(context, keygen.secret_key());
+            BatchEncoder batch_encoder(context);
+            uint64_t t = parms.plain_modulus().value();
+            size_t row_size = batch_encoder.slot_count() / 2;
+
+            vector<uint64_t> input(batch_encoder.slot_count());
+            for (size_t i = 0; i < input.size(); i++)
+            {
+                input[i] = 3 * i + 1;
+            }
+            Plaintext plain;
+            batch_encoder.encode(input, plain);
+            Ciphertext encrypted;
+            encryptor.encrypt(plain, encrypted);
+
+            // Sum of rotations by 1, 2, 4 and -8 with a single division by the special primes
+            vector<int> steps{ 1, 2, 4, -8 };
+            ExtendedCiphertext sum;
+            evaluator.rotate_extended(encrypted, steps[0], glk, sum);
+            for (size_t k = 1; k < steps.size(); k++)
+            {
+                ExtendedCiphertext rotated;
+                evaluator.rotate_extended(encrypted, steps[k], glk, rotated);
+                evaluator.add_extended_inplace(sum, rotated);
+            }
+            Ciphertext result;
+            evaluator.mod_down(sum, result);
+            ASSERT_TRUE(result.parms_id() == encrypted.parms_id());
+            ASSERT_FALSE(result.is_ntt_form());
+
+            decryptor.decrypt(result, plain);
+            vector<uint64_t> output;
+            batch_encoder.decode(plain, output);
+            for (size_t i = 0; i < output.size(); i++)
+            {
+                uint64_t expected = 0;
+                for (int step : steps)
+                {
+                    size_t col = (i % row_size + static_cast<size_t>(step + static_cast<int>(row_size))) % row_size;
+                    expected = (expected + input[(i / row_size) * row_size + col]) % t;
+                }
+                ASSERT_EQ(expected, output[i]);
+            }
+
+            // Missing Galois key
+            ExtendedCiphertext rotated;
+            ASSERT_THROW(evaluator.rotate_extended(encrypted, 3, glk, rotated), invalid_argument);
+
+            // Level mismatch
+            evaluator.mod_switch_to_next_inplace(encrypted);
+            evaluator.rotate_extended(encrypted, 1, glk, rotated);
+            ASSERT_THROW(evaluator.add_extended_inplace(sum, rotated), invalid_argument);
+        };
+        rotate_extended_test(scheme_type::bfv, 1);
+        rotate_extended_test(scheme_type::bfv, 2);
+        rotate_extended_test(scheme_type::bgv, 1);
+        rotate_extended_test(scheme_type::bgv, 2);
+    }
+
+    TEST(EvaluatorTest, BFVEncryptRotateMatrixDecrypt)
+    {
+        EncryptionParameters parms(scheme_type::bfv);
+        Modulus plain_modulus(257);
+        parms.set_poly_modulus_degree(8);
+        parms.set_plain_modulus(plain_modulus);
+        parms.set_coeff_modulus(CoeffModulus::Create(8, { 40, 40 }));
+
+        SEALContext context(parms, false, sec_level_type::none);
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+        GaloisKeys glk;
+        keygen.create_galois_keys(glk);
+
+        Encryptor encryptor(context, pk);
+        Evaluator evaluator(context);
+        Decryptor decryptor(context, keygen.secret_key());
+        BatchEncoder batch_encoder(context);
+
+        Plaintext plain;
+        vector<uint64_t> plain_vec{ 1, 2, 3, 4, 5, 6, 7, 8 };
+        batch_encoder.encode(plain_vec, plain);
+        Ciphertext encrypted;
+        encryptor.encrypt(plain, encrypted);
+
+        evaluator.rotate_columns_inplace(encrypted, glk);
         decryptor.decrypt(encrypted, plain);
         batch_encoder.decode(plain, plain_vec);
         ASSERT_TRUE((plain_vec == vector<uint64_t>{ 5, 6, 7, 8, 1, 2, 3, 4 }));
@@ -6149,4 +6748,490 @@ namespace sealtest
         ASSERT_TRUE(encrypted.parms_id() == parms_id);
         ASSERT_TRUE(plain.to_string() == "5x^64 + Ax^5");
     }
+
+    TEST(EvaluatorTest, BFVHybridKeySwitching)
+    {
+        // Pairs of special modulus count and decomposition number
+        vector<pair<size_t, size_t>> configs{ { 1, 2 }, { 2, 0 }, { 2, 2 }, { 3, 1 }, { 2, 3 } };
+        for (auto &config : configs)
+        {
+            EncryptionParameters parms(scheme_type::bfv);
+            parms.set_poly_modulus_degree(128);
+            parms.set_plain_modulus(PlainModulus::Batching(128, 20));
+            parms.set_coeff_modulus(CoeffModulus::Create(128, { 40, 40, 40, 40, 40, 40, 40 }));
+            parms.set_special_modulus_count(config.first);
+            parms.set_decomposition_number(config.second);
+
+            SEALContext context(parms, true, sec_level_type::none);
+            ASSERT_TRUE(context.parameters_set());
+            ASSERT_EQ(7 - config.first, context.first_context_data()->parms().coeff_modulus().size());
+            ASSERT_TRUE(context.first_context_data()->kswitch_tool());
+
+            KeyGenerator keygen(context);
+            PublicKey pk;
+            keygen.create_public_key(pk);
+            RelinKeys rlk;
+            keygen.create_relin_keys(rlk);
+            GaloisKeys glk;
+            keygen.create_galois_keys(glk);
+
+            Encryptor encryptor(context, pk);
+            Evaluator evaluator(context);
+            Decryptor decryptor(context, keygen.secret_key());
+            BatchEncoder batch_encoder(context);
+            uint64_t t = parms.plain_modulus().value();
+            size_t row_size = batch_encoder.slot_count() / 2;
+
+            vector<uint64_t> input(batch_encoder.slot_count());
+            for (size_t i = 0; i < input.size(); i++)
+            {
+                input[i] = i + 1;
+            }
+
+            Plaintext plain;
+            Ciphertext encrypted;
+            batch_encoder.encode(input, plain);
+            encryptor.encrypt(plain, encrypted);
+            evaluator.square_inplace(encrypted);
+            evaluator.relinearize_inplace(encrypted, rlk);
+            evaluator.rotate_rows_inplace(encrypted, 1, glk);
+            evaluator.rotate_columns_inplace(encrypted, glk);
+            evaluator.mod_switch_to_next_inplace(encrypted);
+            evaluator.rotate_rows_inplace(encrypted, -3, glk);
+            decryptor.decrypt(encrypted, plain);
+
+            vector<uint64_t> output;
+            batch_encoder.decode(plain, output);
+            for (size_t i = 0; i < output.size(); i++)
+            {
+                // Undo rotations: total row shift is 1 - 3 = -2 and rows are swapped
+                size_t row = i / row_size;
+                size_t col = (i % row_size + row_size - 2) % row_size;
+                uint64_t x = input[(1 - row) * row_size + col];
+                ASSERT_EQ((x * x) % t, output[i]);
+            }
+        }
+    }
+
+    TEST(EvaluatorTest, BGVHybridKeySwitching)
+    {
+        // Pairs of special modulus count and decomposition number
+        vector<pair<size_t, size_t>> configs{ { 1, 2 }, { 2, 0 }, { 2, 2 }, { 3, 1 }, { 2, 3 } };
+        for (auto &config : configs)
+        {
+            EncryptionParameters parms(scheme_type::bgv);
+            parms.set_poly_modulus_degree(128);
+            parms.set_plain_modulus(PlainModulus::Batching(128, 20));
+            parms.set_coeff_modulus(CoeffModulus::Create(128, { 40, 40, 40, 40, 40, 40, 40 }));
+            parms.set_special_modulus_count(config.first);
+            parms.set_decomposition_number(config.second);
+
+            SEALContext context(parms, true, sec_level_type::none);
+            ASSERT_TRUE(context.parameters_set());
+            ASSERT_TRUE(context.first_context_data()->kswitch_tool());
+
+            KeyGenerator keygen(context);
+            PublicKey pk;
+            keygen.create_public_key(pk);
+            RelinKeys rlk;
+            keygen.create_relin_keys(rlk);
+            GaloisKeys glk;
+            keygen.create_galois_keys(glk);
+
+            Encryptor encryptor(context, pk);
+            Evaluator evaluator(context);
+            Decryptor decryptor(context, keygen.secret_key());
+            BatchEncoder batch_encoder(context);
+            uint64_t t = parms.plain_modulus().value();
+            size_t row_size = batch_encoder.slot_count() / 2;
+
+            vector<uint64_t> input(batch_encoder.slot_count());
+            for (size_t i = 0; i < input.size(); i++)
+            {
+                input[i] = i + 1;
+            }
+
+            Plaintext plain;
+            Ciphertext encrypted;
+            batch_encoder.encode(input, plain);
+            encryptor.encrypt(plain, encrypted);
+            evaluator.square_inplace(encrypted);
+            evaluator.relinearize_inplace(encrypted, rlk);
+            evaluator.rotate_rows_inplace(encrypted, 1, glk);
+            evaluator.rotate_columns_inplace(encrypted, glk);
+            evaluator.mod_switch_to_next_inplace(encrypted);
+            evaluator.rotate_rows_inplace(encrypted, -3, glk);
+            decryptor.decrypt(encrypted, plain);
+
+            vector<uint64_t> output;
+            batch_encoder.decode(plain, output);
+            for (size_t i = 0; i < output.size(); i++)
+            {
+                size_t row = i / row_size;
+                size_t col = (i % row_size + row_size - 2) % row_size;
+                uint64_t x = input[(1 - row) * row_size + col];
+                ASSERT_EQ((x * x) % t, output[i]);
+            }
+        }
+    }
+
+    TEST(EvaluatorTest, CKKSHybridKeySwitching)
+    {
+        // Pairs of special modulus count and decomposition number; in CKKS the special primes must be at least as
+        // large as every digit to keep the keyswitching noise below the scale
+        vector<pair<size_t, size_t>> configs{ { 2, 0 }, { 2, 3 }, { 3, 1 }, { 3, 2 } };
+        for (auto &config : configs)
+        {
+            EncryptionParameters parms(scheme_type::ckks);
+            size_t slot_size = 32;
+            parms.set_poly_modulus_degree(slot_size * 2);
+            parms.set_coeff_modulus(CoeffModulus::Create(slot_size * 2, { 60, 40, 40, 40, 60, 60, 60 }));
+            parms.set_special_modulus_count(config.first);
+            parms.set_decomposition_number(config.second);
+
+            SEALContext context(parms, true, sec_level_type::none);
+            ASSERT_TRUE(context.parameters_set());
+            ASSERT_TRUE(context.first_context_data()->kswitch_tool());
+
+            KeyGenerator keygen(context);
+            PublicKey pk;
+            keygen.create_public_key(pk);
+            RelinKeys rlk;
+            keygen.create_relin_keys(rlk);
+            GaloisKeys glk;
+            keygen.create_galois_keys(glk);
+
+            Encryptor encryptor(context, pk);
+            Evaluator evaluator(context);
+            Decryptor decryptor(context, keygen.secret_key());
+            CKKSEncoder encoder(context);
+            const double delta = static_cast<double>(1ULL << 40);
+
+            vector<complex<double>> input(slot_size);
+            for (size_t i = 0; i < slot_size; i++)
+            {
+                input[i] = complex<double>(static_cast<double>(i % 7) - 3.0, static_cast<double>(i % 5) - 2.0);
+            }
+
+            Plaintext plain;
+            Ciphertext encrypted;
+            encoder.encode(input, context.first_parms_id(), delta, plain);
+            encryptor.encrypt(plain, encrypted);
+            evaluator.square_inplace(encrypted);
+            evaluator.relinearize_inplace(encrypted, rlk);
+            evaluator.rescale_to_next_inplace(encrypted);
+            evaluator.rotate_vector_inplace(encrypted, 3, glk);
+            evaluator.complex_conjugate_inplace(encrypted, glk);
+            decryptor.decrypt(encrypted, plain);
+
+            vector<complex<double>> output;
+            encoder.decode(plain, output);
+            for (size_t i = 0; i < slot_size; i++)
+            {
+                complex<double> expected = conj(input[(i + 3) % slot_size] * input[(i + 3) % slot_size]);
+                ASSERT_NEAR(expected.real(), output[i].real(), 0.001);
+                ASSERT_NEAR(expected.imag(), output[i].imag(), 0.001);
+            }
+        }
+    }
+
+    TEST(EvaluatorTest, HybridKeySwitchingMatchesDefault)
+    {
+        // Special modulus count 1 with one digit per prime is the classic scheme
+        EncryptionParameters parms(scheme_type::bfv);
+        parms.set_poly_modulus_degree(128);
+        parms.set_plain_modulus(1 << 6);
+        parms.set_coeff_modulus(CoeffModulus::Create(128, { 40, 40, 40, 40 }));
+        parms_id_type default_parms_id = parms.parms_id();
+        parms.set_special_modulus_count(1);
+        parms.set_decomposition_number(0);
+        ASSERT_TRUE(default_parms_id == parms.parms_id());
+        parms.set_decomposition_number(3);
+        ASSERT_FALSE(parms.using_hybrid_keyswitching());
+
+        SEALContext context(parms, true, sec_level_type::none);
+        ASSERT_FALSE(context.first_context_data()->kswitch_tool());
+    }
+
+    TEST(EvaluatorTest, CKKSEncryptInnerProductDecrypt)
+    {
+        // Pairs of special modulus count and decomposition number
+        vector<pair<size_t, size_t>> configs{ { 1, 0 }, { 2, 0 } };
+        for (auto &config : configs)
+        {
+            EncryptionParameters parms(scheme_type::ckks);
+            size_t slot_size = 32;
+            parms.set_poly_modulus_degree(slot_size * 2);
+            parms.set_coeff_modulus(CoeffModulus::Create(slot_size * 2, { 60, 40, 40, 60, 60 }));
+            parms.set_special_modulus_count(config.first);
+            parms.set_decomposition_number(config.second);
+            SEALContext context(parms, true, sec_level_type::none);
+            KeyGenerator keygen(context);
+            PublicKey pk;
+            keygen.create_public_key(pk);
+            RelinKeys rlk;
+            keygen.create_relin_keys(rlk);
+
+            Encryptor encryptor(context, pk);
+            Evaluator evaluator(context);
+            Decryptor decryptor(context, keygen.secret_key());
+            CKKSEncoder encoder(context);
+            const double delta = static_cast<double>(1ULL << 40);
+
+            size_t term_count = 5;
+            vector<vector<complex<double>>> inputs1(term_count, vector<complex<double>>(slot_size));
+            vector<vector<complex<double>>> inputs2(term_count, vector<complex<double>>(slot_size));
+            vector<Ciphertext> encrypteds1(term_count);
+            vector<Ciphertext> encrypteds2(term_count);
+            Plaintext plain;
+            for (size_t k = 0; k < term_count; k++)
+            {
+                for (size_t i = 0; i < slot_size; i++)
+                {
+                    inputs1[k][i] = complex<double>(static_cast<double>((i + k) % 7) - 3.0, static_cast<double>(k));
+                    inputs2[k][i] = complex<double>(static_cast<double>((i * k) % 5) - 2.0, 1.0);
+                }
+                encoder.encode(inputs1[k], delta, plain);
+                encryptor.encrypt(plain, encrypteds1[k]);
+                encoder.encode(inputs2[k], delta, plain);
+                encryptor.encrypt(plain, encrypteds2[k]);
+            }
+
+            // Reference computed with separate multiplications
+            Ciphertext expected_encrypted;
+            evaluator.multiply(encrypteds1[0], encrypteds2[0], expected_encrypted);
+            for (size_t k = 1; k < term_count; k++)
+            {
+                Ciphertext temp;
+                evaluator.multiply(encrypteds1[k], encrypteds2[k], temp);
+                evaluator.add_inplace(expected_encrypted, temp);
+            }
+
+            Ciphertext encrypted;
+            evaluator.multiply_accumulate(encrypteds1, encrypteds2, encrypted);
+            ASSERT_EQ(3, encrypted.size());
+            ASSERT_TRUE(encrypted.is_ntt_form());
+            ASSERT_EQ(delta * delta, encrypted.scale());
+            ASSERT_TRUE(equal(
+                expected_encrypted.data(), expected_encrypted.data() + expected_encrypted.dyn_array().size(),
+                encrypted.data()));
+
+            // Destination may alias one of the inputs
+            evaluator.inner_product(encrypteds1, encrypteds2, rlk, encrypteds1[1]);
+            ASSERT_EQ(2, encrypteds1[1].size());
+            evaluator.rescale_to_next_inplace(encrypteds1[1]);
+            decryptor.decrypt(encrypteds1[1], plain);
+            vector<complex<double>> output;
+            encoder.decode(plain, output);
+            for (size_t i = 0; i < slot_size; i++)
+            {
+                complex<double> expected = 0;
+                for (size_t k = 0; k < term_count; k++)
+                {
+                    expected += inputs1[k][i] * inputs2[k][i];
+                }
+                ASSERT_NEAR(expected.real(), output[i].real(), 0.01);
+                ASSERT_NEAR(expected.imag(), output[i].imag(), 0.01);
+            }
+
+            // Invalid inputs
+            ASSERT_THROW(
+                evaluator.multiply_accumulate(vector<Ciphertext>{}, vector<Ciphertext>{}, encrypted), invalid_argument);
+            ASSERT_THROW(
+                evaluator.multiply_accumulate(encrypteds1, vector<Ciphertext>(2, encrypteds2[0]), encrypted),
+                invalid_argument);
+            ASSERT_THROW(evaluator.multiply_accumulate(encrypteds1, encrypteds2, encrypted), invalid_argument);
+        }
+    }
+
+    TEST(EvaluatorTest, BFVBGVEncryptInnerProductDecrypt)
+    {
+        auto inner_product_test = [](scheme_type scheme, size_t special_modulus_count) {
+            EncryptionParameters parms(scheme);
+            parms.set_poly_modulus_degree(64);
+            parms.set_plain_modulus(PlainModulus::Batching(64, 20));
+            parms.set_coeff_modulus(CoeffModulus::Create(64, { 40, 40, 40, 40 }));
+            parms.set_special_modulus_count(special_modulus_count);
+            SEALContext context(parms, true, sec_level_type::none);
+            KeyGenerator keygen(context);
+            PublicKey pk;
+            keygen.create_public_key(pk);
+            RelinKeys rlk;
+            keygen.create_relin_keys(rlk);
+
+            Encryptor encryptor(context, pk);
+            Evaluator evaluator(context);
+            Decryptor decryptor(context, keygen.secret_key());
+            BatchEncoder batch_encoder(context);
+            uint64_t t = parms.plain_modulus().value();
+            size_t slot_count = batch_encoder.slot_count();
+
+            size_t term_count = 6;
+            vector<vector<uint64_t>> inputs1(term_count, vector<uint64_t>(slot_count));
+            vector<vector<uint64_t>> inputs2(term_count, vector<uint64_t>(slot_count));
+            vector<Ciphertext> encrypteds1(term_count);
+            vector<Ciphertext> encrypteds2(term_count);
+            Plaintext plain;
+            for (size_t k = 0; k < term_count; k++)
+            {
+                for (size_t i = 0; i < slot_count; i++)
+                {
+                    inputs1[k][i] = (i * 3 + k) % t;
+                    inputs2[k][i] = (i + k * k + 1) % t;
+                }
+                batch_encoder.encode(inputs1[k], plain);
+                encryptor.encrypt(plain, encrypteds1[k]);
+                batch_encoder.encode(inputs2[k], plain);
+                encryptor.encrypt(plain, encrypteds2[k]);
+            }
+
+            Ciphertext encrypted;
+            evaluator.inner_product(encrypteds1, encrypteds2, rlk, encrypted);
+            ASSERT_EQ(2, encrypted.size());
+            decryptor.decrypt(encrypted, plain);
+            vector<uint64_t> output;
+            batch_encoder.decode(plain, output);
+            for (size_t i = 0; i < slot_count; i++)
+            {
+                uint64_t expected = 0;
+                for (size_t k = 0; k < term_count; k++)
+                {
+                    expected = (expected + inputs1[k][i] * inputs2[k][i]) % t;
+                }
+                ASSERT_EQ(expected, output[i]);
+            }
+
+            // Ciphertexts of size 3 use the generic path
+            Ciphertext square;
+            evaluator.square(encrypteds1[1], square);
+            vector<Ciphertext> squares{ square };
+            vector<Ciphertext> ones{ encrypteds2[1] };
+            evaluator.multiply_accumulate(squares, ones, encrypted);
+            ASSERT_EQ(4, encrypted.size());
+        };
+        inner_product_test(scheme_type::bfv, 1);
+        inner_product_test(scheme_type::bfv, 2);
+        inner_product_test(scheme_type::bgv, 1);
+        inner_product_test(scheme_type::bgv, 2);
+    }
+
+    TEST(EvaluatorTest, EncryptInnerProductPlainDecrypt)
+    {
+        auto inner_product_plain_test = [](scheme_type scheme, size_t term_count) {
+            EncryptionParameters parms(scheme);
+            parms.set_poly_modulus_degree(64);
+            if (scheme == scheme_type::ckks)
+            {
+                parms.set_coeff_modulus(CoeffModulus::Create(64, { 60, 40, 60 }));
+            }
+            else
+            {
+                parms.set_plain_modulus(PlainModulus::Batching(64, 20));
+                parms.set_coeff_modulus(CoeffModulus::Create(64, { 60, 60, 60 }));
+            }
+            SEALContext context(parms, true, sec_level_type::none);
+            KeyGenerator keygen(context);
+            PublicKey pk;
+            keygen.create_public_key(pk);
+
+            Encryptor encryptor(context, pk);
+            Evaluator evaluator(context);
+
+            // Enough terms to need intermediate reductions of the 128-bit accumulators
+            vector<Ciphertext> encrypteds(term_count);
+            vector<Plaintext> plains(term_count);
+            for (size_t k = 0; k < term_count; k++)
+            {
+                Plaintext plain("1x^" + to_string(k % 63 + 1) + " + " + to_string(k % 7 + 1));
+                if (scheme == scheme_type::ckks)
+                {
+                    CKKSEncoder encoder(context);
+                    encoder.encode(static_cast<double>(k % 5) - 2.0, pow(2.0, 20), plain);
+                    encryptor.encrypt(plain, encrypteds[k]);
+                    encoder.encode(static_cast<double>(k % 3) + 1.0, pow(2.0, 20), plains[k]);
+                }
+                else
+                {
+                    encryptor.encrypt(plain, encrypteds[k]);
+                    evaluator.transform_to_ntt_inplace(encrypteds[k]);
+                    plains[k] = Plaintext("1x^" + to_string((k * 3) % 63 + 1) + " + 2");
+                    evaluator.transform_to_ntt_inplace(plains[k], context.first_parms_id());
+                }
+            }
+
+            // Reference computed with separate multiplications
+            Ciphertext expected;
+            evaluator.multiply_plain(encrypteds[0], plains[0], expected);
+            for (size_t k = 1; k < term_count; k++)
+            {
+                Ciphertext temp;
+                evaluator.multiply_plain(encrypteds[k], plains[k], temp);
+                evaluator.add_inplace(expected, temp);
+            }
+
+            Ciphertext encrypted;
+            evaluator.inner_product_plain(encrypteds, plains, encrypted);
+            ASSERT_TRUE(encrypted.parms_id() == expected.parms_id());
+            ASSERT_EQ(expected.size(), encrypted.size());
+            ASSERT_TRUE(encrypted.is_ntt_form());
+            ASSERT_EQ(expected.scale(), encrypted.scale());
+            ASSERT_TRUE(equal(expected.data(), expected.data() + expected.dyn_array().size(), encrypted.data()));
+
+            // Destination may alias one of the inputs
+            evaluator.inner_product_plain(encrypteds, plains, encrypteds[0]);
+            ASSERT_TRUE(equal(encrypted.data(), encrypted.data() + encrypted.dyn_array().size(), encrypteds[0].data()));
+
+            // Invalid inputs
+            ASSERT_THROW(
+                evaluator.inner_product_plain(vector<Ciphertext>{}, vector<Plaintext>{}, encrypted), invalid_argument);
+            ASSERT_THROW(
+                evaluator.inner_product_plain(encrypteds, vector<Plaintext>(term_count + 1, plains[0]), encrypted),
+                invalid_argument);
+            if (scheme != scheme_type::ckks && term_count > 1)
+            {
+                evaluator.transform_from_ntt_inplace(encrypteds[1]);
+                ASSERT_THROW(evaluator.inner_product_plain(encrypteds, plains, encrypted), invalid_argument);
+            }
+        };
+        inner_product_plain_test(scheme_type::bfv, 1);
+        inner_product_plain_test(scheme_type::bfv, 300);
+        inner_product_plain_test(scheme_type::bgv, 300);
+        inner_product_plain_test(scheme_type::ckks, 1);
+        inner_product_plain_test(scheme_type::ckks, 300);
+    }
+
+    TEST(EvaluatorTest, TraceAllocations)
+    {
+        // Allocations made on the threads of the thread pool are traced as well
+        size_t thread_count = util::ThreadPool::Global().thread_count();
+        util::ThreadPool::Global().set_thread_count(4);
+
+        EncryptionParameters parms(scheme_type::bfv);
+        parms.set_poly_modulus_degree(4096);
+        parms.set_plain_modulus(1 << 6);
+        parms.set_coeff_modulus(CoeffModulus::BFVDefault(4096));
+
+        SEALContext context(parms, false, sec_level_type::none);
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+        Encryptor encryptor(context, pk);
+        Evaluator evaluator(context);
+
+        Ciphertext encrypted;
+        encryptor.encrypt(Plaintext("1x^1"), encrypted);
+        MemoryPoolHandle pool = MemoryPoolHandle::New();
+        pool.set_trace(1);
+        evaluator.multiply_inplace(encrypted, encrypted, pool);
+        util::ThreadPool::Global().set_thread_count(thread_count);
+
+        // Every allocation from the pool is made for the function called
+        auto trace = pool.trace();
+        ASSERT_FALSE(trace.empty());
+        for (auto &entry : trace)
+        {
+            ASSERT_STREQ("Evaluator::multiply_inplace", entry.function);
+        }
+        ASSERT_TRUE(pool.stats().in_use_byte_count == 0);
+    }
 } // namespace sealtest
@@ -0,0 +1,244 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/batchencoder.h"
+#include "seal/ckks.h"
+#include "seal/context.h"
+#include "seal/decryptor.h"
+#include "seal/encryptor.h"
+#include "seal/evaluator.h"
+#include "seal/keygenerator.h"
+#include "seal/lineartransform.h"
+#include "seal/modulus.h"
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <vector>
+#include "gtest/gtest.h"
+
+using namespace seal;
+using namespace std;
+
+namespace sealtest
+{
+    TEST(LinearTransformTest, Create)
+    {
+        EncryptionParameters parms(scheme_type::bfv);
+        parms.set_poly_modulus_degree(64);
+        parms.set_plain_modulus(PlainModulus::Batching(64, 20));
+        parms.set_coeff_modulus(CoeffModulus::Create(64, { 40, 40, 40 }));
+        SEALContext context(parms, true, sec_level_type::none);
+
+        // Dimension 8 with only diagonals 0 and 5 nonzero
+        size_t d = 8;
+        vector<vector<uint64_t>> matrix(d, vector<uint64_t>(d, 0));
+        for (size_t i = 0; i < d; i++)
+        {
+            matrix[i][i] = 1;
+            matrix[i][(i + 5) % d] = 2;
+        }
+        LinearTransform transform(context, matrix, context.first_parms_id());
+        ASSERT_EQ(d, transform.dimension());
+        ASSERT_EQ(3, transform.baby_step_count());
+        ASSERT_EQ(3, transform.giant_step_count());
+        ASSERT_TRUE(transform.is_prepared(context.first_parms_id()));
+        ASSERT_FALSE(transform.is_prepared(context.last_parms_id()));
+        ASSERT_THROW((void)transform.diagonals(context.last_parms_id()), invalid_argument);
+
+        auto &diagonals = transform.diagonals(context.first_parms_id());
+        ASSERT_EQ(d, diagonals.size());
+        for (size_t k = 0; k < d; k++)
+        {
+            bool nonzero = (k == 0 || k == 5);
+            ASSERT_EQ(nonzero, !transform.is_zero_diagonal(k));
+            ASSERT_EQ(nonzero, !diagonals[k].is_zero());
+            ASSERT_EQ(nonzero, diagonals[k].is_ntt_form());
+        }
+
+        // Diagonal 5 is baby step 2 in giant step 1; only these are needed
+        ASSERT_TRUE((vector<int>{ 2, 3 }) == transform.galois_steps());
+
+        transform.prepare(context.last_parms_id());
+        ASSERT_TRUE(transform.is_prepared(context.last_parms_id()));
+        ASSERT_TRUE(transform.diagonals(context.last_parms_id())[5].parms_id() == context.last_parms_id());
+
+        LinearTransform transform2(context, matrix, context.first_parms_id(), 8);
+        ASSERT_EQ(8, transform2.baby_step_count());
+        ASSERT_EQ(1, transform2.giant_step_count());
+        ASSERT_TRUE((vector<int>{ 5 }) == transform2.galois_steps());
+
+        // Invalid dimensions
+        ASSERT_THROW(LinearTransform(context, vector<vector<uint64_t>>{}, context.first_parms_id()), invalid_argument);
+        ASSERT_THROW(
+            LinearTransform(context, vector<vector<uint64_t>>(3, vector<uint64_t>(3)), context.first_parms_id()),
+            invalid_argument);
+        ASSERT_THROW(
+            LinearTransform(context, vector<vector<uint64_t>>(4, vector<uint64_t>(2)), context.first_parms_id()),
+            invalid_argument);
+        ASSERT_THROW(LinearTransform(context, matrix, context.first_parms_id(), 9), invalid_argument);
+
+        // Wrong scheme
+        ASSERT_THROW(
+            LinearTransform(context, vector<vector<double>>(4, vector<double>(4)), context.first_parms_id(), 1.0),
+            invalid_argument);
+    }
+
+    TEST(LinearTransformTest, BFVBGVLinearTransform)
+    {
+        auto linear_transform_test = [](scheme_type scheme, size_t d, size_t special_modulus_count,
+                                        bool all_keys) {
+            EncryptionParameters parms(scheme);
+            parms.set_poly_modulus_degree(64);
+            parms.set_plain_modulus(PlainModulus::Batching(64, 20));
+            parms.set_coeff_modulus(CoeffModulus::Create(64, { 40, 40, 40, 40, 40 }));
+            parms.set_special_modulus_count(special_modulus_count);
+            SEALContext context(parms, true, sec_level_type::none);
+            KeyGenerator keygen(context);
+            PublicKey pk;
+            keygen.create_public_key(pk);
+
+            Encryptor encryptor(context, pk);
+            Evaluator evaluator(context);
+            Decryptor decryptor(context, keygen.secret_key());
+            BatchEncoder batch_encoder(context);
+            uint64_t t = parms.plain_modulus().value();
+            size_t row_size = batch_encoder.slot_count() / 2;
+
+            vector<vector<uint64_t>> matrix(d, vector<uint64_t>(d));
+            for (size_t i = 0; i < d; i++)
+            {
+                for (size_t j = 0; j < d; j++)
+                {
+                    matrix[i][j] = (i * 7 + j * j + 3) % 11;
+                }
+            }
+            auto second_parms_id = context.first_context_data()->next_context_data()->parms_id();
+            LinearTransform transform(context, matrix, context.first_parms_id());
+            transform.prepare(second_parms_id);
+
+            // Without the giant step keys the rotations are composed from power-of-two rotations
+            GaloisKeys glk;
+            if (all_keys)
+            {
+                keygen.create_galois_keys(transform.galois_steps(), glk);
+            }
+            else
+            {
+                keygen.create_galois_keys(glk);
+            }
+
+            // The input is replicated with period d
+            vector<uint64_t> input(batch_encoder.slot_count());
+            for (size_t i = 0; i < input.size(); i++)
+            {
+                input[i] = (i % d) * (i % d) + 1 + (i / row_size);
+            }
+            Plaintext plain;
+            batch_encoder.encode(input, plain);
+            Ciphertext encrypted;
+            encryptor.encrypt(plain, encrypted);
+
+            for (int level = 0; level < 2; level++)
+            {
+                Ciphertext result;
+                evaluator.linear_transform(encrypted, transform, glk, result);
+                ASSERT_TRUE(result.parms_id() == encrypted.parms_id());
+                decryptor.decrypt(result, plain);
+                vector<uint64_t> output;
+                batch_encoder.decode(plain, output);
+                for (size_t i = 0; i < output.size(); i++)
+                {
+                    size_t row_begin = (i / row_size) * row_size;
+                    uint64_t expected = 0;
+                    for (size_t j = 0; j < d; j++)
+                    {
+                        expected = (expected + matrix[i % d][j] * input[row_begin + j]) % t;
+                    }
+                    ASSERT_EQ(expected, output[i]);
+                }
+                evaluator.mod_switch_to_inplace(encrypted, second_parms_id);
+            }
+        };
+        linear_transform_test(scheme_type::bfv, 32, 1, true);
+        linear_transform_test(scheme_type::bfv, 8, 2, true);
+        linear_transform_test(scheme_type::bfv, 16, 1, false);
+        linear_transform_test(scheme_type::bgv, 32, 1, true);
+        linear_transform_test(scheme_type::bgv, 8, 2, true);
+        linear_transform_test(scheme_type::bgv, 16, 2, false);
+    }
+
+    TEST(LinearTransformTest, CKKSLinearTransform)
+    {
+        auto linear_transform_test = [](size_t d, size_t special_modulus_count, bool all_keys) {
+            EncryptionParameters parms(scheme_type::ckks);
+            size_t slot_size = 32;
+            parms.set_poly_modulus_degree(slot_size * 2);
+            parms.set_coeff_modulus(CoeffModulus::Create(slot_size * 2, { 60, 40, 40, 60, 60 }));
+            parms.set_special_modulus_count(special_modulus_count);
+            SEALContext context(parms, true, sec_level_type::none);
+            KeyGenerator keygen(context);
+            PublicKey pk;
+            keygen.create_public_key(pk);
+
+            Encryptor encryptor(context, pk);
+            Evaluator evaluator(context);
+            Decryptor decryptor(context, keygen.secret_key());
+            CKKSEncoder encoder(context);
+            const double delta = static_cast<double>(1ULL << 40);
+
+            vector<vector<complex<double>>> matrix(d, vector<complex<double>>(d));
+            for (size_t i = 0; i < d; i++)
+            {
+                for (size_t j = 0; j < d; j++)
+                {
+                    matrix[i][j] = complex<double>(
+                        static_cast<double>((i + 2 * j) % 5) - 2.0, static_cast<double>((i * j) % 3) - 1.0);
+                }
+            }
+            LinearTransform transform(context, matrix, context.first_parms_id(), delta);
+            GaloisKeys glk;
+            if (all_keys)
+            {
+                keygen.create_galois_keys(transform.galois_steps(), glk);
+            }
+            else
+            {
+                keygen.create_galois_keys(glk);
+            }
+
+            vector<complex<double>> input(slot_size);
+            for (size_t i = 0; i < slot_size; i++)
+            {
+                input[i] = complex<double>(static_cast<double>(i % d) - 3.0, static_cast<double>((i % d) % 4));
+            }
+            Plaintext plain;
+            encoder.encode(input, context.first_parms_id(), delta, plain);
+            Ciphertext encrypted;
+            encryptor.encrypt(plain, encrypted);
+
+            evaluator.linear_transform_inplace(encrypted, transform, glk);
+            ASSERT_EQ(delta * delta, encrypted.scale());
+            evaluator.rescale_to_next_inplace(encrypted);
+            decryptor.decrypt(encrypted, plain);
+            vector<complex<double>> output;
+            encoder.decode(plain, output);
+            for (size_t i = 0; i < slot_size; i++)
+            {
+                complex<double> expected = 0;
+                for (size_t j = 0; j < d; j++)
+                {
+                    expected += matrix[i % d][j] * input[j];
+                }
+                ASSERT_NEAR(expected.real(), output[i].real(), 0.01);
+                ASSERT_NEAR(expected.imag(), output[i].imag(), 0.01);
+            }
+
+            // Not prepared for this level
+            ASSERT_THROW(evaluator.linear_transform_inplace(encrypted, transform, glk), invalid_argument);
+        };
+        linear_transform_test(32, 1, true);
+        linear_transform_test(16, 2, true);
+        linear_transform_test(8, 1, false);
+        linear_transform_test(32, 2, false);
+    }
+} // namespace sealtest
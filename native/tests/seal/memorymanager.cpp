@@ -2,9 +2,13 @@
 // Licensed under the MIT license.
 
 #include "seal/dynarray.h"
+#include "seal/kswitchkeys.h"
 #include "seal/memorymanager.h"
 #include "seal/util/pointer.h"
 #include "seal/util/uintcore.h"
+#include <chrono>
+#include <thread>
+#include <vector>
 #include "gtest/gtest.h"
 
 using namespace seal;
@@ -67,4 +71,161 @@ namespace sealtest
         }
         ASSERT_EQ(1L, pool.use_count());
     }
+
+    TEST(MemoryPoolHandleTest, SizeClass)
+    {
+        MemoryPoolHandle pool = MemoryPoolHandle::GlobalSizeClass();
+        ASSERT_TRUE(&static_cast<MemoryPool &>(pool) == global_variables::global_size_class_memory_pool.get());
+        ASSERT_TRUE(static_cast<MemoryPool &>(pool).is_thread_safe());
+
+        pool = MemoryPoolHandle::NewSizeClass();
+        ASSERT_FALSE(pool == MemoryPoolHandle::GlobalSizeClass());
+        ASSERT_TRUE(0LL == pool.alloc_byte_count());
+        {
+            auto ptr(allocate_uint(5, pool));
+            ASSERT_TRUE(1LL == pool.pool_count());
+            ASSERT_TRUE(pool.alloc_byte_count() >= 5LL * bytes_per_uint64);
+        }
+
+        {
+            MMProfGuard guard(make_unique<MMProfSizeClass>());
+            ASSERT_TRUE(MemoryManager::GetPool() == MemoryPoolHandle::GlobalSizeClass());
+            ASSERT_TRUE(MemoryManager::GetPool(mm_prof_opt::mm_force_global) == MemoryPoolHandle::Global());
+        }
+        ASSERT_FALSE(MemoryManager::GetPool() == MemoryPoolHandle::GlobalSizeClass());
+    }
+
+    TEST(MemoryPoolHandleTest, Trim)
+    {
+        for (auto pool : { MemoryPoolHandle::New(), MemoryPoolHandle::NewSizeClass() })
+        {
+            ASSERT_EQ(0ULL, pool.trim());
+            {
+                vector<Pointer<uint64_t>> pointers;
+                for (size_t i = 0; i < 16; i++)
+                {
+                    pointers.push_back(allocate_uint(4096, pool));
+                }
+                auto held = allocate_uint(1000, pool);
+                pointers.clear();
+
+                size_t byte_count = pool.alloc_byte_count();
+                size_t freed_byte_count = pool.trim(1000 * bytes_per_uint64);
+                ASSERT_TRUE(freed_byte_count > 0);
+                ASSERT_EQ(byte_count - freed_byte_count, pool.alloc_byte_count());
+                ASSERT_TRUE(pool.alloc_byte_count() >= 1000 * bytes_per_uint64);
+            }
+            pool.trim();
+            ASSERT_EQ(0ULL, pool.alloc_byte_count());
+        }
+
+        MemoryPoolHandle pool;
+        ASSERT_THROW((void)pool.trim(), logic_error);
+    }
+
+    TEST(MemoryPoolHandleTest, Trimmer)
+    {
+        MemoryPoolHandle pool = MemoryPoolHandle::New();
+        ASSERT_THROW(MemoryPoolTrimmer(MemoryPoolHandle(), chrono::milliseconds(1)), invalid_argument);
+        ASSERT_THROW(MemoryPoolTrimmer(pool, chrono::milliseconds(0)), invalid_argument);
+        ASSERT_THROW(
+            MemoryPoolTrimmer(MemoryPoolHandle(make_shared<MemoryPoolST>()), chrono::milliseconds(1)), invalid_argument);
+        ASSERT_THROW(MemoryPoolTrimmer(MemoryPoolHandle::ThreadLocal(), chrono::milliseconds(1)), invalid_argument);
+        {
+            auto ptr = allocate_uint(4096, pool);
+        }
+        size_t byte_count = pool.alloc_byte_count();
+        ASSERT_TRUE(byte_count > 0);
+
+        // The pool does not grow any more, so the trimmer eventually frees everything
+        MemoryPoolTrimmer trimmer(pool, chrono::milliseconds(1));
+        for (size_t i = 0; i < 1000 && pool.alloc_byte_count(); i++)
+        {
+            this_thread::sleep_for(chrono::milliseconds(2));
+        }
+        ASSERT_EQ(0ULL, pool.alloc_byte_count());
+        ASSERT_EQ(byte_count, trimmer.freed_byte_count());
+    }
+
+    TEST(MemoryPoolHandleTest, Stats)
+    {
+        for (auto pool : { MemoryPoolHandle::New(), MemoryPoolHandle::NewSizeClass() })
+        {
+            auto ptr1 = allocate_uint(1000, pool);
+            auto ptr2 = allocate_uint(1000, pool);
+            ptr2.release();
+
+            MemoryPoolStats stats = pool.stats();
+            ASSERT_EQ(1ULL, stats.size_classes.size());
+            ASSERT_EQ(pool.alloc_byte_count(), stats.alloc_byte_count);
+            ASSERT_EQ(stats.size_classes[0].item_byte_count, stats.in_use_byte_count);
+            ASSERT_EQ(stats.alloc_byte_count - stats.in_use_byte_count, stats.cached_byte_count);
+            ASSERT_TRUE(stats.cached_byte_count >= stats.size_classes[0].item_byte_count);
+
+            pool.set_trace(1);
+            {
+                AllocationScope scope("Evaluator::multiply_inplace");
+                ptr2 = allocate_uint(10, pool);
+            }
+            vector<MemoryPoolTraceEntry> trace = pool.trace();
+            ASSERT_EQ(1ULL, trace.size());
+            ASSERT_EQ(10 * bytes_per_uint64, trace[0].byte_count);
+            ASSERT_STREQ("Evaluator::multiply_inplace", trace[0].function);
+        }
+
+        MemoryPoolHandle pool;
+        ASSERT_TRUE(pool.stats().size_classes.empty());
+        ASSERT_EQ(0ULL, pool.stats().alloc_byte_count);
+        ASSERT_TRUE(pool.trace().empty());
+        ASSERT_THROW(pool.set_trace(1), logic_error);
+    }
+
+    TEST(MemoryPoolHandleTest, HugePages)
+    {
+        MemoryPoolHandle pool = MemoryPoolHandle::New(false, true);
+        ASSERT_TRUE(dynamic_cast<MemoryPoolMT &>(static_cast<MemoryPool &>(pool)).huge_pages());
+
+        // Keys and other data created in the scope of the guard use the pool
+        {
+            MMProfGuard guard(make_unique<MMProfFixed>(pool));
+            KSwitchKeys keys;
+            ASSERT_TRUE(keys.pool() == pool);
+            DynArray<uint64_t> data(MemoryManager::GetPool());
+            data.resize(MemoryPool::huge_page_byte_count / bytes_per_uint64);
+            ASSERT_TRUE(data.pool() == pool);
+            ASSERT_EQ(1ULL, pool.pool_count());
+        }
+        ASSERT_EQ(0ULL, pool.stats().in_use_byte_count);
+    }
+
+    TEST(MemoryPoolHandleTest, Arena)
+    {
+        MemoryPoolHandle arena = MemoryPoolHandle::Arena(4096);
+        ASSERT_THROW(MMProfArena{ MemoryPoolHandle() }, invalid_argument);
+        ASSERT_THROW(MMProfArena(MemoryPoolHandle::New()), invalid_argument);
+        ASSERT_THROW(MMProfArena(size_t(0)), invalid_argument);
+
+        // Temporary allocations in the scope are given back when the scope ends
+        {
+            MMProfGuard guard(make_unique<MMProfArena>(arena));
+            ASSERT_TRUE(arena == MemoryManager::GetPool());
+            auto ptr = allocate_uint(10, MemoryManager::GetPool());
+            ASSERT_EQ(4096ULL, arena.alloc_byte_count());
+            ASSERT_TRUE(arena.stats().size_classes[0].in_use_count > 0);
+        }
+        ASSERT_FALSE(arena == MemoryManager::GetPool());
+        ASSERT_EQ(0ULL, arena.stats().size_classes[0].in_use_count);
+
+        // Memory that outlives the scope keeps the arena from being reset
+        Pointer<uint64_t> held;
+        {
+            MMProfGuard guard(make_unique<MMProfArena>(arena));
+            held = allocate_uint(10, MemoryManager::GetPool());
+        }
+        ASSERT_TRUE(arena.stats().size_classes[0].in_use_count > 0);
+        held.release();
+        MMProfArena prof(arena);
+        ASSERT_TRUE(prof.reset());
+        ASSERT_EQ(0ULL, arena.stats().size_classes[0].in_use_count);
+    }
 } // namespace sealtest
@@ -180,6 +180,20 @@ namespace sealtest
         ASSERT_EQ(0, mod.reduce(12345670));
     }
 
+    TEST(ModulusTest, MontgomeryInverse)
+    {
+        Modulus mod;
+        ASSERT_EQ(0ULL, mod.montgomery_inverse());
+        mod = 10;
+        ASSERT_EQ(0ULL, mod.montgomery_inverse());
+
+        for (uint64_t value : { 3ULL, 7ULL, 0xFFFFFFFFULL, 0x1FFFFFFFFFFFFFFFULL })
+        {
+            mod = value;
+            ASSERT_EQ(1ULL, value * mod.montgomery_inverse());
+        }
+    }
+
     TEST(CoeffModTest, CustomExceptionTest)
     {
         // Too small poly_modulus_degree
@@ -0,0 +1,223 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/batchencoder.h"
+#include "seal/ckks.h"
+#include "seal/context.h"
+#include "seal/decryptor.h"
+#include "seal/encryptor.h"
+#include "seal/evaluator.h"
+#include "seal/keygenerator.h"
+#include "seal/modulus.h"
+#include "seal/rotationplan.h"
+#include <complex>
+#include <cstdint>
+#include <vector>
+#include "gtest/gtest.h"
+
+using namespace seal;
+using namespace std;
+
+namespace sealtest
+{
+    TEST(RotationPlanTest, Create)
+    {
+        EncryptionParameters parms(scheme_type::bfv);
+        parms.set_poly_modulus_degree(64);
+        parms.set_plain_modulus(PlainModulus::Batching(64, 20));
+        parms.set_coeff_modulus(CoeffModulus::Create(64, { 40, 40, 40 }));
+        SEALContext context(parms, true, sec_level_type::none);
+        KeyGenerator keygen(context);
+
+        // The size of a single key matches the generated keys
+        size_t key_bytes = RotationPlan::galois_key_byte_count(context);
+        GaloisKeys glk;
+        keygen.create_galois_keys(vector<int>{ 1 }, glk);
+        size_t generated_bytes = 0;
+        for (auto &component : glk.key(context.key_context_data()->galois_tool()->get_elt_from_step(1)))
+        {
+            generated_bytes += component.data().dyn_array().size() * sizeof(uint64_t);
+        }
+        ASSERT_EQ(generated_bytes, key_bytes);
+
+        // Every step gets its own key if the budget allows it; 31 is equivalent to -1
+        vector<int> steps{ 1, 2, 3, 5, 7, -1, 0, 3, 31 };
+        RotationPlan plan(context, steps, 6 * key_bytes);
+        ASSERT_TRUE((vector<int>{ 1, 2, 3, 5, 7, -1 }) == plan.key_steps());
+        ASSERT_EQ(6, plan.galois_elts().size());
+        ASSERT_EQ(context.key_context_data()->galois_tool()->get_elt_from_step(-1), plan.galois_elts()[5]);
+        ASSERT_EQ(1, plan.max_key_switch_count());
+        ASSERT_TRUE(plan.key_parms_id() == context.key_parms_id());
+        for (auto step : steps)
+        {
+            ASSERT_TRUE(plan.contains(step));
+            ASSERT_EQ(step ? 1 : 0, plan.key_switch_count(step));
+        }
+        ASSERT_FALSE(plan.contains(4));
+        ASSERT_THROW((void)plan.decomposition(4), invalid_argument);
+        ASSERT_THROW((void)plan.contains(32), invalid_argument);
+
+        // With a smaller budget the steps are composed from fewer keys
+        auto check_plan = [&](const RotationPlan &small_plan, size_t max_key_count) {
+            ASSERT_GE(max_key_count, small_plan.key_steps().size());
+            ASSERT_EQ(small_plan.key_steps().size(), small_plan.galois_elts().size());
+            size_t max_key_switch_count = 0;
+            for (auto step : steps)
+            {
+                ASSERT_TRUE(small_plan.contains(step));
+                int sum = 0;
+                for (auto key_step : small_plan.decomposition(step))
+                {
+                    ASSERT_TRUE(
+                        find(small_plan.key_steps().cbegin(), small_plan.key_steps().cend(), key_step) !=
+                        small_plan.key_steps().cend());
+                    sum += key_step;
+                }
+                ASSERT_EQ(0, ((sum - step) % 32 + 32) % 32);
+                max_key_switch_count = max(max_key_switch_count, small_plan.key_switch_count(step));
+            }
+            ASSERT_EQ(max_key_switch_count, small_plan.max_key_switch_count());
+        };
+        check_plan(RotationPlan(context, steps, 3 * key_bytes), 3);
+        check_plan(RotationPlan(context, steps, 2 * key_bytes + key_bytes / 2), 2);
+        check_plan(RotationPlan(context, steps, key_bytes), 1);
+
+        // The whole budget is used when not every step can have its own key
+        RotationPlan plan3(context, steps, 3 * key_bytes);
+        ASSERT_EQ(3, plan3.key_steps().size());
+        ASSERT_GE(3, plan3.max_key_switch_count());
+
+        // A budget of a single key forces a generator of all rotations
+        RotationPlan plan1(context, vector<int>{ 2, 4, 6 }, key_bytes);
+        ASSERT_TRUE((vector<int>{ 2 }) == plan1.key_steps());
+        ASSERT_EQ(3, plan1.max_key_switch_count());
+
+        // Budget too small
+        ASSERT_THROW(RotationPlan(context, steps, key_bytes - 1), invalid_argument);
+
+        // An empty plan needs no keys
+        RotationPlan empty_plan(context, vector<int>{ 0 }, 0);
+        ASSERT_TRUE(empty_plan.galois_elts().empty());
+        ASSERT_EQ(0, empty_plan.max_key_switch_count());
+
+        // Step counts too large
+        ASSERT_THROW(RotationPlan(context, vector<int>{ 32 }, key_bytes), invalid_argument);
+        ASSERT_THROW(RotationPlan(context, vector<int>{ -32 }, key_bytes), invalid_argument);
+    }
+
+    TEST(RotationPlanTest, BFVBGVRotateRows)
+    {
+        auto rotate_rows_test = [](scheme_type scheme, size_t special_modulus_count) {
+            EncryptionParameters parms(scheme);
+            parms.set_poly_modulus_degree(64);
+            parms.set_plain_modulus(PlainModulus::Batching(64, 20));
+            parms.set_coeff_modulus(CoeffModulus::Create(64, { 40, 40, 40, 40 }));
+            parms.set_special_modulus_count(special_modulus_count);
+            SEALContext context(parms, true, sec_level_type::none);
+            KeyGenerator keygen(context);
+            PublicKey pk;
+            keygen.create_public_key(pk);
+
+            Encryptor encryptor(context, pk);
+            Evaluator evaluator(context);
+            Decryptor decryptor(context, keygen.secret_key());
+            BatchEncoder batch_encoder(context);
+            size_t row_size = batch_encoder.slot_count() / 2;
+
+            vector<int> steps{ 3, 5, 11, -7, 13, 21, -15 };
+            RotationPlan plan(context, steps, 3 * RotationPlan::galois_key_byte_count(context));
+            GaloisKeys glk;
+            keygen.create_galois_keys(plan.galois_elts(), glk);
+            ASSERT_EQ(plan.galois_elts().size(), glk.size());
+
+            vector<uint64_t> input(batch_encoder.slot_count());
+            for (size_t i = 0; i < input.size(); i++)
+            {
+                input[i] = i + 1;
+            }
+            Plaintext plain;
+            batch_encoder.encode(input, plain);
+            Ciphertext encrypted;
+            encryptor.encrypt(plain, encrypted);
+
+            for (auto step : steps)
+            {
+                Ciphertext rotated;
+                evaluator.rotate_rows(encrypted, step, glk, plan, rotated);
+                decryptor.decrypt(rotated, plain);
+                vector<uint64_t> output;
+                batch_encoder.decode(plain, output);
+                for (size_t i = 0; i < output.size(); i++)
+                {
+                    size_t row_begin = (i / row_size) * row_size;
+                    size_t source = (i - row_begin + row_size + static_cast<size_t>(step + 32)) % row_size;
+                    ASSERT_EQ(input[row_begin + source], output[i]);
+                }
+            }
+
+            // Not in the plan
+            ASSERT_THROW(evaluator.rotate_rows_inplace(encrypted, 1, glk, plan), invalid_argument);
+
+            // Keys are missing
+            GaloisKeys glk_other;
+            keygen.create_galois_keys(vector<int>{ 1 }, glk_other);
+            ASSERT_THROW(evaluator.rotate_rows_inplace(encrypted, 3, glk_other, plan), invalid_argument);
+        };
+        rotate_rows_test(scheme_type::bfv, 1);
+        rotate_rows_test(scheme_type::bfv, 2);
+        rotate_rows_test(scheme_type::bgv, 1);
+        rotate_rows_test(scheme_type::bgv, 2);
+    }
+
+    TEST(RotationPlanTest, CKKSRotateVector)
+    {
+        EncryptionParameters parms(scheme_type::ckks);
+        size_t slot_size = 32;
+        parms.set_poly_modulus_degree(slot_size * 2);
+        parms.set_coeff_modulus(CoeffModulus::Create(slot_size * 2, { 60, 40, 40, 60 }));
+        SEALContext context(parms, true, sec_level_type::none);
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+
+        Encryptor encryptor(context, pk);
+        Evaluator evaluator(context);
+        Decryptor decryptor(context, keygen.secret_key());
+        CKKSEncoder encoder(context);
+        const double delta = static_cast<double>(1ULL << 30);
+
+        vector<int> steps{ 1, 2, 3, 4, 5, 6, 7, 8, 16, 24, -1 };
+        RotationPlan plan(context, steps, 4 * RotationPlan::galois_key_byte_count(context));
+        ASSERT_EQ(4, plan.key_steps().size());
+        GaloisKeys glk;
+        keygen.create_galois_keys(plan.galois_elts(), glk);
+
+        vector<complex<double>> input(slot_size);
+        for (size_t i = 0; i < slot_size; i++)
+        {
+            input[i] = complex<double>(static_cast<double>(i), static_cast<double>(i % 5));
+        }
+        Plaintext plain;
+        encoder.encode(input, delta, plain);
+        Ciphertext encrypted;
+        encryptor.encrypt(plain, encrypted);
+
+        for (auto step : steps)
+        {
+            Ciphertext rotated;
+            evaluator.rotate_vector(encrypted, step, glk, plan, rotated);
+            decryptor.decrypt(rotated, plain);
+            vector<complex<double>> output;
+            encoder.decode(plain, output);
+            for (size_t i = 0; i < slot_size; i++)
+            {
+                auto expected = input[(i + slot_size + static_cast<size_t>(step + 32)) % slot_size];
+                ASSERT_NEAR(expected.real(), output[i].real(), 0.01);
+                ASSERT_NEAR(expected.imag(), output[i].imag(), 0.01);
+            }
+        }
+
+        // Wrong scheme
+        ASSERT_THROW(evaluator.rotate_rows_inplace(encrypted, 1, glk, plan), logic_error);
+    }
+} // namespace sealtest
@@ -0,0 +1,150 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/ckks.h"
+#include "seal/util/common.h"
+#include "seal/util/croots.h"
+#include "seal/util/dwthandler.h"
+#include "seal/util/fft.h"
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+
+using namespace seal;
+using namespace seal::util;
+using namespace std;
+
+namespace sealtest
+{
+    namespace util
+    {
+        namespace
+        {
+            // Computes the transforms of SpecialFFT with DWTHandler on std::complex<double>
+            class ReferenceFFT
+            {
+            public:
+                ReferenceFFT(int log_n)
+                    : log_n_(log_n), root_powers_(size_t(1) << log_n), inv_root_powers_(size_t(1) << log_n)
+                {
+                    size_t n = size_t(1) << log_n;
+                    if (n >= 4)
+                    {
+                        ComplexRoots complex_roots(n << 1, MemoryManager::GetPool());
+                        for (size_t i = 1; i < n; i++)
+                        {
+                            root_powers_[i] = complex_roots.get_root(reverse_bits(i, log_n));
+                            inv_root_powers_[i] = conj(complex_roots.get_root(reverse_bits(i - 1, log_n) + 1));
+                        }
+                    }
+                    else
+                    {
+                        root_powers_[1] = { 0, 1 };
+                        inv_root_powers_[1] = { 0, -1 };
+                    }
+                }
+
+                void transform_to_rev(vector<complex<double>> &values) const
+                {
+                    handler_.transform_to_rev(values.data(), log_n_, root_powers_.data());
+                }
+
+                void transform_from_rev(vector<complex<double>> &values, const double *scalar) const
+                {
+                    handler_.transform_from_rev(values.data(), log_n_, inv_root_powers_.data(), scalar);
+                }
+
+            private:
+                int log_n_;
+
+                vector<complex<double>> root_powers_;
+
+                vector<complex<double>> inv_root_powers_;
+
+                Arithmetic<complex<double>, complex<double>, double> arithmetic_;
+
+                DWTHandler<complex<double>, complex<double>, double> handler_{ arithmetic_ };
+            };
+        } // namespace
+
+        TEST(SpecialFFTTest, FFTKernels)
+        {
+            fft_kernel_type default_kernel = get_fft_kernel();
+            ASSERT_TRUE(fft_kernel_supported(default_kernel));
+            ASSERT_TRUE(fft_kernel_supported(fft_kernel_type::scalar));
+
+            ASSERT_THROW(SpecialFFT(0), invalid_argument);
+
+            // Every supported kernel agrees with DWTHandler up to rounding errors
+            mt19937_64 engine(0);
+            uniform_real_distribution<double> dist(-1.0, 1.0);
+            for (int log_n = 1; log_n <= 16; log_n++)
+            {
+                size_t n = size_t(1) << log_n;
+                SpecialFFT fft(log_n);
+                ReferenceFFT reference(log_n);
+                vector<complex<double>> input(n);
+                for (auto &value : input)
+                {
+                    value = { dist(engine), dist(engine) };
+                }
+
+                vector<complex<double>> expected = input;
+                reference.transform_to_rev(expected);
+                double scalar = 3.0 / static_cast<double>(n);
+                vector<complex<double>> inverse_expected = input;
+                reference.transform_from_rev(inverse_expected, nullptr);
+                vector<complex<double>> scaled_inverse_expected = input;
+                reference.transform_from_rev(scaled_inverse_expected, &scalar);
+
+                // The errors grow with log_n times the magnitude of the outputs, which is at most n
+                double tolerance = 1e-14 * static_cast<double>(log_n * n);
+                auto check = [&](const vector<double> &real, const vector<double> &imag,
+                                 const vector<complex<double>> &values) {
+                    for (size_t i = 0; i < n; i++)
+                    {
+                        ASSERT_NEAR(values[i].real(), real[i], tolerance);
+                        ASSERT_NEAR(values[i].imag(), imag[i], tolerance);
+                    }
+                };
+
+                for (auto kernel : { fft_kernel_type::scalar, fft_kernel_type::avx2, fft_kernel_type::avx512 })
+                {
+                    if (!fft_kernel_supported(kernel))
+                    {
+                        continue;
+                    }
+                    set_fft_kernel(kernel);
+                    ASSERT_TRUE(kernel == get_fft_kernel());
+
+                    vector<double> real(n), imag(n);
+                    auto load = [&]() {
+                        for (size_t i = 0; i < n; i++)
+                        {
+                            real[i] = input[i].real();
+                            imag[i] = input[i].imag();
+                        }
+                    };
+
+                    load();
+                    fft.transform_to_rev(real.data(), imag.data());
+                    check(real, imag, expected);
+
+                    load();
+                    fft.transform_from_rev(real.data(), imag.data());
+                    check(real, imag, inverse_expected);
+
+                    load();
+                    fft.transform_from_rev(real.data(), imag.data(), &scalar);
+                    check(real, imag, scaled_inverse_expected);
+                }
+            }
+
+            set_fft_kernel(default_kernel);
+            ASSERT_TRUE(default_kernel == get_fft_kernel());
+        }
+    } // namespace util
+} // namespace sealtest
@@ -8,7 +8,9 @@
 #include "seal/util/pointer.h"
 #include "seal/util/uintcore.h"
 #include <algorithm>
+#include <limits>
 #include <memory>
+#include <thread>
 #include <vector>
 #include "gtest/gtest.h"
 
@@ -561,5 +563,419 @@ namespace sealtest
             auto ptr = allocate(bytes.begin(), bytes.size(), pool);
             ASSERT_TRUE(equal(bytes.begin(), bytes.end(), ptr.get()));
         }
+
+        TEST(MemoryPoolTests, SizeClasses)
+        {
+            size_t prev_class = 0;
+            for (size_t byte_count = 1; byte_count < 100000; byte_count++)
+            {
+                size_t curr_class = MemoryPoolSC::size_class(byte_count);
+                size_t class_byte_count = MemoryPoolSC::size_class_byte_count(curr_class);
+                ASSERT_TRUE(curr_class == prev_class || curr_class == prev_class + 1);
+                ASSERT_TRUE(class_byte_count >= byte_count);
+                ASSERT_TRUE(class_byte_count <= byte_count + max<size_t>(byte_count / 8, 7));
+                if (curr_class)
+                {
+                    ASSERT_TRUE(MemoryPoolSC::size_class_byte_count(curr_class - 1) < byte_count);
+                }
+                prev_class = curr_class;
+            }
+
+            size_t last_class = MemoryPoolSC::size_class(MemoryPool::max_single_alloc_byte_count);
+            ASSERT_EQ(MemoryPoolSC::size_class_count - 1, last_class);
+            ASSERT_TRUE(
+                MemoryPoolSC::size_class_byte_count(last_class) >= MemoryPool::max_single_alloc_byte_count);
+        }
+
+        TEST(MemoryPoolTests, TestMemoryPoolSC)
+        {
+            {
+                MemoryPoolSC pool;
+                ASSERT_TRUE(0LL == pool.pool_count());
+                ASSERT_TRUE(0LL == pool.alloc_byte_count());
+
+                Pointer<uint64_t> pointer{ pool.get_for_byte_count(bytes_per_uint64 * 0) };
+                ASSERT_FALSE(pointer.is_set());
+                ASSERT_TRUE(0LL == pool.pool_count());
+
+                pointer = pool.get_for_byte_count(bytes_per_uint64 * 2);
+                uint64_t *allocation1 = pointer.get();
+                ASSERT_TRUE(pointer.is_set());
+                pointer.release();
+                ASSERT_TRUE(1LL == pool.pool_count());
+
+                // Sizes in the same size class share the free items
+                pointer = pool.get_for_byte_count(bytes_per_uint64 * 2 - 3);
+                ASSERT_TRUE(allocation1 == pointer.get());
+                Pointer<uint64_t> pointer2 = pool.get_for_byte_count(bytes_per_uint64 * 2);
+                uint64_t *allocation2 = pointer2.get();
+                ASSERT_FALSE(allocation2 == pointer.get());
+                pointer.release();
+                pointer2.release();
+                ASSERT_TRUE(1LL == pool.pool_count());
+
+                pointer = pool.get_for_byte_count(bytes_per_uint64 * 2);
+                ASSERT_TRUE(allocation2 == pointer.get());
+                pointer2 = pool.get_for_byte_count(bytes_per_uint64 * 2);
+                ASSERT_TRUE(allocation1 == pointer2.get());
+                Pointer<uint64_t> pointer3 = pool.get_for_byte_count(bytes_per_uint64 * 3);
+                ASSERT_TRUE(2LL == pool.pool_count());
+                pointer.release();
+                pointer2.release();
+                pointer3.release();
+
+                // The items are rounded up, but pointers only see the requested bytes
+                vector<uint64_t> values{ 1, 2, 3, 4, 5 };
+                auto copy = allocate(values.begin(), values.size(), pool);
+                ASSERT_TRUE(equal(values.begin(), values.end(), copy.get()));
+                ASSERT_TRUE(3LL == pool.pool_count());
+
+                // Large allocations
+                for (size_t i = 0; i < 4; i++)
+                {
+                    auto large = allocate<uint64_t>(size_t(1) << 20, pool, uint64_t(i));
+                    ASSERT_EQ(i, large[(size_t(1) << 20) - 1]);
+                }
+                ASSERT_TRUE(pool.alloc_byte_count() >= (size_t(1) << 23));
+                ASSERT_THROW(
+                    auto p = pool.get_for_byte_count(MemoryPool::max_single_alloc_byte_count + 1), invalid_argument);
+            }
+            {
+                MemoryPoolSC pool(true);
+                auto pointer = allocate<uint64_t>(100, pool, uint64_t(1));
+                pointer.release();
+            }
+        }
+
+        TEST(MemoryPoolTests, TestMemoryPoolSCThreads)
+        {
+            MemoryPoolSC pool;
+            size_t thread_count = 8;
+            size_t round_count = 2000;
+
+            // Each thread releases the allocations of the previous round in another thread
+            vector<vector<Pointer<uint64_t>>> handoff(thread_count);
+            vector<thread> threads;
+            vector<int> failed(thread_count, 0);
+            for (size_t t = 0; t < thread_count; t++)
+            {
+                threads.emplace_back([&, t]() {
+                    vector<Pointer<uint64_t>> held;
+                    for (size_t round = 0; round < round_count; round++)
+                    {
+                        size_t count = 1 + (round * 7 + t * 13) % 300;
+                        auto pointer = allocate<uint64_t>(count, pool, uint64_t(t));
+                        for (size_t i = 0; i < count; i++)
+                        {
+                            failed[t] |= (pointer[i] != t);
+                        }
+                        held.push_back(move(pointer));
+                        if (held.size() > 16)
+                        {
+                            held.erase(held.begin(), held.begin() + 8);
+                        }
+                    }
+                    for (auto &pointer : held)
+                    {
+                        failed[t] |= (pointer[0] != t);
+                    }
+                    handoff[t] = move(held);
+                });
+            }
+            for (auto &curr_thread : threads)
+            {
+                curr_thread.join();
+            }
+            ASSERT_TRUE(all_of(failed.begin(), failed.end(), [](int curr_failed) { return !curr_failed; }));
+
+            // Items of exited threads are released from this thread and reused afterwards
+            size_t alloc_byte_count = pool.alloc_byte_count();
+            handoff.clear();
+            for (size_t round = 0; round < round_count; round++)
+            {
+                auto pointer = allocate<uint64_t>(1 + round % 300, pool);
+            }
+            ASSERT_EQ(alloc_byte_count, pool.alloc_byte_count());
+        }
+
+        TEST(MemoryPoolTests, Trim)
+        {
+            auto test_trim = [](MemoryPool &pool) {
+                ASSERT_EQ(0ULL, pool.trim(0));
+
+                vector<Pointer<uint64_t>> pointers;
+                for (size_t i = 0; i < 16; i++)
+                {
+                    pointers.push_back(allocate<uint64_t>(4096, pool, uint64_t(i)));
+                }
+                Pointer<uint64_t> held = allocate<uint64_t>(1000, pool, uint64_t(1));
+                pointers.clear();
+
+                // Only the allocations holding items in use remain
+                size_t byte_count = pool.alloc_byte_count();
+                size_t freed_byte_count = pool.trim(0);
+                ASSERT_TRUE(freed_byte_count >= 16 * 4096 * bytes_per_uint64);
+                ASSERT_EQ(byte_count - freed_byte_count, pool.alloc_byte_count());
+                ASSERT_TRUE(all_of(held.get(), held.get() + 1000, [](uint64_t value) { return value == 1; }));
+
+                // Nothing is freed while the target is met
+                ASSERT_EQ(0ULL, pool.trim(pool.alloc_byte_count()));
+
+                // Trimmed sizes are allocated again
+                auto pointer = allocate<uint64_t>(4096, pool, uint64_t(2));
+                ASSERT_EQ(2ULL, pointer[4095]);
+                pointer.release();
+                held.release();
+                pool.trim(0);
+                ASSERT_EQ(0ULL, pool.alloc_byte_count());
+            };
+
+            MemoryPoolMT pool_mt(true);
+            test_trim(pool_mt);
+            ASSERT_EQ(0ULL, pool_mt.pool_count());
+            MemoryPoolST pool_st;
+            test_trim(pool_st);
+            ASSERT_EQ(0ULL, pool_st.pool_count());
+            MemoryPoolSC pool_sc;
+            test_trim(pool_sc);
+
+            // A free item in an allocation that is still in use only has its pages discarded
+            MemoryPoolST pool;
+            size_t count = MemoryPool::discard_min_byte_count * 4 / bytes_per_uint64;
+            auto pointer1 = allocate<uint64_t>(count, pool);
+            auto pointer2 = allocate<uint64_t>(count, pool);
+            auto pointer3 = allocate<uint64_t>(count, pool, uint64_t(3));
+            uint64_t *allocation3 = pointer3.get();
+            pointer1.release();
+            pointer3.release();
+            size_t freed_byte_count = pool.trim(0);
+            ASSERT_EQ(count * bytes_per_uint64, freed_byte_count);
+            pointer3 = allocate<uint64_t>(count, pool);
+            ASSERT_TRUE(allocation3 == pointer3.get());
+#ifdef SEAL_USE_MADVISE
+            // Only the pages entirely within the item are discarded
+            ASSERT_EQ(0ULL, pointer3[count / 2]);
+#endif
+        }
+
+        TEST(MemoryPoolTests, Stats)
+        {
+            auto test_stats = [](MemoryPool &pool) {
+                ASSERT_TRUE(pool.stats().empty());
+
+                auto pointer1 = allocate<uint64_t>(64, pool);
+                auto pointer2 = allocate<uint64_t>(64, pool);
+                pointer1.release();
+                auto pointer3 = allocate<uint64_t>(64, pool);
+                auto pointer4 = allocate<uint64_t>(1000, pool);
+
+                auto stats = pool.stats();
+                ASSERT_EQ(2ULL, stats.size());
+                ASSERT_TRUE(stats[0].item_byte_count >= 64 * bytes_per_uint64);
+                ASSERT_TRUE(stats[1].item_byte_count >= 1000 * bytes_per_uint64);
+                ASSERT_TRUE(stats[0].item_count >= 2);
+                ASSERT_EQ(2ULL, stats[0].fresh_count);
+                ASSERT_EQ(1ULL, stats[0].reuse_count);
+                ASSERT_EQ(2ULL, stats[0].in_use_count);
+                ASSERT_TRUE(stats[0].peak_in_use_count >= 2);
+                ASSERT_EQ(1ULL, stats[1].fresh_count);
+                ASSERT_EQ(0ULL, stats[1].reuse_count);
+                ASSERT_EQ(1ULL, stats[1].in_use_count);
+
+                // Releasing items keeps the peak
+                pointer2.release();
+                pointer3.release();
+                stats = pool.stats();
+                ASSERT_EQ(0ULL, stats[0].in_use_count);
+                ASSERT_TRUE(stats[0].peak_in_use_count >= 2);
+                ASSERT_EQ(1ULL, stats[1].in_use_count);
+            };
+
+            MemoryPoolMT pool_mt;
+            test_stats(pool_mt);
+            ASSERT_EQ(2ULL, pool_mt.stats()[0].peak_in_use_count);
+            MemoryPoolST pool_st;
+            test_stats(pool_st);
+            ASSERT_EQ(2ULL, pool_st.stats()[0].peak_in_use_count);
+            MemoryPoolSC pool_sc;
+            test_stats(pool_sc);
+
+            // Counters of the size-class memory pool are kept per thread
+            thread([&pool_sc]() {
+                auto pointer1 = allocate<uint64_t>(64, pool_sc);
+                auto pointer2 = allocate<uint64_t>(64, pool_sc);
+            }).join();
+            auto stats = pool_sc.stats();
+            ASSERT_EQ(5ULL, stats[0].fresh_count + stats[0].reuse_count);
+            ASSERT_EQ(0ULL, stats[0].in_use_count);
+        }
+
+        TEST(MemoryPoolTests, Trace)
+        {
+            auto test_trace = [](MemoryPool &pool) {
+                ASSERT_THROW(pool.set_trace(1, 0), invalid_argument);
+                ASSERT_THROW(pool.set_trace(1, MemoryPool::max_trace_capacity + 1), invalid_argument);
+                auto unused = allocate<uint64_t>(1, pool);
+                ASSERT_TRUE(pool.trace().empty());
+
+                // Every second allocation is sampled, and the 3 most recent samples are kept
+                pool.set_trace(2, 3);
+                {
+                    AllocationScope outer("outer");
+                    AllocationScope inner("inner");
+                    ASSERT_STREQ("outer", AllocationScope::current());
+                    for (size_t i = 0; i < 4; i++)
+                    {
+                        auto unused = allocate<uint64_t>(i + 1, pool);
+                    }
+                }
+                ASSERT_TRUE(AllocationScope::current() == nullptr);
+                for (size_t i = 0; i < 4; i++)
+                {
+                    auto unused = allocate<uint64_t>(i + 10, pool);
+                }
+
+                auto trace = pool.trace();
+                ASSERT_EQ(3ULL, trace.size());
+                ASSERT_EQ(2ULL, trace[0].allocation_index);
+                ASSERT_EQ(3 * bytes_per_uint64, trace[0].byte_count);
+                ASSERT_STREQ("outer", trace[0].function);
+                ASSERT_EQ(4ULL, trace[1].allocation_index);
+                ASSERT_EQ(10 * bytes_per_uint64, trace[1].byte_count);
+                ASSERT_TRUE(trace[1].function == nullptr);
+                ASSERT_EQ(6ULL, trace[2].allocation_index);
+                ASSERT_EQ(12 * bytes_per_uint64, trace[2].byte_count);
+
+                // Stopping discards the trace
+                pool.set_trace(0, 0);
+                unused = allocate<uint64_t>(1, pool);
+                ASSERT_TRUE(pool.trace().empty());
+            };
+
+            MemoryPoolMT pool_mt;
+            test_trace(pool_mt);
+            MemoryPoolST pool_st;
+            test_trace(pool_st);
+            MemoryPoolSC pool_sc;
+            test_trace(pool_sc);
+            MemoryPoolArena pool_arena(4096);
+            test_trace(pool_arena);
+        }
+
+        TEST(MemoryPoolTests, HugePages)
+        {
+            auto test_huge_pages = [](MemoryPool &pool) {
+                // Allocations smaller than a huge page are served as usual
+                size_t count = MemoryPool::huge_page_byte_count / bytes_per_uint64;
+                auto small = allocate<uint64_t>(100, pool, uint64_t(1));
+                auto large1 = allocate<uint64_t>(count + 1, pool, uint64_t(2));
+                auto large2 = allocate<uint64_t>(count + 1, pool, uint64_t(3));
+#ifdef SEAL_USE_HUGE_PAGES
+                ASSERT_EQ(0ULL, reinterpret_cast<uintptr_t>(large1.get()) % MemoryPool::huge_page_byte_count);
+                ASSERT_EQ(0ULL, reinterpret_cast<uintptr_t>(large2.get()) % MemoryPool::huge_page_byte_count);
+#endif
+                ASSERT_EQ(1ULL, small[99]);
+                ASSERT_EQ(2ULL, large1[count]);
+                ASSERT_EQ(3ULL, large2[0]);
+                ASSERT_EQ(3ULL, large2[count]);
+
+                // Mapped allocations are unmapped when trimmed
+                large1.release();
+                large2.release();
+                ASSERT_TRUE(pool.trim(0) >= 2 * (count + 1) * bytes_per_uint64);
+                ASSERT_EQ(100 * bytes_per_uint64, pool.alloc_byte_count());
+                large1 = allocate<uint64_t>(count + 1, pool, uint64_t(4));
+                ASSERT_EQ(4ULL, large1[count]);
+            };
+
+            MemoryPoolMT pool_mt(true, true);
+            ASSERT_TRUE(pool_mt.huge_pages());
+            test_huge_pages(pool_mt);
+            MemoryPoolST pool_st(false, true);
+            ASSERT_TRUE(pool_st.huge_pages());
+            test_huge_pages(pool_st);
+            ASSERT_FALSE(MemoryPoolMT().huge_pages());
+        }
+
+        TEST(MemoryPoolTests, Arena)
+        {
+            ASSERT_THROW(MemoryPoolArena(0), invalid_argument);
+            ASSERT_THROW(MemoryPoolArena(numeric_limits<size_t>::max()), invalid_argument);
+            ASSERT_THROW(MemoryPoolArena(MemoryPool::max_batch_alloc_byte_count), invalid_argument);
+            MemoryPoolArena pool(1000, true);
+            ASSERT_TRUE(pool.is_thread_safe());
+            ASSERT_EQ(1024ULL, pool.capacity());
+            ASSERT_EQ(1ULL, pool.pool_count());
+            ASSERT_EQ(1024ULL, pool.alloc_byte_count());
+            ASSERT_EQ(0ULL, pool.used_byte_count());
+
+            // Each allocation takes an aligned block after one alignment of bookkeeping
+            auto pointer1 = allocate<uint64_t>(1, pool, uint64_t(1));
+            auto pointer2 = allocate<uint64_t>(10, pool, uint64_t(2));
+            ASSERT_EQ(0ULL, reinterpret_cast<uintptr_t>(pointer1.get()) % MemoryPoolArena::alignment);
+            ASSERT_EQ(0ULL, reinterpret_cast<uintptr_t>(pointer2.get()) % MemoryPoolArena::alignment);
+            ASSERT_EQ(5 * MemoryPoolArena::alignment, pool.used_byte_count());
+            ASSERT_EQ(pointer1.get() + 2 * MemoryPoolArena::alignment / bytes_per_uint64, pointer2.get());
+
+            // Released memory is not reused before the region is reset
+            pointer1.release();
+            auto pointer3 = allocate<uint64_t>(1, pool);
+            ASSERT_EQ(7 * MemoryPoolArena::alignment, pool.used_byte_count());
+            ASSERT_EQ(2ULL, pointer2[9]);
+
+            // Allocations that do not fit come from the overflow pool
+            auto pointer4 = allocate<uint64_t>(100, pool, uint64_t(4));
+            ASSERT_EQ(2ULL, pool.pool_count());
+            ASSERT_TRUE(pool.alloc_byte_count() > 1024);
+            ASSERT_EQ(7 * MemoryPoolArena::alignment, pool.used_byte_count());
+
+            auto stats = pool.stats();
+            ASSERT_EQ(2ULL, stats.size());
+            ASSERT_EQ(1ULL, stats[0].item_byte_count);
+            ASSERT_EQ(1024ULL, stats[0].item_count);
+            ASSERT_EQ(7 * MemoryPoolArena::alignment, stats[0].in_use_count);
+            ASSERT_EQ(7 * MemoryPoolArena::alignment, stats[0].peak_in_use_count);
+            ASSERT_EQ(1ULL, stats[1].in_use_count);
+
+            // The region cannot be reset while memory from it is in use
+            ASSERT_FALSE(pool.reset());
+            pointer2.release();
+            pointer3.release();
+            ASSERT_TRUE(pool.reset());
+            ASSERT_EQ(0ULL, pool.used_byte_count());
+            pointer1 = allocate<uint64_t>(1, pool);
+            ASSERT_EQ(0ULL, pointer1[0]);
+            stats = pool.stats();
+            ASSERT_EQ(2 * MemoryPoolArena::alignment, stats[0].in_use_count);
+            ASSERT_EQ(7 * MemoryPoolArena::alignment, stats[0].peak_in_use_count);
+            ASSERT_EQ(2 * MemoryPoolArena::alignment, stats[0].reuse_count);
+
+            // Only the overflow pool is trimmed
+            pointer4.release();
+            ASSERT_TRUE(pool.trim(0) > 0);
+            ASSERT_EQ(1ULL, pool.pool_count());
+            ASSERT_EQ(1024ULL, pool.alloc_byte_count());
+
+            // Concurrent allocations get disjoint blocks
+            MemoryPoolArena pool_threads(64 * 1024);
+            vector<thread> threads;
+            for (size_t i = 0; i < 4; i++)
+            {
+                threads.emplace_back([&pool_threads, i]() {
+                    for (size_t j = 0; j < 32; j++)
+                    {
+                        auto pointer = allocate<uint64_t>(8, pool_threads, uint64_t(i));
+                        ASSERT_TRUE(
+                            all_of(pointer.get(), pointer.get() + 8, [i](uint64_t value) { return value == i; }));
+                    }
+                });
+            }
+            for (auto &t : threads)
+            {
+                t.join();
+            }
+            ASSERT_EQ(4 * 32 * 2 * MemoryPoolArena::alignment, pool_threads.used_byte_count());
+            ASSERT_TRUE(pool_threads.reset());
+        }
     } // namespace util
 } // namespace sealtest
@@ -5,9 +5,11 @@
 #include "seal/util/ntt.h"
 #include "seal/util/numth.h"
 #include "seal/util/polycore.h"
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <random>
+#include <vector>
 #include "gtest/gtest.h"
 
 using namespace seal;
@@ -131,5 +133,151 @@ namespace sealtest
                 ASSERT_EQ(temp[i], poly[i]);
             }
         }
+
+        TEST(NTTTablesTest, BlockedNTT)
+        {
+            MemoryPoolHandle pool = MemoryPoolHandle::Global();
+
+            // The blocked traversal computes exactly the same values as the layer-by-layer one
+            mt19937_64 engine(0);
+            for (int coeff_count_power : { 10, 12, 13, 14, 15, 16, 17 })
+            {
+                size_t n = size_t(1) << coeff_count_power;
+                Modulus modulus(get_prime(uint64_t(2) << coeff_count_power, 60));
+                uint64_t q = modulus.value();
+                NTTTables tables(coeff_count_power, modulus, pool);
+                int block_coeff_count_power = tables.block_coeff_count_power();
+#ifndef SEAL_USE_INTEL_HEXL
+                ASSERT_EQ(min(coeff_count_power, SEAL_NTT_BLOCK_COEFF_COUNT_POWER), block_coeff_count_power);
+#endif
+
+                vector<uint64_t> values(n), expected(n);
+                for (size_t i = 0; i < n; i++)
+                {
+                    values[i] = engine() % (4 * q);
+                }
+                expected = values;
+                tables.ntt_handler().transform_to_rev(
+                    expected.data(), coeff_count_power, tables.get_from_root_powers());
+                tables.ntt_handler().transform_to_rev_blocked(
+                    values.data(), coeff_count_power, tables.get_from_root_powers(), block_coeff_count_power,
+                    tables.get_from_block_root_powers());
+                ASSERT_TRUE(expected == values);
+
+                for (size_t i = 0; i < n; i++)
+                {
+                    values[i] = engine() % (2 * q);
+                }
+                expected = values;
+                MultiplyUIntModOperand inv_degree_modulo = tables.inv_degree_modulo();
+                tables.ntt_handler().transform_from_rev(
+                    expected.data(), coeff_count_power, tables.get_from_inv_root_powers(), &inv_degree_modulo);
+                tables.ntt_handler().transform_from_rev_blocked(
+                    values.data(), coeff_count_power, tables.get_from_inv_root_powers(), block_coeff_count_power,
+                    tables.get_from_block_inv_root_powers(), &inv_degree_modulo);
+                ASSERT_TRUE(expected == values);
+
+                // Copies keep the blocked tables
+                NTTTables copy(tables);
+                ASSERT_EQ(block_coeff_count_power, copy.block_coeff_count_power());
+                for (size_t i = 0; i < n; i++)
+                {
+                    ASSERT_EQ(
+                        tables.get_from_block_root_powers()[i].operand, copy.get_from_block_root_powers()[i].operand);
+                    ASSERT_EQ(
+                        tables.get_from_block_inv_root_powers()[i].operand,
+                        copy.get_from_block_inv_root_powers()[i].operand);
+                }
+            }
+        }
+
+        TEST(NTTTablesTest, NTTKernels)
+        {
+            MemoryPoolHandle pool = MemoryPoolHandle::Global();
+            ntt_kernel_type default_kernel = get_ntt_kernel();
+            ASSERT_TRUE(ntt_kernel_supported(default_kernel));
+            ASSERT_TRUE(ntt_kernel_supported(ntt_kernel_type::scalar));
+
+            // Every supported kernel agrees with the scalar one modulo q and keeps the lazy output ranges
+            mt19937_64 engine(0);
+            for (int coeff_count_power : { 3, 4, 5, 10, 13, 14, 15, 16 })
+            {
+                size_t n = size_t(1) << coeff_count_power;
+                for (int bit_count : { 20, 30, 31, 49, 50, 60, 61 })
+                {
+                    Modulus modulus(get_prime(uint64_t(2) << coeff_count_power, bit_count));
+                    uint64_t q = modulus.value();
+                    NTTTables tables(coeff_count_power, modulus, pool);
+                    vector<uint64_t> input(n), expected(n), inverse_input(n), inverse_expected(n);
+                    for (size_t i = 0; i < n; i++)
+                    {
+                        input[i] = engine() % (4 * q);
+                        inverse_input[i] = engine() % (2 * q);
+                    }
+
+                    set_ntt_kernel(ntt_kernel_type::scalar);
+                    expected = input;
+                    ntt_negacyclic_harvey_lazy(expected.data(), tables);
+                    inverse_expected = inverse_input;
+                    inverse_ntt_negacyclic_harvey_lazy(inverse_expected.data(), tables);
+
+                    for (auto kernel : { ntt_kernel_type::avx2, ntt_kernel_type::avx512, ntt_kernel_type::avx512ifma })
+                    {
+                        if (!ntt_kernel_supported(kernel))
+                        {
+                            continue;
+                        }
+                        set_ntt_kernel(kernel);
+                        ASSERT_TRUE(kernel == get_ntt_kernel());
+
+                        vector<uint64_t> values = input;
+                        ntt_negacyclic_harvey_lazy(values.data(), tables);
+                        for (size_t i = 0; i < n; i++)
+                        {
+                            ASSERT_GT(4 * q, values[i]);
+                            ASSERT_EQ(expected[i] % q, values[i] % q);
+                        }
+
+                        values = inverse_input;
+                        inverse_ntt_negacyclic_harvey_lazy(values.data(), tables);
+                        for (size_t i = 0; i < n; i++)
+                        {
+                            ASSERT_GT(2 * q, values[i]);
+                            ASSERT_EQ(inverse_expected[i] % q, values[i] % q);
+                        }
+
+                        // Full reduction
+                        values = input;
+                        ntt_negacyclic_harvey(values.data(), tables);
+                        for (size_t i = 0; i < n; i++)
+                        {
+                            ASSERT_EQ(expected[i] % q, values[i]);
+                        }
+                        values = inverse_input;
+                        inverse_ntt_negacyclic_harvey(values.data(), tables);
+                        for (size_t i = 0; i < n; i++)
+                        {
+                            ASSERT_EQ(inverse_expected[i] % q, values[i]);
+                        }
+
+                        // Round trip with full reduction
+                        values = input;
+                        for (auto &value : values)
+                        {
+                            value %= q;
+                        }
+                        ntt_negacyclic_harvey(values.data(), tables);
+                        inverse_ntt_negacyclic_harvey(values.data(), tables);
+                        for (size_t i = 0; i < n; i++)
+                        {
+                            ASSERT_EQ(input[i] % q, values[i]);
+                        }
+                    }
+                }
+            }
+
+            set_ntt_kernel(default_kernel);
+            ASSERT_TRUE(default_kernel == get_ntt_kernel());
+        }
     } // namespace util
 } // namespace sealtest
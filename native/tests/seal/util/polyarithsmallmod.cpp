@@ -5,8 +5,11 @@
 #include "seal/util/polyarithsmallmod.h"
 #include "seal/util/polycore.h"
 #include "seal/util/uintcore.h"
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <random>
+#include <vector>
 #include "gtest/gtest.h"
 
 using namespace seal;
@@ -639,6 +642,212 @@ namespace sealtest
             }
         }
 
+        TEST(PolyArithSmallMod, PolyArithKernels)
+        {
+            polyarith_kernel_type default_kernel = get_polyarith_kernel();
+            ASSERT_TRUE(polyarith_kernel_supported(default_kernel));
+            ASSERT_TRUE(polyarith_kernel_supported(polyarith_kernel_type::scalar));
+
+            // Every supported kernel agrees with the scalar one, including on the lanes past the last full vector
+            mt19937_64 engine(0);
+            for (size_t coeff_count : { 1, 3, 8, 13, 4099 })
+            {
+                for (uint64_t modulus_value :
+                     { uint64_t(2), uint64_t(17), (uint64_t(1) << 29), (uint64_t(1) << 30) - 35,
+                       (uint64_t(1) << 30) + 3, (uint64_t(1) << 40), (uint64_t(1) << 50) - 27,
+                       (uint64_t(1) << 59) - 55, (uint64_t(1) << 60) - 93, (uint64_t(1) << 61) - 1 })
+                {
+                    Modulus modulus(modulus_value);
+                    uint64_t q = modulus.value();
+
+                    // The dyadic product takes lazy operands in [0, 4q) for moduli of at most 59 bits
+                    uint64_t lazy_bound = modulus.bit_count() <= 59 ? 4 * q : q;
+                    vector<uint64_t> operand1(coeff_count), operand2(coeff_count), lazy1(coeff_count),
+                        lazy2(coeff_count), wide(coeff_count);
+                    for (size_t i = 0; i < coeff_count; i++)
+                    {
+                        operand1[i] = engine() % q;
+                        operand2[i] = engine() % q;
+                        lazy1[i] = engine() % lazy_bound;
+                        lazy2[i] = engine() % lazy_bound;
+                        wide[i] = engine();
+                    }
+                    MultiplyUIntModOperand scalar;
+                    scalar.set(engine() % q, modulus);
+
+                    set_polyarith_kernel(polyarith_kernel_type::scalar);
+                    vector<uint64_t> sum(coeff_count), diff(coeff_count), scaled(coeff_count), prod(coeff_count),
+                        lazy_prod(coeff_count);
+                    add_poly_coeffmod(operand1.data(), operand2.data(), coeff_count, modulus, sum.data());
+                    sub_poly_coeffmod(operand1.data(), operand2.data(), coeff_count, modulus, diff.data());
+                    multiply_poly_scalar_coeffmod(wide.data(), coeff_count, scalar, modulus, scaled.data());
+                    dyadic_product_coeffmod(operand1.data(), operand2.data(), coeff_count, modulus, prod.data());
+                    for (size_t i = 0; i < coeff_count; i++)
+                    {
+                        lazy_prod[i] = multiply_uint_mod(lazy1[i] % q, lazy2[i] % q, modulus);
+                    }
+
+                    for (auto kernel : { polyarith_kernel_type::avx2, polyarith_kernel_type::avx512 })
+                    {
+                        if (!polyarith_kernel_supported(kernel))
+                        {
+                            continue;
+                        }
+                        set_polyarith_kernel(kernel);
+                        ASSERT_TRUE(kernel == get_polyarith_kernel());
+
+                        // One past the end must not be written
+                        vector<uint64_t> result(coeff_count + 1, 0xFFFFFFFFFFFFFFFFULL);
+                        add_poly_coeffmod(operand1.data(), operand2.data(), coeff_count, modulus, result.data());
+                        ASSERT_TRUE(equal(sum.begin(), sum.end(), result.begin()));
+                        ASSERT_EQ(0xFFFFFFFFFFFFFFFFULL, result[coeff_count]);
+
+                        sub_poly_coeffmod(operand1.data(), operand2.data(), coeff_count, modulus, result.data());
+                        ASSERT_TRUE(equal(diff.begin(), diff.end(), result.begin()));
+
+                        multiply_poly_scalar_coeffmod(wide.data(), coeff_count, scalar, modulus, result.data());
+                        ASSERT_TRUE(equal(scaled.begin(), scaled.end(), result.begin()));
+
+                        dyadic_product_coeffmod(operand1.data(), operand2.data(), coeff_count, modulus, result.data());
+                        ASSERT_TRUE(equal(prod.begin(), prod.end(), result.begin()));
+
+                        // In place
+                        result.assign(lazy1.begin(), lazy1.end());
+                        dyadic_product_coeffmod(result.data(), lazy2.data(), coeff_count, modulus, result.data());
+                        ASSERT_TRUE(equal(lazy_prod.begin(), lazy_prod.end(), result.begin()));
+                    }
+                }
+            }
+
+            ASSERT_THROW(set_polyarith_kernel(static_cast<polyarith_kernel_type>(0xFF)), invalid_argument);
+            set_polyarith_kernel(default_kernel);
+            ASSERT_TRUE(default_kernel == get_polyarith_kernel());
+        }
+
+        TEST(PolyArithSmallMod, MontgomeryCoeffMod)
+        {
+            mt19937_64 engine(0);
+            size_t coeff_count = 13;
+            for (uint64_t modulus_value : { uint64_t(3), (uint64_t(1) << 30) - 35, (uint64_t(1) << 61) - 1 })
+            {
+                Modulus modulus(modulus_value);
+                vector<uint64_t> operand1(coeff_count), operand2(coeff_count), expected(coeff_count);
+                for (size_t i = 0; i < coeff_count; i++)
+                {
+                    operand1[i] = engine();
+                    operand2[i] = engine() % modulus_value;
+                    expected[i] = multiply_uint_mod(operand1[i], operand2[i], modulus);
+                }
+
+                // The product with operand2 in Montgomery form is the standard product, with each supported kernel
+                vector<uint64_t> operand2_montgomery(coeff_count), result(coeff_count);
+                to_montgomery_poly_coeffmod(operand2.data(), coeff_count, modulus, operand2_montgomery.data());
+                polyarith_kernel_type default_kernel = get_polyarith_kernel();
+                for (auto kernel :
+                     { polyarith_kernel_type::scalar, polyarith_kernel_type::avx2, polyarith_kernel_type::avx512 })
+                {
+                    if (!polyarith_kernel_supported(kernel))
+                    {
+                        continue;
+                    }
+                    set_polyarith_kernel(kernel);
+                    dyadic_product_montgomery_coeffmod(
+                        operand1.data(), operand2_montgomery.data(), coeff_count, modulus, result.data());
+                    ASSERT_TRUE(equal(expected.begin(), expected.end(), result.begin()));
+                }
+                set_polyarith_kernel(default_kernel);
+
+                for (size_t i = 0; i < coeff_count; i++)
+                {
+                    ASSERT_EQ(to_montgomery(operand2[i], modulus), operand2_montgomery[i]);
+                }
+                from_montgomery_poly_coeffmod(
+                    operand2_montgomery.data(), coeff_count, modulus, operand2_montgomery.data());
+                ASSERT_TRUE(equal(operand2.begin(), operand2.end(), operand2_montgomery.begin()));
+            }
+
+            dyadic_product_backend_type default_backend = get_dyadic_product_backend();
+            vector<Modulus> moduli = CoeffModulus::Create(64, { 30, 60 });
+            set_dyadic_product_backend(dyadic_product_backend_type::montgomery);
+            ASSERT_TRUE(dyadic_product_backend_type::montgomery == get_dyadic_product_backend());
+            ASSERT_TRUE(use_montgomery_dyadic_product(moduli.data(), 1));
+            set_dyadic_product_backend(dyadic_product_backend_type::barrett);
+            ASSERT_TRUE(dyadic_product_backend_type::barrett == get_dyadic_product_backend());
+            ASSERT_FALSE(use_montgomery_dyadic_product(moduli.data(), 2));
+
+#ifndef SEAL_USE_INTEL_HEXL
+            // The automatic backend uses Montgomery products where the Barrett reductions are not vectorized
+            polyarith_kernel_type default_kernel = get_polyarith_kernel();
+            set_dyadic_product_backend(dyadic_product_backend_type::automatic);
+            set_polyarith_kernel(polyarith_kernel_type::scalar);
+            ASSERT_TRUE(use_montgomery_dyadic_product(moduli.data(), 1));
+            if (default_kernel != polyarith_kernel_type::scalar)
+            {
+                set_polyarith_kernel(default_kernel);
+                ASSERT_FALSE(use_montgomery_dyadic_product(moduli.data(), 1));
+                ASSERT_TRUE(use_montgomery_dyadic_product(moduli.data(), 2));
+            }
+            set_polyarith_kernel(default_kernel);
+#endif
+            ASSERT_THROW(set_dyadic_product_backend(static_cast<dyadic_product_backend_type>(0xFF)), invalid_argument);
+            set_dyadic_product_backend(default_backend);
+        }
+
+        TEST(PolyArithSmallMod, LinearCombinationPolyCoeffMod)
+        {
+            // More polynomials than products fit in a 128-bit accumulator, and coefficients larger than modulus as in
+            // base conversion; 32-bit coefficients take the narrow products for small moduli
+            mt19937_64 engine(0);
+            polyarith_kernel_type default_kernel = get_polyarith_kernel();
+            for (int input_bit_count : { 61, 32 })
+            {
+                for (size_t coeff_count : { 1, 13 })
+                {
+                    for (size_t poly_count : { 0, 1, 3, 5, 70 })
+                    {
+                        for (uint64_t modulus_value :
+                             { uint64_t(2), (uint64_t(1) << 30) - 35, (uint64_t(1) << 61) - 1 })
+                        {
+                            Modulus modulus(modulus_value);
+                            vector<uint64_t> polys(poly_count * coeff_count), expected(coeff_count, 0);
+                            vector<MultiplyUIntModOperand> scalars(poly_count);
+                            for (size_t i = 0; i < poly_count; i++)
+                            {
+                                scalars[i].set(engine() % modulus_value, modulus);
+                                for (size_t j = 0; j < coeff_count; j++)
+                                {
+                                    uint64_t coeff = engine() >> (64 - input_bit_count);
+                                    polys[i * coeff_count + j] = coeff;
+                                    expected[j] = add_uint_mod(
+                                        expected[j], multiply_uint_mod(coeff, scalars[i], modulus), modulus);
+                                }
+                            }
+
+                            for (auto kernel :
+                                 { polyarith_kernel_type::scalar, polyarith_kernel_type::avx2,
+                                   polyarith_kernel_type::avx512 })
+                            {
+                                if (!polyarith_kernel_supported(kernel))
+                                {
+                                    continue;
+                                }
+                                set_polyarith_kernel(kernel);
+
+                                // One past the end must not be written
+                                vector<uint64_t> result(coeff_count + 1, 0xFFFFFFFFFFFFFFFFULL);
+                                linear_combination_poly_coeffmod(
+                                    ConstRNSIter(polys.data(), coeff_count), poly_count, scalars.data(), modulus,
+                                    input_bit_count, result.data());
+                                ASSERT_TRUE(equal(expected.begin(), expected.end(), result.begin()));
+                                ASSERT_EQ(0xFFFFFFFFFFFFFFFFULL, result[coeff_count]);
+                            }
+                        }
+                    }
+                }
+            }
+            set_polyarith_kernel(default_kernel);
+        }
+
         TEST(PolyArithSmallMod, PolyInftyNormCoeffMod)
         {
             MemoryPool &pool = *global_variables::global_memory_pool;
@@ -0,0 +1,88 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/memorymanager.h"
+#include "seal/modulus.h"
+#include "seal/util/numth.h"
+#include "seal/util/polyarithsmallmod.h"
+#include "seal/util/polykernels.h"
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+
+using namespace seal;
+using namespace seal::util;
+using namespace std;
+
+namespace sealtest
+{
+    namespace util
+    {
+        TEST(PolyKernelsTest, GeneralOutsideFixedRange)
+        {
+            const PolyKernels &general = get_poly_kernels(11);
+            for (int coeff_count_power : { 1, 10, 17 })
+            {
+                const PolyKernels &kernels = get_poly_kernels(coeff_count_power);
+                ASSERT_EQ(general.ntt_negacyclic_harvey_lazy, kernels.ntt_negacyclic_harvey_lazy);
+                ASSERT_EQ(general.inverse_ntt_negacyclic_harvey_lazy, kernels.inverse_ntt_negacyclic_harvey_lazy);
+                ASSERT_EQ(general.modulo_poly_coeffs, kernels.modulo_poly_coeffs);
+                ASSERT_EQ(general.add_poly_coeffmod, kernels.add_poly_coeffmod);
+                ASSERT_EQ(general.dyadic_product_coeffmod, kernels.dyadic_product_coeffmod);
+            }
+            for (int coeff_count_power = 12; coeff_count_power <= 16; coeff_count_power++)
+            {
+                ASSERT_NE(general.dyadic_product_coeffmod, get_poly_kernels(coeff_count_power).dyadic_product_coeffmod);
+            }
+        }
+
+        TEST(PolyKernelsTest, FixedMatchesGeneral)
+        {
+            MemoryPoolHandle pool = MemoryManager::GetPool();
+            mt19937_64 engine(0);
+            for (int coeff_count_power = 11; coeff_count_power <= 17; coeff_count_power++)
+            {
+                size_t coeff_count = size_t(1) << coeff_count_power;
+                Modulus modulus(get_primes(coeff_count << 1, 60, 1)[0]);
+                Pointer<NTTTables> tables;
+                CreateNTTTables(coeff_count_power, { modulus }, tables, pool);
+                const PolyKernels &kernels = get_poly_kernels(coeff_count_power);
+
+                vector<uint64_t> operand1(coeff_count), operand2(coeff_count), unreduced(coeff_count);
+                for (size_t i = 0; i < coeff_count; i++)
+                {
+                    operand1[i] = engine() % modulus.value();
+                    operand2[i] = engine() % modulus.value();
+                    unreduced[i] = engine();
+                }
+                vector<uint64_t> expected(coeff_count), result(coeff_count);
+
+                modulo_poly_coeffs(unreduced.data(), coeff_count, modulus, expected.data());
+                kernels.modulo_poly_coeffs(unreduced.data(), coeff_count, modulus, result.data());
+                ASSERT_EQ(expected, result);
+
+                add_poly_coeffmod(operand1.data(), operand2.data(), coeff_count, modulus, expected.data());
+                kernels.add_poly_coeffmod(operand1.data(), operand2.data(), coeff_count, modulus, result.data());
+                ASSERT_EQ(expected, result);
+
+                dyadic_product_coeffmod(operand1.data(), operand2.data(), coeff_count, modulus, expected.data());
+                kernels.dyadic_product_coeffmod(operand1.data(), operand2.data(), coeff_count, modulus, result.data());
+                ASSERT_EQ(expected, result);
+
+                expected = operand1;
+                result = operand1;
+                ntt_negacyclic_harvey_lazy(expected.data(), *tables);
+                kernels.ntt_negacyclic_harvey_lazy(result.data(), *tables);
+                ASSERT_EQ(expected, result);
+
+                expected = operand2;
+                result = operand2;
+                inverse_ntt_negacyclic_harvey_lazy(expected.data(), *tables);
+                kernels.inverse_ntt_negacyclic_harvey_lazy(result.data(), *tables);
+                ASSERT_EQ(expected, result);
+            }
+        }
+    } // namespace util
+} // namespace sealtest
@@ -6,6 +6,7 @@
 #include "seal/util/rns.h"
 #include "seal/util/uintarithmod.h"
 #include "seal/util/uintarithsmallmod.h"
+#include <algorithm>
 #include <stdexcept>
 #include <vector>
 #include "gtest/gtest.h"
@@ -437,6 +438,31 @@ namespace sealtest
             }
         }
 
+        TEST(BaseConverterTest, ExactConvertArray)
+        {
+            auto pool = MemoryManager::GetPool();
+
+            // Every value modulo 3 * 5 is converted as its centered representative
+            size_t count = 15;
+            BaseConverter bct(RNSBase({ 3, 5 }, pool), RNSBase({ 7, 11, 13 }, pool), pool);
+            vector<uint64_t> in(2 * count), out(3 * count);
+            for (size_t x = 0; x < count; x++)
+            {
+                in[x] = x % 3;
+                in[count + x] = x % 5;
+            }
+            bct.exact_convert_array(ConstRNSIter(in.data(), count), RNSIter(out.data(), count), pool);
+            uint64_t moduli[]{ 7, 11, 13 };
+            for (size_t j = 0; j < 3; j++)
+            {
+                for (size_t x = 0; x < count; x++)
+                {
+                    uint64_t expected = ((x <= 7) ? x : moduli[j] - (15 - x)) % moduli[j];
+                    ASSERT_EQ(expected, out[j * count + x]);
+                }
+            }
+        }
+
         TEST(RNSToolTest, Initialize)
         {
             auto pool = MemoryManager::GetPool();
@@ -901,6 +927,72 @@ namespace sealtest
 #endif
         }
 
+        TEST(RNSToolTest, HPSScaleAndRound)
+        {
+            // This function computes round(t/q * input) from q U Bsk to Bsk
+            auto pool = MemoryManager::GetPool();
+            Pointer<RNSTool> rns_tool;
+            size_t poly_modulus_degree = 8;
+            Modulus plain_t = 3;
+            ASSERT_NO_THROW(
+                rns_tool = allocate<RNSTool>(pool, poly_modulus_degree, RNSBase({ 5, 7 }, pool), plain_t, pool));
+            auto base_q = rns_tool->base_q();
+            auto base_Bsk = rns_tool->base_Bsk();
+            size_t base_q_size = base_q->size();
+            size_t base_Bsk_size = base_Bsk->size();
+
+            vector<uint64_t> values{ 0, 1, 11, 12, 29, 30, 35 * 1000 + 17, (uint64_t(1) << 60) - 1 };
+            vector<uint64_t> in(poly_modulus_degree * (base_q_size + base_Bsk_size));
+            for (size_t i = 0; i < base_q_size + base_Bsk_size; i++)
+            {
+                const Modulus &modulus = (i < base_q_size) ? (*base_q)[i] : (*base_Bsk)[i - base_q_size];
+                for (size_t j = 0; j < poly_modulus_degree; j++)
+                {
+                    in[i * poly_modulus_degree + j] = barrett_reduce_64(values[j], modulus);
+                }
+            }
+            vector<uint64_t> out(poly_modulus_degree * base_Bsk_size);
+            rns_tool->hps_scale_and_round(
+                ConstRNSIter(in.data(), poly_modulus_degree), RNSIter(out.data(), poly_modulus_degree), pool);
+            for (size_t i = 0; i < base_Bsk_size; i++)
+            {
+                for (size_t j = 0; j < poly_modulus_degree; j++)
+                {
+                    // round(3 * x / 35) = floor((6 * x + 35) / 70)
+                    uint64_t expected = (6 * values[j] + 35) / 70;
+                    ASSERT_EQ(barrett_reduce_64(expected, (*base_Bsk)[i]), out[i * poly_modulus_degree + j]);
+                }
+            }
+
+            // Decryption scaling takes input in base q and reduces the result modulo t
+            vector<uint64_t> out_t(poly_modulus_degree);
+            rns_tool->hps_decrypt_scale_and_round(
+                ConstRNSIter(in.data(), poly_modulus_degree), CoeffIter(out_t.data()), pool);
+            for (size_t j = 0; j < poly_modulus_degree; j++)
+            {
+                uint64_t x = values[j] % 35;
+                ASSERT_EQ(((6 * x + 35) / 70) % 3, out_t[j]);
+            }
+
+            // Exact conversion of centered representatives from q to Bsk and back
+            vector<uint64_t> out_Bsk(poly_modulus_degree * base_Bsk_size);
+            vector<uint64_t> out_q(poly_modulus_degree * base_q_size);
+            rns_tool->exact_bconv_q_to_Bsk(
+                ConstRNSIter(in.data(), poly_modulus_degree), RNSIter(out_Bsk.data(), poly_modulus_degree), pool);
+            for (size_t i = 0; i < base_Bsk_size; i++)
+            {
+                for (size_t j = 0; j < poly_modulus_degree; j++)
+                {
+                    uint64_t x = values[j] % 35;
+                    uint64_t p = (*base_Bsk)[i].value();
+                    ASSERT_EQ((x <= 17) ? x : p - (35 - x), out_Bsk[i * poly_modulus_degree + j]);
+                }
+            }
+            rns_tool->exact_bconv_Bsk_to_q(
+                ConstRNSIter(out_Bsk.data(), poly_modulus_degree), RNSIter(out_q.data(), poly_modulus_degree), pool);
+            ASSERT_TRUE(equal(out_q.cbegin(), out_q.cend(), in.cbegin()));
+        }
+
         TEST(RNSToolTest, DivideAndRoundQLastInplace)
         {
             // This function approximately divides the input values by the last prime in the base q.
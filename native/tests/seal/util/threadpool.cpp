@@ -0,0 +1,102 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/util/iterator.h"
+#include "seal/util/mempool.h"
+#include "seal/util/threadpool.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+
+using namespace seal;
+using namespace seal::util;
+using namespace std;
+
+namespace sealtest
+{
+    namespace util
+    {
+        TEST(ThreadPoolTest, ParallelFor)
+        {
+            ThreadPool pool(4);
+            ASSERT_EQ(4ULL, pool.thread_count());
+
+            vector<uint64_t> values(1000, 0);
+            pool.parallel_for(values.size(), [&](size_t i) { values[i] = i * i; });
+            for (size_t i = 0; i < values.size(); i++)
+            {
+                ASSERT_EQ(i * i, values[i]);
+            }
+
+            // Nested loops run serially on the thread executing the outer iteration
+            atomic<size_t> count{ 0 };
+            pool.parallel_for(8, [&](size_t) {
+                ASSERT_TRUE(ThreadPool::in_parallel_region());
+                thread::id outer_id = this_thread::get_id();
+                pool.parallel_for(8, [&](size_t) {
+                    ASSERT_EQ(outer_id, this_thread::get_id());
+                    count++;
+                });
+            });
+            ASSERT_EQ(64ULL, count.load());
+            ASSERT_FALSE(ThreadPool::in_parallel_region());
+
+            // Exceptions are rethrown on the calling thread
+            ASSERT_THROW(
+                pool.parallel_for(
+                    100,
+                    [](size_t i) {
+                        if (i == 37)
+                        {
+                            throw invalid_argument("37");
+                        }
+                    }),
+                invalid_argument);
+
+            pool.set_thread_count(1);
+            ASSERT_EQ(1ULL, pool.thread_count());
+            pool.parallel_for(values.size(), [&](size_t i) { values[i] = i; });
+            for (size_t i = 0; i < values.size(); i++)
+            {
+                ASSERT_EQ(i, values[i]);
+            }
+
+            // An empty loop does nothing
+            pool.set_thread_count(0);
+            ASSERT_EQ(1ULL, pool.thread_count());
+            pool.parallel_for(0, [](size_t) { FAIL(); });
+        }
+
+        TEST(ThreadPoolTest, ParallelForEachN)
+        {
+            vector<uint64_t> values(64, 0);
+            vector<uint64_t> squares(64, 0);
+            for (size_t i = 0; i < values.size(); i++)
+            {
+                values[i] = i;
+            }
+            auto end = SEAL_ITERATE_PARALLEL(iter(values, squares), values.size(), [](auto I) {
+                get<1>(I) = get<0>(I) * get<0>(I);
+            });
+            ASSERT_TRUE(end == iter(values, squares) + values.size());
+            for (size_t i = 0; i < values.size(); i++)
+            {
+                ASSERT_EQ(i * i, squares[i]);
+            }
+
+            // A memory pool that is not thread-safe forces a serial loop
+            MemoryPoolST pool_st;
+            MemoryPoolMT pool_mt;
+            thread::id caller_id = this_thread::get_id();
+            SEAL_ITERATE_PARALLEL(pool_st, iter(values), values.size(), [&](auto) {
+                ASSERT_EQ(caller_id, this_thread::get_id());
+            });
+            SEAL_ITERATE_PARALLEL(pool_mt, iter(values, squares), values.size(), [](auto I) { get<1>(I) = get<0>(I); });
+            ASSERT_TRUE(values == squares);
+        }
+    } // namespace util
+} // namespace sealtest
@@ -506,5 +506,32 @@ namespace sealtest
             y.set(mod.value() - 1, mod);
             ASSERT_EQ(0ULL, multiply_add_uint_mod(mod.value() - 1, y, mod.value() - 1, mod));
         }
+
+        TEST(UIntArithSmallMod, Montgomery)
+        {
+            Modulus mod(7);
+            uint64_t input[2]{ 0, 0 };
+            ASSERT_EQ(0ULL, montgomery_reduce_128(input, mod));
+            input[1] = 6;
+            ASSERT_EQ(6ULL, montgomery_reduce_128(input, mod));
+            ASSERT_EQ(1ULL, to_montgomery(0, mod) + from_montgomery(to_montgomery(1, mod), mod));
+            ASSERT_EQ(2ULL, to_montgomery(1, mod));
+
+            mod = 0x1FFFFFFFFFFFFFFFULL;
+            input[0] = 0xFFFFFFFFFFFFFFFFULL;
+            input[1] = mod.value() - 1;
+            ASSERT_EQ(barrett_reduce_128(input, mod), to_montgomery(montgomery_reduce_128(input, mod), mod));
+
+            for (uint64_t x : { uint64_t(0), uint64_t(1), uint64_t(12345), mod.value() - 1 })
+            {
+                ASSERT_EQ(x, from_montgomery(to_montgomery(x, mod), mod));
+                for (uint64_t y : { 0ULL, 1ULL, 0xFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL })
+                {
+                    // Any 64-bit operand1 with operand2 in Montgomery form gives the standard product
+                    ASSERT_EQ(
+                        multiply_uint_mod(y, x, mod), multiply_uint_mod_montgomery(y, to_montgomery(x, mod), mod));
+                }
+            }
+        }
     } // namespace util
 } // namespace sealtest